@@ -0,0 +1,47 @@
+#!/usr/bin/env python3
+
+# Copyright 2024 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This file is part of the WarpX automated test suite. It checks that the
+# colored reduction of the tile currents (warpx.do_colored_tile_reduction = 1)
+# gives the same results as the default reduction with locks, up to round-off
+# errors:
+# - Run the same simulation with both reductions, with 4 OpenMP threads, for
+#   the direct and Esirkepov depositions, with particle tiles of 16x16 cells
+#   and of 4x4 cells (too small for the particle shape: these tiles are added
+#   with locks)
+# - Compare the fields, the current density and the particle momenta at the
+#   end of the simulations
+
+import post_processing_utils
+
+# The tile buffers are added to the current density in a different order,
+# and these round-off errors are amplified over the 20 steps
+tolerance = 1.e-9
+
+field_names = ['Ex', 'Ey', 'Ez', 'Bx', 'By', 'Bz', 'jx', 'jy', 'jz']
+species_names = ['electrons', 'positrons']
+
+for deposition in ['direct', 'esirkepov']:
+    for tile_size in [16, 4]:
+        name = '{}_tile{}'.format(deposition, tile_size)
+        options = 'algo.current_deposition={} particles.tile_size={} {}'.format(
+            deposition, tile_size, tile_size)
+        data = {}
+        for variant, variant_options in [('default', ''),
+                                         ('colored', 'warpx.do_colored_tile_reduction=1')]:
+            prefix = 'diags/' + name + '_' + variant
+            post_processing_utils.run_warpx(
+                'inputs_2d', options + ' ' + variant_options + ' diag1.file_prefix=' + prefix,
+                num_threads=4)
+            data[variant] = post_processing_utils.load_fields_and_particles(
+                prefix + '000020', field_names, species_names,
+                particle_variables=('momentum_x', 'momentum_z'))
+        post_processing_utils.check_relative_difference(
+            data['colored'], data['default'], tolerance, name)
+
+print('Passed')
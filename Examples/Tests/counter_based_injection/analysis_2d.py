@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+
+# Copyright 2024 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This file is part of the WarpX automated test suite. It checks the
+# counter-based random numbers of the plasma injection
+# (warpx.counter_based_injection = 1):
+# - Run the same simulation on 1 box with 1 thread, and on 16 boxes with
+#   2 threads: the injected particles must have the same momenta, and the
+#   same positions up to round-off errors
+# - Run the default random numbers on 1 box: the moments of the momentum
+#   distributions must agree with those of the counter-based random numbers,
+#   within their statistical errors
+
+import numpy as np
+import post_processing_utils
+
+species_names = ['plasma', 'beam']
+momenta = ('momentum_x', 'momentum_y', 'momentum_z')
+dx = 0.5
+
+def run_and_load(name, options, num_threads=1):
+    """Positions and momenta of the particles, sorted by momentum (the particle
+    ids depend on the decomposition)"""
+    prefix = 'diags/' + name
+    post_processing_utils.run_warpx('inputs_2d', options + ' diag1.file_prefix=' + prefix,
+                                    num_threads=num_threads)
+    # In 2D, position_y holds z
+    return post_processing_utils.load_fields_and_particles(
+        prefix + '000010', species_names=species_names,
+        particle_variables=('position_x', 'position_y') + momenta, sort_by=momenta)
+
+one_box = run_and_load('one_box', '')
+many_boxes = run_and_load('many_boxes', 'amr.max_grid_size=8', num_threads=2)
+for var in one_box:
+    assert one_box[var].size == many_boxes[var].size > 0
+    error = np.max(np.abs(many_boxes[var] - one_box[var]))
+    print(var, 'difference between the decompositions:', error)
+    if var.endswith(momenta):
+        assert error == 0.
+    else:
+        assert error < 1.e-10*dx
+
+default = run_and_load('default', 'warpx.counter_based_injection=0')
+for var in one_box:
+    if not var.endswith(momenta):
+        continue
+    assert default[var].size == one_box[var].size
+    n = one_box[var].size
+    std = np.std(default[var])
+    mean_error = np.abs(np.mean(one_box[var]) - np.mean(default[var])) / std
+    std_error = np.abs(np.std(one_box[var]) - std) / std
+    print(var, 'difference of the means:', mean_error, 'of the standard deviations:', std_error)
+    # 5 standard deviations of the statistical errors
+    assert mean_error < 5.*np.sqrt(2./n)
+    assert std_error < 5./np.sqrt(n)
+
+print('Passed')
@@ -0,0 +1,54 @@
+#!/usr/bin/env python3
+
+# Copyright 2024 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This file is part of the WarpX automated test suite. It checks the
+# semi-implicit effective-potential electrostatic solver
+# (warpx.do_electrostatic = labframe-effective-potential) on a Langmuir
+# oscillation:
+# - At omega_p*dt = 4, where the explicit electrostatic scheme is unstable
+#   (its energy would grow by an order of magnitude at each step), the total
+#   energy must remain bounded, and the particles must lose energy to the field
+#   (the scheme is also dissipative at such time steps)
+# - At omega_p*dt = 0.1, the electric field must agree with the one of the
+#   default electrostatic solver (labframe) at omega_p*t = 4.7, where it is
+#   maximum, up to the O((omega_p*dt)^2) correction of the effective potential
+
+import numpy as np
+import post_processing_utils
+
+def run(name, options=''):
+    """Run the simulation, with its plotfiles and reduced diagnostics in diags/<name>/"""
+    path = 'diags/' + name + '/'
+    post_processing_utils.run_warpx(
+        'inputs_2d', options + ' diag1.file_prefix=' + path + 'plt' +
+        ' particle_energy.path=' + path + ' field_energy.path=' + path)
+
+# Large time step: stability
+run('large_dt')
+field_energy = np.loadtxt('diags/large_dt/field_energy.txt', skiprows=1)[:,2]
+particle_energy = np.loadtxt('diags/large_dt/particle_energy.txt', skiprows=1)[:,2]
+total_energy = field_energy + particle_energy
+assert np.all(np.isfinite(total_energy))
+max_growth = np.max(total_energy) / total_energy[0]
+print('maximum growth of the total energy at omega_p*dt = 4:', max_growth)
+assert max_growth < 2.
+min_particle_energy = np.min(particle_energy) / particle_energy[0]
+print('minimum particle energy, relative to the initial one:', min_particle_energy)
+assert min_particle_energy < 0.9
+
+# Small time step: agreement with the explicit scheme, at the maximum of Ex
+options = 'my_constants.wpdt=0.1 max_step=47 diag1.intervals=47'
+run('small_dt_effective', options)
+run('small_dt_default', options + ' warpx.do_electrostatic=labframe')
+Ex_effective = post_processing_utils.load_fields_and_particles(
+    'diags/small_dt_effective/plt000047', field_names=['Ex'])
+Ex_default = post_processing_utils.load_fields_and_particles(
+    'diags/small_dt_default/plt000047', field_names=['Ex'])
+post_processing_utils.check_relative_difference(Ex_effective, Ex_default, 0.05, 'omega_p*dt = 0.1')
+
+print('Passed')
@@ -0,0 +1,39 @@
+#!/usr/bin/env python3
+
+# Copyright 2024 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This file is part of the WarpX automated test suite. It checks that the
+# temporally blocked field push (warpx.do_fdtd_temporal_blocking = 1) gives
+# the same results as the default field push, up to round-off errors:
+# - Run the same simulation with both field pushes, for the Yee and CKC
+#   solvers, with 2 OpenMP threads
+# - Compare the fields and the particle momenta at the end of the simulations
+
+import post_processing_utils
+
+# The guard cells are updated by the sweep instead of being exchanged, which
+# can differ by round-off errors, amplified over the 20 steps
+tolerance = 1.e-9
+
+field_names = ['Ex', 'Ey', 'Ez', 'Bx', 'By', 'Bz', 'jx', 'jy', 'jz']
+species_names = ['electrons', 'positrons']
+
+for solver in ['yee', 'ckc']:
+    options = 'algo.maxwell_solver=' + solver
+    data = {}
+    for variant, variant_options in [('default', ''),
+                                     ('blocked', 'warpx.do_fdtd_temporal_blocking=1')]:
+        prefix = 'diags/' + solver + '_' + variant
+        post_processing_utils.run_warpx(
+            'inputs_3d', options + ' ' + variant_options + ' diag1.file_prefix=' + prefix,
+            num_threads=2)
+        data[variant] = post_processing_utils.load_fields_and_particles(
+            prefix + '000020', field_names, species_names)
+    post_processing_utils.check_relative_difference(
+        data['blocked'], data['default'], tolerance, solver)
+
+print('Passed')
@@ -0,0 +1,47 @@
+#!/usr/bin/env python3
+
+# Copyright 2024 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This file is part of the WarpX automated test suite. It checks that the
+# fixed-point deposition (warpx.do_fixed_point_deposition = 1) gives the same
+# results as the default deposition, up to its precision and round-off errors:
+# - Run the same simulation with both depositions, for the direct and
+#   Esirkepov current depositions
+# - Compare the fields, the current and charge densities, and the particle
+#   momenta at the end of the simulations
+# - Run the fixed-point deposition again and check that the results are the same
+#   (on CPU, with one OpenMP thread, since the tiles are added in any order otherwise)
+
+import numpy as np
+import post_processing_utils
+
+# The fixed-point numbers have a relative precision of about 1e-15 per box,
+# and their truncation errors are amplified over the 20 steps
+tolerance = 1.e-9
+
+field_names = ['Ex', 'Ey', 'Ez', 'Bx', 'By', 'Bz', 'jx', 'jy', 'jz', 'rho']
+species_names = ['electrons', 'positrons']
+
+for deposition in ['direct', 'esirkepov']:
+    options = 'algo.current_deposition=' + deposition
+    data = {}
+    for variant, variant_options in [('default', ''),
+                                     ('fixed', 'warpx.do_fixed_point_deposition=1'),
+                                     ('fixed_again', 'warpx.do_fixed_point_deposition=1')]:
+        prefix = 'diags/' + deposition + '_' + variant
+        post_processing_utils.run_warpx(
+            'inputs_2d', options + ' ' + variant_options + ' diag1.file_prefix=' + prefix,
+            num_threads=1)
+        data[variant] = post_processing_utils.load_fields_and_particles(
+            prefix + '000020', field_names, species_names,
+            particle_variables=('momentum_x', 'momentum_z'))
+    post_processing_utils.check_relative_difference(
+        data['fixed'], data['default'], tolerance, deposition)
+    for var in data['fixed']:
+        assert np.array_equal(data['fixed'][var], data['fixed_again'][var])
+
+print('Passed')
@@ -0,0 +1,39 @@
+#!/usr/bin/env python3
+
+# Copyright 2024 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This file is part of the WarpX automated test suite. It checks that the
+# vectorized field gather (warpx.do_simd_field_gather = 1) gives the same
+# results as the default field gather, up to round-off errors:
+# - Run the same Langmuir wave with both gathers, for the particle shapes
+#   1 and 3 and for the energy- and momentum-conserving gathers
+# - Compare the fields and the particle momenta at the end of the simulations
+
+import post_processing_utils
+
+# The vectorized gather sums the contributions of the stencil in a different
+# order, and these round-off errors are amplified over the 20 steps
+tolerance = 1.e-9
+
+field_names = ['Ex', 'Ey', 'Ez', 'Bx', 'By', 'Bz', 'jx', 'jy', 'jz']
+species_names = ['electrons', 'positrons']
+
+for shape in [1, 3]:
+    for gather in ['energy-conserving', 'momentum-conserving']:
+        name = 'shape{}_{}'.format(shape, gather)
+        options = 'algo.particle_shape={} algo.field_gathering={}'.format(shape, gather)
+        data = {}
+        for variant, variant_options in [('default', ''), ('simd', 'warpx.do_simd_field_gather=1')]:
+            prefix = 'diags/' + name + '_' + variant
+            post_processing_utils.run_warpx(
+                'inputs_3d', options + ' ' + variant_options + ' diag1.file_prefix=' + prefix)
+            data[variant] = post_processing_utils.load_fields_and_particles(
+                prefix + '000020', field_names, species_names)
+        post_processing_utils.check_relative_difference(
+            data['simd'], data['default'], tolerance, name)
+
+print('Passed')
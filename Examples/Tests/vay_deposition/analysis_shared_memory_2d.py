@@ -0,0 +1,52 @@
+#!/usr/bin/env python3
+
+# Copyright 2024 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This file is part of the WarpX automated test suite. It checks that the
+# shared-memory Vay deposition (warpx.do_shared_mem_current_deposition = 1
+# with algo.current_deposition = vay) gives the same results as the default
+# Vay deposition, up to round-off errors:
+# - Run the same 2D Langmuir wave with both depositions, for the particle
+#   shapes 1 and 3, and with half the default shared memory tile size
+# - Compare the fields and the particle momenta at the end of the simulations
+# The shared memory deposition is only available in GPU builds: in CPU builds,
+# only the default deposition is run.
+
+import re
+
+import post_processing_utils
+
+# The current of each tile is summed in shared memory before being added to
+# the global arrays, and these round-off errors are amplified over the 20 steps
+tolerance = 1.e-9
+
+common_options = ('max_step=20 diag1.intervals=20 algo.maxwell_solver=psatd amr.max_grid_size=128 '
+                  'algo.current_deposition=vay warpx.cfl=0.7071067811865475 '
+                  'diag1.electrons.variables=x z w ux uy uz diag1.positrons.variables=x z w ux uy uz '
+                  'diag1.fields_to_plot=Ex Ey Ez jx jy jz rho divE')
+field_names = ['Ex', 'Ey', 'Ez', 'jx', 'jy', 'jz']
+species_names = ['electrons', 'positrons']
+
+for shape in [1, 3]:
+    name = 'shape{}'.format(shape)
+    options = common_options + ' algo.particle_shape={}'.format(shape)
+    prefix = 'diags/' + name + '_default'
+    stdout = post_processing_utils.run_warpx('inputs_2d', options + ' diag1.file_prefix=' + prefix)
+    if not re.search(r'(CUDA|HIP) initialized', stdout):
+        print('CPU build: the shared memory deposition is not available')
+        continue
+    ref = post_processing_utils.load_fields_and_particles(prefix + '000020', field_names, species_names)
+    for itile, tilesize in enumerate(['', 'warpx.shared_tilesize=7 7']):
+        prefix = 'diags/' + name + '_shared{}'.format(itile)
+        post_processing_utils.run_warpx(
+            'inputs_2d', options + ' warpx.do_shared_mem_current_deposition=1 ' + tilesize +
+            ' diag1.file_prefix=' + prefix)
+        shared = post_processing_utils.load_fields_and_particles(
+            prefix + '000020', field_names, species_names)
+        post_processing_utils.check_relative_difference(shared, ref, tolerance, name + ' ' + tilesize)
+
+print('Passed')
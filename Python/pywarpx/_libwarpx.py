@@ -14,6 +14,7 @@
 
 import atexit
 import os
+import sys
 
 import numpy as np
 
@@ -30,6 +31,9 @@ class LibWarpX():
     def __init__(self):
         # Track whether amrex and warpx have been initialized
         self.initialized = False
+
+        # The mpi4py communicator of the simulation, when it does not run on all of MPI_COMM_WORLD
+        self.mpi_comm = None
         atexit.register(self.finalize)
 
         # set once libwarpx_so is loaded
@@ -119,7 +123,9 @@ class LibWarpX():
         if mpi_comm is None: # or MPI is None:
             self.libwarpx_so.amrex_init(argv)
         else:
-            raise Exception('mpi_comm argument not yet supported')
+            # mpi_comm is an mpi4py communicator, passed with its Fortran handle
+            self.mpi_comm = mpi_comm
+            self.libwarpx_so.amrex_init(argv, mpi_comm.py2f())
 
     def initialize(self, argv=None, mpi_comm=None):
         '''
@@ -143,6 +149,10 @@ class LibWarpX():
         '''
         # TODO: simplify, part of pyAMReX already
         if self.initialized:
+            # the asynchronous callbacks may still read WarpX data
+            from pywarpx import callbacks
+            callbacks.waitforasynccallbacks()
+
             del self.warpx
             # The call to warpx_finalize causes a crash - don't know why
             #self.libwarpx_so.warpx_finalize()
@@ -60,6 +60,32 @@ Example that calls the Python function ``myplots`` after each step:
    # run simulation
    sim.step(nsteps=100)
 
+Callbacks that only read data (e.g., for logging, inference or steering
+decisions) can instead be installed as asynchronous callbacks, with
+:py:func:`installasynccallback`. At the callback location, the optional
+``snapshot`` function is called synchronously and should copy the data that
+is needed (e.g., with ``.copy()`` on the arrays returned by the wrappers).
+The callback is then called with the result of ``snapshot`` on a worker
+thread, while the simulation continues. A callback location waits for its
+previous asynchronous callbacks to complete before it runs again, and
+:py:func:`waitforasynccallbacks` waits for all of them, e.g. before
+accessing shared state. Since the asynchronous callbacks run concurrently
+with the simulation, they must not access WarpX data directly, but only
+the data returned by ``snapshot``.
+
+.. code-block:: python3
+
+   from pywarpx import fields
+   from pywarpx.callbacks import installasynccallback
+
+   def snapshot():
+       return fields.ExWrapper()[...].copy()
+
+   def log_max(Ex):
+       print(abs(Ex).max())
+
+   installasynccallback('afterstep', log_max, snapshot=snapshot)
+
 The install can also be done using a `Python decorator <https://docs.python.org/3/glossary.html#term-decorator>`__, which has the prefix ``callfrom``.
 To use a decorator, the syntax is as follows. This will install the function ``myplots`` to be called after each step.
 The above example is quivalent to the following:
@@ -76,6 +102,7 @@ The above example is quivalent to the following:
    sim.step(nsteps=100)
 """
 
+import concurrent.futures
 import copy
 import sys
 import time
@@ -102,21 +129,29 @@ class CallbackFunctions(object):
 
     def __init__(self,name=None,lcallonce=0,singlefunconly=False):
         self.funcs = []
+        self.async_funcs = []
         self.time = 0.
         self.timers = {}
         self.name = name
         self.lcallonce = lcallonce
         self.singlefunconly = singlefunconly
+        self._executor = None
+        self._pending = []
 
     def __call__(self,*args,**kw):
         """Call all of the functions in the list"""
         tt = self.callfuncsinlist(*args,**kw)
+        tt += self.callasyncfuncsinlist()
         self.time = self.time + tt
-        if self.lcallonce: self.funcs = []
+        if self.lcallonce:
+            self.funcs = []
+            self.async_funcs = []
 
     def clearlist(self):
         """Unregister/clear out all registered C callbacks"""
+        self.wait()
         self.funcs = []
+        self.async_funcs = []
         libwarpx.libwarpx_so.remove_python_callback(self.name)
 
     def __bool__(self):
@@ -129,7 +164,7 @@ class CallbackFunctions(object):
 
     def hasfuncsinstalled(self):
         """Checks if there are any functions installed"""
-        return len(self.funcs) > 0
+        return len(self.funcs) > 0 or len(self.async_funcs) > 0
 
     def _getmethodobject(self,func):
         """For call backs that are methods, returns the method's instance"""
@@ -178,7 +213,7 @@ class CallbackFunctions(object):
                 f"Only one function can be installed for callback {self.name}."
             )
 
-        if len(self.funcs) == 0:
+        if not self.hasfuncsinstalled():
             # If this is the first function installed, set the callback in the C++
             # to call this class instance.
             libwarpx.libwarpx_so.add_python_callback(self.name, self)
@@ -253,6 +288,54 @@ class CallbackFunctions(object):
                     return 1
         return 0
 
+    def installasyncfuncinlist(self,f,snapshot=None):
+        """Install the function f, called asynchronously with the result of snapshot()"""
+        if self.singlefunconly:
+            raise RuntimeError(
+                f"Asynchronous functions cannot be installed for callback {self.name}."
+            )
+        if not self.hasfuncsinstalled():
+            libwarpx.libwarpx_so.add_python_callback(self.name, self)
+        self.async_funcs.append((f, snapshot))
+
+    def uninstallasyncfuncinlist(self,f):
+        """Uninstall the specified asynchronous function"""
+        self.wait()
+        for func in copy.copy(self.async_funcs):
+            if func[0] == f:
+                self.async_funcs.remove(func)
+                break
+        else:
+            raise Exception(f'Warning: no asynchronous function, {f}, had been installed')
+
+        # if there are no functions left, remove the C callback
+        if not self.hasfuncsinstalled():
+            self.clearlist()
+
+    def wait(self):
+        """Wait for the asynchronous functions of the previous call to complete"""
+        pending, self._pending = self._pending, []
+        for future in pending:
+            # re-raises the exception of the function, if any
+            future.result()
+
+    def callasyncfuncsinlist(self):
+        """Take the snapshots and submit the asynchronous functions"""
+        if len(self.async_funcs) == 0:
+            return 0.
+        bb = time.time()
+        self.wait()
+        if self._executor is None:
+            # a single worker keeps the calls of this location in order
+            self._executor = concurrent.futures.ThreadPoolExecutor(max_workers=1)
+        for f, snapshot in self.async_funcs:
+            if snapshot is None:
+                self._pending.append(self._executor.submit(f))
+            else:
+                self._pending.append(self._executor.submit(f, snapshot()))
+        aa = time.time()
+        return aa - bb
+
     def callfuncsinlist(self,*args,**kw):
         """Call the functions in the list"""
         bb = time.time()
@@ -305,6 +388,24 @@ def installcallback(name, f):
     """
     callback_instances[name].installfuncinlist(f)
 
+def installasynccallback(name, f, snapshot=None):
+    """Installs an asynchronous function to be called at that specified time.
+
+    At the callback location, snapshot() is called (if given), and f is then
+    called on a worker thread with its result. f must not access WarpX data
+    directly, since the simulation advances concurrently.
+    """
+    callback_instances[name].installasyncfuncinlist(f, snapshot)
+
+def uninstallasynccallback(name, f):
+    """Uninstalls the asynchronous function (so it won't be called anymore)"""
+    callback_instances[name].uninstallasyncfuncinlist(f)
+
+def waitforasynccallbacks():
+    """Waits for all the asynchronous callbacks to complete"""
+    for c in callback_instances.values():
+        c.wait()
+
 def uninstallcallback(name, f):
     """Uninstalls the function (so it won't be called anymore).
 
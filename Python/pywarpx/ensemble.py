@@ -0,0 +1,121 @@
+# Copyright 2024 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+"""Run an ensemble of independent simulations within one MPI job.
+
+The ranks of the job are split into groups of ``ranks_per_case`` ranks, each
+group running one simulation on its own sub-communicator. This avoids
+launching one job per simulation for parameter scans and optimizations of
+small (typically 1D or 2D) simulations: the cost of the job launch, of the
+MPI initialization and of the Python imports is paid once for the ensemble.
+Several groups can share a GPU, which should then be run with the NVIDIA
+Multi-Process Service (MPS) so that their kernels run concurrently.
+
+The results returned by each simulation are gathered with MPI on rank 0 of
+the job, without going through the file system.
+
+Typical use, with ``mpiexec -n 64 python scan.py``:
+
+.. code-block:: python
+
+   from mpi4py import MPI
+   from pywarpx import ensemble, picmi
+
+   def run_case(case, comm):
+       sim = make_simulation(**case)   # build the picmi.Simulation
+       sim.step(mpi_comm=comm)
+       return compute_objective(sim)   # any picklable object, from the group root
+
+   cases = [dict(density=n) for n in densities]
+   results = ensemble.run_ensemble(run_case, cases, ranks_per_case=1, gpus_per_node=4)
+   if MPI.COMM_WORLD.rank == 0:
+       print(results)
+
+Each process runs a single simulation, since WarpX holds its state in global
+objects: there must be at least as many groups as cases.
+"""
+
+import os
+
+
+def _select_device(comm_world, gpus_per_node):
+    """Distribute the ranks of a node round-robin among its GPUs, before AMReX
+    initializes the device. With MPS, several ranks then share each GPU."""
+    from mpi4py import MPI
+    node_comm = comm_world.Split_type(MPI.COMM_TYPE_SHARED)
+    device = str(node_comm.Get_rank() % gpus_per_node)
+    node_comm.Free()
+    for variable in ['CUDA_VISIBLE_DEVICES', 'ROCR_VISIBLE_DEVICES', 'ZE_AFFINITY_MASK']:
+        os.environ[variable] = device
+
+
+def run_ensemble(run_case, cases, ranks_per_case=1, gpus_per_node=None, comm=None):
+    """Run each case as an independent simulation on a sub-communicator.
+
+    Parameters
+    ----------
+    run_case: callable
+        ``run_case(case, comm)`` sets up and runs the simulation of one case
+        on the mpi4py communicator ``comm`` (to be passed to
+        ``picmi.Simulation.step(mpi_comm=comm)``), and returns its result.
+        The result of the root rank of the group is kept.
+
+    cases: list
+        The parameters of each case, passed to ``run_case``.
+
+    ranks_per_case: int, default=1
+        Number of MPI ranks of each simulation.
+
+    gpus_per_node: int, optional
+        If given, each rank only sees the GPU ``node_rank % gpus_per_node``,
+        so that the simulations are spread over the GPUs of the node.
+
+    comm: mpi4py communicator, optional
+        The communicator to split, by default MPI.COMM_WORLD.
+
+    Returns
+    -------
+    The list of the results of the cases on rank 0 of ``comm``, in the order of
+    ``cases``, and None on the other ranks. The result of a case that raised an
+    exception is the exception.
+    """
+    from mpi4py import MPI
+    if comm is None:
+        comm = MPI.COMM_WORLD
+
+    size = comm.Get_size()
+    rank = comm.Get_rank()
+    if size % ranks_per_case != 0:
+        raise ValueError(f'The number of ranks ({size}) must be a multiple of ranks_per_case ({ranks_per_case})')
+    ngroups = size // ranks_per_case
+    if len(cases) > ngroups:
+        raise ValueError(f'There are more cases ({len(cases)}) than groups of ranks ({ngroups}): '
+                         'each group can only run one simulation')
+
+    if gpus_per_node is not None:
+        _select_device(comm, gpus_per_node)
+
+    group = rank // ranks_per_case
+    group_comm = comm.Split(color=group, key=rank)
+
+    result = None
+    if group < len(cases):
+        try:
+            result = run_case(cases[group], group_comm)
+        except Exception as e:
+            result = e
+
+    # Only the root rank of each group contributes its result
+    is_group_root = (group_comm.Get_rank() == 0) and (group < len(cases))
+    gathered = comm.gather((group, result) if is_group_root else None, root=0)
+
+    if rank != 0:
+        return None
+    results = [None]*len(cases)
+    for item in gathered:
+        if item is not None:
+            results[item[0]] = item[1]
+    return results
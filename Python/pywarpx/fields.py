@@ -54,6 +54,7 @@ try:
     comm_world = mpi.COMM_WORLD
     npes = comm_world.Get_size()
 except ImportError:
+    comm_world = None
     npes = 1
 
 from ._libwarpx import libwarpx
@@ -305,6 +306,17 @@ class _MultiFABWrapper(object):
             device_arr = device_arr[tuple([slice(ng, -ng) for ng in nghosts[:self.dim]])]
         return device_arr
 
+    def get_local_arrays(self):
+        """Return a list of the arrays of the blocks on this process, one per box.
+
+        The arrays are not copied, but share the underlying memory buffer
+        with WarpX (cupy arrays for GPU runs when cupy is available, numpy
+        arrays otherwise). The arrays are fully writeable.
+        Each array has 4 dimensions, the last one being the component,
+        and includes the ghost cells if include_ghosts is True.
+        """
+        return [self._get_field(mfi) for mfi in self.mf]
+
     def _get_intersect_slice(self, mfi, starts, stops, icstart, icstop):
         """Return the slices where the block intersects with the global slice.
         If the block does not intersect, return None.
@@ -427,11 +439,13 @@ class _MultiFABWrapper(object):
                     slice_arr = slice_arr.get()
                 datalist.append((global_slices, slice_arr))
 
-        # Gather the data from all processors
-        if npes == 1:
+        # Gather the data from all processors of the simulation, which
+        # may run on a sub-communicator (see pywarpx.ensemble)
+        comm = libwarpx.mpi_comm if libwarpx.mpi_comm is not None else comm_world
+        if comm is None or comm.Get_size() == 1:
             all_datalist = [datalist]
         else:
-            all_datalist = comm_world.allgather(datalist)
+            all_datalist = comm.allgather(datalist)
 
         # Create the array to be returned
         result_shape = (max(0, ixstop - ixstart),
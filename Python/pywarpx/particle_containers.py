@@ -237,6 +237,41 @@ class ParticleContainerWrapper(object):
         return data_array
 
 
+    def get_particle_real_array_concatenated(self, comp_name, level=0):
+        '''
+        This returns a single numpy or cupy array containing the particle real
+        array data of all the tiles on this process, in the order of
+        get_particle_real_arrays().
+
+        The data of the tiles is concatenated on the device, without a copy
+        to the host. Since the array is a copy, changes to it are not
+        propagated to WarpX: use get_particle_real_arrays() to modify the data.
+
+        Parameters
+        ----------
+
+        comp_name      : str
+            The component of the array data that will be returned
+
+        level          : int
+            The refinement level to reference (default=0)
+
+        Returns
+        -------
+
+        Array
+            The requested particle array data
+        '''
+        xp, cupy_status = load_cupy()
+        if cupy_status is not None:
+            libwarpx.amr.Print(cupy_status)
+
+        data_array = self.get_particle_real_arrays(comp_name, level)
+        if len(data_array) == 0:
+            return xp.empty(0)
+        return xp.concatenate(data_array)
+
+
     def get_particle_int_arrays(self, comp_name, level, copy_to_host=False):
         '''
         This returns a list of numpy or cupy arrays containing the particle int array data
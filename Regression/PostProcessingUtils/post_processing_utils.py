@@ -6,6 +6,11 @@
 
 ## This file contains functions that are used in multiple CI analysis scripts.
 
+import glob
+import os
+import shlex
+import subprocess
+
 import numpy as np
 import yt
 
@@ -128,3 +133,52 @@ def check_random_filter(fn, filtered_fn, random_fraction, dim, species_name):
     random_filter_expression = 'np.isin(ids + 0.1*cpus,' \
                                           'ids_filtered_warpx + 0.1*cpus_filtered_warpx)'
     check_particle_filter(fn, filtered_fn, random_filter_expression, dim, species_name)
+
+## The functions below are used by the tests that run the WarpX executable themselves
+## (with customRunCmd), e.g. to compare an optional code path with the default one.
+
+## This function runs the WarpX executable of the test directory with the input file `inputs`
+## and the additional command-line parameters `options`, and returns its standard output.
+def run_warpx(inputs, options='', num_threads=None):
+    executables = glob.glob('*.ex')
+    assert(len(executables) == 1)
+    env = dict(os.environ)
+    if num_threads is not None:
+        env['OMP_NUM_THREADS'] = str(num_threads)
+    result = subprocess.run(['./' + executables[0], inputs] + shlex.split(options),
+                            env=env, capture_output=True, text=True)
+    print(result.stdout)
+    print(result.stderr)
+    assert(result.returncode == 0)
+    return result.stdout
+
+## This function returns a dictionary with the fields `field_names` of a plotfile, and the
+## particle quantities `particle_variables` (e.g. 'momentum_x') of the species `species_names`,
+## under the keys <species>_<variable>. The particles are sorted by the quantities `sort_by`
+## (the first one varies the slowest), so that the particles of two simulations can be compared.
+def load_fields_and_particles(fn, field_names=(), species_names=(),
+                              particle_variables=('momentum_x', 'momentum_y', 'momentum_z'),
+                              sort_by=('cpu', 'id')):
+    ds = yt.load(fn)
+    data = {}
+    if field_names:
+        grid = ds.covering_grid(level=0, left_edge=ds.domain_left_edge, dims=ds.domain_dimensions)
+        for field in field_names:
+            data[field] = grid['boxlib', field].to_ndarray()
+    ad = ds.all_data()
+    for species in species_names:
+        keys = [ad[species, 'particle_' + var].to_ndarray() for var in reversed(sort_by)]
+        order = np.lexsort(keys)
+        for var in particle_variables:
+            data[species + '_' + var] = ad[species, 'particle_' + var].to_ndarray()[order]
+    return data
+
+## This function checks that the arrays of the dictionaries `data` and `data_ref` (returned by
+## load_fields_and_particles) agree: their maximum difference, relative to the maximum of
+## data_ref, must be less than `tolerance`.
+def check_relative_difference(data, data_ref, tolerance, label=''):
+    for var in data_ref:
+        assert(data[var].shape == data_ref[var].shape)
+        error = np.max(np.abs(data[var] - data_ref[var])) / np.max(np.abs(data_ref[var]))
+        print(label, var, 'relative difference:', error)
+        assert(error < tolerance)
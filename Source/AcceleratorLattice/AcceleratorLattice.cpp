@@ -11,6 +11,10 @@
 #include "LatticeElements/Drift.H"
 #include "LatticeElements/HardEdgedQuadrupole.H"
 #include "LatticeElements/HardEdgedPlasmaLens.H"
+#include "LatticeElements/ThickMapElement.H"
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXAlgorithmSelection.H"
+#include "WarpX.H"
 
 #include <AMReX_REAL.H>
 
@@ -28,6 +32,15 @@ AcceleratorLattice::AcceleratorLattice ()
 
     h_quad.WriteToDevice();
     h_plasmalens.WriteToDevice();
+    h_thick.WriteToDevice();
+
+    if (h_thick.nelements > 0) {
+        // The maps are applied in the lab frame, in place of the explicit push
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(WarpX::gamma_boost == 1._rt,
+            "The thick lattice elements (thick_quad, dipole, solenoid) are not implemented in the boosted frame");
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(WarpX::evolve_scheme == EvolveScheme::Explicit,
+            "The thick lattice elements (thick_quad, dipole, solenoid) require the explicit evolve scheme");
+    }
 }
 
 void
@@ -65,6 +78,15 @@ AcceleratorLattice::ReadLattice (std::string const & root_name, amrex::ParticleR
         else if (element_type == "plasmalens") {
             h_plasmalens.AddElement(pp_element, z_location);
         }
+        else if (element_type == "thick_quad") {
+            h_thick.AddElement(pp_element, z_location, ThickMapElement::Quadrupole);
+        }
+        else if (element_type == "dipole") {
+            h_thick.AddElement(pp_element, z_location, ThickMapElement::Dipole);
+        }
+        else if (element_type == "solenoid") {
+            h_thick.AddElement(pp_element, z_location, ThickMapElement::Solenoid);
+        }
         else if (element_type == "line") {
             ReadLattice(element_name, z_location);
         }
@@ -76,32 +98,17 @@ AcceleratorLattice::ReadLattice (std::string const & root_name, amrex::ParticleR
 }
 
 void
-AcceleratorLattice::InitElementFinder (int const lev, amrex::BoxArray const & ba, amrex::DistributionMapping const & dm)
+AcceleratorLattice::InitElementFinder (int const lev)
 {
-    if (m_lattice_defined) {
-        m_element_finder = std::make_unique<amrex::LayoutData<LatticeElementFinder>>(ba, dm);
-        for (amrex::MFIter mfi(*m_element_finder); mfi.isValid(); ++mfi)
-        {
-            (*m_element_finder)[mfi].InitElementFinder(lev, mfi, *this);
-        }
-    }
-}
-
-void
-AcceleratorLattice::UpdateElementFinder (int const lev) // NOLINT(readability-make-member-function-const)
-{                                                       // Techniquely clang-tidy is correct because
-                                                        // m_element_finder is unique_ptr, not const*.
-    if (m_lattice_defined) {
-        for (amrex::MFIter mfi(*m_element_finder); mfi.isValid(); ++mfi)
-        {
-            (*m_element_finder)[mfi].UpdateIndices(lev, mfi, *this);
-        }
+    m_level = lev;
+    if (m_lattice_defined && !m_element_finder) {
+        m_element_finder = std::make_unique<LatticeElementFinder>();
+        m_element_finder->InitElementFinder(*this);
     }
 }
 
 LatticeElementFinderDevice
 AcceleratorLattice::GetFinderDeviceInstance (WarpXParIter const& a_pti, int const a_offset) const
 {
-    const LatticeElementFinder & finder = (*m_element_finder)[a_pti];
-    return finder.GetFinderDeviceInstance(a_pti, a_offset, *this);
+    return m_element_finder->GetFinderDeviceInstance(a_pti, a_offset, *this);
 }
@@ -8,71 +8,102 @@
 #include "LatticeElementFinder.H"
 #include "LatticeElements/HardEdgedQuadrupole.H"
 #include "LatticeElements/HardEdgedPlasmaLens.H"
+#include "LatticeElements/ThickMapElement.H"
 
+#include <AMReX_GpuContainers.H>
+#include <AMReX_GpuDevice.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX_REAL.H>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
 using namespace amrex::literals;
 
 void
-LatticeElementFinder::InitElementFinder (int const lev, amrex::MFIter const& a_mfi,
-                                         AcceleratorLattice const& accelerator_lattice)
+LatticeIndexTable::Define (std::vector<amrex::ParticleReal> const & zs,
+                           std::vector<amrex::ParticleReal> const & ze)
 {
+    m_nelements = static_cast<int>(zs.size());
+    if (m_nelements == 0) { return; }
+
+    // The region of each element extends up to the mid point of the gap with the next element.
+    // The first and last regions extend to infinity.
+    std::vector<amrex::ParticleReal> region_end(m_nelements);
+    for (int ie = 0; ie < m_nelements; ++ie) {
+        region_end[ie] = (ie < m_nelements - 1) ?
+            0.5_prt*(ze[ie] + zs[ie+1]) : std::numeric_limits<amrex::ParticleReal>::max();
+    }
 
-    // The lattice is assumed to extend in the z-direction
-    // Get the number of nodes where indices will be setup
-    const amrex::Box box = a_mfi.tilebox();
-    m_nz = box.size()[WARPX_ZINDEX];
-
-    m_dz = WarpX::CellSize(lev)[2];
-
-    m_gamma_boost = WarpX::gamma_boost;
-    m_uz_boost = std::sqrt(WarpX::gamma_boost*WarpX::gamma_boost - 1._prt)*PhysConst::c;
-
-    AllocateIndices(accelerator_lattice);
-
-    UpdateIndices(lev, a_mfi, accelerator_lattice);
+    // The table covers the lattice. With bins no larger than the shortest region, each bin
+    // overlaps at most two regions. The number of bins is limited, in which case the lookup
+    // may have to check a few more regions.
+    constexpr int max_nbins = 1 << 20;
+    m_zmin = zs[0];
+    const amrex::ParticleReal length = ze[m_nelements-1] - m_zmin;
+    amrex::ParticleReal shortest_region = length;
+    for (int ie = 0; ie < m_nelements - 1; ++ie) {
+        const amrex::ParticleReal region_start = (ie == 0) ? m_zmin : region_end[ie-1];
+        const amrex::ParticleReal region_length = region_end[ie] - region_start;
+        if (region_length > 0._prt) { shortest_region = std::min(shortest_region, region_length); }
+    }
+    m_nbins = 1;
+    if (length > 0._prt && shortest_region > 0._prt) {
+        m_nbins = static_cast<int>(std::min(std::ceil(length/shortest_region),
+                                            static_cast<amrex::ParticleReal>(max_nbins)));
+        m_nbins = std::max(m_nbins, 1);
+    }
+    m_dz = (length > 0._prt) ? length/static_cast<amrex::ParticleReal>(m_nbins) : 1._prt;
+
+    // First element whose region overlaps each bin, i.e. that contains the bin lower edge
+    std::vector<int> first_element(m_nbins);
+    int ie = 0;
+    for (int ibin = 0; ibin < m_nbins; ++ibin) {
+        const amrex::ParticleReal zbin = m_zmin + static_cast<amrex::ParticleReal>(ibin)*m_dz;
+        while (ie < m_nelements - 1 && zbin >= region_end[ie]) { ++ie; }
+        first_element[ibin] = ie;
+    }
 
+    d_first_element.resize(m_nbins);
+    d_region_end.resize(m_nelements);
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, first_element.begin(), first_element.end(),
+                          d_first_element.begin());
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, region_end.begin(), region_end.end(),
+                          d_region_end.begin());
+    amrex::Gpu::streamSynchronize();
 }
 
-void
-LatticeElementFinder::AllocateIndices (AcceleratorLattice const& accelerator_lattice)
+LatticeIndexTableDevice
+LatticeIndexTable::GetDeviceInstance () const
 {
-    // Allocate the space for the indices for each element type.
-    // Note that this uses m_nz since the information is saved per node.
-
-    if (accelerator_lattice.h_quad.nelements > 0) {
-        d_quad_indices.resize(m_nz);
-    }
-
-    if (accelerator_lattice.h_plasmalens.nelements > 0) {
-        d_plasmalens_indices.resize(m_nz);
-    }
+    LatticeIndexTableDevice result;
+    result.m_nelements = m_nelements;
+    result.m_nbins = m_nbins;
+    result.m_zmin = m_zmin;
+    result.m_dzi = 1._prt/m_dz;
+    result.m_first_element = d_first_element.data();
+    result.m_region_end = d_region_end.data();
+    return result;
 }
 
 void
-LatticeElementFinder::UpdateIndices (int const lev, amrex::MFIter const& a_mfi,
-                                     AcceleratorLattice const& accelerator_lattice)
+LatticeElementFinder::InitElementFinder (AcceleratorLattice const& accelerator_lattice)
 {
-    auto& warpx = WarpX::GetInstance();
-
-    // Update the location of the index grid.
-    // Note that the current box is used since the box may have been updated since
-    // the initialization in InitElementFinder.
-    const amrex::Box box = a_mfi.tilebox();
-    m_zmin = WarpX::LowerCorner(box, lev, 0._rt).z;
-    m_time = warpx.gett_new(lev);
-
+    // The lattice is assumed to extend in the z-direction.
+    // The tables are in the lab frame: they are built once, and the particle
+    // positions are transformed to the lab frame when looking up the elements.
     if (accelerator_lattice.h_quad.nelements > 0) {
-        setup_lattice_indices(accelerator_lattice.h_quad.d_zs,
-                              accelerator_lattice.h_quad.d_ze,
-                              d_quad_indices);
+        m_quad_table.Define(accelerator_lattice.h_quad.h_zs, accelerator_lattice.h_quad.h_ze);
     }
 
     if (accelerator_lattice.h_plasmalens.nelements > 0) {
-        setup_lattice_indices(accelerator_lattice.h_plasmalens.d_zs,
-                              accelerator_lattice.h_plasmalens.d_ze,
-                              d_plasmalens_indices);
+        m_plasmalens_table.Define(accelerator_lattice.h_plasmalens.h_zs, accelerator_lattice.h_plasmalens.h_ze);
+    }
+
+    if (accelerator_lattice.h_thick.nelements > 0) {
+        m_thick_table.Define(accelerator_lattice.h_thick.h_zs, accelerator_lattice.h_thick.h_ze);
     }
 }
 
@@ -104,66 +135,21 @@ LatticeElementFinderDevice::InitLatticeElementFinderDevice (WarpXParIter const&
 
     m_gamma_boost = WarpX::gamma_boost;
     m_uz_boost = std::sqrt(WarpX::gamma_boost*WarpX::gamma_boost - 1._prt)*PhysConst::c;
-
-    m_zmin = h_finder.m_zmin;
-    m_dz = h_finder.m_dz;
-    m_time = h_finder.m_time;
+    m_time = warpx.gett_new(lev);
 
     if (accelerator_lattice.h_quad.nelements > 0) {
         d_quad = accelerator_lattice.h_quad.GetDeviceInstance();
-        d_quad_indices_arr = h_finder.d_quad_indices.data();
+        d_quad_table = h_finder.m_quad_table.GetDeviceInstance();
     }
 
     if (accelerator_lattice.h_plasmalens.nelements > 0) {
         d_plasmalens = accelerator_lattice.h_plasmalens.GetDeviceInstance();
-        d_plasmalens_indices_arr = h_finder.d_plasmalens_indices.data();
+        d_plasmalens_table = h_finder.m_plasmalens_table.GetDeviceInstance();
     }
 
-}
-
-void
-LatticeElementFinder::setup_lattice_indices (amrex::Gpu::DeviceVector<amrex::ParticleReal> const & zs,
-                       amrex::Gpu::DeviceVector<amrex::ParticleReal> const & ze,
-                       amrex::Gpu::DeviceVector<int> & indices) const
-{
+    if (accelerator_lattice.h_thick.nelements > 0) {
+        d_thick = accelerator_lattice.h_thick.GetDeviceInstance();
+        d_thick_table = h_finder.m_thick_table.GetDeviceInstance();
+    }
 
-    using namespace amrex::literals;
-
-    const auto nelements = static_cast<int>(zs.size());
-    amrex::ParticleReal const * zs_arr = zs.data();
-    amrex::ParticleReal const * ze_arr = ze.data();
-    int * indices_arr = indices.data();
-
-    amrex::Real const zmin = m_zmin;
-    amrex::Real const dz = m_dz;
-
-    amrex::ParticleReal const gamma_boost = m_gamma_boost;
-    amrex::ParticleReal const uz_boost = m_uz_boost;
-    amrex::Real const time = m_time;
-
-    amrex::ParallelFor( m_nz,
-        [=] AMREX_GPU_DEVICE (int iz) {
-
-            // Get the location of the grid node
-            amrex::Real z_node = zmin + iz*dz;
-
-            if (gamma_boost > 1._prt) {
-                // Transform to lab frame
-                z_node = gamma_boost*z_node + uz_boost*time;
-            }
-
-            // Find the index to the element that is closest to the grid cell.
-            // For now, this assumes that there is no overlap among elements of the same type.
-            for (int ie = 0 ; ie < nelements ; ie++) {
-                // Find the mid points between element ie and the ones before and after it.
-                // The first and last element need special handling.
-                const amrex::ParticleReal zcenter_left = (ie == 0)?
-                    (std::numeric_limits<amrex::ParticleReal>::lowest()) : (0.5_prt*(ze_arr[ie-1] + zs_arr[ie]));
-                const amrex::ParticleReal zcenter_right = (ie < nelements - 1)?
-                    (0.5_prt*(ze_arr[ie] + zs_arr[ie+1])) : (std::numeric_limits<amrex::ParticleReal>::max());
-                if (zcenter_left <= z_node && z_node < zcenter_right) {
-                    indices_arr[iz] = ie;
-                }
-            }
-        });
 }
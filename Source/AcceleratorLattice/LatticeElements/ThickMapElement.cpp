@@ -0,0 +1,82 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "ThickMapElement.H"
+#include "Utils/Parser/ParserUtils.H"
+
+#include <AMReX_ParmParse.H>
+#include <AMReX_REAL.H>
+
+#include <string>
+
+ThickMapElement::ThickMapElement ()
+    : LatticeElementBase("thick")
+{
+}
+
+void
+ThickMapElement::AddElement (amrex::ParmParse & pp_element, amrex::ParticleReal & z_location,
+                             Kind const kind)
+{
+    using namespace amrex::literals;
+
+    AddElementBase(pp_element, z_location);
+
+    amrex::ParticleReal strength = 0._prt;
+    amrex::ParticleReal dEdx = 0._prt;
+    if (kind == Quadrupole) {
+        utils::parser::queryWithParser(pp_element, "dBdx", strength);
+        utils::parser::queryWithParser(pp_element, "dEdx", dEdx);
+    }
+    else if (kind == Dipole) {
+        utils::parser::getWithParser(pp_element, "By", strength);
+    }
+    else {
+        utils::parser::getWithParser(pp_element, "Bz", strength);
+    }
+
+    h_kind.push_back(kind);
+    h_strength.push_back(strength);
+    h_dEdx.push_back(dEdx);
+}
+
+void
+ThickMapElement::WriteToDevice ()
+{
+    WriteToDeviceBase();
+
+    d_kind.resize(h_kind.size());
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, h_kind.begin(), h_kind.end(), d_kind.begin());
+    d_strength.resize(h_strength.size());
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, h_strength.begin(), h_strength.end(), d_strength.begin());
+    d_dEdx.resize(h_dEdx.size());
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, h_dEdx.begin(), h_dEdx.end(), d_dEdx.begin());
+}
+
+ThickMapElementDevice
+ThickMapElement::GetDeviceInstance () const
+{
+    ThickMapElementDevice result;
+    result.InitThickMapElementDevice(*this);
+    return result;
+}
+
+void
+ThickMapElementDevice::InitThickMapElementDevice (ThickMapElement const& h_thick)
+{
+
+    nelements = h_thick.nelements;
+
+    if (nelements == 0) { return; }
+
+    d_zs_arr = h_thick.d_zs.data();
+    d_ze_arr = h_thick.d_ze.data();
+
+    d_kind_arr = h_thick.d_kind.data();
+    d_strength_arr = h_thick.d_strength.data();
+    d_dEdx_arr = h_thick.d_dEdx.data();
+
+}
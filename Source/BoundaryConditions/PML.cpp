@@ -10,6 +10,7 @@
 
 #include "BoundaryConditions/PML.H"
 #include "BoundaryConditions/PMLComponent.H"
+#include "Diagnostics/FieldIO.H"
 #include "FieldSolver/Fields.H"
 #ifdef WARPX_USE_FFT
 #   include "FieldSolver/SpectralSolver/SpectralFieldData.H"
@@ -22,6 +23,7 @@
 #include "WarpX.H"
 
 #include <ablastr/utils/Communication.H>
+#include <ablastr/utils/ScratchPool.H>
 
 #include <AMReX.H>
 #include <AMReX_Algorithm.H>
@@ -549,7 +551,7 @@ PML::PML (const int lev, const BoxArray& grid_ba,
           const Geometry* geom, const Geometry* cgeom,
           int ncell, int delta, amrex::IntVect ref_ratio,
           Real dt, int nox_fft, int noy_fft, int noz_fft, short grid_type,
-          int do_moving_window, int /*pml_has_particles*/, int do_pml_in_domain,
+          int do_moving_window, int pml_has_particles, int do_pml_in_domain,
           const int psatd_solution_type, const int J_in_time, const int rho_in_time,
           const bool do_pml_dive_cleaning, const bool do_pml_divb_cleaning,
           const amrex::IntVect& fill_guards_fields,
@@ -695,12 +697,17 @@ PML::PML (const int lev, const BoxArray& grid_ba,
     WarpX::AllocInitMultiFab(pml_B_fp[1], ba_By, dm, ncompb, ngb, lev, "pml_B_fp[y]", 0.0_rt);
     WarpX::AllocInitMultiFab(pml_B_fp[2], ba_Bz, dm, ncompb, ngb, lev, "pml_B_fp[z]", 0.0_rt);
 
-    const amrex::BoxArray ba_jx = amrex::convert(ba, WarpX::GetInstance().getField(FieldType::current_fp, 0,0).ixType().toIntVect());
-    const amrex::BoxArray ba_jy = amrex::convert(ba, WarpX::GetInstance().getField(FieldType::current_fp, 0,1).ixType().toIntVect());
-    const amrex::BoxArray ba_jz = amrex::convert(ba, WarpX::GetInstance().getField(FieldType::current_fp, 0,2).ixType().toIntVect());
-    WarpX::AllocInitMultiFab(pml_j_fp[0], ba_jx, dm, 1, ngb, lev, "pml_j_fp[x]", 0.0_rt);
-    WarpX::AllocInitMultiFab(pml_j_fp[1], ba_jy, dm, 1, ngb, lev, "pml_j_fp[y]", 0.0_rt);
-    WarpX::AllocInitMultiFab(pml_j_fp[2], ba_jz, dm, 1, ngb, lev, "pml_j_fp[z]", 0.0_rt);
+    // The current in the PML is only deposited (and read by EvolveEPML)
+    // when particles are allowed to enter the PML
+    if (pml_has_particles)
+    {
+        const amrex::BoxArray ba_jx = amrex::convert(ba, WarpX::GetInstance().getField(FieldType::current_fp, 0,0).ixType().toIntVect());
+        const amrex::BoxArray ba_jy = amrex::convert(ba, WarpX::GetInstance().getField(FieldType::current_fp, 0,1).ixType().toIntVect());
+        const amrex::BoxArray ba_jz = amrex::convert(ba, WarpX::GetInstance().getField(FieldType::current_fp, 0,2).ixType().toIntVect());
+        WarpX::AllocInitMultiFab(pml_j_fp[0], ba_jx, dm, 1, ngb, lev, "pml_j_fp[x]", 0.0_rt);
+        WarpX::AllocInitMultiFab(pml_j_fp[1], ba_jy, dm, 1, ngb, lev, "pml_j_fp[y]", 0.0_rt);
+        WarpX::AllocInitMultiFab(pml_j_fp[2], ba_jz, dm, 1, ngb, lev, "pml_j_fp[z]", 0.0_rt);
+    }
 
 #ifdef AMREX_USE_EB
     const amrex::IntVect max_guard_EB_vect = amrex::IntVect(max_guard_EB);
@@ -846,12 +853,15 @@ PML::PML (const int lev, const BoxArray& grid_ba,
             WarpX::AllocInitMultiFab( pml_G_cp, cba_G_nodal, cdm, 3, ngf, lev, "pml_G_cp", 0.0_rt);
         }
 
-        const amrex::BoxArray cba_jx = amrex::convert(cba, WarpX::GetInstance().getField(FieldType::current_cp, 1,0).ixType().toIntVect());
-        const amrex::BoxArray cba_jy = amrex::convert(cba, WarpX::GetInstance().getField(FieldType::current_cp, 1,1).ixType().toIntVect());
-        const amrex::BoxArray cba_jz = amrex::convert(cba, WarpX::GetInstance().getField(FieldType::current_cp, 1,2).ixType().toIntVect());
-        WarpX::AllocInitMultiFab(pml_j_cp[0], cba_jx, cdm, 1, ngb, lev, "pml_j_cp[x]", 0.0_rt);
-        WarpX::AllocInitMultiFab(pml_j_cp[1], cba_jy, cdm, 1, ngb, lev, "pml_j_cp[y]", 0.0_rt);
-        WarpX::AllocInitMultiFab(pml_j_cp[2], cba_jz, cdm, 1, ngb, lev, "pml_j_cp[z]", 0.0_rt);
+        if (pml_has_particles)
+        {
+            const amrex::BoxArray cba_jx = amrex::convert(cba, WarpX::GetInstance().getField(FieldType::current_cp, 1,0).ixType().toIntVect());
+            const amrex::BoxArray cba_jy = amrex::convert(cba, WarpX::GetInstance().getField(FieldType::current_cp, 1,1).ixType().toIntVect());
+            const amrex::BoxArray cba_jz = amrex::convert(cba, WarpX::GetInstance().getField(FieldType::current_cp, 1,2).ixType().toIntVect());
+            WarpX::AllocInitMultiFab(pml_j_cp[0], cba_jx, cdm, 1, ngb, lev, "pml_j_cp[x]", 0.0_rt);
+            WarpX::AllocInitMultiFab(pml_j_cp[1], cba_jy, cdm, 1, ngb, lev, "pml_j_cp[y]", 0.0_rt);
+            WarpX::AllocInitMultiFab(pml_j_cp[2], cba_jz, cdm, 1, ngb, lev, "pml_j_cp[z]", 0.0_rt);
+        }
 
         single_domain_box = is_single_box_domain ? cdomain : Box();
         sigba_cp = std::make_unique<MultiSigmaBox>(cba, cdm, grid_cba_reduced, cgeom->CellSize(),
@@ -1177,11 +1187,14 @@ PML::Exchange (MultiFab& pml, MultiFab& reg, const Geometry& geom,
     const auto& period = geom.periodicity();
 
     // Create temporary MultiFab to copy to and from the PML
-    MultiFab tmpregmf(reg.boxArray(), reg.DistributionMap(), ncp, ngr);
+    // (the temporaries come from the scratch pool, since this is done at every step)
+    ablastr::utils::scratch::ScratchMultiFab tmpregmf_scratch(reg.boxArray(), reg.DistributionMap(), ncp, ngr);
+    MultiFab& tmpregmf = *tmpregmf_scratch;
     tmpregmf.setVal(0.0);
 
     // Create the sum of the split fields, in the PML
-    MultiFab totpmlmf(pml.boxArray(), pml.DistributionMap(), 1, 0); // Allocate
+    ablastr::utils::scratch::ScratchMultiFab totpmlmf_scratch(pml.boxArray(), pml.DistributionMap(), 1, 0);
+    MultiFab& totpmlmf = *totpmlmf_scratch;
     MultiFab::LinComb(totpmlmf, 1.0, pml, 0, 1.0, pml, 1, 0, 1, 0); // Sum
     if (ncp == 3) {
         MultiFab::Add(totpmlmf,pml,2,0,1,0); // Sum the third split component
@@ -1344,26 +1357,26 @@ PML::CheckPoint (const std::string& dir) const
 }
 
 void
-PML::Restart (const std::string& dir)
+PML::Restart (const std::string& dir, const bool new_layout)
 {
     if (pml_E_fp[0])
     {
-        VisMF::Read(*pml_E_fp[0], dir+"_Ex_fp");
-        VisMF::Read(*pml_E_fp[1], dir+"_Ey_fp");
-        VisMF::Read(*pml_E_fp[2], dir+"_Ez_fp");
-        VisMF::Read(*pml_B_fp[0], dir+"_Bx_fp");
-        VisMF::Read(*pml_B_fp[1], dir+"_By_fp");
-        VisMF::Read(*pml_B_fp[2], dir+"_Bz_fp");
+        ReadMultiFab(*pml_E_fp[0], dir+"_Ex_fp", new_layout);
+        ReadMultiFab(*pml_E_fp[1], dir+"_Ey_fp", new_layout);
+        ReadMultiFab(*pml_E_fp[2], dir+"_Ez_fp", new_layout);
+        ReadMultiFab(*pml_B_fp[0], dir+"_Bx_fp", new_layout);
+        ReadMultiFab(*pml_B_fp[1], dir+"_By_fp", new_layout);
+        ReadMultiFab(*pml_B_fp[2], dir+"_Bz_fp", new_layout);
     }
 
     if (pml_E_cp[0])
     {
-        VisMF::Read(*pml_E_cp[0], dir+"_Ex_cp");
-        VisMF::Read(*pml_E_cp[1], dir+"_Ey_cp");
-        VisMF::Read(*pml_E_cp[2], dir+"_Ez_cp");
-        VisMF::Read(*pml_B_cp[0], dir+"_Bx_cp");
-        VisMF::Read(*pml_B_cp[1], dir+"_By_cp");
-        VisMF::Read(*pml_B_cp[2], dir+"_Bz_cp");
+        ReadMultiFab(*pml_E_cp[0], dir+"_Ex_cp", new_layout);
+        ReadMultiFab(*pml_E_cp[1], dir+"_Ey_cp", new_layout);
+        ReadMultiFab(*pml_E_cp[2], dir+"_Ez_cp", new_layout);
+        ReadMultiFab(*pml_B_cp[0], dir+"_Bx_cp", new_layout);
+        ReadMultiFab(*pml_B_cp[1], dir+"_By_cp", new_layout);
+        ReadMultiFab(*pml_B_cp[2], dir+"_Bz_cp", new_layout);
     }
 }
 
@@ -8,10 +8,12 @@
 #include "PML_RZ.H"
 
 #include "BoundaryConditions/PML_RZ.H"
+#include "Diagnostics/FieldIO.H"
 #include "FieldSolver/Fields.H"
 #ifdef WARPX_USE_FFT
 #   include "FieldSolver/SpectralSolver/SpectralFieldDataRZ.H"
 #endif
+#include "Utils/TextMsg.H"
 #include "Utils/WarpXConst.H"
 #include "WarpX.H"
 
@@ -27,6 +29,7 @@
 #include <AMReX_Geometry.H>
 #include <AMReX_IndexType.H>
 #include <AMReX_MFIter.H>
+#include <AMReX_ParmParse.H>
 #include <AMReX_RealVect.H>
 #include <AMReX_VisMF.H>
 
@@ -38,25 +41,52 @@ using namespace warpx::fields;
 
 PML_RZ::PML_RZ (const int lev, const amrex::BoxArray& grid_ba, const amrex::DistributionMapping& grid_dm,
                 const amrex::Geometry* geom, const int ncell, const int do_pml_in_domain)
-    : m_ncell(ncell),
+    : m_lev(lev),
+      m_ncell(ncell),
       m_do_pml_in_domain(do_pml_in_domain),
       m_geom(geom)
 {
+    const amrex::ParmParse pp_warpx("warpx");
+    pp_warpx.query("pml_rz_spectral_storage", m_spectral_storage);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!m_spectral_storage || !WarpX::do_moving_window,
+        "warpx.pml_rz_spectral_storage cannot be used with the moving window");
 
+    if (!m_spectral_storage) {
+        AllocateRealSpaceFields(grid_ba, grid_dm, pml_E_fp, pml_B_fp, true);
+    }
+}
+
+void
+PML_RZ::AllocateRealSpaceFields (const amrex::BoxArray& grid_ba, const amrex::DistributionMapping& grid_dm,
+                                 std::array<std::unique_ptr<amrex::MultiFab>,2>& pml_E,
+                                 std::array<std::unique_ptr<amrex::MultiFab>,2>& pml_B,
+                                 const bool register_fields) const
+{
+    const int lev = m_lev;
     const amrex::MultiFab & Er_fp = WarpX::GetInstance().getField(FieldType::Efield_fp, lev,0);
     const amrex::MultiFab & Et_fp = WarpX::GetInstance().getField(FieldType::Efield_fp, lev,1);
     const amrex::BoxArray ba_Er = amrex::convert(grid_ba, Er_fp.ixType().toIntVect());
     const amrex::BoxArray ba_Et = amrex::convert(grid_ba, Et_fp.ixType().toIntVect());
-    WarpX::AllocInitMultiFab(pml_E_fp[0], ba_Er, grid_dm, Er_fp.nComp(), Er_fp.nGrowVect(), lev, "pml_E_fp[0]", 0.0_rt);
-    WarpX::AllocInitMultiFab(pml_E_fp[1], ba_Et, grid_dm, Et_fp.nComp(), Et_fp.nGrowVect(), lev, "pml_E_fp[1]", 0.0_rt);
 
     const amrex::MultiFab & Br_fp = WarpX::GetInstance().getField(FieldType::Bfield_fp, lev,0);
     const amrex::MultiFab & Bt_fp = WarpX::GetInstance().getField(FieldType::Bfield_fp, lev,1);
     const amrex::BoxArray ba_Br = amrex::convert(grid_ba, Br_fp.ixType().toIntVect());
     const amrex::BoxArray ba_Bt = amrex::convert(grid_ba, Bt_fp.ixType().toIntVect());
-    WarpX::AllocInitMultiFab(pml_B_fp[0], ba_Br, grid_dm, Br_fp.nComp(), Br_fp.nGrowVect(), lev, "pml_B_fp[0]", 0.0_rt);
-    WarpX::AllocInitMultiFab(pml_B_fp[1], ba_Bt, grid_dm, Bt_fp.nComp(), Bt_fp.nGrowVect(), lev, "pml_B_fp[1]", 0.0_rt);
 
+    if (register_fields) {
+        WarpX::AllocInitMultiFab(pml_E[0], ba_Er, grid_dm, Er_fp.nComp(), Er_fp.nGrowVect(), lev, "pml_E_fp[0]", 0.0_rt);
+        WarpX::AllocInitMultiFab(pml_E[1], ba_Et, grid_dm, Et_fp.nComp(), Et_fp.nGrowVect(), lev, "pml_E_fp[1]", 0.0_rt);
+        WarpX::AllocInitMultiFab(pml_B[0], ba_Br, grid_dm, Br_fp.nComp(), Br_fp.nGrowVect(), lev, "pml_B_fp[0]", 0.0_rt);
+        WarpX::AllocInitMultiFab(pml_B[1], ba_Bt, grid_dm, Bt_fp.nComp(), Bt_fp.nGrowVect(), lev, "pml_B_fp[1]", 0.0_rt);
+    } else {
+        // temporaries, not registered in WarpX::multifab_map
+        pml_E[0] = std::make_unique<amrex::MultiFab>(ba_Er, grid_dm, Er_fp.nComp(), Er_fp.nGrowVect());
+        pml_E[1] = std::make_unique<amrex::MultiFab>(ba_Et, grid_dm, Et_fp.nComp(), Et_fp.nGrowVect());
+        pml_B[0] = std::make_unique<amrex::MultiFab>(ba_Br, grid_dm, Br_fp.nComp(), Br_fp.nGrowVect());
+        pml_B[1] = std::make_unique<amrex::MultiFab>(ba_Bt, grid_dm, Bt_fp.nComp(), Bt_fp.nGrowVect());
+        for (auto& mf : pml_E) { mf->setVal(0.0_rt); }
+        for (auto& mf : pml_B) { mf->setVal(0.0_rt); }
+    }
 }
 
 void
@@ -64,6 +94,27 @@ PML_RZ::ApplyDamping (amrex::MultiFab* Et_fp, amrex::MultiFab* Ez_fp,
                       amrex::MultiFab* Bt_fp, amrex::MultiFab* Bz_fp,
                       amrex::Real dt)
 {
+#ifdef WARPX_USE_FFT
+    if (m_spectral_storage) {
+        // the split fields are brought to real space for the damping only
+        std::array<std::unique_ptr<amrex::MultiFab>,2> pml_E;
+        std::array<std::unique_ptr<amrex::MultiFab>,2> pml_B;
+        AllocateRealSpaceFields(Et_fp->boxArray(), Et_fp->DistributionMap(), pml_E, pml_B, false);
+        SpectralToRealSpace(pml_E, pml_B);
+        ApplyDamping(Et_fp, Ez_fp, Bt_fp, Bz_fp, *pml_E[1], *pml_B[1], dt);
+        RealSpaceToSpectral(pml_E, pml_B);
+        return;
+    }
+#endif
+    ApplyDamping(Et_fp, Ez_fp, Bt_fp, Bz_fp, *pml_E_fp[1], *pml_B_fp[1], dt);
+}
+
+void
+PML_RZ::ApplyDamping (amrex::MultiFab* Et_fp, amrex::MultiFab* Ez_fp,
+                      amrex::MultiFab* Bt_fp, amrex::MultiFab* Bz_fp,
+                      amrex::MultiFab& pml_Et, amrex::MultiFab& pml_Bt,
+                      amrex::Real dt) const
+{
 
     const amrex::Real dr = m_geom->CellSize(0);
     const amrex::Real cdt_over_dr = PhysConst::c*dt/dr;
@@ -78,8 +129,8 @@ PML_RZ::ApplyDamping (amrex::MultiFab* Et_fp, amrex::MultiFab* Ez_fp,
         amrex::Array4<amrex::Real> const& Bt_arr = Bt_fp->array(mfi);
         amrex::Array4<amrex::Real> const& Bz_arr = Bz_fp->array(mfi);
 
-        amrex::Array4<amrex::Real> const& pml_Et_arr = pml_E_fp[1]->array(mfi);
-        amrex::Array4<amrex::Real> const& pml_Bt_arr = pml_B_fp[1]->array(mfi);
+        amrex::Array4<amrex::Real> const& pml_Et_arr = pml_Et.array(mfi);
+        amrex::Array4<amrex::Real> const& pml_Bt_arr = pml_Bt.array(mfi);
 
         // Get the tileboxes from Efield and Bfield so that they include the guard cells
         // They are all the same, cell centered
@@ -166,6 +217,22 @@ PML_RZ::FillBoundaryB (PatchType patch_type, std::optional<bool> nodal_sync)
 void
 PML_RZ::CheckPoint (const std::string& dir) const
 {
+#ifdef WARPX_USE_FFT
+    if (m_spectral_storage)
+    {
+        // the checkpoint has the same content as without the spectral storage
+        const amrex::MultiFab & Et_fp = WarpX::GetInstance().getField(FieldType::Efield_fp, m_lev, 1);
+        std::array<std::unique_ptr<amrex::MultiFab>,2> pml_E;
+        std::array<std::unique_ptr<amrex::MultiFab>,2> pml_B;
+        AllocateRealSpaceFields(Et_fp.boxArray(), Et_fp.DistributionMap(), pml_E, pml_B, false);
+        SpectralToRealSpace(pml_E, pml_B);
+        VisMF::Write(*pml_E[0], dir+"_Er_fp");
+        VisMF::Write(*pml_E[1], dir+"_Et_fp");
+        VisMF::Write(*pml_B[0], dir+"_Br_fp");
+        VisMF::Write(*pml_B[1], dir+"_Bt_fp");
+        return;
+    }
+#endif
     if (pml_E_fp[0])
     {
         VisMF::AsyncWrite(*pml_E_fp[0], dir+"_Er_fp");
@@ -176,14 +243,29 @@ PML_RZ::CheckPoint (const std::string& dir) const
 }
 
 void
-PML_RZ::Restart (const std::string& dir)
+PML_RZ::Restart (const std::string& dir, const bool new_layout)
 {
+#ifdef WARPX_USE_FFT
+    if (m_spectral_storage)
+    {
+        const amrex::MultiFab & Et_fp = WarpX::GetInstance().getField(FieldType::Efield_fp, m_lev, 1);
+        std::array<std::unique_ptr<amrex::MultiFab>,2> pml_E;
+        std::array<std::unique_ptr<amrex::MultiFab>,2> pml_B;
+        AllocateRealSpaceFields(Et_fp.boxArray(), Et_fp.DistributionMap(), pml_E, pml_B, false);
+        ReadMultiFab(*pml_E[0], dir+"_Er_fp", new_layout);
+        ReadMultiFab(*pml_E[1], dir+"_Et_fp", new_layout);
+        ReadMultiFab(*pml_B[0], dir+"_Br_fp", new_layout);
+        ReadMultiFab(*pml_B[1], dir+"_Bt_fp", new_layout);
+        RealSpaceToSpectral(pml_E, pml_B);
+        return;
+    }
+#endif
     if (pml_E_fp[0])
     {
-        VisMF::Read(*pml_E_fp[0], dir+"_Er_fp");
-        VisMF::Read(*pml_E_fp[1], dir+"_Et_fp");
-        VisMF::Read(*pml_B_fp[0], dir+"_Br_fp");
-        VisMF::Read(*pml_B_fp[1], dir+"_Bt_fp");
+        ReadMultiFab(*pml_E_fp[0], dir+"_Er_fp", new_layout);
+        ReadMultiFab(*pml_E_fp[1], dir+"_Et_fp", new_layout);
+        ReadMultiFab(*pml_B_fp[0], dir+"_Br_fp", new_layout);
+        ReadMultiFab(*pml_B_fp[1], dir+"_Bt_fp", new_layout);
     }
 }
 
@@ -206,16 +288,47 @@ PML_RZ::PushPMLPSATDSinglePatchRZ (
 {
     const SpectralFieldIndex& Idx = solver.m_spectral_index;
 
-    // Perform forward Fourier transforms
-    solver.ForwardTransform(lev, *pml_E[0], Idx.Er_pml, *pml_E[1], Idx.Et_pml);
-    solver.ForwardTransform(lev, *pml_B[0], Idx.Br_pml, *pml_B[1], Idx.Bt_pml);
+    // With the spectral storage, the split fields are already in spectral space
+    // (transformed back after the damping of the previous step)
+    if (!m_spectral_storage) {
+        // Perform forward Fourier transforms
+        solver.ForwardTransform(lev, *pml_E[0], Idx.Er_pml, *pml_E[1], Idx.Et_pml);
+        solver.ForwardTransform(lev, *pml_B[0], Idx.Br_pml, *pml_B[1], Idx.Bt_pml);
+    }
 
     // Advance fields in spectral space
     const bool doing_pml = true;
     solver.pushSpectralFields(doing_pml);
 
-    // Perform backward Fourier transforms
-    solver.BackwardTransform(lev, *pml_E[0], Idx.Er_pml, *pml_E[1], Idx.Et_pml);
-    solver.BackwardTransform(lev, *pml_B[0], Idx.Br_pml, *pml_B[1], Idx.Bt_pml);
+    if (!m_spectral_storage) {
+        // Perform backward Fourier transforms
+        solver.BackwardTransform(lev, *pml_E[0], Idx.Er_pml, *pml_E[1], Idx.Et_pml);
+        solver.BackwardTransform(lev, *pml_B[0], Idx.Br_pml, *pml_B[1], Idx.Bt_pml);
+    }
+}
+
+void
+PML_RZ::SpectralToRealSpace (std::array<std::unique_ptr<amrex::MultiFab>,2>& pml_E,
+                             std::array<std::unique_ptr<amrex::MultiFab>,2>& pml_B) const
+{
+    SpectralSolverRZ& solver = WarpX::GetInstance().get_spectral_solver_fp(m_lev);
+    const SpectralFieldIndex& Idx = solver.m_spectral_index;
+    solver.BackwardTransform(m_lev, *pml_E[0], Idx.Er_pml, *pml_E[1], Idx.Et_pml);
+    solver.BackwardTransform(m_lev, *pml_B[0], Idx.Br_pml, *pml_B[1], Idx.Bt_pml);
+
+    // the guard cells are used by the damping, as those of pml_E_fp and pml_B_fp
+    const amrex::Periodicity& period = m_geom->periodicity();
+    const Vector<amrex::MultiFab*> mf{pml_E[0].get(), pml_E[1].get(), pml_B[0].get(), pml_B[1].get()};
+    ablastr::utils::communication::FillBoundary(mf, WarpX::do_single_precision_comms, period);
+}
+
+void
+PML_RZ::RealSpaceToSpectral (std::array<std::unique_ptr<amrex::MultiFab>,2> const& pml_E,
+                             std::array<std::unique_ptr<amrex::MultiFab>,2> const& pml_B) const
+{
+    SpectralSolverRZ& solver = WarpX::GetInstance().get_spectral_solver_fp(m_lev);
+    const SpectralFieldIndex& Idx = solver.m_spectral_index;
+    solver.ForwardTransform(m_lev, *pml_E[0], Idx.Er_pml, *pml_E[1], Idx.Et_pml);
+    solver.ForwardTransform(m_lev, *pml_B[0], Idx.Br_pml, *pml_B[1], Idx.Bt_pml);
 }
 #endif
@@ -244,6 +244,8 @@ WarpX::DampJPML (int lev, PatchType patch_type)
     {
 
         const auto& pml_j = (patch_type == PatchType::fine) ? pml[lev]->Getj_fp() : pml[lev]->Getj_cp();
+        // The current is only allocated in the PML when it has particles
+        if (!pml_j[0]) { return; }
         const auto& sigba = (patch_type == PatchType::fine) ? pml[lev]->GetMultiSigmaBox_fp()
                                                             : pml[lev]->GetMultiSigmaBox_cp();
 
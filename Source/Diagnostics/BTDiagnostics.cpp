@@ -34,6 +34,7 @@
 #include <AMReX_CoordSys.H>
 #include <AMReX_DistributionMapping.H>
 #include <AMReX_FileSystem.H>
+#include <AMReX_GpuDevice.H>
 #include <AMReX_ParallelContext.H>
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParmParse.H>
@@ -44,6 +45,7 @@
 #include <cstdio>
 #include <memory>
 #include <sstream>
+#include <utility>
 #include <vector>
 
 using namespace amrex::literals;
@@ -262,6 +264,7 @@ BTDiagnostics::ReadParameters ()
         "For back-transformed diagnostics, user should specify either dz_snapshots_lab or dt_snapshots_lab");
 
     utils::parser::queryWithParser(pp_diag_name, "buffer_size", m_buffer_size);
+    pp_diag_name.query("spill_inactive_buffers", m_spill_inactive_buffers);
 #ifdef WARPX_DIM_RZ
     const amrex::Vector< std::string > BTD_varnames_supported = {"Er", "Et", "Ez",
                                                            "Br", "Bt", "Bz",
@@ -837,6 +840,16 @@ BTDiagnostics::PrepareFieldDataForOutput ()
                         DefineFieldBufferMultiFab(i_buffer, lev);
                     }
                 }
+#ifdef AMREX_USE_GPU
+                // The buffers of the snapshots whose z-slice is not back-transformed
+                // at this step are only read when they are flushed: keep them in pinned
+                // host memory, and move them back to the device when they are next updated
+                if (m_spill_inactive_buffers) {
+                    const bool buffer_updated = ZSliceInDomain && (m_snapshot_full[i_buffer] == 0);
+                    MoveFieldBufferToArena(i_buffer, lev,
+                        buffer_updated ? amrex::The_Arena() : amrex::The_Pinned_Arena());
+                }
+#endif
                 if (ZSliceInDomain) {
                     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
                         m_current_z_lab[i_buffer] >= m_buffer_domain_lab[i_buffer].lo(m_moving_window_dir) and
@@ -954,6 +967,20 @@ BTDiagnostics::DefineFieldBufferMultiFab (const int i_buffer, const int lev)
 }
 
 
+void
+BTDiagnostics::MoveFieldBufferToArena (const int i_buffer, const int lev, amrex::Arena* arena)
+{
+    amrex::MultiFab& mf = m_mf_output[i_buffer][lev];
+    if (!mf.ok() || mf.arena() == arena) { return; }
+
+    amrex::MultiFab moved(mf.boxArray(), mf.DistributionMap(), mf.nComp(), mf.nGrowVect(),
+                          amrex::MFInfo().SetArena(arena));
+    amrex::MultiFab::Copy(moved, mf, 0, 0, mf.nComp(), mf.nGrowVect());
+    // the copy must be complete before the memory of mf is released
+    amrex::Gpu::streamSynchronize();
+    mf = std::move(moved);
+}
+
 void
 BTDiagnostics::DefineSnapshotGeometry (const int i_buffer, const int lev)
 {
@@ -12,9 +12,13 @@
 #include "WarpX.H"
 
 #include <AMReX.H>
+#include <AMReX_Box.H>
+#include <AMReX_Geometry.H>
 #include <AMReX_Print.H>
 #include <AMReX_BaseFwd.H>
 
+#include <algorithm>
+
 SelectParticles::SelectParticles (const WarpXParIter& a_pti, TmpParticles& tmp_particle_data,
                                   amrex::Real current_z_boost, amrex::Real old_z_boost,
                                   int a_offset)
@@ -93,6 +97,16 @@ BackTransformParticleFunctor::operator () (PinnedMemoryParticleContainer& pc_dst
             pc_dst.DefineAndReturnParticleTile(lev, pti.index(), pti.LocalTileIndex() );
         }
 
+        // A particle that crosses the z-slice during this step moved by at most c*dt,
+        // so that its current position is within c*dt of the interval swept by the slice.
+        // Tiles that do not overlap this interval (with a margin of one cell) are skipped
+        // without inspecting their particles.
+        const amrex::Geometry& geom = warpx.Geom(lev);
+        const amrex::Real dz = geom.CellSize(WARPX_ZINDEX);
+        const amrex::Real z_margin = PhysConst::c*dt + dz;
+        const amrex::Real z_slice_min = std::min(m_old_z_boost[i_buffer], m_current_z_boost[i_buffer]) - z_margin;
+        const amrex::Real z_slice_max = std::max(m_old_z_boost[i_buffer], m_current_z_boost[i_buffer]) + z_margin;
+
         auto& particles = m_pc_src->GetParticles(lev);
 #ifdef AMREX_USE_OMP
 #pragma omp parallel
@@ -105,6 +119,11 @@ BackTransformParticleFunctor::operator () (PinnedMemoryParticleContainer& pc_dst
 
             for (WarpXParIter pti(*m_pc_src, lev); pti.isValid(); ++pti) {
 
+                const amrex::Box& tile_box = pti.tilebox();
+                const amrex::Real tile_z_min = geom.ProbLo(WARPX_ZINDEX) + tile_box.smallEnd(WARPX_ZINDEX)*dz;
+                const amrex::Real tile_z_max = geom.ProbLo(WARPX_ZINDEX) + (tile_box.bigEnd(WARPX_ZINDEX)+1)*dz;
+                if (tile_z_max < z_slice_min || tile_z_min > z_slice_max) { continue; }
+
                 auto index = std::make_pair(pti.index(), pti.LocalTileIndex());
 
                 const auto GetParticleFilter = SelectParticles(pti, tmp_particle_data,
@@ -51,7 +51,10 @@ ParticleReductionFunctor::operator() (amrex::MultiFab& mf_dst, const int dcomp,
     // the operations performend in the CoarsenAndInterpolate function.
     constexpr int ng = 1;
     // Temporary cell-centered, multi-component MultiFab for storing particles per cell.
-    amrex::MultiFab red_mf(warpx.boxArray(m_lev), warpx.DistributionMap(m_lev), 1, ng);
+    // When averaging, the second component stores the sum of the weights of the
+    // particles that are not filtered out, deposited in the same pass.
+    const bool do_average = m_do_average;
+    amrex::MultiFab red_mf(warpx.boxArray(m_lev), warpx.DistributionMap(m_lev), do_average ? 2 : 1, ng);
     auto& pc = warpx.GetPartContainer().GetParticleContainer(m_ispec);
     // Copy over member variables so they can be captured in the lambda
     auto map_fn = m_map_fn;
@@ -94,58 +97,21 @@ ParticleReductionFunctor::operator() (amrex::MultiFab& mf_dst, const int dcomp,
                 const bool filtered_out_flag = ((do_filter) && (filter_fn(xw, yw, zw, ux, uy, uz) == 0.0_prt));
                 const amrex::Real value = (filtered_out_flag) ? (0._rt):(map_fn(xw, yw, zw, ux, uy, uz));
                 amrex::Gpu::Atomic::AddNoRet(&out_array(ii, jj, kk, 0), (amrex::Real)(p.rdata(PIdx::w) * value));
+                if (do_average && !filtered_out_flag) {
+                    // Add the weight for each particle -- total number of particles of this species
+                    amrex::Gpu::Atomic::AddNoRet(&out_array(ii, jj, kk, 1), (amrex::Real)(p.rdata(PIdx::w)));
+                }
             });
-    if (m_do_average) {
-        amrex::MultiFab ppc_mf(warpx.boxArray(m_lev), warpx.DistributionMap(m_lev), 1, ng);
-        // Add the weight for each particle -- total number of particles of this species
-        ParticleToMesh(pc, ppc_mf, m_lev,
-                [=] AMREX_GPU_DEVICE (const WarpXParticleContainer::SuperParticleType& p,
-                    amrex::Array4<amrex::Real> const& out_array,
-                    amrex::GpuArray<amrex::Real,AMREX_SPACEDIM> const& plo,
-                    amrex::GpuArray<amrex::Real,AMREX_SPACEDIM> const& dxi)
-                {
-                    // Get position in WarpX convention to use in parser. Will be different from
-                    // p.pos() for 1D and 2D simulations.
-                    amrex::ParticleReal xw = 0._rt, yw = 0._rt, zw = 0._rt;
-                    get_particle_position(p, xw, yw, zw);
-
-                    // Get position in AMReX convention to calculate corresponding index.
-                    // Ideally this will be replaced with the AMReX NGP interpolator
-                    // Always do x direction. No RZ case because it's not implemented, and code
-                    // will have aborted
-                    int ii = 0, jj = 0, kk = 0;
-                    const amrex::ParticleReal x = p.pos(0);
-                    const amrex::Real lx = (x - plo[0]) * dxi[0];
-                    ii = static_cast<int>(amrex::Math::floor(lx));
-#if defined(WARPX_DIM_XZ) || defined(WARPX_DIM_3D)
-                    const amrex::ParticleReal y = p.pos(1);
-                    const amrex::Real ly = (y - plo[1]) * dxi[1];
-                    jj = static_cast<int>(amrex::Math::floor(ly));
-#endif
-#if defined(WARPX_DIM_3D)
-                    const amrex::ParticleReal z = p.pos(2);
-                    const amrex::Real lz = (z - plo[2]) * dxi[2];
-                    kk = static_cast<int>(amrex::Math::floor(lz));
-#endif
-                    // Fix dimensions since parser assumes u = gamma * v / c
-                    const amrex::ParticleReal ux = p.rdata(PIdx::ux) / PhysConst::c;
-                    const amrex::ParticleReal uy = p.rdata(PIdx::uy) / PhysConst::c;
-                    const amrex::ParticleReal uz = p.rdata(PIdx::uz) / PhysConst::c;
-                    amrex::Real filter;
-                    if ((do_filter) && (filter_fn(xw, yw, zw, ux, uy, uz) == 0._rt)) { filter = 0._rt;
-                    } else { filter = 1._rt; }
-                    amrex::Gpu::Atomic::AddNoRet(&out_array(ii, jj, kk, 0), (amrex::Real)(p.rdata(PIdx::w) * filter));
-                });
+    if (do_average) {
         // Divide value by number of particles for average. Set average to zero if there are no particles
         for (amrex::MFIter mfi(red_mf, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi)
         {
             const amrex::Box& box = mfi.tilebox();
             amrex::Array4<amrex::Real> const& a_red = red_mf.array(mfi);
-            amrex::Array4<amrex::Real const> const& a_ppc = ppc_mf.const_array(mfi);
             amrex::ParallelFor(box,
                     [=] AMREX_GPU_DEVICE (int i, int j, int k) {
-                        if (a_ppc(i,j,k,0) == 0) { a_red(i,j,k,0) = 0;
-                        } else { a_red(i,j,k,0) = a_red(i,j,k,0) / a_ppc(i,j,k,0); }
+                        if (a_red(i,j,k,1) == 0) { a_red(i,j,k,0) = 0;
+                        } else { a_red(i,j,k,0) = a_red(i,j,k,0) / a_red(i,j,k,1); }
                     });
         }
     }
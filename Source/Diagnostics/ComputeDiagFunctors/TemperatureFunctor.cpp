@@ -13,7 +13,11 @@
 #include <AMReX_BLassert.H>
 #include <AMReX_IntVect.H>
 #include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParticleReduce.H>
 #include <AMReX_REAL.H>
+#include <AMReX_Reduce.H>
+#include <AMReX_Vector.H>
 
 TemperatureFunctor::TemperatureFunctor (const int lev,
         const amrex::IntVect crse_ratio, const int ispec, const int ncomp)
@@ -43,9 +47,33 @@ TemperatureFunctor::operator() (amrex::MultiFab& mf_dst, const int dcomp, const
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(mass > 0.,
         "The temperature diagnostic can not be calculated for a massless species.");
 
-    // Calculate the averages in two steps, first the average velocity <u>, then the
-    // average velocity squared <u - <u>>**2. This method is more robust than the
-    // single step using <u**2> - <u>**2 when <u> >> u_rms.
+    // The temperature is calculated in a single pass over the particles, from the sums of
+    // the weights, of the velocities and of the velocities squared, with
+    // <(u - <u>)**2> = <(u - u0)**2> - <u - u0>**2. The velocities are shifted by the average
+    // velocity u0 of the whole species: this is as robust as subtracting the average velocity
+    // of each cell when <u> >> u_rms (e.g. for a drifting beam), and only needs a reduction
+    // over the particles, without deposition.
+    using PType = typename WarpXParticleContainer::SuperParticleType;
+    amrex::ReduceOps<amrex::ReduceOpSum, amrex::ReduceOpSum,
+                     amrex::ReduceOpSum, amrex::ReduceOpSum> reduce_ops;
+    auto r = amrex::ParticleReduce<amrex::ReduceData<amrex::Real, amrex::Real,
+                                                     amrex::Real, amrex::Real>>(
+        pc,
+        [=] AMREX_GPU_DEVICE (const PType& p) noexcept
+            -> amrex::GpuTuple<amrex::Real, amrex::Real, amrex::Real, amrex::Real>
+        {
+            const amrex::Real w = p.rdata(PIdx::w);
+            return {w, w*p.rdata(PIdx::ux), w*p.rdata(PIdx::uy), w*p.rdata(PIdx::uz)};
+        },
+        reduce_ops);
+    amrex::Vector<amrex::Real> u_sums{amrex::get<0>(r), amrex::get<1>(r),
+                                      amrex::get<2>(r), amrex::get<3>(r)};
+    amrex::ParallelDescriptor::ReduceRealSum(u_sums.data(), static_cast<int>(u_sums.size()));
+    const amrex::Real inv_w_tot = (u_sums[0] > 0._rt) ? 1._rt/u_sums[0] : 0._rt;
+    const amrex::Real ux0 = u_sums[1]*inv_w_tot;
+    const amrex::Real uy0 = u_sums[2]*inv_w_tot;
+    const amrex::Real uz0 = u_sums[3]*inv_w_tot;
+
     ParticleToMesh(pc, sum_mf, m_lev,
             [=] AMREX_GPU_DEVICE (const WarpXParticleContainer::SuperParticleType& p,
                 amrex::Array4<amrex::Real> const& out_array,
@@ -70,79 +98,20 @@ TemperatureFunctor::operator() (amrex::MultiFab& mf_dst, const int dcomp, const
                 kk = static_cast<int>(amrex::Math::floor(lz));
 #endif
 
-                const amrex::ParticleReal w  = p.rdata(PIdx::w);
-                const amrex::ParticleReal ux = p.rdata(PIdx::ux);
-                const amrex::ParticleReal uy = p.rdata(PIdx::uy);
-                const amrex::ParticleReal uz = p.rdata(PIdx::uz);
-                amrex::Gpu::Atomic::AddNoRet(&out_array(ii, jj, kk, 0), (amrex::Real)(w));
-                amrex::Gpu::Atomic::AddNoRet(&out_array(ii, jj, kk, 1), (amrex::Real)(w*ux));
-                amrex::Gpu::Atomic::AddNoRet(&out_array(ii, jj, kk, 2), (amrex::Real)(w*uy));
-                amrex::Gpu::Atomic::AddNoRet(&out_array(ii, jj, kk, 3), (amrex::Real)(w*uz));
-            });
-
-    // Divide value by number of particles for average
-    for (amrex::MFIter mfi(sum_mf, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi)
-    {
-        const amrex::Box& box = mfi.tilebox();
-        amrex::Array4<amrex::Real> const& out_array = sum_mf.array(mfi);
-        amrex::ParallelFor(box,
-                [=] AMREX_GPU_DEVICE (int i, int j, int k) {
-                    if (out_array(i,j,k,0) > 0) {
-                        const amrex::Real invsum = 1._rt/out_array(i,j,k,0);
-                        out_array(i,j,k,1) *= invsum;
-                        out_array(i,j,k,2) *= invsum;
-                        out_array(i,j,k,3) *= invsum;
-                    }
-                });
-    }
-
-    // Calculate the sum of the squares, subtracting the averages
-    // These loops must be written out since ParticleToMesh always zeros out the mf.
-    const auto plo = pc.Geom(m_lev).ProbLoArray();
-    const auto dxi = pc.Geom(m_lev).InvCellSizeArray();
-    for (WarpXParIter pti(pc, m_lev); pti.isValid(); ++pti)
-    {
-        const long np = pti.numParticles();
-        amrex::ParticleReal* wp = pti.GetAttribs(PIdx::w).dataPtr();
-        amrex::ParticleReal* uxp = pti.GetAttribs(PIdx::ux).dataPtr();
-        amrex::ParticleReal* uyp = pti.GetAttribs(PIdx::uy).dataPtr();
-        amrex::ParticleReal* uzp = pti.GetAttribs(PIdx::uz).dataPtr();
-
-        auto const GetPosition = GetParticlePosition<PIdx>(pti);
-
-        amrex::Array4<amrex::Real> const& out_array = sum_mf.array(pti);
-
-        amrex::ParallelFor(np,
-            [=] AMREX_GPU_DEVICE (long ip) {
-                // --- Get particle quantities
-                amrex::ParticleReal xp, yp, zp;
-                GetPosition.AsStored(ip, xp, yp, zp);
-
-                // Get position in AMReX convention to calculate corresponding index.
-                int ii = 0, jj = 0, kk = 0;
-                const amrex::Real lx = (xp - plo[0]) * dxi[0];
-                ii = static_cast<int>(amrex::Math::floor(lx));
-#if defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-                const amrex::Real lz = (zp - plo[1]) * dxi[1];
-                jj = static_cast<int>(amrex::Math::floor(lz));
-#elif defined(WARPX_DIM_3D)
-                const amrex::Real ly = (yp - plo[1]) * dxi[1];
-                jj = static_cast<int>(amrex::Math::floor(ly));
-                const amrex::Real lz = (zp - plo[2]) * dxi[2];
-                kk = static_cast<int>(amrex::Math::floor(lz));
-#endif
-
-                const amrex::ParticleReal w  = wp[ip];
-                const amrex::ParticleReal ux = uxp[ip] - out_array(ii, jj, kk, 1);
-                const amrex::ParticleReal uy = uyp[ip] - out_array(ii, jj, kk, 2);
-                const amrex::ParticleReal uz = uzp[ip] - out_array(ii, jj, kk, 3);
-                amrex::Gpu::Atomic::AddNoRet(&out_array(ii, jj, kk, 4), (amrex::Real)(w*ux*ux));
-                amrex::Gpu::Atomic::AddNoRet(&out_array(ii, jj, kk, 5), (amrex::Real)(w*uy*uy));
-                amrex::Gpu::Atomic::AddNoRet(&out_array(ii, jj, kk, 6), (amrex::Real)(w*uz*uz));
+                const amrex::Real w  = p.rdata(PIdx::w);
+                const amrex::Real ux = p.rdata(PIdx::ux) - ux0;
+                const amrex::Real uy = p.rdata(PIdx::uy) - uy0;
+                const amrex::Real uz = p.rdata(PIdx::uz) - uz0;
+                amrex::Gpu::Atomic::AddNoRet(&out_array(ii, jj, kk, 0), w);
+                amrex::Gpu::Atomic::AddNoRet(&out_array(ii, jj, kk, 1), w*ux);
+                amrex::Gpu::Atomic::AddNoRet(&out_array(ii, jj, kk, 2), w*uy);
+                amrex::Gpu::Atomic::AddNoRet(&out_array(ii, jj, kk, 3), w*uz);
+                amrex::Gpu::Atomic::AddNoRet(&out_array(ii, jj, kk, 4), w*ux*ux);
+                amrex::Gpu::Atomic::AddNoRet(&out_array(ii, jj, kk, 5), w*uy*uy);
+                amrex::Gpu::Atomic::AddNoRet(&out_array(ii, jj, kk, 6), w*uz*uz);
             });
-    }
 
-    // Divide the squares by number of particles for average and calculate the temperature
+    // Divide the sums by number of particles for averages and calculate the temperature
     for (amrex::MFIter mfi(sum_mf, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi)
     {
         const amrex::Box& box = mfi.tilebox();
@@ -151,10 +120,13 @@ TemperatureFunctor::operator() (amrex::MultiFab& mf_dst, const int dcomp, const
                 [=] AMREX_GPU_DEVICE (int i, int j, int k) {
                     if (out_array(i,j,k,0) > 0) {
                         const amrex::Real invsum = 1._rt/out_array(i,j,k,0);
-                        out_array(i,j,k,4) *= invsum;
-                        out_array(i,j,k,5) *= invsum;
-                        out_array(i,j,k,6) *= invsum;
-                        out_array(i,j,k,0) = mass*(out_array(i,j,k,4) + out_array(i,j,k,5) + out_array(i,j,k,6))/(3._rt*PhysConst::q_e);
+                        amrex::Real var_sum = 0._rt;
+                        for (int idir = 0; idir < 3; ++idir) {
+                            const amrex::Real u_ave = out_array(i,j,k,1+idir)*invsum;
+                            const amrex::Real u2_ave = out_array(i,j,k,4+idir)*invsum;
+                            var_sum += amrex::max(u2_ave - u_ave*u_ave, 0._rt);
+                        }
+                        out_array(i,j,k,0) = mass*var_sum/(3._rt*PhysConst::q_e);
                     }
                 });
     }
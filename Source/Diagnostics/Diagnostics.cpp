@@ -26,6 +26,7 @@
 #include <AMReX_BLassert.H>
 #include <AMReX_Config.H>
 #include <AMReX_Geometry.H>
+#include <AMReX_MFIter.H>
 #include <AMReX_MultiFab.H>
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParmParse.H>
@@ -33,6 +34,7 @@
 #include <AMReX_Vector.H>
 
 #include <algorithm>
+#include <cstdint>
 #include <string>
 
 using namespace amrex::literals;
@@ -76,8 +78,9 @@ Diagnostics::BaseReadParameters ()
     if (utils::algorithms::is_in(m_varnames_fields, "phi")){
         WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
             warpx.electrostatic_solver_id==ElectrostaticSolverAlgo::LabFrame ||
+            warpx.electrostatic_solver_id==ElectrostaticSolverAlgo::LabFrameEffectivePotential ||
             warpx.electrostatic_solver_id==ElectrostaticSolverAlgo::LabFrameElectroMagnetostatic,
-            "plot phi only works if do_electrostatic = labframe or do_electrostatic = labframe-electromagnetostatic");
+            "plot phi only works if do_electrostatic = labframe, labframe-effective-potential or labframe-electromagnetostatic");
     }
 
     // Sanity check if user requests to plot A
@@ -502,9 +505,9 @@ Diagnostics::InitBaseData ()
         m_flush_format = std::make_unique<FlushFormatPlotfile>() ;
     } else if (m_format == "checkpoint"){
         // creating checkpoint format
-        m_flush_format = std::make_unique<FlushFormatCheckpoint>() ;
+        m_flush_format = std::make_unique<FlushFormatCheckpoint>(m_diag_name);
     } else if (m_format == "ascent"){
-        m_flush_format = std::make_unique<FlushFormatAscent>();
+        m_flush_format = std::make_unique<FlushFormatAscent>(m_diag_name);
     } else if (m_format == "sensei"){
 #ifdef AMREX_USE_SENSEI_INSITU
         m_flush_format = std::make_unique<FlushFormatSensei>(
@@ -602,3 +605,33 @@ Diagnostics::FilterComputePackFlush (int step, bool force_flush)
         Flush(i_buffer, force_flush);
     }
 }
+
+amrex::Long
+Diagnostics::FieldBufferBytes () const
+{
+    amrex::Long bytes = 0;
+    for (const auto& buffer_mfs : m_mf_output) {
+        for (const auto& mf : buffer_mfs) {
+            if (!mf.ok()) { continue; }
+            for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi) {
+                bytes += static_cast<amrex::Long>(mf[mfi].nBytesOwned());
+            }
+        }
+    }
+    return bytes;
+}
+
+amrex::Long
+Diagnostics::ParticleBufferBytes () const
+{
+    amrex::Long bytes = 0;
+    for (const auto& buffer_pcs : m_particles_buffer) {
+        for (const auto& pc : buffer_pcs) {
+            if (!pc) { continue; }
+            const auto bytes_per_particle = static_cast<amrex::Long>(sizeof(std::uint64_t)
+                + pc->NumRealComps()*sizeof(amrex::ParticleReal) + pc->NumIntComps()*sizeof(int));
+            bytes += pc->TotalNumberOfParticles(false, true)*bytes_per_particle;
+        }
+    }
+    return bytes;
+}
@@ -15,6 +15,7 @@
 #include <AMReX_IntVect.H>
 #include <AMReX_MultiFab.H>
 #include <AMReX_SPACE.H>
+#include <AMReX_VisMF.H>
 
 #include <algorithm>
 #include <cstdint>
@@ -226,3 +227,25 @@ AverageAndPackScalarField (MultiFab& mf_avg,
         WARPX_ABORT_WITH_MESSAGE("Unknown staggering.");
     }
 }
+
+void
+ReadMultiFab( MultiFab& mf, const std::string& name, const bool new_layout )
+{
+    if (!new_layout) {
+        VisMF::Read(mf, name);
+        return;
+    }
+
+    // Read with the BoxArray of the file and a default DistributionMapping
+    MultiFab mf_file;
+    VisMF::Read(mf_file, name);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        mf_file.nComp() == mf.nComp() && mf_file.ixType() == mf.ixType(),
+        "ReadMultiFab: " + name + " does not match the field of the simulation");
+
+    // The guard cells are copied first, so that the valid cells of the file
+    // take precedence where they overlap with guard cells of other boxes
+    mf.setVal(0.0);
+    mf.ParallelCopy(mf_file, 0, 0, mf.nComp(), mf_file.nGrowVect(), mf.nGrowVect());
+    mf.ParallelCopy(mf_file, 0, 0, mf.nComp(), IntVect(0), mf.nGrowVect());
+}
@@ -5,10 +5,25 @@
 #include "Utils/WarpXProfilerWrapper.H"
 
 #include <AMReX.H>
+#include <AMReX_GpuDevice.H>
+#include <AMReX_ParmParse.H>
 #include <AMReX_REAL.H>
 
 using namespace amrex;
 
+FlushFormatAscent::FlushFormatAscent (const std::string& diag_name)
+{
+    // The blueprint wraps the data of the MultiFabs and particle containers without
+    // copy, so on GPU it holds device pointers: by default, let VTK-m use the device.
+#if defined(AMREX_USE_CUDA)
+    m_vtkm_backend = "cuda";
+#elif defined(AMREX_USE_HIP) || defined(AMREX_USE_SYCL)
+    m_vtkm_backend = "kokkos";
+#endif
+    const amrex::ParmParse pp_diag_name(diag_name);
+    pp_diag_name.query("ascent_vtkm_backend", m_vtkm_backend);
+}
+
 void
 FlushFormatAscent::WriteToFile (
     const amrex::Vector<std::string>& varnames,
@@ -51,10 +66,15 @@ FlushFormatAscent::WriteToFile (
     // WriteBlueprintFiles(bp_mesh,"bp_export",step,"hdf5");
 
     WARPX_PROFILE_VAR("FlushFormatAscent::WriteToFile::publish", prof_ascent_publish);
+    // Ascent reads the device data directly: it must be complete
+    amrex::Gpu::streamSynchronize();
     ascent::Ascent ascent;
     conduit::Node opts;
     opts["exceptions"] = "catch";
     opts["mpi_comm"] = MPI_Comm_c2f(ParallelDescriptor::Communicator());
+    if (!m_vtkm_backend.empty()) {
+        opts["runtime/vtkm/backend"] = m_vtkm_backend;
+    }
     ascent.open(opts);
     ascent.publish(bp_mesh);
     WARPX_PROFILE_VAR_STOP(prof_ascent_publish);
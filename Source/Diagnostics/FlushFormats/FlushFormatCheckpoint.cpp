@@ -1,17 +1,24 @@
 #include "FlushFormatCheckpoint.H"
 
 #include "BoundaryConditions/PML.H"
+#include "Diagnostics/ParticleCheckpointEncoding.H"
 #if (defined WARPX_DIM_RZ) && (defined WARPX_USE_FFT)
 #   include "BoundaryConditions/PML_RZ.H"
 #endif
 #include "Diagnostics/ParticleDiag/ParticleDiag.H"
+#include "Diagnostics/ReducedDiags/MultiReducedDiags.H"
 #include "FieldSolver/Fields.H"
 #include "Particles/WarpXParticleContainer.H"
+#include "Utils/Parser/ParserUtils.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXProfilerWrapper.H"
 #include "WarpX.H"
 
+#include <AMReX_AsyncOut.H>
+#include <AMReX_FileSystem.H>
 #include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
 #include <AMReX_ParticleIO.H>
 #include <AMReX_PlotFileUtil.H>
 #include <AMReX_Print.H>
@@ -25,6 +32,38 @@ using namespace warpx::fields;
 namespace
 {
     const std::string default_level_prefix {"Level_"};
+
+    /** Write a MultiFab of the checkpoint. With ``amrex.async_out = 1``, the data is
+     *  copied to host memory and written by the background IO thread of AMReX. */
+    void WriteMultiFab (const amrex::MultiFab& mf, const std::string& name)
+    {
+        if (amrex::AsyncOut::UseAsyncOut()) {
+            amrex::VisMF::AsyncWrite(mf, name);
+        } else {
+            amrex::VisMF::Write(mf, name);
+        }
+    }
+}
+
+FlushFormatCheckpoint::FlushFormatCheckpoint (const std::string& diag_name)
+{
+    const amrex::ParmParse pp_diag_name(diag_name);
+    pp_diag_name.query("keep_last_checkpoints", m_keep_last);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_keep_last >= 0,
+        diag_name + ".keep_last_checkpoints must be non-negative.");
+
+    std::string particle_compression = "none";
+    pp_diag_name.query("checkpoint_particle_compression", particle_compression);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        particle_compression == "none" || particle_compression == "zstd",
+        diag_name + ".checkpoint_particle_compression must be none or zstd.");
+    m_particle_compression = (particle_compression == "zstd");
+#ifndef WARPX_USE_ZSTD
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!m_particle_compression,
+        diag_name + ".checkpoint_particle_compression = zstd requires WarpX to be built with zstd (WarpX_ZSTD=ON).");
+#endif
+    utils::parser::queryWithParser(pp_diag_name, "checkpoint_particle_compression_level",
+                                   m_particle_compression_level);
 }
 
 void
@@ -47,6 +86,9 @@ FlushFormatCheckpoint::WriteToFile (
 
     auto & warpx = WarpX::GetInstance();
 
+    // a restart appends to the reduced diags files: write their buffered output first
+    if (warpx.reduced_diags) { warpx.reduced_diags->Flush(); }
+
     const VisMF::Header::Version current_version = VisMF::GetHeaderVersion();
     VisMF::SetHeaderVersion(amrex::VisMF::Header::NoFabHeader_v1);
 
@@ -64,86 +106,86 @@ FlushFormatCheckpoint::WriteToFile (
 
     for (int lev = 0; lev < nlev; ++lev)
     {
-        VisMF::Write(warpx.getField(FieldType::Efield_fp, lev, 0),
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ex_fp"));
-        VisMF::Write(warpx.getField(FieldType::Efield_fp, lev, 1),
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ey_fp"));
-        VisMF::Write(warpx.getField(FieldType::Efield_fp, lev, 2),
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ez_fp"));
-        VisMF::Write(warpx.getField(FieldType::Bfield_fp, lev, 0),
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bx_fp"));
-        VisMF::Write(warpx.getField(FieldType::Bfield_fp, lev, 1),
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "By_fp"));
-        VisMF::Write(warpx.getField(FieldType::Bfield_fp, lev, 2),
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bz_fp"));
+        WriteMultiFab(warpx.getField(FieldType::Efield_fp, lev, 0),
+                      amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ex_fp"));
+        WriteMultiFab(warpx.getField(FieldType::Efield_fp, lev, 1),
+                      amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ey_fp"));
+        WriteMultiFab(warpx.getField(FieldType::Efield_fp, lev, 2),
+                      amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ez_fp"));
+        WriteMultiFab(warpx.getField(FieldType::Bfield_fp, lev, 0),
+                      amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bx_fp"));
+        WriteMultiFab(warpx.getField(FieldType::Bfield_fp, lev, 1),
+                      amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "By_fp"));
+        WriteMultiFab(warpx.getField(FieldType::Bfield_fp, lev, 2),
+                      amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bz_fp"));
 
         if (WarpX::fft_do_time_averaging)
         {
-            VisMF::Write(warpx.getField(FieldType::Efield_avg_fp, lev, 0),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ex_avg_fp"));
-            VisMF::Write(warpx.getField(FieldType::Efield_avg_fp, lev, 1),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ey_avg_fp"));
-            VisMF::Write(warpx.getField(FieldType::Efield_avg_fp, lev, 2),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ez_avg_fp"));
-
-            VisMF::Write(warpx.getField(FieldType::Bfield_avg_fp, lev, 0),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bx_avg_fp"));
-            VisMF::Write(warpx.getField(FieldType::Bfield_avg_fp, lev, 1),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "By_avg_fp"));
-            VisMF::Write(warpx.getField(FieldType::Bfield_avg_fp, lev, 2),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bz_avg_fp"));
+            WriteMultiFab(warpx.getField(FieldType::Efield_avg_fp, lev, 0),
+                          amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ex_avg_fp"));
+            WriteMultiFab(warpx.getField(FieldType::Efield_avg_fp, lev, 1),
+                          amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ey_avg_fp"));
+            WriteMultiFab(warpx.getField(FieldType::Efield_avg_fp, lev, 2),
+                          amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ez_avg_fp"));
+
+            WriteMultiFab(warpx.getField(FieldType::Bfield_avg_fp, lev, 0),
+                          amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bx_avg_fp"));
+            WriteMultiFab(warpx.getField(FieldType::Bfield_avg_fp, lev, 1),
+                          amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "By_avg_fp"));
+            WriteMultiFab(warpx.getField(FieldType::Bfield_avg_fp, lev, 2),
+                          amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bz_avg_fp"));
         }
 
         if (warpx.getis_synchronized()) {
             // Need to save j if synchronized because after restart we need j to evolve E by dt/2.
-            VisMF::Write(warpx.getField(FieldType::current_fp, lev, 0),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jx_fp"));
-            VisMF::Write(warpx.getField(FieldType::current_fp, lev, 1),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jy_fp"));
-            VisMF::Write(warpx.getField(FieldType::current_fp, lev, 2),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jz_fp"));
+            WriteMultiFab(warpx.getField(FieldType::current_fp, lev, 0),
+                          amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jx_fp"));
+            WriteMultiFab(warpx.getField(FieldType::current_fp, lev, 1),
+                          amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jy_fp"));
+            WriteMultiFab(warpx.getField(FieldType::current_fp, lev, 2),
+                          amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jz_fp"));
         }
 
         if (lev > 0)
         {
-            VisMF::Write(warpx.getField(FieldType::Efield_cp, lev, 0),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ex_cp"));
-            VisMF::Write(warpx.getField(FieldType::Efield_cp, lev, 1),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ey_cp"));
-            VisMF::Write(warpx.getField(FieldType::Efield_cp, lev, 2),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ez_cp"));
-            VisMF::Write(warpx.getField(FieldType::Bfield_cp, lev, 0),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bx_cp"));
-            VisMF::Write(warpx.getField(FieldType::Bfield_cp, lev, 1),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "By_cp"));
-            VisMF::Write(warpx.getField(FieldType::Bfield_cp, lev, 2),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bz_cp"));
+            WriteMultiFab(warpx.getField(FieldType::Efield_cp, lev, 0),
+                          amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ex_cp"));
+            WriteMultiFab(warpx.getField(FieldType::Efield_cp, lev, 1),
+                          amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ey_cp"));
+            WriteMultiFab(warpx.getField(FieldType::Efield_cp, lev, 2),
+                          amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ez_cp"));
+            WriteMultiFab(warpx.getField(FieldType::Bfield_cp, lev, 0),
+                          amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bx_cp"));
+            WriteMultiFab(warpx.getField(FieldType::Bfield_cp, lev, 1),
+                          amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "By_cp"));
+            WriteMultiFab(warpx.getField(FieldType::Bfield_cp, lev, 2),
+                          amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bz_cp"));
 
             if (WarpX::fft_do_time_averaging)
             {
-                VisMF::Write(warpx.getField(FieldType::Efield_avg_cp, lev, 0),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ex_avg_cp"));
-                VisMF::Write(warpx.getField(FieldType::Efield_avg_cp, lev, 1),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ey_avg_cp"));
-                VisMF::Write(warpx.getField(FieldType::Efield_avg_cp, lev, 2),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ez_avg_cp"));
-
-                VisMF::Write(warpx.getField(FieldType::Bfield_avg_cp, lev, 0),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bx_avg_cp"));
-                VisMF::Write(warpx.getField(FieldType::Bfield_avg_cp, lev, 1),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "By_avg_cp"));
-                VisMF::Write(warpx.getField(FieldType::Bfield_avg_cp, lev, 2),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bz_avg_cp"));
+                WriteMultiFab(warpx.getField(FieldType::Efield_avg_cp, lev, 0),
+                              amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ex_avg_cp"));
+                WriteMultiFab(warpx.getField(FieldType::Efield_avg_cp, lev, 1),
+                              amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ey_avg_cp"));
+                WriteMultiFab(warpx.getField(FieldType::Efield_avg_cp, lev, 2),
+                              amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ez_avg_cp"));
+
+                WriteMultiFab(warpx.getField(FieldType::Bfield_avg_cp, lev, 0),
+                              amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bx_avg_cp"));
+                WriteMultiFab(warpx.getField(FieldType::Bfield_avg_cp, lev, 1),
+                              amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "By_avg_cp"));
+                WriteMultiFab(warpx.getField(FieldType::Bfield_avg_cp, lev, 2),
+                              amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bz_avg_cp"));
             }
 
             if (warpx.getis_synchronized()) {
                 // Need to save j if synchronized because after restart we need j to evolve E by dt/2.
-                VisMF::Write(warpx.getField(FieldType::current_cp, lev, 0),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jx_cp"));
-                VisMF::Write(warpx.getField(FieldType::current_cp, lev, 1),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jy_cp"));
-                VisMF::Write(warpx.getField(FieldType::current_cp, lev, 2),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jz_cp"));
+                WriteMultiFab(warpx.getField(FieldType::current_cp, lev, 0),
+                              amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jx_cp"));
+                WriteMultiFab(warpx.getField(FieldType::current_cp, lev, 1),
+                              amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jy_cp"));
+                WriteMultiFab(warpx.getField(FieldType::current_cp, lev, 2),
+                              amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jz_cp"));
             }
         }
 
@@ -167,6 +209,35 @@ FlushFormatCheckpoint::WriteToFile (
 
     VisMF::SetHeaderVersion(current_version);
 
+    RemoveOldCheckpoints(checkpointname);
+}
+
+void
+FlushFormatCheckpoint::RemoveOldCheckpoints (const std::string& checkpointname) const
+{
+    if (m_keep_last == 0) { return; }
+
+    // A diagnostic can write the same step twice (e.g. with dump_last_timestep)
+    if (m_written.empty() || m_written.back() != checkpointname) {
+        m_written.push_back(checkpointname);
+    }
+
+    while (static_cast<int>(m_written.size()) > m_keep_last) {
+        const std::string old_checkpoint = m_written.front();
+        m_written.pop_front();
+        auto remove = [old_checkpoint] () {
+            if (amrex::ParallelDescriptor::IOProcessor()) {
+                amrex::FileSystem::RemoveAll(old_checkpoint);
+            }
+        };
+        if (amrex::AsyncOut::UseAsyncOut()) {
+            // The IO thread runs its tasks in order: the checkpoint is removed
+            // only once the writes submitted before are complete.
+            amrex::AsyncOut::Submit(remove);
+        } else {
+            remove();
+        }
+    }
 }
 
 void
@@ -203,8 +274,18 @@ FlushFormatCheckpoint::CheckpointParticles (
         auto runtime_inames = pc->getParticleRuntimeiComps();
         for (auto const& x : runtime_inames) { int_names[x.second+0] = x.first; }
 
-        pc->Checkpoint(dir, part_diag.getSpeciesName(), true,
-                       real_names, int_names);
+        if (m_particle_compression) {
+            // the AMReX header, with the names of the components and the next id,
+            // but no particles: these are encoded separately
+            auto empty_pc = pc->make_alike<amrex::PinnedArenaAllocator>();
+            empty_pc.Checkpoint(dir, part_diag.getSpeciesName(), true,
+                                real_names, int_names);
+            WriteEncodedParticles(*pc, dir, part_diag.getSpeciesName(),
+                                  m_particle_compression_level);
+        } else {
+            pc->Checkpoint(dir, part_diag.getSpeciesName(), true,
+                           real_names, int_names);
+        }
     }
 }
 
@@ -1,5 +1,6 @@
 #include "FlushFormatOpenPMD.H"
 
+#include "Utils/Parser/ParserUtils.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXProfilerWrapper.H"
 #include "Diagnostics/OpenPMDHelpFunction.H"
@@ -46,8 +47,22 @@ FlushFormatOpenPMD::FlushFormatOpenPMD (const std::string& diag_name)
         encoding = openPMD::IterationEncoding::fileBased;
     }
 
+    // ADIOS2 SST: the data is streamed in memory to a reader, each output being
+    // published as one step of a single series
+    const bool is_stream = (openpmd_backend == "sst");
+    if (is_stream && encoding != openPMD::IterationEncoding::variableBased) {
+        if (encodingDefined) {
+            ablastr::warn_manager::WMRecordWarning("Diagnostics",
+                diag_name + ": streaming with the sst backend requires the variable based "
+                "encoding, which is used instead of the requested one");
+        }
+        encoding = openPMD::IterationEncoding::variableBased;
+    }
+
     std::string diag_type_str;
     pp_diag_name.get("diag_type", diag_type_str);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!is_stream || diag_type_str != "BackTransformed",
+        diag_name + ": BackTransformed diagnostics can not be streamed with the sst backend");
     if (diag_type_str == "BackTransformed")
     {
         if ( ( openPMD::IterationEncoding::fileBased != encoding ) &&
@@ -88,6 +103,22 @@ FlushFormatOpenPMD::FlushFormatOpenPMD (const std::string& diag_name)
         operator_parameters.insert({k, v});
     }
 
+    // ADIOS2 operator type & parameters for the field meshes only
+    std::string fields_operator_type;
+    pp_diag_name.query("adios2_fields_operator.type", fields_operator_type);
+    std::string const fields_prefix = diag_name + ".adios2_fields_operator.parameters";
+    const ParmParse ppf;
+    auto fields_entr = amrex::ParmParse::getEntries(fields_prefix);
+
+    std::map< std::string, std::string > fields_operator_parameters;
+    auto const fields_prefix_len = fields_prefix.size() + 1;
+    for (std::string k : fields_entr) {
+        std::string v;
+        ppf.get(k.c_str(), v);
+        k.erase(0, fields_prefix_len);
+        fields_operator_parameters.insert({k, v});
+    }
+
     // ADIOS2 engine type & parameters
     std::string engine_type;
     pp_diag_name.query("adios2_engine.type", engine_type);
@@ -104,13 +135,48 @@ FlushFormatOpenPMD::FlushFormatOpenPMD (const std::string& diag_name)
         engine_parameters.insert({k, v});
     }
 
+    if (is_stream) {
+        // number of steps buffered for the readers: when the queue is full, the
+        // publication of a step blocks until a reader releases one, or a
+        // step is discarded (the explicit engine parameters take precedence)
+        int stream_queue_limit = 1;
+        utils::parser::queryWithParser(pp_diag_name, "openpmd_stream_queue_limit", stream_queue_limit);
+        std::string stream_queue_full_policy = "Block";
+        pp_diag_name.query("openpmd_stream_queue_full_policy", stream_queue_full_policy);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            stream_queue_full_policy == "Block" || stream_queue_full_policy == "Discard",
+            diag_name + ".openpmd_stream_queue_full_policy must be Block or Discard");
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(stream_queue_limit >= 0,
+            diag_name + ".openpmd_stream_queue_limit must be non-negative");
+        engine_parameters.insert({"QueueLimit", std::to_string(stream_queue_limit)});
+        engine_parameters.insert({"QueueFullPolicy", stream_queue_full_policy});
+    }
+
+    // write the data to disk in a background thread, from pinned copies
+    bool openpmd_async_flush = false;
+    pp_diag_name.query("openpmd_async_flush", openpmd_async_flush);
+    // above this amount of staged data (in MB), a step is written synchronously
+    double openpmd_async_max_staging_mb = 0.;
+    pp_diag_name.query("openpmd_async_max_staging_mb", openpmd_async_max_staging_mb);
+    // write the particles of all the tiles of a rank as one chunk per record component
+    bool openpmd_pack_particles = true;
+    pp_diag_name.query("openpmd_pack_particles", openpmd_pack_particles);
+    // keep the pinned copies of the species from one output to the next
+    bool openpmd_reuse_particle_staging = false;
+    pp_diag_name.query("openpmd_reuse_particle_staging", openpmd_reuse_particle_staging);
+
     auto & warpx = WarpX::GetInstance();
     m_OpenPMDPlotWriter = std::make_unique<WarpXOpenPMDPlot>(
         encoding, openpmd_backend,
         operator_type, operator_parameters,
+        fields_operator_type, fields_operator_parameters,
         engine_type, engine_parameters,
         warpx.getPMLdirections(),
-        warpx.GetAuthors()
+        warpx.GetAuthors(),
+        openpmd_async_flush,
+        static_cast<amrex::Long>(openpmd_async_max_staging_mb*1024.*1024.),
+        openpmd_pack_particles,
+        openpmd_reuse_particle_staging
     );
 }
 
@@ -2,6 +2,7 @@
 
 #include "FieldSolver/Fields.H"
 #include "Diagnostics/MultiDiagnostics.H"
+#include "Diagnostics/ParticleDiag/CopySelectedParticles.H"
 #include "Diagnostics/ParticleDiag/ParticleDiag.H"
 #include "Particles/Filter/FilterFunctors.H"
 #include "Particles/WarpXParticleContainer.H"
@@ -407,7 +408,8 @@ FlushFormatPlotfile::WriteParticles(const std::string& dir,
         if (!isBTD) {
             particlesConvertUnits(ConvertDirection::WarpX_to_SI, pc, mass);
             using SrcData = WarpXParticleContainer::ParticleTileType::ConstParticleTileDataType;
-            tmp.copyParticles(*pc,
+            // only the selected particles and the written components are copied to pinned memory
+            copySelectedParticles(tmp, *pc,
                               [random_filter,uniform_filter,parser_filter,geometry_filter]
                               AMREX_GPU_HOST_DEVICE
                               (const SrcData& src, int ip, const amrex::RandomEngine& engine)
@@ -415,7 +417,7 @@ FlushFormatPlotfile::WriteParticles(const std::string& dir,
                 const SuperParticleType& p = src.getSuperParticle(ip);
                 return random_filter(p, engine) * uniform_filter(p, engine)
                     * parser_filter(p, engine) * geometry_filter(p, engine);
-            }, true);
+            }, part_diag.m_plot_flags);
             particlesConvertUnits(ConvertDirection::SI_to_WarpX, pc, mass);
         } else {
             tmp.copyParticles(*pinned_pc, true);
@@ -0,0 +1,293 @@
+/* Copyright 2026 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "ParticleCheckpointEncoding.H"
+
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXProfilerWrapper.H"
+
+#include <AMReX_GpuContainers.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_REAL.H>
+#include <AMReX_Scan.H>
+#include <AMReX_Utility.H>
+
+#ifdef WARPX_USE_ZSTD
+#   include <zstd.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace amrex;
+
+namespace
+{
+    //! "WPXPENC1", at the beginning of each encoded file
+    constexpr std::uint64_t encoded_magic = 0x57505850454e4331;
+    constexpr int encoded_version = 1;
+
+    std::string encodedDir (std::string const& dir, std::string const& name)
+    {
+        return dir + "/" + name + "/encoded";
+    }
+
+    std::string encodedFileName (std::string const& dir, std::string const& name, int lev, int ifile)
+    {
+        return encodedDir(dir, name) + "/Level_" + std::to_string(lev) + "_"
+            + amrex::Concatenate("", ifile, 5);
+    }
+
+#ifdef WARPX_USE_ZSTD
+    /** Copy the component of all the particles of a level in one contiguous device array */
+    template <typename T, typename PLevel, typename GetComp>
+    Gpu::DeviceVector<T> gatherComp (PLevel& particles, Long np, GetComp const& get_comp)
+    {
+        Gpu::DeviceVector<T> all(np);
+        Long offset = 0;
+        for (auto& kv : particles) {
+            auto const& comp = get_comp(kv.second.GetStructOfArrays());
+            Gpu::copyAsync(Gpu::deviceToDevice, comp.begin(), comp.end(), all.begin() + offset);
+            offset += static_cast<Long>(comp.size());
+        }
+        return all;
+    }
+
+    /** Shuffle the bytes of the n values of src: byte b of value i goes to dst[b*n + i].
+     *  With delta, the difference with the previous value is encoded instead of the value. */
+    template <typename T, bool delta = false>
+    Gpu::DeviceVector<unsigned char> shuffle (T const* src, Long n)
+    {
+        Gpu::DeviceVector<unsigned char> dst(n*sizeof(T));
+        unsigned char* p_dst = dst.data();
+        ParallelFor(n, [=] AMREX_GPU_DEVICE (Long i) noexcept
+        {
+            T value = src[i];
+            if constexpr (delta) { value -= (i > 0) ? src[i-1] : T(0); }
+            unsigned char bytes[sizeof(T)];
+            std::memcpy(bytes, &value, sizeof(T));
+            for (Long b = 0; b < static_cast<Long>(sizeof(T)); ++b) { p_dst[b*n + i] = bytes[b]; }
+        });
+        return dst;
+    }
+
+    /** Inverse of shuffle (without the delta) */
+    template <typename T>
+    void unshuffle (Gpu::DeviceVector<unsigned char> const& src, T* dst, Long n)
+    {
+        unsigned char const* p_src = src.data();
+        ParallelFor(n, [=] AMREX_GPU_DEVICE (Long i) noexcept
+        {
+            unsigned char bytes[sizeof(T)];
+            for (Long b = 0; b < static_cast<Long>(sizeof(T)); ++b) { bytes[b] = p_src[b*n + i]; }
+            std::memcpy(&dst[i], bytes, sizeof(T));
+        });
+        // src is usually a temporary
+        Gpu::streamSynchronize();
+    }
+
+    /** Copy an encoded component to the host, compress it and write it, preceded by its
+     *  compressed size */
+    void writeBlock (std::ofstream& ofs, Gpu::DeviceVector<unsigned char> const& encoded, int level)
+    {
+        Gpu::PinnedVector<unsigned char> host(encoded.size());
+        Gpu::copyAsync(Gpu::deviceToHost, encoded.begin(), encoded.end(), host.begin());
+        Gpu::streamSynchronize();
+
+        std::vector<char> compressed(ZSTD_compressBound(host.size()));
+        const std::size_t csize = ZSTD_compress(compressed.data(), compressed.size(),
+                                                host.data(), host.size(), level);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!ZSTD_isError(csize),
+            std::string("zstd compression of the particles failed: ") + ZSTD_getErrorName(csize));
+
+        const auto size = static_cast<std::uint64_t>(csize);
+        ofs.write(reinterpret_cast<char const*>(&size), sizeof(size));
+        ofs.write(compressed.data(), static_cast<std::streamsize>(csize));
+    }
+
+    /** Read a component written by writeBlock, decompress it and copy it to the device */
+    Gpu::DeviceVector<unsigned char> readBlock (std::ifstream& ifs, std::size_t nbytes,
+                                                std::string const& file_name)
+    {
+        std::uint64_t size = 0;
+        ifs.read(reinterpret_cast<char*>(&size), sizeof(size));
+        std::vector<char> compressed(size);
+        ifs.read(compressed.data(), static_cast<std::streamsize>(size));
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(ifs.good(), "Could not read " + file_name);
+
+        Gpu::PinnedVector<unsigned char> host(nbytes);
+        const std::size_t dsize = ZSTD_decompress(host.data(), nbytes, compressed.data(), size);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!ZSTD_isError(dsize) && dsize == nbytes,
+            "Corrupted encoded particles in " + file_name);
+
+        Gpu::DeviceVector<unsigned char> encoded(nbytes);
+        Gpu::copyAsync(Gpu::hostToDevice, host.begin(), host.end(), encoded.begin());
+        Gpu::streamSynchronize();
+        return encoded;
+    }
+#endif
+}
+
+void
+WriteEncodedParticles (WarpXParticleContainer& pc, std::string const& dir,
+                       std::string const& name, int compression_level)
+{
+#ifndef WARPX_USE_ZSTD
+    amrex::ignore_unused(pc, dir, name, compression_level);
+    WARPX_ABORT_WITH_MESSAGE(
+        "The compression of the particle checkpoints requires WarpX to be built with zstd (WarpX_ZSTD=ON)");
+#else
+    WARPX_PROFILE("WriteEncodedParticles()");
+
+    const int nlevs = pc.finestLevel() + 1;
+    const int nreal = pc.NumRealComps();
+    const int nint = pc.NumIntComps();
+
+    if (ParallelDescriptor::IOProcessor()) {
+        if (!amrex::UtilCreateDirectory(encodedDir(dir, name), 0755)) {
+            amrex::CreateDirectoryFailed(encodedDir(dir, name));
+        }
+        std::ofstream header(encodedDir(dir, name) + "/Header");
+        header << encoded_version << "\n" << nlevs << " " << ParallelDescriptor::NProcs() << "\n";
+        header.close();
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(header.good(),
+            "Could not write " + encodedDir(dir, name) + "/Header");
+    }
+    ParallelDescriptor::Barrier();
+
+    for (int lev = 0; lev < nlevs; ++lev) {
+        auto& particles = pc.GetParticles(lev);
+        Long np = 0;
+        for (auto const& kv : particles) { np += kv.second.numParticles(); }
+
+        const std::string file_name = encodedFileName(dir, name, lev, ParallelDescriptor::MyProc());
+        std::ofstream ofs(file_name, std::ios::binary | std::ios::trunc);
+        if (!ofs.good()) { amrex::FileOpenFailed(file_name); }
+
+        const std::uint64_t header[] = {encoded_magic, static_cast<std::uint64_t>(np),
+            static_cast<std::uint64_t>(nreal), static_cast<std::uint64_t>(nint),
+            sizeof(ParticleReal)};
+        ofs.write(reinterpret_cast<char const*>(header), sizeof(header));
+
+        if (np > 0) {
+            // the ids and cpus of consecutive particles are close: encode their differences
+            auto const idcpu = gatherComp<std::uint64_t>(particles, np,
+                [] (auto const& soa) -> auto const& { return soa.GetIdCPUData(); });
+            writeBlock(ofs, shuffle<std::uint64_t, true>(idcpu.data(), np), compression_level);
+
+            for (int comp = 0; comp < nreal; ++comp) {
+                auto const data = gatherComp<ParticleReal>(particles, np,
+                    [comp] (auto const& soa) -> auto const& { return soa.GetRealData(comp); });
+                writeBlock(ofs, shuffle(data.data(), np), compression_level);
+            }
+            for (int comp = 0; comp < nint; ++comp) {
+                auto const data = gatherComp<int>(particles, np,
+                    [comp] (auto const& soa) -> auto const& { return soa.GetIntData(comp); });
+                writeBlock(ofs, shuffle(data.data(), np), compression_level);
+            }
+        }
+
+        ofs.close();
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(ofs.good(), "Could not write " + file_name);
+    }
+#endif
+}
+
+bool
+ReadEncodedParticles (WarpXParticleContainer& pc, std::string const& dir,
+                      std::string const& name)
+{
+    const std::string header_name = encodedDir(dir, name) + "/Header";
+    if (!amrex::FileExists(header_name)) { return false; }
+
+#ifndef WARPX_USE_ZSTD
+    amrex::ignore_unused(pc);
+    WARPX_ABORT_WITH_MESSAGE("The particles of " + name + " in " + dir
+        + " are compressed: WarpX must be built with zstd (WarpX_ZSTD=ON) to read them");
+    return false;
+#else
+    WARPX_PROFILE("ReadEncodedParticles()");
+
+    Vector<char> header_chars;
+    ParallelDescriptor::ReadAndBcastFile(header_name, header_chars);
+    std::istringstream is(std::string(header_chars.dataPtr()));
+    int version = 0;
+    int nlevs = 0;
+    int nfiles = 0;
+    is >> version >> nlevs >> nfiles;
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(version == encoded_version,
+        "Unknown version of the encoded particles in " + header_name);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(nlevs <= pc.finestLevel() + 1,
+        "The encoded particles in " + header_name + " have more levels than the simulation");
+
+    const int myproc = ParallelDescriptor::MyProc();
+    const int nreal = pc.NumRealComps();
+    const int nint = pc.NumIntComps();
+
+    for (int lev = 0; lev < nlevs; ++lev) {
+        // the files are read in turn by the ranks that own grids on this level, and the
+        // particles are added to their first grid before being redistributed
+        const auto& dm = pc.ParticleDistributionMap(lev);
+        std::vector<int> owners(dm.ProcessorMap().begin(), dm.ProcessorMap().end());
+        std::sort(owners.begin(), owners.end());
+        owners.erase(std::unique(owners.begin(), owners.end()), owners.end());
+        const auto first_grid = std::find(dm.ProcessorMap().begin(), dm.ProcessorMap().end(), myproc);
+
+        for (int ifile = 0; ifile < nfiles; ++ifile) {
+            if (owners[ifile % owners.size()] != myproc) { continue; }
+
+            const std::string file_name = encodedFileName(dir, name, lev, ifile);
+            std::ifstream ifs(file_name, std::ios::binary);
+            if (!ifs.good()) { amrex::FileOpenFailed(file_name); }
+
+            std::uint64_t header[5] = {0, 0, 0, 0, 0};
+            ifs.read(reinterpret_cast<char*>(header), sizeof(header));
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(ifs.good() && header[0] == encoded_magic,
+                file_name + " does not contain encoded particles");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                header[2] == static_cast<std::uint64_t>(nreal) &&
+                header[3] == static_cast<std::uint64_t>(nint) &&
+                header[4] == sizeof(ParticleReal),
+                "The components of the encoded particles in " + file_name
+                + " do not match those of species " + name);
+
+            const auto np = static_cast<Long>(header[1]);
+            if (np == 0) { continue; }
+
+            const int gid = static_cast<int>(first_grid - dm.ProcessorMap().begin());
+            auto& ptile = pc.DefineAndReturnParticleTile(lev, gid, 0);
+            const auto old_np = static_cast<Long>(ptile.numParticles());
+            ptile.resize(old_np + np);
+            auto& soa = ptile.GetStructOfArrays();
+
+            {
+                Gpu::DeviceVector<std::uint64_t> deltas(np);
+                unshuffle(readBlock(ifs, np*sizeof(std::uint64_t), file_name), deltas.data(), np);
+                Scan::InclusiveSum(np, deltas.data(), soa.GetIdCPUData().data() + old_np);
+                Gpu::streamSynchronize();
+            }
+            for (int comp = 0; comp < nreal; ++comp) {
+                unshuffle(readBlock(ifs, np*sizeof(ParticleReal), file_name),
+                          soa.GetRealData(comp).data() + old_np, np);
+            }
+            for (int comp = 0; comp < nint; ++comp) {
+                unshuffle(readBlock(ifs, np*sizeof(int), file_name),
+                          soa.GetIntData(comp).data() + old_np, np);
+            }
+        }
+    }
+
+    pc.Redistribute();
+    return true;
+#endif
+}
@@ -7,6 +7,7 @@
  * License: BSD-3-Clause-LBNL
  */
 
+#include "Diagnostics/ParticleCheckpointEncoding.H"
 #include "FieldSolver/Fields.H"
 #include "Particles/ParticleIO.H"
 #include "Particles/MultiParticleContainer.H"
@@ -211,9 +212,11 @@ MultiParticleContainer::Restart (const std::string& dir)
         }
 
         pc->Restart(dir, species_names.at(i));
+        ReadEncodedParticles(*pc, dir, species_names.at(i));
     }
     for (unsigned i = species_names.size(); i < species_names.size()+lasers_names.size(); ++i) {
         allcontainers.at(i)->Restart(dir, lasers_names.at(i-species_names.size()));
+        ReadEncodedParticles(*allcontainers.at(i), dir, lasers_names.at(i-species_names.size()));
     }
 }
 
@@ -247,9 +250,10 @@ storePhiOnParticles ( PinnedMemoryParticleContainer& tmp,
 
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
         (electrostatic_solver_id == ElectrostaticSolverAlgo::LabFrame) ||
+        (electrostatic_solver_id == ElectrostaticSolverAlgo::LabFrameEffectivePotential) ||
         (electrostatic_solver_id == ElectrostaticSolverAlgo::LabFrameElectroMagnetostatic),
         "Output of the electrostatic potential (phi) on the particles was requested, "
-        "but this is only available for `warpx.do_electrostatic=labframe` or `labframe-electromagnetostatic`.");
+        "but this is only available for `warpx.do_electrostatic=labframe`, `labframe-effective-potential` or `labframe-electromagnetostatic`.");
     // When this is not a full diagnostic, the particles are not written at the same physical time (i.e. PIC iteration)
     // that they were collected. This happens for diagnostics that use buffering (e.g. BackTransformed, BoundaryScraping).
     // Here `phi` is gathered at the iteration when particles are written (not collected) and is thus mismatched.
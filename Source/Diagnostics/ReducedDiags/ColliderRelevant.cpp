@@ -211,121 +211,90 @@ void ColliderRelevant::ComputeDiags (int step)
         return m_headers_indices.at(name).idx;
     };
 
-    std::array<std::unique_ptr<amrex::MultiFab>, 2> num_dens;
+    std::array<std::unique_ptr<amrex::MultiFab>, 2> charge_dens;
+
+    // The sums, minima and maxima computed on this process are stored in these
+    // vectors during the loop over the species, and reduced together after it.
+    // For each species, the positions of its values in the vectors are stored.
+    std::vector<amrex::Real> sums, mins, maxs;
+    std::array<std::size_t, 2> isum{}, imin{}, imax{};
 
     // loop over species
     for (int i_s = 0; i_s < 2; ++i_s)
     {
         // get WarpXParticleContainer class object
         WarpXParticleContainer& myspc = mypc.GetParticleContainerFromName(m_beam_name[i_s]);
-        // get charge
-        amrex::ParticleReal const q = myspc.getCharge();
 
         using PType = typename WarpXParticleContainer::SuperParticleType;
 
-        num_dens[i_s] = myspc.GetChargeDensity(0);
-        num_dens[i_s]->mult(1._prt/q);
+        // the conversion to number density is done on the luminosity
+        charge_dens[i_s] = myspc.GetChargeDensity(0);
+
+        isum[i_s] = sums.size();
+        imin[i_s] = mins.size();
+        imax[i_s] = maxs.size();
 
 #if defined(WARPX_DIM_1D_Z)
         // w_tot
-        amrex::Real w_tot = ReduceSum( myspc,
+        amrex::Real const w_tot = ReduceSum( myspc,
             [=] AMREX_GPU_HOST_DEVICE (const PType& p)
             {
                 return p.rdata(PIdx::w);
             });
-        amrex::ParallelDescriptor::ReduceRealSum(w_tot);
+        sums.push_back(w_tot);
 #elif defined(WARPX_DIM_XZ)
         // w_tot
-        // x_ave,
-        // thetax_min, thetax_ave, thetax_max
+        // x_ave, x_std,
+        // thetax_min, thetax_ave, thetax_max, thetax_std
+        // The standard deviations are computed from the second moments, so
+        // that the particles are only read once
         amrex::ReduceOps<ReduceOpSum,
-                         ReduceOpSum,
-                         ReduceOpMin, ReduceOpSum, ReduceOpMax> reduce_ops;
+                         ReduceOpSum, ReduceOpSum,
+                         ReduceOpSum, ReduceOpSum,
+                         ReduceOpMin, ReduceOpMax> reduce_ops;
         auto r = amrex::ParticleReduce<amrex::ReduceData<Real,
-                                                         Real,
-                                                         Real, Real, Real>>(
+                                                         Real, Real,
+                                                         Real, Real,
+                                                         Real, Real>>(
             myspc,
             [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple<Real,
-                                                                             Real,
-                                                                             Real, Real, Real>
+                                                                             Real, Real,
+                                                                             Real, Real,
+                                                                             Real, Real>
             {
                 const amrex::Real w  = p.rdata(PIdx::w);
                 const amrex::Real x = p.pos(0);
                 const amrex::Real ux = p.rdata(PIdx::ux);
                 const amrex::Real uz = p.rdata(PIdx::uz);
                 const amrex::Real thetax = std::atan2(ux, uz);
-                return {w, w*x, thetax, w*thetax, thetax};
+                return {w, w*x, w*x*x, w*thetax, w*thetax*thetax, thetax, thetax};
             },
             reduce_ops);
 
-        amrex::Real w_tot  = amrex::get<0>(r);
-        amrex::Real x_ave  = amrex::get<1>(r);
-        amrex::Real thetax_min  = amrex::get<2>(r);
-        amrex::Real thetax_ave  = amrex::get<3>(r);
-        amrex::Real thetax_max  = amrex::get<4>(r);
-
-        amrex::ParallelDescriptor::ReduceRealSum({w_tot, x_ave, thetax_ave});
-        amrex::ParallelDescriptor::ReduceRealMin({thetax_min});
-        amrex::ParallelDescriptor::ReduceRealMax({thetax_max});
-
-        // x_std, thetax_std
-        amrex::Real x_std = 0.0_rt;
-        amrex::Real thetax_std = 0.0_rt;
-
-        if (w_tot > 0.0_rt)
-        {
-            x_ave = x_ave / w_tot;
-            thetax_ave = thetax_ave / w_tot;
-
-            amrex::ReduceOps<ReduceOpSum, ReduceOpSum> reduce_ops_std;
-            auto r_std = amrex::ParticleReduce<amrex::ReduceData<Real, Real>>(
-                myspc,
-                [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple<Real, Real>
-                {
-                    const amrex::Real w  = p.rdata(PIdx::w);
-                    const amrex::Real x = p.pos(0);
-                    const amrex::Real ux = p.rdata(PIdx::ux);
-                    const amrex::Real uz = p.rdata(PIdx::uz);
-                    const amrex::Real thetax = std::atan2(ux, uz);
-                    const amrex::Real tmp1 = (x - x_ave)*(x - x_ave)*w;
-                    const amrex::Real tmp2 = (thetax - thetax_ave)*(thetax - thetax_ave)*w;
-                    return {tmp1, tmp2};
-                },
-                reduce_ops_std);
-
-            x_std = amrex::get<0>(r_std);
-            thetax_std = amrex::get<1>(r_std);
-
-            amrex::ParallelDescriptor::ReduceRealSum({x_std, thetax_std});
-
-            x_std = std::sqrt(x_std / w_tot);
-            thetax_std = std::sqrt(thetax_std / w_tot);
-        }
-
-        m_data[get_idx("x_ave_"+m_beam_name[i_s])] = x_ave;
-        m_data[get_idx("x_std_"+m_beam_name[i_s])] = x_std;
-        m_data[get_idx("thetax_min_"+m_beam_name[i_s])] = thetax_min;
-        m_data[get_idx("thetax_ave_"+m_beam_name[i_s])] = thetax_ave;
-        m_data[get_idx("thetax_max_"+m_beam_name[i_s])] = thetax_max;
-        m_data[get_idx("thetax_std_"+m_beam_name[i_s])] = thetax_std;
+        sums.insert(sums.end(), {amrex::get<0>(r), amrex::get<1>(r), amrex::get<2>(r),
+                                 amrex::get<3>(r), amrex::get<4>(r)});
+        mins.push_back(amrex::get<5>(r));
+        maxs.push_back(amrex::get<6>(r));
 #elif defined(WARPX_DIM_3D)
         // w_tot
-        // x_ave, y_ave,
-        // thetax_min, thetax_ave, thetax_max
-        // thetay_min, thetay_ave, thetay_max
+        // x_ave, x_std, y_ave, y_std
+        // thetax_min, thetax_ave, thetax_max, thetax_std
+        // thetay_min, thetay_ave, thetay_max, thetay_std
+        // The standard deviations are computed from the second moments, so
+        // that the particles are only read once
         amrex::ReduceOps<ReduceOpSum,
-                         ReduceOpSum, ReduceOpSum,
-                         ReduceOpMin, ReduceOpSum, ReduceOpMax,
-                         ReduceOpMin, ReduceOpSum, ReduceOpMax> reduce_ops;
+                         ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum,
+                         ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum,
+                         ReduceOpMin, ReduceOpMax, ReduceOpMin, ReduceOpMax> reduce_ops;
         auto r = amrex::ParticleReduce<amrex::ReduceData<Real,
-                                                         Real, Real,
-                                                         Real, Real, Real,
-                                                         Real, Real, Real>>(
+                                                         Real, Real, Real, Real,
+                                                         Real, Real, Real, Real,
+                                                         Real, Real, Real, Real>>(
             myspc,
             [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple<Real,
-                                                                             Real, Real,
-                                                                             Real, Real, Real,
-                                                                             Real, Real, Real>
+                                                                             Real, Real, Real, Real,
+                                                                             Real, Real, Real, Real,
+                                                                             Real, Real, Real, Real>
             {
                 const amrex::Real w  = p.rdata(PIdx::w);
                 const amrex::Real x = p.pos(0);
@@ -335,85 +304,18 @@ void ColliderRelevant::ComputeDiags (int step)
                 const amrex::Real uz = p.rdata(PIdx::uz);
                 const amrex::Real thetax = std::atan2(ux, uz);
                 const amrex::Real thetay = std::atan2(uy, uz);
-                return {w, w*x, w*y,
-                        thetax, w*thetax, thetax,
-                        thetay, w*thetay, thetay};
+                return {w,
+                        w*x, w*x*x, w*y, w*y*y,
+                        w*thetax, w*thetax*thetax, w*thetay, w*thetay*thetay,
+                        thetax, thetax, thetay, thetay};
             },
             reduce_ops);
 
-        amrex::Real w_tot  = amrex::get<0>(r);
-        amrex::Real x_ave  = amrex::get<1>(r);
-        amrex::Real y_ave  = amrex::get<2>(r);
-        amrex::Real thetax_min  = amrex::get<3>(r);
-        amrex::Real thetax_ave  = amrex::get<4>(r);
-        amrex::Real thetax_max  = amrex::get<5>(r);
-        amrex::Real thetay_min  = amrex::get<6>(r);
-        amrex::Real thetay_ave  = amrex::get<7>(r);
-        amrex::Real thetay_max  = amrex::get<8>(r);
-
-        amrex::ParallelDescriptor::ReduceRealSum({w_tot, x_ave, y_ave, thetax_ave, thetay_ave});
-        amrex::ParallelDescriptor::ReduceRealMin({thetax_min, thetay_min});
-        amrex::ParallelDescriptor::ReduceRealMax({thetax_max, thetay_max});
-
-        // x_std, y_std, thetax_std, thetay_std
-        amrex::Real x_std = 0.0_rt;
-        amrex::Real y_std = 0.0_rt;
-        amrex::Real thetax_std = 0.0_rt;
-        amrex::Real thetay_std = 0.0_rt;
-
-        if (w_tot > 0.0_rt)
-        {
-            x_ave = x_ave / w_tot;
-            y_ave = y_ave / w_tot;
-            thetax_ave = thetax_ave / w_tot;
-            thetay_ave = thetay_ave / w_tot;
-
-            amrex::ReduceOps<ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum> reduce_ops_std;
-            auto r_std = amrex::ParticleReduce<amrex::ReduceData<Real, Real, Real, Real>>(
-                myspc,
-                [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple<Real, Real, Real, Real>
-                {
-                    const amrex::Real w  = p.rdata(PIdx::w);
-                    const amrex::Real x = p.pos(0);
-                    const amrex::Real ux = p.rdata(PIdx::ux);
-                    const amrex::Real y = p.pos(1);
-                    const amrex::Real uy = p.rdata(PIdx::uy);
-                    const amrex::Real uz = p.rdata(PIdx::uz);
-                    const amrex::Real thetax = std::atan2(ux, uz);
-                    const amrex::Real thetay = std::atan2(uy, uz);
-                    const amrex::Real tmp1 = (x - x_ave)*(x - x_ave)*w;
-                    const amrex::Real tmp2 = (y - y_ave)*(y - y_ave)*w;
-                    const amrex::Real tmp3 = (thetax - thetax_ave)*(thetax - thetax_ave)*w;
-                    const amrex::Real tmp4 = (thetay - thetay_ave)*(thetay - thetay_ave)*w;
-                    return {tmp1, tmp2, tmp3, tmp4};
-                },
-                reduce_ops_std);
-
-            x_std = amrex::get<0>(r_std);
-            y_std = amrex::get<1>(r_std);
-            thetax_std = amrex::get<2>(r_std);
-            thetay_std = amrex::get<3>(r_std);
-
-            amrex::ParallelDescriptor::ReduceRealSum({x_std, y_std, thetax_std, thetay_std});
-
-            x_std = std::sqrt(x_std / w_tot);
-            y_std = std::sqrt(y_std / w_tot);
-            thetax_std = std::sqrt(thetax_std / w_tot);
-            thetay_std = std::sqrt(thetay_std / w_tot);
-        }
-
-        m_data[get_idx("x_ave_"+m_beam_name[i_s])] = x_ave;
-        m_data[get_idx("x_std_"+m_beam_name[i_s])] = x_std;
-        m_data[get_idx("y_ave_"+m_beam_name[i_s])] = y_ave;
-        m_data[get_idx("y_std_"+m_beam_name[i_s])] = y_std;
-        m_data[get_idx("thetax_min_"+m_beam_name[i_s])] = thetax_min;
-        m_data[get_idx("thetax_ave_"+m_beam_name[i_s])] = thetax_ave;
-        m_data[get_idx("thetax_max_"+m_beam_name[i_s])] = thetax_max;
-        m_data[get_idx("thetax_std_"+m_beam_name[i_s])] = thetax_std;
-        m_data[get_idx("thetay_min_"+m_beam_name[i_s])] = thetay_min;
-        m_data[get_idx("thetay_ave_"+m_beam_name[i_s])] = thetay_ave;
-        m_data[get_idx("thetay_max_"+m_beam_name[i_s])] = thetay_max;
-        m_data[get_idx("thetay_std_"+m_beam_name[i_s])] = thetay_std;
+        sums.insert(sums.end(), {amrex::get<0>(r),
+                                 amrex::get<1>(r), amrex::get<2>(r), amrex::get<3>(r), amrex::get<4>(r),
+                                 amrex::get<5>(r), amrex::get<6>(r), amrex::get<7>(r), amrex::get<8>(r)});
+        mins.insert(mins.end(), {amrex::get<9>(r), amrex::get<11>(r)});
+        maxs.insert(maxs.end(), {amrex::get<10>(r), amrex::get<12>(r)});
 #endif
 
 #if (defined WARPX_QED)
@@ -425,13 +327,9 @@ void ColliderRelevant::ComputeDiags (int step)
         }
 
         // compute chimin, chiave and chimax
-        amrex::Real chimin_f = 0.0_rt;
-        amrex::Real chimax_f = 0.0_rt;
-        amrex::Real chiave_f = 0.0_rt;
-
         if (myspc.DoQED())
         {
-            // define variables in preparation for field gatheeduce_data.value()ring
+            // define variables in preparation for field gathering
             const int n_rz_azimuthal_modes = WarpX::n_rz_azimuthal_modes;
             const int nox = WarpX::nox;
             const bool galerkin_interpolation = WarpX::galerkin_interpolation;
@@ -528,16 +426,9 @@ void ColliderRelevant::ComputeDiags (int step)
                 });
             }
             auto val = reduce_data.value();
-            chimin_f = get<0>(val);
-            chimax_f = get<1>(val);
-            chiave_f = get<2>(val);
-            amrex::ParallelDescriptor::ReduceRealMin(chimin_f);
-            amrex::ParallelDescriptor::ReduceRealMax(chimax_f);
-            amrex::ParallelDescriptor::ReduceRealSum(chiave_f);
-
-            m_data[get_idx("chimin_"+m_beam_name[i_s])] = chimin_f;
-            m_data[get_idx("chiave_"+m_beam_name[i_s])] = chiave_f/w_tot;
-            m_data[get_idx("chimax_"+m_beam_name[i_s])] = chimax_f;
+            mins.push_back(get<0>(val));
+            maxs.push_back(get<1>(val));
+            sums.push_back(get<2>(val));
         }
 #endif
     } // end loop over species
@@ -549,11 +440,83 @@ void ColliderRelevant::ComputeDiags (int step)
     constexpr int ngrow = 0;
     amrex::MultiFab mf_dst1(ba.convert(amrex::IntVect::TheCellVector()), dmap, ncomp, ngrow);
     amrex::MultiFab mf_dst2(ba.convert(amrex::IntVect::TheCellVector()), dmap, ncomp, ngrow);
-    ablastr::coarsen::sample::Coarsen(mf_dst1, *num_dens[0], 0, 0, ncomp, ngrow);
-    ablastr::coarsen::sample::Coarsen(mf_dst2, *num_dens[1], 0, 0, ncomp, ngrow);
+    ablastr::coarsen::sample::Coarsen(mf_dst1, *charge_dens[0], 0, 0, ncomp, ngrow);
+    ablastr::coarsen::sample::Coarsen(mf_dst2, *charge_dens[1], 0, 0, ncomp, ngrow);
+
+    // overlap integral of the charge densities
+    constexpr bool local = true;
+    const std::size_t ilumi = sums.size();
+    sums.push_back(amrex::MultiFab::Dot(mf_dst1, 0, mf_dst2, 0, 1, 0, local));
+
+    // A single reduction of each type for all the quantities of both species
+    amrex::ParallelDescriptor::ReduceRealSum(sums.data(), static_cast<int>(sums.size()));
+    amrex::ParallelDescriptor::ReduceRealMin(mins.data(), static_cast<int>(mins.size()));
+    amrex::ParallelDescriptor::ReduceRealMax(maxs.data(), static_cast<int>(maxs.size()));
+
+    // standard deviation from the first and second moments
+    const auto get_std = [] (amrex::Real ave, amrex::Real ave_sq) {
+        return std::sqrt(std::max(ave_sq - ave*ave, 0.0_rt));
+    };
+
+    for (int i_s = 0; i_s < 2; ++i_s)
+    {
+        const amrex::Real* const s_data = sums.data() + isum[i_s];
+        const amrex::Real* const min_data = mins.data() + imin[i_s];
+        const amrex::Real* const max_data = maxs.data() + imax[i_s];
+        const amrex::Real w_tot = s_data[0];
+        const amrex::Real inv_w_tot = (w_tot > 0.0_rt) ? 1.0_rt/w_tot : 0.0_rt;
+        int n_sums = 1;
+        int n_extrema = 0;
+        amrex::ignore_unused(min_data, max_data, inv_w_tot, get_std);
+
+#if defined(WARPX_DIM_XZ)
+        const amrex::Real x_ave = s_data[1]*inv_w_tot;
+        const amrex::Real thetax_ave = s_data[3]*inv_w_tot;
+        m_data[get_idx("x_ave_"+m_beam_name[i_s])] = x_ave;
+        m_data[get_idx("x_std_"+m_beam_name[i_s])] = get_std(x_ave, s_data[2]*inv_w_tot);
+        m_data[get_idx("thetax_min_"+m_beam_name[i_s])] = min_data[0];
+        m_data[get_idx("thetax_ave_"+m_beam_name[i_s])] = thetax_ave;
+        m_data[get_idx("thetax_max_"+m_beam_name[i_s])] = max_data[0];
+        m_data[get_idx("thetax_std_"+m_beam_name[i_s])] = get_std(thetax_ave, s_data[4]*inv_w_tot);
+        n_sums = 5;
+        n_extrema = 1;
+#elif defined(WARPX_DIM_3D)
+        const amrex::Real x_ave = s_data[1]*inv_w_tot;
+        const amrex::Real y_ave = s_data[3]*inv_w_tot;
+        const amrex::Real thetax_ave = s_data[5]*inv_w_tot;
+        const amrex::Real thetay_ave = s_data[7]*inv_w_tot;
+        m_data[get_idx("x_ave_"+m_beam_name[i_s])] = x_ave;
+        m_data[get_idx("x_std_"+m_beam_name[i_s])] = get_std(x_ave, s_data[2]*inv_w_tot);
+        m_data[get_idx("y_ave_"+m_beam_name[i_s])] = y_ave;
+        m_data[get_idx("y_std_"+m_beam_name[i_s])] = get_std(y_ave, s_data[4]*inv_w_tot);
+        m_data[get_idx("thetax_min_"+m_beam_name[i_s])] = min_data[0];
+        m_data[get_idx("thetax_ave_"+m_beam_name[i_s])] = thetax_ave;
+        m_data[get_idx("thetax_max_"+m_beam_name[i_s])] = max_data[0];
+        m_data[get_idx("thetax_std_"+m_beam_name[i_s])] = get_std(thetax_ave, s_data[6]*inv_w_tot);
+        m_data[get_idx("thetay_min_"+m_beam_name[i_s])] = min_data[1];
+        m_data[get_idx("thetay_ave_"+m_beam_name[i_s])] = thetay_ave;
+        m_data[get_idx("thetay_max_"+m_beam_name[i_s])] = max_data[1];
+        m_data[get_idx("thetay_std_"+m_beam_name[i_s])] = get_std(thetay_ave, s_data[8]*inv_w_tot);
+        n_sums = 9;
+        n_extrema = 2;
+#endif
+
+#if (defined WARPX_QED)
+        if (mypc.GetParticleContainerFromName(m_beam_name[i_s]).DoQED())
+        {
+            m_data[get_idx("chimin_"+m_beam_name[i_s])] = min_data[n_extrema];
+            m_data[get_idx("chiave_"+m_beam_name[i_s])] = s_data[n_sums]/w_tot;
+            m_data[get_idx("chimax_"+m_beam_name[i_s])] = max_data[n_extrema];
+        }
+#else
+        amrex::ignore_unused(n_sums, n_extrema);
+#endif
+    }
 
-    // compute luminosity
-    amrex::Real const n1_dot_n2 = amrex::MultiFab::Dot(mf_dst1, 0, mf_dst2, 0, 1, 0);
+    // compute luminosity, from the number densities n = rho/q
+    const amrex::ParticleReal q1 = mypc.GetParticleContainerFromName(m_beam_name[0]).getCharge();
+    const amrex::ParticleReal q2 = mypc.GetParticleContainerFromName(m_beam_name[1]).getCharge();
+    amrex::Real const n1_dot_n2 = sums[ilumi]/(q1*q2);
     amrex::Real const lumi = 2._rt * PhysConst::c * n1_dot_n2 * dV;
     m_data[get_idx("dL_dt")] = lumi;
 #endif // not RZ
@@ -19,6 +19,9 @@
 #include <AMReX_FabArray.H>
 #include <AMReX_MFIter.H>
 #include <AMReX_Geometry.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_IndexType.H>
+#include <AMReX_iMultiFab.H>
 #include <AMReX_MultiFab.H>
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParmParse.H>
@@ -26,6 +29,7 @@
 
 #include <algorithm>
 #include <fstream>
+#include <memory>
 #include <vector>
 
 using namespace amrex;
@@ -87,46 +91,37 @@ void FieldEnergy::ComputeDiags (int step)
     // get number of level
     const auto nLevel = warpx.finestLevel() + 1;
 
+    // Sums of E squared and B squared on each level, on this process
+    std::vector<amrex::Real> field_sums(2*nLevel, 0.0_rt);
+
     // loop over refinement levels
     for (int lev = 0; lev < nLevel; ++lev)
     {
-        // get MultiFab data at lev
-        const MultiFab & Ex = warpx.getField(FieldType::Efield_aux, lev,0);
-        const MultiFab & Ey = warpx.getField(FieldType::Efield_aux, lev,1);
-        const MultiFab & Ez = warpx.getField(FieldType::Efield_aux, lev,2);
-        const MultiFab & Bx = warpx.getField(FieldType::Bfield_aux, lev,0);
-        const MultiFab & By = warpx.getField(FieldType::Bfield_aux, lev,1);
-        const MultiFab & Bz = warpx.getField(FieldType::Bfield_aux, lev,2);
+        for (int idir = 0; idir < 3; ++idir)
+        {
+            const MultiFab & E = warpx.getField(FieldType::Efield_aux, lev, idir);
+            const MultiFab & B = warpx.getField(FieldType::Bfield_aux, lev, idir);
+#if defined(WARPX_DIM_RZ)
+            field_sums[2*lev] += ComputeNorm2RZ(E, lev);
+            field_sums[2*lev+1] += ComputeNorm2RZ(B, lev);
+#else
+            field_sums[2*lev] += ComputeNorm2(E, lev);
+            field_sums[2*lev+1] += ComputeNorm2(B, lev);
+#endif
+        }
+    }
+
+    // A single reduction for all the components and all the levels
+    ParallelDescriptor::ReduceRealSum(field_sums.data(), static_cast<int>(field_sums.size()));
 
+    for (int lev = 0; lev < nLevel; ++lev)
+    {
         // get cell volume
         const std::array<Real, 3> &dx = WarpX::CellSize(lev);
         const amrex::Real dV = dx[0]*dx[1]*dx[2];
 
-#if defined(WARPX_DIM_RZ)
-        amrex::Real const tmpEx = ComputeNorm2RZ(Ex, lev);
-        amrex::Real const tmpEy = ComputeNorm2RZ(Ey, lev);
-        amrex::Real const tmpEz = ComputeNorm2RZ(Ez, lev);
-        amrex::Real const Es = tmpEx + tmpEy + tmpEz;
-
-        amrex::Real const tmpBx = ComputeNorm2RZ(Bx, lev);
-        amrex::Real const tmpBy = ComputeNorm2RZ(By, lev);
-        amrex::Real const tmpBz = ComputeNorm2RZ(Bz, lev);
-        amrex::Real const Bs = tmpBx + tmpBy + tmpBz;
-#else
-        Geometry const & geom = warpx.Geom(lev);
-
-        // compute E squared
-        Real const tmpEx = Ex.norm2(0,geom.periodicity());
-        Real const tmpEy = Ey.norm2(0,geom.periodicity());
-        Real const tmpEz = Ez.norm2(0,geom.periodicity());
-        Real const Es = tmpEx*tmpEx + tmpEy*tmpEy + tmpEz*tmpEz;
-
-        // compute B squared
-        Real const tmpBx = Bx.norm2(0,geom.periodicity());
-        Real const tmpBy = By.norm2(0,geom.periodicity());
-        Real const tmpBz = Bz.norm2(0,geom.periodicity());
-        Real const Bs = tmpBx*tmpBx + tmpBy*tmpBy + tmpBz*tmpBz;
-#endif
+        amrex::Real const Es = field_sums[2*lev];
+        amrex::Real const Bs = field_sums[2*lev+1];
 
         constexpr int noutputs = 3; // total energy, E-field energy and B-field energy
         constexpr int index_total = 0;
@@ -216,3 +211,64 @@ FieldEnergy::ComputeNorm2RZ(const amrex::MultiFab& field, const int lev)
     return result;
 }
 // end Real FieldEnergy::ComputeNorm2RZ
+
+// Function that computes the sum of the field squared, on this process
+amrex::Real
+FieldEnergy::ComputeNorm2 (const amrex::MultiFab& field, const int lev)
+{
+    // get a reference to WarpX instance
+    auto & warpx = WarpX::GetInstance();
+
+    Geometry const & geom = warpx.Geom(lev);
+    const amrex::IndexType ixtype = field.ixType();
+    const amrex::Box domain = amrex::convert(geom.Domain(), ixtype);
+
+    // Points on the faces shared by several boxes must only be counted once.
+    // The boxes of level 0 cover the domain, so that the node on the upper
+    // face of a box is owned by its neighbor, except on the upper boundary of a
+    // non-periodic domain. On the refined levels, use the owner mask instead.
+    std::unique_ptr<amrex::iMultiFab> owner_mask;
+    if (lev > 0) {
+        owner_mask = amrex::OwnerMask(field, geom.periodicity());
+    }
+
+    amrex::ReduceOps<amrex::ReduceOpSum> reduce_ops;
+    amrex::ReduceData<amrex::Real> reduce_data(reduce_ops);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for ( amrex::MFIter mfi(field, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi )
+    {
+        amrex::Array4<const amrex::Real> const& field_arr = field.const_array(mfi);
+        amrex::Box tb = mfi.tilebox();
+
+        if (owner_mask) {
+            amrex::Array4<const int> const& mask_arr = owner_mask->const_array(mfi);
+            reduce_ops.eval(tb, reduce_data,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
+                {
+                    const amrex::Real f = field_arr(i,j,k);
+                    return mask_arr(i,j,k) ? f*f : 0._rt;
+                });
+        } else {
+            const amrex::Box& vb = mfi.validbox();
+            for (int idir = 0; idir < AMREX_SPACEDIM; ++idir) {
+                if (ixtype.nodeCentered(idir) && tb.bigEnd(idir) == vb.bigEnd(idir) &&
+                    (geom.isPeriodic(idir) || vb.bigEnd(idir) < domain.bigEnd(idir))) {
+                    tb.growHi(idir, -1);
+                }
+            }
+            reduce_ops.eval(tb, reduce_data,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
+                {
+                    const amrex::Real f = field_arr(i,j,k);
+                    return f*f;
+                });
+        }
+    }
+
+    return amrex::get<0>(reduce_data.value());
+}
+// end Real FieldEnergy::ComputeNorm2
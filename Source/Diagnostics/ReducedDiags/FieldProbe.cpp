@@ -7,6 +7,7 @@
 
 #include "FieldProbe.H"
 #include "FieldProbeParticleContainer.H"
+#include "Diagnostics/OpenPMDHelpFunction.H"
 #include "FieldSolver/Fields.H"
 #include "Particles/Gather/FieldGather.H"
 #include "Particles/Pusher/GetAndSetPosition.H"
@@ -15,6 +16,7 @@
 #include "Utils/Parser/ParserUtils.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXConst.H"
+#include "Utils/WarpXProfilerWrapper.H"
 #include "WarpX.H"
 
 #include <ablastr/warn_manager/WarnManager.H>
@@ -35,12 +37,20 @@
 #include <AMReX_StructOfArrays.H>
 #include <AMReX_Vector.H>
 
+#ifdef WARPX_USE_OPENPMD
+#   include <openPMD/openPMD.hpp>
+#endif
+
+#include <array>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <iostream>
 #include <ostream>
+#include <sstream>
 #include <string>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -140,6 +150,26 @@ FieldProbe::FieldProbe (const std::string& rd_name)
     utils::parser::queryWithParser(pp_rd_name, "interp_order", interp_order);
     pp_rd_name.query("do_moving_window_FP", do_moving_window_FP);
 
+    // output format: text file written by the IO rank (default), or parallel openPMD write
+    std::string probe_format = "txt";
+    pp_rd_name.query("format", probe_format);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(probe_format == "txt" || probe_format == "openpmd",
+        "FieldProbe: format must be txt or openpmd");
+    m_write_openpmd = (probe_format == "openpmd");
+    if (m_write_openpmd) {
+#ifdef WARPX_USE_OPENPMD
+        pp_rd_name.query("openpmd_backend", m_openpmd_backend);
+        pp_rd_name.query("file_min_digits", m_file_min_digits);
+        // pick first available backend if default is chosen
+        if( m_openpmd_backend == "default" ) {
+            m_openpmd_backend = WarpXOpenPMDFileType();
+        }
+        pp_rd_name.add("openpmd_backend", m_openpmd_backend);
+#else
+        WARPX_ABORT_WITH_MESSAGE("FieldProbe: format = openpmd needs openPMD-api compiled into WarpX, but was not found!");
+#endif
+    }
+
     bool raw_fields;
     const bool raw_fields_specified = pp_rd_name.query("raw_fields", raw_fields);
     if (raw_fields_specified) {
@@ -161,7 +191,7 @@ FieldProbe::FieldProbe (const std::string& rd_name)
     utils::parser::getWithParser(pp_algo, "particle_shape", particle_shape);
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(interp_order <= particle_shape ,
                                      "Field probe interp_order should be less than or equal to algo.particle_shape");
-    if (ParallelDescriptor::IOProcessor())
+    if (ParallelDescriptor::IOProcessor() && !m_write_openpmd)
     {
         if ( m_write_header )
         {
@@ -583,7 +613,12 @@ void FieldProbe::ComputeDiags (int step)
             }
         } // end particle iterator loop
 
-        if (m_intervals.contains(step+1))
+        if (m_intervals.contains(step+1) && m_write_openpmd)
+        {
+            // every MPI rank writes its own probe points: no gather on the IO rank
+            WriteOpenPMD(step, lev);
+        }
+        else if (m_intervals.contains(step+1))
         {
             // returns total number of mpi notes into mpisize
             const int mpisize = ParallelDescriptor::NProcs();
@@ -630,8 +665,120 @@ void FieldProbe::ComputeDiags (int step)
     m_last_compute_step = step;
 } // end void FieldProbe::ComputeDiags
 
+void FieldProbe::WriteOpenPMD (int step, int lev) const
+{
+#ifdef WARPX_USE_OPENPMD
+    WARPX_PROFILE("FieldProbe::WriteOpenPMD()");
+
+    // number of probe points of this MPI rank and offset of its chunk
+    const auto np_local = static_cast<amrex::Long>(m_data.size() / noutputs);
+    const int nprocs = amrex::ParallelDescriptor::NProcs();
+    amrex::Vector<amrex::Long> np_ranks(nprocs, 0);
+    amrex::ParallelAllGather::AllGather(&np_local, 1, np_ranks.data(),
+                                        amrex::ParallelDescriptor::Communicator());
+    amrex::Long np_total = 0;
+    amrex::Long offset = 0;
+    for (int i = 0; i < nprocs; ++i) {
+        if (i < amrex::ParallelDescriptor::MyProc()) { offset += np_ranks[i]; }
+        np_total += np_ranks[i];
+    }
+    if (np_total == 0) { return; }
+
+    // one file per step, and one series per mesh refinement level
+    std::string filename = "openpmd";
+    if (lev > 0) { filename.append("_lev").append(std::to_string(lev)); }
+    filename.append("_%0").append(std::to_string(m_file_min_digits)).append("T.").append(m_openpmd_backend);
+    std::string filepath = m_path + m_rd_name + "/" + filename;
+    // transform paths for Windows
+#ifdef _WIN32
+    filepath = openPMD::auxiliary::replace_all(filepath, "/", "\\");
+#endif
+
+#if defined(AMREX_USE_MPI)
+    auto series = openPMD::Series(filepath, openPMD::Access::CREATE,
+                                  amrex::ParallelDescriptor::Communicator());
+#else
+    auto series = openPMD::Series(filepath, openPMD::Access::CREATE);
+#endif
+    series.setSoftware("WarpX", WarpX::Version());
+    auto it = series.iterations[step + 1];
+    it.setTime(WarpX::GetInstance().gett_new(0));
+    auto probe = it.particles["probe"];
+
+    const auto dataset = openPMD::Dataset(openPMD::determineDatatype<amrex::Real>(),
+                                          {static_cast<std::uint64_t>(np_total)});
+    const auto id_dataset = openPMD::Dataset(openPMD::determineDatatype<std::uint64_t>(),
+                                             {static_cast<std::uint64_t>(np_total)});
+
+    // the openPMD unit dimensions are (L, M, T, I, theta, N, J); integrated values
+    // have one more time dimension
+    const double t_int = m_field_probe_integrate ? 1. : 0.;
+    const std::array<double, 7> unit_E {1., 1., -3. + t_int, -1., 0., 0., 0.};
+    const std::array<double, 7> unit_B {0., 1., -2. + t_int, -1., 0., 0., 0.};
+    const std::array<double, 7> unit_S {0., 1., -3. + t_int, 0., 0., 0., 0.};
+
+    // records and components, and their index in the data of each probe point
+    struct Component { std::string record; std::string comp; int idx; };
+    const std::vector<Component> components {
+        {"position", "x", 1}, {"position", "y", 2}, {"position", "z", 3},
+        {"E", "x", 4}, {"E", "y", 5}, {"E", "z", 6},
+        {"B", "x", 7}, {"B", "y", 8}, {"B", "z", 9},
+        {"S", openPMD::RecordComponent::SCALAR, 10}};
+
+    probe["position"].setUnitDimension({{openPMD::UnitDimension::L, 1.}});
+    probe["E"].setUnitDimension({{openPMD::UnitDimension::L, unit_E[0]}, {openPMD::UnitDimension::M, unit_E[1]},
+                                 {openPMD::UnitDimension::T, unit_E[2]}, {openPMD::UnitDimension::I, unit_E[3]}});
+    probe["B"].setUnitDimension({{openPMD::UnitDimension::M, unit_B[1]}, {openPMD::UnitDimension::T, unit_B[2]},
+                                 {openPMD::UnitDimension::I, unit_B[3]}});
+    probe["S"].setUnitDimension({{openPMD::UnitDimension::M, unit_S[1]}, {openPMD::UnitDimension::T, unit_S[2]}});
+    for (auto const* comp : {"x", "y", "z"}) {
+        auto po = probe["positionOffset"][comp];
+        po.resetDataset(dataset);
+        po.makeConstant(amrex::Real(0.));
+    }
+    auto id = probe["id"][openPMD::RecordComponent::SCALAR];
+    id.resetDataset(id_dataset);
+    for (auto const& c : components) {
+        probe[c.record][c.comp].resetDataset(dataset);
+    }
+
+    // Do not call storeChunk() with zero-sized chunks:
+    //   https://github.com/openPMD/openPMD-api/issues/1147
+    if (np_local > 0) {
+        const auto chunk_offset = std::vector<std::uint64_t>{static_cast<std::uint64_t>(offset)};
+        const auto chunk_size = std::vector<std::uint64_t>{static_cast<std::uint64_t>(np_local)};
+
+        auto ids = std::shared_ptr<std::uint64_t>(
+            new std::uint64_t[np_local], [](std::uint64_t const *p){ delete[] p; });
+        for (amrex::Long i = 0; i < np_local; ++i) {
+            ids.get()[i] = static_cast<std::uint64_t>(m_data[i*noutputs]);
+        }
+        id.storeChunk(ids, chunk_offset, chunk_size);
+
+        for (auto const& c : components) {
+            auto values = std::shared_ptr<amrex::Real>(
+                new amrex::Real[np_local], [](amrex::Real const *p){ delete[] p; });
+            for (amrex::Long i = 0; i < np_local; ++i) {
+                values.get()[i] = m_data[i*noutputs + c.idx];
+            }
+            probe[c.record][c.comp].storeChunk(values, chunk_offset, chunk_size);
+        }
+    }
+
+    series.flush();
+    it.close();
+    series.close();
+#else
+    amrex::ignore_unused(step, lev);
+    WARPX_ABORT_WITH_MESSAGE("FieldProbe: format = openpmd needs openPMD-api compiled into WarpX, but was not found!");
+#endif
+}
+
 void FieldProbe::WriteToFile (int step) const
 {
+    // with the openPMD format, all MPI ranks write in ComputeDiags
+    if (m_write_openpmd) { return; }
+
     if (!(ProbeInDomain() && amrex::ParallelDescriptor::IOProcessor())) { return; }
 
     // loop over num valid particles to find the lowest particle ID for later sorting
@@ -658,9 +805,7 @@ void FieldProbe::WriteToFile (int step) const
         }
     }
 
-    // open file
-    std::ofstream ofs{m_path + m_rd_name + "." + m_extension,
-                        std::ofstream::out | std::ofstream::app};
+    std::ostringstream ofs;
 
     // loop over num valid particles and write
     for (long int i = 0; i < m_valid_particles; i++)
@@ -678,8 +823,8 @@ void FieldProbe::WriteToFile (int step) const
             ofs << m_sep;
             ofs << sorted_data[i * noutputs + k];
         }
-        ofs << std::endl;
+        ofs << "\n";
     } // end loop over data size
-    // close file
-    ofs.close();
+
+    m_write_buffer += ofs.str();
 }
@@ -9,8 +9,11 @@
 #include "Diagnostics/ReducedDiags/ReducedDiags.H"
 #include "FieldSolver/Fields.H"
 #include "Particles/MultiParticleContainer.H"
+#include "Diagnostics/OpenPMDHelpFunction.H"
+#include "Utils/Parser/ParserUtils.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
+#include "Utils/WarpXProfilerWrapper.H"
 #include "WarpX.H"
 
 #include <AMReX_Box.H>
@@ -20,6 +23,7 @@
 #include <AMReX_MFIter.H>
 #include <AMReX_MultiFab.H>
 #include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
 #include <AMReX_REAL.H>
 #include <AMReX_Utility.H>
 
@@ -28,12 +32,15 @@
 #endif
 
 #include <algorithm>
+#include <cstdint>
 #include <cstdio>
 #include <iomanip>
+#include <sstream>
 #include <istream>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 using namespace amrex;
 using namespace warpx::fields;
@@ -70,6 +77,95 @@ namespace
 LoadBalanceCosts::LoadBalanceCosts (const std::string& rd_name)
     : ReducedDiags{rd_name}
 {
+    const ParmParse pp_rd_name(rd_name);
+
+    // output format: text file written by the IO rank (default), or parallel openPMD write
+    std::string format = "txt";
+    pp_rd_name.query("format", format);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(format == "txt" || format == "openpmd",
+        "LoadBalanceCosts: format must be txt or openpmd");
+    m_write_openpmd = (format == "openpmd");
+    if (m_write_openpmd) {
+#ifdef WARPX_USE_OPENPMD
+        pp_rd_name.query("openpmd_backend", m_openpmd_backend);
+        // pick first available backend if default is chosen
+        if( m_openpmd_backend == "default" ) {
+            m_openpmd_backend = WarpXOpenPMDFileType();
+        }
+        utils::parser::queryWithParser(pp_rd_name, "buffer_intervals", m_buffer_intervals);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_buffer_intervals >= 1,
+            "LoadBalanceCosts: buffer_intervals must be at least 1");
+#else
+        WARPX_ABORT_WITH_MESSAGE("LoadBalanceCosts: format = openpmd needs openPMD-api compiled into WarpX, but was not found!");
+#endif
+    }
+}
+
+void LoadBalanceCosts::CollectHostnames (bool all_ranks)
+{
+#ifdef AMREX_USE_MPI
+    // now parallel reduce to IO proc and get string data (host name) over all procs
+    // MPI Gatherv preliminaries
+
+    // get the MPI host name and number of characters
+    char hostname[MPI_MAX_PROCESSOR_NAME];
+    int length;
+
+    BL_MPI_REQUIRE( MPI_Get_processor_name( hostname, &length ) );
+
+    // IO proc will collect messages from other procs;
+    // receive counts and displacements needed only by IO proc
+    m_data_string_recvcount.assign(ParallelDescriptor::NProcs(), 0);
+    m_data_string_disp.assign(ParallelDescriptor::NProcs(), 0);
+
+    // get the string lengths on IO proc
+    ParallelDescriptor::Gather(&length, 1,                     // send
+                               m_data_string_recvcount.data(), 1, // receive
+                               ParallelDescriptor::IOProcessorNumber());
+
+    // determine total length of collected strings for root, and set displacements;
+    // + 1 is for chosen separation between words in the gathered string; this
+    // chosen separator character is set further below when elements of
+    // m_data_string_recvbuf are initialized
+    m_data_string_recvbuf_length = m_data_string_recvcount[0] + 1;
+    for (int i=1; i<m_data_string_disp.size(); i++)
+    {
+        m_data_string_recvbuf_length += (m_data_string_recvcount[i] + 1);
+
+        // displacements is cumulative sum along recvcount, include the (+ 1) space separator or null terminator
+        m_data_string_disp[i] = m_data_string_disp[i-1] + m_data_string_recvcount[i-1] + 1;
+    }
+
+    // knowing the total length of string on IOProc, we can allocate memory for the receive buffer
+    // initialize spaces, null terminator is the last element
+    m_data_string_recvbuf.assign(m_data_string_recvbuf_length, ' ');
+    m_data_string_recvbuf[m_data_string_recvbuf_length-1] = '\0';
+
+    // now the root process knows cnts and locations to place messages from sending processes;
+    // collect the hostnames; m_data_string_recvbuf will provide mapping from rank-->hostname
+    ParallelDescriptor::Gatherv(&hostname[0],              /* hostname ID */
+                                length,                    /* length of hostname */
+                                m_data_string_recvbuf.data(), /* write data into string buffer */
+                                m_data_string_recvcount,   /* how many messages to receive */
+                                m_data_string_disp,        /* starting position in recv buffer to place received msg */
+                                ParallelDescriptor::IOProcessorNumber());
+
+    if (all_ranks) {
+        ParallelDescriptor::Bcast(&m_data_string_recvbuf_length, 1, ParallelDescriptor::IOProcessorNumber());
+        m_data_string_recvbuf.resize(m_data_string_recvbuf_length, ' ');
+        ParallelDescriptor::Bcast(m_data_string_recvbuf.data(), m_data_string_recvbuf.size(),
+                                  ParallelDescriptor::IOProcessorNumber());
+    }
+
+    if (all_ranks || ParallelDescriptor::IOProcessor())
+    {
+        const std::string m_data_stdstring_recvbuf(m_data_string_recvbuf.begin(), m_data_string_recvbuf.end());
+        m_data_string = amrex::Tokenize(m_data_stdstring_recvbuf, " ");
+    }
+#else
+    amrex::ignore_unused(all_ranks);
+    m_data_string.assign(1, "localhost");
+#endif
 }
 
 // function that gathers costs
@@ -123,6 +219,9 @@ void LoadBalanceCosts::ComputeDiags (int step)
     // shift index for m_data
     int shift_m_data = 0;
 
+    // data of the boxes of this MPI rank only, for the openPMD output
+    std::vector<amrex::Real> local_data;
+
     // save data
     for (int lev = 0; lev < nLevels; ++lev)
     {
@@ -151,77 +250,33 @@ void LoadBalanceCosts::ComputeDiags (int step)
             m_data[shift_m_data + mfi.index()*m_nDataFields + 8] = amrex::Gpu::Device::deviceId();
 #endif
             // ...
+            if (m_write_openpmd) {
+                auto const first = m_data.begin() + shift_m_data + mfi.index()*m_nDataFields;
+                local_data.insert(local_data.end(), first, first + m_nDataFields);
+            }
         }
 
         // we looped through all the boxes on level lev, update the shift index
         shift_m_data += m_nDataFields*(costs[lev]->size());
     }
 
+    // the host names do not change during the simulation: they are collected once
+    if (!m_hostnames_collected) {
+        CollectHostnames(m_write_openpmd);
+        m_hostnames_collected = true;
+    }
+
+    if (m_write_openpmd) {
+        // every MPI rank writes its own boxes: no reduction on the IO rank
+        WriteOpenPMD(step, local_data);
+        return;
+    }
+
     // parallel reduce to IO proc and get data over all procs
     ParallelDescriptor::ReduceRealSum(m_data.data(),
                                       static_cast<int>(m_data.size()),
                                       ParallelDescriptor::IOProcessorNumber());
 
-#ifdef AMREX_USE_MPI
-    // now parallel reduce to IO proc and get string data (host name) over all procs
-    // MPI Gatherv preliminaries
-
-    // get the MPI host name and number of characters
-    char hostname[MPI_MAX_PROCESSOR_NAME];
-    int length;
-
-    BL_MPI_REQUIRE( MPI_Get_processor_name( hostname, &length ) );
-
-    // IO proc will collect messages from other procs;
-    // receive counts and displacements needed only by IO proc
-    m_data_string_recvcount.resize(ParallelDescriptor::NProcs(), 0);
-    m_data_string_recvcount.assign(ParallelDescriptor::NProcs(), 0);
-    m_data_string_disp.resize(ParallelDescriptor::NProcs(), 0);
-    m_data_string_disp.assign(ParallelDescriptor::NProcs(), 0);
-
-    // get the string lengths on IO proc
-    ParallelDescriptor::Gather(&length, 1,                     // send
-                               m_data_string_recvcount.data(), 1, // receive
-                               ParallelDescriptor::IOProcessorNumber());
-
-    // determine total length of collected strings for root, and set displacements;
-    // + 1 is for chosen separation between words in the gathered string; this
-    // chosen separator character is set further below when elements of
-    // m_data_string_recvbuf are initialized
-    m_data_string_recvbuf_length += m_data_string_recvcount[0] + 1;
-    for (int i=1; i<m_data_string_disp.size(); i++)
-    {
-        m_data_string_recvbuf_length += (m_data_string_recvcount[i] + 1);
-
-        // displacements is cumulative sum along recvcount, include the (+ 1) space separator or null terminator
-        m_data_string_disp[i] = m_data_string_disp[i-1] + m_data_string_recvcount[i-1] + 1;
-    }
-
-    // knowing the total length of string on IOProc, we can allocate memory for the receive buffer
-    // initialize spaces, null terminator is the last element
-    m_data_string_recvbuf.resize(m_data_string_recvbuf_length, ' ');
-    m_data_string_recvbuf.assign(m_data_string_recvbuf_length, ' ');
-    m_data_string_recvbuf[m_data_string_recvbuf_length-1] = '\0';
-
-    // now the root process knows cnts and locations to place messages from sending processes;
-    // collect the hostnames; m_data_string_recvbuf will provide mapping from rank-->hostname
-    ParallelDescriptor::Gatherv(&hostname[0],              /* hostname ID */
-                                length,                    /* length of hostname */
-                                m_data_string_recvbuf.data(), /* write data into string buffer */
-                                m_data_string_recvcount,   /* how many messages to receive */
-                                m_data_string_disp,        /* starting position in recv buffer to place received msg */
-                                ParallelDescriptor::IOProcessorNumber());
-#endif
-
-    // cleanup
-    if (ParallelDescriptor::MyProc() == ParallelDescriptor::IOProcessorNumber())
-    {
-#ifdef AMREX_USE_MPI
-        const std::string m_data_stdstring_recvbuf(m_data_string_recvbuf.begin(), m_data_string_recvbuf.end());
-        m_data_string = amrex::Tokenize(m_data_stdstring_recvbuf, " ");
-#endif
-    }
-
     /* m_data now contains up-to-date values for:
      *  [[cost, proc, lev, i_low, j_low, k_low, num_cells, num_macro_particles(, gpu_ID [if GPU run]) ] of box 0 at level 0,
      *   [cost, proc, lev, i_low, j_low, k_low, num_cells, num_macro_particles(, gpu_ID [if GPU run]) ] of box 1 at level 0,
@@ -243,12 +298,95 @@ void LoadBalanceCosts::ComputeDiags (int step)
      */
 }
 
+void LoadBalanceCosts::WriteOpenPMD (int step, std::vector<amrex::Real> const& local_data)
+{
+#ifdef WARPX_USE_OPENPMD
+    WARPX_PROFILE("LoadBalanceCosts::WriteOpenPMD()");
+
+    auto& warpx = WarpX::GetInstance();
+
+    // number of boxes of this MPI rank and offset of its chunk
+    const auto nboxes_local = static_cast<amrex::Long>(local_data.size() / m_nDataFields);
+    const int nprocs = ParallelDescriptor::NProcs();
+    amrex::Vector<amrex::Long> nboxes_ranks(nprocs, 0);
+    amrex::ParallelAllGather::AllGather(&nboxes_local, 1, nboxes_ranks.data(),
+                                        ParallelDescriptor::Communicator());
+    amrex::Long nboxes_total = 0;
+    amrex::Long offset = 0;
+    for (int i = 0; i < nprocs; ++i) {
+        if (i < ParallelDescriptor::MyProc()) { offset += nboxes_ranks[i]; }
+        nboxes_total += nboxes_ranks[i];
+    }
+
+    // a single series (all steps in one file) open for the whole simulation
+    if (!m_series) {
+        std::string filepath = m_path + m_rd_name + "." + m_openpmd_backend;
+        // transform paths for Windows
+#ifdef _WIN32
+        filepath = openPMD::auxiliary::replace_all(filepath, "/", "\\");
+#endif
+#if defined(AMREX_USE_MPI)
+        m_series = std::make_unique<openPMD::Series>(filepath, openPMD::Access::CREATE,
+                                                     ParallelDescriptor::Communicator());
+#else
+        m_series = std::make_unique<openPMD::Series>(filepath, openPMD::Access::CREATE);
+#endif
+        m_series->setIterationEncoding(openPMD::IterationEncoding::groupBased);
+        m_series->setSoftware("WarpX", WarpX::Version());
+        // host name of each MPI rank (the "proc" record indexes it)
+        m_series->setAttribute("hostnames", m_data_string);
+    }
+
+    auto it = m_series->iterations[step + 1];
+    it.setTime(warpx.gett_new(0));
+    // one entry per box, written as a particle species
+    auto boxes = it.particles["boxes"];
+
+    std::vector<std::string> names {"cost", "proc", "lev", "i_low", "j_low", "k_low",
+                                    "num_cells", "num_macro_particles"};
+#ifdef AMREX_USE_GPU
+    names.emplace_back("gpu_ID");
+#endif
+    const auto dataset = openPMD::Dataset(openPMD::determineDatatype<amrex::Real>(),
+                                          {static_cast<std::uint64_t>(nboxes_total)});
+    for (int k = 0; k < m_nDataFields; ++k) {
+        auto comp = boxes[names[k]][openPMD::RecordComponent::SCALAR];
+        comp.resetDataset(dataset);
+        comp.setUnitSI(1.);
+        // Do not call storeChunk() with zero-sized chunks:
+        //   https://github.com/openPMD/openPMD-api/issues/1147
+        if (nboxes_local == 0) { continue; }
+        // the data is kept alive by openPMD-api until it is flushed
+        auto values = std::shared_ptr<amrex::Real>(
+            new amrex::Real[nboxes_local], [](amrex::Real const *p){ delete[] p; });
+        for (amrex::Long i = 0; i < nboxes_local; ++i) {
+            values.get()[i] = local_data[i*m_nDataFields + k];
+        }
+        comp.storeChunk(values, {static_cast<std::uint64_t>(offset)},
+                        {static_cast<std::uint64_t>(nboxes_local)});
+    }
+
+    // outputs are buffered in memory and flushed to disk together
+    ++m_num_buffered;
+    if (m_num_buffered >= m_buffer_intervals ||
+        m_intervals.nextContains(step+1) > warpx.maxStep())
+    {
+        m_series->flush();
+        m_num_buffered = 0;
+    }
+#else
+    amrex::ignore_unused(step, local_data);
+    WARPX_ABORT_WITH_MESSAGE("LoadBalanceCosts: format = openpmd needs openPMD-api compiled into WarpX, but was not found!");
+#endif
+}
+
 // write to file function for cost
 void LoadBalanceCosts::WriteToFile (int step) const
 {
-    // open file
-    std::ofstream ofs{m_path + m_rd_name + "." + m_extension,
-            std::ofstream::out | std::ofstream::app};
+    // with the openPMD format, all MPI ranks write in ComputeDiags
+    if (m_write_openpmd) { return; }
+
+    std::ostringstream ofs;
 
     // write step
     ofs << step+1 << m_sep;
@@ -275,10 +413,9 @@ void LoadBalanceCosts::WriteToFile (int step) const
     // end loop over data size
 
     // end line
-    ofs << std::endl;
+    ofs << "\n";
 
-    // close file
-    ofs.close();
+    m_write_buffer += ofs.str();
 
     // get a reference to WarpX instance
     auto& warpx = WarpX::GetInstance();
@@ -288,6 +425,9 @@ void LoadBalanceCosts::WriteToFile (int step) const
     // final step is a special case, fill jagged array with NaN
     if (m_intervals.nextContains(step+1) > warpx.maxStep())
     {
+        // the whole time series is re-read below
+        FlushBuffer();
+
         // open tmp file to copy data
         const std::string fileTmpName = m_path + m_rd_name + ".tmp." + m_extension;
         std::ofstream ofstmp(fileTmpName, std::ofstream::out);
@@ -0,0 +1,203 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "MemoryUsage.H"
+
+#include "Diagnostics/Diagnostics.H"
+#include "Diagnostics/MultiDiagnostics.H"
+#include "Diagnostics/ReducedDiags/ReducedDiags.H"
+#include "Particles/MultiParticleContainer.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "WarpX.H"
+
+#include <AMReX_BaseFab.H>
+#include <AMReX_GpuDevice.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_REAL.H>
+#include <AMReX_iMultiFab.H>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace amrex;
+
+namespace
+{
+    const std::array<std::string, MemoryUsage::NSubsystems> subsystem_names =
+        {"fields", "pml", "eb", "fluids", "btd", "particles"};
+
+    /** Find the subsystem and the level of a MultiFab from its name in
+     *  WarpX::multifab_map, e.g. "pml_E_fp[x][level=0]" */
+    std::pair<int, int>
+    subsystemAndLevel (const std::string& name)
+    {
+        int lev = 0;
+        const auto pos = name.rfind("[level=");
+        if (pos != std::string::npos) { lev = std::stoi(name.substr(pos + 7)); }
+
+        const auto starts_with = [&name] (const std::string& prefix) {
+            return name.compare(0, prefix.size(), prefix) == 0;
+        };
+        int sub = MemoryUsage::Fields;
+        if (starts_with("pml_")) {
+            sub = MemoryUsage::PML;
+        } else if (starts_with("m_edge_lengths") || starts_with("m_face_areas") ||
+                   starts_with("m_area_mod") || starts_with("m_flag_") ||
+                   starts_with("m_distance_to_eb") || starts_with("ECTRhofield") ||
+                   starts_with("Venl")) {
+            sub = MemoryUsage::EB;
+        } else if (name.find("fluid") != std::string::npos) {
+            sub = MemoryUsage::Fluids;
+        } else if (name.find("BTD") != std::string::npos) {
+            sub = MemoryUsage::BTD;
+        }
+        return {sub, lev};
+    }
+
+    /** Number of bytes owned by the local FABs of mf (0 for an alias) */
+    template <typename MF>
+    Long localBytes (const MF& mf)
+    {
+        Long bytes = 0;
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+            bytes += static_cast<Long>(mf[mfi].nBytesOwned());
+        }
+        return bytes;
+    }
+}
+
+// constructor
+MemoryUsage::MemoryUsage (const std::string& rd_name)
+    : ReducedDiags{rd_name}
+{
+    // read number of levels
+    int nLevel = 0;
+    const ParmParse pp_amr("amr");
+    pp_amr.query("max_level", nLevel);
+    m_nLevel = nLevel + 1;
+
+    // subsystems on each level, then the field and particle buffers of the
+    // diagnostics, the total and high-water mark of the FABs, and the free device memory
+    m_data.resize(m_nLevel*NSubsystems + 5, 0.0_rt);
+
+    if (ParallelDescriptor::IOProcessor())
+    {
+        if ( m_write_header )
+        {
+            // open file
+            std::ofstream ofs{m_path + m_rd_name + "." + m_extension, std::ofstream::out};
+
+            // write header row
+            int c = 0;
+            ofs << "#";
+            ofs << "[" << c++ << "]step()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]time(s)";
+            for (int lev = 0; lev < m_nLevel; ++lev)
+            {
+                for (int sub = 0; sub < NSubsystems; ++sub)
+                {
+                    ofs << m_sep;
+                    ofs << "[" << c++ << "]" << subsystem_names[sub] << "_lev" << lev << "(B)";
+                }
+            }
+            ofs << m_sep << "[" << c++ << "]diag_field_buffers(B)";
+            ofs << m_sep << "[" << c++ << "]diag_particle_buffers(B)";
+            ofs << m_sep << "[" << c++ << "]fabs_total(B)";
+            ofs << m_sep << "[" << c++ << "]fabs_high_water_mark(B)";
+            ofs << m_sep << "[" << c++ << "]device_free_min(B)";
+            ofs << std::endl;
+
+            // close file
+            ofs.close();
+        }
+    }
+}
+
+void MemoryUsage::ComputeDiags (int step)
+{
+    // Judge if the diags should be done
+    if (!m_intervals.contains(step+1)) { return; }
+
+    // get a reference to WarpX instance
+    auto & warpx = WarpX::GetInstance();
+
+    std::fill(m_data.begin(), m_data.end(), 0.0_rt);
+    const int nLevel = std::min(warpx.finestLevel() + 1, m_nLevel);
+
+    // named MultiFabs, allocated with WarpX::AllocInitMultiFab
+    for (const auto& [name, mf] : WarpX::multifab_map)
+    {
+        if (mf == nullptr) { continue; }
+        const auto [sub, lev] = subsystemAndLevel(name);
+        if (lev >= nLevel) { continue; }
+        m_data[lev*NSubsystems + sub] += static_cast<Real>(localBytes(*mf));
+    }
+    for (const auto& [name, imf] : WarpX::imultifab_map)
+    {
+        if (imf == nullptr) { continue; }
+        const auto [sub, lev] = subsystemAndLevel(name);
+        if (lev >= nLevel) { continue; }
+        m_data[lev*NSubsystems + sub] += static_cast<Real>(localBytes(*imf));
+    }
+
+    // particles, estimated from their number and number of components
+    const auto& mypc = warpx.GetPartContainer();
+    for (int i_s = 0; i_s < mypc.nSpecies(); ++i_s)
+    {
+        const auto& pc = mypc.GetParticleContainer(i_s);
+        const auto bytes_per_particle = static_cast<Real>(sizeof(std::uint64_t)
+            + pc.NumRealComps()*sizeof(ParticleReal) + pc.NumIntComps()*sizeof(int));
+        for (int lev = 0; lev < nLevel; ++lev)
+        {
+            m_data[lev*NSubsystems + Particles] +=
+                static_cast<Real>(pc.NumberOfParticlesAtLevel(lev, false, true))*bytes_per_particle;
+        }
+    }
+
+    // output buffers of the diagnostics
+    const int i_diag_buffers = m_nLevel*NSubsystems;
+    auto& multi_diags = warpx.GetMultiDiags();
+    for (int i_diag = 0; i_diag < multi_diags.GetTotalDiags(); ++i_diag)
+    {
+        const auto& diag = multi_diags.GetDiag(i_diag);
+        m_data[i_diag_buffers] += static_cast<Real>(diag.FieldBufferBytes());
+        m_data[i_diag_buffers + 1] += static_cast<Real>(diag.ParticleBufferBytes());
+    }
+
+    // all the FABs, including those that do not belong to the subsystems above
+    // (e.g. the spectral solvers and the temporaries), and their high-water mark
+    // since the last output
+    m_data[i_diag_buffers + 2] = static_cast<Real>(amrex::TotalBytesAllocatedInFabs());
+    m_data[i_diag_buffers + 3] = static_cast<Real>(amrex::TotalBytesAllocatedInFabsHWM());
+    amrex::ResetTotalBytesAllocatedInFabsHWM();
+
+    // the free device memory is negated, so that its minimum is reduced with the maxima
+#ifdef AMREX_USE_GPU
+    m_data[i_diag_buffers + 4] = -static_cast<Real>(amrex::Gpu::Device::freeMemAvailable());
+#endif
+
+    // maximum over the MPI ranks, which is what matters for out-of-memory errors
+    ParallelDescriptor::ReduceRealMax(m_data.data(), static_cast<int>(m_data.size()),
+                                      ParallelDescriptor::IOProcessorNumber());
+#ifdef AMREX_USE_GPU
+    m_data[i_diag_buffers + 4] = -m_data[i_diag_buffers + 4];
+#endif
+
+    /* m_data now contains up-to-date values for:
+     *  [fields, pml, eb, fluids, btd, particles on level 0,
+     *   ... on level 1, ...,
+     *   diagnostics field buffers, diagnostics particle buffers,
+     *   total and high-water mark of the FABs, minimum free device memory] */
+}
@@ -16,13 +16,17 @@
 #include "FieldReduction.H"
 #include "LoadBalanceCosts.H"
 #include "LoadBalanceEfficiency.H"
+#include "MemoryUsage.H"
 #include "ParticleEnergy.H"
 #include "ParticleExtrema.H"
 #include "ParticleHistogram.H"
 #include "ParticleHistogram2D.H"
 #include "ParticleMomentum.H"
 #include "ParticleNumber.H"
+#include "ParticleSums.H"
+#include "PhaseTimings.H"
 #include "RhoMaximum.H"
+#include "Utils/Parser/ParserUtils.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXProfilerWrapper.H"
 
@@ -48,6 +52,12 @@ MultiReducedDiags::MultiReducedDiags ()
     // if names are not given, reduced diags will not be done
     if ( m_plot_rd == 0 ) { return; }
 
+    // the output of all the reduced diags is kept in memory for this number of
+    // output steps, and then written at once
+    utils::parser::queryWithParser(pp_warpx, "reduced_diags_buffer_intervals", m_buffer_intervals);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_buffer_intervals >= 1,
+        "warpx.reduced_diags_buffer_intervals must be at least 1");
+
     using CS = const std::string& ;
     const auto reduced_diags_dictionary =
         std::map<std::string, std::function<std::unique_ptr<ReducedDiags>(CS)>>{
@@ -63,10 +73,12 @@ MultiReducedDiags::MultiReducedDiags ()
             {"ColliderRelevant",      [](CS s){return std::make_unique<ColliderRelevant>(s);}},
             {"LoadBalanceCosts",      [](CS s){return std::make_unique<LoadBalanceCosts>(s);}},
             {"LoadBalanceEfficiency", [](CS s){return std::make_unique<LoadBalanceEfficiency>(s);}},
+            {"MemoryUsage",           [](CS s){return std::make_unique<MemoryUsage>(s);}},
             {"ParticleHistogram",     [](CS s){return std::make_unique<ParticleHistogram>(s);}},
             {"ParticleHistogram2D",   [](CS s){return std::make_unique<ParticleHistogram2D>(s);}},
             {"ParticleNumber",        [](CS s){return std::make_unique<ParticleNumber>(s);}},
             {"ParticleExtrema",       [](CS s){return std::make_unique<ParticleExtrema>(s);}},
+            {"PhaseTimings",          [](CS s){return std::make_unique<PhaseTimings>(s);}},
             {"ChargeOnEB",  [](CS s){return std::make_unique<ChargeOnEB>(s);}}
     };
     // loop over all reduced diags and fill m_multi_rd with requested reduced diags
@@ -89,6 +101,11 @@ MultiReducedDiags::MultiReducedDiags ()
 }
 // end constructor
 
+MultiReducedDiags::~MultiReducedDiags ()
+{
+    Flush();
+}
+
 void MultiReducedDiags::InitData ()
 {
     // loop over all reduced diags
@@ -111,6 +128,9 @@ void MultiReducedDiags::ComputeDiags (int step)
 {
     WARPX_PROFILE("MultiReducedDiags::ComputeDiags()");
 
+    // the particle sums shared by several diags are computed once, at the first request
+    ParticleSums::Invalidate();
+
     // loop over all reduced diags
     for (int i_rd = 0; i_rd < static_cast<int>(m_rd_names.size()); ++i_rd)
     {
@@ -126,15 +146,29 @@ void MultiReducedDiags::WriteToFile (int step)
     // Only the I/O rank does
     if ( !ParallelDescriptor::IOProcessor() ) { return; }
 
+    bool written = false;
+
     // loop over all reduced diags
     for (int i_rd = 0; i_rd < static_cast<int>(m_rd_names.size()); ++i_rd)
     {
         // Judge if the diags should be done
         if (!m_multi_rd[i_rd]->m_intervals.contains(step+1)) { continue; }
 
-        // call the write to file function
+        // call the write to file function, which fills the buffer of the diag
         m_multi_rd[i_rd]->WriteToFile(step);
+        written = true;
     }
     // end loop over all reduced diags
+
+    if (written) { ++m_n_buffered; }
+    if (m_n_buffered >= m_buffer_intervals) { Flush(); }
 }
 // end void MultiReducedDiags::WriteToFile
+
+void MultiReducedDiags::Flush ()
+{
+    if ( !ParallelDescriptor::IOProcessor() ) { return; }
+
+    for (const auto& rd : m_multi_rd) { rd->FlushBuffer(); }
+    m_n_buffered = 0;
+}
@@ -7,21 +7,16 @@
 
 #include "ParticleEnergy.H"
 
+#include "Diagnostics/ReducedDiags/ParticleSums.H"
 #include "Diagnostics/ReducedDiags/ReducedDiags.H"
-#include "Particles/Algorithms/KineticEnergy.H"
 #include "Particles/MultiParticleContainer.H"
-#include "Particles/SpeciesPhysicalProperties.H"
 #include "Particles/WarpXParticleContainer.H"
 #include "WarpX.H"
 
-#include <AMReX_GpuQualifiers.H>
 #include <AMReX_PODVector.H>
 #include <AMReX_ParallelDescriptor.H>
-#include <AMReX_ParticleReduce.H>
 #include <AMReX_Particles.H>
 #include <AMReX_REAL.H>
-#include <AMReX_Reduce.H>
-#include <AMReX_Tuple.H>
 #include <AMReX_Vector.H>
 
 #include <algorithm>
@@ -101,59 +96,11 @@ void ParticleEnergy::ComputeDiags (int step)
     // Loop over species
     for (int i_s = 0; i_s < nSpecies; ++i_s)
     {
-        // Get WarpXParticleContainer class object
-        const auto & myspc = mypc.GetParticleContainer(i_s);
-
-        // Get mass (used only for particles other than photons, see below)
-        const amrex::Real m = myspc.getMass();
-
-        using PType = typename WarpXParticleContainer::SuperParticleType;
-
-        amrex::Real Etot = 0.0_rt;
-        amrex::Real Ws   = 0.0_rt;
-
-        // Use amrex::ParticleReduce to compute the sum of energies and weights of all particles
-        // held by the current MPI rank for this species (loop over all boxes held by this MPI rank):
-        // the result r is the tuple (Etot, Ws)
-        amrex::ReduceOps<ReduceOpSum, ReduceOpSum> reduce_ops;
-        if(myspc.AmIA<PhysicalSpecies::photon>())
-        {
-            auto r = amrex::ParticleReduce<amrex::ReduceData<Real, Real>>(
-                myspc,
-                [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple<Real, Real>
-                {
-                    const amrex::Real w  = p.rdata(PIdx::w);
-                    const amrex::Real ux = p.rdata(PIdx::ux);
-                    const amrex::Real uy = p.rdata(PIdx::uy);
-                    const amrex::Real uz = p.rdata(PIdx::uz);
-                    return {w*Algorithms::KineticEnergyPhotons(ux,uy,uz),w};
-                },
-                reduce_ops);
-
-            Etot = amrex::get<0>(r);
-            Ws   = amrex::get<1>(r);
-        }
-        else // particle other than photons
-        {
-            auto r = amrex::ParticleReduce<amrex::ReduceData<Real, Real>>(
-                myspc,
-                [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple<Real, Real>
-                {
-                    const amrex::Real w  = p.rdata(PIdx::w);
-                    const amrex::Real ux = p.rdata(PIdx::ux);
-                    const amrex::Real uy = p.rdata(PIdx::uy);
-                    const amrex::Real uz = p.rdata(PIdx::uz);
-
-                    return {w*Algorithms::KineticEnergy(ux,uy,uz,m), w};
-                },
-                reduce_ops);
-
-            Etot = amrex::get<0>(r);
-            Ws   = amrex::get<1>(r);
-        }
-
-        // Reduced sum over MPI ranks
-        ParallelDescriptor::ReduceRealSum({Etot,Ws}, ParallelDescriptor::IOProcessorNumber());
+        // Sums of energies and weights of all particles of this species, computed
+        // together with those of the other particle reduced diags, over all MPI ranks
+        const auto & sums = ParticleSums::Get(i_s);
+        const amrex::Real Etot = sums.E;
+        const auto Ws = static_cast<amrex::Real>(sums.w);
 
         // Accumulate sum of weights over all species (must come after MPI reduction of Ws)
         Wtot += Ws;
@@ -7,6 +7,7 @@
 
 #include "ParticleHistogram.H"
 
+#include "Diagnostics/ReducedDiags/HistogramDeposition.H"
 #include "Diagnostics/ReducedDiags/ReducedDiags.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Particles/Pusher/GetAndSetPosition.H"
@@ -211,9 +212,9 @@ void ParticleHistogram::ComputeDiags (int step)
 
                 long const np = pti.numParticles();
 
-                //Flag particles that need to be copied if they cross the z_slice
-                amrex::ParallelFor(np,
-                   [=] AMREX_GPU_DEVICE(int i)
+                // add the particles to the histogram (in shared memory first, on GPU)
+                histogram::deposit(np, num_bins, dptr_data,
+                   [=] AMREX_GPU_DEVICE(int i, int& bin, amrex::Real& value) -> bool
                 {
                     amrex::ParticleReal x, y, z;
                     GetPosition(i, x, y, z);
@@ -225,24 +226,17 @@ void ParticleHistogram::ComputeDiags (int step)
                     // don't count a particle if it is filtered out
                     if (do_parser_filter) {
                         if (fun_filterparser(t, x, y, z, ux, uy, uz) == 0._rt) {
-                            return;
+                            return false;
                         }
                     }
                     // continue function if particle is not filtered out
                     auto const f = fun_partparser(t, x, y, z, ux, uy, uz);
                     // determine particle bin
-                    int const bin = int(Math::floor((f-bin_min)/bin_size));
-                    if ( bin<0 || bin>=num_bins ) { return; } // discard if out-of-range
-
-                    // add particle to histogram bin
-                    //! @todo performance: on CPU, we are probably faster by
-                    //        letting each thread compute its own histogram and
-                    //        then we reduce the histograms after the loop
-                    if ( is_unity_particle_weight ) {
-                        amrex::HostDevice::Atomic::Add(&dptr_data[bin], 1.0_rt);
-                    } else {
-                        amrex::HostDevice::Atomic::Add(&dptr_data[bin], w);
-                    }
+                    bin = int(Math::floor((f-bin_min)/bin_size));
+                    if ( bin<0 || bin>=num_bins ) { return false; } // discard if out-of-range
+
+                    value = is_unity_particle_weight ? 1.0_rt : w;
+                    return true;
                 });
             }
         }
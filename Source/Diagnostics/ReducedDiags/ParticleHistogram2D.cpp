@@ -7,6 +7,7 @@
  */
 #include "ParticleHistogram2D.H"
 
+#include "Diagnostics/ReducedDiags/HistogramDeposition.H"
 #include "Diagnostics/ReducedDiags/ReducedDiags.H"
 #include "Diagnostics/OpenPMDHelpFunction.H"
 #include "Particles/MultiParticleContainer.H"
@@ -59,6 +60,9 @@ ParticleHistogram2D::ParticleHistogram2D (const std::string& rd_name)
 {
     ParmParse pp_rd_name(rd_name);
 
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!m_binary,
+        "ParticleHistogram2D: the binary format is not supported, the output is written with openPMD");
+
     pp_rd_name.query("openpmd_backend", m_openpmd_backend);
     pp_rd_name.query("file_min_digits", m_file_min_digits);
     // pick first available backend if default is chosen
@@ -205,39 +209,41 @@ void ParticleHistogram2D::ComputeDiags (int step)
 
                 long const np = pti.numParticles();
 
-                //Flag particles that need to be copied if they cross the z_slice
-                amrex::ParallelFor(np,
-                                   [=] AMREX_GPU_DEVICE(int i)
-                                   {
-                                       amrex::ParticleReal x, y, z;
-                                       GetPosition(i, x, y, z);
-                                       auto const w  = (amrex::Real)d_w[i];
-                                       auto const ux = d_ux[i] / PhysConst::c;
-                                       auto const uy = d_uy[i] / PhysConst::c;
-                                       auto const uz = d_uz[i] / PhysConst::c;
-
-                                       // don't count a particle if it is filtered out
-                                       if (do_parser_filter) {
-                                           if(!static_cast<bool>(fun_filterparser(t, x, y, z, ux, uy, uz, w))) {
-                                               return;
-                                           }
-                                       }
-
-                                       // continue function if particle is not filtered out
-                                       auto const f_abs = fun_partparser_abs(t, x, y, z, ux, uy, uz, w);
-                                       auto const f_ord = fun_partparser_ord(t, x, y, z, ux, uy, uz, w);
-                                       auto const weight = fun_valueparser(t, x, y, z, ux, uy, uz, w);
-
-                                       // determine particle bin
-                                       int const bin_abs = int(Math::floor((f_abs-bin_min_abs)/bin_size_abs));
-                                       if ( bin_abs<0 || bin_abs>=num_bins_abs ) { return; } // discard if out-of-range
-
-                                       int const bin_ord = int(Math::floor((f_ord-bin_min_ord)/bin_size_ord));
-                                       if ( bin_ord<0 || bin_ord>=num_bins_ord ) { return; } // discard if out-of-range
-
-                                       amrex::Real &data = d_table(bin_abs, bin_ord);
-                                       amrex::HostDevice::Atomic::Add(&data, weight);
-                                   });
+                // add the particles to the histogram (in shared memory first, on GPU,
+                // if it fits); the flattened bin index follows the layout of d_table
+                histogram::deposit(np, num_bins_abs*num_bins_ord, d_table.p,
+                    [=] AMREX_GPU_DEVICE(int i, int& bin, amrex::Real& value) -> bool
+                    {
+                        amrex::ParticleReal x, y, z;
+                        GetPosition(i, x, y, z);
+                        auto const w  = (amrex::Real)d_w[i];
+                        auto const ux = d_ux[i] / PhysConst::c;
+                        auto const uy = d_uy[i] / PhysConst::c;
+                        auto const uz = d_uz[i] / PhysConst::c;
+
+                        // don't count a particle if it is filtered out
+                        if (do_parser_filter) {
+                            if(!static_cast<bool>(fun_filterparser(t, x, y, z, ux, uy, uz, w))) {
+                                return false;
+                            }
+                        }
+
+                        // continue function if particle is not filtered out
+                        auto const f_abs = fun_partparser_abs(t, x, y, z, ux, uy, uz, w);
+                        auto const f_ord = fun_partparser_ord(t, x, y, z, ux, uy, uz, w);
+                        auto const weight = fun_valueparser(t, x, y, z, ux, uy, uz, w);
+
+                        // determine particle bin
+                        int const bin_abs = int(Math::floor((f_abs-bin_min_abs)/bin_size_abs));
+                        if ( bin_abs<0 || bin_abs>=num_bins_abs ) { return false; } // discard if out-of-range
+
+                        int const bin_ord = int(Math::floor((f_ord-bin_min_ord)/bin_size_ord));
+                        if ( bin_ord<0 || bin_ord>=num_bins_ord ) { return false; } // discard if out-of-range
+
+                        bin = bin_abs + bin_ord*num_bins_abs;
+                        value = weight;
+                        return true;
+                    });
             }
         }
     }
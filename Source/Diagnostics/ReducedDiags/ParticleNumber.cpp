@@ -7,6 +7,7 @@
 
 #include "ParticleNumber.H"
 
+#include "Diagnostics/ReducedDiags/ParticleSums.H"
 #include "Diagnostics/ReducedDiags/ReducedDiags.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Particles/WarpXParticleContainer.H"
@@ -111,14 +112,15 @@ void ParticleNumber::ComputeDiags (int step)
     // loop over species
     for (int i_s = 0; i_s < nSpecies; ++i_s)
     {
-        // get WarpXParticleContainer class object
-        auto & myspc = mypc.GetParticleContainer(i_s);
+        // sums over the particles of this species, computed together with those
+        // of the other particle reduced diags
+        const auto & sums = ParticleSums::Get(i_s);
 
         // Save total number of macroparticles for this species
-        m_data[idx_first_species_macroparticles + i_s] = myspc.TotalNumberOfParticles();
+        m_data[idx_first_species_macroparticles + i_s] = static_cast<amrex::Real>(sums.np);
 
         // Save sum of particles weight for this species
-        m_data[idx_first_species_sum_weight + i_s] = myspc.sumParticleWeight(false);
+        m_data[idx_first_species_sum_weight + i_s] = sums.w;
 
         // Increase total number of macroparticles and total weight (all species)
         m_data[idx_total_macroparticles] += m_data[idx_first_species_macroparticles + i_s];
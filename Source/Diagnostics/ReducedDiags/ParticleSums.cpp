@@ -0,0 +1,125 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "ParticleSums.H"
+
+#include "Particles/Algorithms/KineticEnergy.H"
+#include "Particles/MultiParticleContainer.H"
+#include "Particles/SpeciesPhysicalProperties.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXConst.H"
+#include "Utils/WarpXProfilerWrapper.H"
+#include "WarpX.H"
+
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParticleReduce.H>
+#include <AMReX_Particles.H>
+#include <AMReX_Reduce.H>
+#include <AMReX_Tuple.H>
+
+using namespace amrex;
+
+std::vector<ParticleSums::SpeciesSums> ParticleSums::m_sums;
+bool ParticleSums::m_valid = false;
+
+void ParticleSums::Invalidate ()
+{
+    m_valid = false;
+}
+
+ParticleSums::SpeciesSums const& ParticleSums::Get (int i_s)
+{
+    if (!m_valid) {
+        Compute();
+        m_valid = true;
+    }
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(i_s >= 0 && i_s < static_cast<int>(m_sums.size()),
+        "ParticleSums: invalid species index");
+    return m_sums[i_s];
+}
+
+void ParticleSums::Compute ()
+{
+    WARPX_PROFILE("ParticleSums::Compute()");
+
+    // Get MultiParticleContainer class object
+    const auto & mypc = WarpX::GetInstance().GetPartContainer();
+
+    // Get number of species
+    const int nSpecies = mypc.nSpecies();
+
+    m_sums.assign(nSpecies, SpeciesSums{});
+
+    // Local sums of each species, reduced over MPI ranks all at once below
+    std::vector<Real> sums_real(4*nSpecies);
+    std::vector<ParticleReal> sums_w(nSpecies);
+    std::vector<Long> sums_np(nSpecies);
+
+    // Loop over species
+    for (int i_s = 0; i_s < nSpecies; ++i_s)
+    {
+        // Get WarpXParticleContainer class object
+        const auto & myspc = mypc.GetParticleContainer(i_s);
+
+        // Photons have zero mass: their energy is computed separately, and
+        // ux, uy, uz are calculated assuming a mass equal to the electron mass
+        const bool is_photon = myspc.AmIA<PhysicalSpecies::photon>();
+        const amrex::Real m = myspc.getMass();
+        const amrex::Real m_mom = is_photon ? PhysConst::m_e : m;
+
+        using PType = typename WarpXParticleContainer::SuperParticleType;
+
+        // Use amrex::ParticleReduce to compute, in a single pass, the sums of the energies,
+        // momenta and weights and the number of the particles held by the current MPI rank
+        // for this species: the result r is the tuple (Etot, Px, Py, Pz, Ws, Np)
+        amrex::ReduceOps<ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum,
+                         ReduceOpSum> reduce_ops;
+        auto r = amrex::ParticleReduce<amrex::ReduceData<Real, Real, Real, Real, ParticleReal, Long>>(
+            myspc,
+            [=] AMREX_GPU_DEVICE(const PType& p) noexcept
+                -> amrex::GpuTuple<Real, Real, Real, Real, ParticleReal, Long>
+            {
+                const amrex::ParticleReal w  = p.rdata(PIdx::w);
+                const amrex::Real ux = p.rdata(PIdx::ux);
+                const amrex::Real uy = p.rdata(PIdx::uy);
+                const amrex::Real uz = p.rdata(PIdx::uz);
+                const amrex::Real E = is_photon ?
+                    Algorithms::KineticEnergyPhotons(ux,uy,uz) :
+                    Algorithms::KineticEnergy(ux,uy,uz,m);
+                // as TotalNumberOfParticles, only the valid particles are counted
+                const amrex::Long valid = (p.id() > 0) ? 1 : 0;
+                return {w*E, w*m_mom*ux, w*m_mom*uy, w*m_mom*uz, w, valid};
+            },
+            reduce_ops);
+
+        sums_real[4*i_s+0] = amrex::get<0>(r);
+        sums_real[4*i_s+1] = amrex::get<1>(r);
+        sums_real[4*i_s+2] = amrex::get<2>(r);
+        sums_real[4*i_s+3] = amrex::get<3>(r);
+        sums_w[i_s] = amrex::get<4>(r);
+        sums_np[i_s] = amrex::get<5>(r);
+    }
+
+    // Reduced sum over MPI ranks, for all species at once
+    if (nSpecies > 0) {
+        ParallelDescriptor::ReduceRealSum(sums_real.data(), static_cast<int>(sums_real.size()));
+        ParallelDescriptor::ReduceRealSum(sums_w.data(), static_cast<int>(sums_w.size()));
+        ParallelDescriptor::ReduceLongSum(sums_np.data(), static_cast<int>(sums_np.size()));
+    }
+
+    for (int i_s = 0; i_s < nSpecies; ++i_s)
+    {
+        m_sums[i_s].E  = sums_real[4*i_s+0];
+        m_sums[i_s].Px = sums_real[4*i_s+1];
+        m_sums[i_s].Py = sums_real[4*i_s+2];
+        m_sums[i_s].Pz = sums_real[4*i_s+3];
+        m_sums[i_s].w  = sums_w[i_s];
+        m_sums[i_s].np = sums_np[i_s];
+    }
+}
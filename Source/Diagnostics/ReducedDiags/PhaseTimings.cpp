@@ -0,0 +1,151 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "PhaseTimings.H"
+
+#include "Diagnostics/ReducedDiags/ReducedDiags.H"
+#include "Utils/KernelCounters.H"
+#include "Utils/PhaseTimer.H"
+#include "Utils/TextMsg.H"
+#include "WarpX.H"
+
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_REAL.H>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+using namespace amrex;
+
+// constructor
+PhaseTimings::PhaseTimings (const std::string& rd_name)
+    : ReducedDiags{rd_name}
+{
+    const ParmParse pp_rd_name(rd_name);
+
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!m_binary,
+        "PhaseTimings: the binary format is not supported, the output is written as JSON lines");
+
+    // synchronize the GPU at the boundaries of the phases
+    bool synchronize_gpu = false;
+    pp_rd_name.query("synchronize_gpu", synchronize_gpu);
+
+    PhaseTimer::Enable(synchronize_gpu);
+
+    // roofline counters of the main kernels
+    pp_rd_name.query("kernel_counters", m_kernel_counters);
+    if (m_kernel_counters) {
+        KernelCounters::Enable();
+        m_kernel_data.resize(4*KernelCounters::NKernels, 0.);
+    }
+
+    // resize data array: number of steps, then min, avg, max of each phase
+    m_data.resize(1 + 3*PhaseTimer::NPhases, 0.0_rt);
+}
+
+// Reduce the phase times across MPI ranks
+void PhaseTimings::ComputeDiags (int step)
+{
+    ++m_nsteps;
+
+    // Judge if the diags should be done
+    if (!m_intervals.contains(step+1)) { return; }
+
+    const auto& times = PhaseTimer::Times();
+    std::vector<Real> tmin(times.begin(), times.end());
+    std::vector<Real> tmax(times.begin(), times.end());
+    std::vector<Real> tsum(times.begin(), times.end());
+
+    ParallelDescriptor::ReduceRealMin(tmin.data(), PhaseTimer::NPhases);
+    ParallelDescriptor::ReduceRealMax(tmax.data(), PhaseTimer::NPhases);
+    ParallelDescriptor::ReduceRealSum(tsum.data(), PhaseTimer::NPhases);
+
+    const auto nprocs = static_cast<Real>(ParallelDescriptor::NProcs());
+
+    m_data[0] = static_cast<Real>(m_nsteps);
+    for (int p = 0; p < PhaseTimer::NPhases; ++p)
+    {
+        m_data[1 + 3*p    ] = tmin[p];
+        m_data[1 + 3*p + 1] = tsum[p] / nprocs;
+        m_data[1 + 3*p + 2] = tmax[p];
+    }
+
+    /* m_data now contains up-to-date values for:
+     *  [number of steps since the last output,
+     *   min, avg, max of the time of phase 0,
+     *   min, avg, max of the time of phase 1,
+     *   ......] */
+
+    if (m_kernel_counters)
+    {
+        // calls, bytes and flops are summed over ranks; since the ranks run
+        // concurrently, the time of the slowest rank is used for the rates
+        constexpr int nk = KernelCounters::NKernels;
+        std::copy(KernelCounters::Calls().begin(), KernelCounters::Calls().end(), m_kernel_data.begin());
+        std::copy(KernelCounters::Times().begin(), KernelCounters::Times().end(), m_kernel_data.begin() + nk);
+        std::copy(KernelCounters::Bytes().begin(), KernelCounters::Bytes().end(), m_kernel_data.begin() + 2*nk);
+        std::copy(KernelCounters::Flops().begin(), KernelCounters::Flops().end(), m_kernel_data.begin() + 3*nk);
+        ParallelDescriptor::ReduceRealSum(m_kernel_data.data(), nk);
+        ParallelDescriptor::ReduceRealMax(m_kernel_data.data() + nk, nk);
+        ParallelDescriptor::ReduceRealSum(m_kernel_data.data() + 2*nk, 2*nk);
+        KernelCounters::Reset();
+    }
+
+    PhaseTimer::Reset();
+    m_nsteps = 0;
+}
+
+// write to file function
+void PhaseTimings::WriteToFile (int step) const
+{
+    std::ostringstream ofs;
+
+    // set precision
+    ofs << std::setprecision(m_precision) << std::scientific;
+
+    ofs << "{\"step\":" << step+1
+        << ",\"time\":" << WarpX::GetInstance().gett_new(0)
+        << ",\"steps\":" << static_cast<int>(m_data[0])
+        << ",\"phases\":{";
+    for (int p = 0; p < PhaseTimer::NPhases; ++p)
+    {
+        if (p > 0) { ofs << ","; }
+        ofs << "\"" << PhaseTimer::names[p] << "\":{"
+            << "\"min\":" << m_data[1 + 3*p]
+            << ",\"avg\":" << m_data[1 + 3*p + 1]
+            << ",\"max\":" << m_data[1 + 3*p + 2] << "}";
+    }
+    ofs << "}";
+
+    if (m_kernel_counters)
+    {
+        constexpr int nk = KernelCounters::NKernels;
+        ofs << ",\"kernels\":{";
+        for (int k = 0; k < nk; ++k)
+        {
+            const double time = m_kernel_data[nk + k];
+            const double bytes = m_kernel_data[2*nk + k];
+            const double flops = m_kernel_data[3*nk + k];
+            if (k > 0) { ofs << ","; }
+            ofs << "\"" << KernelCounters::names[k] << "\":{"
+                << "\"calls\":" << static_cast<long>(m_kernel_data[k])
+                << ",\"time\":" << time
+                << ",\"bytes\":" << bytes
+                << ",\"flops\":" << flops
+                << ",\"GB/s\":" << ((time > 0.) ? bytes/time*1.e-9 : 0.)
+                << ",\"GFlop/s\":" << ((time > 0.) ? flops/time*1.e-9 : 0.) << "}";
+        }
+        ofs << "}";
+    }
+
+    ofs << "}\n";
+
+    m_write_buffer += ofs.str();
+}
@@ -19,6 +19,7 @@
 
 #include <fstream>
 #include <iomanip>
+#include <sstream>
 
 using namespace amrex;
 
@@ -36,6 +37,11 @@ m_rd_name{rd_name}
     // read extension
     pp_rd_name.query("extension", m_extension);
 
+    // read output format (the openPMD format of some diags is read in their constructor)
+    std::string format = "txt";
+    pp_rd_name.query("format", format);
+    m_binary = (format == "binary");
+
     // check if it is a restart run
     std::string restart_chkfile;
     const ParmParse pp_amr("amr");
@@ -56,6 +62,11 @@ m_rd_name{rd_name}
         {
             std::ofstream ofs{rd_full_file_name, std::ios::trunc};
             ofs.close();
+            if (m_binary)
+            {
+                std::ofstream ofs_bin{DataFileName(), std::ios::trunc | std::ios::binary};
+                ofs_bin.close();
+            }
         }
     }
 
@@ -100,9 +111,19 @@ void ReducedDiags::BackwardCompatibility () const
 // write to file function
 void ReducedDiags::WriteToFile (int step) const
 {
-    // open file
-    std::ofstream ofs{m_path + m_rd_name + "." + m_extension,
-        std::ofstream::out | std::ofstream::app};
+    if (m_binary)
+    {
+        // one row of doubles: step, time, data
+        const auto append = [this] (double value) {
+            m_write_buffer.append(reinterpret_cast<const char*>(&value), sizeof(double));
+        };
+        append(static_cast<double>(step+1));
+        append(static_cast<double>(WarpX::GetInstance().gett_new(0)));
+        for (const auto& item : m_data) { append(static_cast<double>(item)); }
+        return;
+    }
+
+    std::ostringstream ofs;
 
     // write step
     ofs << step+1;
@@ -121,9 +142,24 @@ void ReducedDiags::WriteToFile (int step) const
     // end loop over data size
 
     // end line
-    ofs << std::endl;
+    ofs << "\n";
 
-    // close file
-    ofs.close();
+    m_write_buffer += ofs.str();
 }
 // end ReducedDiags::WriteToFile
+
+void ReducedDiags::FlushBuffer () const
+{
+    if (m_write_buffer.empty()) { return; }
+
+    std::ofstream ofs{DataFileName(), std::ofstream::out | std::ofstream::app | std::ofstream::binary};
+    ofs.write(m_write_buffer.data(), static_cast<std::streamsize>(m_write_buffer.size()));
+    ofs.close();
+
+    m_write_buffer.clear();
+}
+
+std::string ReducedDiags::DataFileName () const
+{
+    return m_path + m_rd_name + "." + (m_binary ? std::string("bin") : m_extension);
+}
@@ -72,6 +72,7 @@ RhoMaximum::RhoMaximum (const std::string& rd_name)
         if (mypc.GetParticleContainer(i).getCharge() != 0.0_rt)
         {
             indices_charged_species.push_back(i);
+            m_species_deposit.push_back(!mypc.GetParticleContainer(i).do_not_deposit);
             n_charged_species += 1;
             for (int lev = 0; lev < nLevel; ++lev)
             {
@@ -147,29 +148,60 @@ void RhoMaximum::ComputeDiags (int step)
         constexpr int ngrow = 0;
         amrex::MultiFab mf_temp(ba, dmap, ncomp, ngrow);
 
-        // Fill temporary MultiFAB with total charge density
         constexpr int idx_total_rho_functor = 0;
         constexpr int idx_first_species_functor = 1;
         constexpr int icomp = 0;
         constexpr int i_buffer = 0;
-        m_rho_functors[lev][idx_total_rho_functor]->operator()(mf_temp, icomp, i_buffer);
-
         constexpr int idx_max_rho_data = 0;
         constexpr int idx_min_rho_data = 1;
         constexpr int idx_first_species_data = 2;
+        constexpr bool local = true;
+        amrex::Real* const data = m_data.data() + lev*noutputs_per_level;
 
-        // Fill output array with min and max of total rho
-        m_data[lev*noutputs_per_level + idx_max_rho_data] = mf_temp.max(icomp);
-        m_data[lev*noutputs_per_level + idx_min_rho_data] = mf_temp.min(icomp);
+        if (warpx.DoFluidSpecies()) {
+            // Fill temporary MultiFAB with total charge density (including the fluids)
+            m_rho_functors[lev][idx_total_rho_functor]->operator()(mf_temp, icomp, i_buffer);
+            data[idx_max_rho_data] = mf_temp.max(icomp, ngrow, local);
+            data[idx_min_rho_data] = mf_temp.min(icomp, ngrow, local);
 
-        // Loop over all charged species
-        for (int i = 0; i < n_charged_species; ++i)
-        {
-            // Fill temporary MultiFAB with the species charge density
-            m_rho_functors[lev][idx_first_species_functor+i]->operator()(mf_temp, icomp, i_buffer);
-            // Fill output array with max |rho| of species
-            m_data[lev*noutputs_per_level + idx_first_species_data + i] = mf_temp.norm0();
+            // Loop over all charged species
+            for (int i = 0; i < n_charged_species; ++i)
+            {
+                // Fill temporary MultiFAB with the species charge density
+                m_rho_functors[lev][idx_first_species_functor+i]->operator()(mf_temp, icomp, i_buffer);
+                // Fill output array with max |rho| of species
+                data[idx_first_species_data + i] = mf_temp.norm0(icomp, ngrow, local);
+            }
+        } else {
+            // Without fluids, the total charge density is the sum of the charge
+            // densities of the depositing species: accumulate it while looping
+            // over the species, instead of depositing the charge a second time
+            amrex::MultiFab mf_total(ba, dmap, ncomp, ngrow);
+            mf_total.setVal(0.0_rt);
+            for (int i = 0; i < n_charged_species; ++i)
+            {
+                // Fill temporary MultiFAB with the species charge density
+                m_rho_functors[lev][idx_first_species_functor+i]->operator()(mf_temp, icomp, i_buffer);
+                // Fill output array with max |rho| of species
+                data[idx_first_species_data + i] = mf_temp.norm0(icomp, ngrow, local);
+                if (m_species_deposit[i]) {
+                    amrex::MultiFab::Add(mf_total, mf_temp, icomp, icomp, ncomp, ngrow);
+                }
+            }
+            data[idx_max_rho_data] = mf_total.max(icomp, ngrow, local);
+            data[idx_min_rho_data] = mf_total.min(icomp, ngrow, local);
         }
+
+        // The minimum is reduced as the maximum of its opposite
+        data[idx_min_rho_data] = -data[idx_min_rho_data];
+    }
+
+    // A single reduction for all the levels and all the species
+    amrex::ParallelDescriptor::ReduceRealMax(m_data.data(), static_cast<int>(m_data.size()));
+    for (int lev = 0; lev < nLevel; ++lev)
+    {
+        constexpr int idx_min_rho_data = 1;
+        m_data[lev*noutputs_per_level + idx_min_rho_data] = -m_data[lev*noutputs_per_level + idx_min_rho_data];
     }
     // end loop over refinement levels
 
@@ -25,6 +25,7 @@
 #   include <AMReX_AmrMeshInSituBridge.H>
 #endif
 #include <AMReX_BoxArray.H>
+#include <AMReX_BoxList.H>
 #include <AMReX_Config.H>
 #include <AMReX_DistributionMapping.H>
 #include <AMReX_Geometry.H>
@@ -84,6 +85,26 @@ WarpX::GetRestartDMap (const std::string& chkfile, const amrex::BoxArray& ba, in
     return dm;
 }
 
+amrex::BoxArray
+WarpX::MakeRestartGrids (const amrex::BoxArray& ba_checkpoint, int lev) const
+{
+    // Merge the boxes of the checkpoint, then chop the region they cover
+    // with the max_grid_size of this run
+    BoxList bl = ba_checkpoint.boxList();
+    bl.simplify();
+    BoxArray ba(std::move(bl));
+
+    const IntVect& bf = blockingFactor(lev);
+    if (ba.coarsenable(bf)) {
+        ba.coarsen(bf);
+        ba.maxSize(maxGridSize(lev) / bf);
+        ba.refine(bf);
+    } else {
+        ba.maxSize(maxGridSize(lev));
+    }
+    return ba;
+}
+
 void
 WarpX::InitFromCheckpoint ()
 {
@@ -198,7 +219,12 @@ WarpX::InitFromCheckpoint ()
             BoxArray ba;
             ba.readFrom(is);
             ablastr::utils::text::goto_next_line(is);
-            const DistributionMapping dm = GetRestartDMap(restart_chkfile, ba, lev);
+            if (restart_with_new_grids) {
+                ba = MakeRestartGrids(ba, lev);
+            }
+            const DistributionMapping dm = restart_with_new_grids ?
+                DistributionMapping{ba, ParallelDescriptor::NProcs()} :
+                GetRestartDMap(restart_chkfile, ba, lev);
             SetBoxArray(lev, ba);
             SetDistributionMap(lev, dm);
             AllocLevelData(lev, ba, dm);
@@ -294,86 +320,116 @@ WarpX::InitFromCheckpoint ()
             }
         }
 
-        VisMF::Read(*Efield_fp[lev][0],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_fp"));
-        VisMF::Read(*Efield_fp[lev][1],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_fp"));
-        VisMF::Read(*Efield_fp[lev][2],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_fp"));
-
-        VisMF::Read(*Bfield_fp[lev][0],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_fp"));
-        VisMF::Read(*Bfield_fp[lev][1],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_fp"));
-        VisMF::Read(*Bfield_fp[lev][2],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_fp"));
+        ReadMultiFab(*Efield_fp[lev][0],
+                     amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_fp"),
+                     restart_with_new_grids);
+        ReadMultiFab(*Efield_fp[lev][1],
+                     amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_fp"),
+                     restart_with_new_grids);
+        ReadMultiFab(*Efield_fp[lev][2],
+                     amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_fp"),
+                     restart_with_new_grids);
+
+        ReadMultiFab(*Bfield_fp[lev][0],
+                     amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_fp"),
+                     restart_with_new_grids);
+        ReadMultiFab(*Bfield_fp[lev][1],
+                     amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_fp"),
+                     restart_with_new_grids);
+        ReadMultiFab(*Bfield_fp[lev][2],
+                     amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_fp"),
+                     restart_with_new_grids);
 
         if (WarpX::fft_do_time_averaging)
         {
-            VisMF::Read(*Efield_avg_fp[lev][0],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_avg_fp"));
-            VisMF::Read(*Efield_avg_fp[lev][1],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_avg_fp"));
-            VisMF::Read(*Efield_avg_fp[lev][2],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_avg_fp"));
-
-            VisMF::Read(*Bfield_avg_fp[lev][0],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_avg_fp"));
-            VisMF::Read(*Bfield_avg_fp[lev][1],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_avg_fp"));
-            VisMF::Read(*Bfield_avg_fp[lev][2],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_avg_fp"));
+            ReadMultiFab(*Efield_avg_fp[lev][0],
+                         amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_avg_fp"),
+                         restart_with_new_grids);
+            ReadMultiFab(*Efield_avg_fp[lev][1],
+                         amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_avg_fp"),
+                         restart_with_new_grids);
+            ReadMultiFab(*Efield_avg_fp[lev][2],
+                         amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_avg_fp"),
+                         restart_with_new_grids);
+
+            ReadMultiFab(*Bfield_avg_fp[lev][0],
+                         amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_avg_fp"),
+                         restart_with_new_grids);
+            ReadMultiFab(*Bfield_avg_fp[lev][1],
+                         amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_avg_fp"),
+                         restart_with_new_grids);
+            ReadMultiFab(*Bfield_avg_fp[lev][2],
+                         amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_avg_fp"),
+                         restart_with_new_grids);
         }
 
         if (is_synchronized) {
-            VisMF::Read(*current_fp[lev][0],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jx_fp"));
-            VisMF::Read(*current_fp[lev][1],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jy_fp"));
-            VisMF::Read(*current_fp[lev][2],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jz_fp"));
+            ReadMultiFab(*current_fp[lev][0],
+                         amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jx_fp"),
+                         restart_with_new_grids);
+            ReadMultiFab(*current_fp[lev][1],
+                         amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jy_fp"),
+                         restart_with_new_grids);
+            ReadMultiFab(*current_fp[lev][2],
+                         amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jz_fp"),
+                         restart_with_new_grids);
         }
 
         if (lev > 0)
         {
-            VisMF::Read(*Efield_cp[lev][0],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_cp"));
-            VisMF::Read(*Efield_cp[lev][1],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_cp"));
-            VisMF::Read(*Efield_cp[lev][2],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_cp"));
-
-            VisMF::Read(*Bfield_cp[lev][0],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_cp"));
-            VisMF::Read(*Bfield_cp[lev][1],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_cp"));
-            VisMF::Read(*Bfield_cp[lev][2],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_cp"));
+            ReadMultiFab(*Efield_cp[lev][0],
+                         amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_cp"),
+                         restart_with_new_grids);
+            ReadMultiFab(*Efield_cp[lev][1],
+                         amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_cp"),
+                         restart_with_new_grids);
+            ReadMultiFab(*Efield_cp[lev][2],
+                         amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_cp"),
+                         restart_with_new_grids);
+
+            ReadMultiFab(*Bfield_cp[lev][0],
+                         amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_cp"),
+                         restart_with_new_grids);
+            ReadMultiFab(*Bfield_cp[lev][1],
+                         amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_cp"),
+                         restart_with_new_grids);
+            ReadMultiFab(*Bfield_cp[lev][2],
+                         amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_cp"),
+                         restart_with_new_grids);
 
             if (WarpX::fft_do_time_averaging)
             {
-                VisMF::Read(*Efield_avg_cp[lev][0],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_avg_cp"));
-                VisMF::Read(*Efield_avg_cp[lev][1],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_avg_cp"));
-                VisMF::Read(*Efield_avg_cp[lev][2],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_avg_cp"));
-
-                VisMF::Read(*Bfield_avg_cp[lev][0],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_avg_cp"));
-                VisMF::Read(*Bfield_avg_cp[lev][1],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_avg_cp"));
-                VisMF::Read(*Bfield_avg_cp[lev][2],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_avg_cp"));
+                ReadMultiFab(*Efield_avg_cp[lev][0],
+                             amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_avg_cp"),
+                             restart_with_new_grids);
+                ReadMultiFab(*Efield_avg_cp[lev][1],
+                             amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_avg_cp"),
+                             restart_with_new_grids);
+                ReadMultiFab(*Efield_avg_cp[lev][2],
+                             amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_avg_cp"),
+                             restart_with_new_grids);
+
+                ReadMultiFab(*Bfield_avg_cp[lev][0],
+                             amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_avg_cp"),
+                             restart_with_new_grids);
+                ReadMultiFab(*Bfield_avg_cp[lev][1],
+                             amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_avg_cp"),
+                             restart_with_new_grids);
+                ReadMultiFab(*Bfield_avg_cp[lev][2],
+                             amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_avg_cp"),
+                             restart_with_new_grids);
             }
 
             if (is_synchronized) {
-                VisMF::Read(*current_cp[lev][0],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jx_cp"));
-                VisMF::Read(*current_cp[lev][1],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jy_cp"));
-                VisMF::Read(*current_cp[lev][2],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jz_cp"));
+                ReadMultiFab(*current_cp[lev][0],
+                             amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jx_cp"),
+                             restart_with_new_grids);
+                ReadMultiFab(*current_cp[lev][1],
+                             amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jy_cp"),
+                             restart_with_new_grids);
+                ReadMultiFab(*current_cp[lev][2],
+                             amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jz_cp"),
+                             restart_with_new_grids);
             }
         }
     }
@@ -383,11 +439,13 @@ WarpX::InitFromCheckpoint ()
     {
         for (int lev = 0; lev < nlevs; ++lev) {
             if (pml[lev]) {
-                pml[lev]->Restart(amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "pml"));
+                pml[lev]->Restart(amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "pml"),
+                                  restart_with_new_grids);
             }
 #if (defined WARPX_DIM_RZ) && (defined WARPX_USE_FFT)
             if (pml_rz[lev]) {
-                pml_rz[lev]->Restart(amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "pml_rz"));
+                pml_rz[lev]->Restart(amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "pml_rz"),
+                                     restart_with_new_grids);
             }
 #endif
         }
@@ -9,6 +9,7 @@
 #include "Particles/ParticleIO.H"
 #include "Diagnostics/ParticleDiag/ParticleDiag.H"
 #include "FieldIO.H"
+#include "Diagnostics/ParticleDiag/CopySelectedParticles.H"
 #include "Particles/Filter/FilterFunctors.H"
 #include "Particles/NamedComponentParticleContainer.H"
 #include "Utils/TextMsg.H"
@@ -43,6 +44,8 @@
 #include <algorithm>
 #include <cctype>
 #include <cstdint>
+#include <cstring>
+#include <future>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -50,6 +53,7 @@
 #include <set>
 #include <string>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 
 namespace detail
@@ -377,11 +381,21 @@ WarpXOpenPMDPlot::WarpXOpenPMDPlot (
     const std::string& openPMDFileType,
     const std::string& operator_type,
     const std::map< std::string, std::string >& operator_parameters,
+    const std::string& fields_operator_type,
+    const std::map< std::string, std::string >& fields_operator_parameters,
     const std::string& engine_type,
     const std::map< std::string, std::string >& engine_parameters,
     const std::vector<bool>& fieldPMLdirections,
-    const std::string& authors)
+    const std::string& authors,
+    bool async_flush,
+    amrex::Long async_max_staging_bytes,
+    bool pack_particles,
+    bool reuse_particle_staging)
     : m_Series(nullptr),
+      m_async_flush{async_flush},
+      m_async_max_staging_bytes{async_max_staging_bytes},
+      m_pack_particles{pack_particles},
+      m_reuse_particle_staging{reuse_particle_staging},
       m_MPIRank{amrex::ParallelDescriptor::MyProc()},
       m_MPISize{amrex::ParallelDescriptor::NProcs()},
       m_Encoding(ie),
@@ -391,15 +405,43 @@ WarpXOpenPMDPlot::WarpXOpenPMDPlot (
 {
     m_OpenPMDoptions = detail::getSeriesOptions(operator_type, operator_parameters,
                                                 engine_type, engine_parameters);
+    // per-dataset options of the field meshes: same layout as the series options,
+    // with an operator block only
+    m_OpenPMDFieldsDatasetOptions = detail::getSeriesOptions(
+        fields_operator_type, fields_operator_parameters, "", {});
+
+#if defined(AMREX_USE_MPI) && !defined(AMREX_MPI_THREAD_MULTIPLE)
+    // the background thread calls the (MPI-collective) I/O library while
+    // the main thread continues to communicate
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        !m_async_flush || amrex::ParallelDescriptor::NProcs() == 1,
+        "openPMD: asynchronous flush with several MPI ranks requires MPI_THREAD_MULTIPLE "
+        "(build AMReX with MPI_THREAD_MULTIPLE)");
+#endif
+#if defined(AMREX_USE_MPI)
+    // the I/O library communicates on its own communicator, so that its collectives
+    // from the background thread do not interleave with those of the simulation
+    if (m_async_flush) {
+        MPI_Comm_dup(amrex::ParallelDescriptor::Communicator(), &m_comm);
+    } else {
+        m_comm = amrex::ParallelDescriptor::Communicator();
+    }
+#endif
 }
 
 WarpXOpenPMDPlot::~WarpXOpenPMDPlot ()
 {
+  WaitAsyncFlush();
   if( m_Series )
   {
     m_Series->flush();
     m_Series.reset( nullptr );
   }
+#if defined(AMREX_USE_MPI)
+  if (m_async_flush) {
+    MPI_Comm_free(&m_comm);
+  }
+#endif
 }
 
 std::string
@@ -424,11 +466,26 @@ WarpXOpenPMDPlot::GetFileName (std::string& filepath)
     return filename;
 }
 
+void
+WarpXOpenPMDPlot::WaitAsyncFlush ()
+{
+    if (m_pending_flush.valid()) {
+        WARPX_PROFILE("WarpXOpenPMDPlot::WaitAsyncFlush()");
+        // rethrows the errors of the background thread, if any
+        m_pending_flush.get();
+    }
+    m_staged_particles.clear();
+    m_staged_bytes = 0;
+}
+
 void WarpXOpenPMDPlot::SetStep (int ts, const std::string& dirPrefix, int file_min_digits,
                                 bool isBTD)
 {
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(ts >= 0 , "openPMD iterations are unsigned");
 
+    // the previous step must be written before the series is accessed again
+    WaitAsyncFlush();
+
     m_dirPrefix = dirPrefix;
     m_file_min_digits = file_min_digits;
 
@@ -453,13 +510,35 @@ void WarpXOpenPMDPlot::CloseStep (bool isBTD, bool isLastBTDFlush)
     bool callClose = true;
     // close BTD file only when isLastBTDFlush is true
     if (isBTD and !isLastBTDFlush) { callClose = false; }
+
+    if (m_async_flush && m_Series) {
+        // with an asynchronous flush, the staged data is written here (and the
+        // iteration closed, if requested)
+        const int step = m_CurrentStep;
+        auto write_step = [this, step, isBTD, callClose] () {
+            if (callClose) {
+                GetIteration(step, isBTD).close();
+            } else {
+                m_Series->flush();
+            }
+        };
+        if (m_async_max_staging_bytes > 0 && m_staged_bytes > m_async_max_staging_bytes) {
+            // too much staged data: write synchronously and release the buffers
+            write_step();
+            WaitAsyncFlush();
+        } else {
+            // only one step is in flight: it is waited for before the next one is staged
+            m_pending_flush = std::async(std::launch::async, write_step);
+        }
+    }
+
     if (callClose) {
-        if (m_Series) {
+        if (m_Series && !m_async_flush) {
             GetIteration(m_CurrentStep, isBTD).close();
         }
 
-        // create a little helper file for ParaView 5.9+
-        if (amrex::ParallelDescriptor::IOProcessor())
+        // create a little helper file for ParaView 5.9+ (not for in-memory streams)
+        if (amrex::ParallelDescriptor::IOProcessor() && m_OpenPMDFileType != "sst")
         {
             // see Init()
             std::string filepath = m_dirPrefix;
@@ -496,7 +575,7 @@ WarpXOpenPMDPlot::Init (openPMD::Access access, bool isBTD)
 #if defined(AMREX_USE_MPI)
         m_Series = std::make_unique<openPMD::Series>(
                 filepath, access,
-                amrex::ParallelDescriptor::Communicator(),
+                m_comm,
                 m_OpenPMDoptions
         );
 #else
@@ -541,9 +620,34 @@ for (unsigned i = 0, n = particle_diags.size(); i < n; ++i) {
         }
     }
 
-    PinnedMemoryParticleContainer tmp = (isBTD || use_pinned_pc) ?
-        pinned_pc->make_alike<amrex::PinnedArenaAllocator>() :
-        pc->make_alike<amrex::PinnedArenaAllocator>();
+    auto make_staging = [&] () {
+        return std::make_unique<PinnedMemoryParticleContainer>((isBTD || use_pinned_pc) ?
+            pinned_pc->make_alike<amrex::PinnedArenaAllocator>() :
+            pc->make_alike<amrex::PinnedArenaAllocator>());
+    };
+    // The pinned copy of the species is either made for this output, or reused from
+    // the previous ones: its tiles are emptied, but keep their (pinned) allocations, so
+    // that the copy only allocates when the number of particles of a tile grows.
+    // The copies from pinned buffers (BTD) clear the tiles, so they are not reused.
+    std::unique_ptr<PinnedMemoryParticleContainer> tmp_owner;
+    PinnedMemoryParticleContainer* tmp_ptr = nullptr;
+    if (m_reuse_particle_staging && !(isBTD || use_pinned_pc)) {
+        auto& staging = m_particle_staging[particle_diags[i].getSpeciesName()];
+        if (!staging || staging->NumRealComps() != pc->NumRealComps() ||
+            staging->NumIntComps() != pc->NumIntComps() ||
+            staging->GetParticles().size() != pc->GetParticles().size()) {
+            staging = make_staging();
+        } else {
+            for (auto& pmap : staging->GetParticles()) {
+                for (auto& kv : pmap) { kv.second.resize(0); }
+            }
+        }
+        tmp_ptr = staging.get();
+    } else {
+        tmp_owner = make_staging();
+        tmp_ptr = tmp_owner.get();
+    }
+    PinnedMemoryParticleContainer& tmp = *tmp_ptr;
 
     const auto mass = pc->AmIA<PhysicalSpecies::photon>() ? PhysConst::m_e : pc->getMass();
     RandomFilter const random_filter(particle_diags[i].m_do_random_filter,
@@ -574,7 +678,8 @@ for (unsigned i = 0, n = particle_diags.size(); i < n; ++i) {
     } else {
         particlesConvertUnits(ConvertDirection::WarpX_to_SI, pc, mass);
         using SrcData = WarpXParticleContainer::ParticleTileType::ConstParticleTileDataType;
-        tmp.copyParticles(*pc,
+        // only the selected particles and the written components are copied to pinned memory
+        copySelectedParticles(tmp, *pc,
             [random_filter,uniform_filter,parser_filter,geometry_filter]
             AMREX_GPU_HOST_DEVICE
             (const SrcData& src, int ip, const amrex::RandomEngine& engine)
@@ -582,7 +687,7 @@ for (unsigned i = 0, n = particle_diags.size(); i < n; ++i) {
                 const SuperParticleType& p = src.getSuperParticle(ip);
                 return random_filter(p, engine) * uniform_filter(p, engine)
                         * parser_filter(p, engine) * geometry_filter(p, engine);
-            }, true);
+            }, particle_diags[i].m_plot_flags);
         particlesConvertUnits(ConvertDirection::SI_to_WarpX, pc, mass);
     }
 
@@ -641,6 +746,16 @@ for (unsigned i = 0, n = particle_diags.size(); i < n; ++i) {
         real_names, int_names,
         pc->getCharge(), pc->getMass(),
         isBTD, isLastBTDFlush);
+
+    // keep the pinned copy alive until the background write of the step is complete
+    // (the persistent copies are only refilled after it, see SetStep)
+    if (m_async_flush) {
+        m_staged_bytes += static_cast<amrex::Long>(tmp.TotalNumberOfParticles(false, true)) *
+            (tmp.NumRealComps() * static_cast<amrex::Long>(sizeof(amrex::ParticleReal)) +
+             tmp.NumIntComps() * static_cast<amrex::Long>(sizeof(int)) +
+             static_cast<amrex::Long>(sizeof(uint64_t)));
+        if (tmp_owner) { m_staged_particles.push_back(std::move(tmp_owner)); }
+    }
     }
 }
 
@@ -717,7 +832,10 @@ WarpXOpenPMDPlot::DumpToFile (ParticleContainer* pc,
     }
 
     // open files from all processors, in case some will not contribute below
-    m_Series->flush();
+    // (with an asynchronous flush, all processors take part in the final flush)
+    if (!m_async_flush) {
+        m_Series->flush();
+    }
 
     // dump individual particles
     bool contributed_particles = false;  // did the local MPI rank contribute particles?
@@ -725,6 +843,22 @@ WarpXOpenPMDPlot::DumpToFile (ParticleContainer* pc,
         auto offset = static_cast<uint64_t>( counter.m_ParticleOffsetAtRank[currentLevel] );
         // For BTD, the offset include the number of particles already flushed
         if (isBTD) { offset += ParticleFlushOffset; }
+
+        // With several non-empty tiles, write them at once: their particles are
+        // contiguous in the openPMD records
+        int num_tiles = 0;
+        for (ParticleIter pti(*pc, currentLevel); pti.isValid(); ++pti) {
+            if (pti.numParticles() > 0) { ++num_tiles; }
+        }
+        if (m_pack_particles && num_tiles > 1) {
+            contributed_particles = true;
+            SavePackedProperties(pc, currentLevel, currSpecies, offset,
+                                 counter.m_ParticleSizeAtRank[currentLevel],
+                                 write_real_comp, real_comp_names,
+                                 write_int_comp, int_comp_names);
+            continue;
+        }
+
         for (ParticleIter pti(*pc, currentLevel); pti.isValid(); ++pti) {
             auto const numParticleOnTile = pti.numParticles();
             auto const numParticleOnTile64 = static_cast<uint64_t>( numParticleOnTile );
@@ -797,7 +931,10 @@ WarpXOpenPMDPlot::DumpToFile (ParticleContainer* pc,
         }
     }
 
-    m_Series->flush();
+    // with an asynchronous flush, the data is written in CloseStep()
+    if (!m_async_flush) {
+        m_Series->flush();
+    }
 }
 
 void
@@ -975,6 +1112,106 @@ WarpXOpenPMDPlot::SaveRealProperty (ParticleIter& pti,
 }
 
 
+void
+WarpXOpenPMDPlot::SavePackedProperties (ParticleContainer const* pc, int lev,
+                       openPMD::ParticleSpecies& currSpecies,
+                       unsigned long long const offset, unsigned long long const np,
+                       amrex::Vector<int> const& write_real_comp,
+                       amrex::Vector<std::string> const& real_comp_names,
+                       amrex::Vector<int> const& write_int_comp,
+                       amrex::Vector<std::string> const& int_comp_names) const
+{
+    auto const np64 = static_cast<uint64_t>(np);
+    auto const nbuf = static_cast<std::size_t>(np);
+
+    auto const getComponentRecord = [&currSpecies](std::string const& comp_name) {
+        // handle scalar and non-scalar records by name
+        const auto [record_name, component_name] = detail::name2openPMD(comp_name);
+        return currSpecies[record_name][component_name];
+    };
+
+    // Copy one component of all the tiles into a contiguous buffer, which is
+    // released by openPMD-api once written
+    auto const pack = [&] (auto const& get_tile_data) {
+        using T = std::remove_cv_t<std::remove_reference_t<decltype(*get_tile_data(std::declval<ParticleIter&>()))>>;
+        std::shared_ptr<T> const buffer(new T[nbuf], [](T const *p) { delete[] p; });
+        std::size_t pos = 0;
+        for (ParticleIter pti(*pc, lev); pti.isValid(); ++pti) {
+            auto const n = static_cast<std::size_t>(pti.numParticles());
+            if (n == 0) { continue; }
+            T const* const src = get_tile_data(pti);
+            std::copy(src, src + n, buffer.get() + pos);
+            pos += n;
+        }
+        return buffer;
+    };
+
+    // here we the save the SoA properties (idcpu)
+    getComponentRecord("id").storeChunk(
+        pack([] (ParticleIter& pti) { return pti.GetStructOfArrays().GetIdCPUData().data(); }),
+        {offset}, {np64});
+
+    // here we the save the SoA properties (real)
+    auto const real_counter = std::min(write_real_comp.size(), real_comp_names.size());
+
+#if defined(WARPX_DIM_RZ)
+    // reconstruct Cartesian positions for RZ simulations
+    // r,z,theta -> x,y,z
+    for (int comp = 0; comp < 2; ++comp) {
+        if (!write_real_comp[comp]) { continue; }
+        std::shared_ptr<amrex::ParticleReal> const xy(
+            new amrex::ParticleReal[nbuf],
+            [](amrex::ParticleReal const *p) { delete[] p; }
+        );
+        std::size_t pos = 0;
+        for (ParticleIter pti(*pc, lev); pti.isValid(); ++pti) {
+            const auto& ptd = pti.GetParticleTile().getConstParticleTileData();
+            auto const n = pti.numParticles();
+            for (int i = 0; i < n; ++i) {
+                const auto& p = ptd.getSuperParticle(i);
+                amrex::ParticleReal xp, yp, zp;
+                get_particle_position(p, xp, yp, zp);
+                xy.get()[pos++] = (comp == 0) ? xp : yp;
+            }
+        }
+        getComponentRecord(real_comp_names[comp]).storeChunk(xy, {offset}, {np64});
+    }
+#endif
+
+    for (auto idx=0; idx<real_counter; idx++) {
+#if defined(WARPX_DIM_RZ)
+        // skip over x,y
+        if (idx < 2) {
+            continue;
+        }
+        // mak names and write flags to SoA real array number
+        int const soa_r_idx = idx - 1 < PIdx::theta ?
+            idx - 1 :  // z and momenta before theta (we added y)
+            idx        // jump over theta (skipped)
+        ;
+#else
+        int const soa_r_idx = idx;
+#endif
+        if (write_real_comp[idx]) {
+            getComponentRecord(real_comp_names[idx]).storeChunk(
+                pack([soa_r_idx] (ParticleIter& pti) {
+                    return pti.GetStructOfArrays().GetRealData(soa_r_idx).data(); }),
+                {offset}, {np64});
+        }
+    }
+
+    // and now SoA int properties
+    auto const int_counter = std::min(write_int_comp.size(), int_comp_names.size());
+    for (auto idx=0; idx<int_counter; idx++) {
+        if (write_int_comp[idx]) {
+            getComponentRecord(int_comp_names[idx]).storeChunk(
+                pack([idx] (ParticleIter& pti) {
+                    return pti.GetStructOfArrays().GetIntData(idx).data(); }),
+                {offset}, {np64});
+        }
+    }
+}
+
 void
 WarpXOpenPMDPlot::SetupPos (
     openPMD::ParticleSpecies& currSpecies,
@@ -1229,7 +1466,9 @@ WarpXOpenPMDPlot::SetupMeshComp (openPMD::Mesh& mesh,
 
     // Prepare the type of dataset that will be written
     openPMD::Datatype const datatype = openPMD::determineDatatype<amrex::Real>();
-    auto const dataset = openPMD::Dataset(datatype, global_size);
+    auto dataset = openPMD::Dataset(datatype, global_size);
+    // compression of the field meshes, if different from the one of the series
+    dataset.options = m_OpenPMDFieldsDatasetOptions;
     mesh.setDataOrder(openPMD::Mesh::DataOrder::C);
     if (var_in_theta_mode) {
         mesh.setGeometry("thetaMode");
@@ -1453,8 +1692,17 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
                     amrex::Gpu::dtoh_memcpy_async(data_pinned.get(), fab.dataPtr(icomp), local_box.numPts()*sizeof(amrex::Real));
                     // intentionally delayed until before we .flush(): amrex::Gpu::streamSynchronize();
                     mesh_comp.storeChunk(data_pinned, chunk_offset, chunk_size);
+                    m_staged_bytes += local_box.numPts()*static_cast<amrex::Long>(sizeof(amrex::Real));
                 } else
 #endif
+                if (m_async_flush) {
+                    // the diagnostic buffers may be overwritten before the background write
+                    amrex::BaseFab<amrex::Real> foo(local_box, 1, amrex::The_Pinned_Arena());
+                    std::shared_ptr<amrex::Real> data_pinned(foo.release());
+                    std::memcpy(data_pinned.get(), fab.dataPtr(icomp), local_box.numPts()*sizeof(amrex::Real));
+                    mesh_comp.storeChunk(data_pinned, chunk_offset, chunk_size);
+                    m_staged_bytes += local_box.numPts()*static_cast<amrex::Long>(sizeof(amrex::Real));
+                } else
                 {
                     amrex::Real const *local_data = fab.dataPtr(icomp);
                     mesh_comp.storeChunkRaw(
@@ -1467,7 +1715,10 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
         amrex::Gpu::streamSynchronize();
 #endif
         // Flush data to disk after looping over all components
-        m_Series->flush();
+        // (with an asynchronous flush, the data is written in CloseStep())
+        if (!m_async_flush) {
+            m_Series->flush();
+        }
     } // levels loop (i)
 }
 #endif // WARPX_USE_OPENPMD
@@ -1478,37 +1729,36 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
 //
 //
 WarpXParticleCounter::WarpXParticleCounter (ParticleContainer* pc):
-    m_MPIRank{amrex::ParallelDescriptor::MyProc()},
-    m_MPISize{amrex::ParallelDescriptor::NProcs()}
+    m_MPIRank{amrex::ParallelDescriptor::MyProc()}
 {
-    m_ParticleCounterByLevel.resize(pc->finestLevel()+1);
-    m_ParticleOffsetAtRank.resize(pc->finestLevel()+1);
-    m_ParticleSizeAtRank.resize(pc->finestLevel()+1);
+    const int nlevs = pc->finestLevel()+1;
+    m_ParticleCounterByLevel.resize(nlevs);
+    m_ParticleOffsetAtRank.resize(nlevs);
+    m_ParticleSizeAtRank.resize(nlevs);
 
-    for (auto currentLevel = 0; currentLevel <= pc->finestLevel(); currentLevel++)
+    for (auto currentLevel = 0; currentLevel < nlevs; currentLevel++)
     {
-        long numParticles = 0; // numParticles in this processor
+        unsigned long long numParticles = 0; // numParticles in this processor
 
         for (ParticleIter pti(*pc, currentLevel); pti.isValid(); ++pti) {
             auto numParticleOnTile = pti.numParticles();
             numParticles += numParticleOnTile;
         }
 
-        unsigned long long offset=0; // offset of this level
-        unsigned long long sum=0; // numParticles in this level (sum from all processors)
-
-        GetParticleOffsetOfProcessor(numParticles, offset,  sum);
-
-        m_ParticleCounterByLevel[currentLevel] = sum;
-        m_ParticleOffsetAtRank[currentLevel] = offset;
         m_ParticleSizeAtRank[currentLevel] = numParticles;
+    }
+
+    // offsets of this rank and numbers of particles of all levels, at once
+    GetParticleOffsetOfProcessor(m_ParticleSizeAtRank, m_ParticleOffsetAtRank, m_ParticleCounterByLevel);
 
+    for (auto currentLevel = 0; currentLevel < nlevs; currentLevel++)
+    {
         // adjust offset, it should be numbered after particles from previous levels
         for (auto lv=0; lv<currentLevel; lv++) {
             m_ParticleOffsetAtRank[currentLevel] += m_ParticleCounterByLevel[lv];
         }
 
-        m_Total += sum;
+        m_Total += m_ParticleCounterByLevel[currentLevel];
     }
 }
 
@@ -1517,33 +1767,30 @@ WarpXParticleCounter::WarpXParticleCounter (ParticleContainer* pc):
 //
 // note: this is a MPI-collective operation
 //
-// input: num of particles  of from each   processor
+// input: num of particles  of from each   processor, for each level
 //
 // output:
-//     offset within <all> the particles in the comm
-//     sum of all particles in the comm
+//     offset within <all> the particles in the comm, for each level
+//     sum of all particles in the comm, for each level
 //
 void
 WarpXParticleCounter::GetParticleOffsetOfProcessor (
-    const long& numParticles,
-    unsigned long long& offset,
-    unsigned long long& sum
+    const std::vector<unsigned long long>& numParticles,
+    std::vector<unsigned long long>& offset,
+    std::vector<unsigned long long>& sum
 ) const
 {
-    offset = 0;
-#if defined(AMREX_USE_MPI)
-    std::vector<long> result(m_MPISize, 0);
-    amrex::ParallelGather::Gather (numParticles, result.data(), -1, amrex::ParallelDescriptor::Communicator());
-
-    sum = 0;
-    auto const num_results = static_cast<int>(result.size());
-    for (int i=0; i<num_results; i++) {
-        sum += result[i];
-        if (i<m_MPIRank) {
-            offset += result[i];
-        }
-    }
-#else
+    auto const nlevs = static_cast<int>(numParticles.size());
+    offset.assign(nlevs, 0);
     sum = numParticles;
+#if defined(AMREX_USE_MPI)
+    if (nlevs == 0) { return; }
+    MPI_Comm const comm = amrex::ParallelDescriptor::Communicator();
+    // exclusive prefix sum over the ranks (undefined on the first rank)
+    MPI_Exscan(numParticles.data(), offset.data(), nlevs,
+               MPI_UNSIGNED_LONG_LONG, MPI_SUM, comm);
+    if (m_MPIRank == 0) { offset.assign(nlevs, 0); }
+    MPI_Allreduce(numParticles.data(), sum.data(), nlevs,
+                  MPI_UNSIGNED_LONG_LONG, MPI_SUM, comm);
 #endif
 }
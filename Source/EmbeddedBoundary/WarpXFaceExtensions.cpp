@@ -119,6 +119,35 @@ SetNeigh(const amrex::Array4<T>& arr, const T val,
 }
 
 
+/**
+* \brief Color (from 0 to 8) of the face i, j, k with normal 'dim', used to process
+*        the face extensions without data races.
+*
+*        The colors tile the plane with normal 'dim' in 3x3 blocks: two extended faces with
+*        the same color are at least 3 faces apart, so their 3x3 neighborhoods of intruded
+*        faces do not overlap and they can be extended concurrently.
+*
+* \param[in] i, j, k the indices of the face
+* \param[in] dim normal direction to the plane in consideration (0 for x, 1 for y, 2 for z)
+*/
+AMREX_GPU_DEVICE AMREX_FORCE_INLINE
+int
+GetFaceColor(const int i, const int j, const int k, const int dim){
+    int a = i;
+    int b = j;
+    if(dim == 0){
+        a = j;
+        b = k;
+    }
+#if defined(WARPX_DIM_3D)
+    else if(dim == 1){
+        b = k;
+    }
+#endif
+    return ((a % 3) + 3) % 3 + 3 * (((b % 3) + 3) % 3);
+}
+
+
 /**
 * \brief Compute the minimal area for stability for the face i, j, k with normal 'dim'.
 *
@@ -269,6 +298,12 @@ WarpX::ComputeFaceExtensions(){
                             ablastr::warn_manager::WarnPriority::low
         );
     }
+
+    // The extension flags are not used by the field solver
+    for (int idim = 0; idim < 3; ++idim) {
+        imultifab_map.erase(m_flag_ext_face[maxLevel()][idim]->tags()[0]);
+        m_flag_ext_face[maxLevel()][idim].reset();
+    }
 #endif
 }
 
@@ -464,78 +499,92 @@ WarpX::ComputeOneWayExtensions() {
             const auto &ly = m_edge_lengths[maxLevel()][1]->array(mfi);
             const auto &lz = m_edge_lengths[maxLevel()][2]->array(mfi);
 
-            vecs_size = amrex::Scan::PrefixSum<int>(ncells,
-                                                    [=] AMREX_GPU_DEVICE (int icell) {
-                const amrex::Dim3 cell = box.atOffset(icell).dim3();
-                const int i = cell.x;
-                const int j = cell.y;
-                const int k = cell.z;
-                // If the face doesn't need to be extended break the loop
-                if (!flag_ext_face(i, j, k)) {
-                    return 0;
-                }
+            // The faces are processed one color at a time, so that two faces extended
+            // concurrently never modify the same intruded face
+            vecs_size = 0;
+            for (int color = 0; color < 9; ++color) {
+                const int offset = vecs_size;
+                vecs_size += amrex::Scan::PrefixSum<int>(ncells,
+                                                        [=] AMREX_GPU_DEVICE (int icell) {
+                    const amrex::Dim3 cell = box.atOffset(icell).dim3();
+                    const int i = cell.x;
+                    const int j = cell.y;
+                    const int k = cell.z;
+                    // If the face doesn't need to be extended break the loop
+                    if (GetFaceColor(i, j, k, idim) != color || !flag_ext_face(i, j, k)) {
+                        return 0;
+                    }
 
-                const amrex::Real S_stab = ComputeSStab(i, j, k, lx, ly, lz, dx, dy, dz, idim);
+                    const amrex::Real S_stab = ComputeSStab(i, j, k, lx, ly, lz, dx, dy, dz, idim);
 
-                const amrex::Real S_ext = S_stab - S(i, j, k);
-                const int n_borrow =
-                    ComputeNBorrowOneFaceExtension(cell, S_ext, S_mod, flag_info_face,
-                                                   flag_ext_face, idim);
+                    const amrex::Real S_ext = S_stab - S(i, j, k);
+                    const int n_borrow =
+                        ComputeNBorrowOneFaceExtension(cell, S_ext, S_mod, flag_info_face,
+                                                       flag_ext_face, idim);
 
 
-              borrowing_size(i, j, k) = n_borrow;
-                return n_borrow;
-            },
-                                                [=] AMREX_GPU_DEVICE (int icell, int ps){
-                const amrex::Dim3 cell = box.atOffset(icell).dim3();
-                const int i = cell.x;
-                const int j = cell.y;
-                const int k = cell.z;
-                const int nborrow = borrowing_size(i, j, k);
-                if (nborrow == 0) {
-                    borrowing_inds_pointer(i, j, k) = nullptr;
-                } else{
-                    borrowing_inds_pointer(i, j, k) = borrowing_inds + ps;
+                  borrowing_size(i, j, k) = n_borrow;
+                    return n_borrow;
+                },
+                                                    [=] AMREX_GPU_DEVICE (int icell, int ps){
 
-                    const amrex::Real S_stab = ComputeSStab(i, j, k, lx, ly, lz, dx, dy, dz, idim);
+                    ps += offset;
 
-                    const amrex::Real S_ext = S_stab - S(i, j, k);
-                    for (int i_n = -1; i_n < 2; i_n++) {
-                        for (int j_n = -1; j_n < 2; j_n++) {
-                            //This if makes sure that we don't visit the "diagonal neighbours"
-                            if( !(i_n == j_n || i_n == -j_n)){
-                                // Here a face is available if it doesn't need to be extended itself and if its
-                                // area exceeds Sz_ext. Here we need to take into account if the intruded face
-                                // has given away already some area, so we use Sz_red rather than Sz.
-                                // If no face is available we don't do anything and we will need to use the
-                                // multi-face extensions.
-                                if (GetNeigh(S_mod, i, j, k, i_n, j_n, idim) > S_ext
-                                    && (GetNeigh(flag_info_face, i, j, k, i_n, j_n, idim) == 1
-                                         || GetNeigh(flag_info_face, i, j, k, i_n, j_n, idim) == 2)
-                                    && flag_ext_face(i, j, k)) {
-
-                                    SetNeigh(S_mod,
-                                             GetNeigh(S_mod, i, j, k, i_n, j_n, idim) - S_ext,
-                                             i, j, k, i_n, j_n, idim);
-
-                                    // Insert the index of the face info
-                                    borrowing_inds[ps] = ps;
-                                    // Store the information about the intruded face in the dataset of the
-                                    // faces which are borrowing area
-                                    FaceInfoBox::addConnectedNeighbor(i_n, j_n, ps,
-                                                                      borrowing_neigh_faces);
-                                    borrowing_area[ps] = S_ext;
-
-                                    SetNeigh(flag_info_face, 2, i, j, k, i_n, j_n, idim);
-                                    // Add the area to the intruding face.
-                                    S_mod(i, j, k) = S(i, j, k) + S_ext;
-                                    flag_ext_face(i, j, k) = false;
+                    const amrex::Dim3 cell = box.atOffset(icell).dim3();
+                    const int i = cell.x;
+                    const int j = cell.y;
+                    const int k = cell.z;
+
+                    if (GetFaceColor(i, j, k, idim) != color) {
+                        return;
+                    }
+
+                    const int nborrow = borrowing_size(i, j, k);
+                    if (nborrow == 0) {
+                        borrowing_inds_pointer(i, j, k) = nullptr;
+                    } else{
+                        borrowing_inds_pointer(i, j, k) = borrowing_inds + ps;
+
+                        const amrex::Real S_stab = ComputeSStab(i, j, k, lx, ly, lz, dx, dy, dz, idim);
+
+                        const amrex::Real S_ext = S_stab - S(i, j, k);
+                        for (int i_n = -1; i_n < 2; i_n++) {
+                            for (int j_n = -1; j_n < 2; j_n++) {
+                                //This if makes sure that we don't visit the "diagonal neighbours"
+                                if( !(i_n == j_n || i_n == -j_n)){
+                                    // Here a face is available if it doesn't need to be extended itself and if its
+                                    // area exceeds Sz_ext. Here we need to take into account if the intruded face
+                                    // has given away already some area, so we use Sz_red rather than Sz.
+                                    // If no face is available we don't do anything and we will need to use the
+                                    // multi-face extensions.
+                                    if (GetNeigh(S_mod, i, j, k, i_n, j_n, idim) > S_ext
+                                        && (GetNeigh(flag_info_face, i, j, k, i_n, j_n, idim) == 1
+                                             || GetNeigh(flag_info_face, i, j, k, i_n, j_n, idim) == 2)
+                                        && flag_ext_face(i, j, k)) {
+
+                                        SetNeigh(S_mod,
+                                                 GetNeigh(S_mod, i, j, k, i_n, j_n, idim) - S_ext,
+                                                 i, j, k, i_n, j_n, idim);
+
+                                        // Insert the index of the face info
+                                        borrowing_inds[ps] = ps;
+                                        // Store the information about the intruded face in the dataset of the
+                                        // faces which are borrowing area
+                                        FaceInfoBox::addConnectedNeighbor(i_n, j_n, ps,
+                                                                          borrowing_neigh_faces);
+                                        borrowing_area[ps] = S_ext;
+
+                                        SetNeigh(flag_info_face, 2, i, j, k, i_n, j_n, idim);
+                                        // Add the area to the intruding face.
+                                        S_mod(i, j, k) = S(i, j, k) + S_ext;
+                                        flag_ext_face(i, j, k) = false;
+                                    }
                                 }
                             }
                         }
                     }
-                }
-            }, amrex::Scan::Type::exclusive);
+                }, amrex::Scan::Type::exclusive);
+            }
         }
     }
 
@@ -585,117 +634,120 @@ WarpX::ComputeEightWaysExtensions() {
             const auto &ly = m_edge_lengths[maxLevel()][1]->array(mfi);
             const auto &lz = m_edge_lengths[maxLevel()][2]->array(mfi);
 
-            vecs_size += amrex::Scan::PrefixSum<int>(ncells,
-                                                     [=] AMREX_GPU_DEVICE (int icell){
-                const amrex::Dim3 cell = box.atOffset(icell).dim3();
-                const int i = cell.x;
-                const int j = cell.y;
-                const int k = cell.z;
-                // If the face doesn't need to be extended break the loop
-                if (!flag_ext_face(i, j, k)) {
-                    return 0;
-                }
-                const amrex::Real S_stab = ComputeSStab(i, j, k, lx, ly, lz, dx, dy, dz, idim);
-
-                const amrex::Real S_ext = S_stab - S(i, j, k);
-                const int n_borrow = ComputeNBorrowEightFacesExtension(cell, S_ext, S_mod, S,
-                                                                       flag_info_face, idim);
-
-              borrowing_size(i, j, k) = n_borrow;
-                return n_borrow;
-            },
-            [=] AMREX_GPU_DEVICE (int icell, int ps) {
-
-                ps += vecs_size;
+            for (int color = 0; color < 9; ++color) {
+                const int offset = vecs_size;
+                vecs_size += amrex::Scan::PrefixSum<int>(ncells,
+                                                         [=] AMREX_GPU_DEVICE (int icell){
+                    const amrex::Dim3 cell = box.atOffset(icell).dim3();
+                    const int i = cell.x;
+                    const int j = cell.y;
+                    const int k = cell.z;
+                    // If the face doesn't need to be extended break the loop
+                    if (GetFaceColor(i, j, k, idim) != color || !flag_ext_face(i, j, k)) {
+                        return 0;
+                    }
+                    const amrex::Real S_stab = ComputeSStab(i, j, k, lx, ly, lz, dx, dy, dz, idim);
 
-                const amrex::Dim3 cell = box.atOffset(icell).dim3();
-                const int i = cell.x;
-                const int j = cell.y;
-                const int k = cell.z;
+                    const amrex::Real S_ext = S_stab - S(i, j, k);
+                    const int n_borrow = ComputeNBorrowEightFacesExtension(cell, S_ext, S_mod, S,
+                                                                           flag_info_face, idim);
 
-                if (!flag_ext_face(i, j, k)) {
-                    return;
-                }
+                  borrowing_size(i, j, k) = n_borrow;
+                    return n_borrow;
+                },
+                [=] AMREX_GPU_DEVICE (int icell, int ps) {
 
-                const int nborrow = borrowing_size(i, j, k);
-                if (nborrow == 0) {
-                    borrowing_inds_pointer(i, j, k) = nullptr;
-                } else {
-                    borrowing_inds_pointer(i, j, k) = borrowing_inds + ps;
+                    ps += offset;
 
-                    S_mod(i, j, k) = S(i, j, k);
-                    const amrex::Real S_stab = ComputeSStab(i, j, k, lx, ly, lz, dx, dy, dz, idim);
+                    const amrex::Dim3 cell = box.atOffset(icell).dim3();
+                    const int i = cell.x;
+                    const int j = cell.y;
+                    const int k = cell.z;
 
-                    const amrex::Real S_ext = S_stab - S(i, j, k);
-                    amrex::Array2D<amrex::Real, 0, 2, 0, 2> local_avail{};
-                    for(int i_loc = 0; i_loc <= 2; i_loc++){
-                        for(int j_loc = 0; j_loc <= 2; j_loc++){
-                            auto const flag = GetNeigh(flag_info_face, i, j, k, i_loc - 1, j_loc - 1, idim);
-                            local_avail(i_loc, j_loc) = flag == 1 || flag == 2;
-                        }
+                    if (GetFaceColor(i, j, k, idim) != color || !flag_ext_face(i, j, k)) {
+                        return;
                     }
 
-                    amrex::Real denom = local_avail(0, 1) * GetNeigh(S, i, j, k, -1, 0, idim) +
-                                        local_avail(2, 1) * GetNeigh(S, i, j, k, 1, 0, idim) +
-                                        local_avail(1, 0) * GetNeigh(S, i, j, k, 0, -1, idim) +
-                                        local_avail(1, 2) * GetNeigh(S, i, j, k, 0, 1, idim) +
-                                        local_avail(0, 0) * GetNeigh(S, i, j, k, -1, -1, idim) +
-                                        local_avail(2, 0) * GetNeigh(S, i, j, k, 1, -1, idim) +
-                                        local_avail(0, 2) * GetNeigh(S, i, j, k, -1, 1, idim) +
-                                        local_avail(2, 2) * GetNeigh(S, i, j, k, 1, 1, idim);
+                    const int nborrow = borrowing_size(i, j, k);
+                    if (nborrow == 0) {
+                        borrowing_inds_pointer(i, j, k) = nullptr;
+                    } else {
+                        borrowing_inds_pointer(i, j, k) = borrowing_inds + ps;
 
-                    bool neg_face = true;
+                        S_mod(i, j, k) = S(i, j, k);
+                        const amrex::Real S_stab = ComputeSStab(i, j, k, lx, ly, lz, dx, dy, dz, idim);
+
+                        const amrex::Real S_ext = S_stab - S(i, j, k);
+                        amrex::Array2D<amrex::Real, 0, 2, 0, 2> local_avail{};
+                        for(int i_loc = 0; i_loc <= 2; i_loc++){
+                            for(int j_loc = 0; j_loc <= 2; j_loc++){
+                                auto const flag = GetNeigh(flag_info_face, i, j, k, i_loc - 1, j_loc - 1, idim);
+                                local_avail(i_loc, j_loc) = flag == 1 || flag == 2;
+                            }
+                        }
 
-                    while(denom >= S_ext && neg_face && denom > 0){
-                        neg_face = false;
-                        for (int i_n = -1; i_n < 2; i_n++) {
-                            for (int j_n = -1; j_n < 2; j_n++) {
-                                if(local_avail(i_n + 1, j_n + 1)){
-                                    const amrex::Real patch = S_ext * GetNeigh(S, i, j, k, i_n, j_n, idim) / denom;
-                                    if(GetNeigh(S_mod, i, j, k, i_n, j_n, idim) - patch <= 0) {
-                                        neg_face = true;
-                                        local_avail(i_n + 1, j_n + 1) = false;
+                        amrex::Real denom = local_avail(0, 1) * GetNeigh(S, i, j, k, -1, 0, idim) +
+                                            local_avail(2, 1) * GetNeigh(S, i, j, k, 1, 0, idim) +
+                                            local_avail(1, 0) * GetNeigh(S, i, j, k, 0, -1, idim) +
+                                            local_avail(1, 2) * GetNeigh(S, i, j, k, 0, 1, idim) +
+                                            local_avail(0, 0) * GetNeigh(S, i, j, k, -1, -1, idim) +
+                                            local_avail(2, 0) * GetNeigh(S, i, j, k, 1, -1, idim) +
+                                            local_avail(0, 2) * GetNeigh(S, i, j, k, -1, 1, idim) +
+                                            local_avail(2, 2) * GetNeigh(S, i, j, k, 1, 1, idim);
+
+                        bool neg_face = true;
+
+                        while(denom >= S_ext && neg_face && denom > 0){
+                            neg_face = false;
+                            for (int i_n = -1; i_n < 2; i_n++) {
+                                for (int j_n = -1; j_n < 2; j_n++) {
+                                    if(local_avail(i_n + 1, j_n + 1)){
+                                        const amrex::Real patch = S_ext * GetNeigh(S, i, j, k, i_n, j_n, idim) / denom;
+                                        if(GetNeigh(S_mod, i, j, k, i_n, j_n, idim) - patch <= 0) {
+                                            neg_face = true;
+                                            local_avail(i_n + 1, j_n + 1) = false;
+                                        }
                                     }
                                 }
                             }
-                        }
 
-                        denom = local_avail(0, 1) * GetNeigh(S, i, j, k, -1, 0, idim) +
-                                local_avail(2, 1) * GetNeigh(S, i, j, k, 1, 0, idim) +
-                                local_avail(1, 0) * GetNeigh(S, i, j, k, 0, -1, idim) +
-                                local_avail(1, 2) * GetNeigh(S, i, j, k, 0, 1, idim) +
-                                local_avail(0, 0) * GetNeigh(S, i, j, k, -1, -1, idim) +
-                                local_avail(2, 0) * GetNeigh(S, i, j, k, 1, -1, idim) +
-                                local_avail(0, 2) * GetNeigh(S, i, j, k, -1, 1, idim) +
-                                local_avail(2, 2) * GetNeigh(S, i, j, k, 1, 1, idim);
-                    }
+                            denom = local_avail(0, 1) * GetNeigh(S, i, j, k, -1, 0, idim) +
+                                    local_avail(2, 1) * GetNeigh(S, i, j, k, 1, 0, idim) +
+                                    local_avail(1, 0) * GetNeigh(S, i, j, k, 0, -1, idim) +
+                                    local_avail(1, 2) * GetNeigh(S, i, j, k, 0, 1, idim) +
+                                    local_avail(0, 0) * GetNeigh(S, i, j, k, -1, -1, idim) +
+                                    local_avail(2, 0) * GetNeigh(S, i, j, k, 1, -1, idim) +
+                                    local_avail(0, 2) * GetNeigh(S, i, j, k, -1, 1, idim) +
+                                    local_avail(2, 2) * GetNeigh(S, i, j, k, 1, 1, idim);
+                        }
 
-                    if(denom >= S_ext){
-                        S_mod(i, j, k) = S(i, j, k);
-                        int count = 0;
-                        for (int i_n = -1; i_n < 2; i_n++) {
-                            for (int j_n = -1; j_n < 2; j_n++) {
-                                if(local_avail(i_n + 1, j_n + 1)){
-                                    const amrex::Real patch = S_ext * GetNeigh(S, i, j, k, i_n, j_n, idim) / denom;
-                                    borrowing_inds[ps + count] = ps + count;
-                                    FaceInfoBox::addConnectedNeighbor(i_n, j_n, ps + count,
-                                                                      borrowing_neigh_faces);
-                                    borrowing_area[ps + count] = patch;
-
-                                    SetNeigh(flag_info_face, 2, i, j, k, i_n, j_n, idim);
-
-                                    S_mod(i, j, k) += patch;
-                                    SetNeigh(S_mod,
-                                             GetNeigh(S_mod, i, j, k, i_n, j_n, idim) - patch,
-                                             i, j, k, i_n, j_n, idim);
-                                    count +=1;
+                        if(denom >= S_ext){
+                            S_mod(i, j, k) = S(i, j, k);
+                            int count = 0;
+                            for (int i_n = -1; i_n < 2; i_n++) {
+                                for (int j_n = -1; j_n < 2; j_n++) {
+                                    if(local_avail(i_n + 1, j_n + 1)){
+                                        const amrex::Real patch = S_ext * GetNeigh(S, i, j, k, i_n, j_n, idim) / denom;
+                                        borrowing_inds[ps + count] = ps + count;
+                                        FaceInfoBox::addConnectedNeighbor(i_n, j_n, ps + count,
+                                                                          borrowing_neigh_faces);
+                                        borrowing_area[ps + count] = patch;
+
+                                        SetNeigh(flag_info_face, 2, i, j, k, i_n, j_n, idim);
+
+                                        S_mod(i, j, k) += patch;
+                                        SetNeigh(S_mod,
+                                                 GetNeigh(S_mod, i, j, k, i_n, j_n, idim) - patch,
+                                                 i, j, k, i_n, j_n, idim);
+                                        count +=1;
+                                    }
                                 }
                             }
+                            flag_ext_face(i, j, k) = false;
                         }
-                        flag_ext_face(i, j, k) = false;
                     }
-                }
-            }, amrex::Scan::Type::exclusive);
+                }, amrex::Scan::Type::exclusive);
+            }
         }
     }
 #endif
@@ -37,6 +37,7 @@
 #  include <AMReX_SPACE.H>
 #  include <AMReX_Vector.H>
 
+#  include <array>
 #  include <cstdlib>
 #  include <string>
 
@@ -313,6 +314,17 @@ WarpX::MarkCells(){
 #ifndef WARPX_DIM_RZ
     auto const &cell_size = CellSize(maxLevel());
 
+    // m_flag_ext_face is only needed while the face extensions are computed:
+    // it is allocated here and released at the end of ComputeFaceExtensions
+    const std::array<std::string, 3> flag_ext_face_names =
+        {"m_flag_ext_face[x]", "m_flag_ext_face[y]", "m_flag_ext_face[z]"};
+    for (int idim = 0; idim < 3; ++idim) {
+        amrex::iMultiFab const& flag_info_face = *m_flag_info_face[maxLevel()][idim];
+        AllocInitMultiFab(m_flag_ext_face[maxLevel()][idim], flag_info_face.boxArray(),
+                          flag_info_face.DistributionMap(), flag_info_face.nComp(),
+                          flag_info_face.nGrowVect(), maxLevel(), flag_ext_face_names[idim]);
+    }
+
 #ifdef WARPX_DIM_3D
     for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
 #elif defined(WARPX_DIM_XZ)
@@ -28,6 +28,7 @@
 #include "Fluids/WarpXFluidContainer.H"
 #include "Particles/ParticleBoundaryBuffer.H"
 #include "Python/callbacks.H"
+#include "Utils/PhaseTimer.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXUtil.H"
@@ -51,6 +52,8 @@
 #include <AMReX_Vector.H>
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <array>
 #include <memory>
 #include <ostream>
@@ -86,13 +89,27 @@ WarpX::Evolve (int numsteps)
 
         multi_diags->NewIteration();
 
+        // Last step of this call, at the end of which the particles are synchronized
+        // (assuming that the time step does not change)
+        synchronization_step = numsteps_max - 1;
+        if (stop_time < std::numeric_limits<Real>::max()) {
+            const double steps_to_stop = std::ceil(
+                static_cast<double>(stop_time - 1.e-3_rt*dt[0] - cur_time)/static_cast<double>(dt[0])) - 1.;
+            if (steps_to_stop < static_cast<double>(numsteps_max - 1 - step)) {
+                synchronization_step = step + std::max(0, static_cast<int>(steps_to_stop));
+            }
+        }
+
         // Start loop on time steps
         if (verbose) {
             amrex::Print() << "STEP " << step+1 << " starts ...\n";
         }
         ExecutePythonCallback("beforestep");
 
-        CheckLoadBalance(step);
+        {
+            PhaseTimer::Scope const phase_timer(PhaseTimer::LoadBalance);
+            CheckLoadBalance(step);
+        }
 
         if (evolve_scheme == EvolveScheme::Explicit)
         {
@@ -109,15 +126,24 @@ WarpX::Evolve (int numsteps)
 
         // Run multi-physics modules:
         // ionization, Coulomb collisions, QED
-        doFieldIonization();
+        {
+            PhaseTimer::Scope const phase_timer(PhaseTimer::Ionization);
+            doFieldIonization();
+        }
 
         ExecutePythonCallback("beforecollisions");
-        mypc->doCollisions( cur_time, dt[0] );
+        {
+            PhaseTimer::Scope const phase_timer(PhaseTimer::Collisions);
+            mypc->doCollisions( cur_time, dt[0], step );
+        }
         ExecutePythonCallback("aftercollisions");
 
 #ifdef WARPX_QED
-        doQEDEvents();
-        mypc->doQEDSchwinger();
+        {
+            PhaseTimer::Scope const phase_timer(PhaseTimer::QED);
+            doQEDEvents();
+            mypc->doQEDSchwinger();
+        }
 #endif
 
         // Main PIC operation:
@@ -125,6 +151,9 @@ WarpX::Evolve (int numsteps)
 
         ExecutePythonCallback("particleinjection");
 
+        // With warpx.localized_cleaning_distance, select the boxes where F and G are evolved
+        UpdateCleaningActiveBoxes();
+
         if (m_implicit_solver) {
             m_implicit_solver->OneStep(cur_time, dt[0], step);
         }
@@ -208,28 +237,31 @@ WarpX::Evolve (int numsteps)
         for (int i = 0; i <= max_level; ++i) {
             t_new[i] = cur_time;
         }
-        multi_diags->FilterComputePackFlush( step, false, true );
+        {
+            PhaseTimer::Scope const phase_timer(PhaseTimer::Diagnostics);
+            multi_diags->FilterComputePackFlush( step, false, true );
+        }
 
         const bool move_j = is_synchronized;
         // If is_synchronized we need to shift j too so that next step we can evolve E by dt/2.
         // We might need to move j because we are going to make a plotfile.
-        const int num_moved = MoveWindow(step+1, move_j);
-
-        // Update the accelerator lattice element finder if the window has moved,
-        // from either a moving window or a boosted frame
-        if (num_moved != 0 || gamma_boost > 1) {
-            for (int lev = 0; lev <= finest_level; ++lev) {
-                m_accelerator_lattice[lev]->UpdateElementFinder(lev);
-            }
+        int num_moved = 0;
+        {
+            PhaseTimer::Scope const phase_timer(PhaseTimer::MovingWindow);
+            num_moved = MoveWindow(step+1, move_j);
         }
 
-        HandleParticlesAtBoundaries(step, cur_time, num_moved);
+        {
+            PhaseTimer::Scope const phase_timer(PhaseTimer::ParticleBoundaries);
+            HandleParticlesAtBoundaries(step, cur_time, num_moved);
+        }
 
         // Field solve step for electrostatic or hybrid-PIC solvers
         if( electrostatic_solver_id != ElectrostaticSolverAlgo::None ||
             electromagnetic_solver_id == ElectromagneticSolverAlgo::HybridPIC )
         {
             ExecutePythonCallback("beforeEsolve");
+            PhaseTimer::Start(PhaseTimer::FieldSolve);
 
             if (electrostatic_solver_id != ElectrostaticSolverAlgo::None) {
                 // Electrostatic solver:
@@ -254,6 +286,7 @@ WarpX::Evolve (int numsteps)
                 // and Ampere's law).
                 HybridPICEvolveFields();
             }
+            PhaseTimer::Stop();
             ExecutePythonCallback("afterEsolve");
         }
 
@@ -262,13 +295,16 @@ WarpX::Evolve (int numsteps)
         ExecutePythonCallback("afterstep");
 
         /// reduced diags
-        if (reduced_diags->m_plot_rd != 0)
         {
-            reduced_diags->LoadBalance();
-            reduced_diags->ComputeDiags(step);
-            reduced_diags->WriteToFile(step);
+            PhaseTimer::Scope const phase_timer(PhaseTimer::Diagnostics);
+            if (reduced_diags->m_plot_rd != 0)
+            {
+                reduced_diags->LoadBalance();
+                reduced_diags->ComputeDiags(step);
+                reduced_diags->WriteToFile(step);
+            }
+            multi_diags->FilterComputePackFlush( step );
         }
-        multi_diags->FilterComputePackFlush( step );
 
         // execute afterdiagnostic callbacks
         ExecutePythonCallback("afterdiagnostics");
@@ -279,6 +315,11 @@ WarpX::Evolve (int numsteps)
             early_params_checked = true;
         }
 
+        // print the warning list of the first step once it has been gathered in the background
+        if (const auto warnings = ablastr::warn_manager::GetWMInstance().TestGlobalWarnings()) {
+            amrex::Print() << *warnings;
+        }
+
         // create ending time stamp for calculating elapsed time each iteration
         const auto evolve_time_end_step = static_cast<Real>(amrex::second());
         evolve_time += evolve_time_end_step - evolve_time_beg_step;
@@ -298,6 +339,10 @@ WarpX::Evolve (int numsteps)
         }
     } // End loop on time steps
 
+    // write the reduced diags kept in memory, so that the files are complete
+    // when Evolve returns (e.g. to a Python script)
+    if (reduced_diags->m_plot_rd != 0) { reduced_diags->Flush(); }
+
     // This if statement is needed for PICMI, which allows the Evolve routine to be
     // called multiple times, otherwise diagnostics will be done at every call,
     // regardless of the diagnostic period parameter provided in the inputs.
@@ -307,6 +352,9 @@ WarpX::Evolve (int numsteps)
         if (m_exit_loop_due_to_interrupt_signal) { ExecutePythonCallback("onbreaksignal"); }
     }
 
+    // complete the gather of the warning list of the first step, if it is still in progress
+    amrex::Print() <<
+        ablastr::warn_manager::GetWMInstance().FlushGlobalWarnings();
     amrex::Print() <<
         ablastr::warn_manager::GetWMInstance().PrintGlobalWarnings("THE END");
 }
@@ -362,8 +410,10 @@ WarpX::OneStep_nosub (Real cur_time)
         }
 
         if (use_hybrid_QED) {
-            FillBoundaryE(guard_cells.ng_alloc_EB);
-            FillBoundaryB(guard_cells.ng_alloc_EB, WarpX::sync_nodal_points);
+            // The QED correction only reads one guard cell of E, whose guard cells are
+            // filled again afterwards; B is not modified by the correction
+            FillBoundaryE(amrex::IntVect(1));
+            FillBoundaryB(guard_cells.ng_afterPushPSATD, WarpX::sync_nodal_points);
             WarpX::Hybrid_QED_Push(dt);
             FillBoundaryE(guard_cells.ng_afterPushPSATD, WarpX::sync_nodal_points);
         }
@@ -377,6 +427,14 @@ WarpX::OneStep_nosub (Real cur_time)
                 FillBoundaryG(guard_cells.ng_alloc_G, WarpX::sync_nodal_points);
             }
         }
+    } else if (WarpX::do_fdtd_temporal_blocking) {
+        // Advance B by dt/2, E by dt and B by dt/2 in one sweep over each box,
+        // without guard cell exchanges in between
+        EvolveBEBBlocked(dt[0]); // We now have E^{n+1} and B^{n+1}
+
+        if (safe_guard_cells) {
+            FillBoundaryB(guard_cells.ng_alloc_EB);
+        }
     } else {
         EvolveF(0.5_rt * dt[0], DtType::FirstHalf);
         EvolveG(0.5_rt * dt[0], DtType::FirstHalf);
@@ -384,12 +442,21 @@ WarpX::OneStep_nosub (Real cur_time)
         FillBoundaryG(guard_cells.ng_FieldSolverG);
 
         EvolveB(0.5_rt * dt[0], DtType::FirstHalf); // We now have B^{n+1/2}
-        FillBoundaryB(guard_cells.ng_FieldSolver, WarpX::sync_nodal_points);
 
-        if (WarpX::em_solver_medium == MediumForEM::Vacuum) {
+        if (WarpX::do_overlap_fill_boundary && !WarpX::do_single_precision_comms &&
+            WarpX::em_solver_medium == MediumForEM::Vacuum) {
+            // Update E in the interior of each box while the B guard cells
+            // are exchanged, then update the remaining shell
+            FillBoundaryB_nowait(guard_cells.ng_FieldSolver, WarpX::sync_nodal_points);
+            EvolveE(dt[0], FieldUpdateRegion::interior);
+            FillBoundaryB_finish(WarpX::sync_nodal_points);
+            EvolveE(dt[0], FieldUpdateRegion::shell); // We now have E^{n+1}
+        } else if (WarpX::em_solver_medium == MediumForEM::Vacuum) {
+            FillBoundaryB(guard_cells.ng_FieldSolver, WarpX::sync_nodal_points);
             // vacuum medium
             EvolveE(dt[0]); // We now have E^{n+1}
         } else if (WarpX::em_solver_medium == MediumForEM::Macroscopic) {
+            FillBoundaryB(guard_cells.ng_FieldSolver, WarpX::sync_nodal_points);
             // macroscopic medium
             MacroscopicEvolveE(dt[0]); // We now have E^{n+1}
         } else {
@@ -431,8 +498,9 @@ void WarpX::checkEarlyUnusedParams ()
     amrex::Print() << "\n"; // better: conditional \n based on return value
     amrex::ParmParse::QueryUnusedInputs();
 
-    // Print the warning list right after the first step.
-    amrex::Print() << ablastr::warn_manager::GetWMInstance().PrintGlobalWarnings("FIRST STEP");
+    // Gather the warning list of the first step with non-blocking communications,
+    // it is printed once the gather is complete (see WarpX::Evolve).
+    ablastr::warn_manager::GetWMInstance().StartGlobalWarnings("FIRST STEP");
 }
 
 void WarpX::ExplicitFillBoundaryEBUpdateAux ()
@@ -489,35 +557,50 @@ void WarpX::HandleParticlesAtBoundaries (int step, amrex::Real cur_time, int num
 {
     mypc->ContinuousFluxInjection(cur_time, dt[0]);
 
-    mypc->ApplyBoundaryConditions();
+    // Particles travel less than c*dt in one time step, with any field solver, to
+    // which the shift of the moving window and of the Galilean grid are added, so
+    // that only the tiles within this distance of a boundary need to apply the
+    // boundary conditions. Species pushed every n steps (<species>.push_every_n_steps)
+    // travel less than n*c*dt on the steps at which they are pushed.
+    const amrex::Real v_galilean = std::sqrt(m_v_galilean[0]*m_v_galilean[0] +
+                                             m_v_galilean[1]*m_v_galilean[1] +
+                                             m_v_galilean[2]*m_v_galilean[2]);
+    const amrex::Real max_push_steps = static_cast<amrex::Real>(mypc->MaxNumStepsPushed());
+    const auto dx0 = Geom(0).CellSizeArray();
+    const amrex::Real max_dx0 = *std::max_element(dx0.begin(), dx0.end());
+    const amrex::Real max_displacement = (PhysConst::c*max_push_steps + v_galilean)*dt[0]
+        + static_cast<amrex::Real>(num_moved)*max_dx0;
+    mypc->ApplyBoundaryConditions(max_displacement);
     m_particle_boundary_buffer->gatherParticlesFromDomainBoundaries(*mypc);
 
-    // Non-Maxwell solver: particles can move by an arbitrary number of cells
-    if( electromagnetic_solver_id == ElectromagneticSolverAlgo::None ||
-        electromagnetic_solver_id == ElectromagneticSolverAlgo::HybridPIC )
-    {
-        mypc->Redistribute();
-    }
-    else
-    {
-        // Electromagnetic solver: due to CFL condition, particles can
-        // only move by one or two cells per time step
-        if (max_level == 0) {
-            int num_redistribute_ghost = num_moved;
-            if ((m_v_galilean[0]!=0) or (m_v_galilean[1]!=0) or (m_v_galilean[2]!=0)) {
-                // Galilean algorithm ; particles can move by up to 2 cells
-                num_redistribute_ghost += 2;
-            } else {
-                // Standard algorithm ; particles can move by up to 1 cell
-                num_redistribute_ghost += 1;
-            }
-            mypc->RedistributeLocal(num_redistribute_ghost);
+    // As above, particles travel less than c*dt in one time step (times the number of
+    // steps of the species pushed every n steps), with any field solver, to which
+    // the shift of the moving window and of the Galilean grid are added.
+    // If this is at most the blocking factor (i.e. the size of the smallest boxes),
+    // particles can only reach the neighboring boxes, and the redistribution only
+    // communicates with the neighboring ranks. Otherwise, and with mesh refinement,
+    // the general redistribution is used. After a regrid or a load balance, the
+    // particles have already been redistributed by the general method.
+    int num_redistribute_ghost = -1;
+    if (neighbor_redistribute && max_level == 0) {
+        int num_cells = 0;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            num_cells = std::max(num_cells, static_cast<int>(
+                std::ceil((PhysConst::c*max_push_steps + v_galilean)*dt[0]/dx0[idim])));
         }
-        else {
-            mypc->Redistribute();
+        num_cells += num_moved;
+        if (num_cells <= blockingFactor(0).min()) {
+            num_redistribute_ghost = num_cells;
         }
     }
 
+    if (num_redistribute_ghost > 0) {
+        mypc->RedistributeLocal(num_redistribute_ghost);
+    }
+    else {
+        mypc->Redistribute();
+    }
+
     // interact the particles with EB walls (if present)
 #ifdef AMREX_USE_EB
     mypc->ScrapeParticlesAtEB(amrex::GetVecOfConstPtrs(m_distance_to_eb));
@@ -629,13 +712,23 @@ WarpX::OneStep_multiJ (const amrex::Real cur_time)
     // 2) Set the averaged fields to zero
     if (WarpX::fft_do_time_averaging) { PSATDEraseAverageFields(); }
 
+    // When J and rho are deposited at the same times, deposit both
+    // in a single pass over the particles
+    const bool deposit_rho_with_J = rho_fp[0] && J_in_time == JInTime::Linear &&
+        rho_in_time == RhoInTime::Linear && MultiParticleContainer::CanDepositCurrentAndCharge(rho_fp);
+
     // 3) Deposit rho (in rho_new, since it will be moved during the loop)
     //    (after checking that pointer to rho_fp on MR level 0 is not null)
     if (rho_fp[0] && rho_in_time == RhoInTime::Linear)
     {
         // Deposit rho at relative time -dt
         // (dt[0] denotes the time step on mesh refinement level 0)
-        mypc->DepositCharge(rho_fp, -dt[0]);
+        if (deposit_rho_with_J) {
+            auto& current = (do_current_centering && !do_fused_current_centering) ? current_fp_nodal : current_fp;
+            mypc->DepositCurrentAndCharge(current, rho_fp, dt[0], -dt[0]);
+        } else {
+            mypc->DepositCharge(rho_fp, -dt[0]);
+        }
         // Filter, exchange boundary, and interpolate across levels
         SyncRho(rho_fp, rho_cp, charge_buf);
         // Forward FFT of rho
@@ -646,8 +739,8 @@ WarpX::OneStep_multiJ (const amrex::Real cur_time)
     //    (dt[0] denotes the time step on mesh refinement level 0)
     if (J_in_time == JInTime::Linear)
     {
-        auto& current = (do_current_centering) ? current_fp_nodal : current_fp;
-        mypc->DepositCurrent(current, dt[0], -dt[0]);
+        auto& current = (do_current_centering && !do_fused_current_centering) ? current_fp_nodal : current_fp;
+        if (!deposit_rho_with_J) { mypc->DepositCurrent(current, dt[0], -dt[0]); }
         // Synchronize J: filter, exchange boundary, and interpolate across levels.
         // With current centering, the nodal current is deposited in 'current',
         // namely 'current_fp_nodal': SyncCurrent stores the result of its centering
@@ -679,9 +772,14 @@ WarpX::OneStep_multiJ (const amrex::Real cur_time)
             (i_deposit-n_deposit+1)*sub_dt : (i_deposit-n_deposit+0.5_rt)*sub_dt;
 
         // Deposit new J at relative time t_deposit_current with time step dt
-        // (dt[0] denotes the time step on mesh refinement level 0)
-        auto& current = (do_current_centering) ? current_fp_nodal : current_fp;
-        mypc->DepositCurrent(current, dt[0], t_deposit_current);
+        // (dt[0] denotes the time step on mesh refinement level 0),
+        // and new rho at the same time if both are deposited together
+        auto& current = (do_current_centering && !do_fused_current_centering) ? current_fp_nodal : current_fp;
+        if (deposit_rho_with_J) {
+            mypc->DepositCurrentAndCharge(current, rho_fp, dt[0], t_deposit_current);
+        } else {
+            mypc->DepositCurrent(current, dt[0], t_deposit_current);
+        }
         // Synchronize J: filter, exchange boundary, and interpolate across levels.
         // With current centering, the nodal current is deposited in 'current',
         // namely 'current_fp_nodal': SyncCurrent stores the result of its centering
@@ -699,7 +797,8 @@ WarpX::OneStep_multiJ (const amrex::Real cur_time)
             if (rho_in_time == RhoInTime::Linear) { PSATDMoveRhoNewToRhoOld(); }
 
             // Deposit rho at relative time t_deposit_charge
-            mypc->DepositCharge(rho_fp, t_deposit_charge);
+            // (unless it was deposited together with J)
+            if (!deposit_rho_with_J) { mypc->DepositCharge(rho_fp, t_deposit_charge); }
             // Filter, exchange boundary, and interpolate across levels
             SyncRho(rho_fp, rho_cp, charge_buf);
             // Forward FFT of rho
@@ -992,11 +1091,12 @@ void
 WarpX::PushParticlesandDeposit (int lev, amrex::Real cur_time, DtType a_dt_type, bool skip_current,
                                PushType push_type)
 {
+    PhaseTimer::Scope const phase_timer(PhaseTimer::ParticlePush);
     amrex::MultiFab* current_x = nullptr;
     amrex::MultiFab* current_y = nullptr;
     amrex::MultiFab* current_z = nullptr;
 
-    if (WarpX::do_current_centering)
+    if (WarpX::do_current_centering && !WarpX::do_fused_current_centering)
     {
         current_x = current_fp_nodal[lev][0].get();
         current_y = current_fp_nodal[lev][1].get();
@@ -1052,6 +1152,10 @@ WarpX::PushParticlesandDeposit (int lev, amrex::Real cur_time, DtType a_dt_type,
                          *Bfield_aux[lev][0], *Bfield_aux[lev][1], *Bfield_aux[lev][2],
                          rho_fp[lev].get(), *current_x, *current_y, *current_z, cur_time, skip_current);
         }
+
+        // All species have deposited on this level: start summing the
+        // guard cells of J, which is completed in SyncCurrent
+        if (canStartSumBoundaryJEarly()) { SumBoundaryJ_nowait(lev); }
     }
 }
 
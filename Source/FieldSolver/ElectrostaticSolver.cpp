@@ -39,10 +39,13 @@
 #include <AMReX_IndexType.H>
 #include <AMReX_IntVect.H>
 #include <AMReX_LO_BCTYPES.H>
+#include <AMReX_LayoutData.H>
 #include <AMReX_MFIter.H>
 #include <AMReX_MLMG.H>
 #include <AMReX_MultiFab.H>
 #include <AMReX_REAL.H>
+#include <AMReX_Reduce.H>
+#include <AMReX_Scan.H>
 #include <AMReX_SPACE.H>
 #include <AMReX_Vector.H>
 #include <AMReX_MFInterp_C.H>
@@ -50,8 +53,12 @@
 #   include <AMReX_EBFabFactory.H>
 #endif
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <memory>
+#include <numeric>
+#include <optional>
 #include <string>
 
 using namespace amrex;
@@ -73,21 +80,60 @@ WarpX::ComputeSpaceChargeField (bool const reset_fields)
     }
 
     if (electrostatic_solver_id == ElectrostaticSolverAlgo::LabFrame ||
+        electrostatic_solver_id == ElectrostaticSolverAlgo::LabFrameEffectivePotential ||
         electrostatic_solver_id == ElectrostaticSolverAlgo::LabFrameElectroMagnetostatic) {
         AddSpaceChargeFieldLabFrame();
     }
     else {
-        // Loop over the species and add their space-charge contribution to E and B.
-        // Note that the fields calculated here does not include the E field
-        // due to simulation boundary potentials
+        // Group the species by mean velocity: the species of a group are
+        // deposited together and their space-charge field is computed with a
+        // single Poisson solve, with the velocity of the first species of the group.
+        // Without self_fields_beta_tolerance, each species is solved separately.
+        amrex::Vector<amrex::Vector<WarpXParticleContainer*>> species_groups;
+        amrex::Vector<std::array<Real, 3>> group_betas;
         for (int ispecies=0; ispecies<mypc->nSpecies(); ispecies++){
             WarpXParticleContainer& species = mypc->GetParticleContainer(ispecies);
-            if (species.initialize_self_fields ||
-                (electrostatic_solver_id == ElectrostaticSolverAlgo::Relativistic)) {
-                AddSpaceChargeField(species);
+            if (!species.initialize_self_fields &&
+                (electrostatic_solver_id != ElectrostaticSolverAlgo::Relativistic)) {
+                continue;
+            }
+            if (species.getCharge() == 0) { continue; }
+
+            // Get the particle beta vector
+            bool const local_average = false; // Average across all MPI ranks
+            std::array<ParticleReal, 3> beta_pr = species.meanParticleVelocity(local_average);
+            std::array<Real, 3> beta;
+            for (int i=0 ; i < static_cast<int>(beta.size()) ; i++) {
+                beta[i] = beta_pr[i]/PhysConst::c; // Normalize
+            }
+
+            bool grouped = false;
+            if (self_fields_beta_tolerance >= 0) {
+                for (int igroup = 0; igroup < static_cast<int>(species_groups.size()); ++igroup) {
+                    bool close = true;
+                    for (int i=0 ; i < static_cast<int>(beta.size()) ; i++) {
+                        close = close && (std::abs(beta[i] - group_betas[igroup][i]) <= self_fields_beta_tolerance);
+                    }
+                    if (close) {
+                        species_groups[igroup].push_back(&species);
+                        grouped = true;
+                        break;
+                    }
+                }
+            }
+            if (!grouped) {
+                species_groups.push_back({&species});
+                group_betas.push_back(beta);
             }
         }
 
+        // Add the space-charge contribution of each group to E and B.
+        // Note that the fields calculated here does not include the E field
+        // due to simulation boundary potentials
+        for (int igroup = 0; igroup < static_cast<int>(species_groups.size()); ++igroup) {
+            AddSpaceChargeField(species_groups[igroup], group_betas[igroup]);
+        }
+
         // Add the field due to the boundary potentials
         if (m_boundary_potential_specified ||
                 (electrostatic_solver_id == ElectrostaticSolverAlgo::Relativistic)){
@@ -143,11 +189,12 @@ WarpX::AddBoundaryField ()
 }
 
 void
-WarpX::AddSpaceChargeField (WarpXParticleContainer& pc)
+WarpX::AddSpaceChargeField (amrex::Vector<WarpXParticleContainer*> const& species_group,
+                            std::array<Real, 3> const beta)
 {
     WARPX_PROFILE("WarpX::AddSpaceChargeField");
 
-    if (pc.getCharge() == 0) {
+    if (species_group.empty()) {
         return;
     }
 
@@ -191,9 +238,11 @@ WarpX::AddSpaceChargeField (WarpXParticleContainer& pc)
     bool const reset = false;
     bool const apply_boundary_and_scale_volume = true;
     bool const interpolate_across_levels = false;
-    if ( !pc.do_not_deposit) {
-        pc.DepositCharge(rho, local, reset, apply_boundary_and_scale_volume,
-                              interpolate_across_levels);
+    for (auto* pc : species_group) {
+        if ( !pc->do_not_deposit) {
+            pc->DepositCharge(rho, local, reset, apply_boundary_and_scale_volume,
+                                  interpolate_across_levels);
+        }
     }
     for (int lev = 0; lev <= max_level; lev++) {
         if (lev > 0) {
@@ -204,18 +253,22 @@ WarpX::AddSpaceChargeField (WarpXParticleContainer& pc)
     }
     SyncRho(rho, rho_coarse, charge_buf); // Apply filter, perform MPI exchange, interpolate across levels
 
-    // Get the particle beta vector
-    bool const local_average = false; // Average across all MPI ranks
-    std::array<ParticleReal, 3> beta_pr = pc.meanParticleVelocity(local_average);
-    std::array<Real, 3> beta;
-    for (int i=0 ; i < static_cast<int>(beta.size()) ; i++) {
-        beta[i] = beta_pr[i]/PhysConst::c; // Normalize
+    // Use the most stringent solver parameters of the species of the group
+    Real required_precision = species_group[0]->self_fields_required_precision;
+    Real absolute_tolerance = species_group[0]->self_fields_absolute_tolerance;
+    int max_iters = species_group[0]->self_fields_max_iters;
+    int verbosity = species_group[0]->self_fields_verbosity;
+    for (auto const* pc : species_group) {
+        required_precision = std::min(required_precision, pc->self_fields_required_precision);
+        absolute_tolerance = std::min(absolute_tolerance, pc->self_fields_absolute_tolerance);
+        max_iters = std::max(max_iters, pc->self_fields_max_iters);
+        verbosity = std::max(verbosity, pc->self_fields_verbosity);
     }
 
     // Compute the potential phi, by solving the Poisson equation
-    computePhi( rho, phi, beta, pc.self_fields_required_precision,
-                pc.self_fields_absolute_tolerance, pc.self_fields_max_iters,
-                pc.self_fields_verbosity );
+    computePhi( rho, phi, beta, required_precision,
+                absolute_tolerance, max_iters,
+                verbosity );
 
     // Compute the corresponding electric and magnetic field, from the potential phi
     computeE( Efield_fp, phi, beta );
@@ -264,6 +317,30 @@ WarpX::AddSpaceChargeFieldLabFrame ()
     // Todo: use simpler finite difference form with beta=0
     const std::array<Real, 3> beta = {0._rt};
 
+    // Set the initial guess of the solver: by default, this is phi from the
+    // previous step, which is still stored in phi_fp
+    if (self_fields_initial_guess == PoissonInitialGuess::Zero) {
+        for (int lev = 0; lev <= finestLevel(); lev++) {
+            phi_fp[lev]->setVal(0.);
+        }
+    } else if (self_fields_initial_guess == PoissonInitialGuess::Extrapolate) {
+        for (int lev = 0; lev <= finestLevel(); lev++) {
+            const amrex::IntVect ng = phi_fp[lev]->nGrowVect();
+            if (!phi_fp_previous[lev]) {
+                // First solve: there is only one previous phi, use it as it is
+                AllocInitMultiFab(phi_fp_previous[lev], phi_fp[lev]->boxArray(),
+                                  phi_fp[lev]->DistributionMap(), 1, ng, lev, "phi_fp_previous");
+                MultiFab::Copy(*phi_fp_previous[lev], *phi_fp[lev], 0, 0, 1, ng);
+            } else {
+                // phi_fp_previous = 2 phi^{n} - phi^{n-1}, then swap it with phi_fp,
+                // so that phi_fp_previous holds phi^{n} for the next solve
+                MultiFab::LinComb(*phi_fp_previous[lev], 2._rt, *phi_fp[lev], 0,
+                                  -1._rt, *phi_fp_previous[lev], 0, 0, 1, ng);
+                MultiFab::Swap(*phi_fp[lev], *phi_fp_previous[lev], 0, 0, 1, ng);
+            }
+        }
+    }
+
     // set the boundary potentials appropriately
     setPhiBC(phi_fp);
 
@@ -273,11 +350,25 @@ WarpX::AddSpaceChargeFieldLabFrame ()
         // Use the Python level solver (user specified)
         ExecutePythonCallback("poissonsolver");
 
+    } else if (electrostatic_solver_id == ElectrostaticSolverAlgo::LabFrameEffectivePotential) {
+
+        // Semi-implicit scheme: the permittivity includes the response of the
+        // plasma over the time step, with the MLMG variable-coefficient solver
+        Vector<std::unique_ptr<MultiFab> > sigma;
+        computeEffectivePotentialSigma(sigma);
+        computePhi(rho_fp, phi_fp, beta, self_fields_required_precision,
+                   self_fields_absolute_tolerance, self_fields_max_iters,
+                   self_fields_verbosity, &sigma);
+
     } else {
 
 #if defined(WARPX_DIM_1D_Z)
         // Use the tridiag solver with 1D
-        computePhiTriDiagonal(rho_fp, phi_fp);
+        if (do_parallel_tridiag_solve) {
+            computePhiTriDiagonalParallel(rho_fp, phi_fp);
+        } else {
+            computePhiTriDiagonal(rho_fp, phi_fp);
+        }
 #else
         // Use the AMREX MLMG or the FFT (IGF) solver otherwise
         computePhi(rho_fp, phi_fp, beta, self_fields_required_precision,
@@ -299,6 +390,79 @@ WarpX::AddSpaceChargeFieldLabFrame ()
     computeB( Bfield_fp, phi_fp, beta );
 }
 
+void
+WarpX::computeEffectivePotentialSigma (amrex::Vector<std::unique_ptr<amrex::MultiFab> >& sigma)
+{
+    WARPX_PROFILE("WarpX::computeEffectivePotentialSigma");
+
+    // Temporary charge density of each species, and the relative permittivity
+    const int num_levels = finest_level + 1;
+    Vector<std::unique_ptr<MultiFab> > rho(num_levels);
+    Vector<std::unique_ptr<MultiFab> > rho_coarse(num_levels);
+    sigma.resize(num_levels);
+    const amrex::IntVect ng = guard_cells.ng_depos_rho;
+    for (int lev = 0; lev < num_levels; lev++) {
+        BoxArray nba = boxArray(lev);
+        nba.surroundingNodes();
+        rho[lev] = std::make_unique<MultiFab>(nba, DistributionMap(lev), 1, ng);
+        if (lev > 0) {
+            BoxArray cba = nba;
+            cba.coarsen(refRatio(lev-1));
+            rho_coarse[lev] = std::make_unique<MultiFab>(cba, DistributionMap(lev), 1, ng);
+        }
+        sigma[lev] = std::make_unique<MultiFab>(boxArray(lev), DistributionMap(lev), 1, 0);
+        sigma[lev]->setVal(1._rt);
+    }
+
+    // Same options as in MultiParticleContainer::DepositCharge, except that the
+    // boundary conditions and the RZ volume scaling are applied here: DepositCharge
+    // applies them to the sum over species, while sigma needs each species separately
+    bool const local = true;
+    bool const reset = false;
+    bool const apply_boundary_and_scale_volume = true;
+    bool const interpolate_across_levels = false;
+    for (int ispecies = 0; ispecies < mypc->nSpecies(); ++ispecies) {
+        WarpXParticleContainer& species = mypc->GetParticleContainer(ispecies);
+        const auto q = static_cast<Real>(species.getCharge());
+        const auto m = static_cast<Real>(species.getMass());
+        if (q == 0._rt || m <= 0._rt || species.do_not_deposit) { continue; }
+
+        for (int lev = 0; lev < num_levels; lev++) {
+            rho[lev]->setVal(0.);
+            if (rho_coarse[lev]) { rho_coarse[lev]->setVal(0.); }
+            if (lev > 0 && charge_buf[lev]) { charge_buf[lev]->setVal(0.); }
+        }
+        species.DepositCharge(rho, local, reset, apply_boundary_and_scale_volume,
+                              interpolate_across_levels);
+        SyncRho(rho, rho_coarse, charge_buf);
+
+        // omega_p^2 = |rho| |q| / (m epsilon_0), averaged over the nodes of each cell
+        for (int lev = 0; lev < num_levels; lev++) {
+            const Real coef = effective_potential_factor*std::abs(q)*dt[lev]*dt[lev]
+                /(4._rt*m*PhysConst::ep0*static_cast<Real>(1 << AMREX_SPACEDIM));
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+            for (MFIter mfi(*sigma[lev], TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+                Array4<Real> const& s = sigma[lev]->array(mfi);
+                Array4<Real const> const& r = rho[lev]->const_array(mfi);
+                amrex::ParallelFor(mfi.tilebox(), [=] AMREX_GPU_DEVICE (int i, int j, int k)
+                {
+                    Real sum = 0._rt;
+                    for (int dk = 0; dk <= (AMREX_SPACEDIM > 2 ? 1 : 0); ++dk) {
+                        for (int dj = 0; dj <= (AMREX_SPACEDIM > 1 ? 1 : 0); ++dj) {
+                            for (int di = 0; di <= 1; ++di) {
+                                sum += std::abs(r(i+di, j+dj, k+dk));
+                            }
+                        }
+                    }
+                    s(i,j,k) += coef*sum;
+                });
+            }
+        }
+    }
+}
+
 /* Compute the potential `phi` by solving the Poisson equation with `rho` as
    a source, assuming that the source moves at a constant speed \f$\vec{\beta}\f$.
    This uses the amrex solver.
@@ -315,6 +479,8 @@ WarpX::AddSpaceChargeFieldLabFrame ()
    \param[in] absolute_tolerance The absolute convergence threshold for the MLMG solver
    \param[in] max_iters The maximum number of iterations allowed for the MLMG solver
    \param[in] verbosity The verbosity setting for the MLMG solver
+   \param[in] sigma The relative permittivity at the cell centers, if the
+              variable-coefficient operator is used (see computeEffectivePotentialSigma)
 */
 void
 WarpX::computePhi (const amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rho,
@@ -323,7 +489,8 @@ WarpX::computePhi (const amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rho,
                    Real const required_precision,
                    Real absolute_tolerance,
                    int const max_iters,
-                   int const verbosity) const
+                   int const verbosity,
+                   amrex::Vector<std::unique_ptr<amrex::MultiFab> > const* sigma) const
 {
     // create a vector to our fields, sorted by level
     amrex::Vector<amrex::MultiFab*> sorted_rho;
@@ -332,6 +499,13 @@ WarpX::computePhi (const amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rho,
         sorted_rho.emplace_back(rho[lev].get());
         sorted_phi.emplace_back(phi[lev].get());
     }
+    std::optional<amrex::Vector<amrex::MultiFab const*> > sorted_sigma;
+    if (sigma) {
+        sorted_sigma = amrex::Vector<amrex::MultiFab const*>{};
+        for (int lev = 0; lev <= finest_level; ++lev) {
+            sorted_sigma->emplace_back((*sigma)[lev].get());
+        }
+    }
 
 #if defined(AMREX_USE_EB)
 
@@ -402,7 +576,8 @@ WarpX::computePhi (const amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rho,
         this->ref_ratio,
         post_phi_calculation,
         gett_new(0),
-        eb_farray_box_factory
+        eb_farray_box_factory,
+        sorted_sigma
     );
 
 }
@@ -1006,6 +1181,163 @@ WarpX::computePhiTriDiagonal (const amrex::Vector<std::unique_ptr<amrex::MultiFa
     phi[lev]->ParallelCopy(phi1d_mf, 0, 0, 1);
 }
 
+void
+WarpX::computePhiTriDiagonalParallel (const amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rho,
+                                      amrex::Vector<std::unique_ptr<amrex::MultiFab> >& phi) const
+{
+    WARPX_PROFILE("WarpX::computePhiTriDiagonalParallel");
+
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(max_level == 0,
+        "The tridiagonal solver cannot be used with mesh refinement");
+
+    const int lev = 0;
+
+    const amrex::Real* dx = Geom(lev).CellSize();
+    const amrex::Real xmin = Geom(lev).ProbLo(0);
+    const amrex::Real xmax = Geom(lev).ProbHi(0);
+    const int nx_full_domain = static_cast<int>( (xmax - xmin)/dx[0] + 0.5_rt );
+
+    const bool lo_is_neumann = (WarpX::field_boundary_lo[0] == FieldBoundaryType::Neumann);
+    const bool hi_is_neumann = (WarpX::field_boundary_hi[0] == FieldBoundaryType::Neumann);
+
+    // Multiplier on the charge density
+    const amrex::Real norm = dx[0]*dx[0]/PhysConst::ep0;
+
+    // Each node is owned by one box: the nodes shared by two neighboring boxes
+    // belong to the box on the right, and the last node to the last box.
+    // For box b, the data reduced over all ranks holds: the sum of the masked
+    // rho over the owned nodes (R_b), the sum of S over the owned nodes (Sigma_b)
+    // and the number of owned nodes (N_b); then the boundary values
+    // rho_0, rho_n, phi_0 and phi_n.
+    const amrex::BoxArray& ba = phi[lev]->boxArray();
+    const int nboxes = static_cast<int>(ba.size());
+    amrex::Vector<amrex::Real> sums(3*nboxes + 4, 0._rt);
+
+    // Local exclusive prefix sum of S on each box, over all the nodes of the box
+    amrex::LayoutData<amrex::Gpu::DeviceVector<amrex::Real>> T_local(ba, phi[lev]->DistributionMap());
+
+    for (MFIter mfi(*phi[lev]); mfi.isValid(); ++mfi) {
+        const amrex::Box& bx = mfi.validbox();
+        const int lo = bx.smallEnd(0);
+        const int hi = bx.bigEnd(0);
+        const int nnodes = hi - lo + 1;
+        const bool owns_hi = (hi == nx_full_domain);
+        const int hi_owned = owns_hi ? hi : hi - 1;
+
+        amrex::Array4<amrex::Real const> const& rho_arr = rho[lev]->const_array(mfi);
+        amrex::Array4<amrex::Real const> const& phi_arr = phi[lev]->const_array(mfi);
+
+        // rho, masked to the nodes that are solved with the Laplacian stencil
+        // and owned by this box
+        amrex::Gpu::DeviceVector<amrex::Real> r(nnodes);
+        amrex::Real* const AMREX_RESTRICT p_r = r.data();
+        amrex::ParallelFor(nnodes, [=] AMREX_GPU_DEVICE (int ii) noexcept
+        {
+            const int i = lo + ii;
+            p_r[ii] = (i >= 1 && i <= nx_full_domain-1 && i <= hi_owned) ?
+                norm*rho_arr(i,0,0) : 0._rt;
+        });
+
+        amrex::Gpu::DeviceVector<amrex::Real> S(nnodes);
+        T_local[mfi].resize(nnodes);
+        amrex::Real* const AMREX_RESTRICT p_S = S.data();
+        amrex::Real* const AMREX_RESTRICT p_T = T_local[mfi].data();
+        const amrex::Real R_b = amrex::Scan::InclusiveSum(nnodes, p_r, p_S, amrex::Scan::retSum);
+        const amrex::Real T_sum = amrex::Scan::ExclusiveSum(nnodes, p_S, p_T, amrex::Scan::retSum);
+
+        // Since the masked rho is zero on a node that is not owned,
+        // S on that node is equal to S on the last owned node
+        const int ib = mfi.index();
+        sums[3*ib] = R_b;
+        sums[3*ib+1] = owns_hi ? T_sum : T_sum - R_b;
+        sums[3*ib+2] = static_cast<amrex::Real>(hi_owned - lo + 1);
+
+        // Values on the boundaries, on the box that owns them
+        amrex::ReduceOps<amrex::ReduceOpSum, amrex::ReduceOpSum,
+                         amrex::ReduceOpSum, amrex::ReduceOpSum> reduce_ops;
+        amrex::ReduceData<amrex::Real, amrex::Real, amrex::Real, amrex::Real> reduce_data(reduce_ops);
+        using ReduceTuple = typename decltype(reduce_data)::Type;
+        reduce_ops.eval(bx, reduce_data,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
+            {
+                amrex::ignore_unused(j, k);
+                const bool is_lo = (i == 0);
+                const bool is_hi = (i == nx_full_domain && owns_hi);
+                return {is_lo ? norm*rho_arr(i,0,0) : 0._rt,
+                        is_hi ? norm*rho_arr(i,0,0) : 0._rt,
+                        is_lo ? phi_arr(i,0,0) : 0._rt,
+                        is_hi ? phi_arr(i,0,0) : 0._rt};
+            });
+        auto const hv = reduce_data.value(reduce_ops);
+        sums[3*nboxes] += amrex::get<0>(hv);
+        sums[3*nboxes+1] += amrex::get<1>(hv);
+        sums[3*nboxes+2] += amrex::get<2>(hv);
+        sums[3*nboxes+3] += amrex::get<3>(hv);
+    }
+
+    amrex::ParallelDescriptor::ReduceRealSum(sums.data(), static_cast<int>(sums.size()));
+
+    // Offsets of S and T at the first node of each box, from the boxes on its left
+    amrex::Vector<int> order(nboxes);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&ba] (int a, int b) {
+        return ba[a].smallEnd(0) < ba[b].smallEnd(0);
+    });
+    amrex::Vector<amrex::Real> S_offset(nboxes), T_offset(nboxes);
+    amrex::Real S_total = 0._rt;
+    amrex::Real T_total = 0._rt;
+    for (const int ib : order) {
+        S_offset[ib] = S_total;
+        T_offset[ib] = T_total;
+        T_total += sums[3*ib+2]*S_total + sums[3*ib+1];
+        S_total += sums[3*ib];
+    }
+    // T at the last node, which does not include S on this node
+    const amrex::Real T_n = T_total - S_total;
+
+    const amrex::Real rho_0 = sums[3*nboxes];
+    const amrex::Real rho_n = sums[3*nboxes+1];
+    amrex::Real phi_0 = sums[3*nboxes+2];
+    const amrex::Real phi_n = sums[3*nboxes+3];
+    const auto n = static_cast<amrex::Real>(nx_full_domain);
+
+    // The slope c = phi_1 - phi_0 and phi_0, from the boundary conditions
+    amrex::Real c = 0._rt;
+    if (lo_is_neumann) {
+        c = -0.5_rt*rho_0;
+        if (hi_is_neumann) {
+            // The potential is relative to an arbitrary constant:
+            // set the upper boundary to zero, as in computePhiTriDiagonal
+            phi_0 = T_n - n*c;
+        } else {
+            phi_0 = phi_n - n*c + T_n;
+        }
+    } else {
+        if (hi_is_neumann) {
+            c = S_total + 0.5_rt*rho_n;
+        } else {
+            c = (phi_n - phi_0 + T_n)/n;
+        }
+    }
+
+    for (MFIter mfi(*phi[lev]); mfi.isValid(); ++mfi) {
+        const amrex::Box& bx = mfi.validbox();
+        const int lo = bx.smallEnd(0);
+        amrex::Array4<amrex::Real> const& phi_arr = phi[lev]->array(mfi);
+        amrex::Real const* const AMREX_RESTRICT p_T = T_local[mfi].data();
+        const amrex::Real S_off = S_offset[mfi.index()];
+        const amrex::Real T_off = T_offset[mfi.index()];
+
+        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            amrex::ignore_unused(j, k);
+            const int ii = i - lo;
+            phi_arr(i,0,0) = phi_0 + static_cast<amrex::Real>(i)*c
+                - (T_off + static_cast<amrex::Real>(ii)*S_off + p_T[ii]);
+        });
+    }
+}
+
 void ElectrostaticSolver::PoissonBoundaryHandler::definePhiBCs (const amrex::Geometry& geom)
 {
 #ifdef WARPX_DIM_RZ
@@ -111,6 +111,64 @@ void FiniteDifferenceSolver::EvolveBCartesian (
 
     amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
 
+#ifdef AMREX_USE_GPU
+    // With many small boxes, the launch latency of one kernel per box dominates:
+    // update all the boxes at once with one kernel per component, unless the
+    // time spent in each box is needed for the load balance costs
+    if (!(cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers))
+    {
+        auto const& Bx = Bfield[0]->arrays();
+        auto const& By = Bfield[1]->arrays();
+        auto const& Bz = Bfield[2]->arrays();
+        auto const& Ex = Efield[0]->arrays();
+        auto const& Ey = Efield[1]->arrays();
+        auto const& Ez = Efield[2]->arrays();
+
+        // Extract stencil coefficients
+        Real const * const AMREX_RESTRICT coefs_x = m_stencil_coefs_x.dataPtr();
+        auto const n_coefs_x = static_cast<int>(m_stencil_coefs_x.size());
+        Real const * const AMREX_RESTRICT coefs_y = m_stencil_coefs_y.dataPtr();
+        auto const n_coefs_y = static_cast<int>(m_stencil_coefs_y.size());
+        Real const * const AMREX_RESTRICT coefs_z = m_stencil_coefs_z.dataPtr();
+        auto const n_coefs_z = static_cast<int>(m_stencil_coefs_z.size());
+
+        amrex::ParallelFor(*Bfield[0],
+            [=] AMREX_GPU_DEVICE (int bno, int i, int j, int k){
+                Bx[bno](i, j, k) += dt * T_Algo::UpwardDz(Ey[bno], coefs_z, n_coefs_z, i, j, k)
+                                  - dt * T_Algo::UpwardDy(Ez[bno], coefs_y, n_coefs_y, i, j, k);
+            });
+        amrex::ParallelFor(*Bfield[1],
+            [=] AMREX_GPU_DEVICE (int bno, int i, int j, int k){
+                By[bno](i, j, k) += dt * T_Algo::UpwardDx(Ez[bno], coefs_x, n_coefs_x, i, j, k)
+                                  - dt * T_Algo::UpwardDz(Ex[bno], coefs_z, n_coefs_z, i, j, k);
+            });
+        amrex::ParallelFor(*Bfield[2],
+            [=] AMREX_GPU_DEVICE (int bno, int i, int j, int k){
+                Bz[bno](i, j, k) += dt * T_Algo::UpwardDy(Ex[bno], coefs_y, n_coefs_y, i, j, k)
+                                  - dt * T_Algo::UpwardDx(Ey[bno], coefs_x, n_coefs_x, i, j, k);
+            });
+
+        // div(B) cleaning correction for errors in magnetic Gauss law (div(B) = 0)
+        if (Gfield)
+        {
+            auto const& G = Gfield->arrays();
+            amrex::ParallelFor(*Bfield[0],
+                [=] AMREX_GPU_DEVICE (int bno, int i, int j, int k){
+                    Bx[bno](i,j,k) += dt * T_Algo::DownwardDx(G[bno], coefs_x, n_coefs_x, i, j, k);
+                });
+            amrex::ParallelFor(*Bfield[1],
+                [=] AMREX_GPU_DEVICE (int bno, int i, int j, int k){
+                    By[bno](i,j,k) += dt * T_Algo::DownwardDy(G[bno], coefs_y, n_coefs_y, i, j, k);
+                });
+            amrex::ParallelFor(*Bfield[2],
+                [=] AMREX_GPU_DEVICE (int bno, int i, int j, int k){
+                    Bz[bno](i,j,k) += dt * T_Algo::DownwardDz(G[bno], coefs_z, n_coefs_z, i, j, k);
+                });
+        }
+        return;
+    }
+#endif
+
     // Loop through the grids, and over the tiles within each grid
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
@@ -0,0 +1,262 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "FiniteDifferenceSolver.H"
+
+#ifndef WARPX_DIM_RZ
+#   include "FieldSolver/FiniteDifferenceSolver/FiniteDifferenceAlgorithms/CartesianYeeAlgorithm.H"
+#   include "FieldSolver/FiniteDifferenceSolver/FiniteDifferenceAlgorithms/CartesianCKCAlgorithm.H"
+#   include "FieldSolver/FiniteDifferenceSolver/FiniteDifferenceAlgorithms/CartesianNodalAlgorithm.H"
+#endif
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXAlgorithmSelection.H"
+#include "Utils/WarpXConst.H"
+#include "WarpX.H"
+
+#include <AMReX.H>
+#include <AMReX_Array4.H>
+#include <AMReX_Box.H>
+#include <AMReX_Config.H>
+#include <AMReX_GpuAtomic.H>
+#include <AMReX_GpuControl.H>
+#include <AMReX_GpuDevice.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_IndexType.H>
+#include <AMReX_IntVect.H>
+#include <AMReX_LayoutData.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_REAL.H>
+
+#include <AMReX_BaseFwd.H>
+
+#include <array>
+#include <memory>
+
+using namespace amrex;
+
+#ifndef WARPX_DIM_RZ
+namespace
+{
+    /** Stencil coefficients of the three directions */
+    struct StencilCoefs
+    {
+        Real const * AMREX_RESTRICT x;
+        Real const * AMREX_RESTRICT y;
+        Real const * AMREX_RESTRICT z;
+        int nx, ny, nz;
+    };
+
+    /** Push B by `dt` in the boxes `tbx`, `tby` and `tbz` (one kernel) */
+    template<typename T_Algo>
+    void pushB (Box const& tbx, Box const& tby, Box const& tbz,
+                Array4<Real> const& Bx, Array4<Real> const& By, Array4<Real> const& Bz,
+                Array4<Real> const& Ex, Array4<Real> const& Ey, Array4<Real> const& Ez,
+                StencilCoefs const& c, Real const dt)
+    {
+        Real const * const AMREX_RESTRICT coefs_x = c.x;
+        Real const * const AMREX_RESTRICT coefs_y = c.y;
+        Real const * const AMREX_RESTRICT coefs_z = c.z;
+        int const n_coefs_x = c.nx;
+        int const n_coefs_y = c.ny;
+        int const n_coefs_z = c.nz;
+
+        amrex::ParallelFor(tbx, tby, tbz,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                Bx(i, j, k) += dt * T_Algo::UpwardDz(Ey, coefs_z, n_coefs_z, i, j, k)
+                             - dt * T_Algo::UpwardDy(Ez, coefs_y, n_coefs_y, i, j, k);
+            },
+            [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                By(i, j, k) += dt * T_Algo::UpwardDx(Ez, coefs_x, n_coefs_x, i, j, k)
+                             - dt * T_Algo::UpwardDz(Ex, coefs_z, n_coefs_z, i, j, k);
+            },
+            [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                Bz(i, j, k) += dt * T_Algo::UpwardDy(Ex, coefs_y, n_coefs_y, i, j, k)
+                             - dt * T_Algo::UpwardDx(Ey, coefs_x, n_coefs_x, i, j, k);
+            }
+        );
+    }
+
+    /** Push E by `dt` in vacuum in the boxes `tex`, `tey` and `tez` (one kernel) */
+    template<typename T_Algo>
+    void pushE (Box const& tex, Box const& tey, Box const& tez,
+                Array4<Real> const& Ex, Array4<Real> const& Ey, Array4<Real> const& Ez,
+                Array4<Real> const& Bx, Array4<Real> const& By, Array4<Real> const& Bz,
+                Array4<Real> const& jx, Array4<Real> const& jy, Array4<Real> const& jz,
+                StencilCoefs const& c, Real const dt)
+    {
+        Real constexpr c2 = PhysConst::c * PhysConst::c;
+        Real const * const AMREX_RESTRICT coefs_x = c.x;
+        Real const * const AMREX_RESTRICT coefs_y = c.y;
+        Real const * const AMREX_RESTRICT coefs_z = c.z;
+        int const n_coefs_x = c.nx;
+        int const n_coefs_y = c.ny;
+        int const n_coefs_z = c.nz;
+
+        amrex::ParallelFor(tex, tey, tez,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                Ex(i, j, k) += c2 * dt * (
+                    - T_Algo::DownwardDz(By, coefs_z, n_coefs_z, i, j, k)
+                    + T_Algo::DownwardDy(Bz, coefs_y, n_coefs_y, i, j, k)
+                    - PhysConst::mu0 * jx(i, j, k) );
+            },
+            [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                Ey(i, j, k) += c2 * dt * (
+                    - T_Algo::DownwardDx(Bz, coefs_x, n_coefs_x, i, j, k)
+                    + T_Algo::DownwardDz(Bx, coefs_z, n_coefs_z, i, j, k)
+                    - PhysConst::mu0 * jy(i, j, k) );
+            },
+            [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                Ez(i, j, k) += c2 * dt * (
+                    - T_Algo::DownwardDy(Bx, coefs_y, n_coefs_y, i, j, k)
+                    + T_Algo::DownwardDx(By, coefs_x, n_coefs_x, i, j, k)
+                    - PhysConst::mu0 * jz(i, j, k) );
+            }
+        );
+    }
+
+    /** Restrict a box to the plane `p` along `dir` (empty if `p` is outside the box) */
+    Box plane (Box bx, int const dir, int const p)
+    {
+        if (p < bx.smallEnd(dir) || p > bx.bigEnd(dir)) { return Box(); }
+        bx.setRange(dir, p);
+        return bx;
+    }
+}
+#endif
+
+/**
+ * \brief Advance B by dt/2, E by dt and B by dt/2 in a single sweep over each box
+ */
+void FiniteDifferenceSolver::EvolveBEBBlocked (
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Efield,
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Bfield,
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Jfield,
+    int lev, amrex::Real const dt ) {
+
+#ifdef WARPX_DIM_RZ
+    amrex::ignore_unused(Efield, Bfield, Jfield, lev, dt);
+    WARPX_ABORT_WITH_MESSAGE("EvolveBEBBlocked: not implemented in RZ geometry");
+#else
+    for (int idim = 0; idim < 3; ++idim) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            Efield[idim]->nGrowVect().allGE(BEBBlockedGuardCellsE()) &&
+            Bfield[idim]->nGrowVect().allGE(BEBBlockedGuardCellsB()) &&
+            Jfield[idim]->nGrowVect().allGE(amrex::IntVect(1)),
+            "EvolveBEBBlocked: not enough guard cells for the temporally blocked update");
+    }
+
+    if (m_grid_type == GridType::Collocated) {
+
+        EvolveBEBBlockedCartesian <CartesianNodalAlgorithm> ( Efield, Bfield, Jfield, lev, dt );
+
+    } else if (m_fdtd_algo == ElectromagneticSolverAlgo::Yee) {
+
+        EvolveBEBBlockedCartesian <CartesianYeeAlgorithm> ( Efield, Bfield, Jfield, lev, dt );
+
+    } else if (m_fdtd_algo == ElectromagneticSolverAlgo::CKC) {
+
+        EvolveBEBBlockedCartesian <CartesianCKCAlgorithm> ( Efield, Bfield, Jfield, lev, dt );
+
+    } else {
+        WARPX_ABORT_WITH_MESSAGE("EvolveBEBBlocked: Unknown algorithm");
+    }
+#endif
+}
+
+
+#ifndef WARPX_DIM_RZ
+
+template<typename T_Algo>
+void FiniteDifferenceSolver::EvolveBEBBlockedCartesian (
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Efield,
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Bfield,
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Jfield,
+    int lev, amrex::Real const dt ) {
+
+    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
+    Real const half_dt = 0.5_rt * dt;
+
+    // Planes are swept along the last dimension (contiguous planes in memory)
+    constexpr int dir = AMREX_SPACEDIM - 1;
+
+    // Extract stencil coefficients
+    StencilCoefs const coefs{
+        m_stencil_coefs_x.dataPtr(), m_stencil_coefs_y.dataPtr(), m_stencil_coefs_z.dataPtr(),
+        static_cast<int>(m_stencil_coefs_x.size()), static_cast<int>(m_stencil_coefs_y.size()),
+        static_cast<int>(m_stencil_coefs_z.size())};
+
+    // Loop through the grids: on CPU, each box is swept as a whole by one
+    // thread, so that the few planes of the wavefront stay in cache
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for ( MFIter mfi(*Efield[0], false); mfi.isValid(); ++mfi ) {
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            amrex::Gpu::synchronize();
+        }
+        auto wt = static_cast<amrex::Real>(amrex::second());
+
+        // Extract field data for this grid
+        Array4<Real> const& Ex = Efield[0]->array(mfi);
+        Array4<Real> const& Ey = Efield[1]->array(mfi);
+        Array4<Real> const& Ez = Efield[2]->array(mfi);
+        Array4<Real> const& Bx = Bfield[0]->array(mfi);
+        Array4<Real> const& By = Bfield[1]->array(mfi);
+        Array4<Real> const& Bz = Bfield[2]->array(mfi);
+        Array4<Real> const& jx = Jfield[0]->array(mfi);
+        Array4<Real> const& jy = Jfield[1]->array(mfi);
+        Array4<Real> const& jz = Jfield[2]->array(mfi);
+
+        // The first half push of B is also done in 2 guard cells, and the push
+        // of E in 1 guard cell, so that the second half push of B in the valid
+        // box only reads values that were updated locally
+        Box const cc_box = amrex::enclosedCells(mfi.validbox());
+        std::array<Box,3> b1_box, e_box, b2_box;
+        for (int idim = 0; idim < 3; ++idim) {
+            b2_box[idim] = amrex::convert(cc_box, Bfield[idim]->ixType());
+            b1_box[idim] = amrex::grow(b2_box[idim], 2);
+            e_box[idim] = amrex::grow(amrex::convert(cc_box, Efield[idim]->ixType()), 1);
+        }
+
+        if (amrex::Gpu::inLaunchRegion()) {
+            // On GPU, each of the three updates is a single kernel over the
+            // whole box: the updates depend on each other through the stencils,
+            // so they cannot be done in place in one kernel without a grid-wide
+            // synchronization in between
+            pushB<T_Algo>(b1_box[0], b1_box[1], b1_box[2], Bx, By, Bz, Ex, Ey, Ez, coefs, half_dt);
+            pushE<T_Algo>(e_box[0], e_box[1], e_box[2], Ex, Ey, Ez, Bx, By, Bz, jx, jy, jz, coefs, dt);
+            pushB<T_Algo>(b2_box[0], b2_box[1], b2_box[2], Bx, By, Bz, Ex, Ey, Ez, coefs, half_dt);
+        } else {
+            // On CPU, wavefront along dir: at step s, the first half push of B is
+            // done in plane s, the push of E in plane s-1 and the second half push
+            // of B in plane s-2. Along dir, the stencils only read the neighboring
+            // planes, so each update reads values that are at the right time level.
+            // (the last planes are nodal along dir for the staggered components)
+            int const s_lo = cc_box.smallEnd(dir) - 2;
+            int const s_hi = cc_box.bigEnd(dir) + 3;
+            for (int s = s_lo; s <= s_hi; ++s) {
+                pushB<T_Algo>(plane(b1_box[0], dir, s), plane(b1_box[1], dir, s), plane(b1_box[2], dir, s),
+                              Bx, By, Bz, Ex, Ey, Ez, coefs, half_dt);
+                pushE<T_Algo>(plane(e_box[0], dir, s-1), plane(e_box[1], dir, s-1), plane(e_box[2], dir, s-1),
+                              Ex, Ey, Ez, Bx, By, Bz, jx, jy, jz, coefs, dt);
+                pushB<T_Algo>(plane(b2_box[0], dir, s-2), plane(b2_box[1], dir, s-2), plane(b2_box[2], dir, s-2),
+                              Bx, By, Bz, Ex, Ey, Ez, coefs, half_dt);
+            }
+        }
+
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            amrex::Gpu::synchronize();
+            wt = static_cast<amrex::Real>(amrex::second()) - wt;
+            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+        }
+    }
+}
+
+#endif // corresponds to ifndef WARPX_DIM_RZ
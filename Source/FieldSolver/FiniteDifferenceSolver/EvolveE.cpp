@@ -20,6 +20,8 @@
 
 #include <AMReX.H>
 #include <AMReX_Array4.H>
+#include <AMReX_Box.H>
+#include <AMReX_BoxList.H>
 #include <AMReX_Config.H>
 #include <AMReX_Extension.H>
 #include <AMReX_GpuAtomic.H>
@@ -42,6 +44,29 @@
 
 using namespace amrex;
 
+#ifndef WARPX_DIM_RZ
+namespace
+{
+    /**
+     * \brief Boxes of a tile (of any index type) to update in the given region
+     *
+     * The interior is the part of the tile whose finite-difference stencil,
+     * of half-width stencil_reach, only reads values inside the valid box;
+     * the shell is the rest of the tile.
+     */
+    amrex::BoxList boxesInRegion (amrex::Box const& tbx, amrex::Box const& cc_valid_box,
+                                  FieldUpdateRegion region, amrex::IntVect const& stencil_reach)
+    {
+        const amrex::Box vbx = amrex::convert(cc_valid_box, tbx.ixType());
+        const amrex::Box interior = tbx & amrex::grow(vbx, -stencil_reach);
+        if (region == FieldUpdateRegion::interior) {
+            return interior.ok() ? amrex::BoxList(interior) : amrex::BoxList(tbx.ixType());
+        }
+        return interior.ok() ? amrex::boxDiff(tbx, interior) : amrex::BoxList(tbx);
+    }
+}
+#endif
+
 /**
  * \brief Update the E field, over one timestep
  */
@@ -53,7 +78,8 @@ void FiniteDifferenceSolver::EvolveE (
     std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& face_areas,
     std::array< std::unique_ptr<amrex::MultiFab>, 3 >& ECTRhofield,
     std::unique_ptr<amrex::MultiFab> const& Ffield,
-    int lev, amrex::Real const dt ) {
+    int lev, amrex::Real const dt,
+    FieldUpdateRegion region, amrex::IntVect const& stencil_reach ) {
 
 #ifdef AMREX_USE_EB
     if (m_fdtd_algo != ElectromagneticSolverAlgo::ECT) {
@@ -66,20 +92,26 @@ void FiniteDifferenceSolver::EvolveE (
     // Select algorithm (The choice of algorithm is a runtime option,
     // but we compile code for each algorithm, using templates)
 #ifdef WARPX_DIM_RZ
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(region == FieldUpdateRegion::all,
+        "EvolveE: split interior/shell update is not implemented in RZ geometry");
+    amrex::ignore_unused(stencil_reach);
     if (m_fdtd_algo == ElectromagneticSolverAlgo::Yee){
         EvolveECylindrical <CylindricalYeeAlgorithm> ( Efield, Bfield, Jfield, edge_lengths, Ffield, lev, dt );
 #else
     if (m_grid_type == GridType::Collocated) {
 
-        EvolveECartesian <CartesianNodalAlgorithm> ( Efield, Bfield, Jfield, edge_lengths, Ffield, lev, dt );
+        EvolveECartesian <CartesianNodalAlgorithm> ( Efield, Bfield, Jfield, edge_lengths, Ffield, lev, dt,
+                                                     region, stencil_reach );
 
     } else if (m_fdtd_algo == ElectromagneticSolverAlgo::Yee || m_fdtd_algo == ElectromagneticSolverAlgo::ECT) {
 
-        EvolveECartesian <CartesianYeeAlgorithm> ( Efield, Bfield, Jfield, edge_lengths, Ffield, lev, dt );
+        EvolveECartesian <CartesianYeeAlgorithm> ( Efield, Bfield, Jfield, edge_lengths, Ffield, lev, dt,
+                                                   region, stencil_reach );
 
     } else if (m_fdtd_algo == ElectromagneticSolverAlgo::CKC) {
 
-        EvolveECartesian <CartesianCKCAlgorithm> ( Efield, Bfield, Jfield, edge_lengths, Ffield, lev, dt );
+        EvolveECartesian <CartesianCKCAlgorithm> ( Efield, Bfield, Jfield, edge_lengths, Ffield, lev, dt,
+                                                   region, stencil_reach );
 
 #endif
     } else {
@@ -98,7 +130,8 @@ void FiniteDifferenceSolver::EvolveECartesian (
     std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Jfield,
     std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& edge_lengths,
     std::unique_ptr<amrex::MultiFab> const& Ffield,
-    int lev, amrex::Real const dt ) {
+    int lev, amrex::Real const dt,
+    FieldUpdateRegion region, amrex::IntVect const& stencil_reach ) {
 
 #ifndef AMREX_USE_EB
     amrex::ignore_unused(edge_lengths);
@@ -148,53 +181,68 @@ void FiniteDifferenceSolver::EvolveECartesian (
         Box const& tey  = mfi.tilebox(Efield[1]->ixType().toIntVect());
         Box const& tez  = mfi.tilebox(Efield[2]->ixType().toIntVect());
 
-        // Loop over the cells and update the fields
-        amrex::ParallelFor(tex, tey, tez,
-
-            [=] AMREX_GPU_DEVICE (int i, int j, int k){
+        auto const update_Ex = [=] AMREX_GPU_DEVICE (int i, int j, int k){
 #ifdef AMREX_USE_EB
-                // Skip field push if this cell is fully covered by embedded boundaries
-                if (lx(i, j, k) <= 0) return;
+            // Skip field push if this cell is fully covered by embedded boundaries
+            if (lx(i, j, k) <= 0) return;
 #endif
-                Ex(i, j, k) += c2 * dt * (
-                    - T_Algo::DownwardDz(By, coefs_z, n_coefs_z, i, j, k)
-                    + T_Algo::DownwardDy(Bz, coefs_y, n_coefs_y, i, j, k)
-                    - PhysConst::mu0 * jx(i, j, k) );
-            },
+            Ex(i, j, k) += c2 * dt * (
+                - T_Algo::DownwardDz(By, coefs_z, n_coefs_z, i, j, k)
+                + T_Algo::DownwardDy(Bz, coefs_y, n_coefs_y, i, j, k)
+                - PhysConst::mu0 * jx(i, j, k) );
+        };
 
-            [=] AMREX_GPU_DEVICE (int i, int j, int k){
+        auto const update_Ey = [=] AMREX_GPU_DEVICE (int i, int j, int k){
 #ifdef AMREX_USE_EB
-                // Skip field push if this cell is fully covered by embedded boundaries
+            // Skip field push if this cell is fully covered by embedded boundaries
 #ifdef WARPX_DIM_3D
-                if (ly(i,j,k) <= 0) return;
+            if (ly(i,j,k) <= 0) return;
 #elif defined(WARPX_DIM_XZ)
-                //In XZ Ey is associated with a mesh node, so we need to check if the mesh node is covered
-                amrex::ignore_unused(ly);
-                if (lx(i, j, k)<=0 || lx(i-1, j, k)<=0 || lz(i, j-1, k)<=0 || lz(i, j, k)<=0) return;
+            //In XZ Ey is associated with a mesh node, so we need to check if the mesh node is covered
+            amrex::ignore_unused(ly);
+            if (lx(i, j, k)<=0 || lx(i-1, j, k)<=0 || lz(i, j-1, k)<=0 || lz(i, j, k)<=0) return;
 #endif
 #endif
-                Ey(i, j, k) += c2 * dt * (
-                    - T_Algo::DownwardDx(Bz, coefs_x, n_coefs_x, i, j, k)
-                    + T_Algo::DownwardDz(Bx, coefs_z, n_coefs_z, i, j, k)
-                    - PhysConst::mu0 * jy(i, j, k) );
-            },
+            Ey(i, j, k) += c2 * dt * (
+                - T_Algo::DownwardDx(Bz, coefs_x, n_coefs_x, i, j, k)
+                + T_Algo::DownwardDz(Bx, coefs_z, n_coefs_z, i, j, k)
+                - PhysConst::mu0 * jy(i, j, k) );
+        };
 
-            [=] AMREX_GPU_DEVICE (int i, int j, int k){
+        auto const update_Ez = [=] AMREX_GPU_DEVICE (int i, int j, int k){
 #ifdef AMREX_USE_EB
-                // Skip field push if this cell is fully covered by embedded boundaries
-                if (lz(i,j,k) <= 0) return;
+            // Skip field push if this cell is fully covered by embedded boundaries
+            if (lz(i,j,k) <= 0) return;
 #endif
-                Ez(i, j, k) += c2 * dt * (
-                    - T_Algo::DownwardDy(Bx, coefs_y, n_coefs_y, i, j, k)
-                    + T_Algo::DownwardDx(By, coefs_x, n_coefs_x, i, j, k)
-                    - PhysConst::mu0 * jz(i, j, k) );
-            }
+            Ez(i, j, k) += c2 * dt * (
+                - T_Algo::DownwardDy(Bx, coefs_y, n_coefs_y, i, j, k)
+                + T_Algo::DownwardDx(By, coefs_x, n_coefs_x, i, j, k)
+                - PhysConst::mu0 * jz(i, j, k) );
+        };
 
-        );
+        // Loop over the cells and update the fields
+        if (region == FieldUpdateRegion::all) {
+            amrex::ParallelFor(tex, tey, tez, update_Ex, update_Ey, update_Ez);
+        } else {
+            // Split update: either the cells whose stencil only reads valid B,
+            // which can proceed while the B guard cells are being exchanged,
+            // or the shell of cells next to the faces of the box
+            Box const& vbx = mfi.validbox();
+            for (Box const& bx : boxesInRegion(tex, vbx, region, stencil_reach)) {
+                amrex::ParallelFor(bx, update_Ex);
+            }
+            for (Box const& bx : boxesInRegion(tey, vbx, region, stencil_reach)) {
+                amrex::ParallelFor(bx, update_Ey);
+            }
+            for (Box const& bx : boxesInRegion(tez, vbx, region, stencil_reach)) {
+                amrex::ParallelFor(bx, update_Ez);
+            }
+        }
 
         // If F is not a null pointer, further update E using the grad(F) term
-        // (hyperbolic correction for errors in charge conservation)
-        if (Ffield) {
+        // (hyperbolic correction for errors in charge conservation).
+        // F does not depend on B, so this is done in one pass over the tile.
+        if (Ffield && region != FieldUpdateRegion::shell) {
 
             // Extract field data for this grid/tile
             const Array4<Real> F = Ffield->array(mfi);
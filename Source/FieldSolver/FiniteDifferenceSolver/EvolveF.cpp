@@ -32,6 +32,7 @@
 #include <AMReX_MFIter.H>
 #include <AMReX_MultiFab.H>
 #include <AMReX_REAL.H>
+#include <AMReX_Vector.H>
 
 #include <AMReX_BaseFwd.H>
 
@@ -48,27 +49,28 @@ void FiniteDifferenceSolver::EvolveF (
     std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Efield,
     std::unique_ptr<amrex::MultiFab> const& rhofield,
     int const rhocomp,
-    amrex::Real const dt ) {
+    amrex::Real const dt,
+    amrex::Vector<int> const* active_boxes ) {
 
     // Select algorithm (The choice of algorithm is a runtime option,
     // but we compile code for each algorithm, using templates)
 #ifdef WARPX_DIM_RZ
     if (m_fdtd_algo == ElectromagneticSolverAlgo::Yee){
 
-        EvolveFCylindrical <CylindricalYeeAlgorithm> ( Ffield, Efield, rhofield, rhocomp, dt );
+        EvolveFCylindrical <CylindricalYeeAlgorithm> ( Ffield, Efield, rhofield, rhocomp, dt, active_boxes );
 
 #else
     if (m_grid_type == GridType::Collocated) {
 
-        EvolveFCartesian <CartesianNodalAlgorithm> ( Ffield, Efield, rhofield, rhocomp, dt );
+        EvolveFCartesian <CartesianNodalAlgorithm> ( Ffield, Efield, rhofield, rhocomp, dt, active_boxes );
 
     } else if (m_fdtd_algo == ElectromagneticSolverAlgo::Yee) {
 
-        EvolveFCartesian <CartesianYeeAlgorithm> ( Ffield, Efield, rhofield, rhocomp, dt );
+        EvolveFCartesian <CartesianYeeAlgorithm> ( Ffield, Efield, rhofield, rhocomp, dt, active_boxes );
 
     } else if (m_fdtd_algo == ElectromagneticSolverAlgo::CKC) {
 
-        EvolveFCartesian <CartesianCKCAlgorithm> ( Ffield, Efield, rhofield, rhocomp, dt );
+        EvolveFCartesian <CartesianCKCAlgorithm> ( Ffield, Efield, rhofield, rhocomp, dt, active_boxes );
 
 #endif
     } else {
@@ -86,7 +88,8 @@ void FiniteDifferenceSolver::EvolveFCartesian (
     std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Efield,
     std::unique_ptr<amrex::MultiFab> const& rhofield,
     int const rhocomp,
-    amrex::Real const dt ) {
+    amrex::Real const dt,
+    amrex::Vector<int> const* active_boxes ) {
 
     // Loop through the grids, and over the tiles within each grid
 #ifdef AMREX_USE_OMP
@@ -94,6 +97,9 @@ void FiniteDifferenceSolver::EvolveFCartesian (
 #endif
     for ( MFIter mfi(*Ffield, TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
 
+        // Skip the boxes where the cleaning is not active
+        if (active_boxes && !(*active_boxes)[mfi.index()]) { continue; }
+
         // Extract field data for this grid/tile
         Array4<Real> const& F = Ffield->array(mfi);
         Array4<Real> const& Ex = Efield[0]->array(mfi);
@@ -139,7 +145,8 @@ void FiniteDifferenceSolver::EvolveFCylindrical (
     std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Efield,
     std::unique_ptr<amrex::MultiFab> const& rhofield,
     int const rhocomp,
-    amrex::Real const dt ) {
+    amrex::Real const dt,
+    amrex::Vector<int> const* active_boxes ) {
 
     // Loop through the grids, and over the tiles within each grid
 #ifdef AMREX_USE_OMP
@@ -147,6 +154,9 @@ void FiniteDifferenceSolver::EvolveFCylindrical (
 #endif
     for ( MFIter mfi(*Ffield, TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
 
+        // Skip the boxes where the cleaning is not active
+        if (active_boxes && !(*active_boxes)[mfi.index()]) { continue; }
+
         // Extract field data for this grid/tile
         const Array4<Real> F = Ffield->array(mfi);
         Array4<Real> const& Er = Efield[0]->array(mfi);
@@ -29,6 +29,7 @@
 #include <AMReX_MFIter.H>
 #include <AMReX_MultiFab.H>
 #include <AMReX_REAL.H>
+#include <AMReX_Vector.H>
 
 #include <AMReX_BaseFwd.H>
 
@@ -40,24 +41,25 @@ using namespace amrex;
 void FiniteDifferenceSolver::EvolveG (
     std::unique_ptr<amrex::MultiFab>& Gfield,
     std::array<std::unique_ptr<amrex::MultiFab>,3> const& Bfield,
-    amrex::Real const dt)
+    amrex::Real const dt,
+    amrex::Vector<int> const* active_boxes)
 {
 #ifdef WARPX_DIM_RZ
     // TODO Implement G update equation in RZ geometry
-    amrex::ignore_unused(Gfield, Bfield, dt);
+    amrex::ignore_unused(Gfield, Bfield, dt, active_boxes);
 #else
     // Select algorithm
     if (m_grid_type == GridType::Collocated)
     {
-        EvolveGCartesian<CartesianNodalAlgorithm>(Gfield, Bfield, dt);
+        EvolveGCartesian<CartesianNodalAlgorithm>(Gfield, Bfield, dt, active_boxes);
     }
     else if (m_fdtd_algo == ElectromagneticSolverAlgo::Yee)
     {
-        EvolveGCartesian<CartesianYeeAlgorithm>(Gfield, Bfield, dt);
+        EvolveGCartesian<CartesianYeeAlgorithm>(Gfield, Bfield, dt, active_boxes);
     }
     else if (m_fdtd_algo == ElectromagneticSolverAlgo::CKC)
     {
-        EvolveGCartesian<CartesianCKCAlgorithm>(Gfield, Bfield, dt);
+        EvolveGCartesian<CartesianCKCAlgorithm>(Gfield, Bfield, dt, active_boxes);
     }
     else
     {
@@ -72,7 +74,8 @@ template<typename T_Algo>
 void FiniteDifferenceSolver::EvolveGCartesian (
     std::unique_ptr<amrex::MultiFab>& Gfield,
     std::array<std::unique_ptr<amrex::MultiFab>,3> const& Bfield,
-    amrex::Real const dt)
+    amrex::Real const dt,
+    amrex::Vector<int> const* active_boxes)
 {
 
     amrex::Real constexpr c2 = PhysConst::c * PhysConst::c;
@@ -84,6 +87,9 @@ void FiniteDifferenceSolver::EvolveGCartesian (
     // Loop over grids and over tiles within each grid
     for (amrex::MFIter mfi(*Gfield, TilingIfNotGPU()); mfi.isValid(); ++mfi)
     {
+        // Skip the boxes where the cleaning is not active
+        if (active_boxes && !(*active_boxes)[mfi.index()]) { continue; }
+
         // Extract field data for this grid/tile
         amrex::Array4<amrex::Real> const& G = Gfield->array(mfi);
         amrex::Array4<amrex::Real> const& Bx = Bfield[0]->array(mfi);
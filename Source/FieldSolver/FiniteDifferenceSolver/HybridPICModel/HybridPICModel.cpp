@@ -12,6 +12,10 @@
 #include "FieldSolver/Fields.H"
 #include "WarpX.H"
 
+#include <ablastr/utils/ScratchPool.H>
+
+#include <vector>
+
 using namespace amrex;
 using namespace warpx::fields;
 
@@ -134,6 +138,13 @@ void HybridPICModel::InitData ()
     m_eta = m_resistivity_parser->compile<2>();
     const std::set<std::string> resistivity_symbols = m_resistivity_parser->symbols();
     m_resistivity_has_J_dependence += resistivity_symbols.count("J");
+    // A constant resistivity (the default is 0) is evaluated once here
+    // rather than with the parser at every node of every E-field solve
+    m_resistivity_is_constant = resistivity_symbols.empty();
+    if (m_resistivity_is_constant) {
+        auto const eta_host = m_resistivity_parser->compileHost<2>();
+        m_eta_const = eta_host(0.0_rt, 0.0_rt);
+    }
 
     m_J_external_parser[0] = std::make_unique<amrex::Parser>(
         utils::parser::makeParser(m_Jx_ext_grid_function,{"x","y","z","t"}));
@@ -575,21 +586,23 @@ void HybridPICModel::BfieldEvolveRK (
     // Make copies of the B-field multifabs at t = n and create multifabs for
     // each direction to store the Runge-Kutta intermediate terms. Each
     // multifab has 2 components for the different terms that need to be stored.
-    std::array< MultiFab, 3 > B_old;
-    std::array< MultiFab, 3 > K;
+    // These temporaries are taken from the scratch pool, since they are needed
+    // at every step.
+    std::vector< ablastr::utils::scratch::ScratchMultiFab > B_old;
+    std::vector< ablastr::utils::scratch::ScratchMultiFab > K;
     for (int ii = 0; ii < 3; ii++)
     {
-        B_old[ii] = MultiFab(
+        B_old.emplace_back(
             Bfield[lev][ii]->boxArray(), Bfield[lev][ii]->DistributionMap(), 1,
             Bfield[lev][ii]->nGrowVect()
         );
-        MultiFab::Copy(B_old[ii], *Bfield[lev][ii], 0, 0, 1, ng);
+        MultiFab::Copy(*B_old[ii], *Bfield[lev][ii], 0, 0, 1, ng);
 
-        K[ii] = MultiFab(
+        K.emplace_back(
             Bfield[lev][ii]->boxArray(), Bfield[lev][ii]->DistributionMap(), 2,
             Bfield[lev][ii]->nGrowVect()
         );
-        K[ii].setVal(0.0);
+        K[ii]->setVal(0.0);
     }
 
     // The Runge-Kutta scheme begins here.
@@ -605,7 +618,7 @@ void HybridPICModel::BfieldEvolveRK (
     {
         // Extract 0.5 * dt * K0 for each direction into index 0 of K.
         MultiFab::LinComb(
-            K[ii], 1._rt, *Bfield[lev][ii], 0, -1._rt, B_old[ii], 0, 0, 1, ng
+            *K[ii], 1._rt, *Bfield[lev][ii], 0, -1._rt, *B_old[ii], 0, 0, 1, ng
         );
     }
 
@@ -622,10 +635,10 @@ void HybridPICModel::BfieldEvolveRK (
     {
         // Subtract 0.5 * dt * K0 from the Bfield for each direction, to get
         // B_new = B_old + 0.5 * dt * K1.
-        MultiFab::Subtract(*Bfield[lev][ii], K[ii], 0, 0, 1, ng);
+        MultiFab::Subtract(*Bfield[lev][ii], *K[ii], 0, 0, 1, ng);
         // Extract 0.5 * dt * K1 for each direction into index 1 of K.
         MultiFab::LinComb(
-            K[ii], 1._rt, *Bfield[lev][ii], 0, -1._rt, B_old[ii], 0, 1, 1, ng
+            *K[ii], 1._rt, *Bfield[lev][ii], 0, -1._rt, *B_old[ii], 0, 1, 1, ng
         );
     }
 
@@ -642,7 +655,7 @@ void HybridPICModel::BfieldEvolveRK (
     {
         // Subtract 0.5 * dt * K1 from the Bfield for each direction to get
         // B_new = B_old + dt * K2.
-        MultiFab::Subtract(*Bfield[lev][ii], K[ii], 1, 0, 1, ng);
+        MultiFab::Subtract(*Bfield[lev][ii], *K[ii], 1, 0, 1, ng);
     }
 
     // Step 4:
@@ -658,20 +671,20 @@ void HybridPICModel::BfieldEvolveRK (
     {
         // Subtract B_old from the Bfield for each direction, to get
         // B = dt * K2 + 0.5 * dt * K3.
-        MultiFab::Subtract(*Bfield[lev][ii], B_old[ii], 0, 0, 1, ng);
+        MultiFab::Subtract(*Bfield[lev][ii], *B_old[ii], 0, 0, 1, ng);
 
         // Add dt * K2 + 0.5 * dt * K3 to index 0 of K (= 0.5 * dt * K0).
-        MultiFab::Add(K[ii], *Bfield[lev][ii], 0, 0, 1, ng);
+        MultiFab::Add(*K[ii], *Bfield[lev][ii], 0, 0, 1, ng);
 
         // Add 2 * 0.5 * dt * K1 to index 0 of K.
         MultiFab::LinComb(
-            K[ii], 1.0, K[ii], 0, 2.0, K[ii], 1, 0, 1, ng
+            *K[ii], 1.0, *K[ii], 0, 2.0, *K[ii], 1, 0, 1, ng
         );
 
         // Overwrite the Bfield with the Runge-Kutta sum:
         // B_new = B_old + 1/3 * dt * (0.5 * K0 + K1 + K2 + 0.5 * K3).
         MultiFab::LinComb(
-            *Bfield[lev][ii], 1.0, B_old[ii], 0, 1.0/3.0, K[ii], 0, 0, 1, ng
+            *Bfield[lev][ii], 1.0, *B_old[ii], 0, 1.0/3.0, *K[ii], 0, 0, 1, ng
         );
     }
 }
@@ -691,7 +704,11 @@ void HybridPICModel::FieldPush (
     CalculateCurrentAmpere(Bfield, edge_lengths);
     // Calculate the E-field from Ohm's law
     HybridPICSolveE(Efield, Jfield, Bfield, rhofield, edge_lengths, true);
-    warpx.FillBoundaryE(ng, nodal_sync);
+    // The Yee update of B in the valid cells only reads E in the valid cells,
+    // so the guard cells of E are not needed between the RK stages. They are
+    // filled once, after the E-field is recomputed at the end of the step.
+    // The exchange is still needed with PML, to copy E into the PML region.
+    if (warpx.DoPML()) { warpx.FillBoundaryE(ng, nodal_sync); }
     // Push forward the B-field using Faraday's law
     warpx.EvolveB(dt, dt_type);
     warpx.FillBoundaryB(ng, nodal_sync);
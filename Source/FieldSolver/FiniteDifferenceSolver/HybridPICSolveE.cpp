@@ -438,6 +438,13 @@ void FiniteDifferenceSolver::HybridPICSolveECylindrical (
 
     const bool include_hyper_resistivity_term = (eta_h > 0.0) && include_resistivity_term;
 
+    // A constant resistivity is evaluated once instead of with the parser at
+    // every node, and a zero resistivity skips the term entirely
+    const auto resistivity_is_constant = hybrid_model->m_resistivity_is_constant;
+    const auto eta_const = hybrid_model->m_eta_const;
+    const bool include_eta_term = include_resistivity_term &&
+        !(resistivity_is_constant && eta_const == 0._rt);
+
     // Index type required for interpolating fields from their respective
     // staggering to the Ex, Ey, Ez locations
     amrex::GpuArray<int, 3> const& Er_stag = hybrid_model->Ex_IndexType;
@@ -595,7 +602,7 @@ void FiniteDifferenceSolver::HybridPICSolveECylindrical (
 
                 // Interpolate current to appropriate staggering to match E field
                 Real jtot_val = 0._rt;
-                if (include_resistivity_term && resistivity_has_J_dependence) {
+                if (include_eta_term && resistivity_has_J_dependence) {
                     const Real jr_val = Interp(Jr, Jr_stag, Er_stag, coarsen, i, j, 0, 0);
                     const Real jt_val = Interp(Jt, Jt_stag, Er_stag, coarsen, i, j, 0, 0);
                     const Real jz_val = Interp(Jz, Jz_stag, Er_stag, coarsen, i, j, 0, 0);
@@ -614,7 +621,9 @@ void FiniteDifferenceSolver::HybridPICSolveECylindrical (
                 Er(i, j, 0) = (enE_r - grad_Pe) / rho_val;
 
                 // Add resistivity only if E field value is used to update B
-                if (include_resistivity_term) { Er(i, j, 0) += eta(rho_val, jtot_val) * Jr(i, j, 0); }
+                if (include_eta_term) {
+                    Er(i, j, 0) += (resistivity_is_constant ? eta_const : eta(rho_val, jtot_val)) * Jr(i, j, 0);
+                }
 
                 if (include_hyper_resistivity_term) {
                     // r on cell-centered point (Jr is cell-centered in r)
@@ -645,7 +654,7 @@ void FiniteDifferenceSolver::HybridPICSolveECylindrical (
 
                 // Interpolate current to appropriate staggering to match E field
                 Real jtot_val = 0._rt;
-                if (include_resistivity_term && resistivity_has_J_dependence) {
+                if (include_eta_term && resistivity_has_J_dependence) {
                     const Real jr_val = Interp(Jr, Jr_stag, Et_stag, coarsen, i, j, 0, 0);
                     const Real jt_val = Interp(Jt, Jt_stag, Et_stag, coarsen, i, j, 0, 0);
                     const Real jz_val = Interp(Jz, Jz_stag, Et_stag, coarsen, i, j, 0, 0);
@@ -665,7 +674,9 @@ void FiniteDifferenceSolver::HybridPICSolveECylindrical (
                 Et(i, j, 0) = (enE_t - grad_Pe) / rho_val;
 
                 // Add resistivity only if E field value is used to update B
-                if (include_resistivity_term) { Et(i, j, 0) += eta(rho_val, jtot_val) * Jt(i, j, 0); }
+                if (include_eta_term) {
+                    Et(i, j, 0) += (resistivity_is_constant ? eta_const : eta(rho_val, jtot_val)) * Jt(i, j, 0);
+                }
 
                 // Note: Hyper-resisitivity should be revisited here when modal decomposition is implemented
             },
@@ -681,7 +692,7 @@ void FiniteDifferenceSolver::HybridPICSolveECylindrical (
 
                 // Interpolate current to appropriate staggering to match E field
                 Real jtot_val = 0._rt;
-                if (include_resistivity_term && resistivity_has_J_dependence) {
+                if (include_eta_term && resistivity_has_J_dependence) {
                     const Real jr_val = Interp(Jr, Jr_stag, Ez_stag, coarsen, i, j, 0, 0);
                     const Real jt_val = Interp(Jt, Jt_stag, Ez_stag, coarsen, i, j, 0, 0);
                     const Real jz_val = Interp(Jz, Jz_stag, Ez_stag, coarsen, i, j, 0, 0);
@@ -700,7 +711,9 @@ void FiniteDifferenceSolver::HybridPICSolveECylindrical (
                 Ez(i, j, 0) = (enE_z - grad_Pe) / rho_val;
 
                 // Add resistivity only if E field value is used to update B
-                if (include_resistivity_term) { Ez(i, j, 0) += eta(rho_val, jtot_val) * Jz(i, j, 0); }
+                if (include_eta_term) {
+                    Ez(i, j, 0) += (resistivity_is_constant ? eta_const : eta(rho_val, jtot_val)) * Jz(i, j, 0);
+                }
 
                 if (include_hyper_resistivity_term) {
                     auto nabla2Jz = T_Algo::Dzz(Jz, coefs_z, n_coefs_z, i, j, 0, 0);
@@ -750,6 +763,13 @@ void FiniteDifferenceSolver::HybridPICSolveECartesian (
 
     const bool include_hyper_resistivity_term = (eta_h > 0.) && include_resistivity_term;
 
+    // A constant resistivity is evaluated once instead of with the parser at
+    // every node, and a zero resistivity skips the term entirely
+    const auto resistivity_is_constant = hybrid_model->m_resistivity_is_constant;
+    const auto eta_const = hybrid_model->m_eta_const;
+    const bool include_eta_term = include_resistivity_term &&
+        !(resistivity_is_constant && eta_const == 0._rt);
+
     // Index type required for interpolating fields from their respective
     // staggering to the Ex, Ey, Ez locations
     amrex::GpuArray<int, 3> const& Ex_stag = hybrid_model->Ex_IndexType;
@@ -905,7 +925,7 @@ void FiniteDifferenceSolver::HybridPICSolveECartesian (
 
                 // Interpolate current to appropriate staggering to match E field
                 Real jtot_val = 0._rt;
-                if (include_resistivity_term && resistivity_has_J_dependence) {
+                if (include_eta_term && resistivity_has_J_dependence) {
                     const Real jx_val = Interp(Jx, Jx_stag, Ex_stag, coarsen, i, j, k, 0);
                     const Real jy_val = Interp(Jy, Jy_stag, Ex_stag, coarsen, i, j, k, 0);
                     const Real jz_val = Interp(Jz, Jz_stag, Ex_stag, coarsen, i, j, k, 0);
@@ -924,7 +944,9 @@ void FiniteDifferenceSolver::HybridPICSolveECartesian (
                 Ex(i, j, k) = (enE_x - grad_Pe) / rho_val;
 
                 // Add resistivity only if E field value is used to update B
-                if (include_resistivity_term) { Ex(i, j, k) += eta(rho_val, jtot_val) * Jx(i, j, k); }
+                if (include_eta_term) {
+                    Ex(i, j, k) += (resistivity_is_constant ? eta_const : eta(rho_val, jtot_val)) * Jx(i, j, k);
+                }
 
                 if (include_hyper_resistivity_term) {
                     auto nabla2Jx = T_Algo::Dxx(Jx, coefs_x, n_coefs_x, i, j, k);
@@ -949,7 +971,7 @@ void FiniteDifferenceSolver::HybridPICSolveECartesian (
 
                 // Interpolate current to appropriate staggering to match E field
                 Real jtot_val = 0._rt;
-                if (include_resistivity_term && resistivity_has_J_dependence) {
+                if (include_eta_term && resistivity_has_J_dependence) {
                     const Real jx_val = Interp(Jx, Jx_stag, Ey_stag, coarsen, i, j, k, 0);
                     const Real jy_val = Interp(Jy, Jy_stag, Ey_stag, coarsen, i, j, k, 0);
                     const Real jz_val = Interp(Jz, Jz_stag, Ey_stag, coarsen, i, j, k, 0);
@@ -968,7 +990,9 @@ void FiniteDifferenceSolver::HybridPICSolveECartesian (
                 Ey(i, j, k) = (enE_y - grad_Pe) / rho_val;
 
                 // Add resistivity only if E field value is used to update B
-                if (include_resistivity_term) { Ey(i, j, k) += eta(rho_val, jtot_val) * Jy(i, j, k); }
+                if (include_eta_term) {
+                    Ey(i, j, k) += (resistivity_is_constant ? eta_const : eta(rho_val, jtot_val)) * Jy(i, j, k);
+                }
 
                 if (include_hyper_resistivity_term) {
                     auto nabla2Jy = T_Algo::Dyy(Jy, coefs_y, n_coefs_y, i, j, k);
@@ -987,7 +1011,7 @@ void FiniteDifferenceSolver::HybridPICSolveECartesian (
 
                 // Interpolate current to appropriate staggering to match E field
                 Real jtot_val = 0._rt;
-                if (include_resistivity_term && resistivity_has_J_dependence) {
+                if (include_eta_term && resistivity_has_J_dependence) {
                     const Real jx_val = Interp(Jx, Jx_stag, Ez_stag, coarsen, i, j, k, 0);
                     const Real jy_val = Interp(Jy, Jy_stag, Ez_stag, coarsen, i, j, k, 0);
                     const Real jz_val = Interp(Jz, Jz_stag, Ez_stag, coarsen, i, j, k, 0);
@@ -1006,7 +1030,9 @@ void FiniteDifferenceSolver::HybridPICSolveECartesian (
                 Ez(i, j, k) = (enE_z - grad_Pe) / rho_val;
 
                 // Add resistivity only if E field value is used to update B
-                if (include_resistivity_term) { Ez(i, j, k) += eta(rho_val, jtot_val) * Jz(i, j, k); }
+                if (include_eta_term) {
+                    Ez(i, j, k) += (resistivity_is_constant ? eta_const : eta(rho_val, jtot_val)) * Jz(i, j, k);
+                }
 
                 if (include_hyper_resistivity_term) {
                     auto nabla2Jz = T_Algo::Dzz(Jz, coefs_z, n_coefs_z, i, j, k);
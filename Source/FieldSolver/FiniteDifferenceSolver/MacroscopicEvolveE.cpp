@@ -96,81 +96,141 @@ void FiniteDifferenceSolver::MacroscopicEvolveE (
 
 #ifndef WARPX_DIM_RZ
 
-template<typename T_Algo, typename T_MacroAlgo>
-void FiniteDifferenceSolver::MacroscopicEvolveECartesian (
-    std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Efield,
-    std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Bfield,
-    std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Jfield,
-    std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& edge_lengths,
-    amrex::Real const dt,
-    std::unique_ptr<MacroscopicProperties> const& macroscopic_properties)
+namespace
 {
-#ifndef AMREX_USE_EB
-    amrex::ignore_unused(edge_lengths);
-#endif
-
-    amrex::MultiFab& sigma_mf = macroscopic_properties->getsigma_mf();
-    amrex::MultiFab& epsilon_mf = macroscopic_properties->getepsilon_mf();
-    amrex::MultiFab& mu_mf = macroscopic_properties->getmu_mf();
-
-    // Index type required for calling ablastr::coarsen::sample::Interp to interpolate macroscopic
-    // properties from their respective staggering to the Ex, Ey, Ez locations
-    amrex::GpuArray<int, 3> const& sigma_stag = macroscopic_properties->sigma_IndexType;
-    amrex::GpuArray<int, 3> const& epsilon_stag = macroscopic_properties->epsilon_IndexType;
-    amrex::GpuArray<int, 3> const& macro_cr     = macroscopic_properties->macro_cr_ratio;
-    amrex::GpuArray<int, 3> const& Ex_stag = macroscopic_properties->Ex_IndexType;
-    amrex::GpuArray<int, 3> const& Ey_stag = macroscopic_properties->Ey_IndexType;
-    amrex::GpuArray<int, 3> const& Ez_stag = macroscopic_properties->Ez_IndexType;
+    /** Interpolate a cell-centered property stored on the grid to the location
+     *  of a component of E, of staggering `sc` */
+    AMREX_GPU_DEVICE AMREX_FORCE_INLINE
+    amrex::Real interpProperty (amrex::Array4<amrex::Real const> const& prop,
+                                amrex::GpuArray<int, 3> const& sf,
+                                amrex::GpuArray<int, 3> const& sc,
+                                amrex::GpuArray<int, 3> const& cr,
+                                int const i, int const j, int const k)
+    {
+        return ablastr::coarsen::sample::Interp(prop, sf, sc, cr, i, j, k, 0);
+    }
 
-    // Loop through the grids, and over the tiles within each grid
-#ifdef AMREX_USE_OMP
-#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
-#endif
-    for ( MFIter mfi(*Efield[0], TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
+    /** Interpolate a property of piecewise-constant materials to the location
+     *  of a component of E, of staggering `sc`: same average over the
+     *  neighboring cells as ablastr::coarsen::sample::Interp, for cell-centered
+     *  material IDs without coarsening */
+    AMREX_GPU_DEVICE AMREX_FORCE_INLINE
+    amrex::Real interpProperty (MaterialPropertyAccessor const& prop,
+                                amrex::GpuArray<int, 3> const& /*sf*/,
+                                amrex::GpuArray<int, 3> const& sc,
+                                amrex::GpuArray<int, 3> const& /*cr*/,
+                                int const i, int const j, int const k)
+    {
+        amrex::Real const wx = 1.0_rt / static_cast<amrex::Real>(1 + sc[0]);
+        amrex::Real const wy = 1.0_rt / static_cast<amrex::Real>(1 + sc[1]);
+        amrex::Real const wz = 1.0_rt / static_cast<amrex::Real>(1 + sc[2]);
+        amrex::Real c = 0.0_rt;
+        for         (int kk = k - sc[2]; kk <= k; ++kk) {
+            for     (int jj = j - sc[1]; jj <= j; ++jj) {
+                for (int ii = i - sc[0]; ii <= i; ++ii) {
+                    c += wx*wy*wz*prop(ii, jj, kk);
+                }
+            }
+        }
+        return c;
+    }
 
-        // Extract field data for this grid/tile
-        Array4<Real> const& Ex = Efield[0]->array(mfi);
-        Array4<Real> const& Ey = Efield[1]->array(mfi);
-        Array4<Real> const& Ez = Efield[2]->array(mfi);
-        Array4<Real> const& Bx = Bfield[0]->array(mfi);
-        Array4<Real> const& By = Bfield[1]->array(mfi);
-        Array4<Real> const& Bz = Bfield[2]->array(mfi);
-        Array4<Real> const& jx = Jfield[0]->array(mfi);
-        Array4<Real> const& jy = Jfield[1]->array(mfi);
-        Array4<Real> const& jz = Jfield[2]->array(mfi);
+    /** Coefficients alpha and beta of the E update, computed from sigma and
+     *  epsilon at the location of E */
+    template <typename T_MacroAlgo, typename T_Prop>
+    struct CoefsFromProperties
+    {
+        T_Prop m_sigma;
+        T_Prop m_epsilon;
+        amrex::GpuArray<int, 3> m_sigma_stag;
+        amrex::GpuArray<int, 3> m_epsilon_stag;
+        amrex::GpuArray<int, 3> m_cr;
+        amrex::Real m_dt;
+
+        AMREX_GPU_DEVICE AMREX_FORCE_INLINE
+        void operator() (int const /*idim*/, amrex::GpuArray<int, 3> const& E_stag,
+                         int const i, int const j, int const k,
+                         amrex::Real& alpha, amrex::Real& beta) const
+        {
+            amrex::Real const sigma_interp = interpProperty(m_sigma, m_sigma_stag, E_stag, m_cr, i, j, k);
+            amrex::Real const epsilon_interp = interpProperty(m_epsilon, m_epsilon_stag, E_stag, m_cr, i, j, k);
+            alpha = T_MacroAlgo::alpha(sigma_interp, epsilon_interp, m_dt);
+            beta = T_MacroAlgo::beta(sigma_interp, epsilon_interp, m_dt);
+        }
+    };
+
+    /** Coefficients alpha and beta of the E update, read from the precomputed MultiFabs */
+    struct CoefsPrecomputed
+    {
+        amrex::GpuArray<amrex::Array4<amrex::Real const>, 3> m_coefs;
+
+        AMREX_GPU_DEVICE AMREX_FORCE_INLINE
+        void operator() (int const idim, amrex::GpuArray<int, 3> const& /*E_stag*/,
+                         int const i, int const j, int const k,
+                         amrex::Real& alpha, amrex::Real& beta) const
+        {
+            alpha = m_coefs[idim](i, j, k, 0);
+            beta = m_coefs[idim](i, j, k, 1);
+        }
+    };
+
+    /** Compute the coefficients alpha and beta of the E update in the box `bx` */
+    template <typename T_MacroAlgo, typename T_Prop>
+    void computeCoefficients (amrex::Box const& bx, amrex::Array4<amrex::Real> const& coefs,
+                              CoefsFromProperties<T_MacroAlgo, T_Prop> const& get_coefs,
+                              int const idim, amrex::GpuArray<int, 3> const& E_stag)
+    {
+        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k){
+            get_coefs(idim, E_stag, i, j, k, coefs(i, j, k, 0), coefs(i, j, k, 1));
+        });
+    }
 
+    /** Fields, current and edge lengths of a tile, for the macroscopic E update */
+    struct MacroscopicTileArrays
+    {
+        amrex::Array4<amrex::Real> Ex, Ey, Ez;
+        amrex::Array4<amrex::Real const> Bx, By, Bz;
+        amrex::Array4<amrex::Real const> jx, jy, jz;
+        amrex::Array4<amrex::Real const> lx, ly, lz;
+    };
+
+    /**
+     * \brief Update E in a tile of a macroscopic medium
+     *
+     * \tparam T_Algo finite-difference algorithm
+     * \tparam T_Coefs functor returning the coefficients alpha and beta at the location of E
+     * \tparam T_Mu accessor to the (cell-centered) permeability
+     */
+    template <typename T_Algo, typename T_Coefs, typename T_Mu>
+    void macroscopicEvolveETile (
+        amrex::Box const& tex, amrex::Box const& tey, amrex::Box const& tez,
+        MacroscopicTileArrays const& a, T_Coefs const& get_coefs, T_Mu const& mu,
+        amrex::GpuArray<int, 3> const& Ex_stag,
+        amrex::GpuArray<int, 3> const& Ey_stag,
+        amrex::GpuArray<int, 3> const& Ez_stag,
+        amrex::Real const * const AMREX_RESTRICT coefs_x, int const n_coefs_x,
+        amrex::Real const * const AMREX_RESTRICT coefs_y, int const n_coefs_y,
+        amrex::Real const * const AMREX_RESTRICT coefs_z, int const n_coefs_z)
+    {
+        Array4<Real> const& Ex = a.Ex;
+        Array4<Real> const& Ey = a.Ey;
+        Array4<Real> const& Ez = a.Ez;
+        Array4<Real const> const& jx = a.jx;
+        Array4<Real const> const& jy = a.jy;
+        Array4<Real const> const& jz = a.jz;
 #ifdef AMREX_USE_EB
-        amrex::Array4<amrex::Real> const& lx = edge_lengths[0]->array(mfi);
-        amrex::Array4<amrex::Real> const& ly = edge_lengths[1]->array(mfi);
-        amrex::Array4<amrex::Real> const& lz = edge_lengths[2]->array(mfi);
+        Array4<Real const> const& lx = a.lx;
+        Array4<Real const> const& ly = a.ly;
+        Array4<Real const> const& lz = a.lz;
 #endif
 
-        // material prop //
-        amrex::Array4<amrex::Real> const& sigma_arr = sigma_mf.array(mfi);
-        amrex::Array4<amrex::Real> const& eps_arr = epsilon_mf.array(mfi);
-        amrex::Array4<amrex::Real> const& mu_arr = mu_mf.array(mfi);
-
-        // Extract stencil coefficients
-        Real const * const AMREX_RESTRICT coefs_x = m_stencil_coefs_x.dataPtr();
-        auto const n_coefs_x = static_cast<int>(m_stencil_coefs_x.size());
-        Real const * const AMREX_RESTRICT coefs_y = m_stencil_coefs_y.dataPtr();
-        auto const n_coefs_y = static_cast<int>(m_stencil_coefs_y.size());
-        Real const * const AMREX_RESTRICT coefs_z = m_stencil_coefs_z.dataPtr();
-        auto const n_coefs_z = static_cast<int>(m_stencil_coefs_z.size());
-
         // This functor computes Hx = Bx/mu
         // Note that mu is cell-centered here and will be interpolated/averaged
         // to the location where the B-field and H-field are defined
-        FieldAccessorMacroscopic const Hx(Bx, mu_arr);
-        FieldAccessorMacroscopic const Hy(By, mu_arr);
-        FieldAccessorMacroscopic const Hz(Bz, mu_arr);
+        FieldAccessorMacroscopic<T_Mu> const Hx(a.Bx, mu);
+        FieldAccessorMacroscopic<T_Mu> const Hy(a.By, mu);
+        FieldAccessorMacroscopic<T_Mu> const Hz(a.Bz, mu);
 
-        // Extract tileboxes for which to loop
-        Box const& tex  = mfi.tilebox(Efield[0]->ixType().toIntVect());
-        Box const& tey  = mfi.tilebox(Efield[1]->ixType().toIntVect());
-        Box const& tez  = mfi.tilebox(Efield[2]->ixType().toIntVect());
-        // starting component to interpolate macro properties to Ex, Ey, Ez locations
-        const int scomp = 0;
         // Loop over the cells and update the fields
         amrex::ParallelFor(tex, tey, tez,
             [=] AMREX_GPU_DEVICE (int i, int j, int k){
@@ -178,14 +238,9 @@ void FiniteDifferenceSolver::MacroscopicEvolveECartesian (
                 // Skip field push if this cell is fully covered by embedded boundaries
                 if (lx(i, j, k) <= 0) return;
 #endif
-                // Interpolate conductivity, sigma, to Ex position on the grid
-                amrex::Real const sigma_interp = ablastr::coarsen::sample::Interp(sigma_arr, sigma_stag,
-                                                                                  Ex_stag, macro_cr, i, j, k, scomp);
-                // Interpolated permittivity, epsilon, to Ex position on the grid
-                amrex::Real const epsilon_interp = ablastr::coarsen::sample::Interp(eps_arr, epsilon_stag,
-                                                                                    Ex_stag, macro_cr, i, j, k, scomp);
-                const amrex::Real alpha = T_MacroAlgo::alpha( sigma_interp, epsilon_interp, dt);
-                const amrex::Real beta = T_MacroAlgo::beta( sigma_interp, epsilon_interp, dt);
+                // Coefficients at the Ex position on the grid
+                amrex::Real alpha, beta;
+                get_coefs(0, Ex_stag, i, j, k, alpha, beta);
                 Ex(i, j, k) = alpha * Ex(i, j, k)
                             + beta * ( - T_Algo::DownwardDz(Hy, coefs_z, n_coefs_z, i, j, k,0)
                                        + T_Algo::DownwardDy(Hz, coefs_y, n_coefs_y, i, j, k,0)
@@ -202,14 +257,9 @@ void FiniteDifferenceSolver::MacroscopicEvolveECartesian (
                 if (lx(i, j, k)<=0 || lx(i-1, j, k)<=0 || lz(i, j, k)<=0 || lz(i, j-1, k)<=0) return;
 #endif
 #endif
-                // Interpolate conductivity, sigma, to Ey position on the grid
-                amrex::Real const sigma_interp = ablastr::coarsen::sample::Interp(sigma_arr, sigma_stag,
-                                                                                  Ey_stag, macro_cr, i, j, k, scomp);
-                // Interpolated permittivity, epsilon, to Ey position on the grid
-                amrex::Real const epsilon_interp = ablastr::coarsen::sample::Interp(eps_arr, epsilon_stag,
-                                                                                    Ey_stag, macro_cr, i, j, k, scomp);
-                const amrex::Real alpha = T_MacroAlgo::alpha( sigma_interp, epsilon_interp, dt);
-                const amrex::Real beta = T_MacroAlgo::beta( sigma_interp, epsilon_interp, dt);
+                // Coefficients at the Ey position on the grid
+                amrex::Real alpha, beta;
+                get_coefs(1, Ey_stag, i, j, k, alpha, beta);
 
                 Ey(i, j, k) = alpha * Ey(i, j, k)
                             + beta * ( - T_Algo::DownwardDx(Hz, coefs_x, n_coefs_x, i, j, k,0)
@@ -222,14 +272,9 @@ void FiniteDifferenceSolver::MacroscopicEvolveECartesian (
                 // Skip field push if this cell is fully covered by embedded boundaries
                 if (lz(i,j,k) <= 0) return;
 #endif
-                // Interpolate conductivity, sigma, to Ez position on the grid
-                amrex::Real const sigma_interp = ablastr::coarsen::sample::Interp(sigma_arr, sigma_stag,
-                                                                                  Ez_stag, macro_cr, i, j, k, scomp);
-                // Interpolated permittivity, epsilon, to Ez position on the grid
-                amrex::Real const epsilon_interp = ablastr::coarsen::sample::Interp(eps_arr, epsilon_stag,
-                                                                                    Ez_stag, macro_cr, i, j, k, scomp);
-                const amrex::Real alpha = T_MacroAlgo::alpha( sigma_interp, epsilon_interp, dt);
-                const amrex::Real beta = T_MacroAlgo::beta( sigma_interp, epsilon_interp, dt);
+                // Coefficients at the Ez position on the grid
+                amrex::Real alpha, beta;
+                get_coefs(2, Ez_stag, i, j, k, alpha, beta);
 
                 Ez(i, j, k) = alpha * Ez(i, j, k)
                             + beta * ( - T_Algo::DownwardDy(Hx, coefs_y, n_coefs_y, i, j, k,0)
@@ -240,4 +285,140 @@ void FiniteDifferenceSolver::MacroscopicEvolveECartesian (
     }
 }
 
+template<typename T_Algo, typename T_MacroAlgo>
+void FiniteDifferenceSolver::MacroscopicEvolveECartesian (
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Efield,
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Bfield,
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Jfield,
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& edge_lengths,
+    amrex::Real const dt,
+    std::unique_ptr<MacroscopicProperties> const& macroscopic_properties)
+{
+#ifndef AMREX_USE_EB
+    amrex::ignore_unused(edge_lengths);
+#endif
+
+    bool const use_materials = macroscopic_properties->usesMaterials();
+    bool const precomputed = macroscopic_properties->precomputeCoefficients();
+
+    // Index type required for calling ablastr::coarsen::sample::Interp to interpolate macroscopic
+    // properties from their respective staggering to the Ex, Ey, Ez locations
+    amrex::GpuArray<int, 3> const& sigma_stag = macroscopic_properties->sigma_IndexType;
+    amrex::GpuArray<int, 3> const& epsilon_stag = macroscopic_properties->epsilon_IndexType;
+    amrex::GpuArray<int, 3> const& macro_cr     = macroscopic_properties->macro_cr_ratio;
+    amrex::GpuArray<int, 3> const& Ex_stag = macroscopic_properties->Ex_IndexType;
+    amrex::GpuArray<int, 3> const& Ey_stag = macroscopic_properties->Ey_IndexType;
+    amrex::GpuArray<int, 3> const& Ez_stag = macroscopic_properties->Ez_IndexType;
+    std::array<amrex::GpuArray<int, 3>, 3> const E_stag = {{Ex_stag, Ey_stag, Ez_stag}};
+
+    // Precomputed coefficients: only computed again when the timestep changes
+    // (the properties of the medium do not change during the simulation)
+    if (precomputed && macroscopic_properties->coefficientsNeedUpdate(dt)) {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+        for ( MFIter mfi(*Efield[0], TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
+            for (int idim = 0; idim < 3; ++idim) {
+                amrex::MultiFab& coefs_mf = macroscopic_properties->getcoefs_mf(idim);
+                Box const& tb = mfi.tilebox(coefs_mf.ixType().toIntVect());
+                Array4<Real> const& coefs = coefs_mf.array(mfi);
+                if (use_materials) {
+                    auto const& id_arr = macroscopic_properties->getmaterial_id_mf().const_array(mfi);
+                    CoefsFromProperties<T_MacroAlgo, MaterialPropertyAccessor> const get_coefs{
+                        MaterialPropertyAccessor{id_arr, macroscopic_properties->getsigma_table()},
+                        MaterialPropertyAccessor{id_arr, macroscopic_properties->getepsilon_table()},
+                        sigma_stag, epsilon_stag, macro_cr, dt};
+                    computeCoefficients(tb, coefs, get_coefs, idim, E_stag[idim]);
+                } else {
+                    CoefsFromProperties<T_MacroAlgo, amrex::Array4<amrex::Real const>> const get_coefs{
+                        macroscopic_properties->getsigma_mf().const_array(mfi),
+                        macroscopic_properties->getepsilon_mf().const_array(mfi),
+                        sigma_stag, epsilon_stag, macro_cr, dt};
+                    computeCoefficients(tb, coefs, get_coefs, idim, E_stag[idim]);
+                }
+            }
+        }
+        macroscopic_properties->setCoefficientsTimestep(dt);
+    }
+
+    // Loop through the grids, and over the tiles within each grid
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for ( MFIter mfi(*Efield[0], TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
+
+        // Extract field data for this grid/tile
+        MacroscopicTileArrays a;
+        a.Ex = Efield[0]->array(mfi);
+        a.Ey = Efield[1]->array(mfi);
+        a.Ez = Efield[2]->array(mfi);
+        a.Bx = Bfield[0]->const_array(mfi);
+        a.By = Bfield[1]->const_array(mfi);
+        a.Bz = Bfield[2]->const_array(mfi);
+        a.jx = Jfield[0]->const_array(mfi);
+        a.jy = Jfield[1]->const_array(mfi);
+        a.jz = Jfield[2]->const_array(mfi);
+
+#ifdef AMREX_USE_EB
+        a.lx = edge_lengths[0]->const_array(mfi);
+        a.ly = edge_lengths[1]->const_array(mfi);
+        a.lz = edge_lengths[2]->const_array(mfi);
+#endif
+
+        // Extract stencil coefficients
+        Real const * const AMREX_RESTRICT coefs_x = m_stencil_coefs_x.dataPtr();
+        auto const n_coefs_x = static_cast<int>(m_stencil_coefs_x.size());
+        Real const * const AMREX_RESTRICT coefs_y = m_stencil_coefs_y.dataPtr();
+        auto const n_coefs_y = static_cast<int>(m_stencil_coefs_y.size());
+        Real const * const AMREX_RESTRICT coefs_z = m_stencil_coefs_z.dataPtr();
+        auto const n_coefs_z = static_cast<int>(m_stencil_coefs_z.size());
+
+        // Extract tileboxes for which to loop
+        Box const& tex  = mfi.tilebox(Efield[0]->ixType().toIntVect());
+        Box const& tey  = mfi.tilebox(Efield[1]->ixType().toIntVect());
+        Box const& tez  = mfi.tilebox(Efield[2]->ixType().toIntVect());
+
+        // The coefficients are either read from the precomputed MultiFabs, or
+        // computed from the material properties (stored on the grid, or as a
+        // material ID per cell with a table per material). mu is always read
+        // from the material properties.
+        if (use_materials) {
+            auto const& id_arr = macroscopic_properties->getmaterial_id_mf().const_array(mfi);
+            MaterialPropertyAccessor const mu{id_arr, macroscopic_properties->getmu_table()};
+            if (precomputed) {
+                CoefsPrecomputed const get_coefs{{
+                    macroscopic_properties->getcoefs_mf(0).const_array(mfi),
+                    macroscopic_properties->getcoefs_mf(1).const_array(mfi),
+                    macroscopic_properties->getcoefs_mf(2).const_array(mfi)}};
+                macroscopicEvolveETile<T_Algo>(tex, tey, tez, a, get_coefs, mu, Ex_stag, Ey_stag, Ez_stag,
+                    coefs_x, n_coefs_x, coefs_y, n_coefs_y, coefs_z, n_coefs_z);
+            } else {
+                CoefsFromProperties<T_MacroAlgo, MaterialPropertyAccessor> const get_coefs{
+                    MaterialPropertyAccessor{id_arr, macroscopic_properties->getsigma_table()},
+                    MaterialPropertyAccessor{id_arr, macroscopic_properties->getepsilon_table()},
+                    sigma_stag, epsilon_stag, macro_cr, dt};
+                macroscopicEvolveETile<T_Algo>(tex, tey, tez, a, get_coefs, mu, Ex_stag, Ey_stag, Ez_stag,
+                    coefs_x, n_coefs_x, coefs_y, n_coefs_y, coefs_z, n_coefs_z);
+            }
+        } else {
+            amrex::Array4<amrex::Real const> const mu = macroscopic_properties->getmu_mf().const_array(mfi);
+            if (precomputed) {
+                CoefsPrecomputed const get_coefs{{
+                    macroscopic_properties->getcoefs_mf(0).const_array(mfi),
+                    macroscopic_properties->getcoefs_mf(1).const_array(mfi),
+                    macroscopic_properties->getcoefs_mf(2).const_array(mfi)}};
+                macroscopicEvolveETile<T_Algo>(tex, tey, tez, a, get_coefs, mu, Ex_stag, Ey_stag, Ez_stag,
+                    coefs_x, n_coefs_x, coefs_y, n_coefs_y, coefs_z, n_coefs_z);
+            } else {
+                CoefsFromProperties<T_MacroAlgo, amrex::Array4<amrex::Real const>> const get_coefs{
+                    macroscopic_properties->getsigma_mf().const_array(mfi),
+                    macroscopic_properties->getepsilon_mf().const_array(mfi),
+                    sigma_stag, epsilon_stag, macro_cr, dt};
+                macroscopicEvolveETile<T_Algo>(tex, tey, tez, a, get_coefs, mu, Ex_stag, Ey_stag, Ez_stag,
+                    coefs_x, n_coefs_x, coefs_y, n_coefs_y, coefs_z, n_coefs_z);
+            }
+        }
+    }
+}
+
 #endif // corresponds to ifndef WARPX_DIM_RZ
@@ -9,16 +9,22 @@
 #include <AMReX_Array4.H>
 #include <AMReX_Config.H>
 #include <AMReX_Geometry.H>
+#include <AMReX_GpuContainers.H>
 #include <AMReX_GpuLaunch.H>
 #include <AMReX_IndexType.H>
 #include <AMReX_MFIter.H>
+#include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX_Print.H>
 #include <AMReX_RealBox.H>
 #include <AMReX_Parser.H>
+#include <AMReX_Reduce.H>
+#include <AMReX_Vector.H>
 
 #include <AMReX_BaseFwd.H>
 
+#include <cmath>
+#include <limits>
 #include <memory>
 #include <sstream>
 
@@ -34,6 +40,16 @@ void
 MacroscopicProperties::ReadParameters ()
 {
     const ParmParse pp_macroscopic("macroscopic");
+
+    pp_macroscopic.query("precompute_coefficients", m_precompute_coefficients);
+
+    // Piecewise-constant materials: the properties are given by a table per
+    // material and by the material ID of each cell, instead of full MultiFabs
+    pp_macroscopic.queryarr("materials", m_material_names);
+    if (!m_material_names.empty()) {
+        ReadMaterials(pp_macroscopic);
+        return;
+    }
     // Since macroscopic maxwell solve is turned on,
     // user-defined sigma, mu, and epsilon are queried.
     // The vacuum values are used as default for the macroscopic parameters
@@ -118,6 +134,92 @@ MacroscopicProperties::ReadParameters ()
 
 }
 
+void
+MacroscopicProperties::ReadMaterials (const amrex::ParmParse& pp_macroscopic)
+{
+    const auto n_materials = static_cast<int>(m_material_names.size());
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        n_materials <= std::numeric_limits<MaterialId>::max() + 1,
+        "macroscopic.materials: too many materials");
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        !pp_macroscopic.contains("sigma_function(x,y,z)") &&
+        !pp_macroscopic.contains("epsilon_function(x,y,z)") &&
+        !pp_macroscopic.contains("mu_function(x,y,z)"),
+        "macroscopic.materials cannot be combined with macroscopic.sigma_function(x,y,z),"
+        " macroscopic.epsilon_function(x,y,z) or macroscopic.mu_function(x,y,z)");
+
+    // The properties of each material default to the vacuum values
+    amrex::Vector<amrex::Real> h_sigma(n_materials, 0.0_rt);
+    amrex::Vector<amrex::Real> h_epsilon(n_materials, PhysConst::ep0);
+    amrex::Vector<amrex::Real> h_mu(n_materials, PhysConst::mu0);
+    for (int m = 0; m < n_materials; ++m) {
+        const ParmParse pp_material("macroscopic." + m_material_names[m]);
+        utils::parser::queryWithParser(pp_material, "sigma", h_sigma[m]);
+        utils::parser::queryWithParser(pp_material, "epsilon", h_epsilon[m]);
+        utils::parser::queryWithParser(pp_material, "mu", h_mu[m]);
+        // In the Maxwell solver, `epsilon` and `mu` are used in the denominator
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(h_epsilon[m] > 0._rt && h_mu[m] > 0._rt,
+            "macroscopic." + m_material_names[m] + ": epsilon and mu must be strictly positive");
+    }
+    m_sigma_table.resize(n_materials);
+    m_epsilon_table.resize(n_materials);
+    m_mu_table.resize(n_materials);
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, h_sigma.begin(), h_sigma.end(), m_sigma_table.begin());
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, h_epsilon.begin(), h_epsilon.end(), m_epsilon_table.begin());
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, h_mu.begin(), h_mu.end(), m_mu_table.begin());
+    amrex::Gpu::streamSynchronize();
+
+    // Index of the material of each cell, in macroscopic.materials
+    std::string str_material_id_function;
+    utils::parser::Store_parserString(
+        pp_macroscopic, "material_id_function(x,y,z)", str_material_id_function);
+    m_material_id_parser = std::make_unique<amrex::Parser>(
+        utils::parser::makeParser(str_material_id_function,{"x","y","z"}));
+}
+
+void
+MacroscopicProperties::InitMaterialIds (
+    const amrex::GpuArray<amrex::Real, AMREX_SPACEDIM>& dx_lev,
+    const amrex::RealBox& prob_domain_lev)
+{
+    auto const& material_id_parser = m_material_id_parser->compile<3>();
+    const auto n_materials = static_cast<int>(m_material_names.size());
+
+    // Same cell-centered positions as in InitializeMacroMultiFabUsingParser
+    amrex::ReduceOps<amrex::ReduceOpMax> reduce_op;
+    amrex::ReduceData<int> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+    for ( amrex::MFIter mfi(*m_material_id_mf, TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
+        const amrex::Box& tb = mfi.growntilebox();
+        amrex::Array4<MaterialId> const& id_arr = m_material_id_mf->array(mfi);
+        reduce_op.eval(tb, reduce_data,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple {
+#if defined(WARPX_DIM_1D_Z)
+                const amrex::Real x = 0._rt;
+                const amrex::Real y = 0._rt;
+                const amrex::Real z = (i + 0.5_rt) * dx_lev[0] + prob_domain_lev.lo(0);
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+                const amrex::Real x = (i + 0.5_rt) * dx_lev[0] + prob_domain_lev.lo(0);
+                const amrex::Real y = 0._rt;
+                const amrex::Real z = (j + 0.5_rt) * dx_lev[1] + prob_domain_lev.lo(1);
+#else
+                const amrex::Real x = (i + 0.5_rt) * dx_lev[0] + prob_domain_lev.lo(0);
+                const amrex::Real y = (j + 0.5_rt) * dx_lev[1] + prob_domain_lev.lo(1);
+                const amrex::Real z = (k + 0.5_rt) * dx_lev[2] + prob_domain_lev.lo(2);
+#endif
+                const auto id = static_cast<int>(std::round(material_id_parser(x,y,z)));
+                const bool invalid = (id < 0 || id >= n_materials);
+                id_arr(i,j,k) = static_cast<MaterialId>(invalid ? 0 : id);
+                return {static_cast<int>(invalid)};
+        });
+    }
+    int invalid = amrex::get<0>(reduce_data.value(reduce_op));
+    amrex::ParallelDescriptor::ReduceIntMax(invalid);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!invalid,
+        "macroscopic.material_id_function(x,y,z) must return indices in macroscopic.materials,"
+        " i.e. between 0 and the number of materials minus one");
+}
+
 void
 MacroscopicProperties::InitData (
     const amrex::BoxArray& ba,
@@ -130,6 +232,48 @@ MacroscopicProperties::InitData (
 {
     amrex::Print() << Utils::TextMsg::Info("we are in init data of macro");
 
+    // Precomputed coefficients of the E update, at the location of each component of E
+    if (m_precompute_coefficients) {
+        const std::array<amrex::IntVect, 3> E_stag = {Ex_stag, Ey_stag, Ez_stag};
+        for (int idim = 0; idim < 3; ++idim) {
+            m_coefs_mf[idim] = std::make_unique<amrex::MultiFab>(
+                amrex::convert(ba, E_stag[idim]), dmap, 2, 0);
+        }
+        m_coefs_dt = -1._rt;
+    }
+
+    // sigma, epsilon and mu (or the material IDs) are cell-centered
+    const amrex::IntVect sigma_stag = ba.ixType().toIntVect();
+    const amrex::IntVect epsilon_stag = ba.ixType().toIntVect();
+    const amrex::IntVect mu_stag = ba.ixType().toIntVect();
+
+
+    for ( int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        sigma_IndexType[idim]   = sigma_stag[idim];
+        epsilon_IndexType[idim] = epsilon_stag[idim];
+        mu_IndexType[idim]      = mu_stag[idim];
+        Ex_IndexType[idim]      = Ex_stag[idim];
+        Ey_IndexType[idim]      = Ey_stag[idim];
+        Ez_IndexType[idim]      = Ez_stag[idim];
+        macro_cr_ratio[idim]    = 1;
+    }
+#if defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+        sigma_IndexType[2]   = 0;
+        epsilon_IndexType[2] = 0;
+        mu_IndexType[2]      = 0;
+        Ex_IndexType[2]      = 0;
+        Ey_IndexType[2]      = 0;
+        Ez_IndexType[2]      = 0;
+        macro_cr_ratio[2]    = 1;
+#endif
+
+    if (usesMaterials()) {
+        // Only the (cell-centered) material IDs are stored on the grid
+        m_material_id_mf = std::make_unique<MaterialIdMultiFab>(ba, dmap, 1, ng_EB_alloc);
+        InitMaterialIds(geom.CellSizeArray(), geom.ProbDomain());
+        return;
+    }
+
     // Define material property multifabs using ba and dmap from WarpX instance
     // sigma is cell-centered MultiFab
     m_sigma_mf = std::make_unique<amrex::MultiFab>(ba, dmap, 1, ng_EB_alloc);
@@ -175,30 +319,6 @@ MacroscopicProperties::InitData (
             geom.CellSizeArray(), geom.ProbDomain());
 
     }
-
-    const amrex::IntVect sigma_stag = m_sigma_mf->ixType().toIntVect();
-    const amrex::IntVect epsilon_stag = m_eps_mf->ixType().toIntVect();
-    const amrex::IntVect mu_stag = m_mu_mf->ixType().toIntVect();
-
-
-    for ( int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
-        sigma_IndexType[idim]   = sigma_stag[idim];
-        epsilon_IndexType[idim] = epsilon_stag[idim];
-        mu_IndexType[idim]      = mu_stag[idim];
-        Ex_IndexType[idim]      = Ex_stag[idim];
-        Ey_IndexType[idim]      = Ey_stag[idim];
-        Ez_IndexType[idim]      = Ez_stag[idim];
-        macro_cr_ratio[idim]    = 1;
-    }
-#if defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-        sigma_IndexType[2]   = 0;
-        epsilon_IndexType[2] = 0;
-        mu_IndexType[2]      = 0;
-        Ex_IndexType[2]      = 0;
-        Ey_IndexType[2]      = 0;
-        Ez_IndexType[2]      = 0;
-        macro_cr_ratio[2]    = 1;
-#endif
 }
 
 void
@@ -0,0 +1,59 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "ImplicitSolver.H"
+#include "WarpX.H"
+
+#include "Utils/TextMsg.H"
+
+namespace
+{
+    amrex::Array<amrex::LinOpBCType,AMREX_SPACEDIM>
+    convertFieldBCToLinOpBC (const amrex::Vector<FieldBoundaryType>& a_fbc)
+    {
+        amrex::Array<amrex::LinOpBCType,AMREX_SPACEDIM> lbc;
+        for (int i = 0; i < AMREX_SPACEDIM; i++) {
+            if (a_fbc[i] == FieldBoundaryType::Periodic) {
+                lbc[i] = amrex::LinOpBCType::Periodic;
+            } else if (a_fbc[i] == FieldBoundaryType::PEC) {
+                // Tangential electric field is zero
+                lbc[i] = amrex::LinOpBCType::Dirichlet;
+            } else {
+                WARPX_ABORT_WITH_MESSAGE(
+                    "The preconditioner of the implicit solver only supports periodic and PEC field boundaries");
+            }
+        }
+        return lbc;
+    }
+}
+
+const amrex::Geometry& ImplicitSolver::GetGeometry () const
+{
+    const int lev = 0;
+    return m_WarpX->Geom(lev);
+}
+
+const amrex::BoxArray& ImplicitSolver::GetBoxArray () const
+{
+    const int lev = 0;
+    return m_WarpX->boxArray(lev);
+}
+
+const amrex::DistributionMapping& ImplicitSolver::GetDistributionMapping () const
+{
+    const int lev = 0;
+    return m_WarpX->DistributionMap(lev);
+}
+
+amrex::Array<amrex::LinOpBCType,AMREX_SPACEDIM> ImplicitSolver::GetLinOpBCLo () const
+{
+    return convertFieldBCToLinOpBC(WarpX::field_boundary_lo);
+}
+
+amrex::Array<amrex::LinOpBCType,AMREX_SPACEDIM> ImplicitSolver::GetLinOpBCHi () const
+{
+    return convertFieldBCToLinOpBC(WarpX::field_boundary_hi);
+}
@@ -187,6 +187,8 @@ WarpX::FinishImplicitParticleUpdate ()
     // step we need to transform the particle postion and momentum from
     // time n+1/2 to time n+1. This is done here.
 
+    mypc->InvalidateCellBins();
+
     for (auto const& pc : *mypc) {
 
         for (int lev = 0; lev <= finest_level; ++lev) {
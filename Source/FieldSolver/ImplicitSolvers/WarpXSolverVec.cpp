@@ -29,7 +29,7 @@ void WarpXSolverVec::SetDotMask( const amrex::Vector<amrex::Geometry>&  a_Geom )
     amrex::ExecOnFinalize(WarpXSolverVec::clearDotMask);
 }
 
-[[nodiscard]] amrex::Real WarpXSolverVec::dotProduct ( const WarpXSolverVec&  a_X ) const
+amrex::Real WarpXSolverVec::localDotProduct ( const WarpXSolverVec&  a_X ) const
 {
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
         m_dot_mask_defined,
@@ -46,6 +46,24 @@ void WarpXSolverVec::SetDotMask( const amrex::Vector<amrex::Geometry>&  a_Geom )
                                           *a_X.getVec()[lev][n], 0, 1, 0, local);
         result += rtmp;
     }
+    return result;
+}
+
+[[nodiscard]] amrex::Real WarpXSolverVec::dotProduct ( const WarpXSolverVec&  a_X ) const
+{
+    amrex::Real result = localDotProduct(a_X);
     amrex::ParallelAllReduce::Sum(result, amrex::ParallelContext::CommunicatorSub());
     return result;
 }
+
+void WarpXSolverVec::dotProducts (
+    const amrex::Vector<std::pair<const WarpXSolverVec*, const WarpXSolverVec*>>& a_pairs,
+    amrex::Vector<amrex::Real>& a_result )
+{
+    a_result.resize(a_pairs.size());
+    for (int i = 0; i < static_cast<int>(a_pairs.size()); ++i) {
+        a_result[i] = a_pairs[i].first->localDotProduct(*a_pairs[i].second);
+    }
+    amrex::ParallelAllReduce::Sum(a_result.data(), static_cast<int>(a_result.size()),
+                                  amrex::ParallelContext::CommunicatorSub());
+}
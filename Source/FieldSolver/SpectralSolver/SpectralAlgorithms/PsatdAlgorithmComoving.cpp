@@ -157,14 +157,13 @@ PsatdAlgorithmComoving::pushSpectralFields (SpectralFieldData& f) const
 }
 
 void PsatdAlgorithmComoving::InitializeSpectralCoefficients (const SpectralKSpace& spectral_kspace,
-                                                             const amrex::DistributionMapping& dm,
+                                                             const amrex::DistributionMapping& /*dm*/,
                                                              const amrex::Real dt)
 {
     const amrex::BoxArray& ba = spectral_kspace.spectralspace_ba;
 
     // Loop over boxes and allocate the corresponding coefficients for each box
-    for (amrex::MFIter mfi(ba, dm); mfi.isValid(); ++mfi) {
-
+    for (SpectralRealCoefficients::UniqueBoxIter mfi(C_coef); mfi.isValid(); ++mfi) {
         const amrex::Box& bx = ba[mfi];
 
         // Extract pointers for the k vectors
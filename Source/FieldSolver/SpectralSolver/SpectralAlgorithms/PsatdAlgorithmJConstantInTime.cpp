@@ -356,7 +356,7 @@ PsatdAlgorithmJConstantInTime::pushSpectralFields (SpectralFieldData& f) const
 
 void PsatdAlgorithmJConstantInTime::InitializeSpectralCoefficients (
     const SpectralKSpace& spectral_kspace,
-    const amrex::DistributionMapping& dm,
+    const amrex::DistributionMapping& /*dm*/,
     const amrex::Real dt)
 {
     const bool is_galilean     = m_is_galilean;
@@ -364,7 +364,7 @@ void PsatdAlgorithmJConstantInTime::InitializeSpectralCoefficients (
     const amrex::BoxArray& ba = spectral_kspace.spectralspace_ba;
 
     // Loop over boxes and allocate the corresponding coefficients for each box
-    for (amrex::MFIter mfi(ba, dm); mfi.isValid(); ++mfi)
+    for (SpectralRealCoefficients::UniqueBoxIter mfi(C_coef); mfi.isValid(); ++mfi)
     {
         const amrex::Box& bx = ba[mfi];
 
@@ -519,13 +519,13 @@ void PsatdAlgorithmJConstantInTime::InitializeSpectralCoefficients (
 
 void PsatdAlgorithmJConstantInTime::InitializeSpectralCoefficientsAveraging (
     const SpectralKSpace& spectral_kspace,
-    const amrex::DistributionMapping& dm,
+    const amrex::DistributionMapping& /*dm*/,
     const amrex::Real dt)
 {
     const amrex::BoxArray& ba = spectral_kspace.spectralspace_ba;
 
     // Loop over boxes and allocate the corresponding coefficients for each box
-    for (amrex::MFIter mfi(ba, dm); mfi.isValid(); ++mfi)
+    for (SpectralRealCoefficients::UniqueBoxIter mfi(C_coef); mfi.isValid(); ++mfi)
     {
         const amrex::Box& bx = ba[mfi];
 
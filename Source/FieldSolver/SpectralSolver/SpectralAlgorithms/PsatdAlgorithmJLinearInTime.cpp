@@ -14,6 +14,7 @@
 #include <AMReX_BLProfiler.H>
 #include <AMReX_BaseFab.H>
 #include <AMReX_BoxArray.H>
+#include <AMReX_Extension.H>
 #include <AMReX_GpuComplex.H>
 #include <AMReX_GpuLaunch.H>
 #include <AMReX_GpuQualifiers.H>
@@ -28,6 +29,109 @@
 
 using namespace amrex::literals;
 
+namespace
+{
+    /** Coefficients C, S_ck, X1, X2 and X3 of the update equations,
+     *  for the norm knorm_s of the modified k vector */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    void computeCoefficients (const amrex::Real knorm_s, const amrex::Real dt,
+                              amrex::Real& C, amrex::Real& S_ck, amrex::Real& X1,
+                              amrex::Real& X2, amrex::Real& X3) noexcept
+    {
+        // Physical constants and imaginary unit
+        constexpr amrex::Real c = PhysConst::c;
+        constexpr amrex::Real ep0 = PhysConst::ep0;
+
+        const amrex::Real c2 = amrex::Math::powi<2>(c);
+        const amrex::Real dt2 = amrex::Math::powi<2>(dt);
+
+        const amrex::Real om_s = c * knorm_s;
+        const amrex::Real om2_s = amrex::Math::powi<2>(om_s);
+
+        // C
+        C = std::cos(om_s * dt);
+
+        // S_ck
+        if (om_s != 0.)
+        {
+            S_ck = std::sin(om_s * dt) / om_s;
+        }
+        else // om_s = 0
+        {
+            S_ck = dt;
+        }
+
+        // X1 (multiplies i*([k] \times J) in the update equation for update B)
+        if (om_s != 0.)
+        {
+            X1 = (1._rt - C) / (ep0 * om2_s);
+        }
+        else // om_s = 0
+        {
+            X1 = 0.5_rt * dt2 / ep0;
+        }
+
+        // X2 (multiplies rho_new in the update equation for E)
+        if (om_s != 0.)
+        {
+            X2 = c2 * (dt - S_ck) / (ep0 * dt * om2_s);
+        }
+        else // om_s = 0
+        {
+            X2 = c2 * dt2 / (6._rt * ep0);
+        }
+
+        // X3 (multiplies rho_old in the update equation for E)
+        if (om_s != 0.)
+        {
+            X3 = c2 * (dt * C - S_ck) / (ep0 * dt * om2_s);
+        }
+        else // om_s = 0
+        {
+            X3 = - c2 * dt2 / (3._rt * ep0);
+        }
+    }
+
+    /** Coefficients X5 and X6 of the update equations with time averaging,
+     *  for the norm knorm_s of the modified k vector */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    void computeCoefficientsAveraging (const amrex::Real knorm_s, const amrex::Real dt,
+                                       const amrex::Real C, const amrex::Real S_ck,
+                                       amrex::Real& X5, amrex::Real& X6) noexcept
+    {
+        // Physical constants and imaginary unit
+        constexpr amrex::Real c = PhysConst::c;
+        constexpr amrex::Real c2 = c*c;
+        constexpr amrex::Real ep0 = PhysConst::ep0;
+
+        // Auxiliary coefficients
+        const amrex::Real dt3 = dt * dt * dt;
+
+        const amrex::Real om_s  = c * knorm_s;
+        const amrex::Real om2_s = om_s * om_s;
+        const amrex::Real om4_s = om2_s * om2_s;
+
+        if (om_s != 0.)
+        {
+            X5 = c2 / ep0 * (S_ck / om2_s - (1._rt - C) / (om4_s * dt)
+                             - 0.5_rt * dt / om2_s);
+        }
+        else
+        {
+            X5 = - c2 * dt3 / (8._rt * ep0);
+        }
+
+        if (om_s != 0.)
+        {
+            X6 = c2 / ep0 * ((1._rt - C) / (om4_s * dt) - 0.5_rt * dt / om2_s);
+        }
+        else
+        {
+            X6 = - c2 * dt3 / (24._rt * ep0);
+        }
+    }
+}
+
 PsatdAlgorithmJLinearInTime::PsatdAlgorithmJLinearInTime(
     const SpectralKSpace& spectral_kspace,
     const amrex::DistributionMapping& dm,
@@ -39,14 +143,19 @@ PsatdAlgorithmJLinearInTime::PsatdAlgorithmJLinearInTime(
     const amrex::Real dt,
     const bool time_averaging,
     const bool dive_cleaning,
-    const bool divb_cleaning)
+    const bool divb_cleaning,
+    const bool on_the_fly_coefficients)
     // Initializer list
     : SpectralBaseAlgorithm(spectral_kspace, dm, spectral_index, norder_x, norder_y, norder_z, grid_type),
     m_dt(dt),
     m_time_averaging(time_averaging),
     m_dive_cleaning(dive_cleaning),
-    m_divb_cleaning(divb_cleaning)
+    m_divb_cleaning(divb_cleaning),
+    m_on_the_fly_coefficients(on_the_fly_coefficients)
 {
+    // The coefficients are recomputed in pushSpectralFields from the modified k vectors
+    if (on_the_fly_coefficients) { return; }
+
     const amrex::BoxArray& ba = spectral_kspace.spectralspace_ba;
 
     // Always allocate these coefficients
@@ -73,6 +182,7 @@ PsatdAlgorithmJLinearInTime::pushSpectralFields (SpectralFieldData& f) const
     const bool time_averaging = m_time_averaging;
     const bool dive_cleaning = m_dive_cleaning;
     const bool divb_cleaning = m_divb_cleaning;
+    const bool on_the_fly = m_on_the_fly_coefficients;
 
     const amrex::Real dt = m_dt;
 
@@ -86,19 +196,26 @@ PsatdAlgorithmJLinearInTime::pushSpectralFields (SpectralFieldData& f) const
         // Extract arrays for the fields to be updated
         const amrex::Array4<Complex> fields = f.fields[mfi].array();
 
-        // These coefficients are always allocated
-        const amrex::Array4<const amrex::Real> C_arr = C_coef[mfi].array();
-        const amrex::Array4<const amrex::Real> S_ck_arr = S_ck_coef[mfi].array();
-        const amrex::Array4<const amrex::Real> X1_arr = X1_coef[mfi].array();
-        const amrex::Array4<const amrex::Real> X2_arr = X2_coef[mfi].array();
-        const amrex::Array4<const amrex::Real> X3_arr = X3_coef[mfi].array();
-
+        // These coefficients are allocated unless they are computed on the fly
+        amrex::Array4<const amrex::Real> C_arr;
+        amrex::Array4<const amrex::Real> S_ck_arr;
+        amrex::Array4<const amrex::Real> X1_arr;
+        amrex::Array4<const amrex::Real> X2_arr;
+        amrex::Array4<const amrex::Real> X3_arr;
         amrex::Array4<const amrex::Real> X5_arr;
         amrex::Array4<const amrex::Real> X6_arr;
-        if (time_averaging)
+        if (!on_the_fly)
         {
-            X5_arr = X5_coef[mfi].array();
-            X6_arr = X6_coef[mfi].array();
+            C_arr = C_coef[mfi].array();
+            S_ck_arr = S_ck_coef[mfi].array();
+            X1_arr = X1_coef[mfi].array();
+            X2_arr = X2_coef[mfi].array();
+            X3_arr = X3_coef[mfi].array();
+            if (time_averaging)
+            {
+                X5_arr = X5_coef[mfi].array();
+                X6_arr = X6_coef[mfi].array();
+            }
         }
 
         // Extract pointers for the k vectors
@@ -148,12 +265,35 @@ PsatdAlgorithmJLinearInTime::pushSpectralFields (SpectralFieldData& f) const
             constexpr amrex::Real inv_ep0 = 1._rt / PhysConst::ep0;
             constexpr Complex I = Complex{0._rt, 1._rt};
 
-            // These coefficients are initialized in the function InitializeSpectralCoefficients
-            const amrex::Real C = C_arr(i,j,k);
-            const amrex::Real S_ck = S_ck_arr(i,j,k);
-            const amrex::Real X1 = X1_arr(i,j,k);
-            const amrex::Real X2 = X2_arr(i,j,k);
-            const amrex::Real X3 = X3_arr(i,j,k);
+            // These coefficients are initialized in the function InitializeSpectralCoefficients,
+            // or computed here from the modified k vectors
+            amrex::Real C, S_ck, X1, X2, X3;
+            amrex::Real X5 = 0._rt, X6 = 0._rt;
+            if (on_the_fly)
+            {
+#if defined(WARPX_DIM_3D)
+                const amrex::Real knorm_s = std::sqrt(
+                    amrex::Math::powi<2>(kx) + amrex::Math::powi<2>(ky) + amrex::Math::powi<2>(kz));
+#else
+                const amrex::Real knorm_s = std::sqrt(
+                    amrex::Math::powi<2>(kx) + amrex::Math::powi<2>(kz));
+#endif
+                computeCoefficients(knorm_s, dt, C, S_ck, X1, X2, X3);
+                if (time_averaging) { computeCoefficientsAveraging(knorm_s, dt, C, S_ck, X5, X6); }
+            }
+            else
+            {
+                C = C_arr(i,j,k);
+                S_ck = S_ck_arr(i,j,k);
+                X1 = X1_arr(i,j,k);
+                X2 = X2_arr(i,j,k);
+                X3 = X3_arr(i,j,k);
+                if (time_averaging)
+                {
+                    X5 = X5_arr(i,j,k);
+                    X6 = X6_arr(i,j,k);
+                }
+            }
             const amrex::Real X4 = - S_ck / PhysConst::ep0;
 
             // Update equations for E in the formulation with rho
@@ -211,9 +351,6 @@ PsatdAlgorithmJLinearInTime::pushSpectralFields (SpectralFieldData& f) const
 
             if (time_averaging)
             {
-                const amrex::Real X5 = X5_arr(i,j,k);
-                const amrex::Real X6 = X6_arr(i,j,k);
-
                 // TODO: Here the code is *accumulating* the average,
                 // because it is meant to be used with sub-cycling
                 // maybe this should be made more generic
@@ -262,13 +399,13 @@ PsatdAlgorithmJLinearInTime::pushSpectralFields (SpectralFieldData& f) const
 
 void PsatdAlgorithmJLinearInTime::InitializeSpectralCoefficients (
     const SpectralKSpace& spectral_kspace,
-    const amrex::DistributionMapping& dm,
+    const amrex::DistributionMapping& /*dm*/,
     const amrex::Real dt)
 {
     const amrex::BoxArray& ba = spectral_kspace.spectralspace_ba;
 
     // Loop over boxes and allocate the corresponding coefficients for each box
-    for (amrex::MFIter mfi(ba, dm); mfi.isValid(); ++mfi)
+    for (SpectralRealCoefficients::UniqueBoxIter mfi(C_coef); mfi.isValid(); ++mfi)
     {
         const amrex::Box& bx = ba[mfi];
 
@@ -297,71 +434,21 @@ void PsatdAlgorithmJLinearInTime::InitializeSpectralCoefficients (
 #else
                 amrex::Math::powi<2>(kz_s[j]));
 #endif
-            // Physical constants and imaginary unit
-            constexpr amrex::Real c = PhysConst::c;
-            constexpr amrex::Real ep0 = PhysConst::ep0;
-
-            const amrex::Real c2 = amrex::Math::powi<2>(c);
-            const amrex::Real dt2 = amrex::Math::powi<2>(dt);
-
-            const amrex::Real om_s = c * knorm_s;
-            const amrex::Real om2_s = amrex::Math::powi<2>(om_s);
-
-            // C
-            C(i,j,k) = std::cos(om_s * dt);
-
-            // S_ck
-            if (om_s != 0.)
-            {
-                S_ck(i,j,k) = std::sin(om_s * dt) / om_s;
-            }
-            else // om_s = 0
-            {
-                S_ck(i,j,k) = dt;
-            }
-
-            // X1 (multiplies i*([k] \times J) in the update equation for update B)
-            if (om_s != 0.)
-            {
-                X1(i,j,k) = (1._rt - C(i,j,k)) / (ep0 * om2_s);
-            }
-            else // om_s = 0
-            {
-                X1(i,j,k) = 0.5_rt * dt2 / ep0;
-            }
-
-            // X2 (multiplies rho_new in the update equation for E)
-            if (om_s != 0.)
-            {
-                X2(i,j,k) = c2 * (dt - S_ck(i,j,k)) / (ep0 * dt * om2_s);
-            }
-            else // om_s = 0
-            {
-                X2(i,j,k) = c2 * dt2 / (6._rt * ep0);
-            }
-
-            // X3 (multiplies rho_old in the update equation for E)
-            if (om_s != 0.)
-            {
-                X3(i,j,k) = c2 * (dt * C(i,j,k) - S_ck(i,j,k)) / (ep0 * dt * om2_s);
-            }
-            else // om_s = 0
-            {
-                X3(i,j,k) = - c2 * dt2 / (3._rt * ep0);
-            }
+            computeCoefficients(knorm_s, dt, C(i,j,k), S_ck(i,j,k),
+                                X1(i,j,k), X2(i,j,k), X3(i,j,k));
         });
     }
 }
 
 void PsatdAlgorithmJLinearInTime::InitializeSpectralCoefficientsAveraging (
     const SpectralKSpace& spectral_kspace,
-    const amrex::DistributionMapping& dm,
+    const amrex::DistributionMapping& /*dm*/,
     const amrex::Real dt)
 {
     const amrex::BoxArray& ba = spectral_kspace.spectralspace_ba;
 
     // Loop over boxes and allocate the corresponding coefficients for each box
-    for (amrex::MFIter mfi(ba, dm); mfi.isValid(); ++mfi)
+    for (SpectralRealCoefficients::UniqueBoxIter mfi(C_coef); mfi.isValid(); ++mfi)
     {
         const amrex::Box& bx = ba[mfi];
 
@@ -389,36 +476,8 @@ void PsatdAlgorithmJLinearInTime::InitializeSpectralCoefficientsAveraging (
 #else
                 amrex::Math::powi<2>(kz_s[j]));
 #endif
-            // Physical constants and imaginary unit
-            constexpr amrex::Real c = PhysConst::c;
-            constexpr amrex::Real c2 = c*c;
-            constexpr amrex::Real ep0 = PhysConst::ep0;
-
-            // Auxiliary coefficients
-            const amrex::Real dt3 = dt * dt * dt;
-
-            const amrex::Real om_s  = c * knorm_s;
-            const amrex::Real om2_s = om_s * om_s;
-            const amrex::Real om4_s = om2_s * om2_s;
-
-            if (om_s != 0.)
-            {
-                X5(i,j,k) = c2 / ep0 * (S_ck(i,j,k) / om2_s - (1._rt - C(i,j,k)) / (om4_s * dt)
-                                        - 0.5_rt * dt / om2_s);
-            }
-            else
-            {
-                X5(i,j,k) = - c2 * dt3 / (8._rt * ep0);
-            }
-
-            if (om_s != 0.)
-            {
-                X6(i,j,k) = c2 / ep0 * ((1._rt - C(i,j,k)) / (om4_s * dt) - 0.5_rt * dt / om2_s);
-            }
-            else
-            {
-                X6(i,j,k) = - c2 * dt3 / (24._rt * ep0);
-            }
+            computeCoefficientsAveraging(knorm_s, dt, C(i,j,k), S_ck(i,j,k),
+                                         X5(i,j,k), X6(i,j,k));
         });
     }
 }
@@ -375,7 +375,7 @@ void PsatdAlgorithmPml::pushSpectralFields(SpectralFieldData& f) const
 
 void PsatdAlgorithmPml::InitializeSpectralCoefficients (
     const SpectralKSpace& spectral_kspace,
-    const amrex::DistributionMapping& dm)
+    const amrex::DistributionMapping& /*dm*/)
 {
     const amrex::Real dt = m_dt;
     const bool is_galilean = m_is_galilean;
@@ -384,7 +384,7 @@ void PsatdAlgorithmPml::InitializeSpectralCoefficients (
 
     // Loop over boxes and allocate the corresponding coefficients
     // for each box owned by the local MPI process
-    for (amrex::MFIter mfi(ba, dm); mfi.isValid(); ++mfi)
+    for (SpectralRealCoefficients::UniqueBoxIter mfi(C_coef); mfi.isValid(); ++mfi)
     {
         const amrex::Box& bx = ba[mfi];
 
@@ -25,14 +25,97 @@
 #include <AMReX_IntVect.H>
 #include <AMReX_LayoutData.H>
 #include <AMReX_MFIter.H>
+#include <AMReX_Periodicity.H>
 #include <AMReX_PODVector.H>
 #include <AMReX_REAL.H>
 #include <AMReX_Utility.H>
 
+#include <array>
+
 #if WARPX_USE_FFT
 
 using namespace amrex;
 
+namespace
+{
+    /* \brief Copy the real-space result `tmp_arr` of a backward FFT, normalized by
+     * `inv_N`, to the component `i_comp` of the box `mfi` of `mf` */
+    void CopyFromTmpRealField (MultiFab& mf, const MFIter& mfi,
+                               const Array4<const Real>& tmp_arr, const Real inv_N,
+                               const IntVect& fill_guards, const int i_comp,
+                               const bool periodic_single_box)
+    {
+#if (AMREX_SPACEDIM >= 2)
+        const int si = (mf.is_nodal(0)) ? 1 : 0;
+#endif
+#if   defined(WARPX_DIM_1D_Z)
+        const int si = (mf.is_nodal(0)) ? 1 : 0;
+        const int sj = 0;
+        const int sk = 0;
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+        const int sj = (mf.is_nodal(1)) ? 1 : 0;
+        const int sk = 0;
+#elif defined(WARPX_DIM_3D)
+        const int sj = (mf.is_nodal(1)) ? 1 : 0;
+        const int sk = (mf.is_nodal(2)) ? 1 : 0;
+#endif
+
+        // Numbers of guard cells
+        const amrex::IntVect& mf_ng = mf.nGrowVect();
+
+        amrex::Box mf_box = (periodic_single_box) ? mf.box(mfi.index()) : mf[mfi].box();
+        const amrex::Array4<amrex::Real> mf_arr = mf[mfi].array();
+
+        // Total number of cells, including ghost cells (nj represents ny in 3D and nz in 2D)
+        const int ni = mf_box.length(0);
+#if   defined(WARPX_DIM_1D_Z)
+        constexpr int nj = 1;
+        constexpr int nk = 1;
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+        const int nj = mf_box.length(1);
+        constexpr int nk = 1;
+#elif defined(WARPX_DIM_3D)
+        const int nj = mf_box.length(1);
+        const int nk = mf_box.length(2);
+#endif
+        // Lower bound of the box (lo_j represents lo_y in 3D and lo_z in 2D)
+        const int lo_i = amrex::lbound(mf_box).x;
+#if   defined(WARPX_DIM_1D_Z)
+        constexpr int lo_j = 0;
+        constexpr int lo_k = 0;
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+        const int lo_j = amrex::lbound(mf_box).y;
+        constexpr int lo_k = 0;
+#elif defined(WARPX_DIM_3D)
+        const int lo_j = amrex::lbound(mf_box).y;
+        const int lo_k = amrex::lbound(mf_box).z;
+#endif
+        // If necessary, do not fill the guard cells
+        // (shrink box by passing negative number of cells)
+        if (!periodic_single_box)
+        {
+            for (int dir = 0; dir < AMREX_SPACEDIM; dir++)
+            {
+                if ((fill_guards[dir]) == 0) { mf_box.grow(dir, -mf_ng[dir]); }
+            }
+        }
+
+        // Loop over cells within full box, including ghost cells
+        ParallelFor(mf_box, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
+        {
+            // Assume periodicity and set the last outer guard cell equal to the first one:
+            // this is necessary in order to get the correct value along a nodal direction,
+            // because the last point along a nodal direction is always discarded when FFTs
+            // are computed, as the real-space box is always cell-centered.
+            const int ii = (i == lo_i + ni - si) ? lo_i : i;
+            const int jj = (j == lo_j + nj - sj) ? lo_j : j;
+            const int kk = (k == lo_k + nk - sk) ? lo_k : k;
+            // Copy and normalize field
+            mf_arr(i,j,k,i_comp) = inv_N * tmp_arr(ii,jj,kk);
+        });
+    }
+}
+
 SpectralFieldIndex::SpectralFieldIndex (const bool update_with_rho,
                                         const bool time_averaging,
                                         const int J_in_time,
@@ -122,9 +205,16 @@ SpectralFieldData::SpectralFieldData( const int lev,
                                       const SpectralKSpace& k_space,
                                       const amrex::DistributionMapping& dm,
                                       const int n_field_required,
-                                      const bool periodic_single_box):
-    m_periodic_single_box{periodic_single_box}
+                                      const bool periodic_single_box,
+                                      const amrex::BoxArray& group_ba):
+    m_periodic_single_box{periodic_single_box},
+    m_group_ba{group_ba}
 {
+    // The FFT boxes are the groups extended by the same number of guard cells on each side
+    if (!m_group_ba.empty()) {
+        m_group_ng = realspace_ba[0].bigEnd() - m_group_ba[0].bigEnd();
+    }
+
     amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
     const bool do_costs = WarpXUtilLoadBalance::doCosts(cost, realspace_ba, dm);
 
@@ -136,8 +226,9 @@ SpectralFieldData::SpectralFieldData( const int lev,
 
     // Allocate temporary arrays - in real space and spectral space
     // These arrays will store the data just before/after the FFT
-    tmpRealField = MultiFab(realspace_ba, dm, 1, 0);
-    tmpSpectralField = SpectralField(spectralspace_ba, dm, 1, 0);
+    // (n_batch components, for the batched transforms of vector fields)
+    tmpRealField = MultiFab(realspace_ba, dm, n_batch, 0);
+    tmpSpectralField = SpectralField(spectralspace_ba, dm, n_batch, 0);
 
     // By default, we assume the FFT is done from/to a nodal grid in real space
     // If the FFT is performed from/to a cell-centered grid in real space,
@@ -165,6 +256,8 @@ SpectralFieldData::SpectralFieldData( const int lev,
     // Allocate and initialize the FFT plans
     forward_plan = ablastr::math::anyfft::FFTplans(spectralspace_ba, dm);
     backward_plan = ablastr::math::anyfft::FFTplans(spectralspace_ba, dm);
+    forward_plan_batch = ablastr::math::anyfft::FFTplans(spectralspace_ba, dm);
+    backward_plan_batch = ablastr::math::anyfft::FFTplans(spectralspace_ba, dm);
     // Loop over boxes and allocate the corresponding plan
     // for each box owned by the local MPI proc
     for ( MFIter mfi(spectralspace_ba, dm); mfi.isValid(); ++mfi ){
@@ -189,6 +282,17 @@ SpectralFieldData::SpectralFieldData( const int lev,
             reinterpret_cast<ablastr::math::anyfft::Complex*>( tmpSpectralField[mfi].dataPtr()),
             ablastr::math::anyfft::direction::C2R, AMREX_SPACEDIM);
 
+        // The components of the tmp fields are contiguous: one plan transforms all of them
+        forward_plan_batch[mfi] = ablastr::math::anyfft::CreatePlan(
+            fft_size, tmpRealField[mfi].dataPtr(),
+            reinterpret_cast<ablastr::math::anyfft::Complex*>( tmpSpectralField[mfi].dataPtr()),
+            ablastr::math::anyfft::direction::R2C, AMREX_SPACEDIM, n_batch);
+
+        backward_plan_batch[mfi] = ablastr::math::anyfft::CreatePlan(
+            fft_size, tmpRealField[mfi].dataPtr(),
+            reinterpret_cast<ablastr::math::anyfft::Complex*>( tmpSpectralField[mfi].dataPtr()),
+            ablastr::math::anyfft::direction::C2R, AMREX_SPACEDIM, n_batch);
+
         if (do_costs)
         {
             amrex::Gpu::synchronize();
@@ -205,6 +309,8 @@ SpectralFieldData::~SpectralFieldData()
         for ( MFIter mfi(tmpRealField); mfi.isValid(); ++mfi ){
             ablastr::math::anyfft::DestroyPlan(forward_plan[mfi]);
             ablastr::math::anyfft::DestroyPlan(backward_plan[mfi]);
+            ablastr::math::anyfft::DestroyPlan(forward_plan_batch[mfi]);
+            ablastr::math::anyfft::DestroyPlan(backward_plan_batch[mfi]);
         }
     }
 }
@@ -217,6 +323,13 @@ SpectralFieldData::ForwardTransform (const int lev,
                                      const MultiFab& mf, const int field_index,
                                      const int i_comp)
 {
+    if (NeedsGroupCopy(mf))
+    {
+        const MultiFab group_mf = CopyToGroups(lev, mf, i_comp);
+        ForwardTransform(lev, group_mf, field_index, 0);
+        return;
+    }
+
     amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
     const bool do_costs = WarpXUtilLoadBalance::doCosts(cost, mf.boxArray(), mf.DistributionMap());
 
@@ -315,6 +428,107 @@ SpectralFieldData::ForwardTransform (const int lev,
 }
 
 
+/* \brief Transform the first component of the three MultiFabs `mf` to spectral
+ *  space with one batched FFT per box, and store the results internally
+ *  (in the spectral fields specified by `field_index`) */
+void
+SpectralFieldData::ForwardTransform (const int lev,
+                                     const std::array<const amrex::MultiFab*,3>& mf,
+                                     const std::array<int,3>& field_index)
+{
+    if (NeedsGroupCopy(*mf[0]))
+    {
+        const std::array<MultiFab,3> group_mf = {CopyToGroups(lev, *mf[0], 0),
+                                                 CopyToGroups(lev, *mf[1], 0),
+                                                 CopyToGroups(lev, *mf[2], 0)};
+        ForwardTransform(lev, {&group_mf[0], &group_mf[1], &group_mf[2]}, field_index);
+        return;
+    }
+
+    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
+    const bool do_costs = WarpXUtilLoadBalance::doCosts(cost, mf[0]->boxArray(), mf[0]->DistributionMap());
+
+    // Check the index type of each field, in order to apply proper shift in spectral space
+    // (the last direction is z, as in the single-field transform)
+    amrex::GpuArray<amrex::GpuArray<int,AMREX_SPACEDIM>,n_batch> is_nodal;
+    amrex::GpuArray<int,n_batch> idx;
+    for (int n = 0; n < n_batch; ++n) {
+        for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+            is_nodal[n][dir] = mf[n]->is_nodal(dir) ? 1 : 0;
+        }
+        idx[n] = field_index[n];
+    }
+
+    // Loop over boxes
+    // Note: we do NOT OpenMP parallelize here, since we use OpenMP threads for
+    //       the FFTs on each box!
+    for ( MFIter mfi(*mf[0]); mfi.isValid(); ++mfi ){
+        if (do_costs)
+        {
+            amrex::Gpu::synchronize();
+        }
+        auto wt = static_cast<amrex::Real>(amrex::second());
+
+        // Copy the real-space fields `mf` to the components of `tmpRealField`
+        // (discarding the last point along nodal directions, see ForwardTransform above)
+        {
+            amrex::GpuArray<amrex::Array4<const amrex::Real>,n_batch> mf_arr;
+            for (int n = 0; n < n_batch; ++n) {
+                Box realspace_bx = (m_periodic_single_box) ? mf[n]->box(mfi.index()) : (*mf[n])[mfi].box();
+                realspace_bx.enclosedCells();
+                AMREX_ALWAYS_ASSERT( realspace_bx.contains(tmpRealField[mfi].box()) );
+                mf_arr[n] = (*mf[n])[mfi].const_array();
+            }
+            const Array4<Real> tmp_arr = tmpRealField[mfi].array();
+            ParallelFor( tmpRealField[mfi].box(), n_batch,
+            [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
+                tmp_arr(i,j,k,n) = mf_arr[n](i,j,k);
+            });
+        }
+
+        // Perform the Fourier transforms of all components at once
+        ablastr::math::anyfft::Execute(forward_plan_batch[mfi]);
+
+        // Copy the components of `tmpSpectralField` to the appropriate
+        // indices of the FabArray `fields`, with the correcting shift factors
+        {
+            const Array4<Complex> fields_arr = SpectralFieldData::fields[mfi].array();
+            const Array4<const Complex> tmp_arr = tmpSpectralField[mfi].array();
+#if (AMREX_SPACEDIM >= 2)
+            const Complex* xshift_arr = xshift_FFTfromCell[mfi].dataPtr();
+#endif
+#if defined(WARPX_DIM_3D)
+            const Complex* yshift_arr = yshift_FFTfromCell[mfi].dataPtr();
+#endif
+            const Complex* zshift_arr = zshift_FFTfromCell[mfi].dataPtr();
+            const Box spectralspace_bx = tmpSpectralField[mfi].box();
+
+            ParallelFor( spectralspace_bx, n_batch,
+            [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
+                Complex spectral_field_value = tmp_arr(i,j,k,n);
+#if defined(WARPX_DIM_3D)
+                if (!is_nodal[n][0]) { spectral_field_value *= xshift_arr[i]; }
+                if (!is_nodal[n][1]) { spectral_field_value *= yshift_arr[j]; }
+                if (!is_nodal[n][2]) { spectral_field_value *= zshift_arr[k]; }
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+                if (!is_nodal[n][0]) { spectral_field_value *= xshift_arr[i]; }
+                if (!is_nodal[n][1]) { spectral_field_value *= zshift_arr[j]; }
+#elif defined(WARPX_DIM_1D_Z)
+                if (!is_nodal[n][0]) { spectral_field_value *= zshift_arr[i]; }
+#endif
+                fields_arr(i,j,k,idx[n]) = spectral_field_value;
+            });
+        }
+
+        if (do_costs)
+        {
+            amrex::Gpu::synchronize();
+            wt = static_cast<amrex::Real>(amrex::second()) - wt;
+            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+        }
+    }
+}
+
 /* \brief Transform spectral field specified by `field_index` back to
  * real space, and store it in the component `i_comp` of `mf` */
 void
@@ -324,6 +538,14 @@ SpectralFieldData::BackwardTransform (const int lev,
                                       const amrex::IntVect& fill_guards,
                                       const int i_comp)
 {
+    if (NeedsGroupCopy(mf))
+    {
+        MultiFab group_mf = MakeGroupMultiFab(mf);
+        BackwardTransform(lev, group_mf, field_index, amrex::IntVect(1), 0);
+        CopyFromGroups(lev, group_mf, mf, fill_guards, i_comp);
+        return;
+    }
+
     amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
     const bool do_costs = WarpXUtilLoadBalance::doCosts(cost, mf.boxArray(), mf.DistributionMap());
 
@@ -340,24 +562,6 @@ SpectralFieldData::BackwardTransform (const int lev,
     const bool is_nodal_z = mf.is_nodal(0);
 #endif
 
-#if (AMREX_SPACEDIM >= 2)
-    const int si = (is_nodal_x) ? 1 : 0;
-#endif
-#if   defined(WARPX_DIM_1D_Z)
-    const int si = (is_nodal_z) ? 1 : 0;
-    const int sj = 0;
-    const int sk = 0;
-#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-    const int sj = (is_nodal_z) ? 1 : 0;
-    const int sk = 0;
-#elif defined(WARPX_DIM_3D)
-    const int sj = (is_nodal_y) ? 1 : 0;
-    const int sk = (is_nodal_z) ? 1 : 0;
-#endif
-
-    // Numbers of guard cells
-    const amrex::IntVect& mf_ng = mf.nGrowVect();
-
     // Loop over boxes
     // Note: we do NOT OpenMP parallelize here, since we use OpenMP threads for
     //       the iFFTs on each box!
@@ -410,62 +614,106 @@ SpectralFieldData::BackwardTransform (const int lev,
 
         // Copy the temporary field tmpRealField to the real-space field mf and
         // normalize, dividing by N, since (FFT + inverse FFT) results in a factor N
+        CopyFromTmpRealField(mf, mfi, tmpRealField[mfi].const_array(),
+                             1._rt / tmpRealField[mfi].box().numPts(),
+                             fill_guards, i_comp, m_periodic_single_box);
+
+        if (do_costs)
         {
-            amrex::Box mf_box = (m_periodic_single_box) ? mfi.validbox() : mfi.fabbox();
-            const amrex::Array4<amrex::Real> mf_arr = mf[mfi].array();
-            const amrex::Array4<const amrex::Real> tmp_arr = tmpRealField[mfi].array();
+            amrex::Gpu::synchronize();
+            wt = static_cast<amrex::Real>(amrex::second()) - wt;
+            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+        }
+    }
+}
 
-            const amrex::Real inv_N = 1._rt / tmpRealField[mfi].box().numPts();
 
-            // Total number of cells, including ghost cells (nj represents ny in 3D and nz in 2D)
-            const int ni = mf_box.length(0);
-#if   defined(WARPX_DIM_1D_Z)
-            constexpr int nj = 1;
-            constexpr int nk = 1;
-#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-            const int nj = mf_box.length(1);
-            constexpr int nk = 1;
-#elif defined(WARPX_DIM_3D)
-            const int nj = mf_box.length(1);
-            const int nk = mf_box.length(2);
+/* \brief Transform the three spectral fields specified by `field_index` back to
+ * real space with one batched FFT per box, and store them in the first
+ * component of the three MultiFabs `mf` */
+void
+SpectralFieldData::BackwardTransform (const int lev,
+                                      const std::array<amrex::MultiFab*,3>& mf,
+                                      const std::array<int,3>& field_index,
+                                      const amrex::IntVect& fill_guards)
+{
+    if (NeedsGroupCopy(*mf[0]))
+    {
+        std::array<MultiFab,3> group_mf = {MakeGroupMultiFab(*mf[0]),
+                                           MakeGroupMultiFab(*mf[1]),
+                                           MakeGroupMultiFab(*mf[2])};
+        BackwardTransform(lev, {&group_mf[0], &group_mf[1], &group_mf[2]}, field_index,
+                          amrex::IntVect(1));
+        for (int n = 0; n < n_batch; ++n) {
+            CopyFromGroups(lev, group_mf[n], *mf[n], fill_guards, 0);
+        }
+        return;
+    }
+
+    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
+    const bool do_costs = WarpXUtilLoadBalance::doCosts(cost, mf[0]->boxArray(), mf[0]->DistributionMap());
+
+    // Check the index type of each field, in order to apply proper shift in spectral space
+    amrex::GpuArray<amrex::GpuArray<int,AMREX_SPACEDIM>,n_batch> is_nodal;
+    amrex::GpuArray<int,n_batch> idx;
+    for (int n = 0; n < n_batch; ++n) {
+        for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+            is_nodal[n][dir] = mf[n]->is_nodal(dir) ? 1 : 0;
+        }
+        idx[n] = field_index[n];
+    }
+
+    // Loop over boxes
+    // Note: we do NOT OpenMP parallelize here, since we use OpenMP threads for
+    //       the iFFTs on each box!
+    for ( MFIter mfi(*mf[0]); mfi.isValid(); ++mfi ){
+        if (do_costs)
+        {
+            amrex::Gpu::synchronize();
+        }
+        auto wt = static_cast<amrex::Real>(amrex::second());
+
+        // Copy the spectral fields to the components of `tmpSpectralField`,
+        // with the correcting shift factors
+        {
+            const Array4<const Complex> field_arr = SpectralFieldData::fields[mfi].array();
+            const Array4<Complex> tmp_arr = tmpSpectralField[mfi].array();
+#if (AMREX_SPACEDIM >= 2)
+            const Complex* xshift_arr = xshift_FFTtoCell[mfi].dataPtr();
 #endif
-            // Lower bound of the box (lo_j represents lo_y in 3D and lo_z in 2D)
-            const int lo_i = amrex::lbound(mf_box).x;
-#if   defined(WARPX_DIM_1D_Z)
-            constexpr int lo_j = 0;
-            constexpr int lo_k = 0;
-#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-            const int lo_j = amrex::lbound(mf_box).y;
-            constexpr int lo_k = 0;
-#elif defined(WARPX_DIM_3D)
-            const int lo_j = amrex::lbound(mf_box).y;
-            const int lo_k = amrex::lbound(mf_box).z;
+#if defined(WARPX_DIM_3D)
+            const Complex* yshift_arr = yshift_FFTtoCell[mfi].dataPtr();
 #endif
-            // If necessary, do not fill the guard cells
-            // (shrink box by passing negative number of cells)
-            if (!m_periodic_single_box)
-            {
-                for (int dir = 0; dir < AMREX_SPACEDIM; dir++)
-                {
-                    if ((fill_guards[dir]) == 0) { mf_box.grow(dir, -mf_ng[dir]); }
-                }
-            }
+            const Complex* zshift_arr = zshift_FFTtoCell[mfi].dataPtr();
+            const Box spectralspace_bx = tmpSpectralField[mfi].box();
 
-            // Loop over cells within full box, including ghost cells
-            ParallelFor(mf_box, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
-            {
-                // Assume periodicity and set the last outer guard cell equal to the first one:
-                // this is necessary in order to get the correct value along a nodal direction,
-                // because the last point along a nodal direction is always discarded when FFTs
-                // are computed, as the real-space box is always cell-centered.
-                const int ii = (i == lo_i + ni - si) ? lo_i : i;
-                const int jj = (j == lo_j + nj - sj) ? lo_j : j;
-                const int kk = (k == lo_k + nk - sk) ? lo_k : k;
-                // Copy and normalize field
-                mf_arr(i,j,k,i_comp) = inv_N * tmp_arr(ii,jj,kk);
+            ParallelFor( spectralspace_bx, n_batch,
+            [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
+                Complex spectral_field_value = field_arr(i,j,k,idx[n]);
+#if defined(WARPX_DIM_3D)
+                if (!is_nodal[n][0]) { spectral_field_value *= xshift_arr[i]; }
+                if (!is_nodal[n][1]) { spectral_field_value *= yshift_arr[j]; }
+                if (!is_nodal[n][2]) { spectral_field_value *= zshift_arr[k]; }
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+                if (!is_nodal[n][0]) { spectral_field_value *= xshift_arr[i]; }
+                if (!is_nodal[n][1]) { spectral_field_value *= zshift_arr[j]; }
+#elif defined(WARPX_DIM_1D_Z)
+                if (!is_nodal[n][0]) { spectral_field_value *= zshift_arr[i]; }
+#endif
+                tmp_arr(i,j,k,n) = spectral_field_value;
             });
         }
 
+        // Perform the inverse Fourier transforms of all components at once
+        ablastr::math::anyfft::Execute(backward_plan_batch[mfi]);
+
+        // Copy the components of tmpRealField to the real-space fields and normalize
+        const amrex::Real inv_N = 1._rt / tmpRealField[mfi].box().numPts();
+        for (int n = 0; n < n_batch; ++n) {
+            CopyFromTmpRealField(*mf[n], mfi, tmpRealField[mfi].const_array(n),
+                                 inv_N, fill_guards, 0, m_periodic_single_box);
+        }
+
         if (do_costs)
         {
             amrex::Gpu::synchronize();
@@ -475,4 +723,48 @@ SpectralFieldData::BackwardTransform (const int lev,
     }
 }
 
+bool
+SpectralFieldData::NeedsGroupCopy (const MultiFab& mf) const
+{
+    return !m_group_ba.empty() && !mf.boxArray().CellEqual(m_group_ba);
+}
+
+MultiFab
+SpectralFieldData::MakeGroupMultiFab (const MultiFab& mf) const
+{
+    return MultiFab(amrex::convert(m_group_ba, mf.ixType()), tmpRealField.DistributionMap(),
+                    1, m_group_ng);
+}
+
+MultiFab
+SpectralFieldData::CopyToGroups (const int lev, const MultiFab& mf, const int i_comp) const
+{
+    const amrex::Periodicity period = WarpX::GetInstance().Geom(lev).periodicity();
+
+    MultiFab group_mf = MakeGroupMultiFab(mf);
+    group_mf.setVal(0._rt);
+    // Copy the guard cells of `mf` first, and then its valid cells,
+    // which take precedence where they overlap
+    group_mf.ParallelCopy(mf, i_comp, 0, 1, mf.nGrowVect(), m_group_ng, period);
+    group_mf.ParallelCopy(mf, i_comp, 0, 1, amrex::IntVect(0), m_group_ng, period);
+    return group_mf;
+}
+
+void
+SpectralFieldData::CopyFromGroups (const int lev, const MultiFab& group_mf, MultiFab& mf,
+                                   const amrex::IntVect& fill_guards, const int i_comp) const
+{
+    const amrex::Periodicity period = WarpX::GetInstance().Geom(lev).periodicity();
+
+    amrex::IntVect dst_ng = mf.nGrowVect();
+    for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+        if (fill_guards[dir] == 0) { dst_ng[dir] = 0; }
+    }
+    // Copy the guard cells of the groups first, and then their valid cells,
+    // which take precedence where they overlap: inside a group, the guard cells
+    // of the boxes thus receive the values computed in the interior of the group
+    mf.ParallelCopy(group_mf, 0, i_comp, 1, m_group_ng, dst_ng, period);
+    mf.ParallelCopy(group_mf, 0, i_comp, 1, amrex::IntVect(0), dst_ng, period);
+}
+
 #endif // WARPX_USE_FFT
@@ -193,7 +193,8 @@ HankelTransform::HankelTransform (int const hankel_order,
 
 void
 HankelTransform::HankelForwardTransform (amrex::FArrayBox const& F, int const F_icomp,
-                                         amrex::FArrayBox      & G, int const G_icomp)
+                                         amrex::FArrayBox      & G, int const G_icomp,
+                                         int const ncomp)
 {
     WARPX_PROFILE("HankelTransform::HankelForwardTransform");
 
@@ -208,14 +209,16 @@ HankelTransform::HankelForwardTransform (amrex::FArrayBox const& F, int const F_
     AMREX_ALWAYS_ASSERT(nz == G_box.length(1));
     AMREX_ALWAYS_ASSERT(ngr >= 0);
     AMREX_ALWAYS_ASSERT(F_box.bigEnd(0)+1 >= m_nr);
+    AMREX_ALWAYS_ASSERT(F_icomp + ncomp <= F.nComp() && G_icomp + ncomp <= G.nComp());
 
     // We perform stream synchronization since `gemm` may be running
     // on a different stream.
     amrex::Gpu::streamSynchronize();
 
     // Note that M is flagged to be transposed since it has dimensions (m_nr, m_nk)
+    // The ncomp components are treated as nz*ncomp columns
     blas::gemm(blas::Layout::ColMajor, blas::Op::Trans, blas::Op::NoTrans,
-               m_nk, nz, m_nr, 1._rt,
+               m_nk, nz*ncomp, m_nr, 1._rt,
                m_M.dataPtr(), m_nk,
                F.dataPtr(F_icomp)+ngr, nrF, 0._rt,
                G.dataPtr(G_icomp), m_nk
@@ -232,7 +235,8 @@ HankelTransform::HankelForwardTransform (amrex::FArrayBox const& F, int const F_
 
 void
 HankelTransform::HankelInverseTransform (amrex::FArrayBox const& G, int const G_icomp,
-                                         amrex::FArrayBox      & F, int const F_icomp)
+                                         amrex::FArrayBox      & F, int const F_icomp,
+                                         int const ncomp)
 {
     WARPX_PROFILE("HankelTransform::HankelInverseTransform");
 
@@ -247,14 +251,16 @@ HankelTransform::HankelInverseTransform (amrex::FArrayBox const& G, int const G_
     AMREX_ALWAYS_ASSERT(nz == G_box.length(1));
     AMREX_ALWAYS_ASSERT(ngr >= 0);
     AMREX_ALWAYS_ASSERT(F_box.bigEnd(0)+1 >= m_nr);
+    AMREX_ALWAYS_ASSERT(F_icomp + ncomp <= F.nComp() && G_icomp + ncomp <= G.nComp());
 
     // We perform stream synchronization since `gemm` may be running
     // on a different stream.
     amrex::Gpu::streamSynchronize();
 
     // Note that m_invM is flagged to be transposed since it has dimensions (m_nk, m_nr)
+    // The ncomp components are treated as nz*ncomp columns
     blas::gemm(blas::Layout::ColMajor, blas::Op::Trans, blas::Op::NoTrans,
-               m_nr, nz, m_nk, 1._rt,
+               m_nr, nz*ncomp, m_nk, 1._rt,
                m_invM.dataPtr(), m_nr,
                G.dataPtr(G_icomp), m_nk, 0._rt,
                F.dataPtr(F_icomp)+ngr, nrF
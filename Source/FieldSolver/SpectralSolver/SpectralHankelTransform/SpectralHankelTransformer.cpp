@@ -73,9 +73,9 @@ SpectralHankelTransformer::PhysicalToSpectral_Scalar (amrex::FArrayBox const & F
             dht0[mode]->HankelForwardTransform(F_physical, icomp, G_spectral, mode_r);
             G_spectral.setVal<amrex::RunOn::Device>(0., mode_i);
         } else {
+            // Real and imaginary parts at once
             int const icomp = 2*mode - 1;
-            dht0[mode]->HankelForwardTransform(F_physical, icomp  , G_spectral, mode_r);
-            dht0[mode]->HankelForwardTransform(F_physical, icomp+1, G_spectral, mode_i);
+            dht0[mode]->HankelForwardTransform(F_physical, icomp, G_spectral, mode_r, 2);
         }
     }
 }
@@ -96,34 +96,32 @@ SpectralHankelTransformer::PhysicalToSpectral_Vector (amrex::Box const & box,
     amrex::Array4<amrex::Real> const & F_r_physical_array = F_r_physical.array();
     amrex::Array4<amrex::Real> const & F_t_physical_array = F_t_physical.array();
 
-    for (int mode=0 ; mode < m_n_rz_azimuthal_modes ; mode++) {
-
+    // Combine the components of all modes in one kernel
+    amrex::ParallelFor(box, m_n_rz_azimuthal_modes,
+    [=] AMREX_GPU_DEVICE (int i, int j, int k, int mode)
+    {
         int const mode_r = 2*mode;
         int const mode_i = 2*mode + 1;
+        amrex::Real const r_real = F_r_physical_array(i,j,k,mode_r);
+        amrex::Real const r_imag = F_r_physical_array(i,j,k,mode_i);
+        amrex::Real const t_real = F_t_physical_array(i,j,k,mode_r);
+        amrex::Real const t_imag = F_t_physical_array(i,j,k,mode_i);
+        // Combine the values
+        // temp_p = (F_r - I*F_t)/2
+        // temp_m = (F_r + I*F_t)/2
+        F_r_physical_array(i,j,k,mode_r) = 0.5_rt*(r_real + t_imag);
+        F_r_physical_array(i,j,k,mode_i) = 0.5_rt*(r_imag - t_real);
+        F_t_physical_array(i,j,k,mode_r) = 0.5_rt*(r_real - t_imag);
+        F_t_physical_array(i,j,k,mode_i) = 0.5_rt*(r_imag + t_real);
+    });
 
-        amrex::ParallelFor(box,
-        [=] AMREX_GPU_DEVICE (int i, int j, int k)
-        {
-            amrex::Real const r_real = F_r_physical_array(i,j,k,mode_r);
-            amrex::Real const r_imag = F_r_physical_array(i,j,k,mode_i);
-            amrex::Real const t_real = F_t_physical_array(i,j,k,mode_r);
-            amrex::Real const t_imag = F_t_physical_array(i,j,k,mode_i);
-            // Combine the values
-            // temp_p = (F_r - I*F_t)/2
-            // temp_m = (F_r + I*F_t)/2
-            F_r_physical_array(i,j,k,mode_r) = 0.5_rt*(r_real + t_imag);
-            F_r_physical_array(i,j,k,mode_i) = 0.5_rt*(r_imag - t_real);
-            F_t_physical_array(i,j,k,mode_r) = 0.5_rt*(r_real - t_imag);
-            F_t_physical_array(i,j,k,mode_i) = 0.5_rt*(r_imag + t_real);
-        });
-
-        amrex::Gpu::streamSynchronize();
-
-        dhtp[mode]->HankelForwardTransform(F_r_physical, mode_r, G_p_spectral, mode_r);
-        dhtp[mode]->HankelForwardTransform(F_r_physical, mode_i, G_p_spectral, mode_i);
-        dhtm[mode]->HankelForwardTransform(F_t_physical, mode_r, G_m_spectral, mode_r);
-        dhtm[mode]->HankelForwardTransform(F_t_physical, mode_i, G_m_spectral, mode_i);
+    amrex::Gpu::streamSynchronize();
 
+    for (int mode=0 ; mode < m_n_rz_azimuthal_modes ; mode++) {
+        // Real and imaginary parts at once
+        int const mode_r = 2*mode;
+        dhtp[mode]->HankelForwardTransform(F_r_physical, mode_r, G_p_spectral, mode_r, 2);
+        dhtm[mode]->HankelForwardTransform(F_t_physical, mode_r, G_m_spectral, mode_r, 2);
     }
 }
 
@@ -147,9 +145,9 @@ SpectralHankelTransformer::SpectralToPhysical_Scalar (amrex::FArrayBox const & G
             int const icomp = 0;
             dht0[mode]->HankelInverseTransform(G_spectral, mode_r, F_physical, icomp);
         } else {
+            // Real and imaginary parts at once
             int const icomp = 2*mode - 1;
-            dht0[mode]->HankelInverseTransform(G_spectral, mode_r, F_physical, icomp);
-            dht0[mode]->HankelInverseTransform(G_spectral, mode_i, F_physical, icomp+1);
+            dht0[mode]->HankelInverseTransform(G_spectral, mode_r, F_physical, icomp, 2);
         }
     }
 }
@@ -167,35 +165,33 @@ SpectralHankelTransformer::SpectralToPhysical_Vector (amrex::Box const & box,
     amrex::Array4<amrex::Real> const & F_r_physical_array = F_r_physical.array();
     amrex::Array4<amrex::Real> const & F_t_physical_array = F_t_physical.array();
 
-    for (int mode=0 ; mode < m_n_rz_azimuthal_modes ; mode++) {
+    amrex::Gpu::streamSynchronize();
 
+    for (int mode=0 ; mode < m_n_rz_azimuthal_modes ; mode++) {
+        // Real and imaginary parts at once
         int const mode_r = 2*mode;
-        int const mode_i = 2*mode + 1;
-
-        amrex::Gpu::streamSynchronize();
-
-        dhtp[mode]->HankelInverseTransform(G_p_spectral, mode_r, F_r_physical, mode_r);
-        dhtp[mode]->HankelInverseTransform(G_p_spectral, mode_i, F_r_physical, mode_i);
-        dhtm[mode]->HankelInverseTransform(G_m_spectral, mode_r, F_t_physical, mode_r);
-        dhtm[mode]->HankelInverseTransform(G_m_spectral, mode_i, F_t_physical, mode_i);
-
-        amrex::Gpu::streamSynchronize();
+        dhtp[mode]->HankelInverseTransform(G_p_spectral, mode_r, F_r_physical, mode_r, 2);
+        dhtm[mode]->HankelInverseTransform(G_m_spectral, mode_r, F_t_physical, mode_r, 2);
+    }
 
-        amrex::ParallelFor(box,
-        [=] AMREX_GPU_DEVICE (int i, int j, int k)
-        {
-            amrex::Real const p_real = F_r_physical_array(i,j,k,mode_r);
-            amrex::Real const p_imag = F_r_physical_array(i,j,k,mode_i);
-            amrex::Real const m_real = F_t_physical_array(i,j,k,mode_r);
-            amrex::Real const m_imag = F_t_physical_array(i,j,k,mode_i);
-            // Combine the values
-            // F_r =    G_p + G_m
-            // F_t = I*(G_p - G_m)
-            F_r_physical_array(i,j,k,mode_r) =  p_real + m_real;
-            F_r_physical_array(i,j,k,mode_i) =  p_imag + m_imag;
-            F_t_physical_array(i,j,k,mode_r) = -p_imag + m_imag;
-            F_t_physical_array(i,j,k,mode_i) =  p_real - m_real;
-        });
+    amrex::Gpu::streamSynchronize();
 
-    }
+    // Combine the components of all modes in one kernel
+    amrex::ParallelFor(box, m_n_rz_azimuthal_modes,
+    [=] AMREX_GPU_DEVICE (int i, int j, int k, int mode)
+    {
+        int const mode_r = 2*mode;
+        int const mode_i = 2*mode + 1;
+        amrex::Real const p_real = F_r_physical_array(i,j,k,mode_r);
+        amrex::Real const p_imag = F_r_physical_array(i,j,k,mode_i);
+        amrex::Real const m_real = F_t_physical_array(i,j,k,mode_r);
+        amrex::Real const m_imag = F_t_physical_array(i,j,k,mode_i);
+        // Combine the values
+        // F_r =    G_p + G_m
+        // F_t = I*(G_p - G_m)
+        F_r_physical_array(i,j,k,mode_r) =  p_real + m_real;
+        F_r_physical_array(i,j,k,mode_i) =  p_imag + m_imag;
+        F_t_physical_array(i,j,k,mode_r) = -p_imag + m_imag;
+        F_t_physical_array(i,j,k,mode_i) =  p_real - m_real;
+    });
 }
@@ -13,9 +13,13 @@
 #include "SpectralAlgorithms/PsatdAlgorithmJLinearInTime.H"
 #include "SpectralKSpace.H"
 #include "SpectralSolver.H"
+#include "Utils/KernelCounters.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXProfilerWrapper.H"
+#include "WarpX.H"
+
+#include <AMReX_MFIter.H>
 
 #include <memory>
 
@@ -37,7 +41,8 @@ SpectralSolver::SpectralSolver(
                 const int J_in_time,
                 const int rho_in_time,
                 const bool dive_cleaning,
-                const bool divb_cleaning)
+                const bool divb_cleaning,
+                const amrex::BoxArray& fft_group_ba)
 {
     // Initialize all structures using the same distribution mapping dm
 
@@ -105,14 +110,16 @@ SpectralSolver::SpectralSolver(
             {
                 algorithm = std::make_unique<PsatdAlgorithmJLinearInTime>(
                     k_space, dm, m_spectral_index, norder_x, norder_y, norder_z, grid_type,
-                    dt, fft_do_time_averaging, dive_cleaning, divb_cleaning);
+                    dt, fft_do_time_averaging, dive_cleaning, divb_cleaning,
+                    WarpX::psatd_on_the_fly_coefficients);
             }
         }
     }
 
     // - Initialize arrays for fields in spectral space + FFT plans
     field_data = SpectralFieldData(lev, realspace_ba, k_space, dm,
-                                   m_spectral_index.n_fields, periodic_single_box);
+                                   m_spectral_index.n_fields, periodic_single_box,
+                                   fft_group_ba);
 }
 
 void
@@ -136,13 +143,44 @@ SpectralSolver::BackwardTransform( const int lev,
     field_data.BackwardTransform(lev, mf, field_index, fill_guards, i_comp);
 }
 
+void
+SpectralSolver::ForwardTransform (const int lev,
+                                  const std::array<const amrex::MultiFab*,3>& mf,
+                                  const std::array<int,3>& field_index)
+{
+    WARPX_PROFILE("SpectralSolver::ForwardTransform");
+    field_data.ForwardTransform(lev, mf, field_index);
+}
+
+void
+SpectralSolver::BackwardTransform (const int lev,
+                                   const std::array<amrex::MultiFab*,3>& mf,
+                                   const std::array<int,3>& field_index,
+                                   const amrex::IntVect& fill_guards)
+{
+    WARPX_PROFILE("SpectralSolver::BackwardTransform");
+    field_data.BackwardTransform(lev, mf, field_index, fill_guards);
+}
+
 void
 SpectralSolver::pushSpectralFields(){
     WARPX_PROFILE("SpectralSolver::pushSpectralFields");
     // Virtual function: the actual function used here depends
     // on the sub-class of `SpectralBaseAlgorithm` that was
     // initialized in the constructor of `SpectralSolver`
+    const double kernel_start = KernelCounters::Start();
     algorithm->pushSpectralFields( field_data );
+    if (KernelCounters::IsEnabled()) {
+        double ncells = 0.;
+        for (amrex::MFIter mfi(field_data.fields); mfi.isValid(); ++mfi) {
+            ncells += static_cast<double>(mfi.validbox().numPts());
+        }
+        // Each spectral component is read and written (complex values), and the
+        // 6 components of E and B are linear combinations of all the components
+        const auto ncomp = static_cast<double>(field_data.fields.nComp());
+        KernelCounters::StopCellKernel(KernelCounters::PSATDPush, kernel_start, ncells,
+                                       4.*ncomp, 6.*8.*ncomp);
+    }
 }
 
 #endif // WARPX_USE_FFT
@@ -9,6 +9,9 @@
 #include "WarpX.H"
 
 #include "BoundaryConditions/PML.H"
+#include "Diagnostics/Diagnostics.H"
+#include "Diagnostics/MultiDiagnostics.H"
+#include "Diagnostics/ReducedDiags/MultiReducedDiags.H"
 #include "Evolve/WarpXDtType.H"
 #include "FieldSolver/FiniteDifferenceSolver/FiniteDifferenceSolver.H"
 #if defined(WARPX_USE_FFT)
@@ -21,6 +24,8 @@
 #   endif
 #endif
 #include "Python/callbacks.H"
+#include "Utils/KernelCounters.H"
+#include "Utils/PhaseTimer.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXConst.H"
@@ -71,9 +76,10 @@ namespace {
         solver.ForwardTransform(lev, *vector_field[0], compx, *vector_field[1], compy);
         solver.ForwardTransform(lev, *vector_field[2], compz);
 #else
-        solver.ForwardTransform(lev, *vector_field[0], compx);
-        solver.ForwardTransform(lev, *vector_field[1], compy);
-        solver.ForwardTransform(lev, *vector_field[2], compz);
+        // One batched FFT per box for the three components
+        solver.ForwardTransform(lev,
+            {vector_field[0].get(), vector_field[1].get(), vector_field[2].get()},
+            {compx, compy, compz});
 #endif
     }
 
@@ -93,9 +99,10 @@ namespace {
         solver.BackwardTransform(lev, *vector_field[0], compx, *vector_field[1], compy);
         solver.BackwardTransform(lev, *vector_field[2], compz);
 #else
-        solver.BackwardTransform(lev, *vector_field[0], compx, fill_guards);
-        solver.BackwardTransform(lev, *vector_field[1], compy, fill_guards);
-        solver.BackwardTransform(lev, *vector_field[2], compz, fill_guards);
+        // One batched FFT per box for the three components
+        solver.BackwardTransform(lev,
+            {vector_field[0].get(), vector_field[1].get(), vector_field[2].get()},
+            {compx, compy, compz}, fill_guards);
 #endif
     }
 }
@@ -415,6 +422,23 @@ void WarpX::PSATDCurrentCorrection ()
     }
 }
 
+bool WarpX::RealSpaceCurrentNeeded ()
+{
+    const int step = istep[0];
+
+    // Last step: the diagnostics are flushed, and J may be moved with the moving window
+    if (step == max_step - 1 || t_new[0] + dt[0] >= stop_time - 1.e-3*dt[0]) { return true; }
+
+    for (int i_diag = 0; i_diag < multi_diags->GetTotalDiags(); ++i_diag) {
+        if (multi_diags->GetDiag(i_diag).DoComputeAndPack(step)) { return true; }
+    }
+    if (reduced_diags->m_plot_rd != 0) { return true; }
+
+    return IsPythonCallbackInstalled("afterstep") ||
+        IsPythonCallbackInstalled("afterdiagnostics") ||
+        IsPythonCallbackInstalled("beforestep");
+}
+
 void WarpX::PSATDVayDeposition ()
 {
     for (int lev = 0; lev <= finest_level; ++lev)
@@ -650,6 +674,7 @@ WarpX::PSATDScaleAverageFields (const amrex::Real scale_factor)
 void
 WarpX::PushPSATD ()
 {
+    PhaseTimer::Scope const phase_timer(PhaseTimer::FieldSolve);
 #ifndef WARPX_USE_FFT
     WARPX_ABORT_WITH_MESSAGE(
         "PushFieldsEM: PSATD solver selected but not built");
@@ -670,8 +695,11 @@ WarpX::PushPSATD ()
             // Correct J in k-space
             PSATDCurrentCorrection();
 
-            // Inverse FFT of J
-            PSATDBackwardTransformJ(current_fp, current_cp);
+            // Inverse FFT of J: the fields are pushed with the corrected J in k-space,
+            // so that this is only needed if J is read in real space later in the step
+            if (!skip_backward_transform_J || RealSpaceCurrentNeeded()) {
+                PSATDBackwardTransformJ(current_fp, current_cp);
+            }
         }
         else if (current_deposition_algo == CurrentDepositionAlgo::Vay)
         {
@@ -818,8 +846,10 @@ WarpX::EvolveB (int lev, amrex::Real a_dt, DtType a_dt_type)
 void
 WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real a_dt, DtType a_dt_type)
 {
+    PhaseTimer::Scope const phase_timer(PhaseTimer::FieldSolve);
 
     // Evolve B field in regular cells
+    const double kernel_start = KernelCounters::Start();
     if (patch_type == PatchType::fine) {
         m_fdtd_solver_fp[lev]->EvolveB(Bfield_fp[lev], Efield_fp[lev], G_fp[lev],
                                        m_face_areas[lev], m_area_mod[lev], ECTRhofield[lev], Venl[lev],
@@ -829,6 +859,12 @@ WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real a_dt, DtType a_dt_typ
                                        m_face_areas[lev], m_area_mod[lev], ECTRhofield[lev], Venl[lev],
                                        m_flag_info_face[lev], m_borrowing[lev], lev, a_dt);
     }
+    if (KernelCounters::IsEnabled()) {
+        // Yee stencil: E and B read, B written; two differences per component
+        const auto& Bx = (patch_type == PatchType::fine) ? Bfield_fp[lev][0] : Bfield_cp[lev][0];
+        KernelCounters::StopCellKernel(KernelCounters::EvolveB, kernel_start,
+                                       KernelCounters::LocalNumCells(*Bx), 9., 18.);
+    }
 
     // Evolve B field in PML cells
     if (do_pml && pml[lev]->ok()) {
@@ -846,43 +882,62 @@ WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real a_dt, DtType a_dt_typ
 
 
 void
-WarpX::EvolveE (amrex::Real a_dt)
+WarpX::EvolveE (amrex::Real a_dt, FieldUpdateRegion region)
 {
     for (int lev = 0; lev <= finest_level; ++lev)
     {
-        EvolveE(lev, a_dt);
+        EvolveE(lev, a_dt, region);
     }
 
     // Allow execution of Python callback after E-field push
-    ExecutePythonCallback("afterEpush");
+    if (region != FieldUpdateRegion::interior) {
+        ExecutePythonCallback("afterEpush");
+    }
 }
 
 void
-WarpX::EvolveE (int lev, amrex::Real a_dt)
+WarpX::EvolveE (int lev, amrex::Real a_dt, FieldUpdateRegion region)
 {
     WARPX_PROFILE("WarpX::EvolveE()");
-    EvolveE(lev, PatchType::fine, a_dt);
+    EvolveE(lev, PatchType::fine, a_dt, region);
     if (lev > 0)
     {
-        EvolveE(lev, PatchType::coarse, a_dt);
+        EvolveE(lev, PatchType::coarse, a_dt, region);
     }
 }
 
 void
-WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt)
+WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt, FieldUpdateRegion region)
 {
+    PhaseTimer::Scope const phase_timer(PhaseTimer::FieldSolve);
     // Evolve E field in regular cells
+    // (when the update is split, the interior only reads B in the valid cells)
+    const double kernel_start = KernelCounters::Start();
     if (patch_type == PatchType::fine) {
         m_fdtd_solver_fp[lev]->EvolveE(Efield_fp[lev], Bfield_fp[lev],
                                        current_fp[lev], m_edge_lengths[lev],
                                        m_face_areas[lev], ECTRhofield[lev],
-                                       F_fp[lev], lev, a_dt );
+                                       F_fp[lev], lev, a_dt,
+                                       region, guard_cells.ng_FieldSolver );
     } else {
         m_fdtd_solver_cp[lev]->EvolveE(Efield_cp[lev], Bfield_cp[lev],
                                        current_cp[lev], m_edge_lengths[lev],
                                        m_face_areas[lev], ECTRhofield[lev],
-                                       F_cp[lev], lev, a_dt );
+                                       F_cp[lev], lev, a_dt,
+                                       region, guard_cells.ng_FieldSolver );
     }
+    if (KernelCounters::IsEnabled()) {
+        // Yee stencil: E, B and J read, E written; two differences per component.
+        // When the update is split, the cells are counted with the interior.
+        const auto& Ex = (patch_type == PatchType::fine) ? Efield_fp[lev][0] : Efield_cp[lev][0];
+        const double ncells = (region == FieldUpdateRegion::shell) ?
+            0. : KernelCounters::LocalNumCells(*Ex);
+        KernelCounters::StopCellKernel(KernelCounters::EvolveE, kernel_start, ncells, 12., 24.);
+    }
+
+    // The PML, the boundary conditions and ECTRhofield are updated
+    // once the whole valid region has been updated
+    if (region == FieldUpdateRegion::interior) { return; }
 
     // Evolve E field in PML cells
     if (do_pml && pml[lev]->ok()) {
@@ -921,6 +976,109 @@ WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt)
 }
 
 
+void
+WarpX::EvolveBEBBlocked (amrex::Real a_dt)
+{
+    PhaseTimer::Scope const phase_timer(PhaseTimer::FieldSolve);
+    WARPX_PROFILE("WarpX::EvolveBEBBlocked()");
+
+    // Only level 0, in vacuum with periodic boundaries (checked in ReadParameters):
+    // there is no PML and no boundary condition to apply in between the updates.
+    const int lev = 0;
+
+    // The first half push of B and the push of E also update guard cells of
+    // each box, which must therefore be valid beforehand
+    const amrex::IntVect ng_E = FiniteDifferenceSolver::BEBBlockedGuardCellsE();
+    const amrex::IntVect ng_B = FiniteDifferenceSolver::BEBBlockedGuardCellsB();
+    if (!guard_cells.ng_FieldGather.allGE(ng_E)) {
+        FillBoundaryE(lev, ng_E, WarpX::sync_nodal_points);
+    }
+    if (!guard_cells.ng_FieldGather.allGE(ng_B)) {
+        FillBoundaryB(lev, ng_B, WarpX::sync_nodal_points);
+    }
+
+    m_fdtd_solver_fp[lev]->EvolveBEBBlocked(Efield_fp[lev], Bfield_fp[lev],
+                                            current_fp[lev], lev, a_dt);
+
+    // E was also updated in 1 guard cell. Fill the others if the solver needs them.
+    if (!amrex::IntVect(1).allGE(guard_cells.ng_FieldSolver)) {
+        FillBoundaryE(lev, guard_cells.ng_FieldSolver, WarpX::sync_nodal_points);
+    }
+
+    // The Python callbacks of the individual pushes are called once, after the sweep
+    ExecutePythonCallback("afterBpush");
+    ExecutePythonCallback("afterEpush");
+}
+
+
+void
+WarpX::UpdateCleaningActiveBoxes ()
+{
+    if (localized_cleaning_distance < 0 || !(do_dive_cleaning || do_divb_cleaning)) { return; }
+
+    WARPX_PROFILE("WarpX::UpdateCleaningActiveBoxes()");
+
+    const amrex::IntVect distance(localized_cleaning_distance);
+
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        const amrex::BoxArray& ba = boxArray(lev);
+        const auto nboxes = static_cast<int>(ba.size());
+
+        // The refined levels are small: F and G are evolved in all their boxes
+        amrex::Vector<int> active(nboxes, lev > 0 ? 1 : 0);
+        if (lev == 0)
+        {
+            // Boxes with particles (including the laser antennas), and finer patches,
+            // grown by the distance
+            amrex::BoxList sources(ba.ixType());
+            const amrex::Vector<amrex::Long> npart = mypc->NumberOfParticlesInGrid(lev);
+            for (int i = 0; i < nboxes; ++i) {
+                if (npart[i] > 0) { sources.push_back(amrex::grow(ba[i], distance)); }
+            }
+            if (finest_level > lev) {
+                const amrex::BoxArray& fine_ba = boxArray(lev+1);
+                for (int i = 0; i < static_cast<int>(fine_ba.size()); ++i) {
+                    sources.push_back(amrex::grow(amrex::coarsen(fine_ba[i], refRatio(lev)), distance));
+                }
+            }
+            if (!sources.isEmpty()) {
+                const amrex::BoxArray sources_ba(std::move(sources));
+                for (int i = 0; i < nboxes; ++i) {
+                    active[i] = sources_ba.intersects(ba[i]) ? 1 : 0;
+                }
+            }
+        }
+
+        // F and G are kept at zero in the inactive boxes, so that they do not act on E and B
+        auto& previous = m_cleaning_active_boxes[lev];
+        const bool same_grids = (static_cast<int>(previous.size()) == nboxes);
+        const auto zero_inactive = [&] (amrex::MultiFab* mf) {
+            if (!mf) { return; }
+            for (amrex::MFIter mfi(*mf); mfi.isValid(); ++mfi) {
+                const int i = mfi.index();
+                if (!active[i] && (!same_grids || previous[i])) {
+                    (*mf)[mfi].setVal<amrex::RunOn::Device>(0._rt);
+                }
+            }
+        };
+        if (do_dive_cleaning) { zero_inactive(F_fp[lev].get()); }
+        if (do_divb_cleaning) { zero_inactive(G_fp[lev].get()); }
+
+        previous = std::move(active);
+    }
+}
+
+amrex::Vector<int> const*
+WarpX::CleaningActiveBoxes (int lev, amrex::MultiFab const& mf) const
+{
+    if (localized_cleaning_distance < 0) { return nullptr; }
+    auto const& active = m_cleaning_active_boxes[lev];
+    // Before the first update, or if the grids changed since then, all boxes are active
+    if (static_cast<int>(active.size()) != static_cast<int>(mf.boxArray().size())) { return nullptr; }
+    return &active;
+}
+
 void
 WarpX::EvolveF (amrex::Real a_dt, DtType a_dt_type)
 {
@@ -944,6 +1102,7 @@ WarpX::EvolveF (int lev, amrex::Real a_dt, DtType a_dt_type)
 void
 WarpX::EvolveF (int lev, PatchType patch_type, amrex::Real a_dt, DtType a_dt_type)
 {
+    PhaseTimer::Scope const phase_timer(PhaseTimer::FieldSolve);
     if (!do_dive_cleaning) { return; }
 
     WARPX_PROFILE("WarpX::EvolveF()");
@@ -951,9 +1110,11 @@ WarpX::EvolveF (int lev, PatchType patch_type, amrex::Real a_dt, DtType a_dt_typ
     const int rhocomp = (a_dt_type == DtType::FirstHalf) ? 0 : 1;
 
     // Evolve F field in regular cells
+    // (only in the active boxes with warpx.localized_cleaning_distance)
     if (patch_type == PatchType::fine) {
         m_fdtd_solver_fp[lev]->EvolveF( F_fp[lev], Efield_fp[lev],
-                                        rho_fp[lev], rhocomp, a_dt );
+                                        rho_fp[lev], rhocomp, a_dt,
+                                        CleaningActiveBoxes(lev, *F_fp[lev]) );
     } else {
         m_fdtd_solver_cp[lev]->EvolveF( F_cp[lev], Efield_cp[lev],
                                         rho_cp[lev], rhocomp, a_dt );
@@ -998,6 +1159,7 @@ WarpX::EvolveG (int lev, amrex::Real a_dt, DtType a_dt_type)
 void
 WarpX::EvolveG (int lev, PatchType patch_type, amrex::Real a_dt, DtType /*a_dt_type*/)
 {
+    PhaseTimer::Scope const phase_timer(PhaseTimer::FieldSolve);
     if (!do_divb_cleaning) { return; }
 
     WARPX_PROFILE("WarpX::EvolveG()");
@@ -1005,7 +1167,8 @@ WarpX::EvolveG (int lev, PatchType patch_type, amrex::Real a_dt, DtType /*a_dt_t
     // Evolve G field in regular cells
     if (patch_type == PatchType::fine)
     {
-        m_fdtd_solver_fp[lev]->EvolveG(G_fp[lev], Bfield_fp[lev], a_dt);
+        m_fdtd_solver_fp[lev]->EvolveG(G_fp[lev], Bfield_fp[lev], a_dt,
+                                       CleaningActiveBoxes(lev, *G_fp[lev]));
     }
     else // coarse patch
     {
@@ -1038,6 +1201,7 @@ WarpX::MacroscopicEvolveE (int lev, amrex::Real a_dt) {
 
 void
 WarpX::MacroscopicEvolveE (int lev, PatchType patch_type, amrex::Real a_dt) {
+    PhaseTimer::Scope const phase_timer(PhaseTimer::FieldSolve);
 
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
         patch_type == PatchType::fine,
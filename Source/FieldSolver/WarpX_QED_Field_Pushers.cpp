@@ -22,7 +22,6 @@
 #include <AMReX_GpuAtomic.H>
 #include <AMReX_GpuControl.H>
 #include <AMReX_GpuDevice.H>
-#include <AMReX_GpuElixir.H>
 #include <AMReX_GpuLaunch.H>
 #include <AMReX_GpuQualifiers.H>
 #include <AMReX_IndexType.H>
@@ -103,11 +102,20 @@ WarpX::Hybrid_QED_Push (int lev, PatchType patch_type, amrex::Real a_dt)
 
     amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
 
+    // The corrections to E at a given node are non-linear functions of the values of E
+    // on the surronding nodes: they are computed for all the tiles before being added to E,
+    // so that modifications to one node do not influence the corrections to the surronding
+    // nodes. Only the valid nodes are corrected, so that the temporary has no guard cells.
+    MultiFab dE(Ex->boxArray(), Ex->DistributionMap(), 3, 0);
+
+    // Make local copy of xi, to use on device.
+    const Real xi_c2 = WarpX::quantum_xi_c2;
+
     // Loop through the grids, and over the tiles within each grid
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
-    for ( MFIter mfi(*Bx, TilingIfNotGPU()); mfi.isValid(); ++mfi )
+    for ( MFIter mfi(dE, TilingIfNotGPU()); mfi.isValid(); ++mfi )
     {
         if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
         {
@@ -115,70 +123,27 @@ WarpX::Hybrid_QED_Push (int lev, PatchType patch_type, amrex::Real a_dt)
         }
         Real wt = static_cast<Real>(amrex::second());
 
-        // Get boxes for E, B, and J
-
-        const Box& tbx = mfi.tilebox(Bx->ixType().toIntVect());
-
-        const Box& tex = mfi.tilebox(Ex->ixType().toIntVect());
-        const Box& tey = mfi.tilebox(Ey->ixType().toIntVect());
-        const Box& tez = mfi.tilebox(Ez->ixType().toIntVect());
+        const Box& tbx = mfi.tilebox();
 
         // Get field arrays
-        auto const& Bxfab = Bx->array(mfi);
-        auto const& Byfab = By->array(mfi);
-        auto const& Bzfab = Bz->array(mfi);
-        auto const& Exfab = Ex->array(mfi);
-        auto const& Eyfab = Ey->array(mfi);
-        auto const& Ezfab = Ez->array(mfi);
-        auto const& Jxfab = Jx->array(mfi);
-        auto const& Jyfab = Jy->array(mfi);
-        auto const& Jzfab = Jz->array(mfi);
-
-        // Define grown box with 1 ghost cell for finite difference stencil
-        const Box& gex = amrex::grow(tex,1);
-        const Box& gey = amrex::grow(tey,1);
-        const Box& gez = amrex::grow(tez,1);
-
-        // Temporary arrays for electric field, protected by Elixir on GPU
-        FArrayBox tmpEx_fab(gex,1);
-        const Elixir tmpEx_eli = tmpEx_fab.elixir();
-        auto const& tmpEx = tmpEx_fab.array();
-
-        FArrayBox tmpEy_fab(gey,1);
-        const Elixir tmpEy_eli = tmpEy_fab.elixir();
-        auto const& tmpEy = tmpEy_fab.array();
-
-        FArrayBox tmpEz_fab(gez,1);
-        const Elixir tmpEz_eli = tmpEz_fab.elixir();
-        auto const& tmpEz = tmpEz_fab.array();
-
-        // Copy electric field to temporary arrays
-        AMREX_PARALLEL_FOR_4D(
-            gex, 1, i, j, k, n,
-            { tmpEx(i,j,k,n) = Exfab(i,j,k,n); }
-        );
-
-        AMREX_PARALLEL_FOR_4D(
-            gey, 1, i, j, k, n,
-            { tmpEy(i,j,k,n) = Eyfab(i,j,k,n); }
-        );
-
-        AMREX_PARALLEL_FOR_4D(
-            gez, 1, i, j, k, n,
-            { tmpEz(i,j,k,n) = Ezfab(i,j,k,n); }
-        );
-
-        // Make local copy of xi, to use on device.
-        const Real xi_c2 = WarpX::quantum_xi_c2;
-
-        // Apply QED correction to electric field, using temporary arrays.
+        auto const& Bxfab = Bx->const_array(mfi);
+        auto const& Byfab = By->const_array(mfi);
+        auto const& Bzfab = Bz->const_array(mfi);
+        auto const& Exfab = Ex->const_array(mfi);
+        auto const& Eyfab = Ey->const_array(mfi);
+        auto const& Ezfab = Ez->const_array(mfi);
+        auto const& Jxfab = Jx->const_array(mfi);
+        auto const& Jyfab = Jy->const_array(mfi);
+        auto const& Jzfab = Jz->const_array(mfi);
+        auto const& dEfab = dE.array(mfi);
+
+        // Compute the QED correction to the electric field
         amrex::ParallelFor(
             tbx,
             [=] AMREX_GPU_DEVICE (int j, int k, int l)
             {
-                warpx_hybrid_QED_push(j,k,l, Exfab, Eyfab, Ezfab, Bxfab, Byfab,
-                    Bzfab, tmpEx, tmpEy, tmpEz, Jxfab, Jyfab, Jzfab, dx, dy, dz,
-                    a_dt, xi_c2);
+                warpx_hybrid_QED_correction(j,k,l, Exfab, Eyfab, Ezfab, Bxfab, Byfab,
+                    Bzfab, Jxfab, Jyfab, Jzfab, dx, dy, dz, a_dt, xi_c2, dEfab);
             }
         );
 
@@ -189,4 +154,9 @@ WarpX::Hybrid_QED_Push (int lev, PatchType patch_type, amrex::Real a_dt)
             amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
         }
     }
+
+    // Apply the QED correction to the electric field
+    MultiFab::Add(*Ex, dE, 0, 0, 1, 0);
+    MultiFab::Add(*Ey, dE, 1, 0, 1, 0);
+    MultiFab::Add(*Ez, dE, 2, 0, 1, 0);
 }
@@ -7,6 +7,7 @@
  */
 #include "Filter.H"
 
+#include "Utils/KernelCounters.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXProfilerWrapper.H"
 #include "WarpX.H"
@@ -17,13 +18,33 @@
 #include <AMReX_Extension.H>
 #include <AMReX_FArrayBox.H>
 #include <AMReX_FabArray.H>
+#include <AMReX_GpuDevice.H>
+#include <AMReX_GpuLaunch.H>
 #include <AMReX_MFIter.H>
 #include <AMReX_MultiFab.H>
 
 #include <algorithm>
+#include <array>
 
 using namespace amrex;
 
+SeparableStencil
+Filter::GetSeparableStencil () const
+{
+    SeparableStencil stencil;
+#if defined(WARPX_DIM_3D)
+    stencil.data = {stencil_x.data(), stencil_y.data(), stencil_z.data()};
+    stencil.length = {slen.x, slen.y, slen.z};
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+    stencil.data = {stencil_x.data(), stencil_z.data(), nullptr};
+    stencil.length = {slen.x, slen.y, 1};
+#else
+    stencil.data = {stencil_z.data(), nullptr, nullptr};
+    stencil.length = {slen.x, 1, 1};
+#endif
+    return stencil;
+}
+
 #ifdef AMREX_USE_GPU
 
 /* \brief Apply stencil on MultiFab (GPU version, 2D/3D).
@@ -42,6 +63,8 @@ Filter::ApplyStencil (MultiFab& dstmf, const MultiFab& srcmf, const int lev, int
 
     amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
 
+    const double kernel_start = KernelCounters::Start();
+
     for (MFIter mfi(dstmf); mfi.isValid(); ++mfi)
     {
         if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
@@ -64,6 +87,14 @@ Filter::ApplyStencil (MultiFab& dstmf, const MultiFab& srcmf, const int lev, int
             amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
         }
     }
+
+    if (KernelCounters::IsEnabled()) {
+        // Each value is read and written once; the stencil is applied one direction
+        // at a time, with one multiply and two additions for each pair of symmetric points
+        KernelCounters::StopCellKernel(KernelCounters::Filter, kernel_start,
+                                       KernelCounters::LocalNumCells(dstmf), 2.*ncomp,
+                                       ncomp*3.*(slen.x + slen.y + slen.z));
+    }
 }
 
 /* \brief Apply stencil on FArrayBox (GPU version, 2D/3D).
@@ -94,6 +125,11 @@ void Filter::DoFilter (const Box& tbx,
                        Array4<Real      > const& dst,
                        int scomp, int dcomp, int ncomp)
 {
+#if defined(AMREX_USE_CUDA) || defined(AMREX_USE_HIP)
+    if (DoFilterSeparable(tbx, src, dst, scomp, dcomp, ncomp)) { return; }
+#endif
+
+    // Fallback: full tensor-product stencil for each cell
 #if (AMREX_SPACEDIM >= 2)
     amrex::Real const* AMREX_RESTRICT sx = stencil_x.data();
 #endif
@@ -174,7 +210,7 @@ void Filter::DoFilter (const Box& tbx,
         for         (int iz=0; iz < slen_local.z; ++iz){
             for     (int iy=0; iy < slen_local.y; ++iy){
                 for (int ix=0; ix < slen_local.x; ++ix){
-                    Real sss = sz[iy];
+                    Real sss = sz[ix];
                     d += sss*( src_zeropad(i-ix,j,k,scomp+n)
                               +src_zeropad(i+ix,j,k,scomp+n));
                 }
@@ -189,6 +225,146 @@ void Filter::DoFilter (const Box& tbx,
 #endif
 }
 
+
+#if defined(AMREX_USE_CUDA) || defined(AMREX_USE_HIP)
+/* \brief Apply stencil one direction at a time, in GPU shared memory (1D/2D/3D).
+ *
+ * The stencil is the tensor product of the stencils along each direction, so
+ * that it can be applied as a sequence of 1D stencils: this costs 2*(slen.x+slen.y+slen.z)
+ * reads per cell instead of 2^dim*slen.x*slen.y*slen.z. Each thread block loads one
+ * tile of src with its guard cells into shared memory, filters it along each
+ * direction in shared memory, and writes the result to dst, so that src and dst
+ * are read and written only once and no temporary array is needed.
+ *
+ * \return false if the tiles do not fit in shared memory, in which case nothing is done.
+ */
+bool Filter::DoFilterSeparable (const Box& tbx,
+                                Array4<Real const> const& src,
+                                Array4<Real      > const& dst,
+                                int scomp, int dcomp, int ncomp)
+{
+    const SeparableStencil stencil = GetSeparableStencil();
+    amrex::Real const* AMREX_RESTRICT s0 = stencil.data[0];
+    amrex::Real const* AMREX_RESTRICT s1 = stencil.data[1];
+    amrex::Real const* AMREX_RESTRICT s2 = stencil.data[2];
+    const Dim3 len{stencil.length[0], stencil.length[1], stencil.length[2]};
+    const Dim3 halo{len.x-1, len.y-1, len.z-1};
+
+    // Largest tile (in output cells) for which the input tile with its guard
+    // cells and the tile filtered along the first direction fit in shared memory
+#if defined(WARPX_DIM_3D)
+    constexpr std::array<Dim3,5> tile_sizes{{{16,8,8}, {8,8,8}, {8,8,4}, {8,4,4}, {4,4,4}}};
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+    constexpr std::array<Dim3,5> tile_sizes{{{32,16,1}, {16,16,1}, {16,8,1}, {8,8,1}, {4,4,1}}};
+#else
+    constexpr std::array<Dim3,5> tile_sizes{{{256,1,1}, {128,1,1}, {64,1,1}, {32,1,1}, {16,1,1}}};
+#endif
+    const std::size_t max_shared_mem_bytes = amrex::Gpu::Device::sharedMemPerBlock();
+    Dim3 tile{0,0,0};
+    std::size_t buffer_size = 0;
+    std::size_t shared_mem_bytes = 0;
+    for (const auto& t : tile_sizes) {
+        buffer_size = static_cast<std::size_t>(t.x + 2*halo.x)*(t.y + 2*halo.y)*(t.z + 2*halo.z);
+        const std::size_t filtered_size = static_cast<std::size_t>(t.x)*(t.y + 2*halo.y)*(t.z + 2*halo.z);
+        shared_mem_bytes = (buffer_size + filtered_size)*sizeof(Real);
+        if (shared_mem_bytes <= max_shared_mem_bytes) {
+            tile = t;
+            break;
+        }
+    }
+    if (tile.x == 0) { return false; }
+    if (tbx.isEmpty()) { return true; }
+
+    const Dim3 lo = amrex::lbound(tbx);
+    const Dim3 hi = amrex::ubound(tbx);
+    const int ntx = (hi.x - lo.x + tile.x) / tile.x;
+    const int nty = (hi.y - lo.y + tile.y) / tile.y;
+    const int ntz = (hi.z - lo.z + tile.z) / tile.z;
+    const int ntiles = ntx*nty*ntz;
+    const int nblocks = ntiles*ncomp;
+    constexpr int threads_per_block = 256;
+
+    amrex::launch(nblocks, threads_per_block, shared_mem_bytes, amrex::Gpu::gpuStream(),
+        [=] AMREX_GPU_DEVICE () noexcept
+    {
+        const int n = blockIdx.x / ntiles;
+        int b = blockIdx.x - n*ntiles;
+        const int tk = b / (ntx*nty);
+        b -= tk*ntx*nty;
+        const int tj = b / ntx;
+        const int ti = b - tj*ntx;
+
+        // Lower corner and size of the output tile
+        const int i0 = lo.x + ti*tile.x;
+        const int j0 = lo.y + tj*tile.y;
+        const int k0 = lo.z + tk*tile.z;
+        const int nx = amrex::min(tile.x, hi.x - i0 + 1);
+        const int ny = amrex::min(tile.y, hi.y - j0 + 1);
+        const int nz = amrex::min(tile.z, hi.z - k0 + 1);
+        // Size of the input tile
+        const int ax = nx + 2*halo.x;
+        const int ay = ny + 2*halo.y;
+        const int az = nz + 2*halo.z;
+
+        amrex::Gpu::SharedMemory<amrex::Real> gsm;
+        amrex::Real* const buffer = gsm.dataPtr();
+        amrex::Real* const filtered = buffer + buffer_size;
+
+        // Load the input tile, padded with zeros beyond the guard cells of src
+        for (int m = threadIdx.x; m < ax*ay*az; m += blockDim.x) {
+            const int i = i0 - halo.x + m % ax;
+            const int j = j0 - halo.y + (m / ax) % ay;
+            const int k = k0 - halo.z + m / (ax*ay);
+            buffer[m] = src.contains(i,j,k) ? src(i,j,k,scomp+n) : 0.0_rt;
+        }
+        __syncthreads();
+
+        // Filter along the first direction: buffer (ax,ay,az) -> filtered (nx,ay,az)
+        for (int m = threadIdx.x; m < nx*ay*az; m += blockDim.x) {
+            const int ii = m % nx;
+            const int jk = m / nx;
+            amrex::Real const* const p = buffer + jk*ax + ii + halo.x;
+            amrex::Real d = 0.0_rt;
+            for (int is = 0; is < len.x; ++is) { d += s0[is]*(p[-is] + p[is]); }
+            filtered[m] = d;
+        }
+        __syncthreads();
+
+        // Filter along the second direction: filtered (nx,ay,az) -> buffer (nx,ny,az)
+        for (int m = threadIdx.x; m < nx*ny*az; m += blockDim.x) {
+            const int ii = m % nx;
+            const int jj = (m / nx) % ny;
+            const int kk = m / (nx*ny);
+            amrex::Real const* const p = filtered + (kk*ay + jj + halo.y)*nx + ii;
+            amrex::Real d = p[0];
+            if (s1) {
+                d = 0.0_rt;
+                for (int is = 0; is < len.y; ++is) { d += s1[is]*(p[-is*nx] + p[is*nx]); }
+            }
+            buffer[m] = d;
+        }
+        __syncthreads();
+
+        // Filter along the third direction: buffer (nx,ny,az) -> dst
+        const int nxy = nx*ny;
+        for (int m = threadIdx.x; m < nxy*nz; m += blockDim.x) {
+            const int ii = m % nx;
+            const int jj = (m / nx) % ny;
+            const int kk = m / nxy;
+            amrex::Real const* const p = buffer + (kk + halo.z)*nxy + jj*nx + ii;
+            amrex::Real d = p[0];
+            if (s2) {
+                d = 0.0_rt;
+                for (int is = 0; is < len.z; ++is) { d += s2[is]*(p[-is*nxy] + p[is*nxy]); }
+            }
+            dst(i0+ii, j0+jj, k0+kk, dcomp+n) = d;
+        }
+    });
+
+    return true;
+}
+#endif
+
 #else
 
 /* \brief Apply stencil on MultiFab (CPU version, 2D/3D).
@@ -207,6 +383,8 @@ Filter::ApplyStencil (amrex::MultiFab& dstmf, const amrex::MultiFab& srcmf, cons
 
     amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
 
+    const double kernel_start = KernelCounters::Start();
+
 #ifdef AMREX_USE_OMP
 // never runs on GPU since in the else branch of AMREX_USE_GPU
 #pragma omp parallel
@@ -242,6 +420,14 @@ Filter::ApplyStencil (amrex::MultiFab& dstmf, const amrex::MultiFab& srcmf, cons
             }
         }
     }
+
+    if (KernelCounters::IsEnabled()) {
+        // Each value is read and written once; the stencil is applied one direction
+        // at a time, with one multiply and two additions for each pair of symmetric points
+        KernelCounters::StopCellKernel(KernelCounters::Filter, kernel_start,
+                                       KernelCounters::LocalNumCells(dstmf), 2.*ncomp,
+                                       ncomp*3.*(slen.x + slen.y + slen.z));
+    }
 }
 
 /* \brief Apply stencil on FArrayBox (CPU version, 2D/3D).
@@ -270,73 +456,79 @@ Filter::ApplyStencil (amrex::FArrayBox& dstfab, const amrex::FArrayBox& srcfab,
     DoFilter(tbx, tmpfab.array(), dstfab.array(), 0, dcomp, ncomp);
 }
 
+/* \brief Apply stencil (CPU version, 1D/2D/3D).
+ *
+ * The stencil is the tensor product of the stencils along each direction, and is
+ * applied one direction at a time: tmp (defined on tbx grown by the stencil length)
+ * is filtered along the first direction into a buffer, which is filtered along the
+ * second direction, etc., the last direction being written to dst on tbx.
+ * tmp must be defined (and padded with zeros) up to the stencil length around tbx.
+ */
 void Filter::DoFilter (const Box& tbx,
                        Array4<Real const> const& tmp,
                        Array4<Real      > const& dst,
                        int scomp, int dcomp, int ncomp)
 {
-    const auto lo = amrex::lbound(tbx);
-    const auto hi = amrex::ubound(tbx);
-    // tmp and dst are of type Array4 (Fortran ordering)
-#if (AMREX_SPACEDIM >= 2)
-    amrex::Real const* AMREX_RESTRICT sx = stencil_x.data();
-#endif
 #if defined(WARPX_DIM_3D)
-    amrex::Real const* AMREX_RESTRICT sy = stencil_y.data();
+    const std::array<amrex::Real const*, AMREX_SPACEDIM> stencils{
+        stencil_x.data(), stencil_y.data(), stencil_z.data()};
+    const std::array<int, AMREX_SPACEDIM> lengths{slen.x, slen.y, slen.z};
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+    const std::array<amrex::Real const*, AMREX_SPACEDIM> stencils{stencil_x.data(), stencil_z.data()};
+    const std::array<int, AMREX_SPACEDIM> lengths{slen.x, slen.y};
+#else
+    const std::array<amrex::Real const*, AMREX_SPACEDIM> stencils{stencil_z.data()};
+    const std::array<int, AMREX_SPACEDIM> lengths{slen.x};
 #endif
-    amrex::Real const* AMREX_RESTRICT sz = stencil_z.data();
-    for (int n = 0; n < ncomp; ++n) {
-        // Set dst value to 0.
+
+    // Apply the 1D stencil s of length len along direction idir, on box bx
+    const auto filter_along = [] (const int idir, amrex::Real const* AMREX_RESTRICT s, const int len,
+                                  const Box& bx, Array4<Real const> const& in, const int incomp,
+                                  Array4<Real> const& out, const int outcomp)
+    {
+        const IntVect shift = IntVect::TheDimensionVector(idir);
+        const Dim3 d = shift.dim3();
+        const auto lo = amrex::lbound(bx);
+        const auto hi = amrex::ubound(bx);
         for         (int k = lo.z; k <= hi.z; ++k) {
             for     (int j = lo.y; j <= hi.y; ++j) {
+                AMREX_PRAGMA_SIMD
                 for (int i = lo.x; i <= hi.x; ++i) {
-                    dst(i,j,k,dcomp+n) = 0.0;
-                }
-            }
-        }
-        // 3 nested loop on 3D stencil
-        for         (int iz=0; iz < slen.z; ++iz){
-            for     (int iy=0; iy < slen.y; ++iy){
-                for (int ix=0; ix < slen.x; ++ix){
-#if defined(WARPX_DIM_3D)
-                    const Real sss = sx[ix]*sy[iy]*sz[iz];
-#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-                    const Real sss = sx[ix]*sz[iy];
-#else
-                    const Real sss = sz[ix];
-#endif
-                    // 3 nested loop on 3D array
-                    for         (int k = lo.z; k <= hi.z; ++k) {
-                        for     (int j = lo.y; j <= hi.y; ++j) {
-                            AMREX_PRAGMA_SIMD
-                            for (int i = lo.x; i <= hi.x; ++i) {
-#if defined(WARPX_DIM_3D)
-                                dst(i,j,k,dcomp+n) += sss*(tmp(i-ix,j-iy,k-iz,scomp+n)
-                                                          +tmp(i+ix,j-iy,k-iz,scomp+n)
-                                                          +tmp(i-ix,j+iy,k-iz,scomp+n)
-                                                          +tmp(i+ix,j+iy,k-iz,scomp+n)
-                                                          +tmp(i-ix,j-iy,k+iz,scomp+n)
-                                                          +tmp(i+ix,j-iy,k+iz,scomp+n)
-                                                          +tmp(i-ix,j+iy,k+iz,scomp+n)
-                                                          +tmp(i+ix,j+iy,k+iz,scomp+n));
-#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-                                dst(i,j,k,dcomp+n) += sss*(tmp(i-ix,j-iy,k,scomp+n)
-                                                          +tmp(i+ix,j-iy,k,scomp+n)
-                                                          +tmp(i-ix,j+iy,k,scomp+n)
-                                                          +tmp(i+ix,j+iy,k,scomp+n));
-#elif defined(WARPX_DIM_1D_Z)
-                                dst(i,j,k,dcomp+n) += sss*(tmp(i-ix,j,k,scomp+n)
-                                                          +tmp(i+ix,j,k,scomp+n));
-#else
-    WARPX_ABORT_WITH_MESSAGE(
-        "Filter not implemented for the current geometry!");
-#endif
-                            }
-                        }
+                    Real v = 0.0;
+                    for (int is = 0; is < len; ++is) {
+                        v += s[is]*(in(i-is*d.x,j-is*d.y,k-is*d.z,incomp)
+                                   +in(i+is*d.x,j+is*d.y,k+is*d.z,incomp));
                     }
+                    out(i,j,k,outcomp) = v;
                 }
             }
         }
+    };
+
+    // Boxes on which the filter along each direction is computed: after filtering along
+    // direction idir, the guard cells are only needed along the directions not filtered yet
+    std::array<Box, AMREX_SPACEDIM> boxes;
+    Box bx = amrex::grow(tbx, stencil_length_each_dir - 1);
+    for (int idir = 0; idir < AMREX_SPACEDIM; ++idir) {
+        bx.grow(idir, 1 - lengths[idir]);
+        boxes[idir] = bx;
+    }
+    std::array<FArrayBox, AMREX_SPACEDIM-1> buffers;
+    for (int idir = 0; idir < AMREX_SPACEDIM-1; ++idir) {
+        buffers[idir].resize(boxes[idir], 1);
+    }
+
+    for (int n = 0; n < ncomp; ++n) {
+        Array4<Real const> in = tmp;
+        int incomp = scomp + n;
+        for (int idir = 0; idir < AMREX_SPACEDIM-1; ++idir) {
+            filter_along(idir, stencils[idir], lengths[idir], boxes[idir], in, incomp,
+                         buffers[idir].array(), 0);
+            in = buffers[idir].const_array();
+            incomp = 0;
+        }
+        filter_along(AMREX_SPACEDIM-1, stencils[AMREX_SPACEDIM-1], lengths[AMREX_SPACEDIM-1],
+                     boxes[AMREX_SPACEDIM-1], in, incomp, dst, dcomp+n);
     }
 }
 
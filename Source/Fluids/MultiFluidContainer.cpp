@@ -8,11 +8,34 @@
 #include "MultiFluidContainer.H"
 #include "Fluids/WarpXFluidContainer.H"
 #include "Utils/Parser/ParserUtils.H"
+#include "Utils/WarpXConst.H"
+#include "Utils/WarpXProfilerWrapper.H"
+#include "WarpX.H"
 
+#include <ablastr/coarsen/sample.H>
+
+#include <AMReX_GpuContainers.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_MFIter.H>
+
+#include <cmath>
 #include <string>
 
 using namespace amrex;
 
+namespace
+{
+    //! Arrays and charge of a fluid species in a box, for the combined current deposition
+    struct FluidCurrentArrays
+    {
+        amrex::Array4<amrex::Real const> N;
+        amrex::Array4<amrex::Real const> NUx;
+        amrex::Array4<amrex::Real const> NUy;
+        amrex::Array4<amrex::Real const> NUz;
+        amrex::Real q;
+    };
+}
+
 MultiFluidContainer::MultiFluidContainer (int nlevs_max)
 {
     const ParmParse pp_fluids("fluids");
@@ -55,9 +78,151 @@ void
 MultiFluidContainer::DepositCurrent (int lev,
     amrex::MultiFab& jx, amrex::MultiFab& jy, amrex::MultiFab& jz)
 {
-    for (auto& fl : allcontainers) {
-        fl->DepositCurrent(lev,jx,jy,jz);
+    amrex::Vector<WarpXFluidContainer*> species;
+    for (auto& fl : allcontainers) { species.push_back(fl.get()); }
+    DepositCurrentOfSpecies(lev, jx, jy, jz, species);
+}
+
+void
+MultiFluidContainer::DepositCurrentOfSpecies (int lev,
+    amrex::MultiFab& jx, amrex::MultiFab& jy, amrex::MultiFab& jz,
+    amrex::Vector<WarpXFluidContainer*> const& species) const
+{
+    if (species.empty()) { return; }
+    if (species.size() == 1) {
+        species[0]->DepositCurrent(lev, jx, jy, jz);
+        return;
+    }
+
+    WARPX_PROFILE("MultiFluidContainer::DepositCurrent");
+
+    // All the species are defined on the same nodal BoxArray and DistributionMapping
+    const amrex::MultiFab& N0 = *species[0]->N[lev];
+    const int nspecies = static_cast<int>(species.size());
+
+    // Arrays of all the species, for each local box
+    const int nboxes = N0.local_size();
+    amrex::Gpu::PinnedVector<FluidCurrentArrays> h_arrays(std::size_t(nboxes)*nspecies);
+    for (MFIter mfi(N0); mfi.isValid(); ++mfi) {
+        for (int is = 0; is < nspecies; ++is) {
+            auto const* fl = species[is];
+            h_arrays[std::size_t(mfi.LocalIndex())*nspecies + is] = FluidCurrentArrays{
+                fl->N[lev]->const_array(mfi), fl->NU[lev][0]->const_array(mfi),
+                fl->NU[lev][1]->const_array(mfi), fl->NU[lev][2]->const_array(mfi),
+                fl->getCharge()};
+        }
     }
+    amrex::Gpu::DeviceVector<FluidCurrentArrays> d_arrays(h_arrays.size());
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, h_arrays.begin(), h_arrays.end(), d_arrays.begin());
+    FluidCurrentArrays const* p_arrays = d_arrays.data();
+
+    // Temporary nodal current, summed over the species
+    amrex::MultiFab tmp_j_fluid(N0.boxArray(), N0.DistributionMap(), 3, 0);
+
+    const amrex::Real inv_clight_sq = 1.0_rt / PhysConst::c / PhysConst::c;
+
+    auto j_nodal_type = amrex::GpuArray<int, 3>{0, 0, 0};
+    auto jx_type = amrex::GpuArray<int, 3>{0, 0, 0};
+    auto jy_type = amrex::GpuArray<int, 3>{0, 0, 0};
+    auto jz_type = amrex::GpuArray<int, 3>{0, 0, 0};
+    for (int i = 0; i < AMREX_SPACEDIM; ++i)
+    {
+        j_nodal_type[i] = tmp_j_fluid.ixType()[i];
+        jx_type[i] = jx.ixType()[i];
+        jy_type[i] = jy.ixType()[i];
+        jz_type[i] = jz.ixType()[i];
+    }
+
+    // Mask to fix the double counting, computed once for all the species
+    const amrex::Periodicity &period = WarpX::GetInstance().Geom(lev).periodicity();
+    auto const &owner_mask_x = amrex::OwnerMask(jx, period);
+    auto const &owner_mask_y = amrex::OwnerMask(jy, period);
+    auto const &owner_mask_z = amrex::OwnerMask(jz, period);
+
+    // Sum j of all the species at the nodes
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(tmp_j_fluid, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        amrex::Box const &tile_box = mfi.tilebox(N0.ixType().toIntVect());
+        const amrex::Array4<amrex::Real> tmp_j_fluid_arr = tmp_j_fluid.array(mfi);
+        FluidCurrentArrays const* box_arrays = p_arrays + std::size_t(mfi.LocalIndex())*nspecies;
+
+        amrex::ParallelFor(tile_box,
+            [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
+            {
+                amrex::Real jx_sum = 0.0_rt, jy_sum = 0.0_rt, jz_sum = 0.0_rt;
+                for (int is = 0; is < nspecies; ++is) {
+                    FluidCurrentArrays const& f = box_arrays[is];
+                    const amrex::Real N = f.N(i, j, k);
+                    const amrex::Real NUx = f.NUx(i, j, k);
+                    const amrex::Real NUy = f.NUy(i, j, k);
+                    const amrex::Real NUz = f.NUz(i, j, k);
+                    amrex::Real gamma = 1.0_rt;
+                    if (N>0.0_rt){
+                        const amrex::Real Ux = NUx/N;
+                        const amrex::Real Uy = NUy/N;
+                        const amrex::Real Uz = NUz/N;
+                        gamma = std::sqrt(1.0_rt + ( Ux*Ux + Uy*Uy + Uz*Uz) * inv_clight_sq ) ;
+                    }
+                    jx_sum += f.q * (NUx / gamma);
+                    jy_sum += f.q * (NUy / gamma);
+                    jz_sum += f.q * (NUz / gamma);
+                }
+                tmp_j_fluid_arr(i, j, k, 0) = jx_sum;
+                tmp_j_fluid_arr(i, j, k, 1) = jy_sum;
+                tmp_j_fluid_arr(i, j, k, 2) = jz_sum;
+            }
+        );
+    }
+
+    // Interpolate j from the nodes to the simulation mesh (typically Yee mesh)
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(tmp_j_fluid, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        amrex::Box const &tile_box_x = mfi.tilebox(jx.ixType().toIntVect());
+        amrex::Box const &tile_box_y = mfi.tilebox(jy.ixType().toIntVect());
+        amrex::Box const &tile_box_z = mfi.tilebox(jz.ixType().toIntVect());
+
+        const amrex::Array4<amrex::Real> jx_arr = jx.array(mfi);
+        const amrex::Array4<amrex::Real> jy_arr = jy.array(mfi);
+        const amrex::Array4<amrex::Real> jz_arr = jz.array(mfi);
+
+        const amrex::Array4<amrex::Real const> tmp_j_fluid_arr = tmp_j_fluid.const_array(mfi);
+
+        const amrex::Array4<int> owner_mask_x_arr = owner_mask_x->array(mfi);
+        const amrex::Array4<int> owner_mask_y_arr = owner_mask_y->array(mfi);
+        const amrex::Array4<int> owner_mask_z_arr = owner_mask_z->array(mfi);
+
+        const amrex::GpuArray<int, 3U> coarsening_ratio = {1, 1, 1};
+
+        amrex::ParallelFor( tile_box_x, tile_box_y, tile_box_z,
+            [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
+            {
+                const amrex::Real jx_tmp = ablastr::coarsen::sample::Interp(tmp_j_fluid_arr,
+                    j_nodal_type, jx_type, coarsening_ratio, i, j, k, 0);
+                if ( owner_mask_x_arr(i,j,k) ) { jx_arr(i, j, k) += jx_tmp; }
+            },
+            [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
+            {
+                const amrex::Real jy_tmp = ablastr::coarsen::sample::Interp(tmp_j_fluid_arr,
+                    j_nodal_type, jy_type, coarsening_ratio, i, j, k, 1);
+                if ( owner_mask_y_arr(i,j,k) ) { jy_arr(i, j, k) += jy_tmp; }
+            },
+            [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
+            {
+                const amrex::Real jz_tmp = ablastr::coarsen::sample::Interp(tmp_j_fluid_arr,
+                    j_nodal_type, jz_type, coarsening_ratio, i, j, k, 2);
+                if ( owner_mask_z_arr(i,j,k) ) { jz_arr(i, j, k) += jz_tmp; }
+            }
+        );
+    }
+
+    // the arrays of the species are used by the kernels above
+    amrex::Gpu::streamSynchronize();
 }
 
 void
@@ -67,7 +232,13 @@ MultiFluidContainer::Evolve (int lev,
                             MultiFab* rho, MultiFab& jx, MultiFab& jy, MultiFab& jz,
                             amrex::Real cur_time, bool skip_deposition)
 {
+    // The current of all the species is deposited at once, at the end of the step
+    amrex::Vector<WarpXFluidContainer*> depositing_species;
     for (auto& fl : allcontainers) {
-        fl->Evolve(lev, Ex, Ey, Ez, Bx, By, Bz, rho, jx, jy, jz, cur_time, skip_deposition);
+        fl->Evolve(lev, Ex, Ey, Ez, Bx, By, Bz, rho, jx, jy, jz, cur_time, skip_deposition, true);
+        if (!fl->do_not_deposit) { depositing_species.push_back(fl.get()); }
+    }
+    if (!skip_deposition) {
+        DepositCurrentOfSpecies(lev, jx, jy, jz, depositing_species);
     }
 }
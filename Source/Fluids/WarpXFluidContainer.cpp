@@ -53,6 +53,7 @@ WarpXFluidContainer::WarpXFluidContainer(int nlevs_max, int ispecies, const std:
     // Resize the list of MultiFabs for the right number of levels
     N.resize(nlevs_max);
     NU.resize(nlevs_max);
+    m_U_half.resize(nlevs_max);
 }
 
 void WarpXFluidContainer::ReadParameters()
@@ -257,7 +258,7 @@ void WarpXFluidContainer::Evolve(
     const amrex::MultiFab &Ex, const amrex::MultiFab &Ey, const amrex::MultiFab &Ez,
     const amrex::MultiFab &Bx, const amrex::MultiFab &By, const amrex::MultiFab &Bz,
     amrex::MultiFab* rho, amrex::MultiFab &jx, amrex::MultiFab &jy, amrex::MultiFab &jz,
-    amrex::Real cur_time, bool skip_deposition)
+    amrex::Real cur_time, bool skip_deposition, bool skip_current_deposition)
 {
 
     WARPX_PROFILE("WarpXFluidContainer::Evolve");
@@ -293,7 +294,7 @@ void WarpXFluidContainer::Evolve(
     }
 
     // Deposit J to the simulation mesh
-    if (!skip_deposition && ! do_not_deposit) {
+    if (!skip_deposition && ! do_not_deposit && ! skip_current_deposition) {
         DepositCurrent(lev, jx, jy, jz);
     }
 }
@@ -436,22 +437,39 @@ void WarpXFluidContainer::AdvectivePush_Muscl (int lev)
 
     const amrex::BoxArray ba = N[lev]->boxArray();
 
-    // Temporary Half-step values
+    // Temporary Half-step values. These are kept from one step to the next
+    // and only (re)defined when the grids of this level change.
 #if defined(WARPX_DIM_3D)
-    amrex::MultiFab tmp_U_minus_x( amrex::convert(ba, IntVect(0,1,1)), N[lev]->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_plus_x( amrex::convert(ba, IntVect(0,1,1)), N[lev]->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_minus_y( amrex::convert(ba, IntVect(1,0,1)), N[lev]->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_plus_y( amrex::convert(ba, IntVect(1,0,1)), N[lev]->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_minus_z( amrex::convert(ba, IntVect(1,1,0)), N[lev]->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_plus_z( amrex::convert(ba, IntVect(1,1,0)), N[lev]->DistributionMap(), 4, 1);
+    const std::array<IntVect, 2*AMREX_SPACEDIM> half_step_ixtype = {
+        IntVect(0,1,1), IntVect(0,1,1), IntVect(1,0,1), IntVect(1,0,1), IntVect(1,1,0), IntVect(1,1,0) };
 #elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-    amrex::MultiFab tmp_U_minus_x( amrex::convert(ba, IntVect(0,1)), N[lev]->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_plus_x( amrex::convert(ba, IntVect(0,1)), N[lev]->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_minus_z( amrex::convert(ba, IntVect(1,0)), N[lev]->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_plus_z( amrex::convert(ba, IntVect(1,0)), N[lev]->DistributionMap(), 4, 1);
+    const std::array<IntVect, 2*AMREX_SPACEDIM> half_step_ixtype = {
+        IntVect(0,1), IntVect(0,1), IntVect(1,0), IntVect(1,0) };
 #else
-    amrex::MultiFab tmp_U_minus_z( amrex::convert(ba, IntVect(0)), N[lev]->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_plus_z( amrex::convert(ba, IntVect(0)), N[lev]->DistributionMap(), 4, 1);
+    const std::array<IntVect, 2*AMREX_SPACEDIM> half_step_ixtype = { IntVect(0), IntVect(0) };
+#endif
+    for (int n = 0; n < 2*AMREX_SPACEDIM; ++n) {
+        amrex::MultiFab& mf = m_U_half[lev][n];
+        const amrex::BoxArray ba_half = amrex::convert(ba, half_step_ixtype[n]);
+        if (!mf.ok() || mf.boxArray() != ba_half || mf.DistributionMap() != N[lev]->DistributionMap()) {
+            mf.define(ba_half, N[lev]->DistributionMap(), 4, 1);
+        }
+    }
+#if defined(WARPX_DIM_3D)
+    amrex::MultiFab& tmp_U_minus_x = m_U_half[lev][0];
+    amrex::MultiFab& tmp_U_plus_x = m_U_half[lev][1];
+    amrex::MultiFab& tmp_U_minus_y = m_U_half[lev][2];
+    amrex::MultiFab& tmp_U_plus_y = m_U_half[lev][3];
+    amrex::MultiFab& tmp_U_minus_z = m_U_half[lev][4];
+    amrex::MultiFab& tmp_U_plus_z = m_U_half[lev][5];
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+    amrex::MultiFab& tmp_U_minus_x = m_U_half[lev][0];
+    amrex::MultiFab& tmp_U_plus_x = m_U_half[lev][1];
+    amrex::MultiFab& tmp_U_minus_z = m_U_half[lev][2];
+    amrex::MultiFab& tmp_U_plus_z = m_U_half[lev][3];
+#else
+    amrex::MultiFab& tmp_U_minus_z = m_U_half[lev][0];
+    amrex::MultiFab& tmp_U_plus_z = m_U_half[lev][1];
 #endif
 
     // Fill edge values of N and U at the half timestep for MUSCL
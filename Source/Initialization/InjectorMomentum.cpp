@@ -9,17 +9,25 @@
 
 using namespace amrex;
 
-void InjectorMomentum::clear () // NOLINT(readability-make-member-function-const)
+void InjectorMomentum::clear ()
 {
     switch (type)
     {
     case Type::parser:
     case Type::gaussian:
-    case Type::gaussianparser:
     case Type::gaussianflux:
+    {
+        object.gaussianflux.clear();
+        break;
+    }
+    case Type::juttner:
+    {
+        object.juttner.clear();
+        break;
+    }
+    case Type::gaussianparser:
     case Type::uniform:
     case Type::boltzmann:
-    case Type::juttner:
     case Type::constant:
     case Type::radial_expansion:
     {
@@ -0,0 +1,141 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "InverseCDFTable.H"
+
+#include "Utils/TextMsg.H"
+
+#include <AMReX_Arena.H>
+#include <AMReX_GpuDevice.H>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace
+{
+    // Number of tabulated points in each row of the table
+    constexpr int n_points = 1024;
+    // Number of points of the fine grid on which the distribution is integrated
+    constexpr int n_fine = 20000;
+    // The last tabulated point is the one above which the probability is exp(-s_max)
+    constexpr double s_max = 27.631021115928547; // -ln(1.e-12)
+
+    /**
+     * \brief Tabulate the inverse cumulative distribution of the distribution
+     * exp(log_pdf(u)), for u in [0, u_max], in terms of t = (-ln(1-q))^(1/3)
+     *
+     * \param[in] log_pdf logarithm of the (non-normalized) probability density
+     * \param[in] u_max upper bound of the integration, above which the
+     *            probability must be negligible compared to exp(-s_max)
+     * \param[in] u_scale factor applied to the tabulated values
+     * \param[out] row the n_points tabulated values
+     */
+    template <typename LogPdf>
+    void tabulateRow (LogPdf const& log_pdf, double u_max, double u_scale, amrex::Real* row)
+    {
+        double const du = u_max/(n_fine-1);
+        std::vector<double> log_f(n_fine);
+        double log_f_max = -std::numeric_limits<double>::infinity();
+        for (int m = 0; m < n_fine; ++m) {
+            log_f[m] = log_pdf(m*du);
+            log_f_max = std::max(log_f_max, log_f[m]);
+        }
+
+        // Complementary cumulative distribution Q(u) = 1 - q(u), integrated from
+        // the top so that the tail is accurate
+        std::vector<double> cdf_c(n_fine);
+        cdf_c[n_fine-1] = 0.;
+        double f_next = std::exp(log_f[n_fine-1] - log_f_max);
+        for (int m = n_fine-2; m >= 0; --m) {
+            double const f = std::exp(log_f[m] - log_f_max);
+            cdf_c[m] = cdf_c[m+1] + 0.5*(f + f_next)*du;
+            f_next = f;
+        }
+        double const inv_norm = 1./cdf_c[0];
+        for (auto& c : cdf_c) { c *= inv_norm; }
+
+        double const dt = std::cbrt(s_max)/(n_points-1);
+        row[0] = amrex::Real(0.);
+        int m = 0;
+        for (int k = 1; k < n_points; ++k) {
+            double const t = k*dt;
+            double const target = std::exp(-t*t*t);
+            // Find m such that cdf_c[m] >= target > cdf_c[m+1]
+            while (m < n_fine-2 && cdf_c[m+1] >= target) { ++m; }
+            double const dc = cdf_c[m] - cdf_c[m+1];
+            double const w = (dc > 0.) ? std::min((cdf_c[m] - target)/dc, 1.) : 0.;
+            row[k] = static_cast<amrex::Real>(u_scale*(m + w)*du);
+        }
+    }
+
+    /** Copy the host table to the arena, and fill the metadata of the view */
+    InverseCDFTable makeTable (std::vector<amrex::Real> const& h_table, int n_rows,
+                               double log_param_min, double dlog_param)
+    {
+        InverseCDFTable table;
+        table.m_n_rows = n_rows;
+        table.m_n_points = n_points;
+        table.m_log_param_min = static_cast<amrex::Real>(log_param_min);
+        table.m_dlog_param_inv = (n_rows > 1) ? static_cast<amrex::Real>(1./dlog_param) : amrex::Real(0.);
+        table.m_dt_inv = static_cast<amrex::Real>((n_points-1)/std::cbrt(s_max));
+
+        std::size_t const nbytes = h_table.size()*sizeof(amrex::Real);
+        table.m_table = static_cast<amrex::Real*>(amrex::The_Arena()->alloc(nbytes));
+        amrex::Gpu::htod_memcpy(table.m_table, h_table.data(), nbytes);
+        return table;
+    }
+}
+
+void InverseCDFTable::clear ()
+{
+    if (m_table) {
+        amrex::The_Arena()->free(m_table);
+        m_table = nullptr;
+    }
+}
+
+InverseCDFTable makeJuttnerSpeedTable (amrex::Real theta_min, amrex::Real theta_max, int n_theta)
+{
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(theta_min > 0 && n_theta >= 1 &&
+                                     (n_theta == 1 || theta_max > theta_min),
+        "Invalid temperature range for the Maxwell-Juttner sampling table");
+
+    double const log_theta_min = std::log(static_cast<double>(theta_min));
+    double const dlog_theta = (n_theta > 1) ?
+        (std::log(static_cast<double>(theta_max)) - log_theta_min)/(n_theta-1) : 0.;
+
+    std::vector<amrex::Real> h_table(static_cast<std::size_t>(n_theta)*n_points);
+    for (int r = 0; r < n_theta; ++r) {
+        double const theta = std::exp(log_theta_min + r*dlog_theta);
+        // gamma - 1 = u^2/(gamma + 1) avoids the cancellation at low temperature
+        auto const log_pdf = [theta] (double u) {
+            double const gamma = std::sqrt(1. + u*u);
+            return 2.*std::log(u) - u*u/((gamma + 1.)*theta);
+        };
+        double const u_max = 50.*theta + 10.*std::sqrt(theta);
+        tabulateRow(log_pdf, u_max, 1., h_table.data() + static_cast<std::size_t>(r)*n_points);
+    }
+    return makeTable(h_table, n_theta, log_theta_min, dlog_theta);
+}
+
+InverseCDFTable makeGaussianFluxTable (amrex::Real u_m, amrex::Real u_th)
+{
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(u_th > 0,
+        "The Gaussian flux sampling table requires a positive momentum spread");
+
+    // Tabulate w = u/u_th, distributed as w exp(-(w-a)^2/2)
+    double const a = static_cast<double>(u_m)/static_cast<double>(u_th);
+    auto const log_pdf = [a] (double w) {
+        return std::log(w) - 0.5*(w - a)*(w - a);
+    };
+    double const w_max = std::max(a, 0.) + 10.;
+
+    std::vector<amrex::Real> h_table(n_points);
+    tabulateRow(log_pdf, w_max, static_cast<double>(u_th), h_table.data());
+    return makeTable(h_table, 1, 0., 0.);
+}
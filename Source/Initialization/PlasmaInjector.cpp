@@ -430,11 +430,14 @@ void PlasmaInjector::setupExternalFile (amrex::ParmParse const& pp_species)
         " to read the external openPMD file with species data");
 #endif
     external_file = true;
-    std::string str_injection_file;
     utils::parser::get(pp_species, source_name, "injection_file", str_injection_file);
     // optional parameters
     utils::parser::queryWithParser(pp_species, source_name, "q_tot", q_tot);
     utils::parser::queryWithParser(pp_species, source_name, "z_shift",z_shift);
+    utils::parser::queryWithParser(pp_species, source_name, "injection_file_batch_size",
+                                   injection_file_batch_size);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(injection_file_batch_size > 0,
+        species_name + ".injection_file_batch_size must be positive.");
 
 #ifdef WARPX_USE_OPENPMD
     const bool charge_is_specified = pp_species.contains("charge");
@@ -9,6 +9,8 @@
 
 #include "Utils/TextMsg.H"
 
+#include <ablastr/parallelization/MPIInitHelpers.H>
+
 #include <AMReX.H>
 #include <AMReX_ccse-mpi.H>
 #include <AMReX_ParmParse.H>
@@ -30,8 +32,16 @@ namespace {
         bool abort_on_out_of_gpu_memory = true; // AMReX' default: false
         pp_amrex.queryAdd("abort_on_out_of_gpu_memory", abort_on_out_of_gpu_memory);
 
-        bool the_arena_is_managed = false; // AMReX' default: true
+        // With warpx.do_particle_memory_oversubscription, the particles are allocated in
+        // managed memory, which can exceed the device memory (the fields of WarpX are then
+        // allocated in The_Device_Arena, see WarpX::AllocInitMultiFab)
+        bool do_particle_memory_oversubscription = false;
+        amrex::ParmParse("warpx").query("do_particle_memory_oversubscription",
+                                        do_particle_memory_oversubscription);
+        bool the_arena_is_managed = do_particle_memory_oversubscription; // AMReX' default: true
         pp_amrex.queryAdd("the_arena_is_managed", the_arena_is_managed);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!do_particle_memory_oversubscription || the_arena_is_managed,
+            "warpx.do_particle_memory_oversubscription requires amrex.the_arena_is_managed = 1");
 
         // https://amrex-codes.github.io/amrex/docs_html/InputsComputeBackends.html
         std::string omp_threads = "nosmt"; // AMReX' default: system
@@ -65,6 +75,33 @@ namespace {
                 "tiny_profiler.device_synchronize_around_region overrides warpx.do_device_synchronize.");
         }
 
+        // Node-aware space-filling-curve distribution mapping: AMReX first
+        // distributes the boxes over the nodes, then over the ranks of each node,
+        // so that most neighboring boxes exchange their guard cells on-node.
+        // The node size is detected from the MPI topology, unless set explicitly.
+        {
+            const amrex::ParmParse pp_algo("algo");
+            bool load_balance_node_aware = false;
+            pp_algo.query("load_balance_node_aware", load_balance_node_aware);
+            amrex::ParmParse pp_dm("DistributionMapping");
+            if (load_balance_node_aware && !pp_dm.contains("node_size"))
+            {
+                const int ranks_per_node = ablastr::parallelization::mpi_ranks_per_node();
+                if (ranks_per_node > 1) {
+                    pp_dm.add("node_size", ranks_per_node);
+                }
+            }
+        }
+
+        // With a GPU-aware MPI library, the guard cells are exchanged directly from
+        // the device buffers: the library then copies the buffers of the ranks of a same
+        // node device-to-device (CUDA/HIP IPC), and only uses the network between nodes.
+        // Otherwise, AMReX stages all the buffers through pinned host memory.
+#ifdef AMREX_USE_GPU
+        bool use_gpu_aware_mpi = ablastr::parallelization::mpi_is_gpu_aware(); // AMReX' default: false
+        pp_amrex.queryAdd("use_gpu_aware_mpi", use_gpu_aware_mpi);
+#endif
+
         // Here we override the default tiling option for particles, which is always
         // "false" in AMReX, to "false" if compiling for GPU execution and "true"
         // if compiling for CPU.
@@ -84,13 +121,13 @@ namespace warpx::initialization
 {
 
     amrex::AMReX*
-    amrex_init (int& argc, char**& argv, bool build_parm_parse)
+    amrex_init (int& argc, char**& argv, bool build_parm_parse, MPI_Comm mpi_comm)
     {
         return amrex::Initialize(
             argc,
             argv,
             build_parm_parse,
-            MPI_COMM_WORLD,
+            mpi_comm,
             ::overwrite_amrex_parser_defaults
         );
     }
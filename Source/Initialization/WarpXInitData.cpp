@@ -26,6 +26,7 @@
 #include "Utils/Algorithms/LinearInterpolation.H"
 #include "Utils/Logo/GetLogo.H"
 #include "Utils/Parser/ParserUtils.H"
+#include "Utils/StartupTimer.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXConst.H"
@@ -39,6 +40,7 @@
 #include <ablastr/warn_manager/WarnManager.H>
 
 #include <AMReX.H>
+#include <AMReX_Algorithm.H>
 #include <AMReX_AmrCore.H>
 #ifdef AMREX_USE_SENSEI_INSITU
 #   include <AMReX_AmrMeshInSituBridge.H>
@@ -71,6 +73,8 @@
 #include <algorithm>
 #include <array>
 #include <cctype>
+#include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -194,6 +198,10 @@ WarpX::PrintMainPICparameters ()
       amrex::Print() << "Operation mode:       | Electrostatic" << "\n";
       amrex::Print() << "                      | - laboratory frame" << "\n";
     }
+    else if (electrostatic_solver_id == ElectrostaticSolverAlgo::LabFrameEffectivePotential) {
+      amrex::Print() << "Operation mode:       | Electrostatic" << "\n";
+      amrex::Print() << "                      | - laboratory frame, effective potential scheme" << "\n";
+    }
     else if (electrostatic_solver_id == ElectrostaticSolverAlgo::Relativistic){
       amrex::Print() << "Operation mode:       | Electrostatic" << "\n";
       amrex::Print() << "                      | - relativistic" << "\n";
@@ -411,6 +419,21 @@ WarpX::PrintMainPICparameters ()
       amrex::Print() << "                      |  - moving_window_v = " << WarpX::moving_window_v << "\n";
       amrex::Print() << "------------------------------------------------------------------------------- \n";
     }
+    //Print the storage of the particles of each species, with the runtime components
+    //that the physics modules of the species need
+    if (mypc->nSpecies() > 0) {
+      amrex::Print() << "Particle storage:     | bytes per particle (runtime components)\n";
+      for (int i = 0; i < mypc->nSpecies(); ++i) {
+        auto const& pc = mypc->GetParticleContainer(i);
+        const auto bytes = pc.NumRealComps()*sizeof(ParticleReal) + pc.NumIntComps()*sizeof(int);
+        std::string runtime_comps;
+        for (auto const& comp : pc.getParticleRuntimeComps()) { runtime_comps += " " + comp.first; }
+        for (auto const& comp : pc.getParticleRuntimeiComps()) { runtime_comps += " " + comp.first; }
+        amrex::Print() << "                      |  - " << mypc->GetSpeciesNames()[i] << ": "
+                       << bytes << " (" << (runtime_comps.empty() ? " none" : runtime_comps) << " )\n";
+      }
+      amrex::Print() << "------------------------------------------------------------------------------- \n";
+    }
 }
 
 void
@@ -454,10 +477,12 @@ WarpX::InitData ()
         ComputeDt();
         WarpX::PrintDtDxDyDz();
         InitFromScratch();
+        const StartupTimer::Scope startup_timer("diagnostics");
         InitDiagnostics();
     }
     else
     {
+        const StartupTimer::Scope startup_timer("restart");
         InitFromCheckpoint();
         WarpX::PrintDtDxDyDz();
         PostRestart();
@@ -508,6 +533,8 @@ WarpX::InitData ()
 
     if (restart_chkfile.empty())
     {
+        const StartupTimer::Scope startup_timer("initial_fields");
+
         // Loop through species and calculate their space-charge field
         bool const reset_fields = false; // Do not erase previous user-specified values on the grid
         ExecutePythonCallback("beforeInitEsolve");
@@ -525,6 +552,8 @@ WarpX::InitData ()
     }
 
     if (restart_chkfile.empty() || write_diagnostics_on_restart) {
+        const StartupTimer::Scope startup_timer("initial_diagnostics_output");
+
         // Write full diagnostics before the first iteration.
         multi_diags->FilterComputePackFlush(istep[0] - 1);
 
@@ -539,6 +568,8 @@ WarpX::InitData ()
     PerformanceHints();
 
     CheckKnownIssues();
+
+    StartupTimer::Finish(print_startup_timings);
 }
 
 void
@@ -569,7 +600,10 @@ WarpX::InitFromScratch ()
 {
     const Real time = 0.0;
 
-    AmrCore::InitFromScratch(time);  // This will call MakeNewLevelFromScratch
+    {
+        const StartupTimer::Scope startup_timer("grids_and_fields");
+        AmrCore::InitFromScratch(time);  // This will call MakeNewLevelFromScratch
+    }
 
     if (m_implicit_solver) {
 
@@ -577,26 +611,35 @@ WarpX::InitFromScratch ()
         m_implicit_solver->GetParticleSolverParams( max_particle_its_in_implicit_scheme,
                                                     particle_tol_in_implicit_scheme );
 
-        // Add space to save the positions and velocities at the start of the time steps
+        // Add space to save the positions and velocities at the start of the time steps.
+        // They are set at the start of each step and only used within the step, during
+        // which the particles are not redistributed, so they are not communicated.
+        bool const comm = false;
         for (auto const& pc : *mypc) {
 #if (AMREX_SPACEDIM >= 2)
-            pc->AddRealComp("x_n");
+            pc->AddRealComp("x_n", comm);
 #endif
 #if defined(WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
-            pc->AddRealComp("y_n");
+            pc->AddRealComp("y_n", comm);
 #endif
-            pc->AddRealComp("z_n");
-            pc->AddRealComp("ux_n");
-            pc->AddRealComp("uy_n");
-            pc->AddRealComp("uz_n");
+            pc->AddRealComp("z_n", comm);
+            pc->AddRealComp("ux_n", comm);
+            pc->AddRealComp("uy_n", comm);
+            pc->AddRealComp("uz_n", comm);
         }
 
     }
 
-    mypc->AllocData();
-    mypc->InitData();
+    {
+        const StartupTimer::Scope startup_timer("particles");
+        mypc->AllocData();
+        mypc->InitData();
+    }
 
-    InitPML();
+    {
+        const StartupTimer::Scope startup_timer("pml");
+        InitPML();
+    }
 
 }
 
@@ -1391,7 +1434,8 @@ WarpX::LoadExternalFieldsFromFile (int const lev)
 void
 WarpX::ReadExternalFieldFromFile (
        const std::string& read_fields_from_path, amrex::MultiFab* mf,
-       const std::string& F_name, const std::string& F_component)
+       const std::string& F_name, const std::string& F_component,
+       const amrex::Box& fill_region)
 {
     // Get WarpX domain info
     auto& warpx = WarpX::GetInstance();
@@ -1449,34 +1493,105 @@ WarpX::ReadExternalFieldFromFile (
 
     auto FC = F[F_component];
     const auto extent = FC.getExtent();
+
+    // Position, spacing and number of points of the file grid along each axis of WarpX
+#if defined(WARPX_DIM_RZ)
     const auto extent0 = static_cast<int>(extent[0]);
-    const auto extent1 = static_cast<int>(extent[1]);
-    const auto extent2 = static_cast<int>(extent[2]);
+    const amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> file_lo = {offset0, offset1};
+    const amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> file_d = {file_dr, file_dz};
+    const amrex::IntVect file_n(static_cast<int>(extent[1]), static_cast<int>(extent[2]));
+#elif defined(WARPX_DIM_3D)
+    const amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> file_lo = {offset0, offset1, offset2};
+    const amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> file_d = {file_dx, file_dy, file_dz};
+    const amrex::IntVect file_n(static_cast<int>(extent[0]), static_cast<int>(extent[1]),
+                                static_cast<int>(extent[2]));
+#endif
 
-    // Determine the chunk data that will be loaded.
-    // Now, the full range of data is loaded.
-    // Loading chunk data can speed up the process.
-    // Thus, `chunk_offset` and `chunk_extent` should be modified accordingly in another PR.
-    const openPMD::Offset chunk_offset = {0,0,0};
-    const openPMD::Extent chunk_extent = {extent[0], extent[1], extent[2]};
+    // Each rank only reads the hyperslab of the file that overlaps its own boxes:
+    // one chunk per box, that covers the file points used to interpolate onto the box,
+    // with one more point on each side as a guard against round-off.
+    // The chunks are stored in the index space of the file grid.
+    const int nlocal = mf->local_size();
+    amrex::Vector<amrex::Box> chunk_boxes(nlocal);
+    amrex::Vector<std::shared_ptr<double>> chunk_data_host(nlocal);
+    for (MFIter mfi(*mf); mfi.isValid(); ++mfi)
+    {
+        amrex::Box fab_box = mfi.fabbox();
+        if (fill_region.ok()) { fab_box &= amrex::convert(fill_region, nodal_flag); }
+        if (!fab_box.ok()) { continue; }
 
-    auto FC_chunk_data = FC.loadChunk<double>(chunk_offset,chunk_extent);
-    series.flush();
-    auto *FC_data_host = FC_chunk_data.get();
+        amrex::IntVect chunk_lo, chunk_hi;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            int ilo = fab_box.smallEnd(idim);
+            int ihi = fab_box.bigEnd(idim);
+#if defined(WARPX_DIM_RZ)
+            if (idim == 0) {
+                // negative radial indices are mirrored
+                const int alo = std::abs(ilo);
+                const int ahi = std::abs(ihi);
+                ilo = (ilo <= 0 && ihi >= 0) ? 0 : std::min(alo, ahi);
+                ihi = std::max(alo, ahi);
+            }
+#endif
+            const amrex::Real shift = (fab_box.type(idim) == amrex::IndexType::CellIndex::NODE) ?
+                0._rt : 0.5_rt*dx[idim];
+            const amrex::Real xlo = real_box.lo(idim) + ilo*dx[idim] + shift;
+            const amrex::Real xhi = real_box.lo(idim) + ihi*dx[idim] + shift;
+            chunk_lo[idim] = static_cast<int>(std::floor((xlo - file_lo[idim])/file_d[idim])) - 1;
+            chunk_hi[idim] = static_cast<int>(std::floor((xhi - file_lo[idim])/file_d[idim])) + 2;
+        }
+        const amrex::Box chunk_box = amrex::Box(chunk_lo, chunk_hi)
+            & amrex::Box(amrex::IntVect(0), file_n - 1);
+        if (!chunk_box.ok()) { continue; }
 
-    // Load data to GPU
-    const size_t total_extent = size_t(extent[0]) * extent[1] * extent[2];
-    amrex::Gpu::DeviceVector<double> FC_data_gpu(total_extent);
-    auto *FC_data = FC_data_gpu.data();
-    amrex::Gpu::copy(amrex::Gpu::hostToDevice, FC_data_host, FC_data_host + total_extent, FC_data);
+        const auto chunk_size = chunk_box.length();
+#if defined(WARPX_DIM_RZ)
+        const openPMD::Offset chunk_offset = {0, std::uint64_t(chunk_box.smallEnd(0)),
+                                              std::uint64_t(chunk_box.smallEnd(1))};
+        const openPMD::Extent chunk_extent = {extent[0], std::uint64_t(chunk_size[0]),
+                                              std::uint64_t(chunk_size[1])};
+#elif defined(WARPX_DIM_3D)
+        const openPMD::Offset chunk_offset = {std::uint64_t(chunk_box.smallEnd(0)),
+                                              std::uint64_t(chunk_box.smallEnd(1)),
+                                              std::uint64_t(chunk_box.smallEnd(2))};
+        const openPMD::Extent chunk_extent = {std::uint64_t(chunk_size[0]),
+                                              std::uint64_t(chunk_size[1]),
+                                              std::uint64_t(chunk_size[2])};
+#endif
+        chunk_boxes[mfi.LocalIndex()] = chunk_box;
+        chunk_data_host[mfi.LocalIndex()] = FC.loadChunk<double>(chunk_offset, chunk_extent);
+    }
+    series.flush();
 
     // Loop over boxes
     for (MFIter mfi(*mf, TilingIfNotGPU()); mfi.isValid(); ++mfi)
     {
+        const amrex::Box& chunk_box = chunk_boxes[mfi.LocalIndex()];
+        if (!chunk_box.ok()) { continue; }
+
         const amrex::Box box = mfi.growntilebox();
-        const amrex::Box tb = mfi.tilebox(nodal_flag, mf->nGrowVect());
+        amrex::Box tb = mfi.tilebox(nodal_flag, mf->nGrowVect());
+        if (fill_region.ok()) {
+            tb &= amrex::convert(fill_region, nodal_flag);
+            if (!tb.ok()) { continue; }
+        }
         auto const& mffab = mf->array(mfi);
 
+        // Load data to GPU
+#if defined(WARPX_DIM_RZ)
+        const auto total_extent = static_cast<std::size_t>(extent0) * chunk_box.numPts();
+#else
+        const auto total_extent = static_cast<std::size_t>(chunk_box.numPts());
+#endif
+        amrex::Gpu::DeviceVector<double> FC_data_gpu(total_extent);
+        auto *FC_data = FC_data_gpu.data();
+        auto *FC_data_host = chunk_data_host[mfi.LocalIndex()].get();
+        amrex::Gpu::copy(amrex::Gpu::hostToDevice, FC_data_host, FC_data_host + total_extent, FC_data);
+
+        // Bounds of the chunk: the interpolation stencil is kept inside.
+        const amrex::IntVect chunk_lo = chunk_box.smallEnd();
+        const amrex::IntVect chunk_hi = chunk_box.bigEnd();
+
         // Start ParallelFor
         amrex::ParallelFor (tb,
             [=] AMREX_GPU_DEVICE (int i, int j, int k) {
@@ -1506,8 +1621,10 @@ WarpX::ReadExternalFieldFromFile (
 
 #if defined(WARPX_DIM_RZ)
                 // Get index of the external field array
-                int const ir = std::floor( (x0-offset0)/file_dr );
-                int const iz = std::floor( (x1-offset1)/file_dz );
+                int const ir = amrex::Clamp(static_cast<int>(std::floor( (x0-offset0)/file_dr )),
+                                            chunk_lo[0], chunk_hi[0]-1);
+                int const iz = amrex::Clamp(static_cast<int>(std::floor( (x1-offset1)/file_dz )),
+                                            chunk_lo[1], chunk_hi[1]-1);
 
                 // Get coordinates of external grid point
                 amrex::Real const xx0 = offset0 + ir * file_dr;
@@ -1520,9 +1637,12 @@ WarpX::ReadExternalFieldFromFile (
                 else { x2 = real_box.lo(2) + k*dx[2] + 0.5_rt*dx[2]; }
 
                 // Get index of the external field array
-                int const ix = std::floor( (x0-offset0)/file_dx );
-                int const iy = std::floor( (x1-offset1)/file_dy );
-                int const iz = std::floor( (x2-offset2)/file_dz );
+                int const ix = amrex::Clamp(static_cast<int>(std::floor( (x0-offset0)/file_dx )),
+                                            chunk_lo[0], chunk_hi[0]-1);
+                int const iy = amrex::Clamp(static_cast<int>(std::floor( (x1-offset1)/file_dy )),
+                                            chunk_lo[1], chunk_hi[1]-1);
+                int const iz = amrex::Clamp(static_cast<int>(std::floor( (x2-offset2)/file_dz )),
+                                            chunk_lo[2], chunk_hi[2]-1);
 
                 // Get coordinates of external grid point
                 amrex::Real const xx0 = offset0 + ix * file_dx;
@@ -1531,7 +1651,8 @@ WarpX::ReadExternalFieldFromFile (
 #endif
 
 #if defined(WARPX_DIM_RZ)
-                const amrex::Array4<double> fc_array(FC_data, {0,0,0}, {extent0, extent2, extent1}, 1);
+                const amrex::Array4<double> fc_array(FC_data, {0, chunk_lo[1], chunk_lo[0]},
+                    {extent0, chunk_hi[1]+1, chunk_hi[0]+1}, 1);
                 const double
                     f00 = fc_array(0, iz  , ir  ),
                     f01 = fc_array(0, iz  , ir+1),
@@ -1542,7 +1663,8 @@ WarpX::ReadExternalFieldFromFile (
                      f00, f01, f10, f11,
                      x0, x1));
 #elif defined(WARPX_DIM_3D)
-                const amrex::Array4<double> fc_array(FC_data, {0,0,0}, {extent2, extent1, extent0}, 1);
+                const amrex::Array4<double> fc_array(FC_data, {chunk_lo[2], chunk_lo[1], chunk_lo[0]},
+                    {chunk_hi[2]+1, chunk_hi[1]+1, chunk_hi[0]+1}, 1);
                 const double
                     f000 = fc_array(iz  , iy  , ix  ),
                     f001 = fc_array(iz+1, iy  , ix  ),
@@ -1567,7 +1689,8 @@ WarpX::ReadExternalFieldFromFile (
 } // End function WarpX::ReadExternalFieldFromFile
 #else // WARPX_USE_OPENPMD && !WARPX_DIM_1D_Z && !defined(WARPX_DIM_XZ)
 void
-WarpX::ReadExternalFieldFromFile (const std::string& , amrex::MultiFab* , const std::string& , const std::string& )
+WarpX::ReadExternalFieldFromFile (const std::string& , amrex::MultiFab* , const std::string& , const std::string& ,
+                                  const amrex::Box& )
 {
 #if defined(WARPX_DIM_1D_Z)
     WARPX_ABORT_WITH_MESSAGE("Reading fields from openPMD files is not supported in 1D");
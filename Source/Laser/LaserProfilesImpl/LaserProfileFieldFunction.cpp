@@ -18,9 +18,11 @@
 #include <AMReX_ParmParse.H>
 #include <AMReX_REAL.H>
 
+#include <algorithm>
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 using namespace amrex;
 
@@ -29,10 +31,96 @@ WarpXLaserProfiles::FieldFunctionLaserProfile::init (
     const amrex::ParmParse& ppl,
     CommonLaserParameters /*params*/)
 {
-    // Parse the properties of the parse_field_function profile
-    utils::parser::Store_parserString(
-            ppl, "field_function(X,Y,t)", m_params.field_function);
-    m_parser = utils::parser::makeParser(m_params.field_function,{"X","Y","t"});
+    // Parse the properties of the parse_field_function profile:
+    // either field_function(X,Y,t), or its separable form
+    // field_function_transverse(X,Y)*field_function_temporal(t)
+    m_separable = ppl.contains("field_function_transverse(X,Y)") ||
+                  ppl.contains("field_function_temporal(t)");
+    if (m_separable) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!ppl.contains("field_function(X,Y,t)"),
+            "field_function(X,Y,t) cannot be combined with field_function_transverse(X,Y) "
+            "and field_function_temporal(t)");
+        utils::parser::Store_parserString(
+                ppl, "field_function_transverse(X,Y)", m_params.field_function_transverse);
+        utils::parser::Store_parserString(
+                ppl, "field_function_temporal(t)", m_params.field_function_temporal);
+        m_transverse_parser = utils::parser::makeParser(m_params.field_function_transverse,{"X","Y"});
+        m_temporal_parser = utils::parser::makeParser(m_params.field_function_temporal,{"t"});
+    } else {
+        utils::parser::Store_parserString(
+                ppl, "field_function(X,Y,t)", m_params.field_function);
+        m_parser = utils::parser::makeParser(m_params.field_function,{"X","Y","t"});
+    }
+
+    // Optional tabulation of the profile on a (X,Y) grid (and, if not separable, over time windows)
+    std::vector<amrex::Real> table_lo, table_hi;
+    std::vector<int> table_n;
+    m_tabulate = utils::parser::queryArrWithParser(ppl, "field_function_table_n", table_n, 0, 2);
+    if (!m_tabulate) { return; }
+
+    utils::parser::getArrWithParser(ppl, "field_function_table_lo", table_lo, 0, 2);
+    utils::parser::getArrWithParser(ppl, "field_function_table_hi", table_hi, 0, 2);
+    for (int idir = 0; idir < 2; ++idir) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(table_n[idir] >= 1 && table_hi[idir] >= table_lo[idir],
+            "field_function_table_n must be positive, and field_function_table_hi at least field_function_table_lo");
+        m_table_n[idir] = table_n[idir];
+        m_table_lo[idir] = table_lo[idir];
+        m_table_dx[idir] = (table_n[idir] > 1) ?
+            (table_hi[idir] - table_lo[idir])/static_cast<amrex::Real>(table_n[idir] - 1) : 0._rt;
+    }
+    if (m_separable) {
+        m_table_nt = 1;
+        fill_table();
+    } else {
+        utils::parser::getWithParser(ppl, "field_function_table_nt", m_table_nt);
+        utils::parser::getWithParser(ppl, "field_function_table_dt", m_table_dt);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_table_nt >= 2 && m_table_dt > 0._rt,
+            "field_function_table_nt must be at least 2, and field_function_table_dt positive");
+    }
+}
+
+void
+WarpXLaserProfiles::FieldFunctionLaserProfile::update (amrex::Real t)
+{
+    if (m_separable) {
+        m_temporal_value = m_temporal_parser.compileHost<1>()(t);
+    } else if (m_tabulate) {
+        const amrex::Real t_end = m_table_t0 + static_cast<amrex::Real>(m_table_nt - 1)*m_table_dt;
+        if (t < m_table_t0 || t > t_end) {
+            m_table_t0 = t;
+            fill_table();
+        }
+    }
+}
+
+void
+WarpXLaserProfiles::FieldFunctionLaserProfile::fill_table ()
+{
+    const int nX = m_table_n[0];
+    const int nY = m_table_n[1];
+    const int nt = m_table_nt;
+    m_table.resize(static_cast<std::size_t>(nX)*nY*nt);
+    Real* const AMREX_RESTRICT table = m_table.dataPtr();
+
+    const auto lo = m_table_lo;
+    const auto dx = m_table_dx;
+    const amrex::Real t0 = m_table_t0;
+    const amrex::Real dt = m_table_dt;
+    const bool separable = m_separable;
+    auto parser = separable ? amrex::ParserExecutor<3>{} : m_parser.compile<3>();
+    auto transverse_parser = separable ? m_transverse_parser.compile<2>() : amrex::ParserExecutor<2>{};
+
+    amrex::ParallelFor(nX*nY*nt, [=] AMREX_GPU_DEVICE (int n) noexcept
+    {
+        const int ix = n % nX;
+        const int iy = (n / nX) % nY;
+        const int it = n / (nX*nY);
+        const Real X = lo[0] + static_cast<Real>(ix)*dx[0];
+        const Real Y = lo[1] + static_cast<Real>(iy)*dx[1];
+        table[n] = separable ? transverse_parser(X, Y) :
+            parser(X, Y, t0 + static_cast<Real>(it)*dt);
+    });
+    amrex::Gpu::streamSynchronize();
 }
 
 void
@@ -40,9 +128,62 @@ WarpXLaserProfiles::FieldFunctionLaserProfile::fill_amplitude (
     const int np, Real const * AMREX_RESTRICT const Xp, Real const * AMREX_RESTRICT const Yp,
     Real t, Real * AMREX_RESTRICT const amplitude) const
 {
-    auto parser = m_parser.compile<3>();
+    const bool separable = m_separable;
+    const Real temporal = m_temporal_value;
+    auto parser = separable ? amrex::ParserExecutor<3>{} : m_parser.compile<3>();
+    auto transverse_parser = separable ? m_transverse_parser.compile<2>() : amrex::ParserExecutor<2>{};
+
+    // Interpolation in the table: linear in time (within the time window of a
+    // non-separable profile), bilinear in (X,Y). The particles outside of the
+    // table, or times outside of the window, use the parser.
+    const Real* AMREX_RESTRICT table = m_tabulate ? m_table.dataPtr() : nullptr;
+    int it0 = 0;
+    Real wt = 0._rt;
+    if (table && !separable) {
+        const Real st = (t - m_table_t0)/m_table_dt;
+        if (st >= 0._rt && st <= static_cast<Real>(m_table_nt - 1)) {
+            it0 = std::min(static_cast<int>(st), m_table_nt - 2);
+            wt = st - static_cast<Real>(it0);
+        } else {
+            table = nullptr;
+        }
+    }
+    const auto lo = m_table_lo;
+    const auto dx = m_table_dx;
+    const auto n = m_table_n;
+
     amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (int i) noexcept
     {
-        amplitude[i] = parser(Xp[i], Yp[i], t);
+        const Real X = Xp[i];
+        const Real Y = Yp[i];
+        if (table) {
+            const Real pos[2] = {X, Y};
+            int idx[2] = {0, 0};
+            int next[2] = {0, 0};
+            Real w[2] = {0._rt, 0._rt};
+            bool inside = true;
+            for (int idir = 0; idir < 2; ++idir) {
+                if (n[idir] == 1) { continue; }
+                const Real s = (pos[idir] - lo[idir])/dx[idir];
+                inside = inside && (s >= 0._rt) && (s <= static_cast<Real>(n[idir] - 1));
+                idx[idir] = amrex::min(amrex::max(static_cast<int>(s), 0), n[idir] - 2);
+                next[idir] = 1;
+                w[idir] = s - static_cast<Real>(idx[idir]);
+            }
+            if (inside) {
+                auto bilinear = [&] (int it) {
+                    const Real* AMREX_RESTRICT p = table + static_cast<long>(it)*n[0]*n[1];
+                    const int i00 = idx[1]*n[0] + idx[0];
+                    const int i01 = (idx[1] + next[1])*n[0] + idx[0];
+                    return (1._rt - w[1])*((1._rt - w[0])*p[i00] + w[0]*p[i00 + next[0]])
+                        + w[1]*((1._rt - w[0])*p[i01] + w[0]*p[i01 + next[0]]);
+                };
+                Real f = bilinear(it0);
+                if (wt > 0._rt) { f = (1._rt - wt)*f + wt*bilinear(it0 + 1); }
+                amplitude[i] = separable ? f*temporal : f;
+                return;
+            }
+        }
+        amplitude[i] = separable ? transverse_parser(X, Y)*temporal : parser(X, Y, t);
     });
 }
@@ -33,6 +33,7 @@
 #include <cmath>
 #include <cstdint>
 #include <fstream>
+#include <future>
 #include <iterator>
 #include <limits>
 #include <string>
@@ -99,6 +100,10 @@ WarpXLaserProfiles::FromFileLaserProfile::init (
     }
     //Reads the (optional) delay
     utils::parser::queryWithParser(ppl, "delay", m_params.t_delay);
+    //Read the next time chunk in the background (by default only for binary files,
+    //since the openPMD backends are not necessarily thread-safe)
+    m_prefetch.enabled = !m_params.file_in_lasy_format;
+    ppl.query("prefetch_time_chunks", m_prefetch.enabled);
 
     //Read first time chunk
     if (m_params.file_in_lasy_format){
@@ -324,37 +329,18 @@ WarpXLaserProfiles::FromFileLaserProfile::read_data_t_chunk (int t_begin, int t_
         (m_params.n_rz_azimuthal_components*(i_last-i_first+1)*m_params.nr) :
         (i_last-i_first+1)*m_params.nx*m_params.ny;
     m_params.E_lasy_data.resize(data_size);
-    Vector<Complex> h_E_lasy_data(m_params.E_lasy_data.size());
+    Vector<Complex> h_E_lasy_data;
     if(ParallelDescriptor::IOProcessor()){
-        auto series = io::Series(m_params.lasy_file_name, io::Access::READ_ONLY);
-        auto i = series.iterations[0];
-        auto E = i.meshes["laserEnvelope"];
-        auto E_laser = E[io::RecordComponent::SCALAR];
-        openPMD:: Extent full_extent = E_laser.getExtent();
-        if (m_params.file_in_cartesian_geom==0) {
-            const openPMD::Extent read_extent = { full_extent[0], (i_last - i_first + 1), full_extent[2]};
-            auto r_data = E_laser.loadChunk< std::complex<double> >(io::Offset{ 0, i_first,  0}, read_extent);
-            const auto read_size = (i_last - i_first + 1)*m_params.nr;
-            series.flush();
-            for (int m=0; m<m_params.n_rz_azimuthal_components; m++){
-                for (auto j=0u; j<read_size; j++) {
-                    h_E_lasy_data[j+m*read_size] = Complex{
-                        static_cast<amrex::Real>(r_data.get()[j+m*read_size].real()),
-                        static_cast<amrex::Real>(r_data.get()[j+m*read_size].imag())};
-                }
-            }
-        } else{
-            const openPMD::Extent read_extent = {(i_last - i_first + 1), full_extent[1], full_extent[2]};
-            auto x_data = E_laser.loadChunk< std::complex<double> >(io::Offset{i_first, 0, 0}, read_extent);
-            const auto read_size = (i_last - i_first + 1)*m_params.nx*m_params.ny;
-            series.flush();
-            for (auto j=0u; j<read_size; j++) {
-                h_E_lasy_data[j] = Complex{
-                    static_cast<amrex::Real>(x_data.get()[j].real()),
-                    static_cast<amrex::Real>(x_data.get()[j].imag())};
-            }
+        //Use the chunk read in the background if it is the right one
+        if (m_prefetch.lasy_data.valid()) {
+            h_E_lasy_data = m_prefetch.lasy_data.get();
+        }
+        if (m_prefetch.t_begin != static_cast<int>(i_first)) {
+            h_E_lasy_data = load_lasy_t_chunk(static_cast<int>(i_first), static_cast<int>(i_last));
         }
     }
+    m_prefetch.t_begin = -1;
+    h_E_lasy_data.resize(m_params.E_lasy_data.size());
     //Broadcast E_lasy_data
     ParallelDescriptor::Bcast(h_E_lasy_data.dataPtr(),
         h_E_lasy_data.size(), ParallelDescriptor::IOProcessorNumber());
@@ -363,11 +349,55 @@ WarpXLaserProfiles::FromFileLaserProfile::read_data_t_chunk (int t_begin, int t_
     //Update first and last indices
     m_params.first_time_index = static_cast<int>(i_first);
     m_params.last_time_index = static_cast<int>(i_last);
+    prefetch_next_t_chunk();
 #else
     amrex::ignore_unused(t_begin, t_end);
 #endif
 }
 
+Vector<Complex>
+WarpXLaserProfiles::FromFileLaserProfile::load_lasy_t_chunk (int t_first, int t_last) const
+{
+    Vector<Complex> h_E_lasy_data;
+#ifdef WARPX_USE_OPENPMD
+    auto const i_first = static_cast<long unsigned int>(t_first);
+    auto const i_last = static_cast<long unsigned int>(t_last);
+    auto series = io::Series(m_params.lasy_file_name, io::Access::READ_ONLY);
+    auto i = series.iterations[0];
+    auto E = i.meshes["laserEnvelope"];
+    auto E_laser = E[io::RecordComponent::SCALAR];
+    openPMD:: Extent full_extent = E_laser.getExtent();
+    if (m_params.file_in_cartesian_geom==0) {
+        const openPMD::Extent read_extent = { full_extent[0], (i_last - i_first + 1), full_extent[2]};
+        auto r_data = E_laser.loadChunk< std::complex<double> >(io::Offset{ 0, i_first,  0}, read_extent);
+        const auto read_size = (i_last - i_first + 1)*m_params.nr;
+        series.flush();
+        h_E_lasy_data.resize(m_params.n_rz_azimuthal_components*read_size);
+        for (int m=0; m<m_params.n_rz_azimuthal_components; m++){
+            for (auto j=0u; j<read_size; j++) {
+                h_E_lasy_data[j+m*read_size] = Complex{
+                    static_cast<amrex::Real>(r_data.get()[j+m*read_size].real()),
+                    static_cast<amrex::Real>(r_data.get()[j+m*read_size].imag())};
+            }
+        }
+    } else{
+        const openPMD::Extent read_extent = {(i_last - i_first + 1), full_extent[1], full_extent[2]};
+        auto x_data = E_laser.loadChunk< std::complex<double> >(io::Offset{i_first, 0, 0}, read_extent);
+        const auto read_size = (i_last - i_first + 1)*m_params.nx*m_params.ny;
+        series.flush();
+        h_E_lasy_data.resize(read_size);
+        for (auto j=0u; j<read_size; j++) {
+            h_E_lasy_data[j] = Complex{
+                static_cast<amrex::Real>(x_data.get()[j].real()),
+                static_cast<amrex::Real>(x_data.get()[j].imag())};
+        }
+    }
+#else
+    amrex::ignore_unused(t_first, t_last);
+#endif
+    return h_E_lasy_data;
+}
+
 void
 WarpXLaserProfiles::FromFileLaserProfile::read_binary_data_t_chunk (int t_begin, int t_end)
 {
@@ -380,37 +410,18 @@ WarpXLaserProfiles::FromFileLaserProfile::read_binary_data_t_chunk (int t_begin,
     auto i_last = min(t_end-1, m_params.nt-1);
     const int data_size = (i_last-i_first+1)*m_params.nx*m_params.ny;
     m_params.E_binary_data.resize(data_size);
-    Vector<Real> h_E_binary_data(m_params.E_binary_data.size());
+    Vector<Real> h_E_binary_data;
     if(ParallelDescriptor::IOProcessor()){
-        //Read data chunk
-        std::ifstream inp(m_params.binary_file_name, std::ios::binary);
-        if(!inp) { WARPX_ABORT_WITH_MESSAGE("Failed to open binary file"); }
-        inp.exceptions(std::ios_base::failbit | std::ios_base::badbit);
-#if (defined(WARPX_DIM_3D))
-        auto skip_amount = 1 +
-        3*sizeof(uint32_t) +
-        2*sizeof(double) +
-        2*sizeof(double) +
-        2*sizeof(double) +
-        sizeof(double)*t_begin*m_params.nx*m_params.ny;
-#else
-        auto skip_amount = 1 +
-        3*sizeof(uint32_t) +
-        2*sizeof(double) +
-        2*sizeof(double) +
-        1*sizeof(double) +
-        sizeof(double)*t_begin*m_params.nx*m_params.ny;
-#endif
-        inp.seekg(static_cast<std::streamoff>(skip_amount));
-        if(!inp) { WARPX_ABORT_WITH_MESSAGE("Failed to read field data from binary file"); }
-        const int read_size = (i_last - i_first + 1)*
-            m_params.nx*m_params.ny;
-        Vector<double> buf_e(read_size);
-        inp.read(reinterpret_cast<char*>(buf_e.dataPtr()), static_cast<std::streamsize>(read_size*sizeof(double)));
-        if(!inp) { WARPX_ABORT_WITH_MESSAGE("Failed to read field data from binary file"); }
-        std::transform(buf_e.begin(), buf_e.end(), h_E_binary_data.begin(),
-            [](auto x) {return static_cast<amrex::Real>(x);} );
+        //Use the chunk read in the background if it is the right one
+        if (m_prefetch.binary_data.valid()) {
+            h_E_binary_data = m_prefetch.binary_data.get();
+        }
+        if (m_prefetch.t_begin != i_first) {
+            h_E_binary_data = load_binary_t_chunk(i_first, i_last);
+        }
     }
+    m_prefetch.t_begin = -1;
+    h_E_binary_data.resize(m_params.E_binary_data.size());
 
     //Broadcast E_binary_data
     ParallelDescriptor::Bcast(h_E_binary_data.dataPtr(),
@@ -422,6 +433,61 @@ WarpXLaserProfiles::FromFileLaserProfile::read_binary_data_t_chunk (int t_begin,
     //Update first and last indices
     m_params.first_time_index = static_cast<int>(i_first);
     m_params.last_time_index = static_cast<int>(i_last);
+    prefetch_next_t_chunk();
+}
+
+Vector<Real>
+WarpXLaserProfiles::FromFileLaserProfile::load_binary_t_chunk (int i_first, int i_last) const
+{
+    //Read data chunk
+    std::ifstream inp(m_params.binary_file_name, std::ios::binary);
+    if(!inp) { WARPX_ABORT_WITH_MESSAGE("Failed to open binary file"); }
+    inp.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+#if (defined(WARPX_DIM_3D))
+    auto skip_amount = 1 +
+    3*sizeof(uint32_t) +
+    2*sizeof(double) +
+    2*sizeof(double) +
+    2*sizeof(double) +
+    sizeof(double)*i_first*m_params.nx*m_params.ny;
+#else
+    auto skip_amount = 1 +
+    3*sizeof(uint32_t) +
+    2*sizeof(double) +
+    2*sizeof(double) +
+    1*sizeof(double) +
+    sizeof(double)*i_first*m_params.nx*m_params.ny;
+#endif
+    inp.seekg(static_cast<std::streamoff>(skip_amount));
+    if(!inp) { WARPX_ABORT_WITH_MESSAGE("Failed to read field data from binary file"); }
+    const int read_size = (i_last - i_first + 1)*
+        m_params.nx*m_params.ny;
+    Vector<double> buf_e(read_size);
+    inp.read(reinterpret_cast<char*>(buf_e.dataPtr()), static_cast<std::streamsize>(read_size*sizeof(double)));
+    if(!inp) { WARPX_ABORT_WITH_MESSAGE("Failed to read field data from binary file"); }
+    Vector<Real> h_E_binary_data(read_size);
+    std::transform(buf_e.begin(), buf_e.end(), h_E_binary_data.begin(),
+        [](auto x) {return static_cast<amrex::Real>(x);} );
+    return h_E_binary_data;
+}
+
+void
+WarpXLaserProfiles::FromFileLaserProfile::prefetch_next_t_chunk ()
+{
+    // The next chunk starts at the last timestep in memory, which is where the
+    // left time index is when the simulation time leaves the current chunk
+    const int t_begin = m_params.last_time_index;
+    if (!m_prefetch.enabled || m_params.last_time_index >= m_params.nt-1) { return; }
+    m_prefetch.t_begin = t_begin;
+    if (!ParallelDescriptor::IOProcessor()) { return; }
+    const int t_last = min(t_begin + m_params.time_chunk_size - 1, m_params.nt-1);
+    if (m_params.file_in_lasy_format) {
+        m_prefetch.lasy_data = std::async(std::launch::async,
+            [this, t_begin, t_last] () { return load_lasy_t_chunk(t_begin, t_last); });
+    } else {
+        m_prefetch.binary_data = std::async(std::launch::async,
+            [this, t_begin, t_last] () { return load_binary_t_chunk(t_begin, t_last); });
+    }
 }
 
 void
@@ -136,27 +136,27 @@ WarpXLaserProfiles::GaussianLaserProfile::fill_amplitude (
     const Complex prefactor = t_prefactor;
 #endif
 
-    // Copy member variables to tmp copies for GPU runs.
-    auto const tmp_profile_t_peak = m_params.t_peak;
-    auto const tmp_beta = m_params.beta;
-    auto const tmp_zeta = m_params.zeta;
-    auto const tmp_theta_stc = m_params.theta_stc;
-    auto const tmp_profile_focal_distance = m_params.focal_distance;
+    // The spatio-temporal exponent, q*(tau - a*u)^2 with u the coordinate along
+    // stc_direction, is expanded in powers of tau and u, so that all the
+    // time-dependent coefficients are computed once here rather than per particle
+    const Complex q = inv_tau2 / stretch_factor;
+    const Complex a = m_params.beta*k0
+        + 2._rt*I*( m_params.zeta - m_params.beta*m_params.focal_distance ) * inv_complex_waist_2;
+    const Real tau = t - m_params.t_peak;
+    const Complex c0 = - tau * tau * q;
+    const Complex c1 = 2._rt * q * tau * a;
+    const Complex c2 = -1._rt * q * a * a;
+    const Real cos_stc = std::cos(m_params.theta_stc);
+    const Real sin_stc = std::sin(m_params.theta_stc);
     // Loop through the macroparticle to calculate the proper amplitude
     amrex::ParallelFor(
         np,
         [=] AMREX_GPU_DEVICE (int i) {
-            const Complex stc_exponent = 1._rt / stretch_factor * inv_tau2 *
-                amrex::pow((t - tmp_profile_t_peak -
-                    tmp_beta*k0*(Xp[i]*std::cos(tmp_theta_stc) + Yp[i]*std::sin(tmp_theta_stc)) -
-                    2._rt *I*(Xp[i]*std::cos(tmp_theta_stc) + Yp[i]*std::sin(tmp_theta_stc))
-                    *( tmp_zeta - tmp_beta*tmp_profile_focal_distance ) * inv_complex_waist_2),2);
-            // stcfactor = everything but complex transverse envelope
-            const Complex stcfactor = prefactor * amrex::exp( - stc_exponent );
-            // Exp argument for transverse envelope
-            const Complex exp_argument = - ( Xp[i]*Xp[i] + Yp[i]*Yp[i] ) * inv_complex_waist_2;
-            // stcfactor + transverse envelope
-            amplitude[i] = ( stcfactor * amrex::exp( exp_argument ) ).real();
+            const Real u = Xp[i]*cos_stc + Yp[i]*sin_stc;
+            // Temporal envelope, spatio-temporal couplings and complex transverse envelope
+            const Complex exp_argument = c0 + u*(c1 + u*c2)
+                - ( Xp[i]*Xp[i] + Yp[i]*Yp[i] ) * inv_complex_waist_2;
+            amplitude[i] = ( prefactor * amrex::exp( exp_argument ) ).real();
         }
         );
 }
@@ -13,6 +13,8 @@
 #   include "BoundaryConditions/PML_RZ.H"
 #endif
 #include "Filter/BilinearFilter.H"
+#include "Python/callbacks.H"
+#include "Utils/PhaseTimer.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXProfilerWrapper.H"
@@ -30,7 +32,9 @@
 #include <AMReX_BoxArray.H>
 #include <AMReX_Config.H>
 #include <AMReX_FabArrayBase.H>
+#include <AMReX_FArrayBox.H>
 #include <AMReX_Geometry.H>
+#include <AMReX_GpuAtomic.H>
 #include <AMReX_GpuContainers.H>
 #include <AMReX_GpuControl.H>
 #include <AMReX_GpuQualifiers.H>
@@ -492,6 +496,59 @@ void WarpX::UpdateCurrentNodalToStag (amrex::MultiFab& dst, amrex::MultiFab cons
     }
 }
 
+void WarpX::AddCurrentNodalToStag (amrex::FArrayBox& dst, amrex::FArrayBox const& src,
+                                   bool use_atomics) const
+{
+    amrex::IntVect const& dst_stag = dst.box().ixType().toIntVect();
+
+    // Source FAB always has nodal index type when this function is called
+    amrex::IntVect const& src_stag = amrex::IntVect::TheNodeVector();
+
+    // Order of finite-order centering of currents
+    const int cc_nox = WarpX::current_centering_nox;
+    const int cc_noy = WarpX::current_centering_noy;
+    const int cc_noz = WarpX::current_centering_noz;
+
+    // Points of dst whose centering stencil includes points of src: along the directions
+    // where dst is cell-centered, the stencil extends by half its order on each side
+#if   defined(WARPX_DIM_1D_Z)
+    const amrex::IntVect half_stencil(cc_noz/2);
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+    const amrex::IntVect half_stencil(cc_nox/2, cc_noz/2);
+#elif defined(WARPX_DIM_3D)
+    const amrex::IntVect half_stencil(cc_nox/2, cc_noy/2, cc_noz/2);
+#endif
+    amrex::Box bx = amrex::convert(src.box(), dst_stag);
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        if (dst_stag[idim] == 0) { bx.grow(idim, half_stencil[idim]); }
+    }
+    bx &= dst.box();
+    if (bx.isEmpty()) { return; }
+
+    // Device vectors of stencil coefficients used for finite-order centering of currents
+    amrex::Real const * stencil_coeffs_x = device_current_centering_stencil_coeffs_x.data();
+    amrex::Real const * stencil_coeffs_y = device_current_centering_stencil_coeffs_y.data();
+    amrex::Real const * stencil_coeffs_z = device_current_centering_stencil_coeffs_z.data();
+
+    for (int n = 0; n < dst.nComp(); ++n)
+    {
+        amrex::Array4<amrex::Real const> const& src_arr = src.const_array(n);
+        amrex::Array4<amrex::Real>       const& dst_arr = dst.array(n);
+
+        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int j, int k, int l) noexcept
+        {
+            const amrex::Real value = warpx_interp_value(
+                j, k, l, src_arr, dst_stag, src_stag, cc_nox, cc_noy, cc_noz,
+                stencil_coeffs_x, stencil_coeffs_y, stencil_coeffs_z);
+            if (use_atomics) {
+                amrex::HostDevice::Atomic::Add(&dst_arr(j,k,l), value);
+            } else {
+                dst_arr(j,k,l) += value;
+            }
+        });
+    }
+}
+
 void
 WarpX::FillBoundaryB (IntVect ng, std::optional<bool> nodal_sync)
 {
@@ -501,6 +558,26 @@ WarpX::FillBoundaryB (IntVect ng, std::optional<bool> nodal_sync)
     }
 }
 
+void
+WarpX::FillBoundaryB_nowait (IntVect ng, std::optional<bool> nodal_sync)
+{
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        FillBoundaryB_nowait(lev, PatchType::fine, ng, nodal_sync);
+        if (lev > 0) { FillBoundaryB_nowait(lev, PatchType::coarse, ng, nodal_sync); }
+    }
+}
+
+void
+WarpX::FillBoundaryB_finish (std::optional<bool> nodal_sync)
+{
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        FillBoundaryB_finish(lev, PatchType::fine, nodal_sync);
+        if (lev > 0) { FillBoundaryB_finish(lev, PatchType::coarse, nodal_sync); }
+    }
+}
+
 void
 WarpX::FillBoundaryE (IntVect ng, std::optional<bool> nodal_sync)
 {
@@ -557,6 +634,7 @@ WarpX::FillBoundaryE (int lev, IntVect ng, std::optional<bool> nodal_sync)
 void
 WarpX::FillBoundaryE (const int lev, const PatchType patch_type, const amrex::IntVect ng, std::optional<bool> nodal_sync)
 {
+    PhaseTimer::Scope const phase_timer(PhaseTimer::FillBoundary);
     std::array<amrex::MultiFab*,3> mf;
     amrex::Periodicity period;
 
@@ -614,6 +692,7 @@ WarpX::FillBoundaryB (int lev, IntVect ng, std::optional<bool> nodal_sync)
 void
 WarpX::FillBoundaryB (const int lev, const PatchType patch_type, const amrex::IntVect ng, std::optional<bool> nodal_sync)
 {
+    PhaseTimer::Scope const phase_timer(PhaseTimer::FillBoundary);
     std::array<amrex::MultiFab*,3> mf;
     amrex::Periodicity period;
 
@@ -661,6 +740,61 @@ WarpX::FillBoundaryB (const int lev, const PatchType patch_type, const amrex::In
     }
 }
 
+void
+WarpX::FillBoundaryB_nowait (const int lev, const PatchType patch_type, const amrex::IntVect ng, std::optional<bool> nodal_sync)
+{
+    PhaseTimer::Scope const phase_timer(PhaseTimer::FillBoundary);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!WarpX::do_single_precision_comms,
+        "FillBoundaryB_nowait: single precision communications are not supported");
+
+    std::array<amrex::MultiFab*,3> mf;
+    amrex::Periodicity period;
+
+    if (patch_type == PatchType::fine)
+    {
+        mf     = {Bfield_fp[lev][0].get(), Bfield_fp[lev][1].get(), Bfield_fp[lev][2].get()};
+        period = Geom(lev).periodicity();
+    }
+    else // coarse patch
+    {
+        mf     = {Bfield_cp[lev][0].get(), Bfield_cp[lev][1].get(), Bfield_cp[lev][2].get()};
+        period = Geom(lev-1).periodicity();
+    }
+
+    // Exchange data between valid domain and PML (blocking)
+    // Fill guard cells in PML
+    if (do_pml && pml[lev] && pml[lev]->ok())
+    {
+        const std::array<amrex::MultiFab*,3> mf_pml =
+            (patch_type == PatchType::fine) ? pml[lev]->GetB_fp() : pml[lev]->GetB_cp();
+
+        pml[lev]->Exchange(mf_pml, mf, patch_type, do_pml_in_domain);
+        pml[lev]->FillBoundaryB(patch_type, nodal_sync);
+    }
+
+    // Start filling guard cells in valid domain
+    for (int i = 0; i < 3; ++i)
+    {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            ng.allLE(mf[i]->nGrowVect()),
+            "Error: in FillBoundaryB_nowait, requested more guard cells than allocated");
+
+        const amrex::IntVect nghost = (safe_guard_cells) ? mf[i]->nGrowVect() : ng;
+        ablastr::utils::communication::FillBoundary_nowait(*mf[i], nghost, period, nodal_sync);
+    }
+}
+
+void
+WarpX::FillBoundaryB_finish (const int lev, const PatchType patch_type, std::optional<bool> nodal_sync)
+{
+    PhaseTimer::Scope const phase_timer(PhaseTimer::FillBoundary);
+    const auto& Bfield = (patch_type == PatchType::fine) ? Bfield_fp[lev] : Bfield_cp[lev];
+    for (int i = 0; i < 3; ++i)
+    {
+        ablastr::utils::communication::FillBoundary_finish(*Bfield[i], nodal_sync);
+    }
+}
+
 void
 WarpX::FillBoundaryE_avg(int lev, IntVect ng)
 {
@@ -671,6 +805,7 @@ WarpX::FillBoundaryE_avg(int lev, IntVect ng)
 void
 WarpX::FillBoundaryE_avg (int lev, PatchType patch_type, IntVect ng)
 {
+    PhaseTimer::Scope const phase_timer(PhaseTimer::FillBoundary);
     if (patch_type == PatchType::fine)
     {
         if (do_pml && pml[lev]->ok())
@@ -725,6 +860,7 @@ WarpX::FillBoundaryB_avg (int lev, IntVect ng)
 void
 WarpX::FillBoundaryB_avg (int lev, PatchType patch_type, IntVect ng)
 {
+    PhaseTimer::Scope const phase_timer(PhaseTimer::FillBoundary);
     if (patch_type == PatchType::fine)
     {
         if (do_pml && pml[lev]->ok())
@@ -776,6 +912,7 @@ WarpX::FillBoundaryF (int lev, IntVect ng, std::optional<bool> nodal_sync)
 void
 WarpX::FillBoundaryF (int lev, PatchType patch_type, IntVect ng, std::optional<bool> nodal_sync)
 {
+    PhaseTimer::Scope const phase_timer(PhaseTimer::FillBoundary);
     if (patch_type == PatchType::fine)
     {
         if (do_pml && pml[lev] && pml[lev]->ok())
@@ -820,6 +957,7 @@ void WarpX::FillBoundaryG (int lev, IntVect ng, std::optional<bool> nodal_sync)
 
 void WarpX::FillBoundaryG (int lev, PatchType patch_type, IntVect ng, std::optional<bool> nodal_sync)
 {
+    PhaseTimer::Scope const phase_timer(PhaseTimer::FillBoundary);
     if (patch_type == PatchType::fine)
     {
         if (do_pml && pml[lev] && pml[lev]->ok())
@@ -864,6 +1002,7 @@ WarpX::FillBoundaryAux (IntVect ng)
 void
 WarpX::FillBoundaryAux (int lev, IntVect ng)
 {
+    PhaseTimer::Scope const phase_timer(PhaseTimer::FillBoundary);
     const amrex::Periodicity& period = Geom(lev).periodicity();
     ablastr::utils::communication::FillBoundary(*Efield_aux[lev][0], ng, WarpX::do_single_precision_comms, period);
     ablastr::utils::communication::FillBoundary(*Efield_aux[lev][1], ng, WarpX::do_single_precision_comms, period);
@@ -879,10 +1018,23 @@ WarpX::SyncCurrent (
     const amrex::Vector<std::array<std::unique_ptr<amrex::MultiFab>,3>>& J_cp,
     const amrex::Vector<std::array<std::unique_ptr<amrex::MultiFab>,3>>& J_buffer)
 {
+    PhaseTimer::Scope const phase_timer(PhaseTimer::CurrentSync);
     WARPX_PROFILE("WarpX::SyncCurrent()");
 
+    // The filter and guard cell sum of J may already have been started
+    // right after the deposition (warpx.do_nonblocking_current_sum):
+    // only wait for the communication to complete
+    if (!m_sum_boundary_J_pending.empty() && m_sum_boundary_J_pending[0])
+    {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(&J_fp == &current_fp && finest_level == 0,
+            "SyncCurrent: pending guard cell sum of J does not match the current being synchronized");
+        SumBoundaryJ_finish(0);
+        return;
+    }
+
     // If warpx.do_current_centering = 1, center currents from nodal grid to staggered grid
-    if (do_current_centering)
+    // (already done during the deposition with warpx.do_fused_current_centering = 1)
+    if (do_current_centering && !do_fused_current_centering)
     {
         AMREX_ALWAYS_ASSERT_WITH_MESSAGE(finest_level <= 1,
                                          "warpx.do_current_centering=1 not supported with more than one fine levels");
@@ -977,8 +1129,9 @@ WarpX::SyncCurrent (
                                      J_fp[lev][idim]->DistributionMap(),
                                      ncomp, 0);
                 fine_lev_cp.setVal(0.0);
-                fine_lev_cp.ParallelAdd(*mf_comm, 0, 0, ncomp, mf_comm->nGrowVect(),
-                                        IntVect(0), period);
+                ablastr::utils::communication::ParallelAdd(
+                    fine_lev_cp, *mf_comm, 0, 0, ncomp, mf_comm->nGrowVect(),
+                    IntVect(0), do_single_precision_comms, period);
                 // We now need to create a mask to fix the double counting.
                 auto owner_mask = amrex::OwnerMask(fine_lev_cp, period);
                 auto const& mma = owner_mask->const_arrays();
@@ -1046,6 +1199,7 @@ WarpX::SyncRho (
     const amrex::Vector<std::unique_ptr<amrex::MultiFab>>& charge_cp,
     const amrex::Vector<std::unique_ptr<amrex::MultiFab>>& charge_buffer)
 {
+    PhaseTimer::Scope const phase_timer(PhaseTimer::CurrentSync);
     WARPX_PROFILE("WarpX::SyncRho()");
 
     if (!charge_fp[0]) { return; }
@@ -1067,8 +1221,9 @@ WarpX::SyncRho (
                                  charge_fp[lev]->DistributionMap(),
                                  ncomp, 0);
             fine_lev_cp.setVal(0.0);
-            fine_lev_cp.ParallelAdd(*mf_comm, 0, 0, ncomp, mf_comm->nGrowVect(),
-                                    IntVect(0), period);
+            ablastr::utils::communication::ParallelAdd(
+                fine_lev_cp, *mf_comm, 0, 0, ncomp, mf_comm->nGrowVect(),
+                IntVect(0), do_single_precision_comms, period);
             // We now need to create a mask to fix the double counting.
             auto owner_mask = amrex::OwnerMask(fine_lev_cp, period);
             auto const& mma = owner_mask->const_arrays();
@@ -1147,6 +1302,10 @@ void WarpX::ApplyFilterJ (
 {
     amrex::MultiFab& J = *current[lev][idim];
 
+    // The deposited current was already filtered, tile by tile
+    // (see warpx.do_filter_in_shared_mem_deposition)
+    if (do_filter_in_shared_mem_deposition && &J == current_fp[lev][idim].get()) { return; }
+
     const int ncomp = J.nComp();
     const amrex::IntVect ngrow = J.nGrowVect();
     amrex::MultiFab Jf(J.boxArray(), J.DistributionMap(), ncomp, ngrow);
@@ -1167,14 +1326,8 @@ void WarpX::ApplyFilterJ (
     }
 }
 
-void WarpX::SumBoundaryJ (
-    const amrex::Vector<std::array<std::unique_ptr<amrex::MultiFab>,3>>& current,
-    const int lev,
-    const int idim,
-    const amrex::Periodicity& period)
+amrex::IntVect WarpX::SumBoundaryJGuardCells (amrex::MultiFab const& J) const
 {
-    amrex::MultiFab& J = *current[lev][idim];
-
     const amrex::IntVect ng = J.nGrowVect();
     amrex::IntVect ng_depos_J = get_ng_depos_J();
 
@@ -1199,7 +1352,18 @@ void WarpX::SumBoundaryJ (
 
     ng_depos_J.min(ng);
 
-    const amrex::IntVect src_ngrow = ng_depos_J;
+    return ng_depos_J;
+}
+
+void WarpX::SumBoundaryJ (
+    const amrex::Vector<std::array<std::unique_ptr<amrex::MultiFab>,3>>& current,
+    const int lev,
+    const int idim,
+    const amrex::Periodicity& period)
+{
+    amrex::MultiFab& J = *current[lev][idim];
+
+    const amrex::IntVect src_ngrow = SumBoundaryJGuardCells(J);
     const int icomp = 0;
     const int ncomp = J.nComp();
     WarpXSumGuardCells(J, period, src_ngrow, icomp, ncomp);
@@ -1216,6 +1380,54 @@ void WarpX::SumBoundaryJ (
     }
 }
 
+bool WarpX::canStartSumBoundaryJEarly () const
+{
+    // With mesh refinement, J_fp of a level only gets complete once the
+    // coarse patch of the finer level has been added to it, in SyncCurrent.
+    // The afterdeposition Python callback may access J, so it must not run
+    // while the communication is in flight.
+    return do_nonblocking_current_sum &&
+        !IsPythonCallbackInstalled("afterdeposition") &&
+        finest_level == 0 &&
+        evolve_scheme == EvolveScheme::Explicit &&
+        (electromagnetic_solver_id == ElectromagneticSolverAlgo::Yee ||
+         electromagnetic_solver_id == ElectromagneticSolverAlgo::CKC ||
+         electromagnetic_solver_id == ElectromagneticSolverAlgo::ECT) &&
+        !do_current_centering &&
+        !do_single_precision_comms;
+}
+
+void WarpX::SumBoundaryJ_nowait (const int lev)
+{
+    WARPX_PROFILE("WarpX::SumBoundaryJ_nowait()");
+
+    if (use_filter) { ApplyFilterJ(current_fp, lev); }
+
+    const amrex::Periodicity& period = Geom(lev).periodicity();
+    for (int idim = 0; idim < 3; ++idim)
+    {
+        amrex::MultiFab& J = *current_fp[lev][idim];
+        ablastr::utils::communication::SumBoundary_nowait(
+            J, 0, J.nComp(), SumBoundaryJGuardCells(J), J.nGrowVect(), period);
+    }
+
+    if (static_cast<int>(m_sum_boundary_J_pending.size()) <= lev) {
+        m_sum_boundary_J_pending.resize(lev+1, false);
+    }
+    m_sum_boundary_J_pending[lev] = true;
+}
+
+void WarpX::SumBoundaryJ_finish (const int lev)
+{
+    WARPX_PROFILE("WarpX::SumBoundaryJ_finish()");
+
+    for (int idim = 0; idim < 3; ++idim)
+    {
+        ablastr::utils::communication::SumBoundary_finish(*current_fp[lev][idim]);
+    }
+    m_sum_boundary_J_pending[lev] = false;
+}
+
 /* /brief Update the currents of `lev` by adding the currents from particles
 *         that are in the mesh refinement patches at `lev+1`
 *
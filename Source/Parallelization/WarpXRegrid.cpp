@@ -20,6 +20,10 @@
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXProfilerWrapper.H"
 
+#include <ablastr/fields/PoissonSolver.H>
+#include <ablastr/utils/Communication.H>
+#include <ablastr/utils/ScratchPool.H>
+
 #include <AMReX.H>
 #include <AMReX_BLassert.H>
 #include <AMReX_Box.H>
@@ -91,6 +95,10 @@ WarpX::LoadBalance ()
     {
         int doLoadBalance = false;
 
+        if (load_balance_prediction_factor > 0._rt) {
+            PredictCosts(lev);
+        }
+
         // Compute the new distribution mapping
         DistributionMapping newdm;
         const amrex::Real nboxes = costs[lev]->size();
@@ -150,9 +158,20 @@ WarpX::LoadBalance ()
     }
     if (loadBalancedAnyLevel)
     {
+        // the communication buffers of the previous distribution are not used anymore
+        ablastr::utils::communication::ClearCommBuffers();
+        // nor are the scratch MultiFabs and the cached Poisson solvers
+        ablastr::utils::scratch::clear_pool();
+        ablastr::fields::clearPoissonSolverCache();
+
         mypc->Redistribute();
         mypc->defineAllParticleTiles();
 
+        // the fastest current deposition may differ with the new distribution
+        if (autotune_current_deposition && autotune_current_deposition_after_load_balance) {
+            mypc->ResetCurrentDepositionAutotuner(istep[0]);
+        }
+
         // redistribute particle boundary buffer
         m_particle_boundary_buffer->redistribute();
 
@@ -197,7 +216,7 @@ WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const Distributi
             if (current_deposition_algo == CurrentDepositionAlgo::Vay) {
                 RemakeMultiFab(current_fp_vay[lev][idim], false);
             }
-            if (do_current_centering) {
+            if (do_current_centering && !do_fused_current_centering) {
                 RemakeMultiFab(current_fp_nodal[lev][idim], false);
             }
             if (fft_do_time_averaging) {
@@ -216,7 +235,6 @@ WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const Distributi
                 if(WarpX::electromagnetic_solver_id == ElectromagneticSolverAlgo::ECT){
                     RemakeMultiFab(Venl[lev][idim], false);
                     RemakeMultiFab(m_flag_info_face[lev][idim], false);
-                    RemakeMultiFab(m_flag_ext_face[lev][idim], false);
                     RemakeMultiFab(m_area_mod[lev][idim], false);
                     RemakeMultiFab(ECTRhofield[lev][idim], false);
                     m_borrowing[lev][idim] = std::make_unique<amrex::LayoutData<FaceInfoBox>>(amrex::convert(ba, Bfield_fp[lev][idim]->ixType().toIntVect()), dm);
@@ -230,6 +248,7 @@ WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const Distributi
         // phi_fp should be redistributed since we use the solution from
         // the last step as the initial guess for the next solve
         RemakeMultiFab(phi_fp[lev], true);
+        RemakeMultiFab(phi_fp_previous[lev], true);
 
         if (WarpX::electromagnetic_solver_id == ElectromagneticSolverAlgo::HybridPIC) {
             RemakeMultiFab(m_hybrid_pic_model->rho_fp_temp[lev], true);
@@ -240,6 +259,8 @@ WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const Distributi
         RemakeMultiFab(m_distance_to_eb[lev], false);
 
         int max_guard = guard_cells.ng_FieldSolver.max();
+        // the cached Poisson solvers refer to the previous EB factory
+        ablastr::fields::clearPoissonSolverCache();
         m_field_factory[lev] = amrex::makeEBFabFactory(Geom(lev), ba, dm,
                                                        {max_guard, max_guard, max_guard},
                                                        amrex::EBSupport::full);
@@ -365,8 +386,7 @@ WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const Distributi
             }
         }
 
-        // Re-initialize the lattice element finder with the new ba and dm.
-        m_accelerator_lattice[lev]->InitElementFinder(lev, ba, dm);
+        // The lattice element finder does not depend on the grids and needs no update.
 
         if (costs[lev] != nullptr)
         {
@@ -440,6 +460,35 @@ WarpX::ResetCosts ()
     }
 }
 
+void
+WarpX::PredictCosts (int lev)
+{
+    // Gather the measured costs of all the boxes on all ranks, since the boxes
+    // may have changed owners since the previous load balance check
+    const int nboxes = costs[lev]->size();
+    amrex::Vector<amrex::Real> measured(nboxes, 0._rt);
+    for (const auto& i : costs[lev]->IndexArray())
+    {
+        measured[i] = (*costs[lev])[i];
+    }
+    ParallelDescriptor::ReduceRealSum(measured.data(), nboxes);
+
+    // Only extrapolate if the grids did not change since the previous check
+    if (m_costs_previous_ba[lev] == costs[lev]->boxArray()
+        && static_cast<int>(m_costs_previous[lev].size()) == nboxes)
+    {
+        for (const auto& i : costs[lev]->IndexArray())
+        {
+            const amrex::Real c = measured[i];
+            (*costs[lev])[i] = std::max(0._rt,
+                c + load_balance_prediction_factor*(c - m_costs_previous[lev][i]));
+        }
+    }
+
+    m_costs_previous[lev] = std::move(measured);
+    m_costs_previous_ba[lev] = costs[lev]->boxArray();
+}
+
 void
 WarpX::RescaleCosts (int step)
 {
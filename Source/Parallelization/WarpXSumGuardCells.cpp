@@ -33,5 +33,6 @@ WarpXSumGuardCells(amrex::MultiFab& dst, amrex::MultiFab& src,
     amrex::IntVect const n_updated_guards = dst.nGrowVect();
 
     dst.setVal(0., icomp, ncomp, n_updated_guards);
-    dst.ParallelAdd(src, 0, icomp, ncomp, src_ngrow, n_updated_guards, period);
+    ablastr::utils::communication::ParallelAdd(dst, src, 0, icomp, ncomp, src_ngrow, n_updated_guards,
+                                               WarpX::do_single_precision_comms, period);
 }
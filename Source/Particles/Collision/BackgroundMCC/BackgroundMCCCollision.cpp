@@ -19,6 +19,8 @@
 #include <AMReX_REAL.H>
 #include <AMReX_Vector.H>
 
+#include <algorithm>
+#include <cmath>
 #include <string>
 
 BackgroundMCCCollision::BackgroundMCCCollision (std::string const& collision_name)
@@ -63,6 +65,8 @@ BackgroundMCCCollision::BackgroundMCCCollision (std::string const& collision_nam
     // compile parsers for background density and temperature
     m_background_density_func = m_background_density_parser.compile<4>();
     m_background_temperature_func = m_background_temperature_parser.compile<4>();
+    m_background_profile.define(
+        collision_name, m_background_density_func, m_background_temperature_func);
 
     utils::parser::queryWithParser(
         pp_collision_name, "max_background_density", m_max_background_density);
@@ -156,13 +160,25 @@ BackgroundMCCCollision::BackgroundMCCCollision (std::string const& collision_nam
         m_ionization_processes_exe.push_back(p.executor());
     }
 #endif
+
+    // optionally resample all cross sections on a common log-uniform energy grid
+    int cross_section_table_size = 0;
+    utils::parser::queryWithParser(
+        pp_collision_name, "cross_section_table_size", cross_section_table_size);
+    if (cross_section_table_size > 0 && !m_scattering_processes.empty()) {
+        m_scattering_processes_table = ScatteringProcessTable(
+            m_scattering_processes, cross_section_table_size);
+    }
 }
 
 /** Calculate the maximum collision frequency using a fixed energy grid that
  *  ranges from 1e-4 to 5000 eV in 0.2 eV increments
+ *
+ *  If `table` is given, the cross sections are taken from it (as in the collision kernel)
  */
 amrex::ParticleReal
-BackgroundMCCCollision::get_nu_max(amrex::Vector<ScatteringProcess> const& mcc_processes) const
+BackgroundMCCCollision::get_nu_max(amrex::Vector<ScatteringProcess> const& mcc_processes,
+                                   ScatteringProcessTable const* table) const
 {
     using namespace amrex::literals;
     amrex::ParticleReal nu, nu_max = 0.0;
@@ -186,9 +202,9 @@ BackgroundMCCCollision::get_nu_max(amrex::Vector<ScatteringProcess> const& mcc_p
         amrex::ParticleReal sigma_E = 0.0;
 
         // loop through all collision pathways
-        for (const auto &scattering_process : mcc_processes) {
+        for (int i = 0; i < static_cast<int>(mcc_processes.size()); ++i) {
             // get collision cross-section
-            sigma_E += scattering_process.getCrossSection(E);
+            sigma_E += table ? table->getCrossSection(i, E) : mcc_processes[i].getCrossSection(E);
         }
 
         // calculate collision frequency
@@ -225,7 +241,8 @@ BackgroundMCCCollision::doCollisions (amrex::Real cur_time, amrex::Real dt, Mult
         m_mass1 = species1.getMass();
 
         // calculate maximum collision frequency without ionization
-        m_nu_max = get_nu_max(m_scattering_processes);
+        m_nu_max = get_nu_max(m_scattering_processes,
+            m_scattering_processes_table.executor().isDefined() ? &m_scattering_processes_table : nullptr);
 
         // calculate total collision probability
         auto coll_n = m_nu_max * dt;
@@ -275,9 +292,29 @@ BackgroundMCCCollision::doCollisions (amrex::Real cur_time, amrex::Real dt, Mult
             + std::to_string(m_total_collision_prob_ioniz)
         );
 
+        m_collision_dt = dt;
         init_flag = true;
     }
 
+    // The collision probabilities depend on the time interval between two
+    // calls, which changes when the number of steps between collisions is adapted
+    if (dt != m_collision_dt) {
+        m_collision_dt = dt;
+        auto const coll_n = m_nu_max * dt;
+        m_total_collision_prob = 1.0_prt - std::exp(-coll_n);
+        if (ionization_flag) {
+            m_total_collision_prob_ioniz = 1.0_prt - std::exp(-m_nu_max_ioniz * dt);
+        }
+        if (std::max(m_nu_max, m_nu_max_ioniz) * dt > 0.1_prt) {
+            ablastr::warn_manager::WMRecordWarning("BackgroundMCC Collisions",
+                     "the time between two MCC collision steps is too large to ensure accurate results, "
+                     "coll_n: " + std::to_string(std::max(m_nu_max, m_nu_max_ioniz) * dt) + " is > 0.1\n");
+        }
+    }
+
+    // evaluate the background on the grid, if needed
+    m_background_profile.update(species1, cur_time);
+
     // Loop over refinement levels
     auto const flvl = species1.finestLevel();
     for (int lev = 0; lev <= flvl; ++lev) {
@@ -325,13 +362,14 @@ void BackgroundMCCCollision::doBackgroundCollisionsWithinTile
     // get particle count
     const long np = pti.numParticles();
 
-    // get parsers for the background density and temperature
-    auto n_a_func = m_background_density_func;
-    auto T_a_func = m_background_temperature_func;
+    // get the background density and temperature
+    auto const background = m_background_profile.executor(pti.GetLevel(), pti, t);
 
     // get collision parameters
     auto *scattering_processes = m_scattering_processes_exe.data();
     auto const process_count  = static_cast<int>(m_scattering_processes_exe.size());
+    auto const cross_section_table = m_scattering_processes_table.executor();
+    bool const use_table = cross_section_table.isDefined();
 
     auto const total_collision_prob = m_total_collision_prob;
     auto const nu_max = m_nu_max;
@@ -363,8 +401,8 @@ void BackgroundMCCCollision::doBackgroundCollisionsWithinTile
                               amrex::ParticleReal x, y, z;
                               GetPosition.AsStored(ip, x, y, z);
 
-                              const amrex::ParticleReal n_a = n_a_func(x, y, z, t);
-                              const amrex::ParticleReal T_a = T_a_func(x, y, z, t);
+                              const amrex::ParticleReal n_a = background.density(x, y, z);
+                              const amrex::ParticleReal T_a = background.temperature(x, y, z);
 
                               amrex::ParticleReal v_coll, v_coll2, sigma_E, nu_i = 0;
                               double gamma, E_coll;
@@ -393,12 +431,20 @@ void BackgroundMCCCollision::doBackgroundCollisionsWithinTile
                               // calculate the collision energy in eV
                               ParticleUtils::getCollisionEnergy(v_coll2, m, M, gamma, E_coll);
 
+                              // position of the collision energy in the cross-section table
+                              ScatteringProcessTable::Location table_loc;
+                              if (use_table) {
+                                  table_loc = cross_section_table.locate(static_cast<amrex::ParticleReal>(E_coll));
+                              }
+
                               // loop through all collision pathways
                               for (int i = 0; i < process_count; i++) {
                                   auto const& scattering_process = *(scattering_processes + i);
 
                                   // get collision cross-section
-                                  sigma_E = scattering_process.getCrossSection(static_cast<amrex::ParticleReal>(E_coll));
+                                  sigma_E = use_table ?
+                                      cross_section_table.getCrossSection(table_loc, i, static_cast<amrex::ParticleReal>(E_coll)) :
+                                      scattering_process.getCrossSection(static_cast<amrex::ParticleReal>(E_coll));
 
                                   // calculate normalized collision frequency
                                   nu_i += n_a * sigma_E * v_coll / nu_max;
@@ -477,12 +523,6 @@ void BackgroundMCCCollision::doBackgroundIonization
     const auto CopyElec = copy_factory_elec.getSmartCopy();
     const auto CopyIon = copy_factory_ion.getSmartCopy();
 
-    const auto Filter = ImpactIonizationFilterFunc(
-                                                   m_ionization_processes[0],
-                                                   m_mass1, m_total_collision_prob_ioniz,
-                                                   m_nu_max_ioniz, m_background_density_func, t
-                                                   );
-
     const amrex::ParticleReal sqrt_kb_m = std::sqrt(PhysConst::kb / m_background_mass);
 
 #ifdef AMREX_USE_OMP
@@ -502,9 +542,15 @@ void BackgroundMCCCollision::doBackgroundIonization
         const auto np_elec = elec_tile.numParticles();
         const auto np_ion = ion_tile.numParticles();
 
+        auto const background = m_background_profile.executor(lev, pti, t);
+        const auto Filter = ImpactIonizationFilterFunc(
+                                                   m_ionization_processes[0],
+                                                   m_mass1, m_total_collision_prob_ioniz,
+                                                   m_nu_max_ioniz, background
+                                                   );
         auto Transform = ImpactIonizationTransformFunc(
                                                        m_ionization_processes[0].getEnergyPenalty(),
-                                                       m_mass1, sqrt_kb_m, m_background_temperature_func, t
+                                                       m_mass1, sqrt_kb_m, background
                                                        );
 
         const auto num_added = filterCopyTransformParticles<1>(species1, species2,
@@ -512,8 +558,8 @@ void BackgroundMCCCollision::doBackgroundIonization
                                                                Filter, CopyElec, CopyIon, Transform
                                                                );
 
-        setNewParticleIDs(elec_tile, np_elec, num_added);
-        setNewParticleIDs(ion_tile, np_ion, num_added);
+        setNewParticleIDs(elec_tile, np_elec, num_added, species1.AssignUniqueIDs());
+        setNewParticleIDs(ion_tile, np_ion, num_added, species2.AssignUniqueIDs());
 
         if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
         {
@@ -0,0 +1,115 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "BackgroundProfile.H"
+
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/TextMsg.H"
+#include "WarpX.H"
+
+#include <AMReX_BoxArray.H>
+#include <AMReX_DistributionMapping.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_ParmParse.H>
+
+void
+BackgroundProfile::define (std::string const& collision_name,
+                           amrex::ParserExecutor<4> const& density_func,
+                           amrex::ParserExecutor<4> const& temperature_func)
+{
+    m_density_func = density_func;
+    m_temperature_func = temperature_func;
+
+    const amrex::ParmParse pp_collision_name(collision_name);
+    pp_collision_name.query("background_on_grid", m_on_grid);
+    pp_collision_name.query("background_grid_update_interval", m_update_interval);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_update_interval >= 0,
+        collision_name + ".background_grid_update_interval must be non-negative");
+}
+
+void
+BackgroundProfile::update (WarpXParticleContainer const& species, amrex::Real t)
+{
+    using namespace amrex::literals;
+
+    if (!m_on_grid) { return; }
+
+    const int step = WarpX::GetInstance().getistep(0);
+    const bool refresh = (m_last_update_step < 0) ||
+        (m_update_interval > 0 && step - m_last_update_step >= m_update_interval);
+
+    const int nlevs = species.finestLevel() + 1;
+    m_fields.resize(nlevs);
+    m_plo.resize(nlevs);
+    m_dxi.resize(nlevs);
+
+    for (int lev = 0; lev < nlevs; ++lev) {
+        amrex::BoxArray ba = species.ParticleBoxArray(lev);
+        ba.surroundingNodes();
+        const amrex::DistributionMapping& dm = species.ParticleDistributionMap(lev);
+
+        // The grids change with regridding and load balancing
+        const bool grids_changed = !m_fields[lev] ||
+            m_fields[lev]->boxArray() != ba || m_fields[lev]->DistributionMap() != dm;
+        if (!refresh && !grids_changed) { continue; }
+        if (grids_changed) {
+            m_fields[lev] = std::make_unique<amrex::MultiFab>(ba, dm, 2, 0);
+        }
+
+        const amrex::Geometry& geom = species.Geom(lev);
+        const auto dx = geom.CellSizeArray();
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+            m_plo[lev][d] = geom.ProbLo(d) - static_cast<amrex::Real>(geom.Domain().smallEnd(d))*dx[d];
+            m_dxi[lev][d] = 1._rt/dx[d];
+        }
+        const auto plo = m_plo[lev];
+        const auto density_func = m_density_func;
+        const auto temperature_func = m_temperature_func;
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+        for (amrex::MFIter mfi(*m_fields[lev], amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+            amrex::Array4<amrex::Real> const& arr = m_fields[lev]->array(mfi);
+            amrex::ParallelFor(mfi.tilebox(), [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+#if defined(WARPX_DIM_3D)
+                const amrex::Real x = plo[0] + i*dx[0];
+                const amrex::Real y = plo[1] + j*dx[1];
+                const amrex::Real z = plo[2] + k*dx[2];
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+                const amrex::Real x = plo[0] + i*dx[0];
+                const amrex::Real y = 0._rt;
+                const amrex::Real z = plo[1] + j*dx[1];
+#else
+                const amrex::Real x = 0._rt;
+                const amrex::Real y = 0._rt;
+                const amrex::Real z = plo[0] + i*dx[0];
+#endif
+                arr(i,j,k,0) = density_func(x, y, z, t);
+                arr(i,j,k,1) = temperature_func(x, y, z, t);
+            });
+        }
+    }
+    if (refresh) { m_last_update_step = step; }
+}
+
+BackgroundProfile::Executor
+BackgroundProfile::executor (int lev, amrex::MFIter const& mfi, amrex::Real t) const
+{
+    Executor exe;
+    exe.m_density_func = m_density_func;
+    exe.m_temperature_func = m_temperature_func;
+    exe.m_t = t;
+    exe.m_on_grid = m_on_grid;
+    if (m_on_grid) {
+        exe.m_arr = m_fields[lev]->const_array(mfi);
+        exe.m_plo = m_plo[lev];
+        exe.m_dxi = m_dxi[lev];
+    }
+    return exe;
+}
@@ -69,6 +69,8 @@ BackgroundStopping::BackgroundStopping (std::string const& collision_name)
     constexpr auto num_parser_args = 4;
     m_background_density_func = m_background_density_parser.compile<num_parser_args>();
     m_background_temperature_func = m_background_temperature_parser.compile<num_parser_args>();
+    m_background_profile.define(
+        collision_name, m_background_density_func, m_background_temperature_func);
 
     if (m_background_type == BackgroundStoppingType::ELECTRONS) {
         m_background_mass = PhysConst::m_e;
@@ -100,6 +102,9 @@ BackgroundStopping::doCollisions (amrex::Real cur_time, amrex::Real dt, MultiPar
 
     const BackgroundStoppingType background_type = m_background_type;
 
+    // evaluate the background on the grid, if needed
+    m_background_profile.update(species, cur_time);
+
     // Loop over refinement levels
     auto const flvl = species.finestLevel();
     for (int lev = 0; lev <= flvl; ++lev) {
@@ -148,9 +153,8 @@ void BackgroundStopping::doBackgroundStoppingOnElectronsWithinTile (WarpXParIter
     // get background particle mass
     amrex::ParticleReal const mass_e = m_background_mass;
 
-    // setup parsers for the background density and temperature
-    auto const n_e_func = m_background_density_func;
-    auto const T_e_func = m_background_temperature_func;
+    // get the background density and temperature
+    auto const background = m_background_profile.executor(pti.GetLevel(), pti, t);
 
     // get Struct-Of-Array particle data, also called attribs
     auto& attribs = pti.GetAttribs();
@@ -167,8 +171,8 @@ void BackgroundStopping::doBackgroundStoppingOnElectronsWithinTile (WarpXParIter
 
             amrex::ParticleReal x, y, z;
             GetPosition.AsStored(ip, x, y, z);
-            amrex::ParticleReal const n_e = n_e_func(x, y, z, t);
-            amrex::ParticleReal const T_e = T_e_func(x, y, z, t)*PhysConst::kb;
+            amrex::ParticleReal const n_e = background.density(x, y, z);
+            amrex::ParticleReal const T_e = background.temperature(x, y, z)*PhysConst::kb;
 
             AMREX_ASSERT(n_e > 0_prt);
             AMREX_ASSERT(T_e > 0_prt);
@@ -223,9 +227,8 @@ void BackgroundStopping::doBackgroundStoppingOnIonsWithinTile (WarpXParIter& pti
     amrex::ParticleReal const mass_i = m_background_mass;
     amrex::ParticleReal const charge_state_i = m_background_charge_state;
 
-    // setup parsers for the background density and temperature
-    auto const n_i_func = m_background_density_func;
-    auto const T_i_func = m_background_temperature_func;
+    // get the background density and temperature
+    auto const background = m_background_profile.executor(pti.GetLevel(), pti, t);
 
     // get Struct-Of-Array particle data, also called attribs
     auto& attribs = pti.GetAttribs();
@@ -242,8 +245,8 @@ void BackgroundStopping::doBackgroundStoppingOnIonsWithinTile (WarpXParIter& pti
 
             amrex::ParticleReal x, y, z;
             GetPosition.AsStored(ip, x, y, z);
-            amrex::ParticleReal const n_i = n_i_func(x, y, z, t);
-            amrex::ParticleReal const T_i = T_i_func(x, y, z, t)*PhysConst::kb;
+            amrex::ParticleReal const n_i = background.density(x, y, z);
+            amrex::ParticleReal const T_i = background.temperature(x, y, z)*PhysConst::kb;
 
             AMREX_ASSERT(n_i > 0_prt);
             AMREX_ASSERT(T_i > 0_prt);
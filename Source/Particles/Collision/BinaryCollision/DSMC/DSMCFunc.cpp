@@ -73,7 +73,17 @@ DSMCFunc::DSMCFunc (
     }
 #endif
 
+    // optionally resample all cross sections on a common log-uniform energy grid
+    int cross_section_table_size = 0;
+    utils::parser::queryWithParser(
+        pp_collision_name, "cross_section_table_size", cross_section_table_size);
+    if (cross_section_table_size > 0 && process_count > 0) {
+        m_scattering_processes_table = ScatteringProcessTable(
+            m_scattering_processes, cross_section_table_size);
+    }
+
     // Link executor to appropriate ScatteringProcess executors
     m_exe.m_scattering_processes_data = m_scattering_processes_exe.data();
     m_exe.m_process_count = process_count;
+    m_exe.m_cross_section_table = m_scattering_processes_table.executor();
 }
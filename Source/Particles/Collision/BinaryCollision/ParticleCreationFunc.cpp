@@ -52,6 +52,9 @@ ParticleCreationFunc::ParticleCreationFunc (const std::string& collision_name,
         WARPX_ABORT_WITH_MESSAGE("Unknown collision type in ParticleCreationFunc");
     }
 
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_num_product_species <= BinaryCollisionUtils::max_product_species,
+        "Too many product species in ParticleCreationFunc");
+
 #ifdef AMREX_USE_GPU
      m_num_products_device.resize(m_num_product_species);
      amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, m_num_products_host.begin(),
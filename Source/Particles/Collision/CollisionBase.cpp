@@ -7,9 +7,12 @@
 #include "CollisionBase.H"
 
 #include "Utils/Parser/ParserUtils.H"
+#include "Utils/TextMsg.H"
 
 #include <AMReX_ParmParse.H>
 
+#include <algorithm>
+
 CollisionBase::CollisionBase (const std::string& collision_name)
 {
 
@@ -22,4 +25,34 @@ CollisionBase::CollisionBase (const std::string& collision_name)
     utils::parser::queryWithParser(
         pp_collision_name, "ndt", ndt);
     m_ndt = ndt;
+
+    // adapt the number of time steps between collisions to the collision frequency
+    pp_collision_name.query("adaptive_ndt", m_adaptive_ndt);
+    if (m_adaptive_ndt) {
+        utils::parser::queryWithParser(
+            pp_collision_name, "ndt_max", m_ndt_max);
+        utils::parser::queryWithParser(
+            pp_collision_name, "adaptive_ndt_target", m_adaptive_ndt_target);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_ndt_max >= 1 && m_ndt >= 1 && m_ndt <= m_ndt_max,
+            collision_name + ".ndt and " + collision_name + ".ndt_max must satisfy 1 <= ndt <= ndt_max");
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_adaptive_ndt_target > 0,
+            collision_name + ".adaptive_ndt_target must be positive");
+    }
+}
+
+void CollisionBase::update_ndt (amrex::Real dt)
+{
+    if (!m_adaptive_ndt) { return; }
+
+    const amrex::Real nu_max = get_max_collision_frequency();
+    // Increase the interval by at most a factor 2 per collision call, so that a
+    // transient lack of colliding pairs does not jump straight to ndt_max
+    int ndt = std::min(2*m_ndt, m_ndt_max);
+    if (nu_max > 0) {
+        const amrex::Real ndt_target = m_adaptive_ndt_target / (nu_max*dt);
+        if (ndt_target < static_cast<amrex::Real>(ndt)) {
+            ndt = std::max(1, static_cast<int>(ndt_target));
+        }
+    }
+    m_ndt = ndt;
 }
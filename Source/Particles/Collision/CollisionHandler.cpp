@@ -71,24 +71,44 @@ CollisionHandler::CollisionHandler(MultiParticleContainer const * const mypc)
             WARPX_ABORT_WITH_MESSAGE("Unknown collision type.");
         }
 
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            !allcollisions[i]->use_adaptive_ndt() ||
+            type == "pairwisecoulomb" || type == "background_mcc",
+            collision_names[i] + ".adaptive_ndt is only supported for the collision types "
+            "pairwisecoulomb and background_mcc.");
     }
 
+    m_next_collision_step.resize(ncollisions, -1);
 }
 
-/** Perform all collisions
+/** Perform all collisions that are due at this step
+ *
+ * Each collision is performed every `ndt` steps, with a time step `ndt*dt`.
+ * With a fixed `ndt`, collisions happen at the steps that are multiples of `ndt`.
+ * With an adaptive `ndt`, the next collision step is set after each collision,
+ * from the collision frequency measured during that collision.
  *
  * @param cur_time Current time
  * @param dt time step size
+ * @param step current step
  * @param mypc MultiParticleContainer calling this method
  *
  */
-void CollisionHandler::doCollisions ( amrex::Real cur_time, amrex::Real dt, MultiParticleContainer* mypc)
+void CollisionHandler::doCollisions ( amrex::Real cur_time, amrex::Real dt, int step, MultiParticleContainer* mypc)
 {
 
-    for (auto& collision : allcollisions) {
+    for (int i = 0; i < static_cast<int>(allcollisions.size()); ++i) {
+        auto& collision = allcollisions[i];
         int const ndt = collision->get_ndt();
-        if ( int(std::floor(cur_time/dt)) % ndt == 0 ) {
-            collision->doCollisions(cur_time, dt*ndt, mypc);
+        bool const do_collision = collision->use_adaptive_ndt() ?
+            step >= m_next_collision_step[i] : step % ndt == 0;
+        if (!do_collision) { continue; }
+
+        collision->doCollisions(cur_time, dt*ndt, mypc);
+
+        if (collision->use_adaptive_ndt()) {
+            collision->update_ndt(dt);
+            m_next_collision_step[i] = step + ndt;
         }
     }
 
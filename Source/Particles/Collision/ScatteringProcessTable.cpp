@@ -0,0 +1,74 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "ScatteringProcessTable.H"
+
+#include "Utils/TextMsg.H"
+
+#include <AMReX_GpuDevice.H>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+ScatteringProcessTable::ScatteringProcessTable (
+    amrex::Vector<ScatteringProcess> const& processes, const int n_energies)
+{
+    using namespace amrex::literals;
+
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(n_energies >= 2,
+        "The cross-section table must have at least 2 energy points.");
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!processes.empty(),
+        "The cross-section table needs at least one scattering process.");
+
+    // The grid covers the energy ranges of all processes. Its first point is the
+    // smallest positive energy of the input data.
+    amrex::ParticleReal energy_lo = std::numeric_limits<amrex::ParticleReal>::max();
+    amrex::ParticleReal energy_hi = 0._prt;
+    for (auto const& process : processes) {
+        const amrex::ParticleReal lo = process.getMinEnergyInput();
+        energy_lo = std::min(energy_lo, (lo > 0._prt) ? lo : process.getEnergyInputStep());
+        energy_hi = std::max(energy_hi, process.getMaxEnergyInput());
+    }
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(energy_hi > energy_lo,
+        "Invalid energy range for the cross-section table.");
+
+    const auto process_count = static_cast<int>(processes.size());
+    const amrex::ParticleReal dlogE = std::log(energy_hi/energy_lo) / static_cast<amrex::ParticleReal>(n_energies - 1);
+
+    // Row 0 holds the cross sections at zero energy, rows 1 to n_energies the grid points
+    m_sigmas_h.resize(static_cast<std::size_t>(n_energies + 1) * process_count);
+    m_energy_penalty_h.resize(process_count);
+    for (int p = 0; p < process_count; ++p) {
+        m_sigmas_h[p] = processes[p].getCrossSection(0._prt);
+        for (int i = 0; i < n_energies; ++i) {
+            const amrex::ParticleReal E = (i == n_energies - 1) ? energy_hi :
+                energy_lo * std::exp(dlogE * static_cast<amrex::ParticleReal>(i));
+            m_sigmas_h[(i+1)*process_count + p] = processes[p].getCrossSection(E);
+        }
+        m_energy_penalty_h[p] = processes[p].getEnergyPenalty();
+    }
+
+    m_exe_h.m_sigmas = m_sigmas_h.data();
+    m_exe_h.m_energy_penalty = m_energy_penalty_h.data();
+    m_exe_h.m_energy_lo = energy_lo;
+    m_exe_h.m_inv_dlogE = 1._prt / dlogE;
+    m_exe_h.m_n_energies = n_energies;
+    m_exe_h.m_process_count = process_count;
+
+#ifdef AMREX_USE_GPU
+    m_exe_d = m_exe_h;
+    m_sigmas_d.resize(m_sigmas_h.size());
+    m_energy_penalty_d.resize(m_energy_penalty_h.size());
+    m_exe_d.m_sigmas = m_sigmas_d.data();
+    m_exe_d.m_energy_penalty = m_energy_penalty_d.data();
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, m_sigmas_h.begin(), m_sigmas_h.end(),
+                          m_sigmas_d.begin());
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, m_energy_penalty_h.begin(), m_energy_penalty_h.end(),
+                          m_energy_penalty_d.begin());
+    amrex::Gpu::streamSynchronize();
+#endif
+}
@@ -7,6 +7,8 @@
 #include "Utils/TextMsg.H"
 #include "WarpX.H"
 
+#include <AMReX_Geometry.H>
+#include <AMReX_MultiFab.H>
 #include <AMReX_Vector.H>
 
 #include <string>
@@ -83,6 +85,34 @@ GetExternalEBField::GetExternalEBField (const WarpXParIter& a_pti, long a_offset
         m_repeated_plasma_lens_strengths_B = mypc.d_repeated_plasma_lens_strengths_B.data();
     }
 
+    // Use the values evaluated on the grid when they are available for this tile
+    if (mypc.m_ext_particle_fields_on_grid)
+    {
+        auto const* E_grid = (lev < static_cast<int>(mypc.m_E_ext_particle_grid.size())) ?
+            mypc.m_E_ext_particle_grid[lev].get() : nullptr;
+        auto const* B_grid = (lev < static_cast<int>(mypc.m_B_ext_particle_grid.size())) ?
+            mypc.m_B_ext_particle_grid[lev].get() : nullptr;
+        const amrex::Geometry& geom = warpx.Geom(lev);
+        const auto problo = geom.ProbLoArray();
+        const auto dxi = geom.InvCellSizeArray();
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            m_grid_xyzmin[idim] = problo[idim];
+            m_grid_dxi[idim] = dxi[idim];
+        }
+        auto const on_this_grid = [&] (amrex::MultiFab const* mf) {
+            return mf && mf->boxArray().CellEqual(warpx.boxArray(lev)) &&
+                mf->DistributionMap() == warpx.DistributionMap(lev);
+        };
+        if (m_Etype == Parser && on_this_grid(E_grid)) {
+            m_Etype = ParserOnGrid;
+            m_E_grid = E_grid->const_array(a_pti);
+        }
+        if (m_Btype == Parser && on_this_grid(B_grid)) {
+            m_Btype = ParserOnGrid;
+            m_B_grid = B_grid->const_array(a_pti);
+        }
+    }
+
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_Etype != Unknown, "Unknown E_ext_particle_init_style");
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_Btype != Unknown, "Unknown B_ext_particle_init_style");
 
@@ -50,6 +50,7 @@
 #include <AMReX_StructOfArrays.H>
 #include <AMReX_Utility.H>
 #include <AMReX_Vector.H>
+#include <AMReX_iMultiFab.H>
 
 #ifdef AMREX_USE_OMP
 #   include <omp.h>
@@ -124,6 +125,11 @@ LaserParticleContainer::LaserParticleContainer (AmrCore* amr_core, int ispecies,
         );
 
     pp_laser_name.query("do_continuous_injection", do_continuous_injection);
+    std::string antenna_type = "particles";
+    pp_laser_name.query("antenna_type", antenna_type);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(antenna_type == "particles" || antenna_type == "current",
+        m_laser_name + ".antenna_type must be particles or current");
+    m_current_antenna = (antenna_type == "current");
     utils::parser::queryWithParser(pp_laser_name,
         "min_particles_per_mode", m_min_particles_per_mode);
 
@@ -179,6 +185,30 @@ LaserParticleContainer::LaserParticleContainer (AmrCore* amr_core, int ispecies,
     Real s = 1.0_rt / std::sqrt(m_nvec[0]*m_nvec[0] + m_nvec[1]*m_nvec[1] + m_nvec[2]*m_nvec[2]);
     m_nvec = { m_nvec[0]*s, m_nvec[1]*s, m_nvec[2]*s };
 
+    if (m_current_antenna) {
+#if defined(WARPX_DIM_RZ)
+        WARPX_ABORT_WITH_MESSAGE(m_laser_name + ".antenna_type = current is not implemented in RZ");
+#endif
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(WarpX::gamma_boost == 1._rt && !do_continuous_injection,
+            m_laser_name + ".antenna_type = current requires a fixed antenna, "
+            "without boosted frame or continuous injection");
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(maxLevel() == 0,
+            m_laser_name + ".antenna_type = current is not implemented with mesh refinement");
+        // Component of the 3D vectors that corresponds to each grid dimension
+#if defined(WARPX_DIM_3D)
+        const std::array<int,AMREX_SPACEDIM> vector_comp = {0, 1, 2};
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+        const std::array<int,AMREX_SPACEDIM> vector_comp = {0, 2};
+#else
+        const std::array<int,AMREX_SPACEDIM> vector_comp = {2};
+#endif
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            if (std::abs(m_nvec[vector_comp[idim]]) > 1._rt - 1.e-12_rt) { m_antenna_normal_dir = idim; }
+        }
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_antenna_normal_dir >= 0,
+            m_laser_name + ".antenna_type = current requires the laser direction to be along a grid axis");
+    }
+
     if (WarpX::gamma_boost > 1.) {
         // Check that the laser direction is equal to the boost direction
         AMREX_ALWAYS_ASSERT_WITH_MESSAGE(  m_nvec[0]*WarpX::boost_direction[0]
@@ -354,6 +384,9 @@ LaserParticleContainer::InitData ()
 {
     if (!m_enabled) { return; }
 
+    // The current antenna has no particles
+    if (m_current_antenna) { return; }
+
     // Call InitData on max level to inject one laser particle per
     // finest cell.
     InitData(maxLevel());
@@ -581,6 +614,13 @@ LaserParticleContainer::Evolve (int lev,
     // Update laser profile
     m_up_laser_profile->update(t_lab);
 
+    if (m_current_antenna) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(push_type == PushType::Explicit,
+            m_laser_name + ".antenna_type = current is only implemented with the explicit scheme");
+        if (!skip_deposition) { DepositAntennaCurrent(lev, jx, jy, jz, t_lab); }
+        return;
+    }
+
     BL_ASSERT(OnSameGrids(lev,jx));
 
     amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
@@ -698,6 +738,106 @@ LaserParticleContainer::Evolve (int lev,
             }
         }
     }
+    // With warpx.do_colored_tile_reduction, the current of the tiles is added to J here
+    AddTileCurrents();
+}
+
+void
+LaserParticleContainer::DepositAntennaCurrent (int lev, MultiFab& jx, MultiFab& jy, MultiFab& jz,
+                                               Real t)
+{
+    WARPX_PROFILE("LaserParticleContainer::DepositAntennaCurrent()");
+
+    const amrex::Geometry& geom = Geom(lev);
+    const auto dx = geom.CellSizeArray();
+    const auto problo = geom.ProbLoArray();
+    const int ndir = m_antenna_normal_dir;
+
+    // Position of the grid dimensions in the 3D vectors, and of the antenna along the normal
+#if defined(WARPX_DIM_3D)
+    const amrex::GpuArray<int,AMREX_SPACEDIM> vector_comp = {0, 1, 2};
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+    const amrex::GpuArray<int,AMREX_SPACEDIM> vector_comp = {0, 2};
+#else
+    const amrex::GpuArray<int,AMREX_SPACEDIM> vector_comp = {2};
+#endif
+    const Real position_normal = m_position[vector_comp[ndir]];
+
+    const amrex::GpuArray<Real,3> position = {m_position[0], m_position[1], m_position[2]};
+    const amrex::GpuArray<Real,3> u_X = {m_u_X[0], m_u_X[1], m_u_X[2]};
+    const amrex::GpuArray<Real,3> u_Y = {m_u_Y[0], m_u_Y[1], m_u_Y[2]};
+
+    const std::array<MultiFab*,3> J = {&jx, &jy, &jz};
+
+    for (int comp = 0; comp < 3; ++comp)
+    {
+        if (m_p_X[comp] == 0._rt) { continue; }
+
+        // The surface current -2 eps0 c E_laser p_X emits the laser field on both sides
+        // of the plane; it is spread over one cell along the normal
+        const Real current_factor = -2._rt*PhysConst::ep0*PhysConst::c*m_p_X[comp]/dx[ndir];
+
+        const amrex::IndexType ixtype = J[comp]->ixType();
+        amrex::GpuArray<Real,AMREX_SPACEDIM> shift;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            shift[idim] = ixtype.cellCentered(idim) ? 0.5_rt : 0._rt;
+        }
+        // The two planes of grid points around the antenna, and their linear weights
+        const Real s_normal = (position_normal - problo[ndir])/dx[ndir] - shift[ndir];
+        const auto k0 = static_cast<int>(std::floor(s_normal));
+        const Real f1 = s_normal - static_cast<Real>(k0);
+
+        amrex::Gpu::DeviceVector<Real> plane_Xp, plane_Yp, amplitude_E;
+
+        // Nodal points shared between boxes get the current only once, in the box that owns them
+        const std::unique_ptr<amrex::iMultiFab> owner_mask = J[comp]->OwnerMask(geom.periodicity());
+
+        for (MFIter mfi(*J[comp]); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.validbox();
+            Box slab = bx;
+            slab.setSmall(ndir, k0);
+            slab.setBig(ndir, k0+1);
+            slab &= bx;
+            if (!slab.ok()) { continue; }
+
+            const auto np = static_cast<int>(slab.numPts());
+            plane_Xp.resize(np);
+            plane_Yp.resize(np);
+            amplitude_E.resize(np);
+            Real* const p_Xp = plane_Xp.dataPtr();
+            Real* const p_Yp = plane_Yp.dataPtr();
+            Real* const p_amplitude = amplitude_E.dataPtr();
+
+            amrex::ParallelFor(slab, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                const amrex::IntVect iv(AMREX_D_DECL(i,j,k));
+                amrex::GpuArray<Real,3> r = {0._rt, 0._rt, 0._rt};
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    r[vector_comp[idim]] = problo[idim] + (static_cast<Real>(iv[idim]) + shift[idim])*dx[idim];
+                }
+                const auto n = static_cast<int>(slab.index(iv));
+                p_Xp[n] = u_X[0]*(r[0] - position[0]) + u_X[1]*(r[1] - position[1]) + u_X[2]*(r[2] - position[2]);
+                p_Yp[n] = u_Y[0]*(r[0] - position[0]) + u_Y[1]*(r[1] - position[1]) + u_Y[2]*(r[2] - position[2]);
+            });
+
+            m_up_laser_profile->fill_amplitude(np, p_Xp, p_Yp, t, p_amplitude);
+
+            amrex::Array4<Real> const& J_arr = J[comp]->array(mfi);
+            amrex::Array4<int const> const& owner = owner_mask->const_array(mfi);
+            amrex::ParallelFor(slab, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                if (!owner(i,j,k)) { return; }
+                const amrex::IntVect iv(AMREX_D_DECL(i,j,k));
+                const Real weight = (iv[ndir] == k0) ? 1._rt - f1 : f1;
+                const auto n = static_cast<int>(slab.index(iv));
+                J_arr(i,j,k) += current_factor*weight*p_amplitude[n];
+            });
+
+            // This is necessary because of plane_Xp, plane_Yp and amplitude_E
+            amrex::Gpu::synchronize();
+        }
+    }
 }
 
 void
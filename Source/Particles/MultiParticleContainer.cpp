@@ -35,6 +35,7 @@
 #include "Particles/WarpXParticleContainer.H"
 #include "SpeciesPhysicalProperties.H"
 #include "Utils/Parser/ParserUtils.H"
+#include "Utils/StartupTimer.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXProfilerWrapper.H"
@@ -58,6 +59,7 @@
 #include <AMReX_FabArray.H>
 #include <AMReX_Geometry.H>
 #include <AMReX_GpuAtomic.H>
+#include <AMReX_GpuContainers.H>
 #include <AMReX_GpuDevice.H>
 #include <AMReX_IntVect.H>
 #include <AMReX_LayoutData.H>
@@ -69,14 +71,24 @@
 #include <AMReX_ParticleTile.H>
 #include <AMReX_Particles.H>
 #include <AMReX_Print.H>
+#include <AMReX_Random.H>
+#include <AMReX_Reduce.H>
+#include <AMReX_Scan.H>
 #include <AMReX_StructOfArrays.H>
 #include <AMReX_Utility.H>
 #include <AMReX_Vector.H>
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <future>
+#include <iomanip>
 #include <limits>
 #include <map>
+#include <memory>
+#include <random>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -91,6 +103,53 @@ namespace
     {
         Array4< amrex::Real const > const Ex, Ey, Ez, Bx, By, Bz;
     };
+
+    /** Name of the file of a QED lookup table in the cache directory,
+     *  from a hash (FNV-1a) of the parameters of the table */
+    std::string getQEDTableCacheFile (std::string const& cache_dir, std::string const& process,
+                                      std::string const& table_params)
+    {
+        std::uint64_t h = 0xcbf29ce484222325ULL;
+        for (const char c : table_params) {
+            h = (h ^ static_cast<unsigned char>(c)) * 0x100000001b3ULL;
+        }
+        std::ostringstream file_name;
+        file_name << cache_dir << "/" << process << "_table_"
+                  << std::hex << std::setw(16) << std::setfill('0') << h << ".bin";
+        return file_name.str();
+    }
+
+    /** Read a QED lookup table from the cache, on the I/O processor, and broadcast it.
+     *  Returns false if the table is not in the cache. */
+    bool loadQEDTableFromCache (std::string const& cache_file, amrex::Vector<char>& table_data)
+    {
+        int exists = 0;
+        if (ParallelDescriptor::IOProcessor()) {
+            exists = amrex::FileExists(cache_file) ? 1 : 0;
+        }
+        ParallelDescriptor::Bcast(&exists, 1, ParallelDescriptor::IOProcessorNumber());
+        if (exists == 0) { return false; }
+        ParallelDescriptor::ReadAndBcastFile(cache_file, table_data);
+        return true;
+    }
+
+    /** Save a QED lookup table in the cache (to be called by the I/O processor only).
+     *  The table is written to a temporary file which is then renamed, so that
+     *  concurrent jobs sharing the cache never read a partially written table. */
+    void saveQEDTableInCache (std::string const& cache_dir, std::string const& cache_file,
+                              amrex::Vector<char> const& table_data)
+    {
+        if (!amrex::UtilCreateDirectory(cache_dir, 0755)) {
+            amrex::CreateDirectoryFailed(cache_dir);
+        }
+        const std::string tmp_file = cache_file + ".tmp" + std::to_string(std::random_device{}());
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            WarpXUtilIO::WriteBinaryDataOnFile(tmp_file, table_data),
+            "Failed to write the QED table in the cache: " + tmp_file);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            std::rename(tmp_file.c_str(), cache_file.c_str()) == 0,
+            "Failed to move the QED table in the cache: " + cache_file);
+    }
 }
 
 MultiParticleContainer::MultiParticleContainer (AmrCore* amr_core)
@@ -260,6 +319,23 @@ MultiParticleContainer::ReadParameters ()
             amrex::Gpu::synchronize();
         }
 
+        // The parsers of the external particle fields may be evaluated on the grid,
+        // rather than at each particle
+        if (m_E_ext_particle_s == "parse_e_ext_particle_function" ||
+            m_B_ext_particle_s == "parse_b_ext_particle_function") {
+            pp_particles.query("ext_particle_fields_on_grid", m_ext_particle_fields_on_grid);
+#if defined(WARPX_DIM_RZ)
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!m_ext_particle_fields_on_grid,
+                "particles.ext_particle_fields_on_grid is not implemented in RZ");
+#endif
+            for (auto const* parser : {m_Ex_particle_parser.get(), m_Ey_particle_parser.get(),
+                                      m_Ez_particle_parser.get(), m_Bx_particle_parser.get(),
+                                      m_By_particle_parser.get(), m_Bz_particle_parser.get()}) {
+                if (parser && parser->symbols().count("t")) {
+                    m_ext_particle_fields_time_dependent = true;
+                }
+            }
+        }
 
         // particle species
         pp_particles.queryarr("species_names", species_names);
@@ -326,6 +402,7 @@ MultiParticleContainer::ReadParameters ()
 
         }
         pp_particles.query("use_fdtd_nci_corr", WarpX::use_fdtd_nci_corr);
+        pp_particles.query("use_fdtd_nci_corr_fused_gather", WarpX::use_fdtd_nci_corr_fused_gather);
 #ifdef WARPX_DIM_RZ
         WARPX_ALWAYS_ASSERT_WITH_MESSAGE(WarpX::use_fdtd_nci_corr==0,
                             "ERROR: use_fdtd_nci_corr is not supported in RZ");
@@ -352,6 +429,11 @@ MultiParticleContainer::ReadParameters ()
             m_laser_deposit_on_main_grid[i] = true;
         }
 
+        {
+            const ParmParse pp_warpx("warpx");
+            pp_warpx.query("do_batched_field_ionization", m_do_batched_field_ionization);
+        }
+
 
 #ifdef WARPX_QED
         const ParmParse pp_warpx("warpx");
@@ -368,6 +450,9 @@ MultiParticleContainer::ReadParameters ()
             utils::parser::queryWithParser(
                 pp_qed_schwinger, "threshold_poisson_gaussian",
                 m_qed_schwinger_threshold_poisson_gaussian);
+            utils::parser::queryWithParser(
+                pp_qed_schwinger, "tile_cull_threshold",
+                m_qed_schwinger_tile_cull_threshold);
             utils::parser::queryWithParser(
                 pp_qed_schwinger, "xmin", m_qed_schwinger_xmin);
             utils::parser::queryWithParser(
@@ -471,9 +556,111 @@ MultiParticleContainer::Evolve (int lev,
         if (rho) { rho->setVal(0.0); }
         if (crho) { crho->setVal(0.0); }
     }
+    UpdateExternalParticleFieldsOnGrid(lev);
     for (auto& pc : allcontainers) {
         pc->Evolve(lev, Ex, Ey, Ez, Bx, By, Bz, jx, jy, jz, cjx, cjy, cjz,
                    rho, crho, cEx, cEy, cEz, cBx, cBy, cBz, t, dt, a_dt_type, skip_deposition, push_type);
+        // The push moves the particles, and possibly creates new ones
+        pc->InvalidateCellBins();
+    }
+}
+
+void
+MultiParticleContainer::UpdateExternalParticleFieldsOnGrid (int lev)
+{
+    if (!m_ext_particle_fields_on_grid) { return; }
+
+    WARPX_PROFILE("MultiParticleContainer::UpdateExternalParticleFieldsOnGrid");
+
+    const WarpX& warpx = WarpX::GetInstance();
+    const amrex::BoxArray& ba = warpx.boxArray(lev);
+    const amrex::DistributionMapping& dm = warpx.DistributionMap(lev);
+    const amrex::Geometry& geom = warpx.Geom(lev);
+    const amrex::Real t = warpx.gett_new(lev);
+    const amrex::RealVect problo(geom.ProbLo());
+
+    if (static_cast<int>(m_E_ext_particle_grid.size()) <= lev) {
+        m_E_ext_particle_grid.resize(lev+1);
+        m_B_ext_particle_grid.resize(lev+1);
+        m_ext_particle_grid_time.resize(lev+1);
+        m_ext_particle_grid_problo.resize(lev+1);
+    }
+
+    const bool use_E = (m_E_ext_particle_s == "parse_e_ext_particle_function");
+    const bool use_B = (m_B_ext_particle_s == "parse_b_ext_particle_function");
+
+    // (Re)allocate the nodal grids when the grids of the level changed; one guard cell
+    // holds the nodes needed by the particles at the edge of the boxes
+    const amrex::BoxArray nodal_ba = amrex::convert(ba, amrex::IntVect::TheNodeVector());
+    bool reevaluate = false;
+    for (auto* ext_field : {use_E ? &m_E_ext_particle_grid[lev] : nullptr,
+                            use_B ? &m_B_ext_particle_grid[lev] : nullptr}) {
+        if (!ext_field) { continue; }
+        if (!(*ext_field) || (*ext_field)->boxArray() != nodal_ba ||
+            (*ext_field)->DistributionMap() != dm) {
+            *ext_field = std::make_unique<amrex::MultiFab>(nodal_ba, dm, 3, 1);
+            reevaluate = true;
+        }
+    }
+    if (m_ext_particle_fields_time_dependent && m_ext_particle_grid_time[lev] != t) { reevaluate = true; }
+    // The domain moves with the moving window
+    if (m_ext_particle_grid_problo[lev] != problo) { reevaluate = true; }
+    if (!reevaluate) { return; }
+    m_ext_particle_grid_time[lev] = t;
+    m_ext_particle_grid_problo[lev] = problo;
+
+    const auto problo_arr = geom.ProbLoArray();
+    const auto dx = geom.CellSizeArray();
+    const amrex::Real gamma_boost = WarpX::gamma_boost;
+    const amrex::Real uz_boost = std::sqrt(WarpX::gamma_boost*WarpX::gamma_boost - 1._rt)*PhysConst::c;
+
+    for (int ifield = 0; ifield < 2; ++ifield) {
+        amrex::MultiFab* const mf = (ifield == 0) ?
+            (use_E ? m_E_ext_particle_grid[lev].get() : nullptr) :
+            (use_B ? m_B_ext_particle_grid[lev].get() : nullptr);
+        if (!mf) { continue; }
+        constexpr auto num_arguments = 4; //x,y,z,t
+        const auto fx = (ifield == 0) ? m_Ex_particle_parser->compile<num_arguments>() :
+                                        m_Bx_particle_parser->compile<num_arguments>();
+        const auto fy = (ifield == 0) ? m_Ey_particle_parser->compile<num_arguments>() :
+                                        m_By_particle_parser->compile<num_arguments>();
+        const auto fz = (ifield == 0) ? m_Ez_particle_parser->compile<num_arguments>() :
+                                        m_Bz_particle_parser->compile<num_arguments>();
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+        for (amrex::MFIter mfi(*mf, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+            const amrex::Box bx = mfi.growntilebox();
+            amrex::Array4<amrex::Real> const& arr = mf->array(mfi);
+            amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                // Position of the node, as seen by the particles
+#if defined(WARPX_DIM_3D)
+                const amrex::Real x = problo_arr[0] + i*dx[0];
+                const amrex::Real y = problo_arr[1] + j*dx[1];
+                amrex::Real z = problo_arr[2] + k*dx[2];
+#elif defined(WARPX_DIM_XZ)
+                const amrex::Real x = problo_arr[0] + i*dx[0];
+                const amrex::Real y = 0._rt;
+                amrex::Real z = problo_arr[1] + j*dx[1];
+#else
+                const amrex::Real x = 0._rt;
+                const amrex::Real y = 0._rt;
+                amrex::Real z = problo_arr[0] + i*dx[0];
+#endif
+                // Same transformation as in GetExternalEBField: the parsers are functions
+                // of the lab frame coordinates
+                amrex::Real lab_time = t;
+                if (gamma_boost > 1._rt) {
+                    lab_time = gamma_boost*t + uz_boost*z/(PhysConst::c*PhysConst::c);
+                    z = gamma_boost*z + uz_boost*t;
+                }
+                arr(i,j,k,0) = fx(x, y, z, lab_time);
+                arr(i,j,k,1) = fy(x, y, z, lab_time);
+                arr(i,j,k,2) = fz(x, y, z, lab_time);
+            });
+        }
     }
 }
 
@@ -490,6 +677,7 @@ MultiParticleContainer::PushP (int lev, Real dt,
                                const MultiFab& Ex, const MultiFab& Ey, const MultiFab& Ez,
                                const MultiFab& Bx, const MultiFab& By, const MultiFab& Bz)
 {
+    UpdateExternalParticleFieldsOnGrid(lev);
     for (auto& pc : allcontainers) {
         pc->PushP(lev, dt, Ex, Ey, Ez, Bx, By, Bz);
     }
@@ -548,6 +736,56 @@ MultiParticleContainer::DepositCurrent (
 #endif
 }
 
+void
+MultiParticleContainer::DepositCurrentAndCharge (
+    amrex::Vector<std::array< std::unique_ptr<amrex::MultiFab>, 3 > >& J,
+    amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rho,
+    const amrex::Real dt, const amrex::Real relative_time)
+{
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(CanDepositCurrentAndCharge(rho),
+        "The current and the charge cannot be deposited in a single pass with these parameters");
+
+    // Reset the J and rho arrays
+    for (auto& J_lev : J)
+    {
+        J_lev[0]->setVal(0.0_rt);
+        J_lev[1]->setVal(0.0_rt);
+        J_lev[2]->setVal(0.0_rt);
+    }
+    for (auto& rho_lev : rho)
+    {
+        rho_lev->setVal(0.0_rt);
+    }
+
+    // Call the deposition kernel for each species
+    // (the particle positions are shifted to relative_time inside the kernel)
+    for (auto& pc : allcontainers)
+    {
+        pc->DepositCurrentAndCharge(J, rho, dt, relative_time);
+    }
+
+#ifdef WARPX_DIM_RZ
+    for (int lev = 0; lev < J.size(); ++lev)
+    {
+        WarpX::GetInstance().ApplyInverseVolumeScalingToCurrentDensity(
+            J[lev][0].get(), J[lev][1].get(), J[lev][2].get(), lev);
+        WarpX::GetInstance().ApplyInverseVolumeScalingToChargeDensity(rho[lev].get(), lev);
+    }
+#endif
+}
+
+bool
+MultiParticleContainer::CanDepositCurrentAndCharge (
+    amrex::Vector<std::unique_ptr<amrex::MultiFab> > const& rho)
+{
+    if (WarpX::current_deposition_algo != CurrentDepositionAlgo::Direct) { return false; }
+    if (WarpX::do_shared_mem_current_deposition || WarpX::do_shared_mem_charge_deposition) { return false; }
+    // The fixed-point deposition deposits the current and the charge separately
+    if (WarpX::do_fixed_point_deposition) { return false; }
+    return std::all_of(rho.begin(), rho.end(),
+        [](auto const& rho_lev) { return rho_lev && rho_lev->ixType().nodeCentered(); });
+}
+
 void
 MultiParticleContainer::DepositCharge (
     amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rho,
@@ -611,7 +849,10 @@ void
 MultiParticleContainer::SortParticlesByBin (amrex::IntVect bin_size)
 {
     for (auto& pc : allcontainers) {
-        if (WarpX::sort_particles_for_deposition) {
+        pc->InvalidateCellBins();
+        if (WarpX::sort_incremental) {
+            pc->SortParticlesByBinIncremental(bin_size);
+        } else if (WarpX::sort_particles_for_deposition) {
             pc->SortParticlesForDeposition(WarpX::sort_idx_type);
         } else {
             pc->SortParticlesByBin(bin_size);
@@ -619,14 +860,31 @@ MultiParticleContainer::SortParticlesByBin (amrex::IntVect bin_size)
     }
 }
 
+void
+MultiParticleContainer::ResetCurrentDepositionAutotuner (int step)
+{
+    for (auto& pc : allcontainers) {
+        pc->ResetCurrentDepositionAutotuner(step);
+    }
+}
+
 void
 MultiParticleContainer::Redistribute ()
 {
     for (auto& pc : allcontainers) {
+        pc->InvalidateCellBins();
         pc->Redistribute();
     }
 }
 
+void
+MultiParticleContainer::InvalidateCellBins ()
+{
+    for (auto& pc : allcontainers) {
+        pc->InvalidateCellBins();
+    }
+}
+
 void
 MultiParticleContainer::defineAllParticleTiles ()
 {
@@ -647,15 +905,16 @@ void
 MultiParticleContainer::RedistributeLocal (const int num_ghost)
 {
     for (auto& pc : allcontainers) {
+        pc->InvalidateCellBins();
         pc->Redistribute(0, 0, 0, num_ghost);
     }
 }
 
 void
-MultiParticleContainer::ApplyBoundaryConditions ()
+MultiParticleContainer::ApplyBoundaryConditions (amrex::Real max_displacement)
 {
     for (auto& pc : allcontainers) {
-        pc->ApplyBoundaryConditions();
+        pc->ApplyBoundaryConditions(max_displacement);
     }
 }
 
@@ -809,6 +1068,30 @@ MultiParticleContainer::mapSpeciesProduct ()
             getSpeciesID(m_qed_schwinger_pos_product_name);
     }
 #endif
+
+    // The particles created between two pushes of a species pushed every n steps
+    // would deposit a spurious current, as those injected continuously
+    const auto check_product = [this] (int i_product) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(allcontainers[i_product]->pushEveryNSteps() == 1,
+            species_names[i_product] + ".push_every_n_steps > 1 is not supported for "
+            "the product species of ionization or QED processes");
+    };
+    for (auto const& pc : allcontainers) {
+        if (pc->do_field_ionization) { check_product(pc->ionization_product); }
+#ifdef WARPX_QED
+        if (pc->has_breit_wheeler()) {
+            check_product(pc->m_qed_breit_wheeler_ele_product);
+            check_product(pc->m_qed_breit_wheeler_pos_product);
+        }
+        if (pc->has_quantum_sync()) { check_product(pc->m_qed_quantum_sync_phot_product); }
+#endif
+    }
+#ifdef WARPX_QED
+    if (m_do_qed_schwinger) {
+        check_product(m_qed_schwinger_ele_product);
+        check_product(m_qed_schwinger_pos_product);
+    }
+#endif
 }
 
 /* \brief Given a species name, return its ID.
@@ -874,6 +1157,14 @@ MultiParticleContainer::doFieldIonization (int lev,
 
     amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
 
+    // The timers of the load balancing costs need a synchronization for each tile
+    if (m_do_batched_field_ionization &&
+        !(cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers))
+    {
+        doFieldIonizationBatched(lev, Ex, Ey, Ez, Bx, By, Bz);
+        return;
+    }
+
     // Loop over all species.
     // Ionized particles in pc_source create particles in pc_product
     for (auto& pc_source : allcontainers)
@@ -915,7 +1206,7 @@ MultiParticleContainer::doFieldIonization (int lev,
             const auto num_added = filterCopyTransformParticles<1>(*pc_product, dst_tile, src_tile, np_dst,
                                                                    Filter, Copy, Transform);
 
-            setNewParticleIDs(dst_tile, np_dst, num_added);
+            setNewParticleIDs(dst_tile, np_dst, num_added, pc_product->AssignUniqueIDs());
 
             if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
             {
@@ -928,10 +1219,172 @@ MultiParticleContainer::doFieldIonization (int lev,
 }
 
 void
-MultiParticleContainer::doCollisions ( Real cur_time, amrex::Real dt )
+MultiParticleContainer::doFieldIonizationBatched (int lev,
+                                                  const MultiFab& Ex,
+                                                  const MultiFab& Ey,
+                                                  const MultiFab& Ez,
+                                                  const MultiFab& Bx,
+                                                  const MultiFab& By,
+                                                  const MultiFab& Bz)
+{
+    WARPX_PROFILE("MultiParticleContainer::doFieldIonizationBatched()");
+
+    // Ionization events of the particles of one tile of a source species
+    struct TileEvents {
+        int source;
+        std::pair<int, int> tile_key;
+        int np;
+        // mask and offsets have np+1 elements, so that offsets[np] is the number of events
+        amrex::Gpu::DeviceVector<int> mask;
+        amrex::Gpu::DeviceVector<int> offsets;
+        int num_events = 0;
+    };
+    std::vector<TileEvents> events;
+
+    // Phase 1: flag and count the ionization events of all the sources, without synchronization
+    for (int is = 0; is < nSpecies(); ++is)
+    {
+        auto& pc_source = allcontainers[is];
+        if (!pc_source->do_field_ionization){ continue; }
+
+        auto& pc_product = allcontainers[pc_source->ionization_product];
+        auto *phys_pc_ptr = static_cast<PhysicalParticleContainer*>(pc_source.get());
+
+        pc_source ->defineAllParticleTiles();
+        pc_product->defineAllParticleTiles();
+
+        auto info = getMFItInfo(*pc_source, *pc_product);
+        for (WarpXParIter pti(*pc_source, lev, info); pti.isValid(); ++pti)
+        {
+            auto& src_tile = pc_source->ParticlesAt(lev, pti);
+            const auto np = static_cast<int>(src_tile.numParticles());
+            if (np == 0) { continue; }
+
+            auto Filter = phys_pc_ptr->getIonizationFunc(pti, lev, Ex.nGrowVect(),
+                                                         Ex[pti], Ey[pti], Ez[pti],
+                                                         Bx[pti], By[pti], Bz[pti]);
+
+            auto& ev = events.emplace_back();
+            ev.source = is;
+            ev.tile_key = std::make_pair(pti.index(), pti.LocalTileIndex());
+            ev.np = np;
+            ev.mask.resize(np + 1);
+            ev.offsets.resize(np + 1);
+
+            auto *const p_mask = ev.mask.dataPtr();
+            const auto src_data = src_tile.getParticleTileData();
+            amrex::ParallelForRNG(np + 1,
+            [=] AMREX_GPU_DEVICE (int i, amrex::RandomEngine const& engine) noexcept
+            {
+                p_mask[i] = (i < np) ? static_cast<int>(Filter(src_data, i, engine)) : 0;
+            });
+            amrex::Scan::ExclusiveSum(np + 1, p_mask, ev.offsets.dataPtr(), amrex::Scan::noRetSum);
+        }
+    }
+    if (events.empty()) { return; }
+
+    // Copy the number of events of all the tiles to the host at once
+    const auto nevents = static_cast<int>(events.size());
+    {
+        amrex::Gpu::HostVector<int const*> h_totals_ptr(nevents);
+        for (int e = 0; e < nevents; ++e) {
+            h_totals_ptr[e] = events[e].offsets.dataPtr() + events[e].np;
+        }
+        amrex::Gpu::DeviceVector<int const*> d_totals_ptr(nevents);
+        amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, h_totals_ptr.begin(), h_totals_ptr.end(),
+                              d_totals_ptr.begin());
+        amrex::Gpu::DeviceVector<int> d_totals(nevents);
+        auto const* const p_totals_ptr = d_totals_ptr.dataPtr();
+        auto *const p_totals = d_totals.dataPtr();
+        amrex::ParallelFor(nevents, [=] AMREX_GPU_DEVICE (int e) noexcept
+        {
+            p_totals[e] = *p_totals_ptr[e];
+        });
+        amrex::Gpu::HostVector<int> h_totals(nevents);
+        amrex::Gpu::copyAsync(amrex::Gpu::deviceToHost, d_totals.begin(), d_totals.end(),
+                              h_totals.begin());
+        amrex::Gpu::streamSynchronize();
+        for (int e = 0; e < nevents; ++e) { events[e].num_events = h_totals[e]; }
+    }
+
+    // Phase 2: resize each tile of each product once, and create the products of all its sources
+    std::vector<std::unique_ptr<SmartCopyFactory>> copy_factories(nSpecies());
+    for (int ip = 0; ip < nSpecies(); ++ip)
+    {
+        std::map<std::pair<int, int>, std::vector<TileEvents const*>> tile_events;
+        for (auto const& ev : events) {
+            if (allcontainers[ev.source]->ionization_product == ip && ev.num_events > 0) {
+                tile_events[ev.tile_key].push_back(&ev);
+            }
+        }
+        if (tile_events.empty()) { continue; }
+
+        auto& pc_product = allcontainers[ip];
+        auto& product_level = pc_product->GetParticles(lev);
+        for (auto const& [tile_key, tile_evs] : tile_events)
+        {
+            auto& dst_tile = product_level[tile_key];
+            const auto np_dst = static_cast<int>(dst_tile.numParticles());
+            int num_added = 0;
+            for (auto const* ev : tile_evs) { num_added += ev->num_events; }
+            dst_tile.resize(np_dst + num_added);
+            const auto dst_data = dst_tile.getParticleTileData();
+
+            int dst_index = np_dst;
+            for (auto const* ev : tile_evs)
+            {
+                auto& pc_source = allcontainers[ev->source];
+                if (!copy_factories[ev->source]) {
+                    copy_factories[ev->source] = std::make_unique<SmartCopyFactory>(*pc_source, *pc_product);
+                }
+                auto Copy      = copy_factories[ev->source]->getSmartCopy();
+                auto Transform = IonizationTransformFunc();
+
+                auto& src_tile = pc_source->GetParticles(lev)[tile_key];
+                const auto src_data = src_tile.getParticleTileData();
+                auto const* const p_mask = ev->mask.dataPtr();
+                auto const* const p_offsets = ev->offsets.dataPtr();
+                const int index = dst_index;
+                amrex::ParallelForRNG(ev->np,
+                [=] AMREX_GPU_DEVICE (int i, amrex::RandomEngine const& engine) noexcept
+                {
+                    if (p_mask[i])
+                    {
+                        Copy(dst_data, src_data, i, p_offsets[i] + index, engine);
+                        Transform(dst_data, src_data, i, p_offsets[i] + index, engine);
+                    }
+                });
+                dst_index += ev->num_events;
+            }
+
+            ParticleCreation::DefaultInitializeRuntimeAttributes(dst_tile,
+                                       0, 0,
+                                       pc_product->getUserRealAttribs(), pc_product->getUserIntAttribs(),
+                                       pc_product->getParticleComps(), pc_product->getParticleiComps(),
+                                       pc_product->getUserRealAttribParser(),
+                                       pc_product->getUserIntAttribParser(),
+#ifdef WARPX_QED
+                                       false, // do not initialize QED quantities, since they were initialized
+                                              // when calling the CopyFunc functor
+                                       pc_product->get_breit_wheeler_engine_ptr(),
+                                       pc_product->get_quantum_sync_engine_ptr(),
+#endif
+                                       pc_product->getIonizationInitialLevel(),
+                                       np_dst, np_dst + num_added);
+
+            setNewParticleIDs(dst_tile, np_dst, num_added, pc_product->AssignUniqueIDs());
+        }
+    }
+
+    // The masks, offsets and copy factories are used by the kernels launched above
+    amrex::Gpu::synchronize();
+}
+
+void
+MultiParticleContainer::doCollisions ( Real cur_time, amrex::Real dt, int step )
 {
     WARPX_PROFILE("MultiParticleContainer::doCollisions()");
-    collisionhandler->doCollisions(cur_time, dt, this);
+    collisionhandler->doCollisions(cur_time, dt, step, this);
 }
 
 void MultiParticleContainer::doResampling (const int timestep, const bool verbose)
@@ -970,6 +1423,8 @@ void MultiParticleContainer::ScrapeParticlesAtEB (const amrex::Vector<const amre
 #ifdef WARPX_QED
 void MultiParticleContainer::InitQED ()
 {
+    const StartupTimer::Scope startup_timer("qed_tables");
+
     m_shr_p_qs_engine = std::make_shared<QuantumSynchrotronEngine>();
     m_shr_p_bw_engine = std::make_shared<BreitWheelerEngine>();
 
@@ -997,6 +1452,24 @@ void MultiParticleContainer::InitQED ()
         InitBreitWheeler();
     }
 
+    // Wait for the tables being generated and distribute them
+    for (auto const& finish : m_qed_tables_to_finish) {
+        finish();
+    }
+    m_qed_tables_to_finish.clear();
+
+    if(m_nspecies_quantum_sync != 0) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            m_shr_p_qs_engine->are_lookup_tables_initialized(),
+            "Table initialization has failed!");
+    }
+
+    if(m_nspecies_breit_wheeler !=0) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            m_shr_p_bw_engine->are_lookup_tables_initialized(),
+            "Table initialization has failed!");
+    }
+
 }
 
 void MultiParticleContainer::InitQuantumSync ()
@@ -1034,11 +1507,7 @@ void MultiParticleContainer::InitQuantumSync ()
         ablastr::warn_manager::WMRecordWarning("QED",
             "A new Quantum Synchrotron table will be generated.",
             ablastr::warn_manager::WarnPriority::low);
-#ifndef WARPX_QED_TABLE_GEN
-        WARPX_ABORT_WITH_MESSAGE("Error: Compile with QED_TABLE_GEN=TRUE to enable table generation!\n");
-#else
         QuantumSyncGenerateTable();
-#endif
     }
     else if(lookup_table_mode == "load"){
         std::string load_table_name;
@@ -1065,10 +1534,6 @@ void MultiParticleContainer::InitQuantumSync ()
     else{
         WARPX_ABORT_WITH_MESSAGE("Unknown Quantum Synchrotron table mode");
     }
-
-    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
-        m_shr_p_qs_engine->are_lookup_tables_initialized(),
-        "Table initialization has failed!");
 }
 
 void MultiParticleContainer::InitBreitWheeler ()
@@ -1093,11 +1558,7 @@ void MultiParticleContainer::InitBreitWheeler ()
         ablastr::warn_manager::WMRecordWarning("QED",
             "A new Breit Wheeler table will be generated.",
             ablastr::warn_manager::WarnPriority::low);
-#ifndef WARPX_QED_TABLE_GEN
-        amrex::Error("Error: Compile with QED_TABLE_GEN=TRUE to enable table generation!\n");
-#else
         BreitWheelerGenerateTable();
-#endif
     }
     else if(lookup_table_mode == "load"){
         std::string load_table_name;
@@ -1124,10 +1585,6 @@ void MultiParticleContainer::InitBreitWheeler ()
     else{
         WARPX_ABORT_WITH_MESSAGE("Unknown Breit Wheeler table mode");
     }
-
-    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
-        m_shr_p_bw_engine->are_lookup_tables_initialized(),
-        "Table initialization has failed!");
 }
 
 void
@@ -1136,9 +1593,11 @@ MultiParticleContainer::QuantumSyncGenerateTable ()
     const ParmParse pp_qed_qs("qed_qs");
     std::string table_name;
     pp_qed_qs.query("save_table_in", table_name);
+    std::string cache_dir;
+    pp_qed_qs.query("table_cache_dir", cache_dir);
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
-        !table_name.empty(),
-        "qed_qs.save_table_in should be provided!");
+        !table_name.empty() || !cache_dir.empty(),
+        "qed_qs.save_table_in (or qed_qs.table_cache_dir) should be provided!");
 
     // qs_minimum_chi_part is the minimum chi parameter to be
     // considered for Synchrotron emission. If a lepton has chi < chi_min,
@@ -1146,8 +1605,8 @@ MultiParticleContainer::QuantumSyncGenerateTable ()
     amrex::Real qs_minimum_chi_part;
     utils::parser::getWithParser(pp_qed_qs, "chi_min", qs_minimum_chi_part);
 
-    if(ParallelDescriptor::IOProcessor()){
-        PicsarQuantumSyncCtrl ctrl;
+    PicsarQuantumSyncCtrl ctrl;
+    {
 
         //==Table parameters==
 
@@ -1200,24 +1659,69 @@ MultiParticleContainer::QuantumSyncGenerateTable ()
         utils::parser::getWithParser(
             pp_qed_qs, "tab_em_frac_how_many", ctrl.phot_em_params.frac_how_many);
         //====================
+    }
+
+    // Look for a table generated with the same parameters in the cache
+    std::string cache_file;
+    if (!cache_dir.empty()) {
+        std::ostringstream table_params;
+        table_params << std::setprecision(17) << "sizeof_real " << sizeof(amrex::ParticleReal)
+            << " dndt " << ctrl.dndt_params.chi_part_min << " " << ctrl.dndt_params.chi_part_max
+            << " " << ctrl.dndt_params.chi_part_how_many
+            << " em " << ctrl.phot_em_params.chi_part_min << " " << ctrl.phot_em_params.chi_part_max
+            << " " << ctrl.phot_em_params.chi_part_how_many << " " << ctrl.phot_em_params.frac_min
+            << " " << ctrl.phot_em_params.frac_how_many;
+        cache_file = getQEDTableCacheFile(cache_dir, "qs", table_params.str());
 
-        m_shr_p_qs_engine->compute_lookup_tables(ctrl, qs_minimum_chi_part);
-        const auto data = m_shr_p_qs_engine->export_lookup_tables_data();
-        WarpXUtilIO::WriteBinaryDataOnFile(table_name,
-            Vector<char>{data.begin(), data.end()});
+        Vector<char> table_data;
+        if (loadQEDTableFromCache(cache_file, table_data)) {
+            ablastr::warn_manager::WMRecordWarning("QED",
+                "The Quantum Synchrotron table was found in the cache: " + cache_file,
+                ablastr::warn_manager::WarnPriority::low);
+            m_shr_p_qs_engine->init_lookup_tables_from_raw_data(
+                table_data, qs_minimum_chi_part);
+            return;
+        }
     }
 
-    ParallelDescriptor::Barrier();
-    Vector<char> table_data;
-    ParallelDescriptor::ReadAndBcastFile(table_name, table_data);
-    ParallelDescriptor::Barrier();
+#ifndef WARPX_QED_TABLE_GEN
+    WARPX_ABORT_WITH_MESSAGE("Error: Compile with QED_TABLE_GEN=TRUE to enable table generation!\n");
+#endif
 
-    //No need to initialize from raw data for the processor that
-    //has just generated the table
-    if(!ParallelDescriptor::IOProcessor()){
-        m_shr_p_qs_engine->init_lookup_tables_from_raw_data(
-            table_data, qs_minimum_chi_part);
+    // The table is computed on another host thread, so that it overlaps with
+    // the generation of the other QED table. This does not call MPI.
+    std::shared_future<void> generation;
+    if(ParallelDescriptor::IOProcessor()){
+        generation = std::async(std::launch::async,
+            [engine = m_shr_p_qs_engine, ctrl, qs_minimum_chi_part, table_name, cache_dir, cache_file] () {
+                engine->compute_lookup_tables(ctrl, qs_minimum_chi_part);
+                const auto data = engine->export_lookup_tables_data();
+                const Vector<char> raw_data{data.begin(), data.end()};
+                if (!table_name.empty()) {
+                    WarpXUtilIO::WriteBinaryDataOnFile(table_name, raw_data);
+                }
+                if (!cache_file.empty()) {
+                    saveQEDTableInCache(cache_dir, cache_file, raw_data);
+                }
+            }).share();
     }
+
+    m_qed_tables_to_finish.emplace_back(
+        [engine = m_shr_p_qs_engine, qs_minimum_chi_part, table_name, cache_file, generation] () {
+            if (generation.valid()) { generation.get(); }
+
+            ParallelDescriptor::Barrier();
+            Vector<char> table_data;
+            ParallelDescriptor::ReadAndBcastFile(table_name.empty() ? cache_file : table_name, table_data);
+            ParallelDescriptor::Barrier();
+
+            //No need to initialize from raw data for the processor that
+            //has just generated the table
+            if(!ParallelDescriptor::IOProcessor()){
+                engine->init_lookup_tables_from_raw_data(
+                    table_data, qs_minimum_chi_part);
+            }
+        });
 }
 
 void
@@ -1226,9 +1730,11 @@ MultiParticleContainer::BreitWheelerGenerateTable ()
     const ParmParse pp_qed_bw("qed_bw");
     std::string table_name;
     pp_qed_bw.query("save_table_in", table_name);
+    std::string cache_dir;
+    pp_qed_bw.query("table_cache_dir", cache_dir);
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
-        !table_name.empty(),
-        "qed_bw.save_table_in should be provided!");
+        !table_name.empty() || !cache_dir.empty(),
+        "qed_bw.save_table_in (or qed_bw.table_cache_dir) should be provided!");
 
     // bw_minimum_chi_phot is the minimum chi parameter to be
     // considered for pair production. If a photon has chi < chi_min,
@@ -1236,8 +1742,8 @@ MultiParticleContainer::BreitWheelerGenerateTable ()
     amrex::Real bw_minimum_chi_part;
     utils::parser::getWithParser(pp_qed_bw, "chi_min", bw_minimum_chi_part);
 
-    if(ParallelDescriptor::IOProcessor()){
-        PicsarBreitWheelerCtrl ctrl;
+    PicsarBreitWheelerCtrl ctrl;
+    {
 
         //==Table parameters==
 
@@ -1285,24 +1791,69 @@ MultiParticleContainer::BreitWheelerGenerateTable ()
         utils::parser::getWithParser(
             pp_qed_bw, "tab_pair_frac_how_many", ctrl.pair_prod_params.frac_how_many);
         //====================
+    }
+
+    // Look for a table generated with the same parameters in the cache
+    std::string cache_file;
+    if (!cache_dir.empty()) {
+        std::ostringstream table_params;
+        table_params << std::setprecision(17) << "sizeof_real " << sizeof(amrex::ParticleReal)
+            << " dndt " << ctrl.dndt_params.chi_phot_min << " " << ctrl.dndt_params.chi_phot_max
+            << " " << ctrl.dndt_params.chi_phot_how_many
+            << " pair " << ctrl.pair_prod_params.chi_phot_min << " " << ctrl.pair_prod_params.chi_phot_max
+            << " " << ctrl.pair_prod_params.chi_phot_how_many
+            << " " << ctrl.pair_prod_params.frac_how_many;
+        cache_file = getQEDTableCacheFile(cache_dir, "bw", table_params.str());
 
-        m_shr_p_bw_engine->compute_lookup_tables(ctrl, bw_minimum_chi_part);
-        const auto data = m_shr_p_bw_engine->export_lookup_tables_data();
-        WarpXUtilIO::WriteBinaryDataOnFile(table_name,
-            Vector<char>{data.begin(), data.end()});
+        Vector<char> table_data;
+        if (loadQEDTableFromCache(cache_file, table_data)) {
+            ablastr::warn_manager::WMRecordWarning("QED",
+                "The Breit Wheeler table was found in the cache: " + cache_file,
+                ablastr::warn_manager::WarnPriority::low);
+            m_shr_p_bw_engine->init_lookup_tables_from_raw_data(
+                table_data, bw_minimum_chi_part);
+            return;
+        }
     }
 
-    ParallelDescriptor::Barrier();
-    Vector<char> table_data;
-    ParallelDescriptor::ReadAndBcastFile(table_name, table_data);
-    ParallelDescriptor::Barrier();
+#ifndef WARPX_QED_TABLE_GEN
+    WARPX_ABORT_WITH_MESSAGE("Error: Compile with QED_TABLE_GEN=TRUE to enable table generation!\n");
+#endif
 
-    //No need to initialize from raw data for the processor that
-    //has just generated the table
-    if(!ParallelDescriptor::IOProcessor()){
-        m_shr_p_bw_engine->init_lookup_tables_from_raw_data(
-            table_data, bw_minimum_chi_part);
+    // The table is computed on another host thread, so that it overlaps with
+    // the generation of the other QED table. This does not call MPI.
+    std::shared_future<void> generation;
+    if(ParallelDescriptor::IOProcessor()){
+        generation = std::async(std::launch::async,
+            [engine = m_shr_p_bw_engine, ctrl, bw_minimum_chi_part, table_name, cache_dir, cache_file] () {
+                engine->compute_lookup_tables(ctrl, bw_minimum_chi_part);
+                const auto data = engine->export_lookup_tables_data();
+                const Vector<char> raw_data{data.begin(), data.end()};
+                if (!table_name.empty()) {
+                    WarpXUtilIO::WriteBinaryDataOnFile(table_name, raw_data);
+                }
+                if (!cache_file.empty()) {
+                    saveQEDTableInCache(cache_dir, cache_file, raw_data);
+                }
+            }).share();
     }
+
+    m_qed_tables_to_finish.emplace_back(
+        [engine = m_shr_p_bw_engine, bw_minimum_chi_part, table_name, cache_file, generation] () {
+            if (generation.valid()) { generation.get(); }
+
+            ParallelDescriptor::Barrier();
+            Vector<char> table_data;
+            ParallelDescriptor::ReadAndBcastFile(table_name.empty() ? cache_file : table_name, table_data);
+            ParallelDescriptor::Barrier();
+
+            //No need to initialize from raw data for the processor that
+            //has just generated the table
+            if(!ParallelDescriptor::IOProcessor()){
+                engine->init_lookup_tables_from_raw_data(
+                    table_data, bw_minimum_chi_part);
+            }
+        });
 }
 
 void
@@ -1362,6 +1913,8 @@ MultiParticleContainer::doQEDSchwinger ()
     const MultiFab & By = warpx.getField(FieldType::Bfield_aux, level_0,1);
     const MultiFab & Bz = warpx.getField(FieldType::Bfield_aux, level_0,2);
 
+    const amrex::Real cull_threshold = m_qed_schwinger_tile_cull_threshold;
+
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
@@ -1382,6 +1935,24 @@ MultiParticleContainer::doQEDSchwinger ()
             Ex[mfi].array(), Ey[mfi].array(), Ez[mfi].array(),
             Bx[mfi].array(), By[mfi].array(), Bz[mfi].array()};
 
+        // The pair production rate is negligible in most of the domain: skip the tiles
+        // in which even the maximum |E| of the tile would create less than
+        // tile_cull_threshold pairs in all its cells
+        if (cull_threshold > 0._rt) {
+            auto const& arrEx = fieldsEB.Ex;
+            auto const& arrEy = fieldsEB.Ey;
+            auto const& arrEz = fieldsEB.Ez;
+            const amrex::Real E2_max = amrex::Reduce::Max<amrex::Real>(box,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept -> amrex::Real
+                {
+                    return arrEx(i,j,k)*arrEx(i,j,k) + arrEy(i,j,k)*arrEy(i,j,k)
+                        + arrEz(i,j,k)*arrEz(i,j,k);
+                });
+            const amrex::Real max_pairs = static_cast<amrex::Real>(box.numPts()) *
+                getSchwingerMaxExpectedPairNumber(dV, dt, std::sqrt(E2_max));
+            if (max_pairs < cull_threshold) { continue; }
+        }
+
         auto& dst_ele_tile = pc_product_ele->ParticlesAt(level_0, mfi);
         auto& dst_pos_tile = pc_product_pos->ParticlesAt(level_0, mfi);
 
@@ -1406,8 +1977,8 @@ MultiParticleContainer::doQEDSchwinger ()
                                np_pos_dst,Filter, CreateEle, CreatePos,
                                Transform, geom_level_zero);
 
-        setNewParticleIDs(dst_ele_tile, np_ele_dst, num_added);
-        setNewParticleIDs(dst_pos_tile, np_pos_dst, num_added);
+        setNewParticleIDs(dst_ele_tile, np_ele_dst, num_added, pc_product_ele->AssignUniqueIDs());
+        setNewParticleIDs(dst_pos_tile, np_pos_dst, num_added, pc_product_pos->AssignUniqueIDs());
 
     }
 }
@@ -1475,6 +2046,63 @@ MultiParticleContainer::ComputeSchwingerGlobalBox () const
     return schwinger_global_box;
 }
 
+namespace
+{
+    using TileCounts = std::map<std::pair<int,int>, amrex::Long>;
+
+    /** \brief Add to counts, for each tile, the number of particles of pc_source
+     *  that pass filter, i.e. the number of QED events in the tile.
+     */
+    template <typename FilterFunc>
+    void countQedEvents (WarpXParticleContainer& pc_source, int lev,
+                         FilterFunc const& filter, TileCounts& counts)
+    {
+        for (WarpXParIter pti(pc_source, lev); pti.isValid(); ++pti)
+        {
+            const auto np = pti.numParticles();
+            if (np == 0) { continue; }
+            const auto src_data = pc_source.ParticlesAt(lev, pti).getParticleTileData();
+
+            amrex::Gpu::DeviceVector<int> mask(np);
+            int* const p_mask = mask.dataPtr();
+            amrex::ParallelForRNG(np,
+                [=] AMREX_GPU_DEVICE (int i, amrex::RandomEngine const& engine) noexcept
+                {
+                    p_mask[i] = filter(src_data, i, engine) ? 1 : 0;
+                });
+            counts[std::make_pair(pti.index(), pti.LocalTileIndex())] +=
+                amrex::Reduce::Sum<amrex::Long>(np,
+                    [=] AMREX_GPU_DEVICE (int i) noexcept -> amrex::Long { return p_mask[i]; });
+        }
+    }
+
+    /** \brief Grow the capacity of the tiles of pc_product so that they can hold
+     *  the given numbers of new particles, without changing their sizes. The products
+     *  of the source species are then appended without reallocating the tiles.
+     */
+    void reserveQedProducts (WarpXParticleContainer& pc_product, int lev, TileCounts const& counts)
+    {
+        pc_product.defineAllParticleTiles();
+        auto& particles = pc_product.GetParticles(lev);
+        for (auto const& [key, count] : counts) {
+            if (count == 0) { continue; }
+            auto& tile = particles[key];
+            const auto np = tile.numParticles();
+            tile.resize(np + count);
+            tile.resize(np);
+        }
+    }
+
+    /** \brief The number of source species that feed each product species.
+     */
+    std::map<int, int> countSourcesPerProduct (std::vector<int> const& products)
+    {
+        std::map<int, int> n_sources;
+        for (auto const i : products) { ++n_sources[i]; }
+        return n_sources;
+    }
+}
+
 void MultiParticleContainer::doQedEvents (int lev,
                                           const MultiFab& Ex,
                                           const MultiFab& Ey,
@@ -1501,6 +2129,37 @@ void MultiParticleContainer::doQedBreitWheeler (int lev,
 
     amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
 
+    // When several species create pairs in the same product species, the capacity
+    // of the product tiles is grown once for all of them, so that each species
+    // does not reallocate (and copy) the product tiles again
+    {
+        std::vector<int> products;
+        for (auto& pc_source : allcontainers){
+            if(!pc_source->has_breit_wheeler()) { continue; }
+            products.push_back(pc_source->m_qed_breit_wheeler_ele_product);
+            products.push_back(pc_source->m_qed_breit_wheeler_pos_product);
+        }
+        const auto n_sources = countSourcesPerProduct(products);
+        std::map<int, TileCounts> product_counts;
+        for (auto& pc_source : allcontainers){
+            if(!pc_source->has_breit_wheeler()) { continue; }
+            const int i_ele = pc_source->m_qed_breit_wheeler_ele_product;
+            const int i_pos = pc_source->m_qed_breit_wheeler_pos_product;
+            if (n_sources.at(i_ele) < 2 && n_sources.at(i_pos) < 2) { continue; }
+            auto *phys_pc_ptr = static_cast<PhysicalParticleContainer*>(pc_source.get());
+            pc_source->defineAllParticleTiles();
+            TileCounts counts;
+            countQedEvents(*pc_source, lev, phys_pc_ptr->getPairGenerationFilterFunc(), counts);
+            for (auto const i_product : {i_ele, i_pos}) {
+                if (n_sources.at(i_product) < 2) { continue; }
+                for (auto const& [key, count] : counts) { product_counts[i_product][key] += count; }
+            }
+        }
+        for (auto const& [i_product, counts] : product_counts) {
+            reserveQedProducts(*allcontainers[i_product], lev, counts);
+        }
+    }
+
     // Loop over all species.
     // Photons undergoing Breit Wheeler process create electrons
     // in pc_product_ele and positrons in pc_product_pos
@@ -1559,8 +2218,8 @@ void MultiParticleContainer::doQedBreitWheeler (int lev,
                                                       src_tile, np_dst_ele, np_dst_pos,
                                                       Filter, CopyEle, CopyPos, Transform);
 
-            setNewParticleIDs(dst_ele_tile, np_dst_ele, num_added);
-            setNewParticleIDs(dst_pos_tile, np_dst_pos, num_added);
+            setNewParticleIDs(dst_ele_tile, np_dst_ele, num_added, pc_product_ele->AssignUniqueIDs());
+            setNewParticleIDs(dst_pos_tile, np_dst_pos, num_added, pc_product_pos->AssignUniqueIDs());
 
             if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
             {
@@ -1584,6 +2243,30 @@ void MultiParticleContainer::doQedQuantumSync (int lev,
 
     amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
 
+    // When several species emit photons in the same product species (e.g. electrons
+    // and positrons), the capacity of the photon tiles is grown once for all of them
+    {
+        std::vector<int> products;
+        for (auto& pc_source : allcontainers){
+            if(!pc_source->has_quantum_sync()){ continue; }
+            products.push_back(pc_source->m_qed_quantum_sync_phot_product);
+        }
+        const auto n_sources = countSourcesPerProduct(products);
+        std::map<int, TileCounts> product_counts;
+        for (auto& pc_source : allcontainers){
+            if(!pc_source->has_quantum_sync()){ continue; }
+            const int i_phot = pc_source->m_qed_quantum_sync_phot_product;
+            if (n_sources.at(i_phot) < 2) { continue; }
+            auto *phys_pc_ptr = static_cast<PhysicalParticleContainer*>(pc_source.get());
+            pc_source->defineAllParticleTiles();
+            countQedEvents(*pc_source, lev, phys_pc_ptr->getPhotonEmissionFilterFunc(),
+                           product_counts[i_phot]);
+        }
+        for (auto const& [i_product, counts] : product_counts) {
+            reserveQedProducts(*allcontainers[i_product], lev, counts);
+        }
+    }
+
     // Loop over all species.
     // Electrons or positrons undergoing Quantum photon emission process
     // create photons in pc_product_phot
@@ -1637,7 +2320,7 @@ void MultiParticleContainer::doQedQuantumSync (int lev,
                 filterCopyTransformParticles<1>(*pc_product_phot, dst_tile, src_tile, np_dst,
                                                 Filter, CopyPhot, Transform);
 
-            setNewParticleIDs(dst_tile, np_dst, num_added);
+            setNewParticleIDs(dst_tile, np_dst, num_added, pc_product_phot->AssignUniqueIDs());
 
             cleanLowEnergyPhotons(
                                   dst_tile, np_dst, num_added,
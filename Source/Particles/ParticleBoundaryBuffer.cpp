@@ -429,10 +429,15 @@ void ParticleBoundaryBuffer::gatherParticlesFromDomainBoundaries (MultiParticleC
                                          { return predicate(ptile_data, ip, rng) ? 1 : 0; });
                         }
 
+                        // Most tiles have no particle crossing the boundary: skip
+                        // the second pass over the particles done by filterAndTransform
+                        const int n_scraped = amrex::get<0>(reduce_data.value());
+                        if (n_scraped == 0) { continue; }
+
                         auto dst_index = ptile_buffer.numParticles();
                         {
                           WARPX_PROFILE("ParticleBoundaryBuffer::gatherParticles::resize");
-                          ptile_buffer.resize(dst_index + amrex::get<0>(reduce_data.value()));
+                          ptile_buffer.resize(dst_index + n_scraped);
                         }
                         {
                           WARPX_PROFILE("ParticleBoundaryBuffer::gatherParticles::filterAndTransform");
@@ -510,6 +515,9 @@ void ParticleBoundaryBuffer::gatherParticlesFromEmbeddedBoundaries (
                 const auto& ptile = plevel.at(index);
                 auto np = ptile.numParticles();
                 if (np == 0) { continue; }
+                // No particle of this tile can be inside the EB if the signed distance
+                // is positive everywhere in the box (see scrapeParticlesAtEB)
+                if ((*distance_to_eb[lev])[pti].min<amrex::RunOn::Device>(0) > 0.0_rt) { continue; }
 
                 using SrcData = WarpXParticleContainer::ParticleTileType::ConstParticleTileDataType;
                 auto predicate = [=] AMREX_GPU_HOST_DEVICE (const SrcData& /*src*/, const int ip)
@@ -534,10 +542,15 @@ void ParticleBoundaryBuffer::gatherParticlesFromEmbeddedBoundaries (
                                  { return predicate(ptile_data, ip) ? 1 : 0; });
                 }
 
+                // Most tiles have no particle crossing the embedded boundary: skip
+                // the second pass over the particles done by filterAndTransform
+                const int n_scraped = amrex::get<0>(reduce_data.value());
+                if (n_scraped == 0) { continue; }
+
                 auto dst_index = ptile_buffer.numParticles();
                 {
                   WARPX_PROFILE("ParticleBoundaryBuffer::gatherParticles::resize_eb");
-                  ptile_buffer.resize(dst_index + amrex::get<0>(reduce_data.value()));
+                  ptile_buffer.resize(dst_index + n_scraped);
                 }
                 auto& warpx = WarpX::GetInstance();
                 const auto dt = warpx.getdt(pti.GetLevel());
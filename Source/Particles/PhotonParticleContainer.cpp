@@ -17,6 +17,7 @@
 #include "Particles/Pusher/GetAndSetPosition.H"
 #include "Particles/Pusher/UpdatePositionPhoton.H"
 #include "Particles/WarpXParticleContainer.H"
+#include "Utils/Parser/ParserUtils.H"
 #include "Utils/TextMsg.H"
 #include "WarpX.H"
 
@@ -58,6 +59,10 @@ PhotonParticleContainer::PhotonParticleContainer (AmrCore* amr_core, int ispecie
         if(m_do_qed_breit_wheeler){
             pp_species_name.get("qed_breit_wheeler_ele_product_species", m_qed_breit_wheeler_ele_product_name);
             pp_species_name.get("qed_breit_wheeler_pos_product_species", m_qed_breit_wheeler_pos_product_name);
+            utils::parser::queryWithParser(pp_species_name, "qed_breit_wheeler_evolve_every_n_steps",
+                m_qed_breit_wheeler_evolve_every_n_steps);
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_qed_breit_wheeler_evolve_every_n_steps >= 1,
+                species_name + ".qed_breit_wheeler_evolve_every_n_steps must be at least 1");
         }
 
         //Check for processes which do not make sense for photons
@@ -93,6 +98,40 @@ PhotonParticleContainer::PushPX (WarpXParIter& pti,
                                  int lev, int gather_lev,
                                  amrex::Real dt, ScaleFields /*scaleFields*/, DtType a_dt_type)
 {
+    auto copyAttribs = CopyParticleAttribs(pti, tmp_particle_data, offset);
+    const int do_copy = (m_do_back_transformed_particles && (a_dt_type!=DtType::SecondHalf) );
+
+    const auto GetPosition = GetParticlePosition<PIdx>(pti, offset);
+    auto SetPosition = SetParticlePosition<PIdx>(pti, offset);
+
+    // The fields are only used to evolve the Breit-Wheeler optical depth, which is done
+    // every m_qed_breit_wheeler_evolve_every_n_steps steps with the corresponding time step.
+    // Otherwise, the photons only move along straight lines.
+#ifdef WARPX_QED
+    const int bw_every_n_steps = m_qed_breit_wheeler_evolve_every_n_steps;
+    const bool evolve_bw_this_step = has_breit_wheeler() &&
+        (WarpX::GetInstance().getistep(lev) % bw_every_n_steps == 0);
+#else
+    const bool evolve_bw_this_step = false;
+#endif
+    if (!evolve_bw_this_step)
+    {
+        auto& attribs = pti.GetAttribs();
+        ParticleReal const* const AMREX_RESTRICT ux = attribs[PIdx::ux].dataPtr() + offset;
+        ParticleReal const* const AMREX_RESTRICT uy = attribs[PIdx::uy].dataPtr() + offset;
+        ParticleReal const* const AMREX_RESTRICT uz = attribs[PIdx::uz].dataPtr() + offset;
+
+        amrex::ParallelFor(np_to_push, [=] AMREX_GPU_DEVICE (long i)
+        {
+            if (do_copy) { copyAttribs(i); }
+            ParticleReal x, y, z;
+            GetPosition(i, x, y, z);
+            UpdatePositionPhoton( x, y, z, ux[i], uy[i], uz[i], dt );
+            SetPosition(i, x, y, z);
+        });
+        return;
+    }
+
     // Get inverse cell size on gather_lev
     const amrex::XDim3 dinv = WarpX::InvCellSize(std::max(gather_lev,0));
 
@@ -126,12 +165,6 @@ PhotonParticleContainer::PushPX (WarpXParIter& pti,
     }
 #endif
 
-    auto copyAttribs = CopyParticleAttribs(pti, tmp_particle_data, offset);
-    const int do_copy = (m_do_back_transformed_particles && (a_dt_type!=DtType::SecondHalf) );
-
-    const auto GetPosition = GetParticlePosition<PIdx>(pti, offset);
-    auto SetPosition = SetParticlePosition<PIdx>(pti, offset);
-
     const auto getExternalEB = GetExternalEBField(pti, offset);
 
     const amrex::ParticleReal Ex_external_particle = m_E_external_particle[0];
@@ -214,9 +247,10 @@ PhotonParticleContainer::PushPX (WarpXParIter& pti,
             [[maybe_unused]] auto *uy_tmp = uy;
             [[maybe_unused]] auto *uz_tmp = uz;
             [[maybe_unused]] auto dt_tmp = dt;
+            [[maybe_unused]] auto bw_every_n_steps_tmp = bw_every_n_steps;
             if constexpr (qed_control == has_qed) {
                 evolve_opt(ux[i], uy[i], uz[i], Exp, Eyp, Ezp, Bxp, Byp, Bzp,
-                           dt, p_optical_depth_BW[i]);
+                           dt*static_cast<amrex::Real>(bw_every_n_steps), p_optical_depth_BW[i]);
             }
 #else
             amrex::ignore_unused(qed_control);
@@ -11,6 +11,7 @@
 #include "PhysicalParticleContainer.H"
 
 #include "Filter/NCIGodfreyFilter.H"
+#include "Initialization/InjectionRandomEngine.H"
 #include "Initialization/InjectorDensity.H"
 #include "Initialization/InjectorMomentum.H"
 #include "Initialization/InjectorPosition.H"
@@ -19,9 +20,12 @@
 #   include "Particles/ElementaryProcess/QEDInternals/BreitWheelerEngineWrapper.H"
 #   include "Particles/ElementaryProcess/QEDInternals/QuantumSyncEngineWrapper.H"
 #endif
+#include "Particles/Deposition/CurrentDeposition.H"
 #include "Particles/Gather/FieldGather.H"
+#include "Particles/Gather/FieldGatherSimd.H"
 #include "Particles/Gather/GetExternalFields.H"
 #include "Particles/ParticleCreation/DefaultInitialization.H"
+#include "Particles/ParticleCreation/SmartUtils.H"
 #include "Particles/Pusher/CopyParticleAttribs.H"
 #include "Particles/Pusher/GetAndSetPosition.H"
 #include "Particles/Pusher/PushSelector.H"
@@ -34,6 +38,7 @@
 #include "Particles/WarpXParticleContainer.H"
 #include "Utils/Parser/ParserUtils.H"
 #include "Utils/ParticleUtils.H"
+#include "Utils/KernelCounters.H"
 #include "Utils/Physics/IonizationEnergiesTable.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
@@ -103,6 +108,7 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <limits>
 #include <map>
@@ -135,6 +141,10 @@ namespace
     Real applyBallisticCorrection(const XDim3& pos, const InjectorMomentum* inj_mom,
                                   Real gamma_boost, Real beta_boost, Real t) noexcept
     {
+        // In the lab frame, the correction vanishes at t=0: skip the evaluation
+        // of the bulk momentum, which is costly when it is given by a parser
+        if (gamma_boost == 1._rt && t == 0._rt) { return pos.z; }
+
         const XDim3 u_bulk = inj_mom->getBulkMomentum(pos.x, pos.y, pos.z);
         const Real gamma_bulk = std::sqrt(1._rt +
                   (u_bulk.x*u_bulk.x+u_bulk.y*u_bulk.y+u_bulk.z*u_bulk.z));
@@ -243,6 +253,229 @@ namespace
 
         idcpu[ip] = amrex::ParticleIdCpus::Invalid;
     }
+
+    /**
+     * \brief Key of the counter-based random numbers of an injection, see
+     * utils::random::InjectionRandomEngine. It combines the seed, the species,
+     * the injection source, the level and the step, none of which depends on
+     * the domain decomposition.
+     *
+     * \param plasma_injector the injection source
+     * \param species_id index of the species
+     * \param lev mesh refinement level of the injection
+     */
+    std::uint64_t getInjectionRandomKey (PlasmaInjector const& plasma_injector,
+                                         int species_id, int lev)
+    {
+        using namespace utils::random;
+        std::uint64_t key = mix64(WarpX::injection_random_seed);
+        key = combine(key, static_cast<std::uint64_t>(species_id));
+        key = combine(key, hashString(plasma_injector.getSourceName()));
+        key = combine(key, static_cast<std::uint64_t>(lev));
+        return combine(key, static_cast<std::uint64_t>(WarpX::GetInstance().getistep(lev)));
+    }
+
+    /**
+     * \brief Map a particle from the lab frame to the boosted frame, and move it
+     * to where it is at the time t0 of the boosted frame, assuming ballistic motion.
+     *
+     * \param x, y, z position of the particle, at the time t_lab of the lab frame
+     * \param ux, uy, uz momentum of the particle in the lab frame
+     * \param t_lab time of the particle in the lab frame
+     * \param t0 current time of the simulation, in the boosted frame
+     * \param do_backward_propagation whether the sign of uz is flipped
+     * \param adjust_transverse_positions whether the transverse positions are also moved
+     */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    void mapToBoostedFrame (ParticleReal& x, ParticleReal& y, ParticleReal& z,
+                            ParticleReal& ux, ParticleReal uy, ParticleReal& uz,
+                            Real t_lab, Real t0, Real gamma_boost, Real beta_boost,
+                            bool do_backward_propagation,
+                            bool adjust_transverse_positions) noexcept
+    {
+        const ParticleReal uz_boost = gamma_boost*beta_boost*PhysConst::c;
+
+        // tpr is the particle's time in the boosted frame
+        const ParticleReal tpr = gamma_boost*t_lab - uz_boost*z/(PhysConst::c*PhysConst::c);
+
+        // The particle's transformed location in the boosted frame
+        const ParticleReal xpr = x;
+        const ParticleReal ypr = y;
+        const ParticleReal zpr = gamma_boost*z - uz_boost*t_lab;
+
+        // transform u and gamma to the boosted frame
+        const ParticleReal gamma_lab = std::sqrt(1._rt + (ux*ux + uy*uy + uz*uz)/(PhysConst::c*PhysConst::c));
+        // ux = ux;
+        // uy = uy;
+        uz = gamma_boost*uz - uz_boost*gamma_lab;
+        const ParticleReal gammapr = std::sqrt(1._rt + (ux*ux + uy*uy + uz*uz)/(PhysConst::c*PhysConst::c));
+
+        const ParticleReal vxpr = ux/gammapr;
+        const ParticleReal vypr = uy/gammapr;
+        const ParticleReal vzpr = uz/gammapr;
+
+        if (do_backward_propagation){
+            uz = -uz;
+        }
+
+        //Move the particles to where they will be at t = t0, the current simulation time in the boosted frame
+        if (adjust_transverse_positions) {
+            x = xpr - (tpr-t0)*vxpr;
+            y = ypr - (tpr-t0)*vypr;
+        }
+        z = zpr - (tpr-t0)*vzpr;
+    }
+
+    /**
+     * \brief Gather of E and B at the position of a particle, shared by the kernels of
+     * PushPX and PushPXAndDepositCurrent
+     */
+    struct PushFieldGather
+    {
+        amrex::Array4<const amrex::Real> ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr;
+        amrex::IndexType ex_type, ey_type, ez_type, bx_type, by_type, bz_type;
+        amrex::XDim3 dinv;
+        amrex::XDim3 xyzmin;
+        amrex::Dim3 lo;
+        int nox;
+        int n_rz_azimuthal_modes;
+        bool galerkin_interpolation;
+        bool do_not_gather;
+        //! Uniform external fields, to which the gathered fields are added
+        amrex::GpuArray<amrex::ParticleReal,6> external_fields;
+        //! Fields already gathered for blocks of particles (see gatherSimd), or nullptr
+        amrex::ParticleReal const* gathered_fields = nullptr;
+        long np_gathered = 0;
+        //! Godfrey filter along z folded into the shape factors (fused NCI corrector), or nullptr
+        amrex::Real const* nci_stencil_exeybz = nullptr;
+        amrex::Real const* nci_stencil_bxbyez = nullptr;
+
+        PushFieldGather (amrex::FArrayBox const * exfab, amrex::FArrayBox const * eyfab,
+                         amrex::FArrayBox const * ezfab, amrex::FArrayBox const * bxfab,
+                         amrex::FArrayBox const * byfab, amrex::FArrayBox const * bzfab,
+                         const Box& box, int gather_lev,
+                         const amrex::Vector<amrex::ParticleReal>& E_external,
+                         const amrex::Vector<amrex::ParticleReal>& B_external,
+                         bool a_do_not_gather)
+            : ex_arr{exfab->array()}, ey_arr{eyfab->array()}, ez_arr{ezfab->array()},
+              bx_arr{bxfab->array()}, by_arr{byfab->array()}, bz_arr{bzfab->array()},
+              ex_type{exfab->box().ixType()}, ey_type{eyfab->box().ixType()},
+              ez_type{ezfab->box().ixType()}, bx_type{bxfab->box().ixType()},
+              by_type{byfab->box().ixType()}, bz_type{bzfab->box().ixType()},
+              dinv{WarpX::InvCellSize(std::max(gather_lev,0))},
+              // Lower corner of tile box physical domain (take into account Galilean shift)
+              xyzmin{WarpX::LowerCorner(box, gather_lev, 0._rt)},
+              lo{lbound(box)},
+              nox{WarpX::nox},
+              n_rz_azimuthal_modes{WarpX::n_rz_azimuthal_modes},
+              galerkin_interpolation{WarpX::galerkin_interpolation},
+              do_not_gather{a_do_not_gather},
+              external_fields{E_external[0], E_external[1], E_external[2],
+                              B_external[0], B_external[1], B_external[2]}
+        {}
+
+        /**
+         * \brief On CPU, gather the fields for blocks of particles at once before the push,
+         * so that the gather is vectorized (see doGatherShapeNSimd)
+         *
+         * \param[in] getPosition  positions of the particles
+         * \param[in] np           number of particles
+         * \param[out] buffer      fields on the particles, which must outlive the kernel
+         */
+        void gatherSimd ([[maybe_unused]] const GetParticlePosition<PIdx>& getPosition,
+                         [[maybe_unused]] long np,
+                         [[maybe_unused]] amrex::Vector<amrex::ParticleReal>& buffer)
+        {
+#if !defined(AMREX_USE_GPU) && !defined(WARPX_DIM_RZ)
+            if (!WarpX::do_simd_field_gather || do_not_gather || nci_stencil_exeybz) { return; }
+            buffer.resize(6*np);
+            amrex::ParticleReal* const fields = buffer.dataPtr();
+            for (int comp = 0; comp < 6; ++comp) {
+                std::fill_n(fields + comp*np, np, external_fields[comp]);
+            }
+            doGatherShapeNSimd(getPosition, np,
+                               fields, fields + np, fields + 2*np,
+                               fields + 3*np, fields + 4*np, fields + 5*np,
+                               ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
+                               ex_type, ey_type, ez_type, bx_type, by_type, bz_type,
+                               dinv, xyzmin, lo, nox, galerkin_interpolation);
+            gathered_fields = fields;
+            np_gathered = np;
+#endif
+        }
+
+        AMREX_GPU_DEVICE AMREX_FORCE_INLINE
+        void operator() (long ip,
+                         amrex::ParticleReal xp, amrex::ParticleReal yp, amrex::ParticleReal zp,
+                         amrex::ParticleReal& Exp, amrex::ParticleReal& Eyp, amrex::ParticleReal& Ezp,
+                         amrex::ParticleReal& Bxp, amrex::ParticleReal& Byp, amrex::ParticleReal& Bzp) const
+        {
+            if (gathered_fields) {
+                // the fields were already gathered for blocks of particles
+                Exp = gathered_fields[ip];
+                Eyp = gathered_fields[ip + np_gathered];
+                Ezp = gathered_fields[ip + 2*np_gathered];
+                Bxp = gathered_fields[ip + 3*np_gathered];
+                Byp = gathered_fields[ip + 4*np_gathered];
+                Bzp = gathered_fields[ip + 5*np_gathered];
+                return;
+            }
+
+            Exp = external_fields[0];
+            Eyp = external_fields[1];
+            Ezp = external_fields[2];
+            Bxp = external_fields[3];
+            Byp = external_fields[4];
+            Bzp = external_fields[5];
+
+            if (do_not_gather) { return; }
+
+#if defined(WARPX_DIM_3D) || defined(WARPX_DIM_XZ)
+            if (nci_stencil_exeybz) {
+                doGatherShapeNFilteredZ<NCIGodfreyFilter::m_stencil_width>(
+                    xp, yp, zp, Exp, Eyp, Ezp, Bxp, Byp, Bzp,
+                    ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
+                    ex_type, ey_type, ez_type, bx_type, by_type, bz_type,
+                    dinv, xyzmin, lo, nci_stencil_exeybz, nci_stencil_bxbyez,
+                    nox, galerkin_interpolation);
+                return;
+            }
+#endif
+            doGatherShapeN(xp, yp, zp, Exp, Eyp, Ezp, Bxp, Byp, Bzp,
+                           ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
+                           ex_type, ey_type, ez_type, bx_type, by_type, bz_type,
+                           dinv, xyzmin, lo, n_rz_azimuthal_modes,
+                           nox, galerkin_interpolation);
+        }
+    };
+
+    /**
+     * \brief Push of the momentum and position of a particle, shared by the kernels of
+     * PushPX and PushPXAndDepositCurrent
+     *
+     * \tparam do_sync   Whether to include quantum synchrotron radiation (QSR)
+     * \tparam pusher    Momentum pusher (see PushKernelPusher)
+     * \tparam use_maps  Whether the particles are advanced by the maps of the thick
+     *                   lattice elements inside them (see GetExternalEBField::pushThroughMap)
+     */
+    template <int do_sync, int pusher, bool use_maps>
+    AMREX_GPU_DEVICE AMREX_FORCE_INLINE
+    void doParticlePushPX ([[maybe_unused]] const GetExternalEBField& getExternalEB,
+                           amrex::ParticleReal& xp, amrex::ParticleReal& yp, amrex::ParticleReal& zp,
+                           amrex::ParticleReal& ux, amrex::ParticleReal& uy, amrex::ParticleReal& uz,
+                           amrex::ParticleReal Exp, amrex::ParticleReal Eyp, amrex::ParticleReal Ezp,
+                           amrex::ParticleReal Bxp, amrex::ParticleReal Byp, amrex::ParticleReal Bzp,
+                           amrex::ParticleReal qp, amrex::ParticleReal m,
+                           amrex::Real t_chi_max, amrex::Real dt)
+    {
+        if constexpr (use_maps) {
+            if (getExternalEB.pushThroughMap(xp, yp, zp, ux, uy, uz, qp, m, dt)) { return; }
+        }
+        doSelectedParticleMomentumPush<do_sync, pusher>(ux, uy, uz,
+                                                        Exp, Eyp, Ezp, Bxp, Byp, Bzp,
+                                                        qp, m, t_chi_max, dt);
+        UpdatePosition(xp, yp, zp, ux, uy, uz, dt);
+    }
 }
 
 PhysicalParticleContainer::PhysicalParticleContainer (AmrCore* amr_core, int ispecies,
@@ -337,8 +570,29 @@ PhysicalParticleContainer::PhysicalParticleContainer (AmrCore* amr_core, int isp
     pp_species_name.query("do_not_deposit", do_not_deposit);
     pp_species_name.query("do_not_gather", do_not_gather);
     pp_species_name.query("do_not_push", do_not_push);
+    pp_species_name.query("assign_unique_ids", m_assign_unique_ids);
+    utils::parser::queryWithParser(pp_species_name, "push_every_n_steps", m_push_every_n_steps);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_push_every_n_steps >= 1,
+        species_name + ".push_every_n_steps must be at least 1");
+    m_push_num_steps = m_push_every_n_steps;
 
     pp_species_name.query("do_continuous_injection", do_continuous_injection);
+    if (m_push_every_n_steps > 1) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            WarpX::evolve_scheme == EvolveScheme::Explicit &&
+            WarpX::electromagnetic_solver_id != ElectromagneticSolverAlgo::PSATD,
+            species_name + ".push_every_n_steps > 1 is only supported with the explicit scheme "
+            "and a finite-difference or electrostatic solver");
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            WarpX::current_deposition_algo != CurrentDepositionAlgo::Vay,
+            species_name + ".push_every_n_steps > 1 is not supported with Vay current deposition");
+        // Particles injected between two pushes are neither at the time of the positions
+        // of the species nor pushed yet, and would deposit a spurious current
+        const bool do_flux_injection = std::any_of(plasma_injectors.begin(), plasma_injectors.end(),
+            [] (auto const& injector) { return injector->doFluxInjection(); });
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!do_continuous_injection && !do_flux_injection,
+            species_name + ".push_every_n_steps > 1 is not supported with continuous or flux injection");
+    }
     pp_species_name.query("initialize_self_fields", initialize_self_fields);
     utils::parser::queryWithParser(
         pp_species_name, "self_fields_required_precision", self_fields_required_precision);
@@ -495,40 +749,60 @@ void PhysicalParticleContainer::MapParticletoBoostedFrame (
 
     // For now, start with the assumption that this will only happen
     // at the start of the simulation.
-    const ParticleReal uz_boost = WarpX::gamma_boost*WarpX::beta_boost*PhysConst::c;
-
-    // tpr is the particle's time in the boosted frame
-    const ParticleReal tpr = WarpX::gamma_boost*t_lab - uz_boost*z/(PhysConst::c*PhysConst::c);
-
-    // The particle's transformed location in the boosted frame
-    const ParticleReal xpr = x;
-    const ParticleReal ypr = y;
-    const ParticleReal zpr = WarpX::gamma_boost*z - uz_boost*t_lab;
-
-    // transform u and gamma to the boosted frame
-    const ParticleReal gamma_lab = std::sqrt(1._rt + (ux*ux + uy*uy + uz*uz)/(PhysConst::c*PhysConst::c));
-    // ux = ux;
-    // uy = uy;
-    uz = WarpX::gamma_boost*uz - uz_boost*gamma_lab;
-    const ParticleReal gammapr = std::sqrt(1._rt + (ux*ux + uy*uy + uz*uz)/(PhysConst::c*PhysConst::c));
+    constexpr int lev = 0;
+    const amrex::Real t0 = WarpX::GetInstance().gett_new(lev);
+    mapToBoostedFrame(x, y, z, ux, uy, uz, t_lab, t0, WarpX::gamma_boost, WarpX::beta_boost,
+                      do_backward_propagation, boost_adjust_transverse_positions);
+}
 
-    const ParticleReal vxpr = ux/gammapr;
-    const ParticleReal vypr = uy/gammapr;
-    const ParticleReal vzpr = uz/gammapr;
+void PhysicalParticleContainer::MapParticlestoBoostedFrame (
+    Gpu::HostVector<ParticleReal>& x, Gpu::HostVector<ParticleReal>& y,
+    Gpu::HostVector<ParticleReal>& z, Gpu::HostVector<ParticleReal>& ux,
+    Gpu::HostVector<ParticleReal>& uy, Gpu::HostVector<ParticleReal>& uz, Real t_lab) const
+{
+    const auto np = static_cast<long>(z.size());
+    if (np == 0) { return; }
 
-    if (do_backward_propagation){
-        uz = -uz;
+    std::array<Gpu::HostVector<ParticleReal>*, 6> const host_data = {&x, &y, &z, &ux, &uy, &uz};
+    std::array<ParticleReal*, 6> data{};
+#ifdef AMREX_USE_GPU
+    // The transform runs on the device: copy the particles there and back
+    std::array<Gpu::DeviceVector<ParticleReal>, 6> device_data;
+    for (int i = 0; i < 6; ++i) {
+        device_data[i].resize(np);
+        Gpu::copyAsync(Gpu::hostToDevice, host_data[i]->begin(), host_data[i]->end(),
+                       device_data[i].begin());
+        data[i] = device_data[i].data();
     }
+#else
+    for (int i = 0; i < 6; ++i) { data[i] = host_data[i]->data(); }
+#endif
 
-    //Move the particles to where they will be at t = t0, the current simulation time in the boosted frame
     constexpr int lev = 0;
     const amrex::Real t0 = WarpX::GetInstance().gett_new(lev);
-    if (boost_adjust_transverse_positions) {
-        x = xpr - (tpr-t0)*vxpr;
-        y = ypr - (tpr-t0)*vypr;
-    }
-    z = zpr - (tpr-t0)*vzpr;
+    const amrex::Real gamma_boost = WarpX::gamma_boost;
+    const amrex::Real beta_boost = WarpX::beta_boost;
+    const bool backward = do_backward_propagation;
+    const bool adjust_transverse = boost_adjust_transverse_positions;
+    ParticleReal* const AMREX_RESTRICT xp = data[0];
+    ParticleReal* const AMREX_RESTRICT yp = data[1];
+    ParticleReal* const AMREX_RESTRICT zp = data[2];
+    ParticleReal* const AMREX_RESTRICT uxp = data[3];
+    ParticleReal* const AMREX_RESTRICT uyp = data[4];
+    ParticleReal* const AMREX_RESTRICT uzp = data[5];
+    amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (long i) noexcept
+    {
+        mapToBoostedFrame(xp[i], yp[i], zp[i], uxp[i], uyp[i], uzp[i], t_lab, t0,
+                          gamma_boost, beta_boost, backward, adjust_transverse);
+    });
 
+#ifdef AMREX_USE_GPU
+    for (int i = 0; i < 6; ++i) {
+        Gpu::copyAsync(Gpu::deviceToHost, device_data[i].begin(), device_data[i].end(),
+                       host_data[i]->begin());
+    }
+    Gpu::streamSynchronize();
+#endif
 }
 
 void
@@ -688,6 +962,11 @@ PhysicalParticleContainer::AddGaussianBeam (PlasmaInjector const& plasma_injecto
             }
         }
     }
+    if (WarpX::gamma_boost > 1.) {
+        MapParticlestoBoostedFrame(particle_x, particle_y, particle_z,
+                                   particle_ux, particle_uy, particle_uz);
+    }
+
     // Add the temporary CPU vectors to the particle structure
     auto const np = static_cast<long>(particle_z.size());
 
@@ -723,113 +1002,172 @@ PhysicalParticleContainer::AddPlasmaFromFile(PlasmaInjector & plasma_injector,
     Gpu::HostVector<ParticleReal> particle_uy;
 
 #ifdef WARPX_USE_OPENPMD
-    //TODO: Make changes for read/write in multiple MPI ranks
-    if (ParallelDescriptor::IOProcessor()) {
-        // take ownership of the series and close it when done
-        auto series = std::move(plasma_injector.m_openpmd_input_series);
-
-        // assumption asserts: see PlasmaInjector
-        openPMD::Iteration it = series->iterations.begin()->second;
-        const ParmParse pp_species_name(species_name);
-        pp_species_name.query("impose_t_lab_from_file", impose_t_lab_from_file);
-        double t_lab = 0._prt;
-        if (impose_t_lab_from_file) {
-            // Impose t_lab as being the time stored in the openPMD file
-            t_lab = it.time<double>() * it.timeUnitSI();
-        }
-        std::string const ps_name = it.particles.begin()->first;
-        openPMD::ParticleSpecies ps = it.particles.begin()->second;
+    // Every MPI rank reads a contiguous chunk of the particles of the file, in batches
+    // of at most injection_file_batch_size particles, which are added to the species
+    // (and redistributed) one after the other. This bounds the host memory needed for
+    // the reading, and does not funnel all the particles through the I/O processor.
+    // The series opened by the I/O processor to read the metadata is not needed anymore.
+    plasma_injector.m_openpmd_input_series.reset();
+    auto series = std::make_unique<openPMD::Series>(
+        plasma_injector.str_injection_file, openPMD::Access::READ_ONLY);
+
+    // assumption asserts: see PlasmaInjector
+    openPMD::Iteration it = series->iterations.begin()->second;
+    const ParmParse pp_species_name(species_name);
+    pp_species_name.query("impose_t_lab_from_file", impose_t_lab_from_file);
+    double t_lab = 0._prt;
+    if (impose_t_lab_from_file) {
+        // Impose t_lab as being the time stored in the openPMD file
+        t_lab = it.time<double>() * it.timeUnitSI();
+    }
+    std::string const ps_name = it.particles.begin()->first;
+    openPMD::ParticleSpecies ps = it.particles.begin()->second;
+
+    if (q_tot != 0.0 && ParallelDescriptor::IOProcessor()) {
+        std::stringstream warnMsg;
+        warnMsg << " Loading particle species from file. " << ps_name << ".q_tot is ignored.";
+        ablastr::warn_manager::WMRecordWarning("AddPlasmaFromFile",
+           warnMsg.str(), ablastr::warn_manager::WarnPriority::high);
+    }
 
-        auto const npart = ps["position"]["x"].getExtent()[0];
+    auto const npart = static_cast<amrex::Long>(ps["position"]["z"].getExtent()[0]);
 #if !defined(WARPX_DIM_1D_Z)  // 2D, 3D, and RZ
-        const std::shared_ptr<ParticleReal> ptr_x = ps["position"]["x"].loadChunk<ParticleReal>();
-        const std::shared_ptr<ParticleReal> ptr_offset_x = ps["positionOffset"]["x"].loadChunk<ParticleReal>();
-        auto const position_unit_x = static_cast<ParticleReal>(ps["position"]["x"].unitSI());
-        auto const position_offset_unit_x = static_cast<ParticleReal>(ps["positionOffset"]["x"].unitSI());
+    auto const position_unit_x = static_cast<ParticleReal>(ps["position"]["x"].unitSI());
+    auto const position_offset_unit_x = static_cast<ParticleReal>(ps["positionOffset"]["x"].unitSI());
 #endif
 #if !(defined(WARPX_DIM_XZ) || defined(WARPX_DIM_1D_Z))
-        const std::shared_ptr<ParticleReal> ptr_y = ps["position"]["y"].loadChunk<ParticleReal>();
-        const std::shared_ptr<ParticleReal> ptr_offset_y = ps["positionOffset"]["y"].loadChunk<ParticleReal>();
-        auto const position_unit_y = static_cast<ParticleReal>(ps["position"]["y"].unitSI());
-        auto const position_offset_unit_y = static_cast<ParticleReal>(ps["positionOffset"]["y"].unitSI());
-#endif
-        const std::shared_ptr<ParticleReal> ptr_z = ps["position"]["z"].loadChunk<ParticleReal>();
-        const std::shared_ptr<ParticleReal> ptr_offset_z = ps["positionOffset"]["z"].loadChunk<ParticleReal>();
-        auto const position_unit_z = static_cast<ParticleReal>(ps["position"]["z"].unitSI());
-        auto const position_offset_unit_z = static_cast<ParticleReal>(ps["positionOffset"]["z"].unitSI());
-        const std::shared_ptr<ParticleReal> ptr_ux = ps["momentum"]["x"].loadChunk<ParticleReal>();
-        auto const momentum_unit_x = static_cast<ParticleReal>(ps["momentum"]["x"].unitSI());
-        const std::shared_ptr<ParticleReal> ptr_uz = ps["momentum"]["z"].loadChunk<ParticleReal>();
-        auto const momentum_unit_z = static_cast<ParticleReal>(ps["momentum"]["z"].unitSI());
-        const std::shared_ptr<ParticleReal> ptr_w = ps["weighting"][openPMD::RecordComponent::SCALAR].loadChunk<ParticleReal>();
-        auto const w_unit = static_cast<ParticleReal>(ps["weighting"][openPMD::RecordComponent::SCALAR].unitSI());
-        std::shared_ptr<ParticleReal> ptr_uy = nullptr;
-        auto momentum_unit_y = 1.0_prt;
-        if (ps["momentum"].contains("y")) {
-            ptr_uy = ps["momentum"]["y"].loadChunk<ParticleReal>();
-            momentum_unit_y = static_cast<ParticleReal>(ps["momentum"]["y"].unitSI());
-        }
-        series->flush();  // shared_ptr data can be read now
+    auto const position_unit_y = static_cast<ParticleReal>(ps["position"]["y"].unitSI());
+    auto const position_offset_unit_y = static_cast<ParticleReal>(ps["positionOffset"]["y"].unitSI());
+#endif
+    auto const position_unit_z = static_cast<ParticleReal>(ps["position"]["z"].unitSI());
+    auto const position_offset_unit_z = static_cast<ParticleReal>(ps["positionOffset"]["z"].unitSI());
+    auto const momentum_unit_x = static_cast<ParticleReal>(ps["momentum"]["x"].unitSI());
+    auto const momentum_unit_z = static_cast<ParticleReal>(ps["momentum"]["z"].unitSI());
+    auto const w_unit = static_cast<ParticleReal>(ps["weighting"][openPMD::RecordComponent::SCALAR].unitSI());
+    const bool has_uy = ps["momentum"].contains("y");
+    auto const momentum_unit_y = has_uy ?
+        static_cast<ParticleReal>(ps["momentum"]["y"].unitSI()) : 1.0_prt;
+
+    // Contiguous chunk [ibegin, ibegin+nlocal) of this rank
+    const amrex::Long nprocs = ParallelDescriptor::NProcs();
+    const amrex::Long myproc = ParallelDescriptor::MyProc();
+    const amrex::Long navg = npart/nprocs;
+    const amrex::Long nleft = npart - navg*nprocs;
+    const amrex::Long ibegin = (myproc < nleft) ? myproc*(navg+1) : myproc*navg + nleft;
+    const amrex::Long nlocal = (myproc < nleft) ? navg+1 : navg;
+
+    // All the ranks do the same number of batches, since adding the particles
+    // of a batch to the species redistributes them
+    const auto batch_size = static_cast<amrex::Long>(plasma_injector.injection_file_batch_size);
+    const amrex::Long nlocal_max = (nleft > 0) ? navg+1 : navg;
+    const amrex::Long nbatches = (nlocal_max + batch_size - 1)/batch_size;
+
+    amrex::Long nkept = 0;
+    for (amrex::Long ibatch = 0; ibatch < nbatches; ++ibatch) {
+        const amrex::Long batch_begin = std::min(ibatch*batch_size, nlocal);
+        const amrex::Long nbatch = std::min(batch_size, nlocal - batch_begin);
+
+        particle_x.clear();
+        particle_y.clear();
+        particle_z.clear();
+        particle_ux.clear();
+        particle_uy.clear();
+        particle_uz.clear();
+        particle_w.clear();
+
+        if (nbatch > 0) {
+            const openPMD::Offset offset{static_cast<std::uint64_t>(ibegin + batch_begin)};
+            const openPMD::Extent extent{static_cast<std::uint64_t>(nbatch)};
+#if !defined(WARPX_DIM_1D_Z)  // 2D, 3D, and RZ
+            const std::shared_ptr<ParticleReal> ptr_x = ps["position"]["x"].loadChunk<ParticleReal>(offset, extent);
+            const std::shared_ptr<ParticleReal> ptr_offset_x = ps["positionOffset"]["x"].loadChunk<ParticleReal>(offset, extent);
+#endif
+#if !(defined(WARPX_DIM_XZ) || defined(WARPX_DIM_1D_Z))
+            const std::shared_ptr<ParticleReal> ptr_y = ps["position"]["y"].loadChunk<ParticleReal>(offset, extent);
+            const std::shared_ptr<ParticleReal> ptr_offset_y = ps["positionOffset"]["y"].loadChunk<ParticleReal>(offset, extent);
+#endif
+            const std::shared_ptr<ParticleReal> ptr_z = ps["position"]["z"].loadChunk<ParticleReal>(offset, extent);
+            const std::shared_ptr<ParticleReal> ptr_offset_z = ps["positionOffset"]["z"].loadChunk<ParticleReal>(offset, extent);
+            const std::shared_ptr<ParticleReal> ptr_ux = ps["momentum"]["x"].loadChunk<ParticleReal>(offset, extent);
+            const std::shared_ptr<ParticleReal> ptr_uz = ps["momentum"]["z"].loadChunk<ParticleReal>(offset, extent);
+            const std::shared_ptr<ParticleReal> ptr_w = ps["weighting"][openPMD::RecordComponent::SCALAR].loadChunk<ParticleReal>(offset, extent);
+            std::shared_ptr<ParticleReal> ptr_uy = nullptr;
+            if (has_uy) {
+                ptr_uy = ps["momentum"]["y"].loadChunk<ParticleReal>(offset, extent);
+            }
+            series->flush();  // shared_ptr data can be read now
 
-        if (q_tot != 0.0) {
-            std::stringstream warnMsg;
-            warnMsg << " Loading particle species from file. " << ps_name << ".q_tot is ignored.";
-            ablastr::warn_manager::WMRecordWarning("AddPlasmaFromFile",
-               warnMsg.str(), ablastr::warn_manager::WarnPriority::high);
-        }
+            particle_x.reserve(nbatch);
+            particle_y.reserve(nbatch);
+            particle_z.reserve(nbatch);
+            particle_ux.reserve(nbatch);
+            particle_uy.reserve(nbatch);
+            particle_uz.reserve(nbatch);
+            particle_w.reserve(nbatch);
 
-        for (auto i = decltype(npart){0}; i<npart; ++i){
+            for (amrex::Long i = 0; i < nbatch; ++i){
 
-            ParticleReal const weight = ptr_w.get()[i]*w_unit;
+                ParticleReal const weight = ptr_w.get()[i]*w_unit;
 
 #if !defined(WARPX_DIM_1D_Z)
-            ParticleReal const x = ptr_x.get()[i]*position_unit_x + ptr_offset_x.get()[i]*position_offset_unit_x;
+                ParticleReal const x = ptr_x.get()[i]*position_unit_x + ptr_offset_x.get()[i]*position_offset_unit_x;
 #else
-            ParticleReal const x = 0.0_prt;
+                ParticleReal const x = 0.0_prt;
 #endif
 #if defined(WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
-            ParticleReal const y = ptr_y.get()[i]*position_unit_y + ptr_offset_y.get()[i]*position_offset_unit_y;
+                ParticleReal const y = ptr_y.get()[i]*position_unit_y + ptr_offset_y.get()[i]*position_offset_unit_y;
 #else
-            ParticleReal const y = 0.0_prt;
+                ParticleReal const y = 0.0_prt;
 #endif
-            ParticleReal const z = ptr_z.get()[i]*position_unit_z + ptr_offset_z.get()[i]*position_offset_unit_z + z_shift;
-
-            if (plasma_injector.insideBounds(x, y, z)) {
-                ParticleReal const ux = ptr_ux.get()[i]*momentum_unit_x/mass;
-                ParticleReal const uz = ptr_uz.get()[i]*momentum_unit_z/mass;
-                ParticleReal uy = 0.0_prt;
-                if (ps["momentum"].contains("y")) {
-                    uy = ptr_uy.get()[i]*momentum_unit_y/mass;
+                ParticleReal const z = ptr_z.get()[i]*position_unit_z + ptr_offset_z.get()[i]*position_offset_unit_z + z_shift;
+
+                if (plasma_injector.insideBounds(x, y, z)) {
+                    ParticleReal const ux = ptr_ux.get()[i]*momentum_unit_x/mass;
+                    ParticleReal const uz = ptr_uz.get()[i]*momentum_unit_z/mass;
+                    ParticleReal uy = 0.0_prt;
+                    if (has_uy) {
+                        uy = ptr_uy.get()[i]*momentum_unit_y/mass;
+                    }
+                    CheckAndAddParticle(x, y, z, ux, uy, uz, weight,
+                                        particle_x,  particle_y,  particle_z,
+                                        particle_ux, particle_uy, particle_uz,
+                                        particle_w);
                 }
-                CheckAndAddParticle(x, y, z, ux, uy, uz, weight,
-                                    particle_x,  particle_y,  particle_z,
-                                    particle_ux, particle_uy, particle_uz,
-                                    particle_w, static_cast<amrex::Real>(t_lab));
+            }
+
+            if (WarpX::gamma_boost > 1.) {
+                MapParticlestoBoostedFrame(particle_x, particle_y, particle_z,
+                                           particle_ux, particle_uy, particle_uz,
+                                           static_cast<amrex::Real>(t_lab));
             }
         }
-        auto const np = particle_z.size();
-        if (np < npart) {
-            ablastr::warn_manager::WMRecordWarning("Species",
-                "Simulation box doesn't cover all particles",
-                ablastr::warn_manager::WarnPriority::high);
-        }
-    } // IO Processor
-    auto const np = static_cast<long>(particle_z.size());
-    const amrex::Vector<ParticleReal> xp(particle_x.data(), particle_x.data() + np);
-    const amrex::Vector<ParticleReal> yp(particle_y.data(), particle_y.data() + np);
-    const amrex::Vector<ParticleReal> zp(particle_z.data(), particle_z.data() + np);
-    const amrex::Vector<ParticleReal> uxp(particle_ux.data(), particle_ux.data() + np);
-    const amrex::Vector<ParticleReal> uyp(particle_uy.data(), particle_uy.data() + np);
-    const amrex::Vector<ParticleReal> uzp(particle_uz.data(), particle_uz.data() + np);
 
-    amrex::Vector<amrex::Vector<ParticleReal>> attr;
-    const amrex::Vector<ParticleReal> wp(particle_w.data(), particle_w.data() + np);
-    attr.push_back(wp);
+        // Add the particles of this batch to the particle structure
+        auto const np = static_cast<long>(particle_z.size());
+        nkept += np;
+        const amrex::Vector<ParticleReal> xp(particle_x.data(), particle_x.data() + np);
+        const amrex::Vector<ParticleReal> yp(particle_y.data(), particle_y.data() + np);
+        const amrex::Vector<ParticleReal> zp(particle_z.data(), particle_z.data() + np);
+        const amrex::Vector<ParticleReal> uxp(particle_ux.data(), particle_ux.data() + np);
+        const amrex::Vector<ParticleReal> uyp(particle_uy.data(), particle_uy.data() + np);
+        const amrex::Vector<ParticleReal> uzp(particle_uz.data(), particle_uz.data() + np);
 
-    const amrex::Vector<amrex::Vector<int>> attr_int;
+        amrex::Vector<amrex::Vector<ParticleReal>> attr;
+        const amrex::Vector<ParticleReal> wp(particle_w.data(), particle_w.data() + np);
+        attr.push_back(wp);
 
-    AddNParticles(0, np, xp,  yp,  zp, uxp, uyp, uzp,
-                  1, attr, 0, attr_int, 1);
+        const amrex::Vector<amrex::Vector<int>> attr_int;
+
+        AddNParticles(0, np, xp,  yp,  zp, uxp, uyp, uzp,
+                      1, attr, 0, attr_int, 1);
+    }
+
+    ParallelDescriptor::ReduceLongSum(nkept);
+    if (nkept < npart) {
+        ablastr::warn_manager::WMRecordWarning("Species",
+            "Simulation box doesn't cover all particles",
+            ablastr::warn_manager::WarnPriority::high);
+    }
 #endif // WARPX_USE_OPENPMD
 
     ignore_unused(plasma_injector, q_tot, z_shift);
@@ -856,6 +1194,27 @@ PhysicalParticleContainer::DefaultInitializeRuntimeAttributes (
                                        0,pinned_tile.numParticles());
 }
 
+void
+PhysicalParticleContainer::DefaultInitializeRuntimeAttributes (
+    ParticleTileType& tile,
+    int n_external_attr_real,
+    int n_external_attr_int)
+{
+    ParticleCreation::DefaultInitializeRuntimeAttributes(tile,
+                                       n_external_attr_real, n_external_attr_int,
+                                       m_user_real_attribs, m_user_int_attribs,
+                                       particle_comps, particle_icomps,
+                                       amrex::GetVecOfPtrs(m_user_real_attrib_parser),
+                                       amrex::GetVecOfPtrs(m_user_int_attrib_parser),
+#ifdef WARPX_QED
+                                       true,
+                                       m_shr_p_bw_engine.get(),
+                                       m_shr_p_qs_engine.get(),
+#endif
+                                       ionization_initial_level,
+                                       0,tile.numParticles());
+}
+
 
 void
 PhysicalParticleContainer::CheckAndAddParticle (
@@ -868,12 +1227,8 @@ PhysicalParticleContainer::CheckAndAddParticle (
     Gpu::HostVector<ParticleReal>& particle_ux,
     Gpu::HostVector<ParticleReal>& particle_uy,
     Gpu::HostVector<ParticleReal>& particle_uz,
-    Gpu::HostVector<ParticleReal>& particle_w,
-    Real t_lab) const
+    Gpu::HostVector<ParticleReal>& particle_w)
 {
-    if (WarpX::gamma_boost > 1.) {
-        MapParticletoBoostedFrame(x, y, z, ux, uy, uz, t_lab);
-    }
     particle_x.push_back(x);
     particle_y.push_back(y);
     particle_z.push_back(z);
@@ -997,6 +1352,9 @@ PhysicalParticleContainer::AddPlasma (PlasmaInjector const& plasma_injector, int
     const Real beta_boost = WarpX::beta_boost;
     const Real t = WarpX::GetInstance().gett_new(lev);
     const Real density_min = plasma_injector.density_min;
+
+    const bool counter_based_injection = WarpX::counter_based_injection;
+    const std::uint64_t injection_key = getInjectionRandomKey(plasma_injector, species_id, lev);
     const Real density_max = plasma_injector.density_max;
 
 #ifdef WARPX_DIM_RZ
@@ -1138,18 +1496,26 @@ PhysicalParticleContainer::AddPlasma (PlasmaInjector const& plasma_injector, int
         // and invalid ones are then discarded
         const amrex::Long max_new_particles = Scan::ExclusiveSum(counts.size(), counts.data(), offset.data());
 
-        // Update NextID to include particles created in this function
-        amrex::Long pid;
+        // Nothing to inject in this tile (e.g. continuous injection into a slab
+        // that is outside of the plasma region): skip the particle creation
+        if (max_new_particles == 0) { continue; }
+
+        // Update NextID to include particles created in this function,
+        // unless the particles of this species do not need unique IDs
+        amrex::Long pid = NonUniqueParticleID;
+        const bool unique_ids = m_assign_unique_ids;
+        if (unique_ids) {
 #ifdef AMREX_USE_OMP
 #pragma omp critical (add_plasma_nextid)
 #endif
-        {
-            pid = ParticleType::NextID();
-            ParticleType::NextID(pid+max_new_particles);
+            {
+                pid = ParticleType::NextID();
+                ParticleType::NextID(pid+max_new_particles);
+            }
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                pid + max_new_particles < LongParticleIds::LastParticleID,
+                "ERROR: overflow on particle id numbers");
         }
-        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
-            pid + max_new_particles < LongParticleIds::LastParticleID,
-            "ERROR: overflow on particle id numbers");
 
         const int cpuid = ParallelDescriptor::MyProc();
 
@@ -1258,7 +1624,12 @@ PhysicalParticleContainer::AddPlasma (PlasmaInjector const& plasma_injector, int
             const auto index = overlap_box.index(iv);
 #ifdef WARPX_DIM_RZ
             Real theta_offset = 0._rt;
-            if (rz_random_theta) { theta_offset = amrex::Random(engine) * 2._rt * MathConst::pi; }
+            if (rz_random_theta) {
+                const auto cell_engine = counter_based_injection ?
+                    utils::random::InjectionRandomEngine(injection_key, iv + shifted, -1) :
+                    utils::random::InjectionRandomEngine(engine);
+                theta_offset = utils::random::Random(cell_engine) * 2._rt * MathConst::pi;
+            }
 #endif
 
             Real scale_fac = 0.0_rt;
@@ -1275,12 +1646,15 @@ PhysicalParticleContainer::AddPlasma (PlasmaInjector const& plasma_injector, int
             for (int i_part = 0; i_part < pcounts[index]; ++i_part)
             {
                 long ip = poffset[index] + i_part;
-                pa_idcpu[ip] = amrex::SetParticleIDandCPU(pid+ip, cpuid);
+                pa_idcpu[ip] = amrex::SetParticleIDandCPU(unique_ids ? pid+ip : pid, cpuid);
+                const auto part_engine = counter_based_injection ?
+                    utils::random::InjectionRandomEngine(injection_key, iv + shifted, i_part) :
+                    utils::random::InjectionRandomEngine(engine);
                 const XDim3 r = (fine_overlap_box.ok() && fine_overlap_box.contains(iv)) ?
                   // In the refined injection region: use refinement ratio `lrrfac`
-                  inj_pos->getPositionUnitBox(i_part, lrrfac, engine) :
+                  inj_pos->getPositionUnitBox(i_part, lrrfac, part_engine) :
                   // Otherwise: use 1 as the refinement ratio
-                  inj_pos->getPositionUnitBox(i_part, amrex::IntVect::TheUnitVector(), engine);
+                  inj_pos->getPositionUnitBox(i_part, amrex::IntVect::TheUnitVector(), part_engine);
                 auto pos = getCellCoords(overlap_corner, dx, r, iv);
 
 #if defined(WARPX_DIM_3D)
@@ -1328,7 +1702,7 @@ PhysicalParticleContainer::AddPlasma (PlasmaInjector const& plasma_injector, int
                 // With only 1 mode, the angle doesn't matter so
                 // choose it randomly.
                 const Real theta = (nmodes == 1 && rz_random_theta)?
-                    (2._rt*MathConst::pi*amrex::Random(engine)):
+                    (2._rt*MathConst::pi*utils::random::Random(part_engine)):
                     (2._rt*MathConst::pi*r.y + theta_offset);
                 pos.x = xb*std::cos(theta);
                 pos.y = xb*std::sin(theta);
@@ -1355,7 +1729,7 @@ PhysicalParticleContainer::AddPlasma (PlasmaInjector const& plasma_injector, int
                         continue;
                     }
 
-                    u = inj_mom->getMomentum(pos.x, pos.y, z0, engine);
+                    u = inj_mom->getMomentum(pos.x, pos.y, z0, part_engine);
                     dens = inj_rho->getDensity(pos.x, pos.y, z0);
 
                     // Remove particle if density below threshold
@@ -1402,7 +1776,7 @@ PhysicalParticleContainer::AddPlasma (PlasmaInjector const& plasma_injector, int
                     dens = amrex::min(dens, density_max);
 
                     // get the full momentum, including thermal motion
-                    u = inj_mom->getMomentum(pos.x, pos.y, 0._rt, engine);
+                    u = inj_mom->getMomentum(pos.x, pos.y, 0._rt, part_engine);
                     const Real gamma_lab = std::sqrt( 1._rt+(u.x*u.x+u.y*u.y+u.z*u.z) );
                     const Real betaz_lab = u.z/(gamma_lab);
 
@@ -1418,11 +1792,11 @@ PhysicalParticleContainer::AddPlasma (PlasmaInjector const& plasma_injector, int
 
 #ifdef WARPX_QED
                 if(loc_has_quantum_sync){
-                    p_optical_depth_QSR[ip] = quantum_sync_get_opt(engine);
+                    p_optical_depth_QSR[ip] = quantum_sync_get_opt(part_engine);
                 }
 
                 if(loc_has_breit_wheeler){
-                    p_optical_depth_BW[ip] = breit_wheeler_get_opt(engine);
+                    p_optical_depth_BW[ip] = breit_wheeler_get_opt(part_engine);
                 }
 #endif
                 // Initialize user-defined integers with user-defined parser
@@ -1527,13 +1901,21 @@ PhysicalParticleContainer::AddPlasmaFlux (PlasmaInjector const& plasma_injector,
 
     amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(0);
 
-    // Create temporary particle container to which particles will be added;
-    // we will then call Redistribute on this new container and finally
-    // add the new particles to the original container.
-    PhysicalParticleContainer tmp_pc(&WarpX::GetInstance());
-    for (int ic = 0; ic < NumRuntimeRealComps(); ++ic) { tmp_pc.AddRealComp(false); }
-    for (int ic = 0; ic < NumRuntimeIntComps(); ++ic) { tmp_pc.AddIntComp(false); }
-    tmp_pc.defineAllParticleTiles();
+    // The particles are first created in a staging container, with the same tiles
+    // as this container, and then appended to this container. The staging container
+    // is kept across steps, and only redefined when the grids change.
+    if (!m_flux_staging_pc ||
+        m_flux_staging_ba != ParticleBoxArray(0) ||
+        m_flux_staging_dm != ParticleDistributionMap(0))
+    {
+        m_flux_staging_pc = std::make_unique<PhysicalParticleContainer>(&WarpX::GetInstance());
+        for (int ic = 0; ic < NumRuntimeRealComps(); ++ic) { m_flux_staging_pc->AddRealComp(false); }
+        for (int ic = 0; ic < NumRuntimeIntComps(); ++ic) { m_flux_staging_pc->AddIntComp(false); }
+        m_flux_staging_pc->defineAllParticleTiles();
+        m_flux_staging_ba = ParticleBoxArray(0);
+        m_flux_staging_dm = ParticleDistributionMap(0);
+    }
+    PhysicalParticleContainer& tmp_pc = *m_flux_staging_pc;
 
     const int nlevs = numLevels();
     static bool refine_injection = false;
@@ -1555,6 +1937,9 @@ PhysicalParticleContainer::AddPlasmaFlux (PlasmaInjector const& plasma_injector,
     constexpr int level_zero = 0;
     const amrex::Real t = WarpX::GetInstance().gett_new(level_zero);
 
+    const bool counter_based_injection = WarpX::counter_based_injection;
+    const std::uint64_t injection_key = getInjectionRandomKey(plasma_injector, species_id, level_zero);
+
 #ifdef WARPX_DIM_RZ
     const int nmodes = WarpX::n_rz_azimuthal_modes;
     const bool rz_random_theta = m_rz_random_theta;
@@ -1667,7 +2052,10 @@ PhysicalParticleContainer::AddPlasmaFlux (PlasmaInjector const& plasma_injector,
             auto lo = getCellCoords(overlap_corner, dx, {0._rt, 0._rt, 0._rt}, iv);
             auto hi = getCellCoords(overlap_corner, dx, {1._rt, 1._rt, 1._rt}, iv);
 
-            const int num_ppc_int = static_cast<int>(num_ppc_real + amrex::Random(engine));
+            const auto cell_engine = counter_based_injection ?
+                utils::random::InjectionRandomEngine(injection_key, iv + shifted, -1) :
+                utils::random::InjectionRandomEngine(engine);
+            const int num_ppc_int = static_cast<int>(num_ppc_real + utils::random::Random(cell_engine));
 
             if (flux_pos->overlapsWith(lo, hi))
             {
@@ -1691,18 +2079,22 @@ PhysicalParticleContainer::AddPlasmaFlux (PlasmaInjector const& plasma_injector,
         // and invalid ones are then discarded
         const amrex::Long max_new_particles = Scan::ExclusiveSum(counts.size(), counts.data(), offset.data());
 
-        // Update NextID to include particles created in this function
-        amrex::Long pid;
+        // Update NextID to include particles created in this function,
+        // unless the particles of this species do not need unique IDs
+        amrex::Long pid = NonUniqueParticleID;
+        const bool unique_ids = m_assign_unique_ids;
+        if (unique_ids) {
 #ifdef AMREX_USE_OMP
 #pragma omp critical (add_plasma_nextid)
 #endif
-        {
-            pid = ParticleType::NextID();
-            ParticleType::NextID(pid+max_new_particles);
+            {
+                pid = ParticleType::NextID();
+                ParticleType::NextID(pid+max_new_particles);
+            }
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                pid + max_new_particles < LongParticleIds::LastParticleID,
+                "overflow on particle id numbers");
         }
-        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
-            pid + max_new_particles < LongParticleIds::LastParticleID,
-            "overflow on particle id numbers");
 
         const int cpuid = ParallelDescriptor::MyProc();
 
@@ -1815,20 +2207,23 @@ PhysicalParticleContainer::AddPlasmaFlux (PlasmaInjector const& plasma_injector,
             for (int i_part = 0; i_part < pcounts[index]; ++i_part)
             {
                 const long ip = poffset[index] + i_part;
-                pa_idcpu[ip] = amrex::SetParticleIDandCPU(pid+ip, cpuid);
+                pa_idcpu[ip] = amrex::SetParticleIDandCPU(unique_ids ? pid+ip : pid, cpuid);
+                const auto part_engine = counter_based_injection ?
+                    utils::random::InjectionRandomEngine(injection_key, iv + shifted, i_part) :
+                    utils::random::InjectionRandomEngine(engine);
 
                 // This assumes the flux_pos is of type InjectorPositionRandomPlane
                 const XDim3 r = (fine_overlap_box.ok() && fine_overlap_box.contains(iv)) ?
                   // In the refined injection region: use refinement ratio `lrrfac`
-                  flux_pos->getPositionUnitBox(i_part, lrrfac, engine) :
+                  flux_pos->getPositionUnitBox(i_part, lrrfac, part_engine) :
                   // Otherwise: use 1 as the refinement ratio
-                  flux_pos->getPositionUnitBox(i_part, amrex::IntVect::TheUnitVector(), engine);
+                  flux_pos->getPositionUnitBox(i_part, amrex::IntVect::TheUnitVector(), part_engine);
                 auto pos = getCellCoords(overlap_corner, dx, r, iv);
                 auto ppos = PDim3(pos);
 
                 // inj_mom would typically be InjectorMomentumGaussianFlux
                 XDim3 u;
-                u = inj_mom->getMomentum(pos.x, pos.y, pos.z, engine);
+                u = inj_mom->getMomentum(pos.x, pos.y, pos.z, part_engine);
                 auto pu = PDim3(u);
 
                 pu.x *= PhysConst::c;
@@ -1871,7 +2266,7 @@ PhysicalParticleContainer::AddPlasmaFlux (PlasmaInjector const& plasma_injector,
                 // With only 1 mode, the angle doesn't matter so
                 // choose it randomly.
                 const Real theta = (nmodes == 1 && rz_random_theta)?
-                    (2._prt*MathConst::pi*amrex::Random(engine)):
+                    (2._prt*MathConst::pi*utils::random::Random(part_engine)):
                     (2._prt*MathConst::pi*r.y);
                 Real const cos_theta = std::cos(theta);
                 Real const sin_theta = std::sin(theta);
@@ -1904,11 +2299,11 @@ PhysicalParticleContainer::AddPlasmaFlux (PlasmaInjector const& plasma_injector,
 
 #ifdef WARPX_QED
                 if (loc_has_quantum_sync) {
-                    p_optical_depth_QSR[ip] = quantum_sync_get_opt(engine);
+                    p_optical_depth_QSR[ip] = quantum_sync_get_opt(part_engine);
                 }
 
                 if(loc_has_breit_wheeler){
-                    p_optical_depth_BW[ip] = breit_wheeler_get_opt(engine);
+                    p_optical_depth_BW[ip] = breit_wheeler_get_opt(part_engine);
                 }
 #endif
                 // Initialize user-defined integers with user-defined parser
@@ -1949,7 +2344,7 @@ PhysicalParticleContainer::AddPlasmaFlux (PlasmaInjector const& plasma_injector,
 
                 // Update particle position by a random `t_fract`
                 // so as to produce a continuous-looking flow of particles
-                const amrex::Real t_fract = amrex::Random(engine)*dt;
+                const amrex::Real t_fract = utils::random::Random(part_engine)*dt;
                 UpdatePosition(ppos.x, ppos.y, ppos.z, pu.x, pu.y, pu.z, t_fract);
 
 #if defined(WARPX_DIM_3D)
@@ -1984,30 +2379,33 @@ PhysicalParticleContainer::AddPlasmaFlux (PlasmaInjector const& plasma_injector,
     scrapeParticlesAtEB(tmp_pc, amrex::GetVecOfConstPtrs(distance_to_eb), ParticleBoundaryProcess::Absorb());
 #endif
 
-    // Redistribute the new particles that were added to the temporary container.
-    // (This eliminates invalid particles, and makes sure that particles
-    // are in the right tile.)
-    tmp_pc.Redistribute();
-
-    // Add the particles to the current container, tile by tile
-    for (int lev=0; lev<numLevels(); lev++) {
+    // Add the particles to the current container, tile by tile, after removing the
+    // invalid ones. There is no Redistribute of the staging container: the new particles
+    // are appended to the tile in which they were created, and those that moved out of it
+    // during their fraction of time step are moved by the Redistribute that follows the
+    // injection in the PIC loop (see WarpX::HandleParticlesAtBoundaries).
+    InvalidateCellBins();
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
-        for (MFIter mfi = MakeMFIter(lev, info); mfi.isValid(); ++mfi)
-        {
-            // Extract tiles
-            const int grid_id = mfi.index();
-            const int tile_id = mfi.LocalTileIndex();
-            auto& src_tile = tmp_pc.DefineAndReturnParticleTile(lev, grid_id, tile_id);
-            auto& dst_tile = DefineAndReturnParticleTile(lev, grid_id, tile_id);
-
-            // Resize container and copy particles
-            auto old_size = dst_tile.numParticles();
-            auto n_new = src_tile.numParticles();
-            dst_tile.resize( old_size+n_new );
-            amrex::copyParticles(dst_tile, src_tile, 0, old_size, n_new);
-        }
+    for (MFIter mfi = MakeMFIter(0, info); mfi.isValid(); ++mfi)
+    {
+        // Extract tiles
+        const int grid_id = mfi.index();
+        const int tile_id = mfi.LocalTileIndex();
+        auto& src_tile = tmp_pc.DefineAndReturnParticleTile(0, grid_id, tile_id);
+        if (src_tile.numParticles() == 0) { continue; }
+        removeInvalidParticles(src_tile);
+        auto& dst_tile = DefineAndReturnParticleTile(0, grid_id, tile_id);
+
+        // Resize container and copy particles
+        auto old_size = dst_tile.numParticles();
+        auto n_new = src_tile.numParticles();
+        dst_tile.resize( old_size+n_new );
+        amrex::copyParticles(dst_tile, src_tile, 0, old_size, n_new);
+
+        // Empty the staging tile for the next injection
+        src_tile.resize(0);
     }
 }
 
@@ -2036,6 +2434,52 @@ PhysicalParticleContainer::Evolve (int lev,
 
     const bool has_buffer = cEx || cjx;
 
+    // Species pushed every m_push_every_n_steps steps (e.g. heavy ions) are pushed
+    // with a time step m_push_every_n_steps*dt. In between pushes, the particles
+    // stay at their new position, and the same current (averaged over the time
+    // step of the species) is deposited again, since the deposition reconstructs
+    // the old position from the new position and the momentum. The last push before
+    // the particles are synchronized (at the end of WarpX::Evolve) is shortened, so
+    // that the positions and momenta are synchronized at the time of the fields.
+    bool push_this_step = true;
+    if (m_push_every_n_steps > 1) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!m_do_back_transformed_particles,
+            species_name + ".push_every_n_steps > 1 is not supported with back-transformed diagnostics");
+        auto const& warpx = WarpX::GetInstance();
+        const int istep = warpx.getistep(lev);
+        push_this_step = (istep >= m_next_push_step);
+        if (push_this_step && !do_not_push) {
+            const int num_steps = static_cast<int>(std::clamp(
+                static_cast<long>(warpx.getsynchronization_step()) + 1 - istep,
+                1L, static_cast<long>(m_push_every_n_steps)));
+            if (num_steps != m_push_num_steps) {
+                // The momentum is half the previous time step of the species before the current
+                // time. As in a leapfrog with a variable time step, kick it with the current
+                // fields so that the push below brings it half the new time step after the
+                // current time. (PushP multiplies its time step by m_push_num_steps.)
+                const amrex::Real kick = 0.5_rt*static_cast<amrex::Real>(m_push_num_steps - num_steps)*dt;
+                PushP(lev, kick/static_cast<amrex::Real>(m_push_num_steps), Ex, Ey, Ez, Bx, By, Bz);
+                m_push_num_steps = num_steps;
+            }
+            m_next_push_step = istep + num_steps;
+        }
+        m_num_steps_pushed = (push_this_step && !do_not_push) ? m_push_num_steps : 0;
+        dt *= static_cast<amrex::Real>(m_push_num_steps);
+    }
+
+    // Whether the field gather, particle push and current deposition
+    // are done in a single kernel (see PushPXAndDepositCurrent)
+    const bool fuse_push_deposition = WarpX::do_fused_push_deposition &&
+        canFusePushAndDeposition() && !has_buffer && push_this_step &&
+        push_type == PushType::Explicit && !skip_deposition && !do_not_deposit;
+
+    // Whether the NCI corrector is applied within the field gather of PushPX,
+    // in which case the fields are not filtered here
+    const bool filter_nci = WarpX::use_fdtd_nci_corr &&
+        !(useFusedNCIGather() && push_type == PushType::Explicit && !fuse_push_deposition);
+
+    PrefetchParticleTiles(lev);
+
     if (m_do_back_transformed_particles)
     {
         for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
@@ -2092,7 +2536,7 @@ PhysicalParticleContainer::Evolve (int lev,
 
             Elixir exeli, eyeli, ezeli, bxeli, byeli, bzeli;
 
-            if (WarpX::use_fdtd_nci_corr)
+            if (filter_nci)
             {
                 // Filter arrays Ex[pti], store the result in
                 // filtered_Ex and update pointer exfab so that it
@@ -2147,10 +2591,16 @@ PhysicalParticleContainer::Evolve (int lev,
                 //
                 // Gather and push for particles not in the buffer
                 //
+                const double kernel_start = KernelCounters::Start();
                 WARPX_PROFILE_VAR_START(blp_fg);
-                const auto np_to_push = np_gather;
+                const auto np_to_push = push_this_step ? np_gather : 0;
                 const auto gather_lev = lev;
-                if (push_type == PushType::Explicit) {
+                if (fuse_push_deposition) {
+                    PushPXAndDepositCurrent(pti, exfab, eyfab, ezfab,
+                           bxfab, byfab, bzfab,
+                           Ex.nGrowVect(), &jx, &jy, &jz,
+                           0, np_to_push, thread_num, lev, dt, ScaleFields(false), a_dt_type);
+                } else if (push_type == PushType::Explicit) {
                     PushPX(pti, exfab, eyfab, ezfab,
                            bxfab, byfab, bzfab,
                            Ex.nGrowVect(), e_is_nodal,
@@ -2162,7 +2612,7 @@ PhysicalParticleContainer::Evolve (int lev,
                                    0, np_to_push, lev, gather_lev, dt, ScaleFields(false), a_dt_type);
                 }
 
-                if (np_gather < np)
+                if (push_this_step && np_gather < np)
                 {
                     const IntVect& ref_ratio = WarpX::RefRatio(lev-1);
                     const Box& cbox = amrex::coarsen(box,ref_ratio);
@@ -2175,7 +2625,7 @@ PhysicalParticleContainer::Evolve (int lev,
                     FArrayBox const* cbyfab = &(*cBy)[pti];
                     FArrayBox const* cbzfab = &(*cBz)[pti];
 
-                    if (WarpX::use_fdtd_nci_corr)
+                    if (filter_nci)
                     {
                         // Filter arrays (*cEx)[pti], store the result in
                         // filtered_Ex and update pointer cexfab so that it
@@ -2207,9 +2657,14 @@ PhysicalParticleContainer::Evolve (int lev,
                 }
 
                 WARPX_PROFILE_VAR_STOP(blp_fg);
-
-                // Current Deposition
-                if (!skip_deposition)
+                // position and momentum read and written, 6 field components read
+                // at each stencil point, and about 60 operations for the Boris push
+                KernelCounters::StopParticleKernel(KernelCounters::GatherAndPush, kernel_start,
+                                                   push_this_step ? static_cast<double>(np) : 0.,
+                                                   WarpX::nox, 12., 6., 60.);
+
+                // Current Deposition (already done in the push when fused)
+                if (!skip_deposition && !fuse_push_deposition)
                 {
                     // Deposit at t_{n+1/2} with explicit push
                     const amrex::Real relative_time = (push_type == PushType::Explicit ? -0.5_rt * dt : 0.0_rt);
@@ -2260,6 +2715,9 @@ PhysicalParticleContainer::Evolve (int lev,
             }
         }
     }
+    // With warpx.do_colored_tile_reduction, the current of the tiles is added to J here
+    AddTileCurrents();
+
     // Split particles at the end of the timestep.
     // When subcycling is ON, the splitting is done on the last call to
     // PhysicalParticleContainer::Evolve on the finest level, i.e., at the
@@ -2558,6 +3016,11 @@ PhysicalParticleContainer::PushP (int lev, Real dt,
 
     if (do_not_push) { return; }
 
+    // Species pushed every m_push_every_n_steps steps have a larger time step: the momentum
+    // is synchronized with (or desynchronized from) the positions over half the time step of
+    // the last push (or of the next push, which is corrected in Evolve if it is shorter)
+    dt *= static_cast<amrex::Real>(m_push_num_steps);
+
     const amrex::XDim3 dinv = WarpX::InvCellSize(std::max(lev,0));
 
 #ifdef AMREX_USE_OMP
@@ -2751,9 +3214,6 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti,
     // If no particles, do not do anything
     if (np_to_push == 0) { return; }
 
-    // Get cell size on gather_lev
-    const amrex::XDim3 dinv = WarpX::InvCellSize(std::max(gather_lev,0));
-
     // Get box from which field is gathered.
     // If not gathering from the finest level, the box is coarsened.
     Box box;
@@ -2772,35 +3232,8 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti,
 
     const auto getExternalEB = GetExternalEBField(pti, offset);
 
-    const amrex::ParticleReal Ex_external_particle = m_E_external_particle[0];
-    const amrex::ParticleReal Ey_external_particle = m_E_external_particle[1];
-    const amrex::ParticleReal Ez_external_particle = m_E_external_particle[2];
-    const amrex::ParticleReal Bx_external_particle = m_B_external_particle[0];
-    const amrex::ParticleReal By_external_particle = m_B_external_particle[1];
-    const amrex::ParticleReal Bz_external_particle = m_B_external_particle[2];
-
-    // Lower corner of tile box physical domain (take into account Galilean shift)
-    const amrex::XDim3 xyzmin = WarpX::LowerCorner(box, gather_lev, 0._rt);
-
-    const Dim3 lo = lbound(box);
-
-    const bool galerkin_interpolation = WarpX::galerkin_interpolation;
-    const int nox = WarpX::nox;
-    const int n_rz_azimuthal_modes = WarpX::n_rz_azimuthal_modes;
-
-    amrex::Array4<const amrex::Real> const& ex_arr = exfab->array();
-    amrex::Array4<const amrex::Real> const& ey_arr = eyfab->array();
-    amrex::Array4<const amrex::Real> const& ez_arr = ezfab->array();
-    amrex::Array4<const amrex::Real> const& bx_arr = bxfab->array();
-    amrex::Array4<const amrex::Real> const& by_arr = byfab->array();
-    amrex::Array4<const amrex::Real> const& bz_arr = bzfab->array();
-
-    amrex::IndexType const ex_type = exfab->box().ixType();
-    amrex::IndexType const ey_type = eyfab->box().ixType();
-    amrex::IndexType const ez_type = ezfab->box().ixType();
-    amrex::IndexType const bx_type = bxfab->box().ixType();
-    amrex::IndexType const by_type = byfab->box().ixType();
-    amrex::IndexType const bz_type = bzfab->box().ixType();
+    PushFieldGather gatherFields(exfab, eyfab, ezfab, bxfab, byfab, bzfab, box, gather_lev,
+                                 m_E_external_particle, m_B_external_particle, do_not_gather);
 
     auto& attribs = pti.GetAttribs();
     ParticleReal* const AMREX_RESTRICT ux = attribs[PIdx::ux].dataPtr() + offset;
@@ -2856,10 +3289,22 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti,
     }
 #endif
 
-    const auto t_do_not_gather = do_not_gather;
+#if defined(WARPX_DIM_3D) || defined(WARPX_DIM_XZ)
+    // With the fused NCI corrector, the fields were not filtered in Evolve,
+    // and the Godfrey filter along z is folded into the shape factors of the gather
+    if (useFusedNCIGather()) {
+        const auto& warpx = WarpX::GetInstance();
+        gatherFields.nci_stencil_exeybz = warpx.nci_godfrey_filter_exeybz[gather_lev]->GetSeparableStencil().data[WARPX_ZINDEX];
+        gatherFields.nci_stencil_bxbyez = warpx.nci_godfrey_filter_bxbyez[gather_lev]->GetSeparableStencil().data[WARPX_ZINDEX];
+    }
+#endif
+
+    amrex::Vector<amrex::ParticleReal> gathered_fields_buffer;
+    gatherFields.gatherSimd(getPosition, np_to_push, gathered_fields_buffer);
 
     enum exteb_flags : int { no_exteb, has_exteb };
     enum qed_flags : int { no_qed, has_qed };
+    enum ion_flags : int { no_ion, has_ion };
 
     const int exteb_runtime_flag = getExternalEB.isNoOp() ? no_exteb : has_exteb;
 #ifdef WARPX_QED
@@ -2867,15 +3312,25 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti,
 #else
     int qed_runtime_flag = no_qed;
 #endif
+    const int ion_runtime_flag = ion_lev ? has_ion : no_ion;
+    const int pusher_runtime_flag = getPushKernelPusher(pusher_algo, do_crr);
 
     // Using this version of ParallelFor with compile time options
-    // improves performance when qed or external EB are not used by reducing
-    // register pressure.
+    // improves performance when qed, external EB or ionization are not used
+    // by reducing register pressure. The pusher is also selected at compile
+    // time, so that each kernel only contains one pusher.
     amrex::ParallelFor(
-        TypeList<CompileTimeOptions<no_exteb,has_exteb>, CompileTimeOptions<no_qed  ,has_qed>>{},
-        {exteb_runtime_flag, qed_runtime_flag},
+        TypeList<CompileTimeOptions<no_exteb,has_exteb>,
+                 CompileTimeOptions<no_qed  ,has_qed>,
+                 CompileTimeOptions<no_ion  ,has_ion>,
+                 CompileTimeOptions<PushKernelPusher::Boris,
+                                    PushKernelPusher::Vay,
+                                    PushKernelPusher::HigueraCary,
+                                    PushKernelPusher::RadiationReaction>>{},
+        {exteb_runtime_flag, qed_runtime_flag, ion_runtime_flag, pusher_runtime_flag},
         np_to_push,
-        [=] AMREX_GPU_DEVICE (long ip, auto exteb_control, auto qed_control)
+        [=] AMREX_GPU_DEVICE (long ip, auto exteb_control, auto qed_control,
+                              auto ion_control, auto pusher_control)
     {
         amrex::ParticleReal xp, yp, zp;
         getPosition(ip, xp, yp, zp);
@@ -2890,21 +3345,9 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti,
             z_old[ip] = zp;
         }
 
-        amrex::ParticleReal Exp = Ex_external_particle;
-        amrex::ParticleReal Eyp = Ey_external_particle;
-        amrex::ParticleReal Ezp = Ez_external_particle;
-        amrex::ParticleReal Bxp = Bx_external_particle;
-        amrex::ParticleReal Byp = By_external_particle;
-        amrex::ParticleReal Bzp = Bz_external_particle;
-
-        if(!t_do_not_gather){
-            // first gather E and B to the particle positions
-            doGatherShapeN(xp, yp, zp, Exp, Eyp, Ezp, Bxp, Byp, Bzp,
-                           ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
-                           ex_type, ey_type, ez_type, bx_type, by_type, bz_type,
-                           dinv, xyzmin, lo, n_rz_azimuthal_modes,
-                           nox, galerkin_interpolation);
-        }
+        // first gather E and B to the particle positions
+        amrex::ParticleReal Exp, Eyp, Ezp, Bxp, Byp, Bzp;
+        gatherFields(ip, xp, yp, zp, Exp, Eyp, Ezp, Bxp, Byp, Bzp);
 
         [[maybe_unused]] const auto& getExternalEB_tmp = getExternalEB;
         if constexpr (exteb_control == has_exteb) {
@@ -2913,6 +3356,13 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti,
 
         scaleFields(xp, yp, zp, Exp, Eyp, Ezp, Bxp, Byp, Bzp);
 
+        // Charge of the particle. The ionization level is only loaded for ionizable species.
+        [[maybe_unused]] auto* const ion_lev_tmp = ion_lev;
+        auto qp = [&] (long i) -> amrex::ParticleReal {
+            if constexpr (ion_control == has_ion) { return q * ion_lev_tmp[i]; }
+            else { amrex::ignore_unused(i); return q; }
+        };
+
 #ifdef WARPX_QED
         if (!do_sync)
 #endif
@@ -2922,16 +3372,15 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti,
                 copyAttribs(ip);
             }
 
-            doParticleMomentumPush<0>(ux[ip], uy[ip], uz[ip],
-                                      Exp, Eyp, Ezp, Bxp, Byp, Bzp,
-                                      ion_lev ? ion_lev[ip] : 1,
-                                      m, q, pusher_algo, do_crr,
+            doParticlePushPX<0, pusher_control, exteb_control == has_exteb>(
+                getExternalEB, xp, yp, zp, ux[ip], uy[ip], uz[ip],
+                Exp, Eyp, Ezp, Bxp, Byp, Bzp, qp(ip), m,
 #ifdef WARPX_QED
-                                      t_chi_max,
+                t_chi_max,
+#else
+                0.0_rt,
 #endif
-                                      dt);
-
-            UpdatePosition(xp, yp, zp, ux[ip], uy[ip], uz[ip], dt);
+                dt);
             setPosition(ip, xp, yp, zp);
         }
 #ifdef WARPX_QED
@@ -2942,14 +3391,9 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti,
                     copyAttribs(ip);
                 }
 
-                doParticleMomentumPush<1>(ux[ip], uy[ip], uz[ip],
-                                          Exp, Eyp, Ezp, Bxp, Byp, Bzp,
-                                          ion_lev ? ion_lev[ip] : 1,
-                                          m, q, pusher_algo, do_crr,
-                                          t_chi_max,
-                                          dt);
-
-                UpdatePosition(xp, yp, zp, ux[ip], uy[ip], uz[ip], dt);
+                doParticlePushPX<1, pusher_control, false>(
+                    getExternalEB, xp, yp, zp, ux[ip], uy[ip], uz[ip],
+                    Exp, Eyp, Ezp, Bxp, Byp, Bzp, qp(ip), m, t_chi_max, dt);
                 setPosition(ip, xp, yp, zp);
             }
         }
@@ -2972,6 +3416,247 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti,
     });
 }
 
+bool
+PhysicalParticleContainer::canFusePushAndDeposition () const
+{
+    // The quantum synchrotron process requires a separate push (see PushPX)
+    return !has_quantum_sync();
+}
+
+bool
+PhysicalParticleContainer::useFusedNCIGather () const
+{
+    return WarpX::use_fdtd_nci_corr && WarpX::use_fdtd_nci_corr_fused_gather;
+}
+
+void
+PhysicalParticleContainer::PushPXAndDepositCurrent (WarpXParIter& pti,
+                                                    amrex::FArrayBox const * exfab,
+                                                    amrex::FArrayBox const * eyfab,
+                                                    amrex::FArrayBox const * ezfab,
+                                                    amrex::FArrayBox const * bxfab,
+                                                    amrex::FArrayBox const * byfab,
+                                                    amrex::FArrayBox const * bzfab,
+                                                    const amrex::IntVect ngEB,
+                                                    amrex::MultiFab * const jx,
+                                                    amrex::MultiFab * const jy,
+                                                    amrex::MultiFab * const jz,
+                                                    const long offset,
+                                                    const long np_to_push,
+                                                    [[maybe_unused]] const int thread_num,
+                                                    int lev,
+                                                    amrex::Real dt, ScaleFields scaleFields,
+                                                    DtType a_dt_type)
+{
+    WARPX_PROFILE("PhysicalParticleContainer::PushPXAndDepositCurrent()");
+
+    // If no particles, do not do anything
+    if (np_to_push == 0) { return; }
+
+    // Get cell size
+    const amrex::XDim3 dinv = WarpX::InvCellSize(std::max(lev,0));
+
+    // Box from which the field is gathered, including guard cells
+    Box box = pti.tilebox();
+    box.grow(ngEB);
+
+    const auto getPosition = GetParticlePosition<PIdx>(pti, offset);
+          auto setPosition = SetParticlePosition<PIdx>(pti, offset);
+
+    const auto getExternalEB = GetExternalEBField(pti, offset);
+
+    // The fields are filtered in Evolve when the NCI corrector is used (see useFusedNCIGather)
+    PushFieldGather gatherFields(exfab, eyfab, ezfab, bxfab, byfab, bzfab, box, lev,
+                                 m_E_external_particle, m_B_external_particle, do_not_gather);
+
+    const int nox = WarpX::nox;
+    const int n_rz_azimuthal_modes = WarpX::n_rz_azimuthal_modes;
+
+    // Tile box where the current is deposited, including guard cells
+    const amrex::IntVect& ng_J = WarpX::GetInstance().get_ng_depos_J();
+    Box depos_box = pti.tilebox();
+#ifndef AMREX_USE_GPU
+    // CPU, tiling: deposit on the local_j<xyz>[thread_num] arrays
+    Box tbx = convert( depos_box, jx->ixType().toIntVect() );
+    Box tby = convert( depos_box, jy->ixType().toIntVect() );
+    Box tbz = convert( depos_box, jz->ixType().toIntVect() );
+    tbx.grow(ng_J);
+    tby.grow(ng_J);
+    tbz.grow(ng_J);
+
+    local_jx[thread_num].resize(tbx, jx->nComp());
+    local_jy[thread_num].resize(tby, jy->nComp());
+    local_jz[thread_num].resize(tbz, jz->nComp());
+
+    local_jx[thread_num].setVal(0.0);
+    local_jy[thread_num].setVal(0.0);
+    local_jz[thread_num].setVal(0.0);
+
+    Array4<Real> const& jx_arr = local_jx[thread_num].array();
+    Array4<Real> const& jy_arr = local_jy[thread_num].array();
+    Array4<Real> const& jz_arr = local_jz[thread_num].array();
+#else
+    // GPU, no tiling: deposit directly on the full j<xyz> arrays
+    Array4<Real> const& jx_arr = jx->array(pti);
+    Array4<Real> const& jy_arr = jy->array(pti);
+    Array4<Real> const& jz_arr = jz->array(pti);
+#endif
+    depos_box.grow(ng_J);
+
+    amrex::IntVect const jx_type = jx->ixType().toIntVect();
+    amrex::IntVect const jy_type = jy->ixType().toIntVect();
+    amrex::IntVect const jz_type = jz->ixType().toIntVect();
+
+    // Lower corner of the deposition box (take into account Galilean shift)
+    const Dim3 depos_lo = lbound(depos_box);
+    const amrex::XDim3 depos_xyzmin = WarpX::LowerCorner(depos_box, lev, 0.5_rt*dt);
+
+    const amrex::Real invvol = dinv.x*dinv.y*dinv.z;
+    amrex::XDim3 const invdtd = amrex::XDim3{(1.0_rt/dt)*dinv.y*dinv.z,
+                                             (1.0_rt/dt)*dinv.x*dinv.z,
+                                             (1.0_rt/dt)*dinv.x*dinv.y};
+
+    // Deposit at t_{n+1/2}, i.e. half a step before the pushed positions
+    const amrex::Real relative_time = -0.5_rt * dt;
+
+    auto& attribs = pti.GetAttribs();
+    const ParticleReal* const AMREX_RESTRICT wp = attribs[PIdx::w].dataPtr() + offset;
+    ParticleReal* const AMREX_RESTRICT ux = attribs[PIdx::ux].dataPtr() + offset;
+    ParticleReal* const AMREX_RESTRICT uy = attribs[PIdx::uy].dataPtr() + offset;
+    ParticleReal* const AMREX_RESTRICT uz = attribs[PIdx::uz].dataPtr() + offset;
+
+    const int do_copy = (m_do_back_transformed_particles && (a_dt_type!=DtType::SecondHalf) );
+    CopyParticleAttribs copyAttribs;
+    if (do_copy) {
+        copyAttribs = CopyParticleAttribs(pti, tmp_particle_data, offset);
+    }
+
+    int* AMREX_RESTRICT ion_lev = nullptr;
+    if (do_field_ionization) {
+        ion_lev = pti.GetiAttribs(particle_icomps["ionizationLevel"]).dataPtr() + offset;
+    }
+
+    const bool save_previous_position = m_save_previous_position;
+    ParticleReal* x_old = nullptr;
+    ParticleReal* y_old = nullptr;
+    ParticleReal* z_old = nullptr;
+    if (save_previous_position) {
+#if (AMREX_SPACEDIM >= 2)
+        x_old = pti.GetAttribs(particle_comps["prev_x"]).dataPtr() + offset;
+#else
+    amrex::ignore_unused(x_old);
+#endif
+#if defined(WARPX_DIM_3D)
+        y_old = pti.GetAttribs(particle_comps["prev_y"]).dataPtr() + offset;
+#else
+    amrex::ignore_unused(y_old);
+#endif
+        z_old = pti.GetAttribs(particle_comps["prev_z"]).dataPtr() + offset;
+    }
+
+    const amrex::ParticleReal q = this->charge;
+    const amrex::ParticleReal m = this-> mass;
+
+    const auto pusher_algo = WarpX::particle_pusher_algo;
+    const auto do_crr = do_classical_radiation_reaction;
+
+    amrex::Vector<amrex::ParticleReal> gathered_fields_buffer;
+    gatherFields.gatherSimd(getPosition, np_to_push, gathered_fields_buffer);
+
+    enum exteb_flags : int { no_exteb, has_exteb };
+    enum depos_flags : int { direct_depos, esirkepov_depos };
+
+    const int exteb_runtime_flag = getExternalEB.isNoOp() ? no_exteb : has_exteb;
+    const int pusher_runtime_flag = getPushKernelPusher(pusher_algo, do_crr);
+    const int depos_runtime_flag =
+        (WarpX::current_deposition_algo == CurrentDepositionAlgo::Esirkepov) ?
+        esirkepov_depos : direct_depos;
+
+    // Each particle is loaded once: its fields are gathered, it is pushed,
+    // and its current is deposited from the updated position and momentum.
+    // As in PushPX, the pusher is selected at compile time, and on CPU the
+    // fields may be gathered beforehand for blocks of particles.
+    amrex::ParallelFor(
+        TypeList<CompileTimeOptions<no_exteb,has_exteb>,
+                 CompileTimeOptions<PushKernelPusher::Boris,
+                                    PushKernelPusher::Vay,
+                                    PushKernelPusher::HigueraCary,
+                                    PushKernelPusher::RadiationReaction>,
+                 CompileTimeOptions<1,2,3,4>,
+                 CompileTimeOptions<direct_depos,esirkepov_depos>>{},
+        {exteb_runtime_flag, pusher_runtime_flag, nox, depos_runtime_flag},
+        np_to_push,
+        [=] AMREX_GPU_DEVICE (long ip, auto exteb_control, auto pusher_control,
+                              auto depos_order_control, auto depos_control)
+    {
+        amrex::ParticleReal xp, yp, zp;
+        getPosition(ip, xp, yp, zp);
+
+        if (save_previous_position) {
+#if (AMREX_SPACEDIM >= 2)
+            x_old[ip] = xp;
+#endif
+#if defined(WARPX_DIM_3D)
+            y_old[ip] = yp;
+#endif
+            z_old[ip] = zp;
+        }
+
+        // first gather E and B to the particle positions
+        amrex::ParticleReal Exp, Eyp, Ezp, Bxp, Byp, Bzp;
+        gatherFields(ip, xp, yp, zp, Exp, Eyp, Ezp, Bxp, Byp, Bzp);
+
+        [[maybe_unused]] const auto& getExternalEB_tmp = getExternalEB;
+        if constexpr (exteb_control == has_exteb) {
+            getExternalEB(ip, Exp, Eyp, Ezp, Bxp, Byp, Bzp);
+        }
+
+        scaleFields(xp, yp, zp, Exp, Eyp, Ezp, Bxp, Byp, Bzp);
+
+        if (do_copy) {
+            //  Copy the old x and u for the BTD
+            copyAttribs(ip);
+        }
+
+        amrex::ParticleReal uxp = ux[ip];
+        amrex::ParticleReal uyp = uy[ip];
+        amrex::ParticleReal uzp = uz[ip];
+        const int ion_lev_p = ion_lev ? ion_lev[ip] : 1;
+
+        doParticlePushPX<0, pusher_control, exteb_control == has_exteb>(
+            getExternalEB, xp, yp, zp, uxp, uyp, uzp,
+            Exp, Eyp, Ezp, Bxp, Byp, Bzp, q*ion_lev_p, m, 0.0_rt, dt);
+        setPosition(ip, xp, yp, zp);
+        ux[ip] = uxp;
+        uy[ip] = uyp;
+        uz[ip] = uzp;
+
+        // Deposit the current from the values that are still in registers
+        const amrex::Real wq = q*wp[ip]*ion_lev_p;
+        constexpr int depos_order = decltype(depos_order_control)::value;
+        if constexpr (depos_control == esirkepov_depos) {
+            doEsirkepovDepositionShapeNKernel<depos_order>(
+                xp, yp, zp, wq, uxp, uyp, uzp,
+                jx_arr, jy_arr, jz_arr, dt, relative_time,
+                dinv, depos_xyzmin, invdtd, depos_lo, n_rz_azimuthal_modes);
+        } else {
+            constexpr amrex::ParticleReal inv_c2 = 1._prt/(PhysConst::c*PhysConst::c);
+            const amrex::Real gaminv = 1.0_rt/std::sqrt(1.0_rt + (uxp*uxp + uyp*uyp + uzp*uzp)*inv_c2);
+            doDepositionShapeNKernel<depos_order>(
+                xp, yp, zp, wq, uxp*gaminv, uyp*gaminv, uzp*gaminv,
+                jx_arr, jy_arr, jz_arr, jx_type, jy_type, jz_type,
+                relative_time, dinv, depos_xyzmin, invvol, depos_lo, n_rz_azimuthal_modes);
+        }
+    });
+
+#ifndef AMREX_USE_GPU
+    // CPU, tiling: atomicAdd local_j<xyz> into j<xyz>
+    (*jx)[pti].lockAdd(local_jx[thread_num], tbx, tbx, 0, 0, jx->nComp());
+    (*jy)[pti].lockAdd(local_jy[thread_num], tby, tby, 0, 0, jy->nComp());
+    (*jz)[pti].lockAdd(local_jz[thread_num], tbz, tbz, 0, 0, jz->nComp());
+#endif
+}
+
 /* \brief Perform the implicit particle push operation in one fused kernel
  *        The main difference from PushPX is the order of operations:
  *         - push position by 1/2 dt
@@ -3299,6 +3984,10 @@ PhysicalParticleContainer::InitIonizationModule ()
         charge = PhysConst::q_e;
     }
     utils::parser::queryWithParser(pp_species_name, "do_adk_correction", do_adk_correction);
+    utils::parser::queryWithParser(pp_species_name, "ionization_table_size", ionization_table_size);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        ionization_table_size == 0 || ionization_table_size >= 2,
+        species_name + ".ionization_table_size must be 0 (no table) or at least 2");
 
     utils::parser::queryWithParser(
         pp_species_name, "ionization_initial_level", ionization_initial_level);
@@ -3368,6 +4057,42 @@ PhysicalParticleContainer::InitIonizationModule ()
         p_adk_exp_prefactor[i] = -2._rt/3._rt * std::pow( Uion/UH,3._rt/2._rt) * Ea;
     });
 
+    if (ionization_table_size > 0) {
+        // Table of the log of the ionization rate (the probability over dt) vs. log(E).
+        // Its range, for each ionization level, covers -exp_prefactor/100 < E < -exp_prefactor*100,
+        // where the exponential factor of the rate goes from exp(-100) to about 1.
+        // Outside of this range, the rate is computed without the table.
+        const int n_table = ionization_table_size;
+        ionization_log_rate_table.resize(static_cast<std::size_t>(ion_atomic_number)*n_table);
+        ionization_table_log_E_lo.resize(ion_atomic_number);
+        ionization_table_inv_dlog_E.resize(ion_atomic_number);
+        Real * AMREX_RESTRICT p_table = ionization_log_rate_table.data();
+        Real * AMREX_RESTRICT p_log_E_lo = ionization_table_log_E_lo.data();
+        Real * AMREX_RESTRICT p_inv_dlog_E = ionization_table_inv_dlog_E.data();
+        Real const* AMREX_RESTRICT p_correction_factors = adk_correction_factors.data();
+        const int loc_do_adk_correction = do_adk_correction;
+        amrex::ParallelFor(ion_atomic_number, [=] AMREX_GPU_DEVICE (int i) noexcept
+        {
+            const Real E_scale = -p_adk_exp_prefactor[i];
+            const Real log_E_lo = std::log(E_scale) - std::log(100._rt);
+            const Real dlog_E = 2._rt*std::log(100._rt)/static_cast<Real>(n_table - 1);
+            p_log_E_lo[i] = log_E_lo;
+            p_inv_dlog_E[i] = 1._rt/dlog_E;
+            for (int k = 0; k < n_table; ++k) {
+                const Real log_E = log_E_lo + static_cast<Real>(k)*dlog_E;
+                const Real E = std::exp(log_E);
+                Real log_rate = std::log(p_adk_prefactor[i]/dt) + p_adk_power[i]*log_E
+                    + p_adk_exp_prefactor[i]/E;
+                if (loc_do_adk_correction) {
+                    const Real r = E / p_correction_factors[3];
+                    log_rate += p_correction_factors[0]*r*r + p_correction_factors[1]*r
+                        + p_correction_factors[2];
+                }
+                p_table[i*n_table + k] = log_rate;
+            }
+        });
+    }
+
     Gpu::synchronize();
 }
 
@@ -3384,7 +4109,7 @@ PhysicalParticleContainer::getIonizationFunc (const WarpXParIter& pti,
 {
     WARPX_PROFILE("PhysicalParticleContainer::getIonizationFunc()");
 
-    return {pti, lev, ngEB, Ex, Ey, Ez, Bx, By, Bz,
+    IonizationFilterFunc filter{pti, lev, ngEB, Ex, Ey, Ez, Bx, By, Bz,
                                 m_E_external_particle, m_B_external_particle,
                                 ionization_energies.dataPtr(),
                                 adk_prefactor.dataPtr(),
@@ -3394,6 +4119,15 @@ PhysicalParticleContainer::getIonizationFunc (const WarpXParIter& pti,
                                 particle_icomps["ionizationLevel"],
                                 ion_atomic_number,
                                 do_adk_correction};
+    if (ionization_table_size > 0) {
+        // the table holds the rate: the probability uses the current time step of this level
+        filter.setRateTable(ionization_log_rate_table.dataPtr(),
+                            ionization_table_log_E_lo.dataPtr(),
+                            ionization_table_inv_dlog_E.dataPtr(),
+                            ionization_table_size,
+                            WarpX::GetInstance().getdt(lev));
+    }
+    return filter;
 }
 
 PlasmaInjector* PhysicalParticleContainer::GetPlasmaInjector (int i)
@@ -3440,6 +4174,57 @@ void PhysicalParticleContainer::resample (const int timestep, const bool verbose
             );
         }
     }
+    else if (m_resampler.getTrigger().hasLocalTriggers())
+    {
+        // Local triggers: only the tiles that are too large, or the largest tiles of the
+        // processes that are short of device memory, are resampled
+        const ResamplingTrigger& trigger = m_resampler.getTrigger();
+        const bool memory_pressure = trigger.memoryPressure();
+        auto mean_tile_numparts = [&] () {
+            amrex::Long numparts = 0, numtiles = 0;
+            for (int lev = 0; lev <= maxLevel(); lev++) {
+                for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti) {
+                    numparts += pti.numParticles();
+                    ++numtiles;
+                }
+            }
+            return (numtiles > 0) ? static_cast<amrex::Real>(numparts)/static_cast<amrex::Real>(numtiles) : amrex::Real(0.0);
+        };
+
+        amrex::Real mean_numparts = mean_tile_numparts();
+        bool any_tile_triggered = false;
+        for (int lev = 0; lev <= maxLevel(); lev++) {
+            for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti) {
+                any_tile_triggered = any_tile_triggered ||
+                    trigger.tileTriggered(pti.numParticles(), mean_numparts, memory_pressure);
+            }
+        }
+        // Redistribute is collective
+        amrex::ParallelDescriptor::ReduceBoolOr(any_tile_triggered);
+
+        if (any_tile_triggered)
+        {
+            Redistribute();
+            mean_numparts = mean_tile_numparts();
+            for (int lev = 0; lev <= maxLevel(); lev++)
+            {
+                for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
+                {
+                    if (trigger.tileTriggered(pti.numParticles(), mean_numparts, memory_pressure)) {
+                        m_resampler(pti, lev, this);
+                    }
+                }
+            }
+            deleteInvalidParticles();
+            if (verbose) {
+                amrex::Print() << Utils::TextMsg::Info(
+                    "Resampled the largest tiles of " + species_name + " at step " + std::to_string(timestep)
+                    + ": macroparticle count decreased by "
+                    + std::to_string(static_cast<int>(global_numparts - TotalNumberOfParticles()))
+                );
+            }
+        }
+    }
     WARPX_PROFILE_VAR_STOP(blp_resample_actual);
 }
 
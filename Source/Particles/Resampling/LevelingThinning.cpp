@@ -17,6 +17,8 @@
 #include <AMReX_BLassert.H>
 #include <AMReX_DenseBins.H>
 #include <AMReX_Extension.H>
+#include <AMReX_GpuAtomic.H>
+#include <AMReX_GpuContainers.H>
 #include <AMReX_GpuLaunch.H>
 #include <AMReX_GpuQualifiers.H>
 #include <AMReX_PODVector.H>
@@ -25,6 +27,7 @@
 #include <AMReX_ParticleTile.H>
 #include <AMReX_Particles.H>
 #include <AMReX_Random.H>
+#include <AMReX_Reduce.H>
 #include <AMReX_StructOfArrays.H>
 
 #include <AMReX_BaseFwd.H>
@@ -51,6 +54,11 @@ LevelingThinning::LevelingThinning (const std::string& species_name)
     BackwardCompatibility(species_name);
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_min_ppc >= 1,
                                      "Resampling min_ppc should be greater than or equal to 1");
+
+    utils::parser::queryWithParser(
+        pp_species_name, "resampling_algorithm_heavy_cell_ppc", m_heavy_cell_ppc);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_heavy_cell_ppc >= 1,
+                                     "Resampling heavy_cell_ppc should be greater than or equal to 1");
 }
 
 void LevelingThinning::BackwardCompatibility (const std::string& species_name )
@@ -79,7 +87,7 @@ void LevelingThinning::operator() (WarpXParIter& pti, const int lev,
     // efficient to directly loop over the particles. Nevertheless, this structure with a loop over
     // the cells is more general and can be readily used to implement almost any other resampling
     // algorithm.
-    auto bins = ParticleUtils::findParticlesInEachCell(lev, pti, ptile);
+    auto& bins = pc->getCellBins(lev, pti);
 
     const auto n_cells = static_cast<int>(bins.numBins());
     auto *const indices = bins.permutationPtr();
@@ -87,6 +95,15 @@ void LevelingThinning::operator() (WarpXParIter& pti, const int lev,
 
     const amrex::Real target_ratio = m_target_ratio;
     const int min_ppc = m_min_ppc;
+    const int heavy_cell_ppc = m_heavy_cell_ppc;
+
+    // Count the heavy cells, which are thinned with one thread per particle below
+    const int n_heavy_cells = amrex::Reduce::Sum<int>(n_cells,
+        [=] AMREX_GPU_DEVICE (int i_cell) noexcept -> int
+        {
+            const auto cell_numparts = static_cast<int>(cell_offsets[i_cell+1] - cell_offsets[i_cell]);
+            return (cell_numparts >= heavy_cell_ppc && cell_numparts >= min_ppc) ? 1 : 0;
+        });
 
     // Loop over cells
     amrex::ParallelForRNG( n_cells,
@@ -103,6 +120,10 @@ void LevelingThinning::operator() (WarpXParIter& pti, const int lev,
             if (cell_numparts < min_ppc) {
                 return;
             }
+            // heavy cells are done below
+            if (cell_numparts >= heavy_cell_ppc) {
+                return;
+            }
             amrex::Real average_weight = 0._rt;
 
             // First loop over cell particles to compute average particle weight in the cell
@@ -135,4 +156,50 @@ void LevelingThinning::operator() (WarpXParIter& pti, const int lev,
             }
         }
     );
+
+    if (n_heavy_cells == 0) { return; }
+
+    // Heavy cells: the weights of their particles are first summed with one
+    // thread per particle, and each particle then does its own Bernoulli trial
+    const auto np = static_cast<int>(bins.numItems());
+    auto *const particle_cells = bins.binsPtr();
+    amrex::Gpu::DeviceVector<amrex::Real> cell_weight(n_cells, 0._rt);
+    amrex::Real *const AMREX_RESTRICT p_cell_weight = cell_weight.dataPtr();
+
+    amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (int ip) noexcept
+    {
+        const auto i_cell = static_cast<int>(particle_cells[ip]);
+        const auto cell_numparts = static_cast<int>(cell_offsets[i_cell+1] - cell_offsets[i_cell]);
+        if (cell_numparts >= heavy_cell_ppc && cell_numparts >= min_ppc) {
+            amrex::Gpu::Atomic::AddNoRet(&p_cell_weight[i_cell], amrex::Real(w[ip]));
+        }
+    });
+
+    amrex::ParallelForRNG(np,
+        [=] AMREX_GPU_DEVICE (int ip, amrex::RandomEngine const& engine) noexcept
+        {
+            const auto i_cell = static_cast<int>(particle_cells[ip]);
+            const auto cell_numparts = static_cast<int>(cell_offsets[i_cell+1] - cell_offsets[i_cell]);
+            if (cell_numparts < heavy_cell_ppc || cell_numparts < min_ppc) { return; }
+
+            const amrex::Real level_weight = p_cell_weight[i_cell]/cell_numparts*target_ratio;
+
+            // Particles with weight greater than level_weight are left unchanged
+            if (w[ip] > level_weight) { return; }
+
+            amrex::Real const random_number = amrex::Random(engine);
+            // Remove particle with probability 1 - particle_weight/level_weight
+            if (random_number > w[ip]/level_weight)
+            {
+                idcpu[ip] = amrex::ParticleIdCpus::Invalid;
+            }
+            // Set particle weight to level weight otherwise
+            else
+            {
+                w[ip] = level_weight;
+            }
+        }
+    );
+    // cell_weight goes out of scope
+    amrex::Gpu::streamSynchronize();
 }
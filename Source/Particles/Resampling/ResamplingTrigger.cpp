@@ -7,9 +7,11 @@
 #include "ResamplingTrigger.H"
 
 #include "Utils/Parser/ParserUtils.H"
+#include "Utils/TextMsg.H"
 #include "WarpX.H"
 
 #include <AMReX_BoxArray.H>
+#include <AMReX_GpuDevice.H>
 #include <AMReX_ParmParse.H>
 
 #include <vector>
@@ -24,6 +26,17 @@ ResamplingTrigger::ResamplingTrigger (const std::string& species_name)
 
     utils::parser::queryWithParser(
         pp_species_name, "resampling_trigger_max_avg_ppc", m_max_avg_ppc);
+
+    utils::parser::queryWithParser(
+        pp_species_name, "resampling_trigger_max_tile_particles", m_max_tile_particles);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_max_tile_particles > 0,
+        "resampling_trigger_max_tile_particles must be positive");
+
+    utils::parser::queryWithParser(
+        pp_species_name, "resampling_trigger_min_free_memory_fraction", m_min_free_memory_fraction);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        m_min_free_memory_fraction >= amrex::Real(0.0) && m_min_free_memory_fraction < amrex::Real(1.0),
+        "resampling_trigger_min_free_memory_fraction must be in [0, 1)");
 }
 
 bool ResamplingTrigger::triggered (const int timestep, const amrex::Real global_numparts) const
@@ -35,6 +48,32 @@ bool ResamplingTrigger::triggered (const int timestep, const amrex::Real global_
             avg_ppc > m_max_avg_ppc);
 }
 
+bool ResamplingTrigger::hasLocalTriggers () const
+{
+    return m_max_tile_particles < std::numeric_limits<amrex::Long>::max() ||
+           m_min_free_memory_fraction > amrex::Real(0.0);
+}
+
+bool ResamplingTrigger::memoryPressure () const
+{
+#ifdef AMREX_USE_GPU
+    if (m_min_free_memory_fraction > amrex::Real(0.0)) {
+        const auto free_memory = static_cast<amrex::Real>(amrex::Gpu::Device::freeMemAvailable());
+        const auto total_memory = static_cast<amrex::Real>(amrex::Gpu::Device::totalGlobalMem());
+        return free_memory < m_min_free_memory_fraction*total_memory;
+    }
+#endif
+    return false;
+}
+
+bool ResamplingTrigger::tileTriggered (const amrex::Long tile_numparts,
+                                       const amrex::Real mean_tile_numparts,
+                                       const bool memory_pressure) const
+{
+    return tile_numparts > m_max_tile_particles ||
+           (memory_pressure && static_cast<amrex::Real>(tile_numparts) > mean_tile_numparts);
+}
+
 void ResamplingTrigger::initialize_global_numcells () const
 {
     auto & warpx = WarpX::GetInstance();
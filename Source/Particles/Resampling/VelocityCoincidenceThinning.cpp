@@ -85,7 +85,7 @@ void VelocityCoincidenceThinning::operator() (WarpXParIter& pti, const int lev,
     auto * const AMREX_RESTRICT idcpu = soa.GetIdCPUData().data();
 
     // Using this function means that we must loop over the cells in the ParallelFor.
-    auto bins = ParticleUtils::findParticlesInEachCell(lev, pti, ptile);
+    auto& bins = pc->getCellBins(lev, pti);
 
     const auto n_cells = static_cast<int>(bins.numBins());
     auto *const indices = bins.permutationPtr();
@@ -95,11 +95,8 @@ void VelocityCoincidenceThinning::operator() (WarpXParIter& pti, const int lev,
     const auto cluster_weight = m_cluster_weight;
     const auto mass = pc->getMass();
 
-    // check if species mass > 0
-    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
-        mass > 0,
-        "VelocityCoincidenceThinning does not yet work for massless particles."
-    );
+    // For photons, the momenta are normalized by the electron mass
+    const bool is_massless = (mass == 0._prt);
 
     // create a GPU vector to hold the momentum cluster index for each particle
     amrex::Gpu::DeviceVector<int> momentum_bin_number(n_parts_in_tile);
@@ -211,8 +208,9 @@ void VelocityCoincidenceThinning::operator() (WarpXParIter& pti, const int lev,
                 cluster_uy += w[part_idx]*uy[part_idx];
                 cluster_uz += w[part_idx]*uz[part_idx];
                 total_weight += w[part_idx];
-                total_energy += w[part_idx] * Algorithms::KineticEnergy(
-                    ux[part_idx], uy[part_idx], uz[part_idx], mass
+                total_energy += w[part_idx] * (is_massless ?
+                    Algorithms::KineticEnergyPhotons(ux[part_idx], uy[part_idx], uz[part_idx]) :
+                    Algorithms::KineticEnergy(ux[part_idx], uy[part_idx], uz[part_idx], mass)
                 );
 
                 // check if this is the last particle in the current momentum bin,
@@ -244,11 +242,14 @@ void VelocityCoincidenceThinning::operator() (WarpXParIter& pti, const int lev,
                         auto cluster_u_mag = std::sqrt(cluster_u_mag2);
 
                         // calculate required velocity magnitude to achieve
-                        // energy conservation
-                        auto v_mag2 = total_energy / total_weight * (
-                            (total_energy / total_weight + 2._prt * mass * c2 )
-                            / (mass * mass * c2)
-                        );
+                        // energy conservation (for photons, E = m_e c |u|)
+                        constexpr auto me_c = PhysConst::m_e * PhysConst::c;
+                        auto v_mag2 = is_massless ?
+                            (total_energy / total_weight / me_c) * (total_energy / total_weight / me_c) :
+                            total_energy / total_weight * (
+                                (total_energy / total_weight + 2._prt * mass * c2 )
+                                / (mass * mass * c2)
+                            );
                         auto v_perp = (v_mag2 > cluster_u_mag2) ? std::sqrt(v_mag2 - cluster_u_mag2) : 0_prt;
 
                         // choose random angle for new velocity vector
@@ -19,6 +19,7 @@
 #include "Pusher/UpdateMomentumVay.H"
 #include "RigidInjectedParticleContainer.H"
 #include "Utils/Parser/ParserUtils.H"
+#include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXConst.H"
 #include "Utils/WarpXProfilerWrapper.H"
@@ -46,12 +47,14 @@
 #include <AMReX_PODVector.H>
 #include <AMReX_ParIter.H>
 #include <AMReX_ParmParse.H>
+#include <AMReX_Reduce.H>
 #include <AMReX_Particles.H>
 #include <AMReX_StructOfArrays.H>
 
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <limits>
 #include <map>
 
 using namespace amrex;
@@ -67,6 +70,8 @@ RigidInjectedParticleContainer::RigidInjectedParticleContainer (AmrCore* amr_cor
         pp_species_name, "zinject_plane", zinject_plane);
     pp_species_name.query("rigid_advance", rigid_advance);
 
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_push_every_n_steps == 1,
+        species_name + ".push_every_n_steps > 1 is not supported for rigid-injected species");
 }
 
 void RigidInjectedParticleContainer::InitData()
@@ -188,6 +193,43 @@ RigidInjectedParticleContainer::PushPX (WarpXParIter& pti,
     amrex::ParticleReal* const AMREX_RESTRICT uy = uyp.dataPtr() + offset;
     amrex::ParticleReal* const AMREX_RESTRICT uz = uzp.dataPtr() + offset;
 
+    const amrex::ParticleReal z_plane_lev = zinject_plane_lev;
+    const amrex::ParticleReal vz_ave_boosted = vzbeam_ave_boosted;
+    const bool rigid = rigid_advance;
+    constexpr amrex::ParticleReal inv_csq = 1._prt/(PhysConst::c*PhysConst::c);
+
+    if (!done_injecting_lev && np_to_push > 0)
+    {
+        // Particles travel less than c*dt: if all the particles of the tile are far enough
+        // before the injection plane, none of them is injected at this step, and they are
+        // simply drifted, without gathering the fields nor saving and restoring their state.
+        const amrex::ParticleReal zmax = amrex::Reduce::Max<amrex::ParticleReal>(np_to_push,
+            [=] AMREX_GPU_DEVICE (long i) noexcept -> amrex::ParticleReal
+            {
+                amrex::ParticleReal xp, yp, zp;
+                GetPosition(i, xp, yp, zp);
+                return zp;
+            }, std::numeric_limits<amrex::ParticleReal>::lowest());
+
+        if (zmax + static_cast<amrex::ParticleReal>(dt*PhysConst::c) <= z_plane_lev) {
+            amrex::ParallelFor( np_to_push,
+                                [=] AMREX_GPU_DEVICE (long i) {
+                                    amrex::ParticleReal xp, yp, zp;
+                                    GetPosition(i, xp, yp, zp);
+                                    if (rigid) {
+                                        zp += dt*vz_ave_boosted;
+                                    }
+                                    else {
+                                        const amrex::ParticleReal gi = 1._prt/std::sqrt(1._prt + (ux[i]*ux[i]
+                                                             + uy[i]*uy[i] + uz[i]*uz[i])*inv_csq);
+                                        zp += dt*uz[i]*gi;
+                                    }
+                                    SetPosition(i, xp, yp, zp);
+                                });
+            return;
+        }
+    }
+
 #ifdef WARPX_QED
     const bool loc_has_quantum_sync = has_quantum_sync();
     amrex::ParticleReal* AMREX_RESTRICT p_optical_depth = nullptr;
@@ -258,10 +300,6 @@ RigidInjectedParticleContainer::PushPX (WarpXParIter& pti,
 
         // Undo the push for particles not injected yet.
         // The zp are advanced a fixed amount.
-        const amrex::ParticleReal z_plane_lev = zinject_plane_lev;
-        const amrex::ParticleReal vz_ave_boosted = vzbeam_ave_boosted;
-        const bool rigid = rigid_advance;
-        constexpr amrex::ParticleReal inv_csq = 1._prt/(PhysConst::c*PhysConst::c);
         amrex::ParallelFor( np_to_push,
                             [=] AMREX_GPU_DEVICE (long i) {
                                 amrex::ParticleReal xp, yp, zp;
@@ -0,0 +1,174 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "Particles/WarpXParticleContainer.H"
+#include "SortingUtils.H"
+#include "Utils/WarpXProfilerWrapper.H"
+
+#include <AMReX_Box.H>
+#include <AMReX_GpuAtomic.H>
+#include <AMReX_GpuContainers.H>
+#include <AMReX_GpuDevice.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_IntVect.H>
+#include <AMReX_ParticleUtil.H>
+#include <AMReX_Particles.H>
+#include <AMReX_Reduce.H>
+#include <AMReX_Scan.H>
+
+using namespace amrex;
+
+namespace
+{
+    /** Number of elements of the sorted array `a` (of size n) that are smaller than `value`
+     *  (or smaller than or equal to `value` if `inclusive` is true) */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    int countBelow (int const* AMREX_RESTRICT a, int n, int value, bool inclusive) noexcept
+    {
+        int lo = 0;
+        int hi = n;
+        while (lo < hi) {
+            const int mid = lo + (hi - lo) / 2;
+            if (a[mid] < value || (inclusive && a[mid] == value)) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+}
+
+/* \brief Sort the particles of each tile by bin, reusing the order of the previous sort
+ *
+ *  Between two sorts, only the particles that crossed a bin boundary are out of order.
+ *  For each tile:
+ *  - Tiles in which all particles are still ordered by bin are left untouched.
+ *  - Otherwise, the particles whose bin is ordered with respect to both neighbours in
+ *    memory are kept in their relative order. The other particles are sorted by bin
+ *    with a counting sort, and both sorted sequences are merged.
+ *  - If the kept particles are themselves not ordered (e.g. after many new particles
+ *    were added), all particles of the tile are counting-sorted.
+ *
+ * \param bin_size size of the bins, in number of cells
+ */
+void
+WarpXParticleContainer::SortParticlesByBinIncremental (amrex::IntVect bin_size)
+{
+    WARPX_PROFILE("WarpXParticleContainer::SortParticlesByBinIncremental");
+
+    for (int lev = 0; lev <= finestLevel(); ++lev)
+    {
+        const amrex::Geometry& geom = Geom(lev);
+        const auto plo = geom.ProbLoArray();
+        const auto dxi = geom.InvCellSizeArray();
+        const amrex::Box domain = geom.Domain();
+
+        for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
+        {
+            const auto np = static_cast<int>(pti.numParticles());
+            if (np < 2) { continue; }
+
+            ParticleTileType& ptile = pti.GetParticleTile();
+            const auto ptd = ptile.getConstParticleTileData();
+
+            // Bins of the tile. Particles are clamped to the tile, in case
+            // they have not been redistributed yet.
+            const amrex::Box bin_box = amrex::coarsen(pti.tilebox(), bin_size);
+            const auto nbins = static_cast<int>(bin_box.numPts());
+
+            Gpu::DeviceVector<int> bins(np);
+            int* const AMREX_RESTRICT bins_ptr = bins.dataPtr();
+            amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (int i) noexcept
+            {
+                amrex::IntVect iv = amrex::coarsen(
+                    amrex::getParticleCell(ptd, i, plo, dxi, domain), bin_size);
+                iv.max(bin_box.smallEnd());
+                iv.min(bin_box.bigEnd());
+                bins_ptr[i] = static_cast<int>(bin_box.index(iv));
+            });
+
+            // Keep the particles that are ordered with respect to their neighbours
+            Gpu::DeviceVector<int> is_kept(np);
+            int* const AMREX_RESTRICT is_kept_ptr = is_kept.dataPtr();
+            amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (int i) noexcept
+            {
+                const bool ordered_before = (i == 0) || (bins_ptr[i-1] <= bins_ptr[i]);
+                const bool ordered_after = (i == np-1) || (bins_ptr[i] <= bins_ptr[i+1]);
+                is_kept_ptr[i] = (ordered_before && ordered_after) ? 1 : 0;
+            });
+            const int n_kept = amrex::Reduce::Sum<int>(np,
+                [=] AMREX_GPU_DEVICE (int i) noexcept { return is_kept_ptr[i]; });
+            if (n_kept == np) { continue; } // this tile is still sorted
+
+            Gpu::DeviceVector<int> pid(np);
+            fillWithConsecutiveIntegers(pid);
+            stablePartition(pid.begin(), pid.end(), is_kept);
+            const int* const AMREX_RESTRICT pid_ptr = pid.dataPtr();
+
+            const int n_unordered = (n_kept < 2) ? 0 : amrex::Reduce::Sum<int>(n_kept-1,
+                [=] AMREX_GPU_DEVICE (int k) noexcept
+                { return (bins_ptr[pid_ptr[k]] > bins_ptr[pid_ptr[k+1]]) ? 1 : 0; });
+            // Fall back to a counting sort of all particles of the tile
+            const int n_stay = (n_unordered == 0) ? n_kept : 0;
+            const int n_move = np - n_stay;
+            const int* const AMREX_RESTRICT move_ptr = (n_stay == 0) ? nullptr : pid_ptr + n_stay;
+
+            // Counting sort of the moved particles
+            Gpu::DeviceVector<int> bin_offsets(nbins+1, 0);
+            int* const AMREX_RESTRICT offsets_ptr = bin_offsets.dataPtr();
+            amrex::ParallelFor(n_move, [=] AMREX_GPU_DEVICE (int r) noexcept
+            {
+                const int ip = move_ptr ? move_ptr[r] : r;
+                amrex::Gpu::Atomic::AddNoRet(&offsets_ptr[bins_ptr[ip]], 1);
+            });
+            amrex::Scan::ExclusiveSum(nbins+1, offsets_ptr, offsets_ptr);
+
+            Gpu::DeviceVector<int> moved_sorted(n_move);
+            Gpu::DeviceVector<int> moved_bins(n_move);
+            int* const AMREX_RESTRICT moved_sorted_ptr = moved_sorted.dataPtr();
+            int* const AMREX_RESTRICT moved_bins_ptr = moved_bins.dataPtr();
+            amrex::ParallelFor(n_move, [=] AMREX_GPU_DEVICE (int r) noexcept
+            {
+                const int ip = move_ptr ? move_ptr[r] : r;
+                const int b = bins_ptr[ip];
+                const int dst = amrex::Gpu::Atomic::Add(&offsets_ptr[b], 1);
+                moved_sorted_ptr[dst] = ip;
+                moved_bins_ptr[dst] = b;
+            });
+
+            // Merge the kept particles and the sorted moved particles
+            Gpu::DeviceVector<int> kept_bins(n_stay);
+            int* const AMREX_RESTRICT kept_bins_ptr = kept_bins.dataPtr();
+            amrex::ParallelFor(n_stay, [=] AMREX_GPU_DEVICE (int k) noexcept
+            {
+                kept_bins_ptr[k] = bins_ptr[pid_ptr[k]];
+            });
+
+            Gpu::DeviceVector<int> perm(np);
+            int* const AMREX_RESTRICT perm_ptr = perm.dataPtr();
+            amrex::ParallelFor(n_stay, [=] AMREX_GPU_DEVICE (int k) noexcept
+            {
+                perm_ptr[k + countBelow(moved_bins_ptr, n_move, kept_bins_ptr[k], false)] = pid_ptr[k];
+            });
+            amrex::ParallelFor(n_move, [=] AMREX_GPU_DEVICE (int r) noexcept
+            {
+                perm_ptr[r + countBelow(kept_bins_ptr, n_stay, moved_bins_ptr[r], true)] = moved_sorted_ptr[r];
+            });
+
+            // Reorder the actual particle array, using the `perm` indices
+            ParticleTileType ptile_tmp;
+            ptile_tmp.define(NumRuntimeRealComps(), NumRuntimeIntComps());
+            ptile_tmp.resize(np);
+            amrex::gatherParticles(ptile_tmp, ptile, np, perm.dataPtr());
+            ptile.swap(ptile_tmp);
+
+            // Make sure that the temporary arrays and particle tile are not
+            // destroyed before the GPU kernels finish running
+            Gpu::streamSynchronize();
+        }
+    }
+}
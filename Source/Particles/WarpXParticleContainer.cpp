@@ -12,15 +12,19 @@
 #include "ablastr/particles/DepositCharge.H"
 #include "Deposition/ChargeDeposition.H"
 #include "Deposition/CurrentDeposition.H"
+#include "Deposition/FixedPointDeposition.H"
 #include "Deposition/SharedDepositionUtils.H"
+#include "ParticleCreation/SmartUtils.H"
 #include "Pusher/GetAndSetPosition.H"
 #include "Pusher/UpdatePosition.H"
 #include "ParticleBoundaries_K.H"
+#include "Utils/KernelCounters.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXConst.H"
 #include "Utils/WarpXProfilerWrapper.H"
 #include "Utils/Parser/ParserUtils.H"
+#include "Utils/ParticleUtils.H"
 #include "WarpX.H"
 
 #include <ablastr/coarsen/average.H>
@@ -28,6 +32,7 @@
 
 #include <AMReX.H>
 #include <AMReX_AmrCore.H>
+#include <AMReX_Arena.H>
 #include <AMReX_AmrParGDB.H>
 #include <AMReX_BLassert.H>
 #include <AMReX_Box.H>
@@ -35,6 +40,7 @@
 #include <AMReX_Config.H>
 #include <AMReX_Dim3.H>
 #include <AMReX_Extension.H>
+#include <AMReX_FArrayBox.H>
 #include <AMReX_FabArray.H>
 #include <AMReX_Geometry.H>
 #include <AMReX_GpuAllocators.H>
@@ -70,20 +76,79 @@
 #endif
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <map>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 using namespace amrex;
 
+namespace
+{
+    /** Call `deposit` with a value of the floating point type of the shared memory
+     *  deposition buffers (see WarpX::do_single_precision_shared_deposition)
+     *
+     * \param[in] deposit generic callable, which deposits with buffers of type decltype(arg)
+     */
+    template <typename F>
+    void depositWithSharedBufferType (F&& deposit)
+    {
+#if (defined(AMREX_USE_HIP) || defined(AMREX_USE_CUDA)) && !defined(AMREX_USE_FLOAT)
+        if (WarpX::do_single_precision_shared_deposition) {
+            deposit(float{});
+            return;
+        }
+#endif
+        deposit(amrex::Real{});
+    }
+}
+
 WarpXParIter::WarpXParIter (ContainerType& pc, int level)
     : amrex::ParIterSoA<PIdx::nattribs, 0>(pc, level,
              MFItInfo().SetDynamic(WarpX::do_dynamic_scheduling))
 {
+    sortTilesByCost();
 }
 
 WarpXParIter::WarpXParIter (ContainerType& pc, int level, MFItInfo& info)
     : amrex::ParIterSoA<PIdx::nattribs, 0>(pc, level,
                    info.SetDynamic(WarpX::do_dynamic_scheduling))
 {
+    sortTilesByCost();
+}
+
+void
+WarpXParIter::sortTilesByCost ()
+{
+#ifdef AMREX_USE_OMP
+    // With dynamic scheduling, each thread holds the list of all the tiles and
+    // takes the next one from a shared counter: iterating over the tiles by
+    // decreasing number of particles then hands out the most expensive ones first.
+    if (!WarpX::sort_tiles_by_cost || !dynamic || omp_get_num_threads() == 1) { return; }
+
+    // The last entry of m_valid_index is the end sentinel
+    const auto ntiles = static_cast<int>(m_valid_index.size()) - 1;
+    if (ntiles < 2) { return; }
+
+    std::vector<int> order(ntiles);
+    std::iota(order.begin(), order.end(), 0);
+    // Stable, so that all the threads get the same order
+    std::stable_sort(order.begin(), order.end(),
+        [this] (int a, int b) {
+            return m_particle_tiles[a]->numParticles() > m_particle_tiles[b]->numParticles();
+        });
+
+    const auto valid_index = m_valid_index;
+    const auto particle_tiles = m_particle_tiles;
+    for (int i = 0; i < ntiles; ++i) {
+        m_valid_index[i] = valid_index[order[i]];
+        m_particle_tiles[i] = particle_tiles[order[i]];
+    }
+    currentIndex = (m_pariter_index < ntiles) ? m_valid_index[m_pariter_index] : endIndex;
+#endif
 }
 
 WarpXParticleContainer::WarpXParticleContainer (AmrCore* amr_core, int ispecies)
@@ -118,6 +183,8 @@ WarpXParticleContainer::WarpXParticleContainer (AmrCore* amr_core, int ispecies)
     local_jx.resize(num_threads);
     local_jy.resize(num_threads);
     local_jz.resize(num_threads);
+    m_tile_currents.resize(num_threads);
+    m_n_tile_currents.resize(num_threads, 0);
 
     // The boundary conditions are read in in ReadBCParams but a child class
     // can allow these value to be overwritten if different boundary
@@ -215,7 +282,7 @@ WarpXParticleContainer::AddNParticles (int /*lev*/, long n,
 
         amrex::Long current_id = id;  // copy input
         if (id == -1) {
-            current_id = ParticleType::NextID();
+            current_id = m_assign_unique_ids ? ParticleType::NextID() : NonUniqueParticleID;
         }
         idcpu_data.push_back(amrex::SetParticleIDandCPU(current_id, ParallelDescriptor::MyProc()));
 
@@ -306,8 +373,130 @@ WarpXParticleContainer::AddNParticles (int /*lev*/, long n,
 #endif
 }
 
+void
+WarpXParticleContainer::AddNParticles (int /*lev*/, long n,
+                                       amrex::ParticleReal const * x,
+                                       amrex::ParticleReal const * y,
+                                       amrex::ParticleReal const * z,
+                                       amrex::ParticleReal const * ux,
+                                       amrex::ParticleReal const * uy,
+                                       amrex::ParticleReal const * uz,
+                                       amrex::Vector<amrex::ParticleReal const *> const & attr_real,
+                                       amrex::Vector<int const *> const & attr_int,
+                                       amrex::Long id)
+{
+    const auto nattr_real = static_cast<int>(attr_real.size());
+    const auto nattr_int = static_cast<int>(attr_int.size());
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(nattr_real >= 1,
+                                     "The particle weights must be specified");
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE((PIdx::nattribs + nattr_real - 1) <= NumRealComps(),
+                                     "Too many real attributes specified");
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(nattr_int <= NumIntComps(),
+                                     "Too many integer attributes specified");
+
+    if (n > 0)
+    {
+        // The particles get consecutive IDs, assigned on the device
+        const bool consecutive_ids = (id == -1) && m_assign_unique_ids;
+        amrex::Long pid = (id == -1) ? NonUniqueParticleID : id;
+        if (consecutive_ids) {
+            pid = ParticleType::NextID();
+            ParticleType::NextID(pid + n);
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                pid + n < amrex::LongParticleIds::LastParticleID,
+                "ERROR: overflow on particle id numbers");
+        }
+        const int cpuid = ParallelDescriptor::MyProc();
+
+        ParticleTileType new_tile;
+        new_tile.define(NumRuntimeRealComps(), NumRuntimeIntComps());
+        new_tile.resize(n);
+
+        auto& soa = new_tile.GetStructOfArrays();
+        uint64_t * const AMREX_RESTRICT idcpu = soa.GetIdCPUData().data();
+#if !defined(WARPX_DIM_1D_Z)
+        amrex::ParticleReal * const AMREX_RESTRICT px = soa.GetRealData(PIdx::x).data();
+#endif
+#if defined(WARPX_DIM_3D)
+        amrex::ParticleReal * const AMREX_RESTRICT py = soa.GetRealData(PIdx::y).data();
+#elif defined(WARPX_DIM_RZ)
+        amrex::ParticleReal * const AMREX_RESTRICT ptheta = soa.GetRealData(PIdx::theta).data();
+#endif
+        amrex::ParticleReal * const AMREX_RESTRICT pz = soa.GetRealData(PIdx::z).data();
+        amrex::ParticleReal * const AMREX_RESTRICT pw = soa.GetRealData(PIdx::w).data();
+        amrex::ParticleReal * const AMREX_RESTRICT pux = soa.GetRealData(PIdx::ux).data();
+        amrex::ParticleReal * const AMREX_RESTRICT puy = soa.GetRealData(PIdx::uy).data();
+        amrex::ParticleReal * const AMREX_RESTRICT puz = soa.GetRealData(PIdx::uz).data();
+        amrex::ParticleReal const * const AMREX_RESTRICT w = attr_real[0];
+
+        amrex::ParallelFor(n, [=] AMREX_GPU_DEVICE (long i) noexcept
+        {
+            idcpu[i] = amrex::SetParticleIDandCPU(consecutive_ids ? pid + i : pid, cpuid);
+#if defined(WARPX_DIM_3D)
+            px[i] = x[i];
+            py[i] = y[i];
+#elif defined(WARPX_DIM_RZ)
+            px[i] = std::sqrt(x[i]*x[i] + y[i]*y[i]);
+            ptheta[i] = std::atan2(y[i], x[i]);
+#elif defined(WARPX_DIM_XZ)
+            px[i] = x[i];
+#endif
+            pz[i] = z[i];
+            pw[i] = w[i];
+            pux[i] = ux[i];
+            puy[i] = uy[i];
+            puz[i] = uz[i];
+        });
+#if defined(WARPX_DIM_XZ)
+        amrex::ignore_unused(y);
+#elif defined(WARPX_DIM_1D_Z)
+        amrex::ignore_unused(x, y);
+#endif
+
+        // Initialize nattr_real - 1 runtime real attributes from the attr_real arrays
+        for (int j = PIdx::nattribs; j < PIdx::nattribs + nattr_real - 1; ++j)
+        {
+            amrex::ParticleReal const * const src = attr_real[j - PIdx::nattribs + 1];
+            amrex::Gpu::copyAsync(amrex::Gpu::deviceToDevice, src, src + n,
+                                  soa.GetRealData(j).begin());
+        }
+
+        // Initialize nattr_int runtime integer attributes from the attr_int arrays
+        for (int j = 0; j < nattr_int; ++j)
+        {
+            amrex::Gpu::copyAsync(amrex::Gpu::deviceToDevice, attr_int[j], attr_int[j] + n,
+                                  soa.GetIntData(j).begin());
+        }
+
+        // Default initialize the other real and integer runtime attributes
+        DefaultInitializeRuntimeAttributes(new_tile, nattr_real - 1, nattr_int);
+
+        //  Add to grid 0 and tile 0
+        // Redistribute() will move them to proper places.
+        auto& particle_tile = DefineAndReturnParticleTile(0, 0, 0);
+        auto old_np = particle_tile.numParticles();
+        auto new_np = old_np + new_tile.numParticles();
+        particle_tile.resize(new_np);
+        amrex::copyParticles(
+            particle_tile, new_tile, 0, old_np, new_tile.numParticles()
+        );
+        amrex::Gpu::streamSynchronize();
+    }
+
+    // Move particles to their appropriate tiles
+    Redistribute();
+
+    // Remove particles that are inside the embedded boundaries
+#ifdef AMREX_USE_EB
+    auto & distance_to_eb = WarpX::GetInstance().GetDistanceToEB();
+    scrapeParticlesAtEB( *this, amrex::GetVecOfConstPtrs(distance_to_eb), ParticleBoundaryProcess::Absorb());
+    deleteInvalidParticles();
+#endif
+}
+
 void
 WarpXParticleContainer::deleteInvalidParticles () {
+    InvalidateCellBins();
     const int nLevels = finestLevel();
     for (int lev = 0; lev <= nLevels; ++lev) {
 #ifdef AMREX_USE_OMP
@@ -340,6 +529,10 @@ WarpXParticleContainer::deleteInvalidParticles () {
  *                       current positions of the particles. When different than 0,
  *                       the particle position will be temporarily modified to match
  *                       the time of the deposition.
+ * \param push_type   Explicit or implicit particle push
+ * \param rho         If not null, full array of (nodal) charge density, in which the
+ *                    charge is deposited in the same pass as the current, at the same time
+ *                    relative_time (only for the direct deposition, without shared memory)
  */
 void
 WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
@@ -349,7 +542,8 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                                         amrex::MultiFab * const jx, amrex::MultiFab * const jy, amrex::MultiFab * const jz,
                                         long const offset, long const np_to_deposit,
                                         int const thread_num, const int lev, int const depos_lev,
-                                        amrex::Real const dt, amrex::Real const relative_time, PushType push_type)
+                                        amrex::Real const dt, amrex::Real const relative_time, PushType push_type,
+                                        amrex::MultiFab * const rho)
 {
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE((depos_lev==(lev-1)) ||
                                      (depos_lev==(lev  )),
@@ -407,6 +601,8 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
             direct_current_dep_kernel);
     WARPX_PROFILE_VAR_NS("WarpXParticleContainer::DepositCurrent::EsirkepovCurrentDepKernel",
             esirkepov_current_dep_kernel);
+    WARPX_PROFILE_VAR_NS("WarpXParticleContainer::DepositCurrent::VayCurrentDepKernel",
+            vay_current_dep_kernel);
     WARPX_PROFILE_VAR_NS("WarpXParticleContainer::DepositCurrent::CurrentDeposition", blp_deposit);
     WARPX_PROFILE_VAR_NS("WarpXParticleContainer::DepositCurrent::Accumulate", blp_accumulate);
 
@@ -421,46 +617,97 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
         tilebox = amrex::coarsen(pti.tilebox(),ref_ratio);
     }
 
+    // With warpx.do_fused_current_centering, j<xyz> are staggered: the current is deposited
+    // on nodal buffers of the tile (CPU) or box (GPU), which are centered and added to j<xyz>
+    // at the end of the deposition (as UpdateCurrentNodalToStag does for the whole level)
+    const bool fused_centering = warpx.do_fused_current_centering && (lev == depos_lev);
+
 #ifndef AMREX_USE_GPU
     // Staggered tile boxes (different in each direction)
-    Box tbx = convert( tilebox, jx->ixType().toIntVect() );
-    Box tby = convert( tilebox, jy->ixType().toIntVect() );
-    Box tbz = convert( tilebox, jz->ixType().toIntVect() );
+    Box tbx = convert( tilebox, fused_centering ? IntVect::TheNodeVector() : jx->ixType().toIntVect() );
+    Box tby = convert( tilebox, fused_centering ? IntVect::TheNodeVector() : jy->ixType().toIntVect() );
+    Box tbz = convert( tilebox, fused_centering ? IntVect::TheNodeVector() : jz->ixType().toIntVect() );
+#endif
+
+    if (rho) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            WarpX::current_deposition_algo == CurrentDepositionAlgo::Direct &&
+            push_type == PushType::Explicit && lev == depos_lev &&
+            rho->ixType().nodeCentered() && !WarpX::do_fixed_point_deposition,
+            "The charge can only be deposited together with the current for the explicit, "
+            "direct deposition of a nodal rho, without deposition buffers or fixed-point deposition");
+    }
+#ifndef AMREX_USE_GPU
+    // Nodal tile box of rho, with the guard cells for the deposition of rho
+    Box tb_rho = amrex::surroundingNodes(tilebox);
+    tb_rho.grow(warpx.get_ng_depos_rho());
 #endif
 
     tilebox.grow(ng_J);
 
 #ifdef AMREX_USE_GPU
     amrex::ignore_unused(thread_num);
-    // GPU, no tiling: j<xyz>_arr point to the full j<xyz> arrays
-    auto & jx_fab = jx->get(pti);
-    auto & jy_fab = jy->get(pti);
-    auto & jz_fab = jz->get(pti);
-    Array4<Real> const& jx_arr = jx->array(pti);
-    Array4<Real> const& jy_arr = jy->array(pti);
-    Array4<Real> const& jz_arr = jz->array(pti);
+    // GPU, no tiling: j<xyz>_arr point to the full j<xyz> arrays,
+    // or with warpx.do_fused_current_centering to nodal buffers of the box
+    amrex::FArrayBox jx_nodal, jy_nodal, jz_nodal;
+    if (fused_centering) {
+        const Box nodal_box = amrex::grow(amrex::surroundingNodes(pti.validbox()), jx->nGrowVect());
+        jx_nodal.resize(nodal_box, jx->nComp(), amrex::The_Async_Arena());
+        jy_nodal.resize(nodal_box, jy->nComp(), amrex::The_Async_Arena());
+        jz_nodal.resize(nodal_box, jz->nComp(), amrex::The_Async_Arena());
+        jx_nodal.setVal<amrex::RunOn::Device>(0.0);
+        jy_nodal.setVal<amrex::RunOn::Device>(0.0);
+        jz_nodal.setVal<amrex::RunOn::Device>(0.0);
+    }
+    auto & jx_fab = fused_centering ? jx_nodal : jx->get(pti);
+    auto & jy_fab = fused_centering ? jy_nodal : jy->get(pti);
+    auto & jz_fab = fused_centering ? jz_nodal : jz->get(pti);
+    Array4<Real> const& jx_arr = jx_fab.array();
+    Array4<Real> const& jy_arr = jy_fab.array();
+    Array4<Real> const& jz_arr = jz_fab.array();
 #else
     tbx.grow(ng_J);
     tby.grow(ng_J);
     tbz.grow(ng_J);
 
-    // CPU, tiling: j<xyz>_arr point to the local_j<xyz>[thread_num] arrays
-    local_jx[thread_num].resize(tbx, jx->nComp());
-    local_jy[thread_num].resize(tby, jy->nComp());
-    local_jz[thread_num].resize(tbz, jz->nComp());
-
-    // local_jx[thread_num] is set to zero
-    local_jx[thread_num].setVal(0.0);
-    local_jy[thread_num].setVal(0.0);
-    local_jz[thread_num].setVal(0.0);
+    // CPU, tiling: j<xyz>_arr point to the local_j<xyz>[thread_num] arrays, or with
+    // warpx.do_colored_tile_reduction to the buffers of the tile, added to j<xyz> in AddTileCurrents
+    TileCurrent* const tile_current =
+        WarpX::do_colored_tile_reduction ? &getTileCurrent(thread_num) : nullptr;
+    if (tile_current) {
+        tile_current->tilebox = amrex::grow(tilebox, -ng_J);
+        tile_current->tbox = {tbx, tby, tbz};
+        tile_current->mf = {jx, jy, jz};
+        tile_current->grid = pti.index();
+    }
+    auto & jx_fab = tile_current ? tile_current->j[0] : local_jx[thread_num];
+    auto & jy_fab = tile_current ? tile_current->j[1] : local_jy[thread_num];
+    auto & jz_fab = tile_current ? tile_current->j[2] : local_jz[thread_num];
+    jx_fab.resize(tbx, jx->nComp());
+    jy_fab.resize(tby, jy->nComp());
+    jz_fab.resize(tbz, jz->nComp());
+
+    // jx_fab is set to zero
+    jx_fab.setVal(0.0);
+    jy_fab.setVal(0.0);
+    jz_fab.setVal(0.0);
+
+    Array4<Real> const& jx_arr = jx_fab.array();
+    Array4<Real> const& jy_arr = jy_fab.array();
+    Array4<Real> const& jz_arr = jz_fab.array();
+#endif
 
-    auto & jx_fab = local_jx[thread_num];
-    auto & jy_fab = local_jy[thread_num];
-    auto & jz_fab = local_jz[thread_num];
-    Array4<Real> const& jx_arr = local_jx[thread_num].array();
-    Array4<Real> const& jy_arr = local_jy[thread_num].array();
-    Array4<Real> const& jz_arr = local_jz[thread_num].array();
+    // Charge density deposited in the same pass as the current, if requested
+    amrex::FArrayBox* rho_fab = nullptr;
+    if (rho) {
+#ifdef AMREX_USE_GPU
+        rho_fab = &(rho->get(pti));
+#else
+        local_rho[thread_num].resize(tb_rho, WarpX::ncomps);
+        local_rho[thread_num].setVal(0.0);
+        rho_fab = &local_rho[thread_num];
 #endif
+    }
 
     const auto GetPosition = GetParticlePosition<PIdx>(pti, offset);
 
@@ -477,10 +724,59 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
         }
     }
 
+    // Select how the deposited current is accumulated
+    // (with warpx.autotune_current_deposition, this is tuned at runtime)
+    bool use_shared_mem = WarpX::do_shared_mem_current_deposition;
+    amrex::IntVect shared_tilesize = WarpX::shared_tilesize;
+    const int step = warpx.getistep(0);
+    bool time_deposition = false;
+    if (WarpX::autotune_current_deposition && push_type == PushType::Explicit && !rho) {
+        if (!m_current_deposition_autotuner.isDefined()) {
+            m_current_deposition_autotuner.define(
+                CurrentDepositionCandidates(), WarpX::autotune_current_deposition_nsteps, step);
+        }
+        auto const& variant = m_current_deposition_autotuner.variant(step);
+        use_shared_mem = variant.use_shared_mem;
+        shared_tilesize = variant.shared_tilesize;
+        time_deposition = m_current_deposition_autotuner.isTuning(step);
+    }
+    if (time_deposition) { amrex::Gpu::synchronize(); }
+    const auto deposition_start_time = static_cast<amrex::Real>(amrex::second());
+
+    const double kernel_start = KernelCounters::Start();
     WARPX_PROFILE_VAR_START(blp_deposit);
 
+    // The charge is only deposited together with the current by the global-memory kernel
+    if (rho) { use_shared_mem = false; }
+
+    // With warpx.shared_mem_current_deposition_min_density, the boxes whose particles are too
+    // few to fill the shared memory buffers of their bins (e.g. in vacuum) deposit directly
+    // into global memory, which avoids zeroing and adding back the buffers of nearly empty bins.
+    // Each buffer covers a bin and the guard cells of the particle shape.
+    if (use_shared_mem && WarpX::shared_mem_current_deposition_min_density > 0._rt &&
+        !WarpX::do_filter_in_shared_mem_deposition) {
+        const Box box = amrex::grow(pti.validbox(), ng_J);
+        amrex::Long nbins = 1;
+        amrex::Long buffer_cells = 1;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            const int bin = std::max(shared_tilesize[idim], 1);
+            nbins *= (box.length(idim) + bin - 1)/bin;
+            buffer_cells *= bin + WarpX::nox + 1;
+        }
+        const auto density = static_cast<amrex::Real>(np_to_deposit)/
+            static_cast<amrex::Real>(nbins*buffer_cells);
+        if (density < WarpX::shared_mem_current_deposition_min_density) { use_shared_mem = false; }
+    }
+
+    // With warpx.do_filter_in_shared_mem_deposition, the filter is only applied by the shared memory kernel
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!WarpX::do_filter_in_shared_mem_deposition || use_shared_mem,
+        "warpx.do_filter_in_shared_mem_deposition requires that all the current is deposited "
+        "by the shared memory kernel");
+    const SeparableStencil filter = WarpX::do_filter_in_shared_mem_deposition ?
+        warpx.bilinear_filter.GetSeparableStencil() : SeparableStencil{};
+
     // If doing shared mem current deposition, get tile info
-    if (WarpX::do_shared_mem_current_deposition) {
+    if (use_shared_mem) {
         const Geometry& geom = Geom(lev);
         const auto dxi = geom.InvCellSizeArray();
         const auto plo = geom.ProbLoArray();
@@ -488,7 +784,7 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
 
         Box box = pti.validbox();
         box.grow(ng_J);
-        const amrex::IntVect bin_size = WarpX::shared_tilesize;
+        const amrex::IntVect bin_size = shared_tilesize;
 
         //sort particles by bin
         WARPX_PROFILE_VAR_START(blp_sort);
@@ -515,13 +811,13 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
             // get tile boxes
         //get the maximum size necessary for shared mem
 #if AMREX_SPACEDIM > 0
-        const int sizeX = getMaxTboxAlongDim(box.size()[0], WarpX::shared_tilesize[0]);
+        const int sizeX = getMaxTboxAlongDim(box.size()[0], bin_size[0]);
 #endif
 #if AMREX_SPACEDIM > 1
-        const int sizeZ = getMaxTboxAlongDim(box.size()[1], WarpX::shared_tilesize[1]);
+        const int sizeZ = getMaxTboxAlongDim(box.size()[1], bin_size[1]);
 #endif
 #if AMREX_SPACEDIM > 2
-        const int sizeY = getMaxTboxAlongDim(box.size()[2], WarpX::shared_tilesize[2]);
+        const int sizeY = getMaxTboxAlongDim(box.size()[2], bin_size[2]);
 #endif
         const amrex::IntVect max_tbox_size( AMREX_D_DECL(sizeX,sizeZ,sizeY) );
         WARPX_PROFILE_VAR_STOP(blp_get_max_tilesize);
@@ -531,45 +827,120 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
             amrex::Abort("Cannot do shared memory deposition with implicit algorithm");
         }
         if (WarpX::current_deposition_algo == CurrentDepositionAlgo::Esirkepov) {
-            WARPX_ABORT_WITH_MESSAGE("Cannot do shared memory deposition with Esirkepov algorithm");
+            WARPX_PROFILE_VAR_START(esirkepov_current_dep_kernel);
+            auto esirkepov_shared = [&] (auto buffer_type) {
+                using T_buff = decltype(buffer_type);
+                if        (WarpX::nox == 1){
+                    doEsirkepovDepositionSharedShapeN<1, T_buff>(
+                            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                            jx_fab, jy_fab, jz_fab, np_to_deposit, dt, relative_time, dinv,
+                            xyzmin, lo, q, WarpX::n_rz_azimuthal_modes,
+                            bins, box, geom, max_tbox_size, bin_size);
+                } else if (WarpX::nox == 2){
+                    doEsirkepovDepositionSharedShapeN<2, T_buff>(
+                            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                            jx_fab, jy_fab, jz_fab, np_to_deposit, dt, relative_time, dinv,
+                            xyzmin, lo, q, WarpX::n_rz_azimuthal_modes,
+                            bins, box, geom, max_tbox_size, bin_size);
+                } else if (WarpX::nox == 3){
+                    doEsirkepovDepositionSharedShapeN<3, T_buff>(
+                            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                            jx_fab, jy_fab, jz_fab, np_to_deposit, dt, relative_time, dinv,
+                            xyzmin, lo, q, WarpX::n_rz_azimuthal_modes,
+                            bins, box, geom, max_tbox_size, bin_size);
+                } else if (WarpX::nox == 4){
+                    doEsirkepovDepositionSharedShapeN<4, T_buff>(
+                            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                            jx_fab, jy_fab, jz_fab, np_to_deposit, dt, relative_time, dinv,
+                            xyzmin, lo, q, WarpX::n_rz_azimuthal_modes,
+                            bins, box, geom, max_tbox_size, bin_size);
+                }
+            };
+            depositWithSharedBufferType(esirkepov_shared);
+            WARPX_PROFILE_VAR_STOP(esirkepov_current_dep_kernel);
         }
         else if (WarpX::current_deposition_algo == CurrentDepositionAlgo::Villasenor) {
             WARPX_ABORT_WITH_MESSAGE("Cannot do shared memory deposition with Villasenor algorithm");
         }
         else if (WarpX::current_deposition_algo == CurrentDepositionAlgo::Vay) {
-            WARPX_ABORT_WITH_MESSAGE("Cannot do shared memory deposition with Vay algorithm");
+#if defined(WARPX_DIM_RZ) || defined(WARPX_DIM_1D_Z)
+            WARPX_ABORT_WITH_MESSAGE("Cannot do shared memory deposition with Vay algorithm in RZ or 1D geometry");
+#endif
+            WARPX_PROFILE_VAR_START(vay_current_dep_kernel);
+            auto vay_shared = [&] (auto buffer_type) {
+                using T_buff = decltype(buffer_type);
+                if        (WarpX::nox == 1){
+                    doVayDepositionSharedShapeN<1, T_buff>(
+                            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                            jx_fab, jy_fab, jz_fab, np_to_deposit, dt, relative_time, dinv,
+                            xyzmin, lo, q, WarpX::n_rz_azimuthal_modes,
+                            bins, box, geom, max_tbox_size, bin_size);
+                } else if (WarpX::nox == 2){
+                    doVayDepositionSharedShapeN<2, T_buff>(
+                            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                            jx_fab, jy_fab, jz_fab, np_to_deposit, dt, relative_time, dinv,
+                            xyzmin, lo, q, WarpX::n_rz_azimuthal_modes,
+                            bins, box, geom, max_tbox_size, bin_size);
+                } else if (WarpX::nox == 3){
+                    doVayDepositionSharedShapeN<3, T_buff>(
+                            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                            jx_fab, jy_fab, jz_fab, np_to_deposit, dt, relative_time, dinv,
+                            xyzmin, lo, q, WarpX::n_rz_azimuthal_modes,
+                            bins, box, geom, max_tbox_size, bin_size);
+                } else if (WarpX::nox == 4){
+                    doVayDepositionSharedShapeN<4, T_buff>(
+                            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                            jx_fab, jy_fab, jz_fab, np_to_deposit, dt, relative_time, dinv,
+                            xyzmin, lo, q, WarpX::n_rz_azimuthal_modes,
+                            bins, box, geom, max_tbox_size, bin_size);
+                }
+            };
+            depositWithSharedBufferType(vay_shared);
+            WARPX_PROFILE_VAR_STOP(vay_current_dep_kernel);
         }
         else {
             WARPX_PROFILE_VAR_START(direct_current_dep_kernel);
-            if        (WarpX::nox == 1){
-                doDepositionSharedShapeN<1>(
-                        GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
-                        uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
-                        jx_fab, jy_fab, jz_fab, np_to_deposit, relative_time, dinv,
-                        xyzmin, lo, q, WarpX::n_rz_azimuthal_modes,
-                        bins, box, geom, max_tbox_size);
-            } else if (WarpX::nox == 2){
-                doDepositionSharedShapeN<2>(
-                        GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
-                        uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
-                        jx_fab, jy_fab, jz_fab, np_to_deposit, relative_time, dinv,
-                        xyzmin, lo, q, WarpX::n_rz_azimuthal_modes,
-                        bins, box, geom, max_tbox_size);
-            } else if (WarpX::nox == 3){
-                doDepositionSharedShapeN<3>(
-                        GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
-                        uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
-                        jx_fab, jy_fab, jz_fab, np_to_deposit, relative_time, dinv,
-                        xyzmin, lo, q, WarpX::n_rz_azimuthal_modes,
-                        bins, box, geom, max_tbox_size);
-            } else if (WarpX::nox == 4){
-                doDepositionSharedShapeN<4>(
-                        GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
-                        uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
-                        jx_fab, jy_fab, jz_fab, np_to_deposit, relative_time, dinv,
-                        xyzmin, lo, q, WarpX::n_rz_azimuthal_modes,
-                        bins, box, geom, max_tbox_size);
-            }
+            auto direct_shared = [&] (auto buffer_type) {
+                using T_buff = decltype(buffer_type);
+                if        (WarpX::nox == 1){
+                    doDepositionSharedShapeN<1, T_buff>(
+                            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                            jx_fab, jy_fab, jz_fab, np_to_deposit, relative_time, dinv,
+                            xyzmin, lo, q, WarpX::n_rz_azimuthal_modes,
+                            bins, box, geom, max_tbox_size, bin_size, filter);
+                } else if (WarpX::nox == 2){
+                    doDepositionSharedShapeN<2, T_buff>(
+                            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                            jx_fab, jy_fab, jz_fab, np_to_deposit, relative_time, dinv,
+                            xyzmin, lo, q, WarpX::n_rz_azimuthal_modes,
+                            bins, box, geom, max_tbox_size, bin_size, filter);
+                } else if (WarpX::nox == 3){
+                    doDepositionSharedShapeN<3, T_buff>(
+                            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                            jx_fab, jy_fab, jz_fab, np_to_deposit, relative_time, dinv,
+                            xyzmin, lo, q, WarpX::n_rz_azimuthal_modes,
+                            bins, box, geom, max_tbox_size, bin_size, filter);
+                } else if (WarpX::nox == 4){
+                    doDepositionSharedShapeN<4, T_buff>(
+                            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                            jx_fab, jy_fab, jz_fab, np_to_deposit, relative_time, dinv,
+                            xyzmin, lo, q, WarpX::n_rz_azimuthal_modes,
+                            bins, box, geom, max_tbox_size, bin_size, filter);
+                }
+            };
+            depositWithSharedBufferType(direct_shared);
             WARPX_PROFILE_VAR_STOP(direct_current_dep_kernel);
         }
     }
@@ -577,30 +948,53 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
     else {
         if (WarpX::current_deposition_algo == CurrentDepositionAlgo::Esirkepov) {
             if (push_type == PushType::Explicit) {
-                if        (WarpX::nox == 1){
-                    doEsirkepovDepositionShapeN<1>(
-                        GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
-                        uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
-                        jx_arr, jy_arr, jz_arr, np_to_deposit, dt, relative_time, dinv, xyzmin, lo, q,
-                        WarpX::n_rz_azimuthal_modes);
-                } else if (WarpX::nox == 2){
-                    doEsirkepovDepositionShapeN<2>(
-                        GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
-                        uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
-                        jx_arr, jy_arr, jz_arr, np_to_deposit, dt, relative_time, dinv, xyzmin, lo, q,
-                        WarpX::n_rz_azimuthal_modes);
-                } else if (WarpX::nox == 3){
-                    doEsirkepovDepositionShapeN<3>(
-                        GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
-                        uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
-                        jx_arr, jy_arr, jz_arr, np_to_deposit, dt, relative_time, dinv, xyzmin, lo, q,
-                        WarpX::n_rz_azimuthal_modes);
-                } else if (WarpX::nox == 4){
-                    doEsirkepovDepositionShapeN<4>(
-                        GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
-                        uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
-                        jx_arr, jy_arr, jz_arr, np_to_deposit, dt, relative_time, dinv, xyzmin, lo, q,
-                        WarpX::n_rz_azimuthal_modes);
+                auto esirkepov = [&] (auto const& jx_acc, auto const& jy_acc, auto const& jz_acc,
+                                      amrex::Real const q_acc) {
+                    if        (WarpX::nox == 1){
+                        doEsirkepovDepositionShapeN<1>(
+                            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                            jx_acc, jy_acc, jz_acc, np_to_deposit, dt, relative_time, dinv, xyzmin, lo, q_acc,
+                            WarpX::n_rz_azimuthal_modes);
+                    } else if (WarpX::nox == 2){
+                        doEsirkepovDepositionShapeN<2>(
+                            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                            jx_acc, jy_acc, jz_acc, np_to_deposit, dt, relative_time, dinv, xyzmin, lo, q_acc,
+                            WarpX::n_rz_azimuthal_modes);
+                    } else if (WarpX::nox == 3){
+                        doEsirkepovDepositionShapeN<3>(
+                            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                            jx_acc, jy_acc, jz_acc, np_to_deposit, dt, relative_time, dinv, xyzmin, lo, q_acc,
+                            WarpX::n_rz_azimuthal_modes);
+                    } else if (WarpX::nox == 4){
+                        doEsirkepovDepositionShapeN<4>(
+                            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                            jx_acc, jy_acc, jz_acc, np_to_deposit, dt, relative_time, dinv, xyzmin, lo, q_acc,
+                            WarpX::n_rz_azimuthal_modes);
+                    }
+                };
+                if (WarpX::do_fixed_point_deposition) {
+                    // The value deposited by a particle of unit weight is bounded by its flux
+                    // through a face of the cell in one time step (or by its out-of-plane current),
+                    // with a margin for the partial sums of the algorithm and the azimuthal modes
+                    const amrex::Real invdt = 1.0_rt/dt;
+                    const amrex::Real max_unit_contribution = 8._rt*std::abs(q)*std::max({
+                        invdt*dinv.y*dinv.z, invdt*dinv.x*dinv.z, invdt*dinv.x*dinv.y,
+                        static_cast<amrex::Real>(PhysConst::c)*dinv.x*dinv.y*dinv.z});
+                    const amrex::Real scale = getFixedPointDepositionScale(
+                        wp.dataPtr() + offset, ion_lev, np_to_deposit, max_unit_contribution);
+                    auto jx_buffer = makeFixedPointBuffer(jx_fab);
+                    auto jy_buffer = makeFixedPointBuffer(jy_fab);
+                    auto jz_buffer = makeFixedPointBuffer(jz_fab);
+                    esirkepov(jx_buffer.array(), jy_buffer.array(), jz_buffer.array(), q*scale);
+                    addFixedPointBuffer(jx_fab, jx_buffer, scale);
+                    addFixedPointBuffer(jy_fab, jy_buffer, scale);
+                    addFixedPointBuffer(jz_fab, jz_buffer, scale);
+                } else {
+                    esirkepov(jx_arr, jy_arr, jz_arr, q);
                 }
             } else if (push_type == PushType::Implicit) {
 #if (AMREX_SPACEDIM >= 2)
@@ -741,30 +1135,49 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
             }
         } else { // Direct deposition
             if (push_type == PushType::Explicit) {
-                if        (WarpX::nox == 1){
-                    doDepositionShapeN<1>(
-                        GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
-                        uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
-                        jx_fab, jy_fab, jz_fab, np_to_deposit, relative_time, dinv,
-                        xyzmin, lo, q, WarpX::n_rz_azimuthal_modes);
-                } else if (WarpX::nox == 2){
-                    doDepositionShapeN<2>(
-                        GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
-                        uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
-                        jx_fab, jy_fab, jz_fab, np_to_deposit, relative_time, dinv,
-                        xyzmin, lo, q, WarpX::n_rz_azimuthal_modes);
-                } else if (WarpX::nox == 3){
-                    doDepositionShapeN<3>(
-                        GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
-                        uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
-                        jx_fab, jy_fab, jz_fab, np_to_deposit, relative_time, dinv,
-                        xyzmin, lo, q, WarpX::n_rz_azimuthal_modes);
-                } else if (WarpX::nox == 4){
-                    doDepositionShapeN<4>(
-                        GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
-                        uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
-                        jx_fab, jy_fab, jz_fab, np_to_deposit, relative_time, dinv,
-                        xyzmin, lo, q, WarpX::n_rz_azimuthal_modes);
+                auto direct = [&] (auto& jx_acc, auto& jy_acc, auto& jz_acc, amrex::Real const q_acc) {
+                    if        (WarpX::nox == 1){
+                        doDepositionShapeN<1>(
+                            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                            jx_acc, jy_acc, jz_acc, np_to_deposit, relative_time, dinv,
+                            xyzmin, lo, q_acc, WarpX::n_rz_azimuthal_modes, rho_fab);
+                    } else if (WarpX::nox == 2){
+                        doDepositionShapeN<2>(
+                            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                            jx_acc, jy_acc, jz_acc, np_to_deposit, relative_time, dinv,
+                            xyzmin, lo, q_acc, WarpX::n_rz_azimuthal_modes, rho_fab);
+                    } else if (WarpX::nox == 3){
+                        doDepositionShapeN<3>(
+                            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                            jx_acc, jy_acc, jz_acc, np_to_deposit, relative_time, dinv,
+                            xyzmin, lo, q_acc, WarpX::n_rz_azimuthal_modes, rho_fab);
+                    } else if (WarpX::nox == 4){
+                        doDepositionShapeN<4>(
+                            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                            jx_acc, jy_acc, jz_acc, np_to_deposit, relative_time, dinv,
+                            xyzmin, lo, q_acc, WarpX::n_rz_azimuthal_modes, rho_fab);
+                    }
+                };
+                if (WarpX::do_fixed_point_deposition) {
+                    // The current deposited by a particle of unit weight is bounded by q*c/volume,
+                    // with a factor 2 for the azimuthal modes
+                    const amrex::Real max_unit_contribution = 2._rt*std::abs(q)*
+                        static_cast<amrex::Real>(PhysConst::c)*dinv.x*dinv.y*dinv.z;
+                    const amrex::Real scale = getFixedPointDepositionScale(
+                        wp.dataPtr() + offset, ion_lev, np_to_deposit, max_unit_contribution);
+                    auto jx_buffer = makeFixedPointBuffer(jx_fab);
+                    auto jy_buffer = makeFixedPointBuffer(jy_fab);
+                    auto jz_buffer = makeFixedPointBuffer(jz_fab);
+                    direct(jx_buffer, jy_buffer, jz_buffer, q*scale);
+                    addFixedPointBuffer(jx_fab, jx_buffer, scale);
+                    addFixedPointBuffer(jy_fab, jy_buffer, scale);
+                    addFixedPointBuffer(jz_fab, jz_buffer, scale);
+                } else {
+                    direct(jx_fab, jy_fab, jz_fab, q);
                 }
             } else if (push_type == PushType::Implicit) {
                 auto& uxp_n = pti.GetAttribs(particle_comps["ux_n"]);
@@ -808,16 +1221,278 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
     }
     WARPX_PROFILE_VAR_STOP(blp_deposit);
 
+    if (KernelCounters::IsEnabled()) {
+        // Esirkepov-type algorithms deposit on a stencil that is one point wider
+        auto kernel = KernelCounters::DirectDeposition;
+        int stencil_order = WarpX::nox;
+        if (WarpX::current_deposition_algo == CurrentDepositionAlgo::Esirkepov) {
+            kernel = KernelCounters::EsirkepovDeposition;
+            stencil_order += 1;
+        } else if (WarpX::current_deposition_algo == CurrentDepositionAlgo::Villasenor) {
+            kernel = KernelCounters::VillasenorDeposition;
+            stencil_order += 1;
+        } else if (WarpX::current_deposition_algo == CurrentDepositionAlgo::Vay) {
+            kernel = KernelCounters::VayDeposition;
+        }
+        // 7 particle components read (position, momentum, weight),
+        // 3 components of J read and written at each stencil point
+        KernelCounters::StopParticleKernel(kernel, kernel_start, static_cast<double>(np_to_deposit),
+                                           stencil_order, 7., 6., 20.);
+    }
+
+    if (time_deposition) {
+        amrex::Gpu::synchronize();
+        m_current_deposition_autotuner.record(
+            step, static_cast<amrex::Real>(amrex::second()) - deposition_start_time, np_to_deposit);
+    }
+
+    if (fused_centering) {
+        // Center the nodal buffers and add them to the staggered j<xyz>
+        // (on CPU, the neighboring tiles of a box add to the same points)
+        WARPX_PROFILE_VAR_START(blp_accumulate);
+#ifdef AMREX_USE_GPU
+        constexpr bool use_atomics = false;
+#else
+        constexpr bool use_atomics = true;
+#endif
+        warpx.AddCurrentNodalToStag((*jx)[pti], jx_fab, use_atomics);
+        warpx.AddCurrentNodalToStag((*jy)[pti], jy_fab, use_atomics);
+        warpx.AddCurrentNodalToStag((*jz)[pti], jz_fab, use_atomics);
+        WARPX_PROFILE_VAR_STOP(blp_accumulate);
+    }
+
 #ifndef AMREX_USE_GPU
     // CPU, tiling: atomicAdd local_j<xyz> into j<xyz>
+    // (the buffers of the tile are added later, in AddTileCurrents)
     WARPX_PROFILE_VAR_START(blp_accumulate);
-    (*jx)[pti].lockAdd(local_jx[thread_num], tbx, tbx, 0, 0, jx->nComp());
-    (*jy)[pti].lockAdd(local_jy[thread_num], tby, tby, 0, 0, jy->nComp());
-    (*jz)[pti].lockAdd(local_jz[thread_num], tbz, tbz, 0, 0, jz->nComp());
+    if (!tile_current && !fused_centering) {
+        (*jx)[pti].lockAdd(local_jx[thread_num], tbx, tbx, 0, 0, jx->nComp());
+        (*jy)[pti].lockAdd(local_jy[thread_num], tby, tby, 0, 0, jy->nComp());
+        (*jz)[pti].lockAdd(local_jz[thread_num], tbz, tbz, 0, 0, jz->nComp());
+    }
+    if (rho) {
+        (*rho)[pti].lockAdd(local_rho[thread_num], tb_rho, tb_rho, 0, 0, WarpX::ncomps);
+    }
     WARPX_PROFILE_VAR_STOP(blp_accumulate);
 #endif
 }
 
+WarpXParticleContainer::TileCurrent&
+WarpXParticleContainer::getTileCurrent (int thread_num)
+{
+    auto& tile_currents = m_tile_currents[thread_num];
+    int& n_tile_currents = m_n_tile_currents[thread_num];
+    if (n_tile_currents == static_cast<int>(tile_currents.size())) {
+        tile_currents.emplace_back();
+    }
+    return tile_currents[n_tile_currents++];
+}
+
+void
+WarpXParticleContainer::AddTileCurrents ()
+{
+    if (std::all_of(m_n_tile_currents.begin(), m_n_tile_currents.end(),
+                    [] (int n) { return n == 0; })) { return; }
+
+    WARPX_PROFILE("WarpXParticleContainer::AddTileCurrents()");
+
+    // Tiles of each FAB of the current
+    std::map<std::pair<amrex::MultiFab const*, int>, std::vector<TileCurrent*>> fab_tiles;
+    for (int ithread = 0; ithread < static_cast<int>(m_tile_currents.size()); ++ithread) {
+        for (int i = 0; i < m_n_tile_currents[ithread]; ++i) {
+            auto& tile_current = m_tile_currents[ithread][i];
+            fab_tiles[{tile_current.mf[0], tile_current.grid}].push_back(&tile_current);
+        }
+        m_n_tile_currents[ithread] = 0;
+    }
+
+    // The tiles of a FAB are colored by the parity of their index in each direction.
+    // Two tiles of the same color are separated by at least one tile, so that they
+    // share no cell if each tile is at least as large as its guard cells: the tiles
+    // of a color are then added to the FABs in parallel, without atomics. The buffers
+    // of the same tile (deposited several times) are added by the same thread.
+    using TileSlot = std::vector<TileCurrent*>;
+    constexpr int ncolors = 1 << AMREX_SPACEDIM;
+    std::array<std::vector<TileSlot>, ncolors> colored_slots;
+    std::vector<TileSlot> locked_slots;
+    for (auto& [fab, tiles] : fab_tiles) {
+        amrex::ignore_unused(fab);
+        std::array<std::vector<int>, AMREX_SPACEDIM> tile_lo;
+        bool separated = true;
+        for (auto const* tile_current : tiles) {
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                const int len = tile_current->tilebox.length(idim);
+                tile_lo[idim].push_back(tile_current->tilebox.smallEnd(idim));
+                for (auto const& tbox : tile_current->tbox) {
+                    separated = separated && (len >= tbox.length(idim) - len);
+                }
+            }
+        }
+        for (auto& lo : tile_lo) {
+            std::sort(lo.begin(), lo.end());
+            lo.erase(std::unique(lo.begin(), lo.end()), lo.end());
+        }
+
+        std::map<std::array<int, AMREX_SPACEDIM>, TileSlot> slots;
+        for (auto* tile_current : tiles) {
+            std::array<int, AMREX_SPACEDIM> lo;
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                lo[idim] = tile_current->tilebox.smallEnd(idim);
+            }
+            slots[lo].push_back(tile_current);
+        }
+        for (auto& [lo, slot] : slots) {
+            if (!separated) {
+                locked_slots.push_back(std::move(slot));
+                continue;
+            }
+            int color = 0;
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                const auto index = std::lower_bound(tile_lo[idim].begin(), tile_lo[idim].end(), lo[idim])
+                    - tile_lo[idim].begin();
+                color |= static_cast<int>(index % 2) << idim;
+            }
+            colored_slots[color].push_back(std::move(slot));
+        }
+    }
+
+    auto const add_slots = [] (std::vector<TileSlot> const& slots, bool lock) {
+        const auto nslots = static_cast<int>(slots.size());
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (int islot = 0; islot < nslots; ++islot) {
+            for (auto const* tile_current : slots[islot]) {
+                for (int idir = 0; idir < 3; ++idir) {
+                    auto& fab = (*tile_current->mf[idir])[tile_current->grid];
+                    amrex::Box const& tbox = tile_current->tbox[idir];
+                    const int ncomp = tile_current->j[idir].nComp();
+                    if (lock) {
+                        fab.lockAdd(tile_current->j[idir], tbox, tbox, 0, 0, ncomp);
+                    } else {
+                        fab.plus<amrex::RunOn::Host>(tile_current->j[idir], tbox, tbox, 0, 0, ncomp);
+                    }
+                }
+            }
+        }
+    };
+    for (auto const& slots : colored_slots) { add_slots(slots, false); }
+    // Tiles smaller than their guard cells overlap with the tiles of the same color
+    add_slots(locked_slots, true);
+}
+
+amrex::Vector<CurrentDepositionAutotuner::Variant>
+WarpXParticleContainer::CurrentDepositionCandidates () const
+{
+    using Variant = CurrentDepositionAutotuner::Variant;
+
+    // The user's choice comes first
+    amrex::Vector<Variant> candidates;
+    candidates.push_back(Variant{WarpX::do_shared_mem_current_deposition, WarpX::shared_tilesize});
+
+#if (defined(AMREX_USE_HIP) || defined(AMREX_USE_CUDA))
+    const bool shared_mem_available =
+        WarpX::current_deposition_algo == CurrentDepositionAlgo::Direct
+#   ifndef WARPX_DIM_RZ
+        || WarpX::current_deposition_algo == CurrentDepositionAlgo::Esirkepov
+#   endif
+#   if !(defined(WARPX_DIM_RZ) || defined(WARPX_DIM_1D_Z))
+        || WarpX::current_deposition_algo == CurrentDepositionAlgo::Vay
+#   endif
+        ;
+    if (!shared_mem_available) { return candidates; }
+
+    // (the tile size is irrelevant without shared memory)
+    if (WarpX::do_shared_mem_current_deposition) {
+        candidates.push_back(Variant{false, WarpX::shared_tilesize});
+    }
+
+    // Shared memory tiles around the default size, which fit in shared memory
+    // (see doDepositionSharedShapeN, doEsirkepovDepositionSharedShapeN and doVayDepositionSharedShapeN)
+    const bool esirkepov = (WarpX::current_deposition_algo == CurrentDepositionAlgo::Esirkepov);
+    const bool vay = (WarpX::current_deposition_algo == CurrentDepositionAlgo::Vay);
+    const int buffer_ng = (esirkepov || vay) ? WarpX::nox + 2 : WarpX::nox;
+#   if defined(WARPX_DIM_3D)
+    const int ncomp_vay = 4;
+#   else
+    const int ncomp_vay = 3;
+#   endif
+    const std::size_t max_shared_mem_bytes = amrex::Gpu::Device::sharedMemPerBlock();
+    const amrex::IntVect default_tilesize = WarpX::shared_tilesize;
+    amrex::IntVect half_tilesize = default_tilesize / 2;
+    half_tilesize.max(amrex::IntVect(1));
+    amrex::IntVect long_tilesize = default_tilesize;
+    long_tilesize[WARPX_ZINDEX] *= 2;
+
+    for (auto const& tilesize : {default_tilesize, half_tilesize, long_tilesize}) {
+        const amrex::Box sample_tbox = amrex::grow(amrex::Box(amrex::IntVect(0), tilesize - 1), buffer_ng);
+        // one buffer per component for Esirkepov, one per intermediate quantity for Vay,
+        // one buffer reused for all components otherwise
+        const amrex::Long npts_tbox = amrex::surroundingNodes(sample_tbox).numPts();
+        const amrex::Long npts = esirkepov ? 3*npts_tbox : (vay ? ncomp_vay*npts_tbox : npts_tbox);
+        const std::size_t value_bytes = WarpX::do_single_precision_shared_deposition ?
+            sizeof(float) : sizeof(amrex::Real);
+        if (static_cast<std::size_t>(npts)*value_bytes > max_shared_mem_bytes) { continue; }
+
+        const bool is_new = std::none_of(candidates.begin(), candidates.end(),
+            [&](Variant const& v) { return v.use_shared_mem && v.shared_tilesize == tilesize; });
+        if (is_new) { candidates.push_back(Variant{true, tilesize}); }
+    }
+#endif
+
+    return candidates;
+}
+
+void
+WarpXParticleContainer::ResetCurrentDepositionAutotuner (int step)
+{
+    if (m_current_deposition_autotuner.isDefined()) {
+        m_current_deposition_autotuner.reset(step);
+    }
+}
+
+WarpXParticleContainer::CellBins&
+WarpXParticleContainer::getCellBins (int lev, amrex::MFIter const& mfi)
+{
+    ParticleTileType& ptile = ParticlesAt(lev, mfi);
+    const amrex::Box tilebox = mfi.tilebox(amrex::IntVect::TheZeroVector());
+    const auto np = static_cast<amrex::Long>(ptile.numParticles());
+
+    // The map is shared by the OpenMP threads, which each handle different tiles
+    CellBinsCacheEntry* entry = nullptr;
+#ifdef AMREX_USE_OMP
+#pragma omp critical (warpx_cell_bins_cache)
+#endif
+    {
+        entry = &m_cell_bins_cache[std::make_tuple(lev, mfi.index(), mfi.LocalTileIndex())];
+    }
+
+    if (entry->generation != m_cell_bins_generation || entry->np != np || entry->tilebox != tilebox)
+    {
+        entry->bins = ParticleUtils::findParticlesInEachCell(lev, mfi, ptile);
+        entry->tilebox = tilebox;
+        entry->np = np;
+        entry->generation = m_cell_bins_generation;
+        entry->shuffled = false;
+    }
+    return entry->bins;
+}
+
+bool
+WarpXParticleContainer::markCellBinsShuffled (int lev, amrex::MFIter const& mfi)
+{
+    CellBinsCacheEntry* entry = nullptr;
+#ifdef AMREX_USE_OMP
+#pragma omp critical (warpx_cell_bins_cache)
+#endif
+    {
+        entry = &m_cell_bins_cache[std::make_tuple(lev, mfi.index(), mfi.LocalTileIndex())];
+    }
+    const bool already_shuffled = entry->shuffled;
+    entry->shuffled = true;
+    return already_shuffled;
+}
+
 void
 WarpXParticleContainer::DepositCurrent (
     amrex::Vector<std::array< std::unique_ptr<amrex::MultiFab>, 3 > >& J,
@@ -856,6 +1531,51 @@ WarpXParticleContainer::DepositCurrent (
 #ifdef AMREX_USE_OMP
         }
 #endif
+        AddTileCurrents();
+    }
+}
+
+void
+WarpXParticleContainer::DepositCurrentAndCharge (
+    amrex::Vector<std::array< std::unique_ptr<amrex::MultiFab>, 3 > >& J,
+    amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rho,
+    const amrex::Real dt, const amrex::Real relative_time)
+{
+    // Loop over the refinement levels
+    auto const finest_level = static_cast<int>(J.size() - 1);
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        // Loop over particle tiles and deposit current and charge on each level
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+        {
+        const int thread_num = omp_get_thread_num();
+#else
+        const int thread_num = 0;
+#endif
+        for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
+        {
+            const long np = pti.numParticles();
+            const auto & wp = pti.GetAttribs(PIdx::w);
+            const auto & uxp = pti.GetAttribs(PIdx::ux);
+            const auto & uyp = pti.GetAttribs(PIdx::uy);
+            const auto & uzp = pti.GetAttribs(PIdx::uz);
+
+            int* AMREX_RESTRICT ion_lev = nullptr;
+            if (do_field_ionization)
+            {
+                ion_lev = pti.GetiAttribs(particle_icomps["ionizationLevel"]).dataPtr();
+            }
+
+            DepositCurrent(pti, wp, uxp, uyp, uzp, ion_lev,
+                           J[lev][0].get(), J[lev][1].get(), J[lev][2].get(),
+                           0, np, thread_num, lev, lev, dt, relative_time, PushType::Explicit,
+                           rho[lev].get());
+        }
+#ifdef AMREX_USE_OMP
+        }
+#endif
+        AddTileCurrents();
     }
 }
 
@@ -890,6 +1610,8 @@ WarpXParticleContainer::DepositCharge (WarpXParIter& pti, RealVector const& wp,
         ": not enough components allocated (" + std::to_string(rho->nComp()) + "!"
     );
 
+    const double kernel_start = KernelCounters::Start();
+
     if (WarpX::do_shared_mem_charge_deposition)
     {
         WARPX_ALWAYS_ASSERT_WITH_MESSAGE((depos_lev==(lev-1)) ||
@@ -1087,31 +1809,35 @@ WarpXParticleContainer::DepositCharge (WarpXParIter& pti, RealVector const& wp,
         Box box = pti.validbox();
         box.grow(ng_rho);
 
-        if (WarpX::nox == 1){
-            doChargeDepositionSharedShapeN<1>(GetPosition, wp.dataPtr()+offset, ion_lev,
-                                              rho_fab, ix_type, np_to_deposit, dinv, xyzmin, lo, q,
-                                              WarpX::n_rz_azimuthal_modes,
-                                              bins, box, geom, max_tbox_size,
-                                              WarpX::shared_tilesize);
-        } else if (WarpX::nox == 2){
-            doChargeDepositionSharedShapeN<2>(GetPosition, wp.dataPtr()+offset, ion_lev,
-                                              rho_fab, ix_type, np_to_deposit, dinv, xyzmin, lo, q,
-                                              WarpX::n_rz_azimuthal_modes,
-                                              bins, box, geom, max_tbox_size,
-                                              WarpX::shared_tilesize);
-        } else if (WarpX::nox == 3){
-            doChargeDepositionSharedShapeN<3>(GetPosition, wp.dataPtr()+offset, ion_lev,
-                                              rho_fab, ix_type, np_to_deposit, dinv, xyzmin, lo, q,
-                                              WarpX::n_rz_azimuthal_modes,
-                                              bins, box, geom, max_tbox_size,
-                                              WarpX::shared_tilesize);
-        } else if (WarpX::nox == 4){
-            doChargeDepositionSharedShapeN<4>(GetPosition, wp.dataPtr()+offset, ion_lev,
-                                              rho_fab, ix_type, np_to_deposit, dinv, xyzmin, lo, q,
-                                              WarpX::n_rz_azimuthal_modes,
-                                              bins, box, geom, max_tbox_size,
-                                              WarpX::shared_tilesize);
-        }
+        auto charge_shared = [&] (auto buffer_type) {
+            using T_buff = decltype(buffer_type);
+            if (WarpX::nox == 1){
+                doChargeDepositionSharedShapeN<1, T_buff>(GetPosition, wp.dataPtr()+offset, ion_lev,
+                                                  rho_fab, ix_type, np_to_deposit, dinv, xyzmin, lo, q,
+                                                  WarpX::n_rz_azimuthal_modes,
+                                                  bins, box, geom, max_tbox_size,
+                                                  WarpX::shared_tilesize);
+            } else if (WarpX::nox == 2){
+                doChargeDepositionSharedShapeN<2, T_buff>(GetPosition, wp.dataPtr()+offset, ion_lev,
+                                                  rho_fab, ix_type, np_to_deposit, dinv, xyzmin, lo, q,
+                                                  WarpX::n_rz_azimuthal_modes,
+                                                  bins, box, geom, max_tbox_size,
+                                                  WarpX::shared_tilesize);
+            } else if (WarpX::nox == 3){
+                doChargeDepositionSharedShapeN<3, T_buff>(GetPosition, wp.dataPtr()+offset, ion_lev,
+                                                  rho_fab, ix_type, np_to_deposit, dinv, xyzmin, lo, q,
+                                                  WarpX::n_rz_azimuthal_modes,
+                                                  bins, box, geom, max_tbox_size,
+                                                  WarpX::shared_tilesize);
+            } else if (WarpX::nox == 4){
+                doChargeDepositionSharedShapeN<4, T_buff>(GetPosition, wp.dataPtr()+offset, ion_lev,
+                                                  rho_fab, ix_type, np_to_deposit, dinv, xyzmin, lo, q,
+                                                  WarpX::n_rz_azimuthal_modes,
+                                                  bins, box, geom, max_tbox_size,
+                                                  WarpX::shared_tilesize);
+            }
+        };
+        depositWithSharedBufferType(charge_shared);
 #ifndef AMREX_USE_GPU
         // CPU, tiling: atomicAdd local_rho into rho
         WARPX_PROFILE_VAR_START(blp_accumulate);
@@ -1162,8 +1888,13 @@ WarpXParticleContainer::DepositCharge (WarpXParIter& pti, RealVector const& wp,
                 WarpX::noz, dinv, xyzmin, WarpX::n_rz_azimuthal_modes,
                 ng_rho, depos_lev, ref_ratio,
                 offset, np_to_deposit,
-                icomp, nc);
+                icomp, nc, WarpX::do_fixed_point_deposition);
     }
+
+    // 4 particle components read (position, weight),
+    // rho read and written at each stencil point
+    KernelCounters::StopParticleKernel(KernelCounters::ChargeDeposition, kernel_start,
+                                       static_cast<double>(np_to_deposit), WarpX::nox, 4., 2., 0.);
 }
 
 void
@@ -1460,6 +2191,8 @@ WarpXParticleContainer::PushX (int lev, amrex::Real dt)
 {
     WARPX_PROFILE("WarpXParticleContainer::PushX()");
 
+    InvalidateCellBins();
+
     if (do_not_push) { return; }
 
     amrex::LayoutData<amrex::Real>* costs = WarpX::getCosts(lev);
@@ -1532,6 +2265,67 @@ void WarpXParticleContainer::defineAllParticleTiles () noexcept
     }
 }
 
+namespace
+{
+    /** Call f with the pointer, allocated bytes and used bytes of each component of ptile */
+    template <typename PTile, typename F>
+    void forEachParticleArray (PTile& ptile, F const& f)
+    {
+        auto& soa = ptile.GetStructOfArrays();
+        auto apply = [&f] (auto& v) {
+            using T = typename std::decay_t<decltype(v)>::value_type;
+            if (v.capacity() > 0) {
+                f(static_cast<void*>(v.data()), v.capacity()*sizeof(T), v.size()*sizeof(T));
+            }
+        };
+        apply(soa.GetIdCPUData());
+        for (int comp = 0; comp < soa.NumRealComps(); ++comp) { apply(soa.GetRealData(comp)); }
+        for (int comp = 0; comp < soa.NumIntComps(); ++comp) { apply(soa.GetIntData(comp)); }
+    }
+}
+
+void
+WarpXParticleContainer::PrefetchParticleTiles (int lev)
+{
+    if (!WarpX::do_particle_memory_oversubscription || !amrex::The_Arena()->isManaged()) { return; }
+
+#if defined(AMREX_USE_CUDA) || defined(AMREX_USE_HIP)
+    WARPX_PROFILE("WarpXParticleContainer::PrefetchParticleTiles()");
+
+    const int device = amrex::Gpu::Device::deviceId();
+    for (auto& kv : GetParticles(lev)) {
+        const bool cold = (kv.second.numParticles() == 0);
+        forEachParticleArray(kv.second,
+            [=] (void* p, std::size_t allocated_bytes, std::size_t used_bytes)
+            {
+#if defined(AMREX_USE_CUDA)
+                if (cold) {
+                    AMREX_CUDA_SAFE_CALL(cudaMemAdvise(p, allocated_bytes,
+                        cudaMemAdviseSetPreferredLocation, cudaCpuDeviceId));
+                } else {
+                    AMREX_CUDA_SAFE_CALL(cudaMemAdvise(p, allocated_bytes,
+                        cudaMemAdviseUnsetPreferredLocation, device));
+                    AMREX_CUDA_SAFE_CALL(cudaMemPrefetchAsync(p, used_bytes, device,
+                        amrex::Gpu::gpuStream()));
+                }
+#else
+                if (cold) {
+                    AMREX_HIP_SAFE_CALL(hipMemAdvise(p, allocated_bytes,
+                        hipMemAdviseSetPreferredLocation, hipCpuDeviceId));
+                } else {
+                    AMREX_HIP_SAFE_CALL(hipMemAdvise(p, allocated_bytes,
+                        hipMemAdviseUnsetPreferredLocation, device));
+                    AMREX_HIP_SAFE_CALL(hipMemPrefetchAsync(p, used_bytes, device,
+                        amrex::Gpu::gpuStream()));
+                }
+#endif
+            });
+    }
+#else
+    amrex::ignore_unused(lev);
+#endif
+}
+
 // This function is called in Redistribute, just after locate
 void
 WarpXParticleContainer::particlePostLocate(ParticleType& p,
@@ -1556,21 +2350,55 @@ WarpXParticleContainer::particlePostLocate(ParticleType& p,
 }
 
 void
-WarpXParticleContainer::ApplyBoundaryConditions (){
+WarpXParticleContainer::ApplyBoundaryConditions (amrex::Real max_displacement){
     WARPX_PROFILE("WarpXParticleContainer::ApplyBoundaryConditions()");
 
     // Periodic boundaries are handled in AMReX code
     if (m_boundary_conditions.CheckAll(ParticleBoundaryType::Periodic)) { return; }
 
+    InvalidateCellBins();
+
     auto boundary_conditions = m_boundary_conditions.data;
 
+    // Boundary conditions on the lower and upper sides of each dimension of the index space
+    const std::array<std::array<ParticleBoundaryType, 2>, AMREX_SPACEDIM> bc_dims{{
+#if defined(WARPX_DIM_3D)
+        {boundary_conditions.xmin_bc, boundary_conditions.xmax_bc},
+        {boundary_conditions.ymin_bc, boundary_conditions.ymax_bc},
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+        {boundary_conditions.xmin_bc, boundary_conditions.xmax_bc},
+#endif
+        {boundary_conditions.zmin_bc, boundary_conditions.zmax_bc}
+    }};
+
     for (int lev = 0; lev <= finestLevel(); ++lev)
     {
+        const amrex::Box& domain = Geom(lev).Domain();
+        const auto dx = Geom(lev).CellSizeArray();
+
+        // Whether the particles of a tile may have crossed a non-periodic boundary,
+        // i.e. whether the tile, grown by max_displacement, extends out of the domain
+        const auto may_cross_boundary = [&] (const amrex::Box& tbx) {
+            if (max_displacement < 0) { return true; }
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                const int ncells = static_cast<int>(std::ceil(max_displacement/dx[idim]));
+                if ((bc_dims[idim][0] != ParticleBoundaryType::Periodic &&
+                     tbx.smallEnd(idim) - ncells < domain.smallEnd(idim)) ||
+                    (bc_dims[idim][1] != ParticleBoundaryType::Periodic &&
+                     tbx.bigEnd(idim) + ncells > domain.bigEnd(idim))) {
+                    return true;
+                }
+            }
+            return false;
+        };
+
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
         for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
         {
+            if (!may_cross_boundary(pti.tilebox())) { continue; }
+
             auto GetPosition = GetParticlePosition<PIdx>(pti);
             auto SetPosition = SetParticlePosition<PIdx>(pti);
 #ifndef WARPX_DIM_1D_Z
@@ -8,6 +8,9 @@
 
 #include <Particles/WarpXParticleContainer.H>
 
+#include <cstdint>
+#include <vector>
+
 
 void init_WarpXParIter (py::module& m)
 {
@@ -85,6 +88,36 @@ void init_WarpXParticleContainer (py::module& m)
             py::arg("nattr_int"), py::arg("attr_int"),
             py::arg("uniqueparticles"), py::arg("id")=-1
         )
+        .def("add_n_particles_from_device",
+            [](WarpXParticleContainer& pc, int lev, long n,
+                std::uintptr_t x, std::uintptr_t y, std::uintptr_t z,
+                std::uintptr_t ux, std::uintptr_t uy, std::uintptr_t uz,
+                std::vector<std::uintptr_t> const & attr_real,
+                std::vector<std::uintptr_t> const & attr_int,
+                amrex::Long id
+            ) {
+                // The arguments are the addresses of arrays in the memory of the particle
+                // container (e.g. arr.data.ptr of CuPy arrays), of type ParticleReal and int
+                const auto real_ptr = [] (std::uintptr_t p) {
+                    return reinterpret_cast<amrex::ParticleReal const *>(p); // NOLINT(performance-no-int-to-ptr)
+                };
+                amrex::Vector<amrex::ParticleReal const *> attr;
+                for (auto const p : attr_real) { attr.push_back(real_ptr(p)); }
+                amrex::Vector<int const *> iattr;
+                for (auto const p : attr_int) {
+                    iattr.push_back(reinterpret_cast<int const *>(p)); // NOLINT(performance-no-int-to-ptr)
+                }
+
+                pc.AddNParticles(
+                    lev, n, real_ptr(x), real_ptr(y), real_ptr(z),
+                    real_ptr(ux), real_ptr(uy), real_ptr(uz), attr, iattr, id
+                );
+            },
+            py::arg("lev"), py::arg("n"),
+            py::arg("x"), py::arg("y"), py::arg("z"),
+            py::arg("ux"), py::arg("uy"), py::arg("uz"),
+            py::arg("attr_real"), py::arg("attr_int"), py::arg("id")=-1
+        )
         .def("get_comp_index",
             [](WarpXParticleContainer& pc, std::string comp_name)
             {
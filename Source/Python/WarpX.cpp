@@ -83,6 +83,9 @@ void init_WarpX (py::module& m)
             "Initializes the WarpX simulation"
         )
         .def("evolve", &WarpX::Evolve,
+            // release the GIL, so that asynchronous Python callbacks can run
+            // while the simulation advances (the callbacks re-acquire it)
+            py::call_guard<py::gil_scoped_release>(),
             "Evolve the simulation the specified number of steps"
         )
 
@@ -8,6 +8,8 @@
  */
 #include "callbacks.H"
 
+#include "Utils/PhaseTimer.H"
+
 #include <cstdlib>
 #include <exception>
 #include <iostream>
@@ -30,6 +32,7 @@ void ExecutePythonCallback ( const std::string& name )
 {
     if ( IsPythonCallbackInstalled(name) ) {
         WARPX_PROFILE("warpx_py_" + name);
+        PhaseTimer::Scope const phase_timer(PhaseTimer::PythonCallbacks);
         try {
             warpx_callback_py_map[name]();
         } catch (std::exception &e) {
@@ -11,6 +11,8 @@
 #include <Utils/WarpXVersion.H>
 #include <Initialization/WarpXAMReXInit.H>
 
+#include <optional>
+
 #define STRINGIFY(x) #x
 #define MACRO_STRINGIFY(x) STRINGIFY(x)
 #define CONCAT_NAME(PRE, SUF) PRE ## SUF
@@ -96,7 +98,7 @@ PYBIND11_MODULE(PYWARPX_MODULE_NAME, m) {
     // std::cout << "numpy version: " << py::str(npversion) << std::endl;
 
     m.def("amrex_init",
-        [](const py::list args) {
+        [](const py::list args, std::optional<int> mpi_comm_f) {
             amrex::Vector<std::string> cargs;
             amrex::Vector<char*> argv;
 
@@ -114,10 +116,18 @@ PYBIND11_MODULE(PYWARPX_MODULE_NAME, m) {
             char** tmp = argv.data();
 
             const bool build_parm_parse = (cargs.size() > 1);
-            // TODO: handle version with MPI
-            return warpx::initialization::amrex_init(argc, tmp, build_parm_parse);
+
+            // The communicator is passed as its Fortran handle, as given by mpi4py's Comm.py2f()
+            MPI_Comm mpi_comm = MPI_COMM_WORLD;
+#ifdef AMREX_USE_MPI
+            if (mpi_comm_f) { mpi_comm = MPI_Comm_f2c(*mpi_comm_f); }
+#else
+            amrex::ignore_unused(mpi_comm_f);
+#endif
+            return warpx::initialization::amrex_init(argc, tmp, build_parm_parse, mpi_comm);
         }, py::return_value_policy::reference,
-        "Initialize AMReX library");
+        py::arg("args"), py::arg("mpi_comm_f") = py::none(),
+        "Initialize AMReX library, optionally on the MPI communicator with the Fortran handle mpi_comm_f");
     m.def("amrex_finalize", [] () { amrex::Finalize(); },
         "Close out the amrex related data");
 
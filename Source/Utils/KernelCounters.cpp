@@ -0,0 +1,97 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "KernelCounters.H"
+
+#include <AMReX_GpuDevice.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_OpenMP.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_REAL.H>
+
+#include <cmath>
+
+bool KernelCounters::m_enabled = false;
+std::array<double, KernelCounters::NKernels> KernelCounters::m_calls = {};
+std::array<double, KernelCounters::NKernels> KernelCounters::m_times = {};
+std::array<double, KernelCounters::NKernels> KernelCounters::m_bytes = {};
+std::array<double, KernelCounters::NKernels> KernelCounters::m_flops = {};
+
+double
+KernelCounters::Start ()
+{
+    if (!m_enabled) { return 0.; }
+    amrex::Gpu::synchronize();
+    return amrex::ParallelDescriptor::second();
+}
+
+void
+KernelCounters::Stop (Kernel kernel, double start, double bytes, double flops)
+{
+    if (!m_enabled) { return; }
+    amrex::Gpu::synchronize();
+    double elapsed = amrex::ParallelDescriptor::second() - start;
+    if (amrex::OpenMP::in_parallel()) {
+        elapsed /= static_cast<double>(amrex::OpenMP::get_num_threads());
+    }
+#ifdef AMREX_USE_OMP
+#pragma omp critical (warpx_kernel_counters)
+#endif
+    {
+        m_calls[kernel] += 1.;
+        m_times[kernel] += elapsed;
+        m_bytes[kernel] += bytes;
+        m_flops[kernel] += flops;
+    }
+}
+
+void
+KernelCounters::StopParticleKernel (Kernel kernel, double start, double np, int shape_order,
+                                    double particle_reals, double grid_values, double extra_flops)
+{
+    if (!m_enabled) { return; }
+    const double stencil_points = ShapeStencilPoints(shape_order);
+    // shape factors: a few operations per point and per direction;
+    // grid accesses: one multiply-add per value and per stencil point
+    const double flops_per_particle = 4.*(shape_order + 1)*AMREX_SPACEDIM
+        + 2.*grid_values*stencil_points + extra_flops;
+    const double bytes_per_particle = particle_reals*sizeof(amrex::ParticleReal)
+        + grid_values*stencil_points*sizeof(amrex::Real);
+    Stop(kernel, start, np*bytes_per_particle, np*flops_per_particle);
+}
+
+void
+KernelCounters::StopCellKernel (Kernel kernel, double start, double ncells,
+                                double reals_per_cell, double flops_per_cell)
+{
+    if (!m_enabled) { return; }
+    Stop(kernel, start, ncells*reals_per_cell*sizeof(amrex::Real), ncells*flops_per_cell);
+}
+
+void
+KernelCounters::Reset ()
+{
+    m_calls.fill(0.);
+    m_times.fill(0.);
+    m_bytes.fill(0.);
+    m_flops.fill(0.);
+}
+
+double
+KernelCounters::LocalNumCells (amrex::MultiFab const& mf)
+{
+    double ncells = 0.;
+    for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        ncells += static_cast<double>(mfi.validbox().numPts());
+    }
+    return ncells;
+}
+
+double
+KernelCounters::ShapeStencilPoints (int shape_order)
+{
+    return std::pow(static_cast<double>(shape_order + 1), AMREX_SPACEDIM);
+}
@@ -0,0 +1,59 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "PhaseTimer.H"
+
+#include <AMReX_GpuDevice.H>
+#include <AMReX_ParallelDescriptor.H>
+
+bool PhaseTimer::m_enabled = false;
+bool PhaseTimer::m_synchronize = false;
+std::array<double, PhaseTimer::NPhases> PhaseTimer::m_times = {};
+std::vector<std::pair<int, double>> PhaseTimer::m_stack;
+
+void
+PhaseTimer::Enable (bool synchronize)
+{
+    m_enabled = true;
+    m_synchronize = m_synchronize || synchronize;
+}
+
+void
+PhaseTimer::AccumulateTop (double now)
+{
+    if (m_stack.empty()) { return; }
+    auto& top = m_stack.back();
+    m_times[top.first] += now - top.second;
+    top.second = now;
+}
+
+void
+PhaseTimer::Start (Phase phase)
+{
+    if (!m_enabled) { return; }
+    if (m_synchronize) { amrex::Gpu::synchronize(); }
+    const double now = amrex::ParallelDescriptor::second();
+    AccumulateTop(now);
+    m_stack.emplace_back(phase, now);
+}
+
+void
+PhaseTimer::Stop ()
+{
+    if (!m_enabled || m_stack.empty()) { return; }
+    if (m_synchronize) { amrex::Gpu::synchronize(); }
+    const double now = amrex::ParallelDescriptor::second();
+    AccumulateTop(now);
+    m_stack.pop_back();
+    // resume the enclosing phase
+    if (!m_stack.empty()) { m_stack.back().second = now; }
+}
+
+void
+PhaseTimer::Reset ()
+{
+    m_times.fill(0.);
+}
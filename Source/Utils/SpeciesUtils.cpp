@@ -135,6 +135,10 @@ namespace SpeciesUtils {
                        mom_dist_s.end(),
                        mom_dist_s.begin(),
                        ::tolower);
+        // Whether the gaussianflux and maxwell_juttner distributions are sampled
+        // from tabulated inverse cumulative distributions, instead of rejection methods
+        int sampling_table = 0;
+        utils::parser::queryWithParser(pp_species, source_name, "momentum_sampling_table", sampling_table);
         if (mom_dist_s == "at_rest") {
             constexpr amrex::Real ux = 0._rt;
             constexpr amrex::Real uy = 0._rt;
@@ -181,10 +185,17 @@ namespace SpeciesUtils {
             utils::parser::queryWithParser(pp_species, source_name, "ux_th", ux_th);
             utils::parser::queryWithParser(pp_species, source_name, "uy_th", uy_th);
             utils::parser::queryWithParser(pp_species, source_name, "uz_th", uz_th);
+            // The rejection method has no loop for a vanishing central momentum
+            InverseCDFTable flux_table;
+            const amrex::Real u_m_normal = (flux_normal_axis == 0) ? ux_m : ((flux_normal_axis == 1) ? uy_m : uz_m);
+            const amrex::Real u_th_normal = (flux_normal_axis == 0) ? ux_th : ((flux_normal_axis == 1) ? uy_th : uz_th);
+            if (sampling_table && u_m_normal != 0._rt && u_th_normal > 0._rt) {
+                flux_table = makeGaussianFluxTable(u_m_normal, u_th_normal);
+            }
             // Construct InjectorMomentum with InjectorMomentumGaussianFlux.
             h_inj_mom.reset(new InjectorMomentum((InjectorMomentumGaussianFlux*)nullptr,
                                                 ux_m, uy_m, uz_m, ux_th, uy_th, uz_th,
-                                                flux_normal_axis, flux_direction));
+                                                flux_normal_axis, flux_direction, flux_table));
         } else if (mom_dist_s == "uniform") {
             amrex::Real ux_min = 0._rt;
             amrex::Real uy_min = 0._rt;
@@ -213,8 +224,23 @@ namespace SpeciesUtils {
             const GetTemperature getTemp(*h_mom_temp);
             h_mom_vel = std::make_unique<VelocityProperties>(pp_species, source_name);
             const GetVelocity getVel(*h_mom_vel);
+            // With a spatially-varying temperature, the table has rows spaced
+            // logarithmically between theta_min and theta_max, and the rejection
+            // method is used for the temperatures outside of this range
+            InverseCDFTable speed_table;
+            if (sampling_table) {
+                if (h_mom_temp->m_type == TempConstantValue) {
+                    speed_table = makeJuttnerSpeedTable(h_mom_temp->m_temperature, h_mom_temp->m_temperature, 1);
+                } else {
+                    amrex::Real theta_min = 0.1_rt;
+                    amrex::Real theta_max = 10._rt;
+                    utils::parser::queryWithParser(pp_species, source_name, "momentum_sampling_table_theta_min", theta_min);
+                    utils::parser::queryWithParser(pp_species, source_name, "momentum_sampling_table_theta_max", theta_max);
+                    speed_table = makeJuttnerSpeedTable(theta_min, theta_max, 128);
+                }
+            }
             // Construct InjectorMomentum with InjectorMomentumJuttner.
-            h_inj_mom.reset(new InjectorMomentum((InjectorMomentumJuttner*)nullptr, getTemp, getVel));
+            h_inj_mom.reset(new InjectorMomentum((InjectorMomentumJuttner*)nullptr, getTemp, getVel, speed_table));
         } else if (mom_dist_s == "radial_expansion") {
             amrex::Real u_over_r = 0._rt;
             utils::parser::queryWithParser(pp_species, source_name, "u_over_r", u_over_r);
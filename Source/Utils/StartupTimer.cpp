@@ -0,0 +1,61 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "StartupTimer.H"
+
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParallelReduce.H>
+#include <AMReX_Print.H>
+
+#include <iomanip>
+
+std::vector<StartupTimer::Stage> StartupTimer::m_stages;
+int StartupTimer::m_depth = 0;
+bool StartupTimer::m_finished = false;
+double StartupTimer::m_first_start = -1.;
+
+StartupTimer::Scope::Scope (const char* name)
+{
+    if (m_finished) { return; }
+    m_index = static_cast<int>(m_stages.size());
+    m_start = amrex::ParallelDescriptor::second();
+    if (m_first_start < 0.) { m_first_start = m_start; }
+    m_stages.push_back(Stage{name, m_depth, 0.});
+    ++m_depth;
+}
+
+StartupTimer::Scope::~Scope ()
+{
+    if (m_index < 0) { return; }
+    m_stages[m_index].time = amrex::ParallelDescriptor::second() - m_start;
+    --m_depth;
+}
+
+void
+StartupTimer::Finish (bool print_report)
+{
+    if (m_finished) { return; }
+    m_finished = true;
+    if (!print_report) { return; }
+
+    // The stages are the same on all ranks, in the same order
+    std::vector<double> times(m_stages.size() + 1);
+    for (std::size_t i = 0; i < m_stages.size(); ++i) { times[i] = m_stages[i].time; }
+    times.back() = (m_first_start < 0.) ? 0. : amrex::ParallelDescriptor::second() - m_first_start;
+    amrex::ParallelDescriptor::ReduceRealMax(times.data(), static_cast<int>(times.size()),
+                                             amrex::ParallelDescriptor::IOProcessorNumber());
+
+    amrex::Print() << "\nStartup timings (max over ranks, in seconds):\n";
+    for (std::size_t i = 0; i < m_stages.size(); ++i) {
+        const std::string name = std::string(2*(m_stages[i].depth + 1), ' ') + m_stages[i].name;
+        amrex::Print() << std::left << std::setw(40) << name
+                       << std::right << std::setw(12) << std::fixed << std::setprecision(3)
+                       << times[i] << "\n";
+    }
+    amrex::Print() << std::left << std::setw(40) << "  total"
+                   << std::right << std::setw(12) << std::fixed << std::setprecision(3)
+                   << times.back() << "\n\n";
+}
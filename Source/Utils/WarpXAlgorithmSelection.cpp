@@ -52,6 +52,7 @@ const std::map<std::string, int> electrostatic_solver_algo_to_int = {
     {"relativistic", ElectrostaticSolverAlgo::Relativistic},
     {"labframe-electromagnetostatic", ElectrostaticSolverAlgo::LabFrameElectroMagnetostatic},
     {"labframe", ElectrostaticSolverAlgo::LabFrame},
+    {"labframe-effective-potential", ElectrostaticSolverAlgo::LabFrameEffectivePotential},
     {"default", ElectrostaticSolverAlgo::None }
 };
 
@@ -61,6 +62,13 @@ const std::map<std::string, int> poisson_solver_algo_to_int = {
     {"default", PoissonSolverAlgo::Multigrid }
 };
 
+const std::map<std::string, int> poisson_initial_guess_to_int = {
+    {"previous",    PoissonInitialGuess::Previous},
+    {"extrapolate", PoissonInitialGuess::Extrapolate},
+    {"zero",        PoissonInitialGuess::Zero},
+    {"default",     PoissonInitialGuess::Previous }
+};
+
 const std::map<std::string, int> particle_pusher_algo_to_int = {
     {"boris",   ParticlePusherAlgo::Boris },
     {"vay",     ParticlePusherAlgo::Vay },
@@ -105,6 +113,12 @@ const std::map<std::string, int> rho_in_time_to_int = {
     {"default", RhoInTime::Linear}
 };
 
+const std::map<std::string, int> fft_decomposition_to_int = {
+    {"local", FFTDecomposition::Local},
+    {"grouped", FFTDecomposition::Grouped},
+    {"default", FFTDecomposition::Local}
+};
+
 const std::map<std::string, int> load_balance_costs_update_algo_to_int = {
     {"timers",    LoadBalanceCostsUpdateAlgo::Timers },
     {"heuristic", LoadBalanceCostsUpdateAlgo::Heuristic },
@@ -173,6 +187,8 @@ GetAlgorithmInteger(const amrex::ParmParse& pp, const char* pp_search_key ){
         algo_to_int = electrostatic_solver_algo_to_int;
     } else if (0 == std::strcmp(pp_search_key, "poisson_solver")) {
         algo_to_int = poisson_solver_algo_to_int;
+    } else if (0 == std::strcmp(pp_search_key, "self_fields_initial_guess")) {
+        algo_to_int = poisson_initial_guess_to_int;
     } else if (0 == std::strcmp(pp_search_key, "particle_pusher")) {
         algo_to_int = particle_pusher_algo_to_int;
     } else if (0 == std::strcmp(pp_search_key, "current_deposition")) {
@@ -192,6 +208,8 @@ GetAlgorithmInteger(const amrex::ParmParse& pp, const char* pp_search_key ){
         algo_to_int = J_in_time_to_int;
     } else if (0 == std::strcmp(pp_search_key, "rho_in_time")) {
         algo_to_int = rho_in_time_to_int;
+    } else if (0 == std::strcmp(pp_search_key, "fft_decomposition")) {
+        algo_to_int = fft_decomposition_to_int;
     } else if (0 == std::strcmp(pp_search_key, "load_balance_costs_update")) {
         algo_to_int = load_balance_costs_update_algo_to_int;
     } else if (0 == std::strcmp(pp_search_key, "em_solver_medium")) {
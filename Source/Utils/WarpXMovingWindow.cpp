@@ -286,6 +286,12 @@ WarpX::MoveWindow (const int step, bool move_j)
             }
         }
 
+        // Load the slab of the external fields from file that the window moved into
+        if (m_p_ext_field_params->B_ext_grid_type == ExternalFieldType::read_from_file ||
+            m_p_ext_field_params->E_ext_grid_type == ExternalFieldType::read_from_file) {
+            ShiftExternalFieldsFromFile(lev, num_shift, dir);
+        }
+
         // Shift scalar field F with div(E) cleaning in valid domain
         // TODO: shift F from pml_rz for RZ geometry with PSATD, once implemented
         if (F_fp[lev])
@@ -452,9 +458,67 @@ WarpX::MoveWindow (const int step, bool move_j)
         }
     }
 
+    // The cells of the particles changed with the domain
+    mypc->InvalidateCellBins();
+
     return num_shift_base;
 }
 
+void
+WarpX::ShiftExternalFieldsFromFile (int const lev, int const num_shift, int const dir)
+{
+    WARPX_PROFILE("WarpX::ShiftExternalFieldsFromFile()");
+
+    // Cells that the window moved into, including the guard cells
+    // (and one more cell, for the nodal points on its boundary)
+    const amrex::Box& domain_box = geom[lev].Domain();
+    amrex::Box new_region = amrex::grow(domain_box, guard_cells.ng_alloc_EB);
+    if (num_shift > 0) {
+        new_region.setSmall(dir, domain_box.bigEnd(dir) - num_shift);
+    } else {
+        new_region.setBig(dir, domain_box.smallEnd(dir) - num_shift);
+    }
+
+#if defined(WARPX_DIM_RZ)
+    const std::array<std::string, 3> components = {"r", "t", "z"};
+#else
+    const std::array<std::string, 3> components = {"x", "y", "z"};
+#endif
+
+    const auto shift_and_read = [&] (amrex::MultiFab& field, amrex::MultiFab& field_external,
+                                     const std::string& F_name, const std::string& F_component)
+    {
+        shiftMF(field_external, geom[lev], num_shift, dir, lev, false);
+        ReadExternalFieldFromFile(m_p_ext_field_params->external_fields_path, &field_external,
+                                  F_name, F_component, new_region);
+
+        // The shifted field holds the constant external value in the new cells
+        // (see shiftMF): add the field read from file there
+        const amrex::Box region = amrex::convert(new_region, field.ixType());
+        for (amrex::MFIter mfi(field, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const amrex::Box bx = mfi.growntilebox() & region;
+            if (!bx.ok()) { continue; }
+            auto const& f = field.array(mfi);
+            auto const& f_ext = field_external.const_array(mfi);
+            amrex::ParallelFor(bx, field.nComp(),
+                [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+                {
+                    f(i,j,k,n) += f_ext(i,j,k,n);
+                });
+        }
+    };
+
+    for (int dim = 0; dim < 3; ++dim) {
+        if (m_p_ext_field_params->B_ext_grid_type == ExternalFieldType::read_from_file) {
+            shift_and_read(*Bfield_fp[lev][dim], *Bfield_fp_external[lev][dim], "B", components[dim]);
+        }
+        if (m_p_ext_field_params->E_ext_grid_type == ExternalFieldType::read_from_file) {
+            shift_and_read(*Efield_fp[lev][dim], *Efield_fp_external[lev][dim], "E", components[dim]);
+        }
+    }
+}
+
 void
 WarpX::shiftMF (amrex::MultiFab& mf, const amrex::Geometry& geom,
                 int num_shift, int dir, const int lev, bool update_cost_flag,
@@ -464,18 +528,16 @@ WarpX::shiftMF (amrex::MultiFab& mf, const amrex::Geometry& geom,
     using namespace amrex::literals;
     WARPX_PROFILE("WarpX::shiftMF()");
     const amrex::BoxArray& ba = mf.boxArray();
-    const amrex::DistributionMapping& dm = mf.DistributionMap();
     const int nc = mf.nComp();
     const amrex::IntVect& ng = mf.nGrowVect();
 
     AMREX_ALWAYS_ASSERT(ng[dir] >= num_shift);
 
-    amrex::MultiFab tmpmf(ba, dm, nc, ng);
-    amrex::MultiFab::Copy(tmpmf, mf, 0, 0, nc, ng);
-
+    // The guard cells are filled in place, since they are overwritten by the
+    // shift below anyway: this avoids a temporary copy of the whole MultiFab.
     if ( WarpX::safe_guard_cells ) {
         // Fill guard cells.
-        ablastr::utils::communication::FillBoundary(tmpmf, WarpX::do_single_precision_comms, geom.periodicity());
+        ablastr::utils::communication::FillBoundary(mf, WarpX::do_single_precision_comms, geom.periodicity());
     } else {
         amrex::IntVect ng_mw = amrex::IntVect::TheUnitVector();
         // Enough guard cells in the MW direction
@@ -483,7 +545,7 @@ WarpX::shiftMF (amrex::MultiFab& mf, const amrex::Geometry& geom,
         // Make sure we don't exceed number of guard cells allocated
         ng_mw = ng_mw.min(ng);
         // Fill guard cells.
-        ablastr::utils::communication::FillBoundary(tmpmf, ng_mw, WarpX::do_single_precision_comms, geom.periodicity());
+        ablastr::utils::communication::FillBoundary(mf, ng_mw, WarpX::do_single_precision_comms, geom.periodicity());
     }
 
     // Make a box that covers the region that the window moved into
@@ -522,7 +584,7 @@ WarpX::shiftMF (amrex::MultiFab& mf, const amrex::Geometry& geom,
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
 
-    for (amrex::MFIter mfi(tmpmf); mfi.isValid(); ++mfi )
+    for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi )
     {
         if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
         {
@@ -530,8 +592,9 @@ WarpX::shiftMF (amrex::MultiFab& mf, const amrex::Geometry& geom,
         }
         auto wt = static_cast<amrex::Real>(amrex::second());
 
-        auto const& dstfab = mf.array(mfi);
-        auto const& srcfab = tmpmf.array(mfi);
+        // Initialize the cells that the window moved into directly in mf,
+        // before they are shifted
+        auto const& srcfab = mf.array(mfi);
 
         const amrex::Box& outbox = mfi.fabbox() & adjBox;
 
@@ -543,7 +606,7 @@ WarpX::shiftMF (amrex::MultiFab& mf, const amrex::Geometry& geom,
                 })
             } else {
                 // index type of the src mf
-                auto const& mf_IndexType = (tmpmf).ixType();
+                auto const& mf_IndexType = mf.ixType();
                 amrex::IntVect mf_type(AMREX_D_DECL(0,0,0));
                 for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
                     mf_type[idim] = mf_IndexType.nodeCentered(idim);
@@ -578,6 +641,16 @@ WarpX::shiftMF (amrex::MultiFab& mf, const amrex::Geometry& geom,
 
         }
 
+        // Copy of this box only, used as the source of the shift, which
+        // cannot be done in place in parallel
+        amrex::FArrayBox tmpfab(mf[mfi].box(), nc, amrex::The_Async_Arena());
+        auto const& tmparr = tmpfab.array();
+        auto const& dstfab = mf.array(mfi);
+        AMREX_PARALLEL_FOR_4D ( mf[mfi].box(), nc, i, j, k, n,
+        {
+            tmparr(i,j,k,n) = srcfab(i,j,k,n);
+        })
+
         amrex::Box dstBox = mf[mfi].box();
         if (num_shift > 0) {
             dstBox.growHi(dir, -num_shift);
@@ -586,7 +659,7 @@ WarpX::shiftMF (amrex::MultiFab& mf, const amrex::Geometry& geom,
         }
         AMREX_PARALLEL_FOR_4D ( dstBox, nc, i, j, k, n,
         {
-            dstfab(i,j,k,n) = srcfab(i+shift.x,j+shift.y,k+shift.z,n);
+            dstfab(i,j,k,n) = tmparr(i+shift.x,j+shift.y,k+shift.z,n);
         })
 
         if (cost && update_cost_flag &&
@@ -616,12 +689,12 @@ WarpX::shiftMF (amrex::MultiFab& mf, const amrex::Geometry& geom,
             bl.push_back(amrex::grow(ba[i], 0, mf.nGrowVect()[0]));
         }
         const amrex::BoxArray rba(std::move(bl));
-        amrex::MultiFab rmf(rba, dm, mf.nComp(), IntVect(0,mf.nGrowVect()[1]), MFInfo().SetAlloc(false));
+        amrex::MultiFab rmf(rba, mf.DistributionMap(), mf.nComp(), IntVect(0,mf.nGrowVect()[1]), MFInfo().SetAlloc(false));
 
         for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi) {
             rmf.setFab(mfi, FArrayBox(mf[mfi], amrex::make_alias, 0, mf.nComp()));
         }
-        rmf.FillBoundary(false);
+        ablastr::utils::communication::FillBoundary(rmf, WarpX::do_single_precision_comms);
     }
 #endif
 
@@ -35,6 +35,7 @@
 #include "Fluids/WarpXFluidContainer.H"
 #include "Particles/ParticleBoundaryBuffer.H"
 #include "AcceleratorLattice/AcceleratorLattice.H"
+#include "Utils/StartupTimer.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXConst.H"
@@ -43,6 +44,9 @@
 
 #include "FieldSolver/ImplicitSolvers/ImplicitSolverLibrary.H"
 
+#include <ablastr/fields/PoissonSolver.H>
+#include <ablastr/parallelization/MPIInitHelpers.H>
+#include <ablastr/utils/ScratchPool.H>
 #include <ablastr/utils/SignalHandling.H>
 #include <ablastr/warn_manager/WarnManager.H>
 
@@ -53,6 +57,7 @@
 #include <AMReX_BLassert.H>
 #include <AMReX_Box.H>
 #include <AMReX_BoxArray.H>
+#include <AMReX_BoxList.H>
 #include <AMReX_Dim3.H>
 #ifdef AMREX_USE_EB
 #   include <AMReX_EBFabFactory.H>
@@ -96,6 +101,7 @@ int WarpX::moving_window_dir = -1;
 Real WarpX::moving_window_v = std::numeric_limits<amrex::Real>::max();
 
 bool WarpX::fft_do_time_averaging = false;
+bool WarpX::psatd_on_the_fly_coefficients = false;
 
 amrex::IntVect WarpX::m_fill_guards_fields  = amrex::IntVect(0);
 amrex::IntVect WarpX::m_fill_guards_current = amrex::IntVect(0);
@@ -126,9 +132,23 @@ bool WarpX::do_divb_cleaning = false;
 int WarpX::em_solver_medium;
 int WarpX::macroscopic_solver_algo;
 bool WarpX::do_single_precision_comms = false;
+bool WarpX::do_overlap_fill_boundary = false;
+bool WarpX::do_fdtd_temporal_blocking = false;
+bool WarpX::do_nonblocking_current_sum = false;
 
 bool WarpX::do_shared_mem_charge_deposition = false;
 bool WarpX::do_shared_mem_current_deposition = false;
+amrex::Real WarpX::shared_mem_current_deposition_min_density = 0._rt;
+bool WarpX::do_filter_in_shared_mem_deposition = false;
+bool WarpX::do_fused_push_deposition = false;
+bool WarpX::do_particle_memory_oversubscription = false;
+bool WarpX::do_simd_field_gather = false;
+bool WarpX::do_single_precision_shared_deposition = false;
+bool WarpX::do_fixed_point_deposition = false;
+bool WarpX::do_colored_tile_reduction = false;
+bool WarpX::autotune_current_deposition = false;
+int WarpX::autotune_current_deposition_nsteps = 4;
+bool WarpX::autotune_current_deposition_after_load_balance = true;
 #if defined(WARPX_DIM_3D)
 amrex::IntVect WarpX::shared_tilesize(AMREX_D_DECL(6,6,8));
 #elif (AMREX_SPACEDIM == 2)
@@ -163,6 +183,7 @@ int WarpX::current_centering_noy = 2;
 int WarpX::current_centering_noz = 2;
 
 bool WarpX::use_fdtd_nci_corr = false;
+bool WarpX::use_fdtd_nci_corr_fused_gather = false;
 bool WarpX::galerkin_interpolation = true;
 
 bool WarpX::verboncoeur_axis_correction = true;
@@ -172,6 +193,8 @@ bool WarpX::use_kspace_filter       = true;
 bool WarpX::use_filter_compensation = false;
 
 bool WarpX::serialize_initial_conditions = false;
+bool WarpX::counter_based_injection = false;
+unsigned long WarpX::injection_random_seed = 1;
 bool WarpX::refine_plasma     = false;
 
 int WarpX::num_mirrors = 0;
@@ -186,8 +209,11 @@ bool WarpX::sort_particles_for_deposition = false;
 #endif
 
 amrex::IntVect WarpX::sort_idx_type(AMREX_D_DECL(0,0,0));
+bool WarpX::sort_incremental = false;
+bool WarpX::neighbor_redistribute = true;
 
 bool WarpX::do_dynamic_scheduling = true;
+bool WarpX::sort_tiles_by_cost = false;
 
 int WarpX::electrostatic_solver_id;
 int WarpX::poisson_solver_id;
@@ -195,6 +221,10 @@ Real WarpX::self_fields_required_precision = 1.e-11_rt;
 Real WarpX::self_fields_absolute_tolerance = 0.0_rt;
 int WarpX::self_fields_max_iters = 200;
 int WarpX::self_fields_verbosity = 2;
+int WarpX::self_fields_initial_guess = PoissonInitialGuess::Previous;
+Real WarpX::effective_potential_factor = 4._rt;
+bool WarpX::do_parallel_tridiag_solve = false;
+Real WarpX::self_fields_beta_tolerance = -1._rt;
 
 bool WarpX::do_subcycling = false;
 bool WarpX::do_multi_J = false;
@@ -216,6 +246,8 @@ WarpX* WarpX::m_instance = nullptr;
 
 void WarpX::MakeWarpX ()
 {
+    const StartupTimer::Scope startup_timer("setup");
+
     ParseGeometryInput();
 
     ConvertLabParamsToBoost();
@@ -258,7 +290,10 @@ WarpX::WarpX ()
 
     BackwardCompatibility();
 
-    InitEB();
+    {
+        const StartupTimer::Scope startup_timer("embedded_boundaries");
+        InitEB();
+    }
 
     ablastr::utils::SignalHandling::InitSignalHandling();
 
@@ -322,6 +357,7 @@ WarpX::WarpX ()
     G_fp.resize(nlevs_max);
     rho_fp.resize(nlevs_max);
     phi_fp.resize(nlevs_max);
+    phi_fp_previous.resize(nlevs_max);
     current_fp.resize(nlevs_max);
     Efield_fp.resize(nlevs_max);
     Bfield_fp.resize(nlevs_max);
@@ -357,6 +393,8 @@ WarpX::WarpX ()
 
     current_store.resize(nlevs_max);
 
+    m_cleaning_active_boxes.resize(nlevs_max);
+
     if (do_current_centering)
     {
         current_fp_nodal.resize(nlevs_max);
@@ -403,6 +441,8 @@ WarpX::WarpX ()
 
     costs.resize(nlevs_max);
     load_balance_efficiency.resize(nlevs_max);
+    m_costs_previous.resize(nlevs_max);
+    m_costs_previous_ba.resize(nlevs_max);
 
     m_field_factory.resize(nlevs_max);
 
@@ -527,6 +567,8 @@ WarpX::ReadParameters ()
         const ParmParse pp_amr("amr");
 
         pp_amr.query("restart", restart_chkfile);
+        const ParmParse pp_warpx("warpx");
+        pp_warpx.query("restart_with_new_grids", restart_with_new_grids);
     }
 
     {
@@ -644,12 +686,17 @@ WarpX::ReadParameters ()
                 const unsigned long cpu_seed = myproc_1 * dist(rd);
                 const unsigned long gpu_seed = myproc_1 * dist(rd);
                 ResetRandomSeed(cpu_seed, gpu_seed);
+                // the counter-based seed must be the same on all ranks
+                int injection_seed = dist(rd);
+                ParallelDescriptor::Bcast(&injection_seed, 1, ParallelDescriptor::IOProcessorNumber());
+                injection_random_seed = static_cast<unsigned long>(injection_seed);
             } else if ( std::stoi(random_seed) > 0 ) {
                 const unsigned long nprocs = ParallelDescriptor::NProcs();
                 const unsigned long seed_long = std::stoul(random_seed);
                 const unsigned long cpu_seed = myproc_1 * seed_long;
                 const unsigned long gpu_seed = (myproc_1 + nprocs) * seed_long;
                 ResetRandomSeed(cpu_seed, gpu_seed);
+                injection_random_seed = seed_long;
             } else {
                 WARPX_ABORT_WITH_MESSAGE(
                     "warpx.random_seed must be \"default\", \"random\" or an integer > 0.");
@@ -658,7 +705,16 @@ WarpX::ReadParameters ()
 
         utils::parser::queryWithParser(pp_warpx, "cfl", cfl);
         pp_warpx.query("verbose", verbose);
+        pp_warpx.query("print_startup_timings", print_startup_timings);
         utils::parser::queryWithParser(pp_warpx, "regrid_int", regrid_int);
+        if (regrid_int > 0) {
+            // RemakeLevel only supports a new DistributionMapping on the same
+            // BoxArray (load balancing): the refined patches are static
+            ablastr::warn_manager::WMRecordWarning("Mesh refinement",
+                "warpx.regrid_int is ignored: dynamic regridding is not supported, "
+                "the refined patches are defined once at initialization by "
+                "warpx.fine_tag_lo/fine_tag_hi or warpx.ref_patch_function(x,y,z).");
+        }
         pp_warpx.query("do_subcycling", do_subcycling);
         pp_warpx.query("do_multi_J", do_multi_J);
         if (do_multi_J)
@@ -675,6 +731,10 @@ WarpX::ReadParameters ()
 
         WARPX_ALWAYS_ASSERT_WITH_MESSAGE(do_subcycling != 1 || max_level <= 1,
                                          "Subcycling method 1 only works for 2 levels.");
+        // OneStep_sub1 advances the fine level by exactly two steps per coarse step
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(do_subcycling != 1 || max_level == 0 ||
+                                         refRatio(0) == amrex::IntVect(2),
+                                         "Subcycling method 1 only works with a refinement ratio of 2.");
 
         ReadBoostedFrameParameters(gamma_boost, beta_boost, boost_direction);
 
@@ -742,6 +802,7 @@ WarpX::ReadParameters ()
         }
 
         if (electrostatic_solver_id == ElectrostaticSolverAlgo::LabFrame ||
+            electrostatic_solver_id == ElectrostaticSolverAlgo::LabFrameEffectivePotential ||
             electrostatic_solver_id == ElectrostaticSolverAlgo::LabFrameElectroMagnetostatic)
         {
             // Note that with the relativistic version, these parameters would be
@@ -753,7 +814,27 @@ WarpX::ReadParameters ()
             utils::parser::queryWithParser(
                 pp_warpx, "self_fields_max_iters", self_fields_max_iters);
             pp_warpx.query("self_fields_verbosity", self_fields_verbosity);
+            self_fields_initial_guess = GetAlgorithmInteger(pp_warpx, "self_fields_initial_guess");
+            if (electrostatic_solver_id == ElectrostaticSolverAlgo::LabFrameEffectivePotential) {
+                utils::parser::queryWithParser(
+                    pp_warpx, "effective_potential_factor", effective_potential_factor);
+                WARPX_ALWAYS_ASSERT_WITH_MESSAGE(effective_potential_factor >= 0._rt,
+                    "warpx.effective_potential_factor must be non-negative");
+#ifdef AMREX_USE_EB
+                WARPX_ABORT_WITH_MESSAGE(
+                    "warpx.do_electrostatic = labframe-effective-potential does not support embedded boundaries yet");
+#endif
+            }
+#if defined(WARPX_DIM_1D_Z)
+            pp_warpx.query("do_parallel_tridiag_solve", do_parallel_tridiag_solve);
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!do_parallel_tridiag_solve ||
+                (field_boundary_lo[0] != FieldBoundaryType::Periodic &&
+                 field_boundary_hi[0] != FieldBoundaryType::Periodic),
+                "warpx.do_parallel_tridiag_solve does not support periodic boundaries");
+#endif
         }
+        utils::parser::queryWithParser(
+            pp_warpx, "self_fields_beta_tolerance", self_fields_beta_tolerance);
 
         poisson_solver_id = GetAlgorithmInteger(pp_warpx, "poisson_solver");
 #ifndef WARPX_DIM_3D
@@ -775,6 +856,12 @@ WarpX::ReadParameters ()
         "The FFT Poisson solver is not implemented in labframe-electromagnetostatic mode yet."
         );
 
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            electrostatic_solver_id!=ElectrostaticSolverAlgo::LabFrameEffectivePotential ||
+            poisson_solver_id!=PoissonSolverAlgo::IntegratedGreenFunction,
+            "The FFT Poisson solver cannot be used with labframe-effective-potential, "
+            "which requires a variable-coefficient operator.");
+
         // Parse the input file for domain boundary potentials
         const ParmParse pp_boundary("boundary");
         bool potential_specified = false;
@@ -873,6 +960,19 @@ WarpX::ReadParameters ()
                 "Overwrote warpx.do_single_precision_comms to be 0, since WarpX was built in single precision.",
                 ablastr::warn_manager::WarnPriority::low);
         }
+#endif
+        pp_warpx.query("do_overlap_fill_boundary", do_overlap_fill_boundary);
+        pp_warpx.query("do_fdtd_temporal_blocking", do_fdtd_temporal_blocking);
+        pp_warpx.query("do_nonblocking_current_sum", do_nonblocking_current_sum);
+#ifdef WARPX_DIM_RZ
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!do_overlap_fill_boundary,
+            "warpx.do_overlap_fill_boundary is not implemented in RZ geometry");
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!do_fdtd_temporal_blocking,
+            "warpx.do_fdtd_temporal_blocking is not implemented in RZ geometry");
+#endif
+#ifdef AMREX_USE_EB
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!do_fdtd_temporal_blocking,
+            "warpx.do_fdtd_temporal_blocking is not implemented with embedded boundaries");
 #endif
         pp_warpx.query("do_shared_mem_charge_deposition", do_shared_mem_charge_deposition);
         pp_warpx.query("do_shared_mem_current_deposition", do_shared_mem_current_deposition);
@@ -880,7 +980,46 @@ WarpX::ReadParameters ()
         WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!do_shared_mem_current_deposition,
                 "requested shared memory for current deposition, but shared memory is only available for CUDA or HIP");
 #endif
+        pp_warpx.query("do_filter_in_shared_mem_deposition", do_filter_in_shared_mem_deposition);
+        utils::parser::queryWithParser(pp_warpx, "shared_mem_current_deposition_min_density",
+            shared_mem_current_deposition_min_density);
         pp_warpx.query("shared_mem_current_tpb", shared_mem_current_tpb);
+        pp_warpx.query("do_single_precision_shared_deposition", do_single_precision_shared_deposition);
+#ifdef AMREX_USE_FLOAT
+        if (do_single_precision_shared_deposition) {
+            do_single_precision_shared_deposition = false;
+            ablastr::warn_manager::WMRecordWarning(
+                "shared memory deposition",
+                "Overwrote warpx.do_single_precision_shared_deposition to be 0, since WarpX was built in single precision.",
+                ablastr::warn_manager::WarnPriority::low);
+        }
+#endif
+        pp_warpx.query("do_fixed_point_deposition", do_fixed_point_deposition);
+        pp_warpx.query("do_colored_tile_reduction", do_colored_tile_reduction);
+#ifdef AMREX_USE_GPU
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!do_colored_tile_reduction,
+                "warpx.do_colored_tile_reduction is only available on CPU");
+#endif
+        pp_warpx.query("do_fused_push_deposition", do_fused_push_deposition);
+        pp_warpx.query("do_particle_memory_oversubscription", do_particle_memory_oversubscription);
+#if !(defined(AMREX_USE_HIP) || defined(AMREX_USE_CUDA))
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!do_particle_memory_oversubscription,
+                "warpx.do_particle_memory_oversubscription is only available for CUDA or HIP");
+#endif
+        pp_warpx.query("do_simd_field_gather", do_simd_field_gather);
+#if defined(AMREX_USE_GPU) || defined(WARPX_DIM_RZ)
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!do_simd_field_gather,
+                "warpx.do_simd_field_gather is only available on CPU, in Cartesian geometry");
+#endif
+        pp_warpx.query("autotune_current_deposition", autotune_current_deposition);
+#if !(defined(AMREX_USE_HIP) || defined(AMREX_USE_CUDA))
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!autotune_current_deposition,
+                "requested autotuning of the current deposition, but it is only available for CUDA or HIP");
+#endif
+        utils::parser::queryWithParser(pp_warpx, "autotune_current_deposition_nsteps", autotune_current_deposition_nsteps);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(autotune_current_deposition_nsteps > 0,
+                "warpx.autotune_current_deposition_nsteps must be positive");
+        pp_warpx.query("autotune_current_deposition_after_load_balance", autotune_current_deposition_after_load_balance);
 
         // initialize the shared tilesize
         Vector<int> vect_shared_tilesize(AMREX_SPACEDIM, 1);
@@ -893,9 +1032,16 @@ WarpX::ReadParameters ()
         }
 
         pp_warpx.query("serialize_initial_conditions", serialize_initial_conditions);
+        pp_warpx.query("counter_based_injection", counter_based_injection);
         pp_warpx.query("refine_plasma", refine_plasma);
         pp_warpx.query("do_dive_cleaning", do_dive_cleaning);
         pp_warpx.query("do_divb_cleaning", do_divb_cleaning);
+        utils::parser::queryWithParser(
+            pp_warpx, "localized_cleaning_distance", localized_cleaning_distance);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            localized_cleaning_distance < 0 ||
+            electromagnetic_solver_id != ElectromagneticSolverAlgo::PSATD,
+            "warpx.localized_cleaning_distance is only implemented with the FDTD solvers");
         utils::parser::queryWithParser(
             pp_warpx, "n_field_gather_buffer", n_field_gather_buffer);
         utils::parser::queryWithParser(
@@ -1027,8 +1173,16 @@ WarpX::ReadParameters ()
             utils::parser::queryWithParser(pp_warpx, "mffile_nstreams", mffile_nstreams);
             VisMF::SetMFFileInStreams(mffile_nstreams);
             utils::parser::queryWithParser(pp_warpx, "field_io_nfiles", field_io_nfiles);
-            VisMF::SetNOutFiles(field_io_nfiles);
             utils::parser::queryWithParser(pp_warpx, "particle_io_nfiles", particle_io_nfiles);
+            // Optionally, aggregate the output of the ranks of each node into a few files
+            int io_nfiles_per_node = 0;
+            utils::parser::queryWithParser(pp_warpx, "io_nfiles_per_node", io_nfiles_per_node);
+            if (io_nfiles_per_node > 0) {
+                const int num_nodes = ablastr::parallelization::mpi_num_nodes();
+                field_io_nfiles = std::min(num_nodes*io_nfiles_per_node, ParallelDescriptor::NProcs());
+                particle_io_nfiles = field_io_nfiles;
+            }
+            VisMF::SetNOutFiles(field_io_nfiles);
             ParmParse pp_particles("particles");
             pp_particles.add("particles_nfiles", particle_io_nfiles);
         }
@@ -1061,6 +1215,14 @@ WarpX::ReadParameters ()
         }
 
         pp_warpx.query("do_dynamic_scheduling", do_dynamic_scheduling);
+        pp_warpx.query("sort_tiles_by_cost", sort_tiles_by_cost);
+#ifndef AMREX_USE_OMP
+        if (sort_tiles_by_cost) {
+            ablastr::warn_manager::WMRecordWarning("Performance",
+                "warpx.sort_tiles_by_cost is ignored without OpenMP.",
+                ablastr::warn_manager::WarnPriority::low);
+        }
+#endif
 
         // Integer that corresponds to the type of grid used in the simulation
         // (collocated, staggered, hybrid)
@@ -1142,6 +1304,16 @@ WarpX::ReadParameters ()
                                           current_centering_noy,
                                           current_centering_noz,
                                           grid_type);
+
+            // If true, the nodal current of each tile (CPU) or box (GPU) is centered and
+            // added to the staggered current at the end of its deposition, so that the
+            // nodal current of the whole level is never stored
+            pp_warpx.query("do_fused_current_centering", do_fused_current_centering);
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                !do_fused_current_centering ||
+                (!do_fused_push_deposition && !do_colored_tile_reduction),
+                "warpx.do_fused_current_centering cannot be used with "
+                "warpx.do_fused_push_deposition or warpx.do_colored_tile_reduction");
         }
 
         WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
@@ -1253,6 +1425,47 @@ WarpX::ReadParameters ()
                 "be used with Implicit evolve schemes.");
         }
 
+        if (do_filter_in_shared_mem_deposition) {
+            // The filter is applied to the current of each tile in the shared memory
+            // deposition kernel, instead of ApplyFilterJ on the whole fine patch:
+            // all the current must be deposited by this kernel
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                use_filter && do_shared_mem_current_deposition && !autotune_current_deposition,
+                "warpx.do_filter_in_shared_mem_deposition requires warpx.use_filter and "
+                "warpx.do_shared_mem_current_deposition, without warpx.autotune_current_deposition.");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                current_deposition_algo == CurrentDepositionAlgo::Direct &&
+                evolve_scheme == EvolveScheme::Explicit && maxLevel() == 0,
+                "warpx.do_filter_in_shared_mem_deposition is only implemented for the direct "
+                "current deposition, with the explicit scheme and without mesh refinement.");
+        }
+
+        if (do_fixed_point_deposition) {
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                (current_deposition_algo == CurrentDepositionAlgo::Direct ||
+                 current_deposition_algo == CurrentDepositionAlgo::Esirkepov) &&
+                evolve_scheme == EvolveScheme::Explicit,
+                "warpx.do_fixed_point_deposition is only implemented for the direct "
+                "and Esirkepov current deposition, with the explicit scheme.");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                !do_shared_mem_current_deposition && !do_shared_mem_charge_deposition &&
+                !autotune_current_deposition && !do_fused_push_deposition,
+                "warpx.do_fixed_point_deposition cannot be used with the shared memory "
+                "deposition, warpx.autotune_current_deposition or warpx.do_fused_push_deposition.");
+        }
+
+        if (do_fused_push_deposition) {
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                current_deposition_algo == CurrentDepositionAlgo::Direct ||
+                current_deposition_algo == CurrentDepositionAlgo::Esirkepov,
+                "warpx.do_fused_push_deposition is only implemented for "
+                "direct and Esirkepov current deposition.");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                !do_shared_mem_current_deposition,
+                "warpx.do_fused_push_deposition cannot be used with "
+                "warpx.do_shared_mem_current_deposition.");
+        }
+
         // Query algo.field_gathering from input, set field_gathering_algo to
         // "default" if not found (default defined in Utils/WarpXAlgorithmSelection.cpp)
         field_gathering_algo = static_cast<short>(GetAlgorithmInteger(pp_algo, "field_gathering"));
@@ -1317,6 +1530,23 @@ WarpX::ReadParameters ()
             macroscopic_solver_algo = GetAlgorithmInteger(pp_algo,"macroscopic_sigma_method");
         }
 
+        if (do_fdtd_temporal_blocking) {
+            const bool all_periodic =
+                std::all_of(field_boundary_lo.begin(), field_boundary_lo.end(),
+                    [](FieldBoundaryType bc){ return bc == FieldBoundaryType::Periodic; }) &&
+                std::all_of(field_boundary_hi.begin(), field_boundary_hi.end(),
+                    [](FieldBoundaryType bc){ return bc == FieldBoundaryType::Periodic; });
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                (electromagnetic_solver_id == ElectromagneticSolverAlgo::Yee ||
+                 electromagnetic_solver_id == ElectromagneticSolverAlgo::CKC) &&
+                evolve_scheme == EvolveScheme::Explicit &&
+                em_solver_medium == MediumForEM::Vacuum &&
+                maxLevel() == 0 && all_periodic &&
+                !do_dive_cleaning && !do_divb_cleaning,
+                "warpx.do_fdtd_temporal_blocking requires the explicit Yee or CKC solver in vacuum,"
+                " without mesh refinement, with periodic field boundaries and without div(E)/div(B) cleaning");
+        }
+
         if (evolve_scheme == EvolveScheme::SemiImplicitEM ||
             evolve_scheme == EvolveScheme::ThetaImplicitEM) {
 
@@ -1353,6 +1583,10 @@ WarpX::ReadParameters ()
         }
         utils::parser::queryWithParser(pp_algo, "load_balance_efficiency_ratio_threshold",
                         load_balance_efficiency_ratio_threshold);
+        utils::parser::queryWithParser(pp_algo, "load_balance_prediction_factor",
+                        load_balance_prediction_factor);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(load_balance_prediction_factor >= 0._rt,
+            "algo.load_balance_prediction_factor must be non-negative");
         load_balance_costs_update_algo = static_cast<short>(GetAlgorithmInteger(pp_algo, "load_balance_costs_update"));
         if (WarpX::load_balance_costs_update_algo==LoadBalanceCostsUpdateAlgo::Heuristic) {
             utils::parser::queryWithParser(
@@ -1435,6 +1669,8 @@ WarpX::ReadParameters ()
         }
 
         pp_warpx.query("sort_particles_for_deposition",sort_particles_for_deposition);
+        pp_warpx.query("sort_incremental", sort_incremental);
+        pp_warpx.query("neighbor_redistribute", neighbor_redistribute);
         Vector<int> vect_sort_idx_type(AMREX_SPACEDIM,0);
         const bool sort_idx_type_is_specified =
             utils::parser::queryArrWithParser(
@@ -1490,6 +1726,15 @@ WarpX::ReadParameters ()
     {
         const ParmParse pp_psatd("psatd");
         pp_psatd.query("periodic_single_box_fft", fft_periodic_single_box);
+        fft_decomposition = static_cast<short>(GetAlgorithmInteger(pp_psatd, "fft_decomposition"));
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            !fft_periodic_single_box || fft_decomposition == FFTDecomposition::Local,
+            "psatd.fft_decomposition=grouped cannot be used with psatd.periodic_single_box_fft=1");
+#ifdef WARPX_DIM_RZ
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            fft_decomposition == FFTDecomposition::Local,
+            "psatd.fft_decomposition=grouped is not implemented in RZ geometry");
+#endif
 
         std::string nox_str;
         std::string noy_str;
@@ -1556,6 +1801,7 @@ WarpX::ReadParameters ()
         if (do_multi_J) { current_correction = false; }
 
         pp_psatd.query("current_correction", current_correction);
+        pp_psatd.query("skip_backward_transform_J", skip_backward_transform_J);
 
         if (!current_correction &&
             current_deposition_algo != CurrentDepositionAlgo::Esirkepov &&
@@ -1573,6 +1819,7 @@ WarpX::ReadParameters ()
         }
 
         pp_psatd.query("do_time_averaging", fft_do_time_averaging);
+        pp_psatd.query("on_the_fly_coefficients", psatd_on_the_fly_coefficients);
 
         if (WarpX::current_deposition_algo == CurrentDepositionAlgo::Vay)
         {
@@ -2058,6 +2305,9 @@ WarpX::MakeNewLevelFromCoarse (int /*lev*/, amrex::Real /*time*/, const amrex::B
 void
 WarpX::ClearLevel (int lev)
 {
+    // the scratch MultiFabs may be defined on the boxes of this level
+    ablastr::utils::scratch::clear_pool();
+
     for (int i = 0; i < 3; ++i) {
         Efield_aux[lev][i].reset();
         Bfield_aux[lev][i].reset();
@@ -2108,6 +2358,7 @@ WarpX::ClearLevel (int lev)
     G_fp  [lev].reset();
     rho_fp[lev].reset();
     phi_fp[lev].reset();
+    phi_fp_previous[lev].reset();
     F_cp  [lev].reset();
     G_cp  [lev].reset();
     rho_cp[lev].reset();
@@ -2165,6 +2416,8 @@ WarpX::AllocLevelData (int lev, const BoxArray& ba, const DistributionMapping& d
 
 #ifdef AMREX_USE_EB
         int max_guard = guard_cells.ng_FieldSolver.max();
+        // the cached Poisson solvers refer to the previous EB factory, if any
+        ablastr::fields::clearPoissonSolverCache();
         m_field_factory[lev] = amrex::makeEBFabFactory(Geom(lev), ba, dm,
                                                        {max_guard, max_guard, max_guard},
                                                        amrex::EBSupport::full);
@@ -2193,7 +2446,7 @@ WarpX::AllocLevelData (int lev, const BoxArray& ba, const DistributionMapping& d
                   guard_cells.ng_alloc_Rho, guard_cells.ng_alloc_F, guard_cells.ng_alloc_G, aux_is_nodal);
 
     m_accelerator_lattice[lev] = std::make_unique<AcceleratorLattice>();
-    m_accelerator_lattice[lev]->InitElementFinder(lev, ba, dm);
+    m_accelerator_lattice[lev]->InitElementFinder(lev);
 
 }
 
@@ -2327,7 +2580,7 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
         AllocInitMultiFab(Efield_fp_external[lev][2], amrex::convert(ba, Ez_nodal_flag), dm, ncomps, ngEB, lev, "Efield_fp_external[z]", 0.0_rt);
     }
 
-    if (do_current_centering)
+    if (do_current_centering && !do_fused_current_centering)
     {
         amrex::BoxArray const& nodal_ba = amrex::convert(ba, amrex::IntVect::TheNodeVector());
         AllocInitMultiFab(current_fp_nodal[lev][0], nodal_ba, dm, ncomps, ngJ, lev, "current_fp_nodal[x]", 0.0_rt);
@@ -2411,18 +2664,11 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
             AllocInitMultiFab(m_face_areas[lev][2], amrex::convert(ba, Bz_nodal_flag), dm, ncomps, guard_cells.ng_FieldSolver, lev, "m_face_areas[z]");
         }
         if(WarpX::electromagnetic_solver_id == ElectromagneticSolverAlgo::ECT) {
-            AllocInitMultiFab(m_edge_lengths[lev][0], amrex::convert(ba, Ex_nodal_flag), dm, ncomps, guard_cells.ng_FieldSolver, lev, "m_edge_lengths[x]");
-            AllocInitMultiFab(m_edge_lengths[lev][1], amrex::convert(ba, Ey_nodal_flag), dm, ncomps, guard_cells.ng_FieldSolver, lev, "m_edge_lengths[y]");
-            AllocInitMultiFab(m_edge_lengths[lev][2], amrex::convert(ba, Ez_nodal_flag), dm, ncomps, guard_cells.ng_FieldSolver, lev, "m_edge_lengths[z]");
-            AllocInitMultiFab(m_face_areas[lev][0], amrex::convert(ba, Bx_nodal_flag), dm, ncomps, guard_cells.ng_FieldSolver, lev, "m_face_areas[x]");
-            AllocInitMultiFab(m_face_areas[lev][1], amrex::convert(ba, By_nodal_flag), dm, ncomps, guard_cells.ng_FieldSolver, lev, "m_face_areas[y]");
-            AllocInitMultiFab(m_face_areas[lev][2], amrex::convert(ba, Bz_nodal_flag), dm, ncomps, guard_cells.ng_FieldSolver, lev, "m_face_areas[z]");
+            // m_edge_lengths and m_face_areas are allocated above, and m_flag_ext_face
+            // is only allocated while the face extensions are computed (see MarkCells)
             AllocInitMultiFab(m_flag_info_face[lev][0], amrex::convert(ba, Bx_nodal_flag), dm, ncomps, guard_cells.ng_FieldSolver, lev, "m_flag_info_face[x]");
             AllocInitMultiFab(m_flag_info_face[lev][1], amrex::convert(ba, By_nodal_flag), dm, ncomps, guard_cells.ng_FieldSolver, lev, "m_flag_info_face[y]");
             AllocInitMultiFab(m_flag_info_face[lev][2], amrex::convert(ba, Bz_nodal_flag), dm, ncomps, guard_cells.ng_FieldSolver, lev, "m_flag_info_face[z]");
-            AllocInitMultiFab(m_flag_ext_face[lev][0], amrex::convert(ba, Bx_nodal_flag), dm, ncomps, guard_cells.ng_FieldSolver, lev, "m_flag_ext_face[x]");
-            AllocInitMultiFab(m_flag_ext_face[lev][1], amrex::convert(ba, By_nodal_flag), dm, ncomps, guard_cells.ng_FieldSolver, lev, "m_flag_ext_face[y]");
-            AllocInitMultiFab(m_flag_ext_face[lev][2], amrex::convert(ba, Bz_nodal_flag), dm, ncomps, guard_cells.ng_FieldSolver, lev, "m_flag_ext_face[z]");
             AllocInitMultiFab(m_area_mod[lev][0], amrex::convert(ba, Bx_nodal_flag), dm, ncomps, guard_cells.ng_FieldSolver, lev, "m_area_mod[x]");
             AllocInitMultiFab(m_area_mod[lev][1], amrex::convert(ba, By_nodal_flag), dm, ncomps, guard_cells.ng_FieldSolver, lev, "m_area_mod[y]");
             AllocInitMultiFab(m_area_mod[lev][2], amrex::convert(ba, Bz_nodal_flag), dm, ncomps, guard_cells.ng_FieldSolver, lev, "m_area_mod[z]");
@@ -2442,6 +2688,7 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
 
     int rho_ncomps = 0;
     if( (electrostatic_solver_id == ElectrostaticSolverAlgo::LabFrame) ||
+        (electrostatic_solver_id == ElectrostaticSolverAlgo::LabFrameEffectivePotential) ||
         (electrostatic_solver_id == ElectrostaticSolverAlgo::LabFrameElectroMagnetostatic) ||
         (electromagnetic_solver_id == ElectromagneticSolverAlgo::HybridPIC) ) {
         rho_ncomps = ncomps;
@@ -2461,6 +2708,7 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
     }
 
     if (electrostatic_solver_id == ElectrostaticSolverAlgo::LabFrame ||
+        electrostatic_solver_id == ElectrostaticSolverAlgo::LabFrameEffectivePotential ||
         electrostatic_solver_id == ElectrostaticSolverAlgo::LabFrameElectroMagnetostatic)
     {
         const IntVect ngPhi = IntVect( AMREX_D_DECL(1,1,1) );
@@ -2757,6 +3005,8 @@ void WarpX::AllocLevelSpectralSolverRZ (amrex::Vector<std::unique_ptr<SpectralSo
                                         const amrex::DistributionMapping& dm,
                                         const std::array<Real,3>& dx)
 {
+    const StartupTimer::Scope startup_timer("spectral_solver");
+
     const RealVect dx_vect(dx[0], dx[2]);
 
     amrex::Real solver_dt = dt[lev];
@@ -2804,6 +3054,8 @@ void WarpX::AllocLevelSpectralSolver (amrex::Vector<std::unique_ptr<SpectralSolv
                                       const std::array<Real,3>& dx,
                                       const bool pml_flag)
 {
+    const StartupTimer::Scope startup_timer("spectral_solver");
+
 #if defined(WARPX_DIM_3D)
     const RealVect dx_vect(dx[0], dx[1], dx[2]);
 #elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
@@ -2815,9 +3067,30 @@ void WarpX::AllocLevelSpectralSolver (amrex::Vector<std::unique_ptr<SpectralSolv
     amrex::Real solver_dt = dt[lev];
     if (WarpX::do_multi_J) { solver_dt /= static_cast<amrex::Real>(WarpX::do_multi_J_n_depositions); }
 
+    // With the grouped decomposition, the FFTs are performed on the groups of
+    // adjacent boxes of each MPI rank, extended by the same guard cells
+    amrex::BoxArray solver_ba = realspace_ba;
+    amrex::DistributionMapping solver_dm = dm;
+    amrex::BoxArray fft_group_ba;
+    if (fft_decomposition == FFTDecomposition::Grouped && !pml_flag)
+    {
+        const amrex::IntVect& ng = guard_cells.ng_alloc_EB;
+        amrex::BoxArray valid_ba = realspace_ba;
+        valid_ba.grow(-ng);
+        GroupBoxesForFFT(valid_ba, dm, fft_group_ba, solver_dm);
+        if (fft_group_ba.size() < valid_ba.size()) {
+            solver_ba = fft_group_ba;
+            solver_ba.grow(ng);
+        } else {
+            // No box could be merged: keep the local decomposition
+            fft_group_ba = amrex::BoxArray();
+            solver_dm = dm;
+        }
+    }
+
     auto pss = std::make_unique<SpectralSolver>(lev,
-                                                realspace_ba,
-                                                dm,
+                                                solver_ba,
+                                                solver_dm,
                                                 nox_fft,
                                                 noy_fft,
                                                 noz_fft,
@@ -2834,9 +3107,35 @@ void WarpX::AllocLevelSpectralSolver (amrex::Vector<std::unique_ptr<SpectralSolv
                                                 J_in_time,
                                                 rho_in_time,
                                                 do_dive_cleaning,
-                                                do_divb_cleaning);
+                                                do_divb_cleaning,
+                                                fft_group_ba);
     spectral_solver[lev] = std::move(pss);
 }
+
+void WarpX::GroupBoxesForFFT (const amrex::BoxArray& ba, const amrex::DistributionMapping& dm,
+                              amrex::BoxArray& group_ba, amrex::DistributionMapping& group_dm)
+{
+    // The boxes of each rank are merged independently, in the same order on all ranks
+    amrex::Vector<amrex::BoxList> rank_boxes(amrex::ParallelDescriptor::NProcs());
+    for (int i = 0; i < static_cast<int>(ba.size()); ++i) {
+        rank_boxes[dm[i]].push_back(ba[i]);
+    }
+
+    amrex::BoxList group_bl;
+    amrex::Vector<int> group_ranks;
+    for (int rank = 0; rank < static_cast<int>(rank_boxes.size()); ++rank) {
+        auto& bl = rank_boxes[rank];
+        if (bl.isEmpty()) { continue; }
+        bl.simplify();
+        for (const auto& b : bl) {
+            group_bl.push_back(b);
+            group_ranks.push_back(rank);
+        }
+    }
+
+    group_ba = amrex::BoxArray(std::move(group_bl));
+    group_dm = amrex::DistributionMapping(std::move(group_ranks));
+}
 #   endif
 #endif
 
@@ -3343,7 +3642,9 @@ WarpX::AllocInitMultiFab (
     std::optional<const amrex::Real> initial_value)
 {
     const auto name_with_suffix = TagWithLevelSuffix(name, level);
-    const auto tag = amrex::MFInfo().SetTag(name_with_suffix);
+    auto tag = amrex::MFInfo().SetTag(name_with_suffix);
+    // keep the fields on the device when the particles are in managed memory
+    if (do_particle_memory_oversubscription) { tag.SetArena(amrex::The_Device_Arena()); }
     mf = std::make_unique<amrex::MultiFab>(ba, dm, ncomp, ngrow, tag);
     if (initial_value) {
         mf->setVal(*initial_value);
@@ -3363,7 +3664,9 @@ WarpX::AllocInitMultiFab (
     std::optional<const int> initial_value)
 {
     const auto name_with_suffix = TagWithLevelSuffix(name, level);
-    const auto tag = amrex::MFInfo().SetTag(name_with_suffix);
+    auto tag = amrex::MFInfo().SetTag(name_with_suffix);
+    // keep the fields on the device when the particles are in managed memory
+    if (do_particle_memory_oversubscription) { tag.SetArena(amrex::The_Device_Arena()); }
     mf = std::make_unique<amrex::iMultiFab>(ba, dm, ncomp, ngrow, tag);
     if (initial_value) {
         mf->setVal(*initial_value);
@@ -3398,7 +3701,9 @@ WarpX::AllocInitMultiFabFromModel (
     std::optional<const amrex::Real> initial_value)
 {
     const auto name_with_suffix = TagWithLevelSuffix(name, level);
-    const auto tag = amrex::MFInfo().SetTag(name_with_suffix);
+    auto tag = amrex::MFInfo().SetTag(name_with_suffix);
+    // keep the fields on the device when the particles are in managed memory
+    if (do_particle_memory_oversubscription) { tag.SetArena(amrex::The_Device_Arena()); }
     mf = std::make_unique<amrex::MultiFab>(mf_model.boxArray(), mf_model.DistributionMap(),
                                            mf_model.nComp(), mf_model.nGrowVect(), tag);
     if (initial_value) {
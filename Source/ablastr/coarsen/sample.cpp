@@ -10,6 +10,7 @@
 
 #include <AMReX_BLProfiler.H>
 #include <AMReX_BoxArray.H>
+#include <AMReX_BoxList.H>
 #include <AMReX_Config.H>
 #include <AMReX_DistributionMapping.H>
 #include <AMReX_FArrayBox.H>
@@ -20,23 +21,96 @@
 #include <AMReX_IntVect.H>
 #include <AMReX_MFIter.H>
 #include <AMReX_MultiFab.H>
+#include <AMReX_Vector.H>
 
 #include <memory>
+#include <vector>
 
 
-namespace ablastr::coarsen::sample
+namespace
 {
+    /** Boxes of the coarsened source BoxArray of Coarsen that intersect the destination,
+     *  with the owners and the indices of the corresponding source boxes */
+    struct RestrictedLayout
+    {
+        // the source and destination layouts, kept so that their ids are not reused
+        amrex::BoxArray src_ba;
+        amrex::DistributionMapping src_dm;
+        amrex::BoxArray dst_ba;
+        amrex::IntVect crse_ratio;
+
+        amrex::BoxArray ba;
+        amrex::DistributionMapping dm;
+        amrex::Vector<int> src_index;
+    };
+
+    /** Get the restricted layout of the temporary MultiFab of Coarsen. The layouts are
+     *  cached, so that the same BoxArray is used at each call, and AMReX reuses the
+     *  communication metadata of the ParallelCopy into the destination (e.g. for the
+     *  diagnostics of a slice of the domain, at every output). */
+    RestrictedLayout const&
+    getRestrictedLayout (
+        const amrex::MultiFab& mf_dst,
+        const amrex::MultiFab& mf_src,
+        const amrex::BoxArray& ba_tmp,
+        const amrex::IntVect crse_ratio
+    )
+    {
+        static std::vector<RestrictedLayout> cache;
+
+        for (auto const& layout : cache) {
+            if (layout.src_ba.getRefID() == mf_src.boxArray().getRefID() &&
+                layout.src_ba.ixType() == mf_src.boxArray().ixType() &&
+                layout.src_dm == mf_src.DistributionMap() &&
+                layout.dst_ba.getRefID() == mf_dst.boxArray().getRefID() &&
+                layout.dst_ba.ixType() == mf_dst.boxArray().ixType() &&
+                layout.crse_ratio == crse_ratio) {
+                return layout;
+            }
+        }
+
+        // the layouts of the previous grids are not needed after a regrid
+        constexpr std::size_t max_cache_size = 64;
+        if (cache.size() >= max_cache_size) { cache.clear(); }
+
+        RestrictedLayout layout{mf_src.boxArray(), mf_src.DistributionMap(),
+                                mf_dst.boxArray(), crse_ratio, {}, {}, {}};
+        const amrex::Box dst_region = mf_dst.boxArray().minimalBox();
+        amrex::BoxList bl(ba_tmp.ixType());
+        amrex::Vector<int> pmap;
+        for (int i = 0; i < static_cast<int>(ba_tmp.size()); ++i) {
+            const amrex::Box b = ba_tmp[i] & dst_region;
+            if (b.ok()) {
+                bl.push_back(b);
+                pmap.push_back(mf_src.DistributionMap()[i]);
+                layout.src_index.push_back(i);
+            }
+        }
+        if (!bl.isEmpty()) {
+            layout.ba = amrex::BoxArray(std::move(bl));
+            layout.dm = amrex::DistributionMapping(std::move(pmap));
+        }
+        cache.push_back(std::move(layout));
+        return cache.back();
+    }
+
+    /** Loop of ablastr::coarsen::sample::Loop. Without src_index, mf_dst and mf_src have
+     *  the same DistributionMapping and box indices; otherwise, box i of mf_dst is inside
+     *  the coarsened box src_index[i] of mf_src, on the same rank. */
     void
-    Loop (
+    LoopImpl (
         amrex::MultiFab& mf_dst,
         const amrex::MultiFab& mf_src,
         const int dcomp,
         const int scomp,
         const int ncomp,
         const amrex::IntVect ngrowvect,
-        const amrex::IntVect crse_ratio
+        const amrex::IntVect crse_ratio,
+        amrex::Vector<int> const* src_index
     )
     {
+        using namespace ablastr::coarsen::sample;
+
         // Staggering of source fine MultiFab and destination coarse MultiFab
         const amrex::IntVect stag_src = mf_src.boxArray().ixType().toIntVect();
         const amrex::IntVect stag_dst = mf_dst.boxArray().ixType().toIntVect();
@@ -69,7 +143,8 @@ namespace ablastr::coarsen::sample
             // Tiles defined at the coarse level
             const amrex::Box& bx = mfi.growntilebox( ngrowvect );
             amrex::Array4<amrex::Real> const& arr_dst = mf_dst.array( mfi );
-            amrex::Array4<amrex::Real const> const& arr_src = mf_src.const_array( mfi );
+            amrex::Array4<amrex::Real const> const& arr_src = src_index ?
+                mf_src.const_array( (*src_index)[mfi.index()] ) : mf_src.const_array( mfi );
             ParallelFor( bx, ncomp,
                          [=] AMREX_GPU_DEVICE( int i, int j, int k, int n )
                          {
@@ -78,6 +153,23 @@ namespace ablastr::coarsen::sample
                          } );
         }
     }
+}
+
+namespace ablastr::coarsen::sample
+{
+    void
+    Loop (
+        amrex::MultiFab& mf_dst,
+        const amrex::MultiFab& mf_src,
+        const int dcomp,
+        const int scomp,
+        const int ncomp,
+        const amrex::IntVect ngrowvect,
+        const amrex::IntVect crse_ratio
+    )
+    {
+        LoopImpl( mf_dst, mf_src, dcomp, scomp, ncomp, ngrowvect, crse_ratio, nullptr );
+    }
 
     void
     Coarsen (
@@ -124,10 +216,14 @@ namespace ablastr::coarsen::sample
         } else
         {
             // Cannot coarsen into MultiFab with different BoxArray or DistributionMapping:
-            // 1) create temporary MultiFab on coarsened version of source BoxArray with same DistributionMapping
-            amrex::MultiFab mf_tmp( ba_tmp, mf_src.DistributionMap(), ncomp, ngrowvect, amrex::MFInfo(), amrex::FArrayBoxFactory() );
+            // 1) create temporary MultiFab on the boxes of the coarsened version of source
+            //    BoxArray that intersect mf_dst (e.g. a slice of the domain), on the same ranks
+            //    (the guard cells of mf_tmp are not copied to mf_dst, and are not needed)
+            RestrictedLayout const& layout = getRestrictedLayout( mf_dst, mf_src, ba_tmp, crse_ratio );
+            if ( layout.ba.empty() ) { return; }
+            amrex::MultiFab mf_tmp( layout.ba, layout.dm, ncomp, 0, amrex::MFInfo(), amrex::FArrayBoxFactory() );
             // 2) interpolate from mf_src to mf_tmp (start writing into component 0)
-            Loop( mf_tmp, mf_src, 0, scomp, ncomp, ngrowvect, crse_ratio );
+            LoopImpl( mf_tmp, mf_src, 0, scomp, ncomp, amrex::IntVect(0), crse_ratio, &layout.src_index );
             // 3) copy from mf_tmp to mf_dst (with different BoxArray or DistributionMapping)
             mf_dst.ParallelCopy( mf_tmp, 0, dcomp, ncomp );
         }
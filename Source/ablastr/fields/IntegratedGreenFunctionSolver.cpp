@@ -7,14 +7,18 @@
 #include "IntegratedGreenFunctionSolver.H"
 
 #include <ablastr/constant.H>
+#include <ablastr/utils/ScratchPool.H>
+#include <ablastr/utils/TextMsg.H>
 #include <ablastr/warn_manager/WarnManager.H>
 #include <ablastr/math/fft/AnyFFT.H>
 
+#include <AMReX.H>
 #include <AMReX_Array4.H>
 #include <AMReX_BaseFab.H>
 #include <AMReX_BLassert.H>
 #include <AMReX_Box.H>
 #include <AMReX_BoxArray.H>
+#include <AMReX_BoxList.H>
 #include <AMReX_Config.H>
 #include <AMReX_DistributionMapping.H>
 #include <AMReX_FabArray.H>
@@ -25,13 +29,84 @@
 #include <AMReX_MFIter.H>
 #include <AMReX_MLLinOp.H>
 #include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
 #include <AMReX_REAL.H>
+#include <AMReX_Vector.H>
+
+#if defined(ABLASTR_USE_HEFFTE)
+#   include <heffte.h>
+#endif
 
 #include <array>
+#include <memory>
 
 
 namespace ablastr::fields {
 
+namespace {
+    using SpectralField = amrex::FabArray< amrex::BaseFab< amrex::GpuComplex< amrex::Real > > >;
+
+    /** @brief Fourier transform of the integrated Green function, kept across calls
+     *
+     * The Green function only depends on the size of the (doubled) domain and on the
+     * cell size, so that its transform can be reused as long as these do not change.
+     */
+    struct GreenFunctionCache
+    {
+        amrex::IntVect m_domain_size; /**< number of points of the physical domain */
+        std::array<amrex::Real, 3> m_cell_size; /**< cell size used in the Green function */
+        std::unique_ptr<SpectralField> m_G_fft; /**< forward FFT of the Green function */
+
+        [[nodiscard]] bool
+        isValidFor (amrex::IntVect const & domain_size,
+                    std::array<amrex::Real, 3> const & cell_size,
+                    amrex::BoxArray const & spectralspace_ba,
+                    amrex::DistributionMapping const & dm) const
+        {
+            return m_G_fft &&
+                   m_domain_size == domain_size && m_cell_size == cell_size &&
+                   m_G_fft->boxArray() == spectralspace_ba &&
+                   m_G_fft->DistributionMap() == dm;
+        }
+
+        void clear () { m_G_fft.reset(); }
+    };
+
+    GreenFunctionCache green_function_cache;
+
+#if defined(ABLASTR_USE_HEFFTE)
+    /** @brief Decompose a box in slabs along z, with one slab per MPI rank
+     *
+     * @param[in] box the box to decompose
+     * @param[in] nslabs the number of slabs
+     * @return the amrex::BoxArray of the slabs, ordered by increasing z
+     */
+    amrex::BoxArray
+    decomposeInSlabs (amrex::Box const & box, int nslabs)
+    {
+        amrex::BoxList bl(box.ixType());
+        int const zlo = box.smallEnd(2);
+        int const nz = box.length(2);
+        for (int islab = 0; islab < nslabs; ++islab) {
+            amrex::Box slab = box;
+            slab.setSmall(2, zlo + (islab*nz)/nslabs);
+            slab.setBig(2, zlo + ((islab+1)*nz)/nslabs - 1);
+            bl.push_back(slab);
+        }
+        return amrex::BoxArray(bl);
+    }
+
+    /** @brief Convert an amrex::Box into a heFFTe box, with indices relative to `origin` */
+    heffte::box3d<int>
+    toHeffteBox (amrex::Box const & box, amrex::IntVect const & origin)
+    {
+        return heffte::box3d<int>(
+            {box.smallEnd(0)-origin[0], box.smallEnd(1)-origin[1], box.smallEnd(2)-origin[2]},
+            {box.bigEnd(0)-origin[0], box.bigEnd(1)-origin[1], box.bigEnd(2)-origin[2]} );
+    }
+#endif
+} // namespace
+
 void
 computePhiIGF ( amrex::MultiFab const & rho,
                 amrex::MultiFab & phi,
@@ -50,90 +125,182 @@ computePhiIGF ( amrex::MultiFab const & rho,
     int const nz = domain.length(2);
 
     // Allocate 2x wider arrays for the convolution of rho with the Green function
-    // This also defines the box arrays for the global FFT: contains only one box;
     amrex::Box const realspace_box = amrex::Box(
         {domain.smallEnd(0), domain.smallEnd(1), domain.smallEnd(2)},
         {2*nx-1+domain.smallEnd(0), 2*ny-1+domain.smallEnd(1), 2*nz-1+domain.smallEnd(2)},
         amrex::IntVect::TheNodeVector() );
-    amrex::BoxArray const realspace_ba = amrex::BoxArray( realspace_box );
     amrex::Box const spectralspace_box = amrex::Box(
         {0,0,0},
         {nx, 2*ny-1, 2*nz-1},
         amrex::IntVect::TheNodeVector() );
+#if !defined(ABLASTR_USE_HEFFTE)
+    // Define the box arrays for the global FFT: contains only one box
+    amrex::BoxArray const realspace_ba = amrex::BoxArray( realspace_box );
     amrex::BoxArray const spectralspace_ba = amrex::BoxArray( spectralspace_box );
     // Define a distribution mapping for the global FFT, with only one box
     amrex::DistributionMapping dm_global_fft;
     dm_global_fft.define( realspace_ba );
-    // Allocate required arrays
-    amrex::MultiFab tmp_rho = amrex::MultiFab(realspace_ba, dm_global_fft, 1, 0);
-    tmp_rho.setVal(0);
-    amrex::MultiFab tmp_G = amrex::MultiFab(realspace_ba, dm_global_fft, 1, 0);
-    tmp_G.setVal(0);
-    // Allocate corresponding arrays in Fourier space
-    using SpectralField = amrex::FabArray< amrex::BaseFab< amrex::GpuComplex< amrex::Real > > >;
-    SpectralField tmp_rho_fft = SpectralField( spectralspace_ba, dm_global_fft, 1, 0 );
-    SpectralField tmp_G_fft = SpectralField( spectralspace_ba, dm_global_fft, 1, 0 );
+#else
+    // Define the box arrays for the distributed FFT: one slab along z per MPI rank.
+    // Both box arrays have the same extent along z, hence the same number of slabs.
+    int const nprocs = amrex::ParallelDescriptor::NProcs();
+    ABLASTR_ALWAYS_ASSERT_WITH_MESSAGE( 2*nz >= nprocs,
+        "The distributed IGF solver requires at least one z-slab of the doubled domain per MPI rank.");
+    amrex::BoxArray const realspace_ba = decomposeInSlabs( realspace_box, nprocs );
+    amrex::BoxArray const spectralspace_ba = decomposeInSlabs( spectralspace_box, nprocs );
+    // Define a distribution mapping with the slab of index i on MPI rank i
+    amrex::Vector<int> slab_to_rank(nprocs);
+    for (int i = 0; i < nprocs; ++i) { slab_to_rank[i] = i; }
+    amrex::DistributionMapping const dm_global_fft( slab_to_rank );
 
-    // Copy from rho to tmp_rho
-    tmp_rho.ParallelCopy( rho, 0, 0, 1, amrex::IntVect::TheZeroVector(), amrex::IntVect::TheZeroVector() );
+#if defined(AMREX_USE_CUDA)
+    using heffte_backend = heffte::backend::cufft;
+#elif defined(AMREX_USE_HIP)
+    using heffte_backend = heffte::backend::rocfft;
+#else
+    using heffte_backend = heffte::backend::fftw;
+#endif
+    using heffte_complex = typename heffte::fft_output<amrex::Real>::type;
+
+    // Each rank owns exactly one slab in real and spectral space
+    int const local_boxid = amrex::ParallelDescriptor::MyProc();
 
-    // Compute the integrated Green function
+    // The real-to-complex transform halves the spectral domain along x (direction 0)
+    heffte::fft3d_r2c<heffte_backend> fft(
+        toHeffteBox( realspace_ba[local_boxid], realspace_box.smallEnd() ),
+        toHeffteBox( spectralspace_ba[local_boxid], amrex::IntVect::TheZeroVector() ),
+        0, amrex::ParallelDescriptor::Communicator() );
+#endif
+
+    // Compute the Fourier transform of the integrated Green function,
+    // unless it is still in the cache from a previous call
+    amrex::IntVect const domain_size(nx, ny, nz);
+    if (!green_function_cache.isValidFor( domain_size, cell_size, spectralspace_ba, dm_global_fft ))
     {
-    BL_PROFILE("Initialize Green function");
-    amrex::BoxArray const domain_ba = amrex::BoxArray( domain );
+        BL_PROFILE("Initialize Green function");
+        amrex::MultiFab tmp_G = amrex::MultiFab(realspace_ba, dm_global_fft, 1, 0);
+        tmp_G.setVal(0);
+        auto tmp_G_fft = std::make_unique<SpectralField>( spectralspace_ba, dm_global_fft, 1, 0 );
+
+        amrex::Real const dx = cell_size[0];
+        amrex::Real const dy = cell_size[1];
+        amrex::Real const dz = cell_size[2];
+        amrex::IntVect const lo = realspace_box.smallEnd();
+#if !defined(ABLASTR_USE_HEFFTE)
+        amrex::BoxArray const domain_ba = amrex::BoxArray( domain );
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
-    for (amrex::MFIter mfi(domain_ba, dm_global_fft,amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+        for (amrex::MFIter mfi(domain_ba, dm_global_fft,amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi) {
 
-        amrex::Box const bx = mfi.tilebox();
+            amrex::Box const bx = mfi.tilebox();
 
-        amrex::IntVect const lo = realspace_box.smallEnd();
-        amrex::IntVect const hi = realspace_box.bigEnd();
+            amrex::IntVect const hi = realspace_box.bigEnd();
 
-        // Fill values of the Green function
-        amrex::Real const dx = cell_size[0];
-        amrex::Real const dy = cell_size[1];
-        amrex::Real const dz = cell_size[2];
-        amrex::Array4<amrex::Real> const tmp_G_arr = tmp_G.array(mfi);
-        amrex::ParallelFor( bx,
-            [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
-            {
-                int const i0 = i - lo[0];
-                int const j0 = j - lo[1];
-                int const k0 = k - lo[2];
-                amrex::Real const x = i0*dx;
-                amrex::Real const y = j0*dy;
-                amrex::Real const z = k0*dz;
-
-                amrex::Real const G_value = 1._rt/(4._rt*ablastr::constant::math::pi*ablastr::constant::SI::ep0) * (
-                    IntegratedPotential( x+0.5_rt*dx, y+0.5_rt*dy, z+0.5_rt*dz )
-                  - IntegratedPotential( x-0.5_rt*dx, y+0.5_rt*dy, z+0.5_rt*dz )
-                  - IntegratedPotential( x+0.5_rt*dx, y-0.5_rt*dy, z+0.5_rt*dz )
-                  - IntegratedPotential( x+0.5_rt*dx, y+0.5_rt*dy, z-0.5_rt*dz )
-                  + IntegratedPotential( x+0.5_rt*dx, y-0.5_rt*dy, z-0.5_rt*dz )
-                  + IntegratedPotential( x-0.5_rt*dx, y+0.5_rt*dy, z-0.5_rt*dz )
-                  + IntegratedPotential( x-0.5_rt*dx, y-0.5_rt*dy, z+0.5_rt*dz )
-                  - IntegratedPotential( x-0.5_rt*dx, y-0.5_rt*dy, z-0.5_rt*dz )
-                );
-
-                tmp_G_arr(i,j,k) = G_value;
-                // Fill the rest of the array by periodicity
-                if (i0>0) {tmp_G_arr(hi[0]+1-i0, j         , k         ) = G_value;}
-                if (j0>0) {tmp_G_arr(i         , hi[1]+1-j0, k         ) = G_value;}
-                if (k0>0) {tmp_G_arr(i         , j         , hi[2]+1-k0) = G_value;}
-                if ((i0>0)&&(j0>0)) {tmp_G_arr(hi[0]+1-i0, hi[1]+1-j0, k         ) = G_value;}
-                if ((j0>0)&&(k0>0)) {tmp_G_arr(i         , hi[1]+1-j0, hi[2]+1-k0) = G_value;}
-                if ((i0>0)&&(k0>0)) {tmp_G_arr(hi[0]+1-i0, j         , hi[2]+1-k0) = G_value;}
-                if ((i0>0)&&(j0>0)&&(k0>0)) {tmp_G_arr(hi[0]+1-i0, hi[1]+1-j0, hi[2]+1-k0) = G_value;}
-            }
-        );
-    }
+            // Fill values of the Green function
+            amrex::Array4<amrex::Real> const tmp_G_arr = tmp_G.array(mfi);
+            amrex::ParallelFor( bx,
+                [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
+                {
+                    int const i0 = i - lo[0];
+                    int const j0 = j - lo[1];
+                    int const k0 = k - lo[2];
+                    amrex::Real const x = i0*dx;
+                    amrex::Real const y = j0*dy;
+                    amrex::Real const z = k0*dz;
+
+                    amrex::Real const G_value = 1._rt/(4._rt*ablastr::constant::math::pi*ablastr::constant::SI::ep0) *
+                        SumOfIntegratedPotential( x, y, z, dx, dy, dz );
+
+                    tmp_G_arr(i,j,k) = G_value;
+                    // Fill the rest of the array by periodicity
+                    if (i0>0) {tmp_G_arr(hi[0]+1-i0, j         , k         ) = G_value;}
+                    if (j0>0) {tmp_G_arr(i         , hi[1]+1-j0, k         ) = G_value;}
+                    if (k0>0) {tmp_G_arr(i         , j         , hi[2]+1-k0) = G_value;}
+                    if ((i0>0)&&(j0>0)) {tmp_G_arr(hi[0]+1-i0, hi[1]+1-j0, k         ) = G_value;}
+                    if ((j0>0)&&(k0>0)) {tmp_G_arr(i         , hi[1]+1-j0, hi[2]+1-k0) = G_value;}
+                    if ((i0>0)&&(k0>0)) {tmp_G_arr(hi[0]+1-i0, j         , hi[2]+1-k0) = G_value;}
+                    if ((i0>0)&&(j0>0)&&(k0>0)) {tmp_G_arr(hi[0]+1-i0, hi[1]+1-j0, hi[2]+1-k0) = G_value;}
+                }
+            );
+        }
+
+        // Forward FFT of G
+        for ( amrex::MFIter mfi(realspace_ba, dm_global_fft); mfi.isValid(); ++mfi ){
+
+            // Note: the size of the real-space box and spectral-space box
+            // differ when using real-to-complex FFT. When initializing
+            // the FFT plan, the valid dimensions are those of the real-space box.
+            const amrex::IntVect fft_size = realspace_ba[mfi].length();
+
+            auto forward_plan_G = ablastr::math::anyfft::CreatePlan(
+                fft_size, tmp_G[mfi].dataPtr(),
+                reinterpret_cast<ablastr::math::anyfft::Complex*>((*tmp_G_fft)[mfi].dataPtr()),
+                ablastr::math::anyfft::direction::R2C, AMREX_SPACEDIM);
+            ablastr::math::anyfft::Execute(forward_plan_G);
+            ablastr::math::anyfft::DestroyPlan(forward_plan_G);
+        }
+#else
+        // Each rank fills its own slab: the value at a point of the doubled domain
+        // is obtained from the periodic image of the offset within the physical domain
+        // (the offset n, which has no image, is left to 0).
+        for (amrex::MFIter mfi(realspace_ba, dm_global_fft,amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+
+            amrex::Box const bx = mfi.tilebox();
+
+            amrex::Array4<amrex::Real> const tmp_G_arr = tmp_G.array(mfi);
+            amrex::ParallelFor( bx,
+                [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
+                {
+                    int const di = i - lo[0];
+                    int const dj = j - lo[1];
+                    int const dk = k - lo[2];
+                    if (di == nx || dj == ny || dk == nz) { return; }
+                    int const i0 = (di < nx) ? di : 2*nx - di;
+                    int const j0 = (dj < ny) ? dj : 2*ny - dj;
+                    int const k0 = (dk < nz) ? dk : 2*nz - dk;
+
+                    tmp_G_arr(i,j,k) = 1._rt/(4._rt*ablastr::constant::math::pi*ablastr::constant::SI::ep0) *
+                        SumOfIntegratedPotential( i0*dx, j0*dy, k0*dz, dx, dy, dz );
+                }
+            );
+        }
+
+        // Forward FFT of G
+        fft.forward( tmp_G[local_boxid].dataPtr(),
+                     reinterpret_cast<heffte_complex*>( (*tmp_G_fft)[local_boxid].dataPtr() ) );
+#endif
+
+        green_function_cache.m_domain_size = domain_size;
+        green_function_cache.m_cell_size = cell_size;
+        green_function_cache.m_G_fft = std::move(tmp_G_fft);
+
+        // The cached FabArray must be freed before AMReX is finalized
+        // (and registered again if AMReX is initialized again, e.g. from Python)
+        static bool clear_on_finalize_registered = false;
+        if (!clear_on_finalize_registered) {
+            amrex::ExecOnFinalize( [] () {
+                green_function_cache.clear();
+                clear_on_finalize_registered = false;
+            });
+            clear_on_finalize_registered = true;
+        }
     }
+    SpectralField const & G_fft = *green_function_cache.m_G_fft;
 
+    // Allocate the arrays for rho, in real and Fourier space
+    // (from the scratch pool in real space, since this is done at every step)
+    ablastr::utils::scratch::ScratchMultiFab tmp_rho_scratch(realspace_ba, dm_global_fft, 1, 0);
+    amrex::MultiFab& tmp_rho = *tmp_rho_scratch;
+    tmp_rho.setVal(0);
+    SpectralField tmp_rho_fft = SpectralField( spectralspace_ba, dm_global_fft, 1, 0 );
+
+    // Copy from rho to tmp_rho
+    tmp_rho.ParallelCopy( rho, 0, 0, 1, amrex::IntVect::TheZeroVector(), amrex::IntVect::TheZeroVector() );
+
+#if !defined(ABLASTR_USE_HEFFTE)
     // Perform forward FFTs
     auto forward_plan_rho = ablastr::math::anyfft::FFTplans(spectralspace_ba, dm_global_fft);
-    auto forward_plan_G = ablastr::math::anyfft::FFTplans(spectralspace_ba, dm_global_fft);
     // Loop over boxes perform FFTs
     for ( amrex::MFIter mfi(realspace_ba, dm_global_fft); mfi.isValid(); ++mfi ){
 
@@ -148,19 +315,11 @@ computePhiIGF ( amrex::MultiFab const & rho,
             reinterpret_cast<ablastr::math::anyfft::Complex*>(tmp_rho_fft[mfi].dataPtr()),
             ablastr::math::anyfft::direction::R2C, AMREX_SPACEDIM);
         ablastr::math::anyfft::Execute(forward_plan_rho[mfi]);
-
-        // FFT of G
-        forward_plan_G[mfi] = ablastr::math::anyfft::CreatePlan(
-            fft_size, tmp_G[mfi].dataPtr(),
-            reinterpret_cast<ablastr::math::anyfft::Complex*>(tmp_G_fft[mfi].dataPtr()),
-            ablastr::math::anyfft::direction::R2C, AMREX_SPACEDIM);
-        ablastr::math::anyfft::Execute(forward_plan_G[mfi]);
-
     }
 
-    // Multiply tmp_G_fft and tmp_rho_fft in spectral space
-    // Store the result in-place in Gtmp_G_fft, to save memory
-    amrex::Multiply( tmp_G_fft, tmp_rho_fft, 0, 0, 1, 0);
+    // Multiply tmp_rho_fft by the (cached) G_fft in spectral space
+    // Store the result in-place in tmp_rho_fft, to save memory
+    amrex::Multiply( tmp_rho_fft, G_fft, 0, 0, 1, 0);
 
     // Perform inverse FFT
     auto backward_plan = ablastr::math::anyfft::FFTplans(spectralspace_ba, dm_global_fft);
@@ -172,25 +331,42 @@ computePhiIGF ( amrex::MultiFab const & rho,
         // the FFT plan, the valid dimensions are those of the real-space box.
         const amrex::IntVect fft_size = realspace_ba[mfi].length();
 
-        // Inverse FFT: is done in-place, in the array of G
+        // Inverse FFT: is done in-place, in the array of rho
         backward_plan[mfi] = ablastr::math::anyfft::CreatePlan(
-            fft_size, tmp_G[mfi].dataPtr(),
-            reinterpret_cast<ablastr::math::anyfft::Complex*>( tmp_G_fft[mfi].dataPtr()),
+            fft_size, tmp_rho[mfi].dataPtr(),
+            reinterpret_cast<ablastr::math::anyfft::Complex*>( tmp_rho_fft[mfi].dataPtr()),
             ablastr::math::anyfft::direction::C2R, AMREX_SPACEDIM);
         ablastr::math::anyfft::Execute(backward_plan[mfi]);
     }
+#else
+    {
+    BL_PROFILE("ablastr::fields::computePhiIGF: distributed FFTs");
+    auto* const rho_fft_data = reinterpret_cast<heffte_complex*>( tmp_rho_fft[local_boxid].dataPtr() );
+
+    // Perform forward FFT
+    fft.forward( tmp_rho[local_boxid].dataPtr(), rho_fft_data );
+
+    // Multiply tmp_rho_fft by the (cached) G_fft in spectral space
+    // Store the result in-place in tmp_rho_fft, to save memory
+    amrex::Multiply( tmp_rho_fft, G_fft, 0, 0, 1, 0);
+
+    // Inverse FFT: is done in-place, in the array of rho
+    fft.backward( rho_fft_data, tmp_rho[local_boxid].dataPtr() );
+    }
+#endif
     // Normalize, since (FFT + inverse FFT) results in a factor N
     const amrex::Real normalization = 1._rt / realspace_box.numPts();
-    tmp_G.mult( normalization );
+    tmp_rho.mult( normalization );
 
-    // Copy from tmp_G to phi
-    phi.ParallelCopy( tmp_G, 0, 0, 1, amrex::IntVect::TheZeroVector(), phi.nGrowVect() );
+    // Copy from tmp_rho to phi
+    phi.ParallelCopy( tmp_rho, 0, 0, 1, amrex::IntVect::TheZeroVector(), phi.nGrowVect() );
 
+#if !defined(ABLASTR_USE_HEFFTE)
     // Loop to destroy FFT plans
     for ( amrex::MFIter mfi(spectralspace_ba, dm_global_fft); mfi.isValid(); ++mfi ){
-        ablastr::math::anyfft::DestroyPlan(forward_plan_G[mfi]);
         ablastr::math::anyfft::DestroyPlan(forward_plan_rho[mfi]);
         ablastr::math::anyfft::DestroyPlan(backward_plan[mfi]);
     }
+#endif
 }
 } // namespace ablastr::fields
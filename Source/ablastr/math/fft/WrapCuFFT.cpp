@@ -10,12 +10,31 @@
 #include "ablastr/utils/TextMsg.H"
 #include "ablastr/profiler/ProfilerWrapper.H"
 
+#include <array>
+#include <map>
+#include <tuple>
+
 namespace ablastr::math::anyfft
 {
 
+    namespace
+    {
+        /** Key of the plan cache: size, dimension, direction and number of transforms */
+        using PlanKey = std::tuple<std::array<int,3>, int, direction, int>;
+
+        /** Plans shared by all the boxes with the same shape */
+        std::map<PlanKey, VendorFFTPlan> plan_cache;
+    }
+
     void setup(){/*nothing to do*/}
 
-    void cleanup(){/*nothing to do*/}
+    void cleanup()
+    {
+        for (auto& key_plan : plan_cache) {
+            cufftDestroy(key_plan.second);
+        }
+        plan_cache.clear();
+    }
 
 #ifdef AMREX_USE_FLOAT
     cufftType VendorR2C = CUFFT_R2C;
@@ -28,14 +47,47 @@ namespace ablastr::math::anyfft
     std::string cufftErrorToString (const cufftResult& err);
 
     FFTplan CreatePlan(const amrex::IntVect& real_size, amrex::Real * const real_array,
-                       Complex * const complex_array, const direction dir, const int dim)
+                       Complex * const complex_array, const direction dir, const int dim,
+                       const int howmany)
     {
         FFTplan fft_plan;
         ABLASTR_PROFILE("ablastr::math::anyfft::CreatePlan");
 
+        // Store meta-data in fft_plan
+        fft_plan.m_real_array = real_array;
+        fft_plan.m_complex_array = complex_array;
+        fft_plan.m_dir = dir;
+        fft_plan.m_dim = dim;
+
+        // Reuse the plan of a box with the same shape, if any
+        std::array<int,3> size = {1, 1, 1};
+        for (int i = 0; i < dim; ++i) { size[i] = real_size[i]; }
+        const PlanKey key{size, dim, dir, howmany};
+        if (const auto it = plan_cache.find(key); it != plan_cache.end()) {
+            fft_plan.m_plan = it->second;
+            return fft_plan;
+        }
+
         // Initialize fft_plan.m_plan with the vendor fft plan.
         cufftResult result;
-        if (dir == direction::R2C){
+        if (howmany > 1) {
+            ABLASTR_ALWAYS_ASSERT_WITH_MESSAGE(dim == 2 || dim == 3,
+                "only dim=2 and dim=3 have been implemented");
+            // cuFFT is C-order, AMReX FAB are Fortran-order
+            int n[3];
+            for (int i = 0; i < dim; ++i) { n[i] = real_size[dim-1-i]; }
+            int real_dist = 1;
+            for (int i = 0; i < dim; ++i) { real_dist *= n[i]; }
+            const int complex_dist = real_dist / n[dim-1] * (n[dim-1]/2 + 1);
+            // With null embeddings, the arrays of the batch are contiguous
+            if (dir == direction::R2C) {
+                result = cufftPlanMany(&(fft_plan.m_plan), dim, n, nullptr, 1, real_dist,
+                                       nullptr, 1, complex_dist, VendorR2C, howmany);
+            } else {
+                result = cufftPlanMany(&(fft_plan.m_plan), dim, n, nullptr, 1, complex_dist,
+                                       nullptr, 1, real_dist, VendorC2R, howmany);
+            }
+        } else if (dir == direction::R2C){
             if (dim == 3) {
                 result = cufftPlan3d(
                     &(fft_plan.m_plan), real_size[2], real_size[1], real_size[0], VendorR2C);
@@ -60,19 +112,14 @@ namespace ablastr::math::anyfft
         ABLASTR_ALWAYS_ASSERT_WITH_MESSAGE(result == CUFFT_SUCCESS,
             "cufftplan failed! Error: " + cufftErrorToString(result));
 
-        // Store meta-data in fft_plan
-        fft_plan.m_real_array = real_array;
-        fft_plan.m_complex_array = complex_array;
-        fft_plan.m_dir = dir;
-        fft_plan.m_dim = dim;
+        plan_cache[key] = fft_plan.m_plan;
 
         return fft_plan;
     }
 
-    void DestroyPlan(FFTplan& fft_plan)
+    void DestroyPlan(FFTplan& /*fft_plan*/)
     {
-        ABLASTR_PROFILE("ablastr::math::anyfft::DestroyPlan");
-        cufftDestroy( fft_plan.m_plan );
+        // The cached plans are destroyed in cleanup()
     }
 
     void Execute(FFTplan& fft_plan){
@@ -25,15 +25,20 @@ namespace ablastr::math::anyfft
     const auto VendorCreatePlanC2R3D = fftwf_plan_dft_c2r_3d;
     const auto VendorCreatePlanR2C2D = fftwf_plan_dft_r2c_2d;
     const auto VendorCreatePlanC2R2D = fftwf_plan_dft_c2r_2d;
+    const auto VendorCreatePlanManyR2C = fftwf_plan_many_dft_r2c;
+    const auto VendorCreatePlanManyC2R = fftwf_plan_many_dft_c2r;
 #else
     const auto VendorCreatePlanR2C3D = fftw_plan_dft_r2c_3d;
     const auto VendorCreatePlanC2R3D = fftw_plan_dft_c2r_3d;
     const auto VendorCreatePlanR2C2D = fftw_plan_dft_r2c_2d;
     const auto VendorCreatePlanC2R2D = fftw_plan_dft_c2r_2d;
+    const auto VendorCreatePlanManyR2C = fftw_plan_many_dft_r2c;
+    const auto VendorCreatePlanManyC2R = fftw_plan_many_dft_c2r;
 #endif
 
     FFTplan CreatePlan(const amrex::IntVect& real_size, amrex::Real * const real_array,
-                       Complex * const complex_array, const direction dir, const int dim)
+                       Complex * const complex_array, const direction dir, const int dim,
+                       const int howmany)
     {
         FFTplan fft_plan;
 
@@ -49,7 +54,25 @@ namespace ablastr::math::anyfft
 
         // Initialize fft_plan.m_plan with the vendor fft plan.
         // Swap dimensions: AMReX FAB are Fortran-order but FFTW is C-order
-        if (dir == direction::R2C){
+        if (howmany > 1) {
+            ABLASTR_ALWAYS_ASSERT_WITH_MESSAGE(dim == 2 || dim == 3,
+                "only dim=2 and dim=3 have been implemented");
+            int n[3];
+            for (int i = 0; i < dim; ++i) { n[i] = real_size[dim-1-i]; }
+            // Distance between the arrays of two successive transforms
+            int real_dist = 1;
+            for (int i = 0; i < dim; ++i) { real_dist *= n[i]; }
+            const int complex_dist = real_dist / n[dim-1] * (n[dim-1]/2 + 1);
+            if (dir == direction::R2C) {
+                fft_plan.m_plan = VendorCreatePlanManyR2C(
+                    dim, n, howmany, real_array, nullptr, 1, real_dist,
+                    complex_array, nullptr, 1, complex_dist, FFTW_ESTIMATE);
+            } else {
+                fft_plan.m_plan = VendorCreatePlanManyC2R(
+                    dim, n, howmany, complex_array, nullptr, 1, complex_dist,
+                    real_array, nullptr, 1, real_dist, FFTW_ESTIMATE);
+            }
+        } else if (dir == direction::R2C){
             if (dim == 3) {
                 fft_plan.m_plan = VendorCreatePlanR2C3D(
                     real_size[2], real_size[1], real_size[0], real_array, complex_array, FFTW_ESTIMATE);
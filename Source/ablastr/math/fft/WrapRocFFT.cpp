@@ -9,8 +9,21 @@
 
 #include "ablastr/utils/TextMsg.H"
 
+#include <array>
+#include <map>
+#include <tuple>
+
 namespace ablastr::math::anyfft
 {
+    namespace
+    {
+        /** Key of the plan cache: size, dimension, direction and number of transforms */
+        using PlanKey = std::tuple<std::array<int,3>, int, direction, int>;
+
+        /** Plans shared by all the boxes with the same shape */
+        std::map<PlanKey, VendorFFTPlan> plan_cache;
+    }
+
     void setup()
     {
         rocfft_setup();
@@ -18,6 +31,10 @@ namespace ablastr::math::anyfft
 
     void cleanup()
     {
+        for (auto& key_plan : plan_cache) {
+            rocfft_plan_destroy(key_plan.second);
+        }
+        plan_cache.clear();
         rocfft_cleanup();
     }
 
@@ -33,10 +50,26 @@ namespace ablastr::math::anyfft
     }
 
     FFTplan CreatePlan (const amrex::IntVect& real_size, amrex::Real * const real_array,
-                        Complex * const complex_array, const direction dir, const int dim)
+                        Complex * const complex_array, const direction dir, const int dim,
+                        const int howmany)
     {
         FFTplan fft_plan;
 
+        // Store meta-data in fft_plan
+        fft_plan.m_real_array = real_array;
+        fft_plan.m_complex_array = complex_array;
+        fft_plan.m_dir = dir;
+        fft_plan.m_dim = dim;
+
+        // Reuse the plan of a box with the same shape, if any
+        std::array<int,3> size = {1, 1, 1};
+        for (int i = 0; i < dim; ++i) { size[i] = real_size[i]; }
+        const PlanKey key{size, dim, dir, howmany};
+        if (const auto it = plan_cache.find(key); it != plan_cache.end()) {
+            fft_plan.m_plan = it->second;
+            return fft_plan;
+        }
+
         const std::size_t lengths[] = {AMREX_D_DECL(std::size_t(real_size[0]),
                                                     std::size_t(real_size[1]),
                                                     std::size_t(real_size[2]))};
@@ -53,22 +86,18 @@ namespace ablastr::math::anyfft
                                                   rocfft_precision_double,
 #endif
                                                   dim, lengths,
-                                                  1, // number of transforms,
+                                                  howmany, // number of transforms, contiguous
                                                   nullptr);
         assert_rocfft_status("rocfft_plan_create", result);
 
-        // Store meta-data in fft_plan
-        fft_plan.m_real_array = real_array;
-        fft_plan.m_complex_array = complex_array;
-        fft_plan.m_dir = dir;
-        fft_plan.m_dim = dim;
+        plan_cache[key] = fft_plan.m_plan;
 
         return fft_plan;
     }
 
-    void DestroyPlan (FFTplan& fft_plan)
+    void DestroyPlan (FFTplan& /*fft_plan*/)
     {
-        rocfft_plan_destroy( fft_plan.m_plan );
+        // The cached plans are destroyed in cleanup()
     }
 
     void Execute (FFTplan& fft_plan)
@@ -12,6 +12,9 @@
 
 #if defined(AMREX_USE_MPI)
 #   include <mpi.h>
+#   if defined(OPEN_MPI) && OPEN_MPI
+#       include <mpi-ext.h>
+#   endif
 #endif
 
 // OLCFDEV-1655: Segfault during MPI_Init & in PMI_Allgather
@@ -107,4 +110,82 @@ namespace ablastr::parallelization
 #endif
     }
 
+    int
+    mpi_ranks_per_node ()
+    {
+#ifdef AMREX_USE_MPI
+        MPI_Comm const comm = amrex::ParallelDescriptor::Communicator();
+        int const rank = amrex::ParallelDescriptor::MyProc();
+
+        MPI_Comm node_comm = MPI_COMM_NULL;
+        MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank,
+                            MPI_INFO_NULL, &node_comm);
+        int node_rank = 0;
+        int node_size = 0;
+        MPI_Comm_rank(node_comm, &node_rank);
+        MPI_Comm_size(node_comm, &node_size);
+
+        // The ranks of a node are contiguous if they start at the rank
+        // of the first rank of the node
+        int first_rank = rank;
+        MPI_Bcast(&first_rank, 1, MPI_INT, 0, node_comm);
+        MPI_Comm_free(&node_comm);
+
+        // min and max of the node size, and whether all nodes are contiguous,
+        // reduced at once as a min over (size, -size, contiguous)
+        int local[3] = {node_size, -node_size,
+                        (rank - first_rank == node_rank) ? 1 : 0};
+        int global[3] = {0, 0, 0};
+        MPI_Allreduce(local, global, 3, MPI_INT, MPI_MIN, comm);
+
+        const bool is_uniform = (global[0] == -global[1]) && (global[2] == 1);
+        return is_uniform ? node_size : 0;
+#else
+        return 0;
+#endif
+    }
+
+    int
+    mpi_num_nodes ()
+    {
+#ifdef AMREX_USE_MPI
+        MPI_Comm const comm = amrex::ParallelDescriptor::Communicator();
+        MPI_Comm node_comm = MPI_COMM_NULL;
+        MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, amrex::ParallelDescriptor::MyProc(),
+                            MPI_INFO_NULL, &node_comm);
+        int node_rank = 0;
+        MPI_Comm_rank(node_comm, &node_rank);
+        MPI_Comm_free(&node_comm);
+
+        // count the first rank of each node
+        int const is_first = (node_rank == 0) ? 1 : 0;
+        int num_nodes = 0;
+        MPI_Allreduce(&is_first, &num_nodes, 1, MPI_INT, MPI_SUM, comm);
+        return num_nodes;
+#else
+        return 1;
+#endif
+    }
+
+    bool
+    mpi_is_gpu_aware ()
+    {
+#if defined(AMREX_USE_MPI) && defined(AMREX_USE_GPU)
+        int gpu_aware = 0;
+
+#   if defined(AMREX_USE_CUDA) && defined(MPIX_CUDA_AWARE_SUPPORT) && MPIX_CUDA_AWARE_SUPPORT
+        gpu_aware = MPIX_Query_cuda_support();
+#   elif defined(AMREX_USE_HIP) && defined(MPIX_ROCM_AWARE_SUPPORT) && MPIX_ROCM_AWARE_SUPPORT
+        gpu_aware = MPIX_Query_rocm_support();
+#   endif
+
+        int all_gpu_aware = 0;
+        MPI_Allreduce(&gpu_aware, &all_gpu_aware, 1, MPI_INT, MPI_MIN,
+                      amrex::ParallelDescriptor::Communicator());
+        return all_gpu_aware != 0;
+#else
+        return false;
+#endif
+    }
+
 } // namespace ablastr::parallelization
@@ -6,6 +6,7 @@
  */
 #include "Communication.H"
 
+#include <AMReX.H>
 #include <AMReX_BaseFab.H>
 #include <AMReX_BLProfiler.H>
 #include <AMReX_IntVect.H>
@@ -18,13 +19,108 @@
 #include <AMReX_ParmParse.H>
 
 #include <algorithm>
+#include <array>
+#include <map>
 #include <memory>
+#include <tuple>
 #include <vector>
 
 
 namespace ablastr::utils::communication
 {
 
+namespace
+{
+    /** Runtime parameters of the communication functions */
+    struct CommOptions
+    {
+        bool fillboundary_always_sync = false;
+        bool cache_comm_buffers = true;
+    };
+
+    /** The parameters, read at the first communication (and reset by amrex::Finalize) */
+    std::optional<CommOptions> comm_options;
+
+    using CommFab = amrex::FabArray<amrex::BaseFab<comm_float_type> >;
+
+    /** Boxes and distribution, index type, number of components, guard cells
+     *  and slot (to distinguish the source and destination of a ParallelCopy) */
+    using CommBufferKey = std::tuple<amrex::FabArrayBase::BDKey, std::array<int,AMREX_SPACEDIM>,
+                                     int, std::array<int,AMREX_SPACEDIM>, int>;
+
+    /** Single-precision buffers of the communications, reused until ClearCommBuffers */
+    std::map<CommBufferKey, std::unique_ptr<CommFab> > comm_buffers;
+
+    /** Bound on the number of cached buffers: temporary MultiFabs with their own boxes
+     *  (e.g. in the RZ PML shift of the moving window) would otherwise accumulate;
+     *  beyond it, the buffers are allocated at each call */
+    constexpr std::size_t max_comm_buffers = 128;
+
+    CommOptions const& getCommOptions ()
+    {
+        if (!comm_options) {
+            // ParmParse lookups are not free: do them once, instead of at each communication
+            CommOptions options;
+            const amrex::ParmParse pp_ablastr("ablastr");
+            pp_ablastr.query("fillboundary_always_sync", options.fillboundary_always_sync);
+            pp_ablastr.query("cache_comm_buffers", options.cache_comm_buffers);
+            comm_options = options;
+            amrex::ExecOnFinalize([] () {
+                comm_options.reset();
+                ClearCommBuffers();
+            });
+        }
+        return *comm_options;
+    }
+
+    /** Whether a FillBoundary must also synchronize nodal points */
+    bool doNodalSync (std::optional<bool> nodal_sync)
+    {
+        // allow developers to always enforce nodal sync, independent of the
+        // nodal_sync argument
+        const bool do_nodal_sync_arg = nodal_sync.value_or(false);
+
+        // logic: inputs overwrite argument unless argument is true
+        return do_nodal_sync_arg || getCommOptions().fillboundary_always_sync;
+    }
+
+    /** Single-precision buffer with the boxes and distribution of mf, for the communications
+     *
+     * Unless ablastr.cache_comm_buffers is 0, the buffer is allocated at the first call
+     * and reused by the next calls with the same boxes, distribution, number of components,
+     * guard cells and slot; otherwise it is allocated in tmp.
+     * Its content is undefined: the callers overwrite all its cells.
+     */
+    CommFab& getCommBuffer (amrex::MultiFab const& mf, int ncomp, amrex::IntVect const& ngrow,
+                            int slot, std::unique_ptr<CommFab>& tmp)
+    {
+        if (!getCommOptions().cache_comm_buffers) {
+            tmp = std::make_unique<CommFab>(mf.boxArray(), mf.DistributionMap(), ncomp, ngrow);
+            return *tmp;
+        }
+
+        const CommBufferKey key{mf.getBDKey(), mf.ixType().toIntVect().toArray(),
+                                ncomp, ngrow.toArray(), slot};
+        if (comm_buffers.size() >= max_comm_buffers && comm_buffers.count(key) == 0) {
+            // Do not evict: the buffers may be in use (e.g. the source of a ParallelCopy)
+            tmp = std::make_unique<CommFab>(mf.boxArray(), mf.DistributionMap(), ncomp, ngrow);
+            return *tmp;
+        }
+        auto& buffer = comm_buffers[key];
+        // The key does not distinguish coarsened box arrays that share their boxes
+        if (!buffer || buffer->boxArray() != mf.boxArray() ||
+            buffer->DistributionMap() != mf.DistributionMap()) {
+            buffer = std::make_unique<CommFab>(mf.boxArray(), mf.DistributionMap(), ncomp, ngrow);
+        }
+        return *buffer;
+    }
+}
+
+void ClearCommBuffers ()
+{
+    comm_buffers.clear();
+}
+
 void ParallelCopy(amrex::MultiFab &dst, const amrex::MultiFab &src, int src_comp, int dst_comp, int num_comp,
                   const amrex::IntVect &src_nghost, const amrex::IntVect &dst_nghost,
                   bool do_single_precision_comms, const amrex::Periodicity &period,
@@ -36,16 +132,11 @@ void ParallelCopy(amrex::MultiFab &dst, const amrex::MultiFab &src, int src_comp
 
     if (do_single_precision_comms)
     {
-        amrex::FabArray<amrex::BaseFab<comm_float_type> > src_tmp(src.boxArray(),
-                                                                  src.DistributionMap(),
-                                                                  num_comp,
-                                                                  src_nghost);
+        std::unique_ptr<CommFab> src_alloc, dst_alloc;
+        CommFab& src_tmp = getCommBuffer(src, num_comp, src_nghost, 0, src_alloc);
         mixedCopy(src_tmp, src, src_comp, 0, num_comp, src_nghost);
 
-        amrex::FabArray<amrex::BaseFab<comm_float_type> > dst_tmp(dst.boxArray(),
-                                                                  dst.DistributionMap(),
-                                                                  num_comp,
-                                                                  dst_nghost);
+        CommFab& dst_tmp = getCommBuffer(dst, num_comp, dst_nghost, 1, dst_alloc);
 
         mixedCopy(dst_tmp, dst, dst_comp, 0, num_comp, dst_nghost);
 
@@ -76,23 +167,12 @@ void FillBoundary (amrex::MultiFab &mf,
 {
     BL_PROFILE("ablastr::utils::communication::FillBoundary");
 
-    // allow developers to always enforce nodal sync, independent of the
-    // nodal_sync argument
-    const bool do_nodal_sync_arg = nodal_sync.value_or(false);
-
-    const amrex::ParmParse pp_ablastr("ablastr");
-    bool do_nodal_sync_input = false;
-    pp_ablastr.query("fillboundary_always_sync", do_nodal_sync_input);
-
-    // logic: inputs overwrite argument unless argument is true
-    bool const do_nodal_sync = do_nodal_sync_arg || do_nodal_sync_input;
+    bool const do_nodal_sync = doNodalSync(nodal_sync);
 
     if (do_single_precision_comms)
     {
-        amrex::FabArray<amrex::BaseFab<comm_float_type> > mf_tmp(mf.boxArray(),
-                                                            mf.DistributionMap(),
-                                                            mf.nComp(),
-                                                            mf.nGrowVect());
+        std::unique_ptr<CommFab> alloc;
+        CommFab& mf_tmp = getCommBuffer(mf, mf.nComp(), mf.nGrowVect(), 0, alloc);
 
         mixedCopy(mf_tmp, mf, 0, 0, mf.nComp(), mf.nGrowVect());
 
@@ -129,6 +209,31 @@ FillBoundary (amrex::Vector<amrex::MultiFab *> const &mf, bool do_single_precisi
     }
 }
 
+void FillBoundary_nowait (amrex::MultiFab &mf,
+                          amrex::IntVect ng,
+                          const amrex::Periodicity &period,
+                          std::optional<bool> nodal_sync)
+{
+    BL_PROFILE("ablastr::utils::communication::FillBoundary_nowait");
+
+    if (doNodalSync(nodal_sync)) {
+        mf.FillBoundaryAndSync_nowait(0, mf.nComp(), ng, period);
+    } else {
+        mf.FillBoundary_nowait(ng, period);
+    }
+}
+
+void FillBoundary_finish (amrex::MultiFab &mf, std::optional<bool> nodal_sync)
+{
+    BL_PROFILE("ablastr::utils::communication::FillBoundary_finish");
+
+    if (doNodalSync(nodal_sync)) {
+        mf.FillBoundaryAndSync_finish();
+    } else {
+        mf.FillBoundary_finish();
+    }
+}
+
 void FillBoundary (amrex::iMultiFab &imf, const amrex::Periodicity &period)
 {
     BL_PROFILE("ablastr::utils::communication::FillBoundary::iMultiFab");
@@ -158,10 +263,8 @@ SumBoundary (amrex::MultiFab &mf,
 
     if (do_single_precision_comms)
     {
-        amrex::FabArray<amrex::BaseFab<comm_float_type> > mf_tmp(mf.boxArray(),
-                                                                 mf.DistributionMap(),
-                                                                 num_comps,
-                                                                 mf.nGrowVect());
+        std::unique_ptr<CommFab> alloc;
+        CommFab& mf_tmp = getCommBuffer(mf, num_comps, mf.nGrowVect(), 0, alloc);
         mixedCopy(mf_tmp, mf, start_comp, 0, num_comps, mf.nGrowVect());
 
         mf_tmp.SumBoundary(0, num_comps, src_ng, dst_ng, period);
@@ -174,6 +277,26 @@ SumBoundary (amrex::MultiFab &mf,
     }
 }
 
+void
+SumBoundary_nowait (amrex::MultiFab &mf,
+                    int start_comp,
+                    int num_comps,
+                    amrex::IntVect src_ng,
+                    amrex::IntVect dst_ng,
+                    const amrex::Periodicity &period)
+{
+    BL_PROFILE("ablastr::utils::communication::SumBoundary_nowait");
+
+    mf.SumBoundary_nowait(start_comp, num_comps, src_ng, dst_ng, period);
+}
+
+void SumBoundary_finish (amrex::MultiFab &mf)
+{
+    BL_PROFILE("ablastr::utils::communication::SumBoundary_finish");
+
+    mf.SumBoundary_finish();
+}
+
 void OverrideSync (amrex::MultiFab &mf,
                    bool do_single_precision_comms,
                    const amrex::Periodicity &period)
@@ -184,10 +307,8 @@ void OverrideSync (amrex::MultiFab &mf,
 
     if (do_single_precision_comms)
     {
-        amrex::FabArray<amrex::BaseFab<comm_float_type> > mf_tmp(mf.boxArray(),
-                                                                 mf.DistributionMap(),
-                                                                 mf.nComp(),
-                                                                 mf.nGrowVect());
+        std::unique_ptr<CommFab> alloc;
+        CommFab& mf_tmp = getCommBuffer(mf, mf.nComp(), mf.nGrowVect(), 0, alloc);
 
         mixedCopy(mf_tmp, mf, 0, 0, mf.nComp(), mf.nGrowVect());
 
@@ -0,0 +1,78 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "ScratchPool.H"
+
+#include <AMReX.H>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    /** Maximum number of MultiFabs kept in the pool: its memory is bounded by
+     *  this number of the largest temporaries of the simulation */
+    constexpr std::size_t max_pool_size = 32;
+
+    /** MultiFabs returned to the pool, the most recently returned last */
+    std::vector<std::unique_ptr<amrex::MultiFab>>&
+    pool ()
+    {
+        static std::vector<std::unique_ptr<amrex::MultiFab>> free_mfs;
+        static bool clear_on_finalize_registered = false;
+        if (!clear_on_finalize_registered) {
+            // The MultiFabs must be freed before AMReX is finalized (and registered
+            // again if AMReX is initialized again, e.g. from Python)
+            amrex::ExecOnFinalize( [] () {
+                ablastr::utils::scratch::clear_pool();
+                clear_on_finalize_registered = false;
+            });
+            clear_on_finalize_registered = true;
+        }
+        return free_mfs;
+    }
+}
+
+namespace ablastr::utils::scratch
+{
+    ScratchMultiFab::ScratchMultiFab (amrex::BoxArray const& ba, amrex::DistributionMapping const& dm,
+                                      int ncomp, amrex::IntVect const& ngrow)
+    {
+        auto& free_mfs = pool();
+        auto const it = std::find_if(free_mfs.rbegin(), free_mfs.rend(),
+            [&] (std::unique_ptr<amrex::MultiFab> const& mf) {
+                return mf->nComp() == ncomp && mf->nGrowVect() == ngrow &&
+                    mf->DistributionMap() == dm && mf->boxArray() == ba;
+            });
+        if (it != free_mfs.rend()) {
+            m_mf = std::move(*it);
+            free_mfs.erase(std::next(it).base());
+        } else {
+            m_mf = std::make_unique<amrex::MultiFab>(ba, dm, ncomp, ngrow);
+        }
+    }
+
+    ScratchMultiFab::~ScratchMultiFab ()
+    {
+        // moved-from
+        if (!m_mf) { return; }
+
+        // The kernels still using the MultiFab are on the same stream as the
+        // kernels of its next user, so that it can be handed out again right away
+        auto& free_mfs = pool();
+        if (free_mfs.size() >= max_pool_size) { free_mfs.erase(free_mfs.begin()); }
+        free_mfs.push_back(std::move(m_mf));
+    }
+
+    void clear_pool ()
+    {
+        pool().clear();
+    }
+
+} // namespace ablastr::utils::scratch
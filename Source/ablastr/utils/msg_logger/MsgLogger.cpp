@@ -12,6 +12,10 @@
 
 #include <AMReX_ParallelDescriptor.H>
 
+#ifdef AMREX_USE_MPI
+#   include <mpi.h>
+#endif
+
 #include <algorithm>
 #include <array>
 #include <memory>
@@ -93,9 +97,45 @@ namespace
     */
     std::vector<Msg> deserialize_msgs(
         const std::vector<char>& serialized);
+
+    /**
+    * \brief This function merges the messages with counters gathered on the I/O rank
+    * by Logger::start_async_gather
+    *
+    * @param[in] all_data a byte array containing the serialized messages with counters of all the ranks
+    * @param[in] package_sizes the size of the data of each rank in all_data
+    * @param[in] displacements a vector of displacements to access data corresponding to a given rank in all_data
+    * @return a vector of messages with global counters and emitting rank lists
+    */
+    std::vector<MsgWithCounterAndRanks> merge_gathered_msgs(
+        const std::vector<char>& all_data,
+        const std::vector<int>& package_sizes,
+        const std::vector<int>& displacements);
 }
 #endif
 
+/**
+* The non-blocking gather of Logger::start_async_gather has two phases: the sizes of the
+* packages of messages of all the ranks are gathered on the I/O rank (MPI_Igather), then the
+* packages themselves (MPI_Igatherv). The communications use a duplicate of the communicator,
+* so that they can be interleaved with the other collective operations of the code.
+*/
+struct Logger::AsyncGather
+{
+#ifdef AMREX_USE_MPI
+    MPI_Comm comm = MPI_COMM_NULL;
+    MPI_Request request = MPI_REQUEST_NULL;
+    int phase = 0;
+    int package_size = 0;
+    std::vector<char> package;
+    std::vector<int> package_sizes;
+    std::vector<int> displacements;
+    std::vector<char> all_data;
+#endif
+    bool done = false;
+    std::vector<MsgWithCounterAndRanks> result;
+};
+
 std::string abl_msg_logger::PriorityToString(const Priority& priority)
 {
     if(priority == Priority::high) {
@@ -216,6 +256,8 @@ Logger::Logger() :
     m_io_rank{amrex::ParallelDescriptor::IOProcessorNumber()}
 {}
 
+Logger::~Logger() = default;
+
 void Logger::record_msg(const Msg& msg)
 {
     m_messages[msg]++;
@@ -307,6 +349,101 @@ Logger::collective_gather_msgs_with_counter_and_ranks() const
 #endif
 }
 
+void Logger::start_async_gather()
+{
+    ABLASTR_ALWAYS_ASSERT_WITH_MESSAGE(!m_async_gather,
+        "A gather of the messages is already in progress");
+    m_async_gather = std::make_unique<AsyncGather>();
+
+#ifdef AMREX_USE_MPI
+    if (m_num_procs > 1) {
+        auto& ag = *m_async_gather;
+        for (const auto& el : m_messages) {
+            abl_ser::put_in_vec<char>(
+                MsgWithCounter{el.first, el.second}.serialize(), ag.package);
+        }
+        ag.package_size = static_cast<int>(ag.package.size());
+        if (m_rank == m_io_rank) { ag.package_sizes.resize(m_num_procs); }
+
+        MPI_Comm_dup(amrex::ParallelDescriptor::Communicator(), &ag.comm);
+        MPI_Igather(&ag.package_size, 1, MPI_INT,
+            ag.package_sizes.data(), 1, MPI_INT, m_io_rank, ag.comm, &ag.request);
+        return;
+    }
+#endif
+
+    m_async_gather->result = one_rank_gather_msgs_with_counter_and_ranks();
+    m_async_gather->done = true;
+}
+
+bool Logger::is_async_gather_pending() const
+{
+    return static_cast<bool>(m_async_gather);
+}
+
+bool Logger::test_async_gather()
+{
+    if (!m_async_gather) { return false; }
+
+#ifdef AMREX_USE_MPI
+    while (!m_async_gather->done) {
+        int flag = 0;
+        MPI_Test(&m_async_gather->request, &flag, MPI_STATUS_IGNORE);
+        if (flag == 0) { return false; }
+        advance_async_gather();
+    }
+#endif
+
+    return m_async_gather->done;
+}
+
+std::vector<MsgWithCounterAndRanks> Logger::finish_async_gather()
+{
+    if (!m_async_gather) { return std::vector<MsgWithCounterAndRanks>{}; }
+
+#ifdef AMREX_USE_MPI
+    while (!m_async_gather->done) {
+        MPI_Wait(&m_async_gather->request, MPI_STATUS_IGNORE);
+        advance_async_gather();
+    }
+#endif
+
+    auto result = std::move(m_async_gather->result);
+    m_async_gather.reset();
+    return result;
+}
+
+void Logger::advance_async_gather()
+{
+#ifdef AMREX_USE_MPI
+    auto& ag = *m_async_gather;
+    const bool is_io_rank = (m_rank == m_io_rank);
+
+    if (ag.phase == 0) {
+        // The sizes of the packages are known: gather the packages
+        if (is_io_rank) {
+            ag.displacements.resize(m_num_procs);
+            std::exclusive_scan(ag.package_sizes.begin(), ag.package_sizes.end(),
+                ag.displacements.begin(), 0);
+            ag.all_data.resize(ag.displacements.back() + ag.package_sizes.back());
+        }
+        MPI_Igatherv(ag.package.data(), ag.package_size, MPI_CHAR,
+            ag.all_data.data(), ag.package_sizes.data(), ag.displacements.data(), MPI_CHAR,
+            m_io_rank, ag.comm, &ag.request);
+        ag.phase = 1;
+    }
+    else {
+        if (is_io_rank) {
+            ag.result = ::merge_gathered_msgs(ag.all_data, ag.package_sizes, ag.displacements);
+        }
+        MPI_Comm_free(&ag.comm);
+        std::vector<char>{}.swap(ag.all_data);
+        std::vector<char>{}.swap(ag.package);
+        ag.done = true;
+    }
+#endif
+}
+
 std::vector<MsgWithCounterAndRanks>
 Logger::one_rank_gather_msgs_with_counter_and_ranks() const
 {
@@ -659,6 +796,46 @@ std::vector<Msg> deserialize_msgs(
 
     return msgs;
 }
+
+std::vector<MsgWithCounterAndRanks> merge_gathered_msgs(
+    const std::vector<char>& all_data,
+    const std::vector<int>& package_sizes,
+    const std::vector<int>& displacements)
+{
+    const auto num_procs = static_cast<int>(package_sizes.size());
+
+    // The ranks are visited in order, so that the rank lists are sorted
+    std::map<Msg, MsgWithCounterAndRanks> tmap;
+    for (int rr = 0; rr < num_procs; ++rr){
+        auto it = all_data.begin() + displacements[rr];
+        const auto end = it + package_sizes[rr];
+        while (it < end){
+            const auto serialized_msg_with_counter = abl_ser::get_out_vec<char>(it);
+            const auto msg_with_counter =
+                MsgWithCounter::deserialize(serialized_msg_with_counter.begin());
+            auto& el = tmap[msg_with_counter.msg];
+            if (el.ranks.empty()){
+                el.msg_with_counter = msg_with_counter;
+            }
+            else{
+                el.msg_with_counter.counter += msg_with_counter.counter;
+            }
+            el.ranks.push_back(rr);
+        }
+    }
+
+    std::vector<MsgWithCounterAndRanks> msgs_with_counter_and_ranks;
+    msgs_with_counter_and_ranks.reserve(tmap.size());
+    for (auto& el : tmap){
+        if (static_cast<int>(el.second.ranks.size()) == num_procs){
+            el.second.all_ranks = true;
+            std::vector<int>{}.swap(el.second.ranks);
+        }
+        msgs_with_counter_and_ranks.push_back(std::move(el.second));
+    }
+
+    return msgs_with_counter_and_ranks;
+}
 }
 
 #endif
@@ -130,9 +130,36 @@ std::string WarnManager::PrintLocalWarnings(const std::string& when) const
 
 std::string WarnManager::PrintGlobalWarnings(const std::string& when) const
 {
-    auto all_warnings =
-        m_p_logger->collective_gather_msgs_with_counter_and_ranks();
+    return FormatGlobalWarnings(when,
+        m_p_logger->collective_gather_msgs_with_counter_and_ranks());
+}
+
+void WarnManager::StartGlobalWarnings(const std::string& when)
+{
+    m_async_when = when;
+    m_p_logger->start_async_gather();
+}
+
+std::optional<std::string> WarnManager::TestGlobalWarnings()
+{
+    if(!m_p_logger->test_async_gather()) {
+        return std::nullopt;
+    }
+    return FlushGlobalWarnings();
+}
 
+std::string WarnManager::FlushGlobalWarnings()
+{
+    if(!m_p_logger->is_async_gather_pending()) {
+        return "";
+    }
+    return FormatGlobalWarnings(m_async_when, m_p_logger->finish_async_gather());
+}
+
+std::string WarnManager::FormatGlobalWarnings(
+    const std::string& when,
+    std::vector<abl_msg_logger::MsgWithCounterAndRanks> all_warnings) const
+{
     if(m_rank != amrex::ParallelDescriptor::IOProcessorNumber()) {
         return "[see I/O rank message]";
     }
@@ -0,0 +1,409 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+/* Standalone microbenchmarks of the particle kernels of WarpX
+ *
+ * The current deposition (direct and Esirkepov), field gather and momentum
+ * pushers (Boris, Vay, Higuera-Cary) are run on one synthetic tile, without
+ * setting up a simulation, and the particle throughput and the achieved
+ * bandwidth (estimated with the same analytic counts as KernelCounters) are
+ * reported. Parameters are read with ParmParse (inputs file or command line):
+ *
+ *   benchmark.kernels     kernels to run (default: all)
+ *   benchmark.n_cell      number of cells of the tile (default: 64 in each direction)
+ *   benchmark.ppc         number of particles per cell (default: 8)
+ *   benchmark.shape_order order of the particle shape, 1 to 4 (default: 3)
+ *   benchmark.skew        fraction of the particles that are concentrated in the
+ *                         first 1/2^dim of the tile, to mimic a non-uniform
+ *                         distribution (default: 0, uniform)
+ *   benchmark.repetitions number of timed calls of each kernel (default: 10)
+ *   benchmark.seed        seed of the random particle positions (default: 1)
+ *   benchmark.output      if set, file to which one JSON line per kernel is appended
+ *
+ * The dimensionality is the one of the build (1D, 2D or 3D).
+ */
+
+#include "Particles/Deposition/CurrentDeposition.H"
+#include "Particles/Gather/FieldGather.H"
+#include "Particles/Pusher/GetAndSetPosition.H"
+#include "Particles/Pusher/UpdateMomentumBoris.H"
+#include "Particles/Pusher/UpdateMomentumHigueraCary.H"
+#include "Particles/Pusher/UpdateMomentumVay.H"
+#include "Particles/Pusher/UpdatePosition.H"
+#include "Utils/KernelCounters.H"
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXConst.H"
+
+#include <AMReX.H>
+#include <AMReX_FArrayBox.H>
+#include <AMReX_GpuContainers.H>
+#include <AMReX_GpuDevice.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_IntVect.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <AMReX_REAL.H>
+#include <AMReX_Vector.H>
+
+#include <array>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace amrex::literals;
+
+namespace
+{
+    /** Index type of a field component: staggered along its own direction for E and J
+     *  (edge-centered), and nodal along its own direction only for B (face-centered) */
+    amrex::IntVect field_type (int comp, bool is_B)
+    {
+        amrex::IntVect t(is_B ? 0 : 1);
+        const int own = is_B ? 1 : 0;
+#if defined(WARPX_DIM_3D)
+        t[comp] = own;
+#elif defined(WARPX_DIM_XZ)
+        if (comp == 0) { t[0] = own; }
+        else if (comp == 2) { t[1] = own; }
+#elif defined(WARPX_DIM_1D_Z)
+        if (comp == 2) { t[0] = own; }
+#endif
+        return t;
+    }
+
+    /** Synthetic tile: particle data and grid data */
+    struct Tile
+    {
+        amrex::Box box;
+        amrex::Box grown_box;
+        amrex::XDim3 dinv;
+        amrex::XDim3 xyzmin;
+        amrex::Dim3 lo;
+        amrex::Real dt;
+        long np;
+        amrex::Gpu::DeviceVector<amrex::ParticleReal> x, y, z, ux, uy, uz, w;
+        amrex::Gpu::DeviceVector<amrex::ParticleReal> Ex, Ey, Ez, Bx, By, Bz;
+        std::array<amrex::FArrayBox, 3> J, E, B;
+
+        GetParticlePosition<PIdx> GetPosition () const
+        {
+            GetParticlePosition<PIdx> pos;
+#if defined(WARPX_DIM_3D)
+            pos.m_x = x.dataPtr();
+            pos.m_y = y.dataPtr();
+            pos.m_z = z.dataPtr();
+#elif defined(WARPX_DIM_XZ)
+            pos.m_x = x.dataPtr();
+            pos.m_z = z.dataPtr();
+#else
+            pos.m_z = z.dataPtr();
+#endif
+            return pos;
+        }
+    };
+
+    void InitTile (Tile& tile, const amrex::IntVect& n_cell, int ppc, int shape_order,
+                   amrex::Real skew, unsigned int seed)
+    {
+        constexpr amrex::Real dx = 1.e-6_rt;
+        tile.box = amrex::Box(amrex::IntVect(0), n_cell - 1);
+        tile.grown_box = amrex::grow(tile.box, shape_order + 1);
+        tile.dinv = {1._rt/dx, 1._rt/dx, 1._rt/dx};
+        tile.lo = amrex::lbound(tile.grown_box);
+        const amrex::IntVect glo = tile.grown_box.smallEnd();
+#if defined(WARPX_DIM_3D)
+        tile.xyzmin = {glo[0]*dx, glo[1]*dx, glo[2]*dx};
+#elif defined(WARPX_DIM_XZ)
+        tile.xyzmin = {glo[0]*dx, std::numeric_limits<amrex::Real>::lowest(), glo[1]*dx};
+#else
+        tile.xyzmin = {std::numeric_limits<amrex::Real>::lowest(),
+                       std::numeric_limits<amrex::Real>::lowest(), glo[0]*dx};
+#endif
+        // particles move by less than half a cell per step
+        tile.dt = 0.5_rt*dx/PhysConst::c;
+
+        tile.np = static_cast<long>(tile.box.numPts())*ppc;
+        std::vector<amrex::ParticleReal> pos[3], mom[3], w(tile.np, 1.e10_prt);
+        for (auto& p : pos) { p.resize(tile.np, 0._prt); }
+        for (auto& u : mom) { u.resize(tile.np, 0._prt); }
+
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<amrex::ParticleReal> uniform(0._prt, 1._prt);
+        std::normal_distribution<amrex::ParticleReal> thermal(0._prt, 0.01_prt*PhysConst::c);
+        for (long ip = 0; ip < tile.np; ++ip) {
+            // with probability skew, the particle is placed in the lower half of each direction
+            const bool in_corner = uniform(gen) < skew;
+            amrex::ParticleReal r[AMREX_SPACEDIM];
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                const amrex::ParticleReal extent = (in_corner ? 0.5_prt : 1._prt)*n_cell[idim];
+                r[idim] = uniform(gen)*extent*dx;
+            }
+#if defined(WARPX_DIM_3D)
+            pos[0][ip] = r[0]; pos[1][ip] = r[1]; pos[2][ip] = r[2];
+#elif defined(WARPX_DIM_XZ)
+            pos[0][ip] = r[0]; pos[2][ip] = r[1];
+#else
+            pos[2][ip] = r[0];
+#endif
+            for (auto& u : mom) { u[ip] = thermal(gen); }
+        }
+
+        auto to_device = [&] (amrex::Gpu::DeviceVector<amrex::ParticleReal>& d,
+                              std::vector<amrex::ParticleReal> const& h) {
+            d.resize(h.size());
+            amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, h.begin(), h.end(), d.begin());
+        };
+        to_device(tile.x, pos[0]); to_device(tile.y, pos[1]); to_device(tile.z, pos[2]);
+        to_device(tile.ux, mom[0]); to_device(tile.uy, mom[1]); to_device(tile.uz, mom[2]);
+        to_device(tile.w, w);
+        for (auto* f : {&tile.Ex, &tile.Ey, &tile.Ez, &tile.Bx, &tile.By, &tile.Bz}) {
+            f->resize(tile.np);
+        }
+        amrex::Gpu::streamSynchronize();
+
+        for (int comp = 0; comp < 3; ++comp) {
+            tile.J[comp].resize(amrex::convert(tile.grown_box, field_type(comp, false)), 1);
+            tile.E[comp].resize(amrex::convert(tile.grown_box, field_type(comp, false)), 1);
+            tile.B[comp].resize(amrex::convert(tile.grown_box, field_type(comp, true)), 1);
+            tile.J[comp].setVal<amrex::RunOn::Device>(0._rt);
+            tile.E[comp].setVal<amrex::RunOn::Device>(1.e9_rt);
+            tile.B[comp].setVal<amrex::RunOn::Device>(1._rt);
+        }
+    }
+
+    template <int depos_order>
+    void Deposit (Tile& tile, bool esirkepov)
+    {
+        const GetParticlePosition<PIdx> GetPosition = tile.GetPosition();
+        const amrex::Real q = -PhysConst::q_e;
+        if (esirkepov) {
+            doEsirkepovDepositionShapeN<depos_order>(
+                GetPosition, tile.w.dataPtr(), tile.ux.dataPtr(), tile.uy.dataPtr(), tile.uz.dataPtr(),
+                nullptr, tile.J[0].array(), tile.J[1].array(), tile.J[2].array(), tile.np,
+                tile.dt, 0._rt, tile.dinv, tile.xyzmin, tile.lo, q, 1);
+        } else {
+            doDepositionShapeN<depos_order>(
+                GetPosition, tile.w.dataPtr(), tile.ux.dataPtr(), tile.uy.dataPtr(), tile.uz.dataPtr(),
+                nullptr, tile.J[0], tile.J[1], tile.J[2], tile.np,
+                0._rt, tile.dinv, tile.xyzmin, tile.lo, q, 1);
+        }
+    }
+
+    template <int depos_order>
+    void Gather (Tile& tile)
+    {
+        const GetParticlePosition<PIdx> GetPosition = tile.GetPosition();
+        auto* const Exp = tile.Ex.dataPtr(); auto* const Eyp = tile.Ey.dataPtr(); auto* const Ezp = tile.Ez.dataPtr();
+        auto* const Bxp = tile.Bx.dataPtr(); auto* const Byp = tile.By.dataPtr(); auto* const Bzp = tile.Bz.dataPtr();
+        amrex::Array4<amrex::Real const> const ex_arr = tile.E[0].const_array();
+        amrex::Array4<amrex::Real const> const ey_arr = tile.E[1].const_array();
+        amrex::Array4<amrex::Real const> const ez_arr = tile.E[2].const_array();
+        amrex::Array4<amrex::Real const> const bx_arr = tile.B[0].const_array();
+        amrex::Array4<amrex::Real const> const by_arr = tile.B[1].const_array();
+        amrex::Array4<amrex::Real const> const bz_arr = tile.B[2].const_array();
+        const amrex::IndexType ex_type = tile.E[0].box().ixType();
+        const amrex::IndexType ey_type = tile.E[1].box().ixType();
+        const amrex::IndexType ez_type = tile.E[2].box().ixType();
+        const amrex::IndexType bx_type = tile.B[0].box().ixType();
+        const amrex::IndexType by_type = tile.B[1].box().ixType();
+        const amrex::IndexType bz_type = tile.B[2].box().ixType();
+        const amrex::XDim3 dinv = tile.dinv;
+        const amrex::XDim3 xyzmin = tile.xyzmin;
+        const amrex::Dim3 lo = tile.lo;
+
+        amrex::ParallelFor(tile.np, [=] AMREX_GPU_DEVICE (long ip)
+        {
+            amrex::ParticleReal xp, yp, zp;
+            GetPosition(ip, xp, yp, zp);
+            Exp[ip] = 0._prt; Eyp[ip] = 0._prt; Ezp[ip] = 0._prt;
+            Bxp[ip] = 0._prt; Byp[ip] = 0._prt; Bzp[ip] = 0._prt;
+            doGatherShapeN<depos_order, 0>(xp, yp, zp,
+                Exp[ip], Eyp[ip], Ezp[ip], Bxp[ip], Byp[ip], Bzp[ip],
+                ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
+                ex_type, ey_type, ez_type, bx_type, by_type, bz_type,
+                dinv, xyzmin, lo, 1);
+        });
+    }
+
+    enum struct Pusher { Boris, Vay, HigueraCary };
+
+    void Push (Tile& tile, Pusher pusher)
+    {
+        auto* const xp = tile.x.dataPtr(); auto* const yp = tile.y.dataPtr(); auto* const zp = tile.z.dataPtr();
+        auto* const uxp = tile.ux.dataPtr(); auto* const uyp = tile.uy.dataPtr(); auto* const uzp = tile.uz.dataPtr();
+        auto const* const Exp = tile.Ex.dataPtr(); auto const* const Eyp = tile.Ey.dataPtr(); auto const* const Ezp = tile.Ez.dataPtr();
+        auto const* const Bxp = tile.Bx.dataPtr(); auto const* const Byp = tile.By.dataPtr(); auto const* const Bzp = tile.Bz.dataPtr();
+        const amrex::ParticleReal q = -PhysConst::q_e;
+        const amrex::ParticleReal m = PhysConst::m_e;
+        const amrex::Real dt = tile.dt;
+
+        amrex::ParallelFor(tile.np, [=] AMREX_GPU_DEVICE (long ip)
+        {
+            amrex::ParticleReal ux = uxp[ip], uy = uyp[ip], uz = uzp[ip];
+            if (pusher == Pusher::Boris) {
+                UpdateMomentumBoris(ux, uy, uz, Exp[ip], Eyp[ip], Ezp[ip], Bxp[ip], Byp[ip], Bzp[ip], q, m, dt);
+            } else if (pusher == Pusher::Vay) {
+                UpdateMomentumVay(ux, uy, uz, Exp[ip], Eyp[ip], Ezp[ip], Bxp[ip], Byp[ip], Bzp[ip], q, m, dt);
+            } else {
+                UpdateMomentumHigueraCary(ux, uy, uz, Exp[ip], Eyp[ip], Ezp[ip], Bxp[ip], Byp[ip], Bzp[ip], q, m, dt);
+            }
+            // the momentum is not stored back, so that all repetitions do the same
+            // work and the particles only drift by a small fraction of a cell
+            UpdatePosition(xp[ip], yp[ip], zp[ip], ux, uy, uz, dt);
+        });
+    }
+
+    template <typename F>
+    void CallWithShapeOrder (int shape_order, F&& f)
+    {
+        if      (shape_order == 1) { f(std::integral_constant<int,1>{}); }
+        else if (shape_order == 2) { f(std::integral_constant<int,2>{}); }
+        else if (shape_order == 3) { f(std::integral_constant<int,3>{}); }
+        else if (shape_order == 4) { f(std::integral_constant<int,4>{}); }
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        const amrex::ParmParse pp("benchmark");
+
+        std::vector<std::string> kernels = {
+            "deposition_direct", "deposition_esirkepov", "gather",
+            "push_boris", "push_vay", "push_higuera_cary"};
+        pp.queryarr("kernels", kernels);
+
+        amrex::Vector<int> n_cell_v(AMREX_SPACEDIM, 64);
+        pp.queryarr("n_cell", n_cell_v);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(n_cell_v.size() == AMREX_SPACEDIM,
+            "benchmark.n_cell must have one value per dimension");
+        const amrex::IntVect n_cell(n_cell_v);
+
+        int ppc = 8;
+        pp.query("ppc", ppc);
+        int shape_order = 3;
+        pp.query("shape_order", shape_order);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(shape_order >= 1 && shape_order <= 4,
+            "benchmark.shape_order must be between 1 and 4");
+        amrex::Real skew = 0._rt;
+        pp.query("skew", skew);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(skew >= 0._rt && skew <= 1._rt,
+            "benchmark.skew must be between 0 and 1");
+        int repetitions = 10;
+        pp.query("repetitions", repetitions);
+        int seed = 1;
+        pp.query("seed", seed);
+        std::string output;
+        pp.query("output", output);
+
+        Tile tile;
+        InitTile(tile, n_cell, ppc, shape_order, skew, static_cast<unsigned int>(seed));
+        const auto np = static_cast<double>(tile.np);
+
+        amrex::Print() << "Kernel benchmarks: " << AMREX_SPACEDIM << "D, n_cell = " << n_cell
+                       << ", ppc = " << ppc << ", shape order = " << shape_order
+                       << ", skew = " << skew << ", " << tile.np << " particles\n\n";
+        amrex::Print() << std::left << std::setw(24) << "kernel"
+                       << std::right << std::setw(14) << "time/call(s)"
+                       << std::setw(16) << "particles/s"
+                       << std::setw(12) << "GB/s"
+                       << std::setw(12) << "GFlop/s" << "\n";
+
+        KernelCounters::Enable();
+        for (const auto& name : kernels)
+        {
+            std::function<void()> run;
+            std::function<void(double)> count;
+            // same analytic counts as in the simulation code (see KernelCounters)
+            if (name == "deposition_direct" || name == "deposition_esirkepov") {
+                const bool esirkepov = (name == "deposition_esirkepov");
+                run = [&, esirkepov] () {
+                    CallWithShapeOrder(shape_order, [&] (auto order) { Deposit<decltype(order)::value>(tile, esirkepov); });
+                };
+                count = [&, esirkepov] (double start) {
+                    KernelCounters::StopParticleKernel(
+                        esirkepov ? KernelCounters::EsirkepovDeposition : KernelCounters::DirectDeposition,
+                        start, np, esirkepov ? shape_order + 1 : shape_order, 7., 6., 20.);
+                };
+            } else if (name == "gather") {
+                run = [&] () {
+                    CallWithShapeOrder(shape_order, [&] (auto order) { Gather<decltype(order)::value>(tile); });
+                };
+                count = [&] (double start) {
+                    KernelCounters::StopParticleKernel(KernelCounters::GatherAndPush,
+                                                       start, np, shape_order, 9., 6., 0.);
+                };
+            } else if (name == "push_boris" || name == "push_vay" || name == "push_higuera_cary") {
+                const Pusher pusher = (name == "push_boris") ? Pusher::Boris :
+                    ((name == "push_vay") ? Pusher::Vay : Pusher::HigueraCary);
+                run = [&, pusher] () { Push(tile, pusher); };
+                // 6 field components and the momentum read, position read and written
+                count = [&, pusher] (double start) {
+                    const double flops = (pusher == Pusher::Boris) ? 60. : 100.;
+                    KernelCounters::Stop(KernelCounters::GatherAndPush, start,
+                                         np*15.*sizeof(amrex::ParticleReal), np*flops);
+                };
+            } else {
+                WARPX_ABORT_WITH_MESSAGE("Unknown kernel in benchmark.kernels: " + name);
+            }
+
+            // warm-up call, not timed
+            run();
+            amrex::Gpu::synchronize();
+
+            KernelCounters::Reset();
+            for (int i = 0; i < repetitions; ++i) {
+                const double start = KernelCounters::Start();
+                run();
+                count(start);
+            }
+
+            double time = 0., bytes = 0., flops = 0.;
+            for (int k = 0; k < KernelCounters::NKernels; ++k) {
+                time += KernelCounters::Times()[k];
+                bytes += KernelCounters::Bytes()[k];
+                flops += KernelCounters::Flops()[k];
+            }
+            const double particles_per_second = np*repetitions/time;
+
+            amrex::Print() << std::left << std::setw(24) << name << std::right << std::scientific
+                           << std::setprecision(3)
+                           << std::setw(14) << time/repetitions
+                           << std::setw(16) << particles_per_second
+                           << std::fixed << std::setprecision(1)
+                           << std::setw(12) << bytes/time*1.e-9
+                           << std::setw(12) << flops/time*1.e-9 << "\n";
+
+            if (!output.empty() && amrex::ParallelDescriptor::IOProcessor()) {
+                std::ofstream ofs{output, std::ofstream::out | std::ofstream::app};
+                ofs << std::setprecision(6) << std::scientific
+                    << "{\"kernel\":\"" << name << "\",\"dim\":" << AMREX_SPACEDIM
+                    << ",\"n_cell\":[" << n_cell[0]
+#if AMREX_SPACEDIM > 1
+                    << "," << n_cell[1]
+#endif
+#if AMREX_SPACEDIM > 2
+                    << "," << n_cell[2]
+#endif
+                    << "],\"ppc\":" << ppc << ",\"shape_order\":" << shape_order
+                    << ",\"skew\":" << skew << ",\"particles\":" << tile.np
+                    << ",\"time_per_call\":" << time/repetitions
+                    << ",\"particles_per_second\":" << particles_per_second
+                    << ",\"GB/s\":" << bytes/time*1.e-9
+                    << ",\"GFlop/s\":" << flops/time*1.e-9 << "}" << std::endl;
+            }
+        }
+    }
+    amrex::Finalize();
+}
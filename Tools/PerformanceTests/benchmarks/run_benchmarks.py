@@ -0,0 +1,230 @@
+#!/usr/bin/env python3
+#
+# Copyright 2024 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+"""Machine-agnostic performance benchmarks for WarpX.
+
+This script runs the benchmark decks of this directory with a given WarpX
+executable, for one or several numbers of MPI ranks (weak or strong scaling),
+and appends one JSON line per run to an output file. Each line contains the
+commit of the WarpX sources, the host, the variant label (e.g. ``cpu`` or
+``gpu``), the run parameters, the total and per-step times, and the per-phase
+timings and kernel counters of the ``PhaseTimings`` reduced diagnostic.
+
+The script does not submit jobs: run it from within an allocation, and
+describe how to launch an executable on ``n`` MPI ranks with ``--launcher``.
+
+Typical use, on 1 to 8 GPUs of a node:
+
+.. code-block:: sh
+
+   python run_benchmarks.py --executable ../../../build/bin/warpx.3d \\
+       --launcher "srun -n {nprocs} --gpus-per-task=1" \\
+       --nprocs 1,2,4,8 --scaling weak --variant gpu \\
+       --output perf_results.jsonl
+"""
+
+import argparse
+import datetime
+import json
+import os
+import re
+import shutil
+import socket
+import subprocess
+import sys
+import time
+
+here = os.path.dirname(os.path.abspath(__file__))
+
+# Benchmark decks, and the build options they require
+benchmarks = {
+    'uniform_plasma': {'input': 'inputs_uniform_plasma', 'requires': ''},
+    'psatd': {'input': 'inputs_psatd', 'requires': 'WarpX_PSATD=ON'},
+    'electrostatic': {'input': 'inputs_electrostatic', 'requires': ''},
+    'implicit': {'input': 'inputs_implicit', 'requires': ''},
+    'collisions': {'input': 'inputs_collisions', 'requires': ''},
+    'qed': {'input': 'inputs_qed', 'requires': 'WarpX_QED=ON'},
+    'btd': {'input': 'inputs_btd', 'requires': ''},
+}
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description='Run WarpX performance benchmarks')
+    parser.add_argument('--executable', required=True,
+                        help='path to the 3D WarpX executable')
+    parser.add_argument('--launcher', default='mpiexec -n {nprocs}',
+                        help='command that launches the executable on {nprocs} MPI ranks')
+    parser.add_argument('--nprocs', default='1',
+                        help='comma-separated list of numbers of MPI ranks')
+    parser.add_argument('--scaling', choices=['weak', 'strong'], default='weak',
+                        help='weak: the number of cells grows with the number of ranks; '
+                             'strong: the number of cells is fixed')
+    parser.add_argument('--benchmarks', default=','.join(benchmarks),
+                        help='comma-separated list of benchmarks, among: ' + ', '.join(benchmarks))
+    parser.add_argument('--n_cell', default='64,64,64',
+                        help='number of cells for the smallest number of ranks')
+    parser.add_argument('--max_grid_size', type=int, default=32)
+    parser.add_argument('--steps', type=int, default=50,
+                        help='number of steps of each run')
+    parser.add_argument('--warmup', type=int, default=10,
+                        help='number of steps excluded from the per-phase timings')
+    parser.add_argument('--omp', type=int, default=None,
+                        help='number of OpenMP threads per rank (CPU builds)')
+    parser.add_argument('--variant', default='',
+                        help='label of the build or machine variant, e.g. cpu or gpu')
+    parser.add_argument('--extra', default='',
+                        help='additional input parameters passed to every run, e.g. "warpx.sort_intervals=4"')
+    parser.add_argument('--workdir', default='perf_runs',
+                        help='directory in which the runs are done')
+    parser.add_argument('--output', default='perf_results.jsonl',
+                        help='file to which one JSON line per run is appended')
+    parser.add_argument('--dry-run', action='store_true',
+                        help='only print the commands')
+    return parser.parse_args()
+
+
+def git_commit(path):
+    """Commit hash of the WarpX sources, or None outside of a git repository"""
+    try:
+        return subprocess.check_output(['git', 'rev-parse', 'HEAD'], cwd=path,
+                                       stderr=subprocess.DEVNULL, text=True).strip()
+    except (OSError, subprocess.CalledProcessError):
+        return None
+
+
+def scale_n_cell(n_cell, factor):
+    """Multiply the number of cells by factor (a power of 2), one direction at a time"""
+    n_cell = list(n_cell)
+    idim = 0
+    while factor > 1:
+        n_cell[idim] *= 2
+        factor //= 2
+        idim = (idim + 1) % 3
+    return n_cell
+
+
+def parse_output(stdout):
+    """Total time and number of steps, from the standard output of WarpX"""
+    total_time = None
+    m = re.search(r'Total Time\s*:\s*(\S+)', stdout)
+    if m:
+        total_time = float(m.group(1))
+    steps = re.findall(r'STEP (\d+) ends', stdout)
+    avg = re.findall(r'Avg\. per step = (\S+) s', stdout)
+    return total_time, (int(steps[-1]) if steps else None), (float(avg[-1]) if avg else None)
+
+
+def read_phase_timings(path):
+    """Last line of the PhaseTimings output: it covers the steps after the warmup"""
+    if not os.path.isfile(path):
+        return None
+    with open(path) as f:
+        lines = [line for line in f if line.strip()]
+    return json.loads(lines[-1]) if lines else None
+
+
+def main():
+    args = parse_args()
+
+    nprocs_list = [int(n) for n in args.nprocs.split(',')]
+    n_cell_base = [int(n) for n in args.n_cell.split(',')]
+    names = [b.strip() for b in args.benchmarks.split(',') if b.strip()]
+    for name in names:
+        if name not in benchmarks:
+            sys.exit('Unknown benchmark ' + name + '; choose among: ' + ', '.join(benchmarks))
+    if args.scaling == 'weak':
+        for nprocs in nprocs_list:
+            ratio = nprocs // nprocs_list[0]
+            if nprocs % nprocs_list[0] != 0 or ratio & (ratio - 1) != 0:
+                sys.exit('Weak scaling requires numbers of ranks that are powers of 2 '
+                         'times the smallest one')
+    if args.warmup >= args.steps:
+        sys.exit('--warmup must be smaller than --steps')
+
+    executable = os.path.abspath(args.executable)
+    commit = git_commit(here)
+    host = socket.gethostname()
+    date = datetime.datetime.now().isoformat(timespec='seconds')
+
+    env = dict(os.environ)
+    if args.omp is not None:
+        env['OMP_NUM_THREADS'] = str(args.omp)
+
+    for name in names:
+        for nprocs in nprocs_list:
+            if args.scaling == 'weak':
+                n_cell = scale_n_cell(n_cell_base, nprocs // nprocs_list[0])
+            else:
+                n_cell = n_cell_base
+
+            run_dir = os.path.abspath(os.path.join(
+                args.workdir, '{}_{}_n{}{}'.format(
+                    name, args.scaling, nprocs, '_' + args.variant if args.variant else '')))
+            input_file = benchmarks[name]['input']
+
+            # per-phase timings and kernel counters, output after the
+            # warmup and at the end of the run
+            params = [
+                'max_step={}'.format(args.steps),
+                'amr.n_cell={} {} {}'.format(*n_cell),
+                'amr.max_grid_size={}'.format(args.max_grid_size),
+                'warpx.reduced_diags_names=perf',
+                'perf.type=PhaseTimings',
+                'perf.intervals={w}:{w},{s}:{s}'.format(w=args.warmup, s=args.steps),
+                'perf.kernel_counters=1',
+                'perf.path=./',
+                'perf.extension=jsonl',
+            ] + args.extra.split()
+
+            command = args.launcher.format(nprocs=nprocs).split() + [executable, input_file] + params
+            print(' '.join(command))
+            if args.dry_run:
+                continue
+
+            if os.path.exists(run_dir):
+                shutil.rmtree(run_dir)
+            os.makedirs(run_dir)
+            shutil.copy(os.path.join(here, input_file), run_dir)
+
+            start = time.time()
+            result = subprocess.run(command, cwd=run_dir, env=env,
+                                    stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+            wall_time = time.time() - start
+            with open(os.path.join(run_dir, 'output.txt'), 'w') as f:
+                f.write(result.stdout)
+
+            total_time, steps, time_per_step = parse_output(result.stdout)
+            record = {
+                'benchmark': name,
+                'commit': commit,
+                'date': date,
+                'host': host,
+                'variant': args.variant,
+                'executable': executable,
+                'scaling': args.scaling,
+                'nprocs': nprocs,
+                'omp_threads': args.omp,
+                'n_cell': n_cell,
+                'max_grid_size': args.max_grid_size,
+                'steps': steps,
+                'success': result.returncode == 0,
+                'wall_time': wall_time,
+                'total_time': total_time,
+                'time_per_step': time_per_step,
+                'timings': read_phase_timings(os.path.join(run_dir, 'perf.jsonl')),
+            }
+            if result.returncode != 0:
+                print('  failed (see {}), requires: {}'.format(
+                    os.path.join(run_dir, 'output.txt'), benchmarks[name]['requires'] or 'nothing'))
+
+            with open(args.output, 'a') as f:
+                f.write(json.dumps(record) + '\n')
+
+
+if __name__ == '__main__':
+    main()
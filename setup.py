@@ -102,6 +102,7 @@ class CMakeBuild(build_ext):
             '-DWarpX_PYTHON_IPO:BOOL=' + WARPX_PYTHON_IPO,
             '-DWarpX_QED:BOOL=' + WARPX_QED,
             '-DWarpX_QED_TABLE_GEN:BOOL=' + WARPX_QED_TABLE_GEN,
+            '-DWarpX_QED_TABLES_GEN_OMP=' + WARPX_QED_TABLES_GEN_OMP,
             ## dependency control (developers & package managers)
             '-DWarpX_amrex_internal=' + WARPX_AMREX_INTERNAL,
             # PEP-440 conformant version from package
@@ -210,6 +211,7 @@ WARPX_FFT = env.pop('WARPX_FFT', 'OFF')
 WARPX_HEFFTE = env.pop('WARPX_HEFFTE', 'OFF')
 WARPX_QED = env.pop('WARPX_QED', 'ON')
 WARPX_QED_TABLE_GEN = env.pop('WARPX_QED_TABLE_GEN', 'OFF')
+WARPX_QED_TABLES_GEN_OMP = env.pop('WARPX_QED_TABLES_GEN_OMP', 'AUTO')
 WARPX_DIMS = env.pop('WARPX_DIMS', '1;2;RZ;3')
 BUILD_PARALLEL = env.pop('BUILD_PARALLEL', '2')
 BUILD_SHARED_LIBS = env.pop('WARPX_BUILD_SHARED_LIBS',